@@ -101,3 +101,54 @@ function(visionaray_add_library name)
     visionaray_target_set_warnings(${name})
     target_link_libraries(${name} ${__VSNRAY_LINK_LIBRARIES})
 endfunction()
+
+# Compile sources once per instruction set listed in VSNRAY_DISPATCH_ISAS and add
+# the objects to target (see visionaray/isa_dispatch.h). Each variant declares the
+# library's inline functions and templates in its own namespace (VSNRAY_ISA_NAMESPACE),
+# so that the linker cannot merge them with the baseline definitions. For each
+# instruction set, target gets the compile definition VSNRAY_DISPATCH_<ISA>=1 (test
+# with #ifdef, the macros of instruction sets not in the list are undefined)
+function(visionaray_add_isa_sources target)
+    foreach(isa ${VSNRAY_DISPATCH_ISAS})
+        if(MSVC)
+            if(isa STREQUAL "AVX")
+                set(flags /arch:AVX)
+            elseif(isa STREQUAL "AVX2")
+                set(flags /arch:AVX2)
+            elseif(isa STREQUAL "AVX512F")
+                set(flags /arch:AVX512)
+            else()
+                set(flags "")
+            endif()
+        else()
+            if(isa STREQUAL "SSE2")
+                set(flags -msse2)
+            elseif(isa STREQUAL "SSE4_1")
+                set(flags -msse4.1)
+            elseif(isa STREQUAL "SSE4_2")
+                set(flags -msse4.2)
+            elseif(isa STREQUAL "AVX")
+                set(flags -mavx)
+            elseif(isa STREQUAL "AVX2")
+                set(flags -mavx2)
+            elseif(isa STREQUAL "AVX512F")
+                set(flags -mavx512f)
+            else()
+                message(FATAL_ERROR "Unsupported dispatch ISA ${isa}")
+            endif()
+        endif()
+
+        string(TOLOWER ${isa} suffix)
+        set(objects ${target}_${suffix})
+
+        add_library(${objects} OBJECT ${ARGN})
+        visionaray_target_set_warnings(${objects})
+        target_compile_options(${objects} PRIVATE ${flags})
+        # Compilers that don't define macros for the ISA (e.g. MSVC for SSE4.x)
+        target_compile_definitions(${objects} PRIVATE VSNRAY_SIMD_ISA_=VSNRAY_SIMD_ISA_${isa})
+        target_compile_definitions(${objects} PRIVATE VSNRAY_ISA_NAMESPACE=isa_${suffix})
+
+        target_sources(${target} PRIVATE $<TARGET_OBJECTS:${objects}>)
+        target_compile_definitions(${target} PRIVATE VSNRAY_DISPATCH_${isa}=1)
+    endforeach()
+endfunction()
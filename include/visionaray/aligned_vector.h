@@ -10,9 +10,11 @@
 #include <vector>
 
 #include "detail/aligned_allocator.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // An std::vector that is aligned to A byte boundaries
@@ -21,6 +23,7 @@ namespace visionaray
 template <typename T, size_t A = 16>
 using aligned_vector = std::vector<T, aligned_allocator<T, A>>;
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_ALIGNED_VECTOR_H
@@ -8,9 +8,11 @@
 
 #include "detail/macros.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class ambient_light
@@ -33,6 +35,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/ambient_light.inl"
@@ -0,0 +1,485 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_AOV_H
+#define VSNRAY_AOV_H 1
+
+#include <type_traits>
+
+#include "detail/macros.h"
+#include "detail/pixel_access.h"
+#include "math/simd/type_traits.h"
+#include "math/matrix.h"
+#include "math/vector.h"
+#include "pixel_format.h"
+#include "pixel_traits.h"
+#include "render_target.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Arbitrary output variables (AOVs)
+//
+// An AOV channel combines a semantic (what is stored) with a pixel format
+// (how it is stored), e.g. aov_channel<aov::normal, PF_RGB16F> stores
+// normals as half floats. The schedulers write all channels of an AOV
+// render target (see aov_buffer_rt) in the same pass as the colors, from
+// the first sample of a pixel and the result record the kernel returned.
+// Blend samplers (pixel_sampler::jittered_blend etc.) blend the channels
+// that are marked blendable with the frame's blend factors, id channels are
+// always overwritten. The feature buffers of render_target_ref (denoiser
+// inputs, see albedo() and normal_depth()) are written through the same
+// path as AOV channels aov::albedo and aov::normal_depth.
+//
+
+namespace aov
+{
+
+// First hit albedo, RGB (see result_record), 1 if no hit so that
+// demodulating the background is a no-op
+struct albedo
+{
+    static constexpr pixel_format source_format = PF_RGB32F;
+    static constexpr bool blendable = true;
+};
+
+// First hit shading normal, XYZ, 0 if no hit
+struct normal
+{
+    static constexpr pixel_format source_format = PF_RGB32F;
+    static constexpr bool blendable = true;
+};
+
+// Distance along the primary ray, 0 if no hit
+struct depth
+{
+    static constexpr pixel_format source_format = PF_R32F;
+    static constexpr bool blendable = true;
+};
+
+// Normal (XYZ) and depth (W) in one channel, 0 if no hit
+struct normal_depth
+{
+    static constexpr pixel_format source_format = PF_RGBA32F;
+    static constexpr bool blendable = true;
+};
+
+// First hit position in world space
+struct position
+{
+    static constexpr pixel_format source_format = PF_RGB32F;
+    static constexpr bool blendable = true;
+};
+
+// Primitive id of the first hit, -1 if no hit
+struct prim_id
+{
+    static constexpr pixel_format source_format = PF_R32I;
+    static constexpr bool blendable = false;
+};
+
+// Geometry (object) id of the first hit, -1 if no hit
+struct geom_id
+{
+    static constexpr pixel_format source_format = PF_R32I;
+    static constexpr bool blendable = false;
+};
+
+// Screen space motion in pixels, previous minus current position (see
+// aov_buffer_rt::set_camera_transform())
+struct motion
+{
+    static constexpr pixel_format source_format = PF_RG32F;
+    static constexpr bool blendable = true;
+};
+
+} // aov
+
+
+//-------------------------------------------------------------------------------------------------
+// AOV channel
+//
+
+template <typename Semantic, pixel_format Format>
+struct aov_channel
+{
+    using semantic = Semantic;
+
+    constexpr static pixel_format format = Format;
+
+    // Storage type used by the channel's buffer
+    using type = typename pixel_traits<Format>::type;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// View projection matrices of the current and the previous frame
+//
+
+struct aov_camera_transform
+{
+    mat4 curr;
+    mat4 prev;
+};
+
+
+namespace detail
+{
+
+//-------------------------------------------------------------------------------------------------
+// Get the value of an AOV from the result record and the primary ray
+//
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline vector<3, typename RR::scalar_type> get_aov(
+        aov::albedo                                     /* */,
+        RR const&                                       result,
+        R const&                                        /* */,
+        aov_camera_transform const*                     /* */,
+        int                                             /* */,
+        int                                             /* */
+        )
+{
+    using V = vector<3, typename RR::scalar_type>;
+    return select(result.hit, result.albedo, V(1.0));
+}
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline vector<3, typename RR::scalar_type> get_aov(
+        aov::normal                                     /* */,
+        RR const&                                       result,
+        R const&                                        /* */,
+        aov_camera_transform const*                     /* */,
+        int                                             /* */,
+        int                                             /* */
+        )
+{
+    using V = vector<3, typename RR::scalar_type>;
+    return select(result.hit, result.normal, V(0.0));
+}
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline typename RR::scalar_type get_aov(
+        aov::depth                                      /* */,
+        RR const&                                       result,
+        R const&                                        /* */,
+        aov_camera_transform const*                     /* */,
+        int                                             /* */,
+        int                                             /* */
+        )
+{
+    using S = typename RR::scalar_type;
+    return select(result.hit, result.depth, S(0.0));
+}
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline vector<4, typename RR::scalar_type> get_aov(
+        aov::normal_depth                               /* */,
+        RR const&                                       result,
+        R const&                                        /* */,
+        aov_camera_transform const*                     /* */,
+        int                                             /* */,
+        int                                             /* */
+        )
+{
+    using S = typename RR::scalar_type;
+    using V = vector<3, S>;
+    return vector<4, S>(
+            select(result.hit, result.normal, V(0.0)),
+            select(result.hit, result.depth, S(0.0))
+            );
+}
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline vector<3, typename RR::scalar_type> get_aov(
+        aov::position                                   /* */,
+        RR const&                                       result,
+        R const&                                        r,
+        aov_camera_transform const*                     /* */,
+        int                                             /* */,
+        int                                             /* */
+        )
+{
+    using V = vector<3, typename RR::scalar_type>;
+    return select(result.hit, r.ori + r.dir * result.depth, V(0.0));
+}
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline simd::int_type_t<typename RR::scalar_type> get_aov(
+        aov::prim_id                                    /* */,
+        RR const&                                       result,
+        R const&                                        /* */,
+        aov_camera_transform const*                     /* */,
+        int                                             /* */,
+        int                                             /* */
+        )
+{
+    using I = simd::int_type_t<typename RR::scalar_type>;
+    return select(result.hit, result.prim_id, I(-1));
+}
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline simd::int_type_t<typename RR::scalar_type> get_aov(
+        aov::geom_id                                    /* */,
+        RR const&                                       result,
+        R const&                                        /* */,
+        aov_camera_transform const*                     /* */,
+        int                                             /* */,
+        int                                             /* */
+        )
+{
+    using I = simd::int_type_t<typename RR::scalar_type>;
+    return select(result.hit, result.geom_id, I(-1));
+}
+
+template <typename S>
+VSNRAY_FUNC
+inline vector<4, S> transform_point(mat4 const& m, vector<4, S> const& p)
+{
+    return vector<4, S>(m.col0) * p.x
+         + vector<4, S>(m.col1) * p.y
+         + vector<4, S>(m.col2) * p.z
+         + vector<4, S>(m.col3) * p.w;
+}
+
+template <typename RR, typename R>
+VSNRAY_FUNC
+inline vector<2, typename RR::scalar_type> get_aov(
+        aov::motion                                     /* */,
+        RR const&                                       result,
+        R const&                                        r,
+        aov_camera_transform const*                     transform,
+        int                                             width,
+        int                                             height
+        )
+{
+    using S = typename RR::scalar_type;
+    using V2 = vector<2, S>;
+    using V4 = vector<4, S>;
+
+    if (transform == nullptr)
+    {
+        return V2(0.0);
+    }
+
+    // Points at infinity w/o hit, so that the background moves w/ rotations
+    V4 p = select(
+            result.hit,
+            V4(r.ori + r.dir * result.depth, S(1.0)),
+            V4(r.dir, S(0.0))
+            );
+
+    V4 curr = transform_point(transform->curr, p);
+    V4 prev = transform_point(transform->prev, p);
+
+    auto valid = curr.w > S(0.0) && prev.w > S(0.0);
+
+    V2 motion = (prev.xy() / prev.w - curr.xy() / curr.w) * S(0.5) * V2(S((float)width), S((float)height));
+
+    return select(valid, motion, V2(0.0));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Recursive AOV buffer storage
+//
+
+template <typename ...Channels>
+struct aov_buffers
+{
+    // No channel with this semantic
+    template <typename Semantic>
+    void get(Semantic) const = delete;
+
+    template <typename RR, typename R>
+    VSNRAY_FUNC
+    void store(RR const&, R const&, aov_camera_transform const*, int, int, int, int) const
+    {
+    }
+
+    template <typename RR, typename R, typename S>
+    VSNRAY_FUNC
+    void blend(RR const&, R const&, aov_camera_transform const*, int, int, int, int, S, S) const
+    {
+    }
+};
+
+template <typename Channel, typename ...Channels>
+struct aov_buffers<Channel, Channels...>
+{
+    using semantic = typename Channel::semantic;
+
+    typename Channel::type* data;
+    aov_buffers<Channels...> rest;
+
+    VSNRAY_FUNC typename Channel::type* get(semantic) const
+    {
+        return data;
+    }
+
+    template <typename Semantic>
+    VSNRAY_FUNC auto get(Semantic s) const -> decltype(rest.get(s))
+    {
+        return rest.get(s);
+    }
+
+    template <typename RR, typename R>
+    VSNRAY_FUNC
+    void store(
+            RR const&                                   result,
+            R const&                                    r,
+            aov_camera_transform const*                 transform,
+            int                                         x,
+            int                                         y,
+            int                                         width,
+            int                                         height
+            ) const
+    {
+        if (data != nullptr)
+        {
+            pixel_access::store(
+                    pixel_format_constant<Channel::format>{},
+                    pixel_format_constant<semantic::source_format>{},
+                    x,
+                    y,
+                    width,
+                    height,
+                    get_aov(semantic{}, result, r, transform, width, height),
+                    data
+                    );
+        }
+
+        rest.store(result, r, transform, x, y, width, height);
+    }
+
+    template <typename RR, typename R, typename S>
+    VSNRAY_FUNC
+    void blend(
+            RR const&                                   result,
+            R const&                                    r,
+            aov_camera_transform const*                 transform,
+            int                                         x,
+            int                                         y,
+            int                                         width,
+            int                                         height,
+            S                                           sfactor,
+            S                                           dfactor
+            ) const
+    {
+        if (data != nullptr)
+        {
+            blend_channel(
+                    std::integral_constant<bool, semantic::blendable>{},
+                    get_aov(semantic{}, result, r, transform, width, height),
+                    x,
+                    y,
+                    width,
+                    height,
+                    sfactor,
+                    dfactor
+                    );
+        }
+
+        rest.blend(result, r, transform, x, y, width, height, sfactor, dfactor);
+    }
+
+private:
+
+    template <typename V, typename S>
+    VSNRAY_FUNC
+    void blend_channel(std::true_type, V const& value, int x, int y, int width, int height, S sfactor, S dfactor) const
+    {
+        pixel_access::blend(
+                pixel_format_constant<Channel::format>{},
+                pixel_format_constant<semantic::source_format>{},
+                x,
+                y,
+                width,
+                height,
+                value,
+                data,
+                sfactor,
+                dfactor
+                );
+    }
+
+    // Ids can't be blended, always hold the current frame
+    template <typename V, typename S>
+    VSNRAY_FUNC
+    void blend_channel(std::false_type, V const& value, int x, int y, int width, int height, S, S) const
+    {
+        pixel_access::store(
+                pixel_format_constant<Channel::format>{},
+                pixel_format_constant<semantic::source_format>{},
+                x,
+                y,
+                width,
+                height,
+                value,
+                data
+                );
+    }
+};
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// Render target ref with AOV channels
+//
+
+template <
+    pixel_format ColorFormat,
+    pixel_format DepthFormat,
+    pixel_format AccumFormat,
+    typename ...Channels
+    >
+struct aov_render_target_ref : render_target_ref<ColorFormat, DepthFormat, AccumFormat>
+{
+    constexpr static unsigned num_aovs = sizeof...(Channels);
+
+    // Buffer of the channel with the given semantic
+    template <typename Semantic>
+    VSNRAY_FUNC auto aov(Semantic s = Semantic{}) const -> decltype(detail::aov_buffers<Channels...>{}.get(s))
+    {
+        return aovs_.get(s);
+    }
+
+    // Store all AOVs for the pixel (packet) at (x,y)
+    template <typename RR, typename R>
+    VSNRAY_FUNC void store_aovs(RR const& result, R const& r, int x, int y) const
+    {
+        aovs_.store(result, r, camera_transform_, x, y, this->width_, this->height_);
+    }
+
+    // Blend all AOVs for the pixel (packet) at (x,y) w/ the frame's blend factors
+    template <typename RR, typename R, typename S>
+    VSNRAY_FUNC void blend_aovs(RR const& result, R const& r, int x, int y, S sfactor, S dfactor) const
+    {
+        aovs_.blend(result, r, camera_transform_, x, y, this->width_, this->height_, sfactor, dfactor);
+    }
+
+    // Public, buffers may be null (not written)
+    detail::aov_buffers<Channels...> aovs_;
+    aov_camera_transform const* camera_transform_ = nullptr;
+};
+
+template <pixel_format CF, pixel_format DF, pixel_format AF, typename ...Channels>
+constexpr unsigned aov_render_target_ref<CF, DF, AF, Channels...>::num_aovs;
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#endif // VSNRAY_AOV_H
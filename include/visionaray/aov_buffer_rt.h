@@ -0,0 +1,167 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_AOV_BUFFER_RT_H
+#define VSNRAY_AOV_BUFFER_RT_H 1
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "math/matrix.h"
+#include "aligned_vector.h"
+#include "aov.h"
+#include "pixel_traits.h"
+#include "simple_buffer_rt.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+namespace detail
+{
+
+//-------------------------------------------------------------------------------------------------
+// Recursive storage for the AOV channels
+//
+
+template <typename ...Channels>
+struct aov_storage
+{
+    template <typename Semantic>
+    void get(Semantic) const = delete;
+
+    void resize(size_t)
+    {
+    }
+
+    void fill_buffers(aov_buffers<Channels...>&)
+    {
+    }
+};
+
+template <typename Channel, typename ...Channels>
+struct aov_storage<Channel, Channels...>
+{
+    using semantic = typename Channel::semantic;
+    using type = typename Channel::type;
+
+    aligned_vector<type> buffer;
+    aov_storage<Channels...> rest;
+
+    void resize(size_t size)
+    {
+        buffer.resize(size);
+        rest.resize(size);
+    }
+
+    void fill_buffers(aov_buffers<Channel, Channels...>& buffers)
+    {
+        buffers.data = buffer.data();
+        rest.fill_buffers(buffers.rest);
+    }
+
+    type* get(semantic)
+    {
+        return buffer.data();
+    }
+
+    type const* get(semantic) const
+    {
+        return buffer.data();
+    }
+
+    template <typename Semantic>
+    auto get(Semantic s) -> decltype(rest.get(s))
+    {
+        return rest.get(s);
+    }
+
+    template <typename Semantic>
+    auto get(Semantic s) const -> decltype(rest.get(s))
+    {
+        return rest.get(s);
+    }
+};
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// Render target with color, depth and accumulation buffer like simple_buffer_rt,
+// and with one buffer per AOV channel (see aov.h)
+//
+// Usage:
+//
+//     aov_buffer_rt<
+//         PF_RGBA8,
+//         PF_UNSPECIFIED,
+//         PF_RGBA32F,
+//         aov_channel<aov::normal, PF_RGB16F>,
+//         aov_channel<aov::prim_id, PF_R32I>,
+//         aov_channel<aov::motion, PF_RG32F>
+//         > rt;
+//     ...
+//     rt.set_camera_transform(cam.get_proj_matrix() * cam.get_view_matrix());
+//     sched.frame(kernel, sparams);
+//     auto normals = rt.aov<aov::normal>(); // vector<3, half>*
+//
+
+template <
+    pixel_format ColorFormat,
+    pixel_format DepthFormat,
+    pixel_format AccumFormat,
+    typename ...Channels
+    >
+class aov_buffer_rt : public simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>
+{
+public:
+
+    using base_type     = simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>;
+    using ref_type      = aov_render_target_ref<ColorFormat, DepthFormat, AccumFormat, Channels...>;
+
+    // Buffer type of the channel with the given semantic
+    template <typename Semantic>
+    using aov_type      = typename std::remove_pointer<
+            decltype(std::declval<detail::aov_storage<Channels...>&>().get(Semantic{}))
+            >::type;
+
+public:
+
+    template <typename Semantic>
+    aov_type<Semantic>* aov();
+
+    template <typename Semantic>
+    aov_type<Semantic> const* aov() const;
+
+    ref_type ref();
+
+    // View projection matrix the next frame is rendered with, used to
+    // compute screen space motion (aov::motion). The matrix passed with the
+    // previous call becomes the previous frame's, on the first call there
+    // is no motion
+    void set_camera_transform(mat4 const& view_proj);
+
+    // Reset all AOV buffers to the values for pixels w/o hit
+    void clear_aovs();
+
+    void resize(int w, int h);
+
+private:
+
+    detail::aov_storage<Channels...> aovs_;
+
+    aov_camera_transform camera_transform_;
+    bool have_camera_transform_ = false;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#include "detail/aov_buffer_rt.inl"
+
+#endif // VSNRAY_AOV_BUFFER_RT_H
@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "math/vector.h"
 #include "light_sample.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T, typename Geometry>
 class area_light
@@ -53,6 +55,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/area_light.inl"
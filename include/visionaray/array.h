@@ -10,9 +10,11 @@
 #include <iterator>
 
 #include "detail/macros.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // array
@@ -89,6 +91,7 @@ struct array
     T data_[N];
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/array.inl"
@@ -14,9 +14,11 @@
 #include <vector>
 
 #include "detail/macros.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // array_ref
@@ -229,6 +231,7 @@ inline bool operator>=(array_ref<T> lhs, array_ref<T> rhs)
     return !(lhs < rhs);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_ARRAY_REF_H
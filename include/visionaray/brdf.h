@@ -14,9 +14,11 @@
 #include "sampling.h"
 #include "spectrum.h"
 #include "surface_interaction.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Lambertian reflection
@@ -467,6 +469,7 @@ public:
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_BRDF_H
@@ -25,9 +25,11 @@
 #include "math/matrix.h"
 #include "aligned_vector.h"
 #include "tags.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -45,6 +47,20 @@ inline T const* get_pointer(thrust::device_vector<T> const& vec)
     return thrust::raw_pointer_cast(vec.data());
 }
 #endif
+
+// Vectors reuse their memory, other containers (e.g. array_ref) are reconstructed
+template <typename Container, typename P>
+inline auto assign_range(Container& cont, P* first, P* last, int /* prefer */)
+    -> decltype(cont.assign(first, last), void())
+{
+    cont.assign(first, last);
+}
+
+template <typename Container, typename P>
+inline void assign_range(Container& cont, P* first, P* last, long /* fallback */)
+{
+    cont = Container(first, last);
+}
 } // detail
 
 
@@ -143,21 +159,132 @@ inline bool operator==(bvh_node const& a, bvh_node const& b)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// bvh_motion_node
+//
+// Node with bounds at the beginning (time 0) and at the end (time 1) of the shutter
+// interval, traversal interpolates them linearly with ray.time. This is conservative
+// for primitives whose vertices move linearly, e.g. motion blurred instances.
+//
+// The builders set both bounds to the bounds of the whole motion (see set_inner()
+// and set_leaf()), build_top_down() then computes the bounds at time 0 and 1 with
+// get_motion_bounds().
+//
+
+struct VSNRAY_ALIGN(32) bvh_motion_node
+{
+    aabb bbox0;
+    aabb bbox1;
+    union
+    {
+        unsigned first_child;
+        unsigned first_prim;
+    };
+    unsigned short num_prims;
+    unsigned char ordered_traversal_axis;
+    unsigned char ordered_traversal_sign;
+
+    VSNRAY_FUNC bool is_inner() const { return num_prims == 0; }
+    VSNRAY_FUNC bool is_leaf() const { return num_prims != 0; }
+
+    // Bounds of the whole motion
+    VSNRAY_FUNC aabb get_bounds() const
+    {
+        return combine(bbox0, bbox1);
+    }
+
+    // Bounds at time in [0..1]
+    template <typename T>
+    VSNRAY_FUNC basic_aabb<T> get_bounds(T const& time) const
+    {
+        return basic_aabb<T>(
+                lerp(vector<3, T>(bbox0.min), vector<3, T>(bbox1.min), time),
+                lerp(vector<3, T>(bbox0.max), vector<3, T>(bbox1.max), time)
+                );
+    }
+
+    VSNRAY_FUNC unsigned get_child(unsigned i = 0) const
+    {
+        assert(is_inner());
+        return first_child + i;
+    }
+
+    VSNRAY_FUNC bvh_node::index_range get_indices() const
+    {
+        assert(is_leaf());
+        return { first_prim, first_prim + num_prims };
+    }
+
+    VSNRAY_FUNC unsigned get_first_primitive() const
+    {
+        assert(is_leaf());
+        return first_prim;
+    }
+
+    VSNRAY_FUNC unsigned get_num_primitives() const
+    {
+        assert(is_leaf());
+        return static_cast<unsigned>(num_prims);
+    }
+
+    VSNRAY_FUNC void set_inner(
+            aabb const& bounds, unsigned first_child_index, unsigned char axis, unsigned char sign
+            )
+    {
+        bbox0 = bounds;
+        bbox1 = bounds;
+        first_child = first_child_index;
+        num_prims = 0;
+        ordered_traversal_axis = axis;
+        ordered_traversal_sign = sign;
+    }
+
+    VSNRAY_FUNC void set_leaf(aabb const& bounds, unsigned first_primitive_index, unsigned count)
+    {
+        bbox0 = bounds;
+        bbox1 = bounds;
+        first_prim = first_primitive_index;
+        num_prims = static_cast<unsigned short>(count);
+    }
+
+    VSNRAY_FUNC void set_motion_bounds(aabb const& bounds0, aabb const& bounds1)
+    {
+        bbox0 = bounds0;
+        bbox1 = bounds1;
+    }
+};
+
+static_assert( sizeof(bvh_motion_node) == 64, "Size mismatch" );
+
+VSNRAY_FUNC
+inline bool is_inner(bvh_motion_node const& node)
+{
+    return node.is_inner();
+}
+
+VSNRAY_FUNC
+inline bool is_leaf(bvh_motion_node const& node)
+{
+    return node.is_leaf();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 // [index_]bvh_ref_t
 //
 
-template <typename PrimitiveType>
+template <typename PrimitiveType, typename NodeType = bvh_node>
 class bvh_ref_t
 {
 public:
 
     using primitive_type = PrimitiveType;
+    using node_type      = NodeType;
 
 private:
 
     using P = const PrimitiveType;
-    using N = const bvh_node;
+    using N = const NodeType;
 
     P* primitives_first;
     P* primitives_last;
@@ -198,17 +325,18 @@ public:
     }
 };
 
-template <typename PrimitiveType>
+template <typename PrimitiveType, typename NodeType = bvh_node>
 class index_bvh_ref_t
 {
 public:
 
     using primitive_type = PrimitiveType;
+    using node_type      = NodeType;
 
 private:
 
     using P = const PrimitiveType;
-    using N = const bvh_node;
+    using N = const NodeType;
     using I = const unsigned;
 
     P* primitives_first;
@@ -384,6 +512,23 @@ public:
     {
     }
 
+    // Motion blurred instance, the transform is interpolated linearly from transform0
+    // (ray.time == 0) to transform1 (ray.time == 1). Rotations shrink the instance
+    // while in motion, split them into several motion steps if that matters
+    index_bvh_inst_t(
+            index_bvh_ref_t<PrimitiveType> const&   ref,
+            mat4x3 const&                           transform0,
+            mat4x3 const&                           transform1
+            )
+        : ref_(ref)
+        , affine_inv_(inverse(top_left(transform0)))
+        , trans_inv_(-transform0(3))
+        , has_motion_(true)
+        , transform0_(transform0)
+        , transform1_(transform1)
+    {
+    }
+
     VSNRAY_FUNC size_t num_primitives() const
     {
         return ref_.num_primitives();
@@ -424,9 +569,27 @@ public:
         return trans_inv_;
     }
 
+    VSNRAY_FUNC bool has_motion() const
+    {
+        return has_motion_;
+    }
+
+    // Transform at time 0 and 1, only valid for motion blurred instances
+    VSNRAY_FUNC mat4x3 transform0() const
+    {
+        return transform0_;
+    }
+
+    VSNRAY_FUNC mat4x3 transform1() const
+    {
+        return transform1_;
+    }
+
     VSNRAY_FUNC bool operator==(index_bvh_inst_t const& rhs) const
     {
-        return ref_ == rhs.ref_ && affine_inv_ == rhs.affine_inv_ && trans_inv_ == rhs.trans_inv_;
+        return ref_ == rhs.ref_ && affine_inv_ == rhs.affine_inv_ && trans_inv_ == rhs.trans_inv_
+            && has_motion_ == rhs.has_motion_
+            && (!has_motion_ || (transform0_ == rhs.transform0_ && transform1_ == rhs.transform1_));
     }
 
     template <typename Ray>
@@ -434,6 +597,21 @@ public:
     {
         using T = typename Ray::scalar_type;
 
+        if (has_motion_)
+        {
+            matrix<3, 3, T> aff(
+                    lerp(vector<3, T>(transform0_(0)), vector<3, T>(transform1_(0)), r.time),
+                    lerp(vector<3, T>(transform0_(1)), vector<3, T>(transform1_(1)), r.time),
+                    lerp(vector<3, T>(transform0_(2)), vector<3, T>(transform1_(2)), r.time)
+                    );
+            vector<3, T> trans = lerp(vector<3, T>(transform0_(3)), vector<3, T>(transform1_(3)), r.time);
+
+            matrix<3, 3, T> aff_inv = inverse(aff);
+            r.ori = aff_inv * (r.ori - trans);
+            r.dir = aff_inv * r.dir;
+            return;
+        }
+
         matrix<3, 3, T> aff_inv(affine_inv_);
         r.ori = aff_inv * (r.ori + vector<3, T>(trans_inv_));
         r.dir = aff_inv * r.dir;
@@ -454,14 +632,19 @@ private:
     // BVH ref
     index_bvh_ref_t<PrimitiveType> ref_;
 
-    // Inverse affine transformation matrix
+    // Inverse affine transformation matrix (at time 0)
     mat3 affine_inv_;
 
-    // Inverse translation
+    // Inverse translation (at time 0)
     vec3 trans_inv_;
 
     // Instance ID
     int inst_id_ = -1;
+
+    // Motion blur, the transforms are interpolated per ray
+    bool has_motion_ = false;
+    mat4x3 transform0_;
+    mat4x3 transform1_;
 };
 
 
@@ -479,7 +662,7 @@ public:
     using node_type         = typename NodeVector::value_type;
     using node_vector       = NodeVector;
 
-    using bvh_ref  = bvh_ref_t<primitive_type>;
+    using bvh_ref  = bvh_ref_t<primitive_type, node_type>;
     using bvh_inst = bvh_inst_t<primitive_type>;
 
 public:
@@ -541,6 +724,14 @@ public:
         nodes_.reserve(capacity);
     }
 
+    // Replace the primitives and clear the hierarchy, keeps allocated memory
+    template <typename P>
+    void reset(P* prims, size_t count)
+    {
+        detail::assign_range(primitives_, prims, prims + count, 0);
+        clear(count == 0 ? 0 : 2 * count - 1);
+    }
+
 private:
 
     primitive_vector primitives_;
@@ -559,7 +750,7 @@ public:
     using node_vector       = NodeVector;
     using index_vector      = IndexVector;
 
-    using bvh_ref  = index_bvh_ref_t<primitive_type>;
+    using bvh_ref  = index_bvh_ref_t<primitive_type, node_type>;
     using bvh_inst = index_bvh_inst_t<primitive_type>;
 
 public:
@@ -633,6 +824,19 @@ public:
         indices_.reserve(capacity);
     }
 
+    // Replace the primitives and clear the hierarchy, keeps allocated memory
+    template <typename P>
+    void reset(P* prims, size_t count)
+    {
+        detail::assign_range(primitives_, prims, prims + count, 0);
+
+        nodes_.clear();
+        nodes_.reserve(count == 0 ? 0 : 2 * count - 1);
+
+        indices_.clear();
+        indices_.reserve(count);
+    }
+
 private:
 
     primitive_vector primitives_;
@@ -704,8 +908,8 @@ struct is_bvh : std::false_type {};
 template <typename T1, typename T2>
 struct is_bvh<bvh_t<T1, T2>> : std::true_type {};
 
-template <typename T>
-struct is_bvh<bvh_ref_t<T>> : std::true_type {};
+template <typename T, typename N>
+struct is_bvh<bvh_ref_t<T, N>> : std::true_type {};
 
 template <typename T>
 struct is_bvh<bvh_inst_t<T>> : std::true_type {};
@@ -716,8 +920,8 @@ struct is_index_bvh : std::false_type {};
 template <typename T1, typename T2, typename T3>
 struct is_index_bvh<index_bvh_t<T1, T2, T3>> : std::true_type {};
 
-template <typename T>
-struct is_index_bvh<index_bvh_ref_t<T>> : std::true_type {};
+template <typename T, typename N>
+struct is_index_bvh<index_bvh_ref_t<T, N>> : std::true_type {};
 
 template <typename T>
 struct is_index_bvh<index_bvh_inst_t<T>> : std::true_type {};
@@ -750,6 +954,10 @@ template <typename P>
 using bvh               = bvh_t<aligned_vector<P>, aligned_vector<bvh_node, 32>>;
 template <typename P>
 using index_bvh         = index_bvh_t<aligned_vector<P>, aligned_vector<bvh_node, 32>, aligned_vector<unsigned>>;
+template <typename P>
+using motion_bvh        = bvh_t<aligned_vector<P>, aligned_vector<bvh_motion_node, 32>>;
+template <typename P>
+using index_motion_bvh  = index_bvh_t<aligned_vector<P>, aligned_vector<bvh_motion_node, 32>, aligned_vector<unsigned>>;
 
 #ifdef __CUDACC__
 template <typename P>
@@ -774,6 +982,7 @@ void traverse_leaves(B const& b, F func);
 template <typename B, typename N, typename F>
 void traverse_parents(B const& b, N const& n, F func);
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/bvh/get_bounds.inl"
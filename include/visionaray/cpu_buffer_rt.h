@@ -14,14 +14,17 @@
 #include "aligned_vector.h"
 #include "pixel_traits.h"
 #include "render_target.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <
     pixel_format ColorFormat,
     pixel_format DepthFormat,
-    pixel_format AccumFormat = PF_UNSPECIFIED
+    pixel_format AccumFormat = PF_UNSPECIFIED,
+    pixel_format FeatureFormat = PF_UNSPECIFIED
     >
 class cpu_buffer_rt : public render_target
 {
@@ -30,8 +33,9 @@ public:
     using color_type    = typename pixel_traits<ColorFormat>::type;
     using depth_type    = typename pixel_traits<DepthFormat>::type;
     using accum_type    = typename pixel_traits<AccumFormat>::type;
+    using feature_type  = typename pixel_traits<FeatureFormat>::type;
 
-    using ref_type      = render_target_ref<ColorFormat, DepthFormat, AccumFormat>;
+    using ref_type      = render_target_ref<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>;
 
 public:
 
@@ -41,16 +45,21 @@ public:
     color_type* color();
     depth_type* depth();
     accum_type* accum();
+    feature_type* albedo();
+    feature_type* normal_depth();
 
     color_type const* color() const;
     depth_type const* depth() const;
     accum_type const* accum() const;
+    feature_type const* albedo() const;
+    feature_type const* normal_depth() const;
 
     ref_type ref();
 
     void clear_color_buffer(vec4 const& color = vec4(0.0f));
     void clear_depth_buffer(float depth = 1.0f);
     void clear_accum_buffer(vec4 const& color = vec4(0.0f));
+    void clear_feature_buffers();
     void begin_frame();
     void end_frame();
     void resize(int w, int h);
@@ -63,9 +72,12 @@ private:
     aligned_vector<color_type>            color_buffer;
     aligned_vector<depth_type>            depth_buffer;
     aligned_vector<accum_type>            accum_buffer;
+    aligned_vector<feature_type>          albedo_buffer;
+    aligned_vector<feature_type>          normal_depth_buffer;
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/cpu_buffer_rt.inl"
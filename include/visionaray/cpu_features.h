@@ -0,0 +1,33 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_CPU_FEATURES_H
+#define VSNRAY_CPU_FEATURES_H 1
+
+#include "export.h"
+
+namespace visionaray
+{
+
+//-------------------------------------------------------------------------------------------------
+// Runtime detection of the SIMD instruction sets supported by the host
+//
+// Instruction sets are identified by the VSNRAY_SIMD_ISA_* constants from
+// math/simd/intrinsics.h. On x86, detection queries CPUID and also checks (with
+// XGETBV) that the operating system saves the AVX / AVX-512 register state.
+//
+
+// Widest instruction set supported by the host CPU and OS
+VSNRAY_EXPORT int host_simd_isa();
+
+// Check if the host supports the given instruction set
+VSNRAY_EXPORT bool host_supports_simd_isa(int isa);
+
+// Human readable name of an instruction set, e.g. "AVX2"
+VSNRAY_EXPORT char const* simd_isa_name(int isa);
+
+} // visionaray
+
+#endif // VSNRAY_CPU_FEATURES_H
@@ -0,0 +1,128 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_DENOISER_H
+#define VSNRAY_DENOISER_H 1
+
+#include <thread>
+
+#include "detail/thread_pool.h"
+#include "math/vector.h"
+#include "aligned_vector.h"
+#include "pixel_format.h"
+#include "pixel_traits.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Edge-avoiding a-trous wavelet filter (Dammertz et al. 2010)
+//
+// Filters a noisy (accumulated) image with a sequence of sparse 5x5 B3-spline
+// kernels whose step width doubles with each iteration. Filter weights are
+// reduced across color, normal and depth discontinuities, the feature buffers
+// are those written by the schedulers if the render target has a
+// FeatureFormat (see render_target_ref). Before filtering, the colors are
+// divided by the albedo so that texture detail is not blurred, and multiplied
+// by it afterwards.
+//
+// Rows are filtered in parallel, and groups of four adjacent pixels with SIMD.
+//
+// Usage:
+//
+//     cpu_buffer_rt<PF_RGBA8, PF_UNSPECIFIED, PF_RGBA32F, PF_RGBA32F> rt;
+//     ...
+//     sched.frame(kernel, sparams);   // e.g. jittered_blend_type sampler
+//     denoiser.filter(rt);            // accum buffer -> color buffer
+//
+
+class atrous_denoiser
+{
+public:
+
+    explicit atrous_denoiser(unsigned num_threads = std::thread::hardware_concurrency());
+
+    // Number of filter passes, pass i has a step width of 2^i pixels
+    void set_num_iterations(unsigned num_iterations);
+    unsigned num_iterations() const;
+
+    // Color edge stopping, relative to the mean luminance of the two pixels;
+    // halved with each iteration. Smaller values preserve more detail, which
+    // pays off with higher sample counts
+    void set_sigma_color(float sigma);
+    float sigma_color() const;
+
+    // Normal edge stopping, in terms of the distance between unit normals
+    void set_sigma_normal(float sigma);
+    float sigma_normal() const;
+
+    // Depth edge stopping, relative to the pixel's distance and the step width
+    void set_sigma_depth(float sigma);
+    float sigma_depth() const;
+
+    // Filter illumination instead of colors (default: true)
+    void set_demodulate_albedo(bool demodulate);
+    bool demodulate_albedo() const;
+
+    // Filter the RGBA32F image src into dst (may be the same buffer),
+    // converting to dst's pixel format. albedo and normal_depth are the
+    // feature buffers in RGBA32F format. The alpha channel is not filtered.
+    template <pixel_format DF>
+    void filter(
+            pixel_format_constant<DF>                   dst_format,
+            typename pixel_traits<DF>::type*            dst,
+            vec4 const*                                 src,
+            vec4 const*                                 albedo,
+            vec4 const*                                 normal_depth,
+            int                                         width,
+            int                                         height
+            );
+
+    void filter(
+            vec4*                                       dst,
+            vec4 const*                                 src,
+            vec4 const*                                 albedo,
+            vec4 const*                                 normal_depth,
+            int                                         width,
+            int                                         height
+            );
+
+    // Filter the render target's accumulation buffer (or its color buffer if
+    // there is none) and store the result in its color buffer
+    template <typename RenderTarget>
+    void filter(RenderTarget& rt);
+
+private:
+
+    // Split into planes, divide by albedo
+    void prepare(vec4 const* src, vec4 const* albedo, vec4 const* normal_depth, int width, int height);
+
+    // One a-trous pass from the current planes into the scratch planes
+    void iterate(unsigned iteration, int width, int height);
+
+    thread_pool pool_;
+
+    unsigned num_iterations_ = 4;
+    float sigma_color_ = 2.0f;
+    float sigma_normal_ = 0.2f;
+    float sigma_depth_ = 0.05f;
+    bool demodulate_albedo_ = true;
+
+    // Planar color (r, g, b) and features (nx, ny, nz, depth), plus a second
+    // set of color planes to ping-pong between iterations
+    aligned_vector<float> color_[3];
+    aligned_vector<float> scratch_[3];
+    aligned_vector<float> features_[4];
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#include "detail/denoiser.inl"
+
+#endif // VSNRAY_DENOISER_H
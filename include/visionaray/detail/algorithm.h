@@ -13,9 +13,11 @@
 #include <type_traits>
 
 #include "macros.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace algo
 {
 
@@ -258,6 +260,7 @@ void reorder(RanIt1 indices_first, RanIt1 indices_last, RanIt2 data)
 }
 
 } // namespace algo
+VSNRAY_ISA_NAMESPACE_END
 } // namespace visionaray
 
 #endif // VSNRAY_DETAIL_ALGORITHM_H
@@ -12,6 +12,7 @@
 #include <visionaray/math/simd/intrinsics.h> // VSNRAY_ARCH
 
 #include "macros.h"
+#include "isa_namespace.h"
 
 #if VSNRAY_CXX_GCC || VSNRAY_CXX_CLANG
 #if VSNRAY_ARCH == VSNRAY_ARCH_ARM
@@ -22,6 +23,7 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 inline void* _mm_malloc(size_t s, size_t aln)
 {
@@ -33,6 +35,7 @@ inline void _mm_free(void* ptr)
     free(ptr);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #else
@@ -45,6 +48,7 @@ inline void _mm_free(void* ptr)
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T, size_t A>
 class aligned_allocator
@@ -122,6 +126,7 @@ public:
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_ALIGNED_ALLOCATOR_H
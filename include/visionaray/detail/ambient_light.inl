@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 template <typename U>
@@ -23,4 +26,5 @@ VSNRAY_FUNC void ambient_light<T>::set_kl(T const& kl)
     kl_ = kl;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -0,0 +1,94 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstddef>
+
+#include "../math/ray.h"
+#include "../result_record.h"
+#include "isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Accessors
+//
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, typename ...Channels>
+template <typename Semantic>
+inline auto aov_buffer_rt<ColorFormat, DepthFormat, AccumFormat, Channels...>::aov()
+    -> aov_type<Semantic>*
+{
+    return aovs_.get(Semantic{});
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, typename ...Channels>
+template <typename Semantic>
+inline auto aov_buffer_rt<ColorFormat, DepthFormat, AccumFormat, Channels...>::aov() const
+    -> aov_type<Semantic> const*
+{
+    return aovs_.get(Semantic{});
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Interface
+//
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, typename ...Channels>
+inline typename aov_buffer_rt<ColorFormat, DepthFormat, AccumFormat, Channels...>::ref_type
+aov_buffer_rt<ColorFormat, DepthFormat, AccumFormat, Channels...>::ref()
+{
+    ref_type result;
+
+    static_cast<typename base_type::ref_type&>(result) = base_type::ref();
+
+    aovs_.fill_buffers(result.aovs_);
+    result.camera_transform_ = have_camera_transform_ ? &camera_transform_ : nullptr;
+
+    return result;
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, typename ...Channels>
+inline void aov_buffer_rt<ColorFormat, DepthFormat, AccumFormat, Channels...>::set_camera_transform(
+        mat4 const& view_proj
+        )
+{
+    camera_transform_.prev = have_camera_transform_ ? camera_transform_.curr : view_proj;
+    camera_transform_.curr = view_proj;
+    have_camera_transform_ = true;
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, typename ...Channels>
+inline void aov_buffer_rt<ColorFormat, DepthFormat, AccumFormat, Channels...>::clear_aovs()
+{
+    detail::aov_buffers<Channels...> buffers;
+    aovs_.fill_buffers(buffers);
+
+    // Store the AOVs of a primary ray w/o hit
+    result_record<float> miss;
+    basic_ray<float> r(vec3(0.0f), vec3(0.0f, 0.0f, 1.0f));
+
+    int w = this->width();
+    int h = this->height();
+
+    for (int y = 0; y < h; ++y)
+    {
+        for (int x = 0; x < w; ++x)
+        {
+            buffers.store(miss, r, nullptr, x, y, w, h);
+        }
+    }
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, typename ...Channels>
+inline void aov_buffer_rt<ColorFormat, DepthFormat, AccumFormat, Channels...>::resize(int w, int h)
+{
+    base_type::resize(w, h);
+
+    aovs_.resize(static_cast<size_t>(w) * h);
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
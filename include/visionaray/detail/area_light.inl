@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // area_light members
@@ -87,4 +90,5 @@ inline void area_light<T, Geometry>::set_kl(T kl)
     kl_ = kl;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
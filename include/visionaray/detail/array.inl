@@ -9,6 +9,7 @@
 #endif
 
 #include "compiler.h"
+#include "isa_namespace.h"
 
 #ifdef VSNRAY_CXX_HAS_CONSTEXPR
 #define VSNRAY_CONSTEXPR_ constexpr
@@ -18,6 +19,7 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // array members
@@ -269,6 +271,7 @@ bool operator!=(array<T, N> const& a, array<T, N> const& b)
 
 // TODO: lexicographic comparisons!
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 
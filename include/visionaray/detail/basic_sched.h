@@ -6,8 +6,15 @@
 #ifndef VSNRAY_DETAIL_BASIC_SCHED_H
 #define VSNRAY_DETAIL_BASIC_SCHED_H 1
 
+#include <vector>
+
+#include "../aligned_vector.h"
+#include "tile_order.h"
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename Backend, typename R>
 class basic_sched
@@ -23,14 +30,50 @@ public:
     template <typename ...Args>
     void reset(Args&&... args);
 
+    // Progressive preview: if factor > 1, trace only one pixel per factor x factor
+    // block at the block center and replicate it to the whole block. Set this while
+    // the camera moves and reset it to 1 for a full resolution frame.
+    void set_preview_factor(int factor);
+    int preview_factor() const;
+
 private:
 
+    // Render [x0..nx) x [y0..ny) (expanded to packet boundaries) into rt_ref
+    template <typename K, typename SP, typename RTRef>
+    void render_region(
+            K kernel,
+            SP const& sched_params,
+            RTRef rt_ref,
+            int x0,
+            int y0,
+            int nx,
+            int ny,
+            int width,
+            int height
+            );
+
+    // Render at reduced resolution and upsample into [x0..nx) x [y0..ny)
+    template <typename K, typename SP>
+    void render_preview(K kernel, SP const& sched_params, int x0, int y0, int nx, int ny);
+
     Backend backend_;
 
-    unsigned frame_id_;
+    unsigned frame_id_ = 0;
+
+    int preview_factor_ = 1;
+
+    // Color, depth and accumulation buffers for preview frames
+    aligned_vector<unsigned char, 64> preview_buffer_;
+
+    // Tile order of the last frame, recomputed when the tile grid changes
+    std::vector<int> tile_indices_;
+    tile_order tile_order_ = RowMajorOrder;
+    int num_tiles_x_ = 0;
+    int num_tiles_y_ = 0;
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "basic_sched.inl"
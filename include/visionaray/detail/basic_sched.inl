@@ -6,12 +6,18 @@
 
 #include "../make_generator.h"
 #include "../make_random_seed.h"
+#include "../math/detail/math.h"
+#include "../math/rectangle.h"
 #include "../packet_traits.h"
+#include "../profiling.h"
 #include "range.h"
 #include "sched_common.h"
+#include "tile_order.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace basic_sched_impl
 {
 
@@ -19,13 +25,14 @@ namespace basic_sched_impl
 // Generate primary ray and sample pixel
 //
 
-template <typename R, typename K, typename SP, typename Generator, typename ...Args>
+template <typename R, typename K, typename SP, typename Generator, typename RTRef, typename ...Args>
 void call_sample_pixel(
         std::false_type /* has intersector */,
         R const&        r,
         K               kernel,
         SP              sparams,
         Generator&      gen,
+        RTRef           rt_ref,
         Args&&...       args
         )
 {
@@ -34,18 +41,19 @@ void call_sample_pixel(
             sparams.sample_params,
             r,
             gen,
-            sparams.rt.ref(),
+            rt_ref,
             std::forward<Args>(args)...
             );
 }
 
-template <typename R, typename K, typename SP, typename Generator, typename ...Args>
+template <typename R, typename K, typename SP, typename Generator, typename RTRef, typename ...Args>
 void call_sample_pixel(
         std::true_type  /* has intersector */,
         R const&        r,
         K               kernel,
         SP              sparams,
         Generator&      gen,
+        RTRef           rt_ref,
         Args&&...       args
         )
 {
@@ -56,11 +64,58 @@ void call_sample_pixel(
             sparams.sample_params,
             r,
             gen,
-            sparams.rt.ref(),
+            rt_ref,
             std::forward<Args>(args)...
             );
 }
 
+
+//-------------------------------------------------------------------------------------------------
+// Preview frames
+//
+
+// Take the next size bytes of preview storage, or none if the format is unspecified
+template <typename T>
+T* take_preview_buffer(unsigned char*& storage, size_t size, bool specified)
+{
+    if (!specified)
+    {
+        return nullptr;
+    }
+
+    T* result = reinterpret_cast<T*>(storage);
+    storage += round_up(size * sizeof(T), size_t(64));
+    return result;
+}
+
+template <typename T>
+size_t preview_buffer_size(size_t size, bool specified)
+{
+    return specified ? round_up(size * sizeof(T), size_t(64)) : 0;
+}
+
+// AOVs are not written in preview frames
+template <typename RTRef>
+void detach_aovs(std::false_type, RTRef&)
+{
+}
+
+template <typename RTRef>
+void detach_aovs(std::true_type, RTRef& ref)
+{
+    ref.aovs_ = {};
+}
+
+// Replicate the preview pixel covering (x,y)
+template <typename T>
+void upsample_preview_pixel(T* dst, T const* src, int x, int y, int width, int factor, int preview_width)
+{
+    if (dst != nullptr)
+    {
+        dst[y * width + x] = src[(y / factor) * preview_width + x / factor];
+    }
+}
+
 } // basic_sched_impl
 
 
@@ -79,25 +134,135 @@ template <typename B, typename R>
 template <typename K, typename SP>
 void basic_sched<B, R>::frame(K kernel, SP sched_params)
 {
+    VSNRAY_PROFILE_SCOPE_ID("frame", frame_id_);
+
     sched_params.cam.begin_frame();
 
-    sched_params.rt.begin_frame();
+    {
+        VSNRAY_PROFILE_SCOPE("begin_frame");
+        sched_params.rt.begin_frame();
+    }
 
+    int width = sched_params.rt.width();
+    int height = sched_params.rt.height();
+
+    int x0 = 0;
+    int y0 = 0;
+
+    int nx = width;
+    int ny = height;
+
+    // Region of interest
+    recti const& scissor = sched_params.scissor;
+
+    if (scissor.w > 0 && scissor.h > 0)
+    {
+        x0 = max(scissor.x, 0);
+        y0 = max(scissor.y, 0);
+        nx = min(nx, scissor.x + scissor.w);
+        ny = min(ny, scissor.y + scissor.h);
+    }
+
+    if (x0 < nx && y0 < ny)
+    {
+        if (preview_factor_ > 1)
+        {
+            render_preview(kernel, sched_params, x0, y0, nx, ny);
+        }
+        else
+        {
+            render_region(kernel, sched_params, sched_params.rt.ref(), x0, y0, nx, ny, width, height);
+        }
+    }
+
+    {
+        VSNRAY_PROFILE_SCOPE("end_frame");
+        sched_params.rt.end_frame();
+    }
+
+    sched_params.cam.end_frame();
+
+    ++frame_id_;
+}
+
+template <typename B, typename R>
+template <typename ...Args>
+void basic_sched<B, R>::reset(Args&&... args)
+{
+    backend_.reset(std::forward<Args>(args)...);
+}
+
+template <typename B, typename R>
+void basic_sched<B, R>::set_preview_factor(int factor)
+{
+    preview_factor_ = max(factor, 1);
+}
+
+template <typename B, typename R>
+int basic_sched<B, R>::preview_factor() const
+{
+    return preview_factor_;
+}
+
+template <typename B, typename R>
+template <typename K, typename SP, typename RTRef>
+void basic_sched<B, R>::render_region(
+        K           kernel,
+        SP const&   sched_params,
+        RTRef       rt_ref,
+        int         x0,
+        int         y0,
+        int         nx,
+        int         ny,
+        int         width,
+        int         height
+        )
+{
     int pw = packet_size<typename R::scalar_type>::w;
     int ph = packet_size<typename R::scalar_type>::h;
 
+    // Expand to packet boundaries
+    x0 = x0 / pw * pw;
+    y0 = y0 / ph * ph;
+    nx = min(width, round_up(nx, pw));
+    ny = min(height, round_up(ny, ph));
+
+    int tw = sched_params.tile_width;
+    int th = sched_params.tile_height;
+
+    if (tw <= 0 || th <= 0)
+    {
+        int ts = detail::auto_tile_size(nx - x0, ny - y0, backend_.num_threads());
+        tw = tw <= 0 ? ts : tw;
+        th = th <= 0 ? ts : th;
+    }
+
     // Tile size must be be a multiple of packet size.
-    int dx = round_up(16, pw);
-    int dy = round_up(16, ph);
+    int dx = round_up(tw, pw);
+    int dy = round_up(th, ph);
 
-    int x0 = 0;
-    int y0 = 0;
+    int num_tiles_x = div_up(nx - x0, dx);
+    int num_tiles_y = div_up(ny - y0, dy);
+
+    if (sched_params.order != tile_order_ || num_tiles_x != num_tiles_x_ || num_tiles_y != num_tiles_y_)
+    {
+        tile_order_ = sched_params.order;
+        num_tiles_x_ = num_tiles_x;
+        num_tiles_y_ = num_tiles_y;
 
-    int nx = sched_params.rt.width();
-    int ny = sched_params.rt.height();
+        if (tile_order_ != RowMajorOrder)
+        {
+            detail::make_tile_order(tile_order_, num_tiles_x_, num_tiles_y_, tile_indices_);
+        }
+    }
+
+    unsigned frame_id = frame_id_;
 
     backend_.for_each_packet(
-        tiled_range2d<int>(x0, nx, dx, y0, ny, dy), pw, ph,
+        tiled_range2d<int>(x0, nx, dx, y0, ny, dy),
+        tile_order_ != RowMajorOrder ? tile_indices_.data() : nullptr,
+        pw,
+        ph,
         [=](int x, int y)
         {
             using S = typename R::scalar_type;
@@ -105,8 +270,8 @@ void basic_sched<B, R>::frame(K kernel, SP sched_params)
 
             expand_pixel<S> ep;
             auto seed = make_random_seed(
-                convert_to_int(ep.y(y)) * sched_params.rt.width() + convert_to_int(ep.x(x)),
-                I(frame_id_)
+                convert_to_int(ep.y(y)) * width + convert_to_int(ep.x(x)),
+                I(frame_id)
                 );
 
             auto gen = make_generator(S{}, sched_params.sample_params, seed);
@@ -117,26 +282,90 @@ void basic_sched<B, R>::frame(K kernel, SP sched_params)
                     kernel,
                     sched_params,
                     gen,
+                    rt_ref,
                     x,
                     y,
-                    sched_params.rt.width(),
-                    sched_params.rt.height(),
+                    width,
+                    height,
                     sched_params.cam
                     );
         });
-
-    sched_params.rt.end_frame();
-
-    sched_params.cam.end_frame();
-
-    ++frame_id_;
 }
 
 template <typename B, typename R>
-template <typename ...Args>
-void basic_sched<B, R>::reset(Args&&... args)
+template <typename K, typename SP>
+void basic_sched<B, R>::render_preview(K kernel, SP const& sched_params, int x0, int y0, int nx, int ny)
 {
-    backend_.reset(std::forward<Args>(args)...);
+    using RTRef = decltype(sched_params.rt.ref());
+    using C = typename RTRef::color_type;
+    using D = typename RTRef::depth_type;
+    using A = typename RTRef::accum_type;
+    using F = typename RTRef::feature_type;
+
+    bool has_depth = RTRef::depth_format != PF_UNSPECIFIED;
+    bool has_accum = RTRef::accum_format != PF_UNSPECIFIED;
+    bool has_features = RTRef::feature_format != PF_UNSPECIFIED;
+
+    int f = preview_factor_;
+
+    int width = sched_params.rt.width();
+    int height = sched_params.rt.height();
+
+    int preview_width = div_up(width, f);
+    int preview_height = div_up(height, f);
+
+    size_t n = static_cast<size_t>(preview_width) * preview_height;
+
+    size_t size = basic_sched_impl::preview_buffer_size<C>(n, true)
+                + basic_sched_impl::preview_buffer_size<D>(n, has_depth)
+                + basic_sched_impl::preview_buffer_size<A>(n, has_accum)
+                + basic_sched_impl::preview_buffer_size<F>(n, has_features) * 2;
+
+    // Zero-initialized so that blending starts from a defined state
+    if (preview_buffer_.size() != size)
+    {
+        preview_buffer_.assign(size, 0);
+    }
+
+    auto full_ref = sched_params.rt.ref();
+
+    RTRef preview_ref = full_ref;
+    unsigned char* storage = preview_buffer_.data();
+    preview_ref.color_ = basic_sched_impl::take_preview_buffer<C>(storage, n, true);
+    preview_ref.depth_ = basic_sched_impl::take_preview_buffer<D>(storage, n, has_depth);
+    preview_ref.accum_ = basic_sched_impl::take_preview_buffer<A>(storage, n, has_accum);
+    preview_ref.albedo_ = basic_sched_impl::take_preview_buffer<F>(storage, n, has_features);
+    preview_ref.normal_depth_ = basic_sched_impl::take_preview_buffer<F>(storage, n, has_features);
+    preview_ref.width_ = preview_width;
+    preview_ref.height_ = preview_height;
+    basic_sched_impl::detach_aovs(detail::has_aovs<RTRef>{}, preview_ref);
+
+    render_region(
+            kernel,
+            sched_params,
+            preview_ref,
+            x0 / f,
+            y0 / f,
+            div_up(nx, f),
+            div_up(ny, f),
+            preview_width,
+            preview_height
+            );
+
+    backend_.for_each_packet(
+        tiled_range2d<int>(x0, nx, 64, y0, ny, 64),
+        nullptr,
+        1,
+        1,
+        [=](int x, int y)
+        {
+            basic_sched_impl::upsample_preview_pixel(full_ref.color_, preview_ref.color_, x, y, width, f, preview_width);
+            basic_sched_impl::upsample_preview_pixel(full_ref.depth_, preview_ref.depth_, x, y, width, f, preview_width);
+            basic_sched_impl::upsample_preview_pixel(full_ref.accum_, preview_ref.accum_, x, y, width, f, preview_width);
+            basic_sched_impl::upsample_preview_pixel(full_ref.albedo_, preview_ref.albedo_, x, y, width, f, preview_width);
+            basic_sched_impl::upsample_preview_pixel(full_ref.normal_depth_, preview_ref.normal_depth_, x, y, width, f, preview_width);
+        });
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -11,10 +11,12 @@
 #include "../compiler.h"
 #include "lbvh.h"
 #include "sah.h"
+#include "../isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename Tree, typename P>
 Tree VSNRAY_DEPRECATED build(lbvh_builder /* */, P* primitives, size_t num_prims)
@@ -51,6 +53,7 @@ Tree VSNRAY_DEPRECATED build(P* primitives, size_t num_prims, bool enable_spatia
             );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_BUILD_H
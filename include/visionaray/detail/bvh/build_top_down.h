@@ -13,9 +13,11 @@
 #include <visionaray/aligned_vector.h>
 
 #include "../algorithm.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -79,6 +81,56 @@ inline void build_top_down_impl(
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// Bounds at time 0 and 1 for motion BVHs, the builder only knows the bounds of the
+// whole motion. Children are stored after their parents
+//
+
+template <typename Tree>
+inline void update_motion_bounds(Tree& /* */, std::false_type /* has motion nodes */)
+{
+}
+
+template <typename Tree>
+inline void update_motion_bounds(Tree& tree, std::true_type /* has motion nodes */)
+{
+    auto& nodes = tree.nodes();
+
+    for (size_t i = nodes.size(); i-- > 0; )
+    {
+        auto& node = nodes[i];
+
+        aabb bounds0;
+        aabb bounds1;
+
+        if (node.is_leaf())
+        {
+            bounds0.invalidate();
+            bounds1.invalidate();
+
+            auto indices = node.get_indices();
+
+            for (unsigned j = indices.first; j != indices.last; ++j)
+            {
+                auto bounds = get_motion_bounds(tree.primitive(j));
+                bounds0.insert(bounds[0]);
+                bounds1.insert(bounds[1]);
+            }
+        }
+        else
+        {
+            auto const& left  = nodes[node.get_child(0)];
+            auto const& right = nodes[node.get_child(1)];
+
+            bounds0 = combine(left.bbox0, right.bbox0);
+            bounds1 = combine(left.bbox1, right.bbox1);
+        }
+
+        node.set_motion_bounds(bounds0, bounds1);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 // build_top_down
 //
@@ -119,7 +171,11 @@ inline void build_top_down_work(
     // TODO:
     // Maybe rewrite the builder to directly shuffle the primitives?!?!
 
-    aligned_vector<unsigned> indices;
+    // Reuse the builder's buffer, so that repeated builds don't allocate
+    auto& indices = builder.leaf_indices;
+
+    indices.clear();
+    indices.reserve(tree.primitives().size());
 
     //assert(builder.use_spatial_splits == false);
 
@@ -157,12 +213,10 @@ inline void build_top_down(Tree& tree, Builder& builder, I first, I last, int ma
 
     auto root = builder.init(first, last);
 
-    // Preallocate memory
-    // Guess number of nodes...
-
-    auto count = std::distance(first, last);
-
-    tree.clear(2 * (count / max_leaf_size));
+    // The tree was reset() by the builder, which also preallocated memory:
+    // a binary tree over N leaves has 2N - 1 nodes; there are at most N leaves
+    // unless spatial splits duplicate references
+    assert(tree.nodes().empty());
 
     // Build the tree
 
@@ -170,9 +224,12 @@ inline void build_top_down(Tree& tree, Builder& builder, I first, I last, int ma
     tree.nodes().emplace_back();
 
     build_top_down_work(tree, builder, root, first, last, max_leaf_size, is_index_bvh<Tree>());
+
+    update_motion_bounds(tree, std::is_same<typename Tree::node_type, bvh_motion_node>());
 }
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_BUILD_TOP_DOWN_H
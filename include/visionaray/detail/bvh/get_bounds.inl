@@ -4,9 +4,34 @@
 #include <type_traits>
 
 #include <visionaray/math/aabb.h>
+#include <visionaray/array.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+VSNRAY_FUNC
+inline aabb transform_bounds(aabb const& bbox, mat3 const& affine, vec3 const& trans)
+{
+    aabb result;
+    result.invalidate();
+
+    auto vertices = compute_vertices(bbox);
+
+    for (vec3 v : vertices)
+    {
+        v = affine * v + trans;
+        result.insert(v);
+    }
+
+    return result;
+}
+
+} // detail
+
 
 template <
     typename BVH,
@@ -37,23 +62,57 @@ template <
 VSNRAY_FUNC
 inline aabb get_bounds(BVH const& bvh)
 {
-    mat3 affine = inverse(bvh.affine_inv());
-    vec3 trans = -bvh.trans_inv();
+    auto bounds = get_motion_bounds(bvh);
+    return combine(bounds[0], bounds[1]);
+}
 
-    aabb bbox = get_bounds(bvh.get_ref());
 
-    aabb result;
-    result.invalidate();
+//-------------------------------------------------------------------------------------------------
+// Bounds at time 0 and at time 1, used to build motion BVHs (see bvh_motion_node).
+// Primitives w/o motion have the same bounds at both times, add overloads for
+// primitives that move
+//
 
-    auto vertices = compute_vertices(bbox);
+template <typename Primitive>
+VSNRAY_FUNC
+inline array<aabb, 2> get_motion_bounds(Primitive const& prim)
+{
+    aabb bounds = get_bounds(prim);
+    return {{ bounds, bounds }};
+}
 
-    for (vec3 v : vertices)
+template <typename P>
+VSNRAY_FUNC
+inline array<aabb, 2> get_motion_bounds(bvh_inst_t<P> const& inst)
+{
+    aabb bounds = detail::transform_bounds(
+            get_bounds(inst.get_ref()),
+            inverse(inst.affine_inv()),
+            -inst.trans_inv()
+            );
+    return {{ bounds, bounds }};
+}
+
+template <typename P>
+VSNRAY_FUNC
+inline array<aabb, 2> get_motion_bounds(index_bvh_inst_t<P> const& inst)
+{
+    aabb bbox = get_bounds(inst.get_ref());
+
+    if (!inst.has_motion())
     {
-        v = affine * v + trans;
-        result.insert(v);
+        aabb bounds = detail::transform_bounds(bbox, inverse(inst.affine_inv()), -inst.trans_inv());
+        return {{ bounds, bounds }};
     }
 
-    return result;
+    mat4x3 t0 = inst.transform0();
+    mat4x3 t1 = inst.transform1();
+
+    return {{
+        detail::transform_bounds(bbox, top_left(t0), t0(3)),
+        detail::transform_bounds(bbox, top_left(t1), t1(3))
+        }};
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -9,9 +9,11 @@
 #include <type_traits>
 
 #include <visionaray/tags.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <
     typename HR,
@@ -118,6 +120,7 @@ auto get_color(Colors colors, HR const& hr, Primitive /* */, colors_per_geometry
             );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_GET_COLOR_H
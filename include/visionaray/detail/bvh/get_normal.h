@@ -13,9 +13,11 @@
 
 // TODO: should not depend on this
 #include "hit_record.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 namespace detail
 {
@@ -138,6 +140,7 @@ auto get_shading_normal(
     return detail::get_normal_from_bvh(normals, hr, prim, NormalBinding{});
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_GET_NORMAL_H
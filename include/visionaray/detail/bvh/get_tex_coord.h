@@ -7,9 +7,11 @@
 #define VSNRAY_DETAIL_BVH_GET_TEX_COORD_H 1
 
 #include <type_traits>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <
     typename HR,
@@ -77,6 +79,7 @@ auto get_tex_coord(TexCoords tex_coords, HR const& hr, Primitive prim)
             );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_GET_TEX_COORD_H
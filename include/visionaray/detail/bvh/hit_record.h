@@ -13,9 +13,11 @@
 #include <visionaray/math/ray.h>
 #include <visionaray/array.h>
 #include <visionaray/update_if.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // A special hit record for BVHs that stores additional hit information associated
@@ -237,6 +239,7 @@ inline auto unpack(
 
 } // simd
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_HIT_RECORD_H
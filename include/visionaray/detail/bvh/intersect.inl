@@ -15,6 +15,7 @@
 #include "../tags.h"
 #include "../traversal_result.h"
 #include "hit_record.h"
+#include "../isa_namespace.h"
 
 #ifdef __CUDA_ARCH__
 #define VSNRAY_FULL_STACK_TRAVERSAL_ 0
@@ -24,6 +25,31 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+//-------------------------------------------------------------------------------------------------
+// Node bounds for the ray, motion nodes are interpolated with ray.time
+//
+
+template <typename R>
+VSNRAY_FUNC
+inline aabb const& node_bounds(bvh_node const& node, R const& /* */)
+{
+    return node.get_bounds();
+}
+
+template <typename R>
+VSNRAY_FUNC
+inline auto node_bounds(bvh_motion_node const& node, R const& ray)
+    -> basic_aabb<typename R::scalar_type>
+{
+    return node.get_bounds(ray.time);
+}
+
+} // detail
+
 
 //-------------------------------------------------------------------------------------------------
 // Ray / BVH intersection
@@ -83,8 +109,8 @@ next:
             {   
                 auto children = &b.node(node.get_child(0));
 
-                auto hr1 = isect(ray, children[0].get_bounds(), inv_dir);
-                auto hr2 = isect(ray, children[1].get_bounds(), inv_dir);
+                auto hr1 = isect(ray, node_bounds(children[0], ray), inv_dir);
+                auto hr2 = isect(ray, node_bounds(children[1], ray), inv_dir);
 
                 auto b1 = any(is_closer(hr1, result, ray.tmin, ray.tmax));
                 auto b2 = any(is_closer(hr2, result, ray.tmin, ray.tmax));
@@ -113,7 +139,7 @@ next:
         {
             while (true)
             {
-                auto hr = isect(ray, node.get_bounds(), inv_dir);
+                auto hr = isect(ray, node_bounds(node, ray), inv_dir);
                 auto hit = any(is_closer(hr, result, ray.tmin, ray.tmax));
 
                 if (!hit)
@@ -175,7 +201,7 @@ next:
 
     auto inv_dir = T(1.0) / ray.dir;
 
-    bvh_node node = b.node(0);
+    auto node = b.node(0);
 
     uint64_t level = 0x8000000000000000ULL;
 
@@ -254,8 +280,8 @@ next:
         {
             auto children = &b.node(node.get_child(0));
 
-            auto hr1 = isect(ray, children[0].get_bounds(), inv_dir);
-            auto hr2 = isect(ray, children[1].get_bounds(), inv_dir);
+            auto hr1 = isect(ray, node_bounds(children[0], ray), inv_dir);
+            auto hr2 = isect(ray, node_bounds(children[1], ray), inv_dir);
 
             auto b1 = any(is_closer(hr1, result, ray.tmin, ray.tmax));
             auto b2 = any(is_closer(hr2, result, ray.tmin, ray.tmax));
@@ -382,6 +408,151 @@ inline auto intersect(
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Ray / BVH occlusion query
+//
+// Returns a mask that is set for the active rays that hit any primitive in
+// [ray.tmin..ray.tmax]. Unlike any-hit traversal, no hit records are assembled,
+// children are visited in a fixed order without comparing their distances, and
+// the whole packet terminates as soon as all active rays are occluded.
+//
+// The functions returning masks are force-inlined: GCC (12) may clobber the
+// upper half of a 256-bit mask union returned from an out-of-line function
+// with vzeroupper.
+//
+
+namespace detail
+{
+
+// Nested BVHs (e.g. instances in a top-level BVH)
+template <typename R, typename P, typename Intersector, typename M>
+VSNRAY_FUNC
+VSNRAY_FORCE_INLINE M occluded_prim(std::true_type /* is_any_bvh */, R const& ray, P const& prim, Intersector& isect, M const& active)
+{
+    return isect(occlusion_tag{}, ray, prim, active);
+}
+
+template <typename R, typename P, typename Intersector, typename M>
+VSNRAY_FUNC
+VSNRAY_FORCE_INLINE M occluded_prim(std::false_type /* is_any_bvh */, R const& ray, P const& prim, Intersector& isect, M const& active)
+{
+    auto hr = isect(ray, prim);
+    return active && hr.hit && hr.t >= ray.tmin && hr.t <= ray.tmax;
+}
+
+} // detail
+
+template <
+    typename R,
+    typename BVH,
+    typename = typename std::enable_if<is_any_bvh<BVH>::value>::type,
+    typename = typename std::enable_if<!is_any_bvh_inst<BVH>::value>::type,
+    typename Intersector,
+    typename T = typename R::scalar_type
+    >
+VSNRAY_FUNC
+VSNRAY_FORCE_INLINE auto occluded(
+        R const&                    ray,
+        BVH const&                  b,
+        Intersector&                isect,
+        simd::mask_type_t<T> const& active
+        )
+    -> simd::mask_type_t<T>
+{
+    using namespace detail;
+    using P = typename BVH::primitive_type;
+    using M = simd::mask_type_t<T>;
+
+    M result(false);
+
+    // Active rays that are not occluded yet
+    M todo = active;
+
+    if (!any(todo))
+    {
+        return result;
+    }
+
+    stack<32> st;
+    st.push(0); // address of root node
+
+    auto inv_dir = T(1.0) / ray.dir;
+
+next:
+    while (!st.empty())
+    {
+        auto node = b.node(st.pop());
+
+        while (!is_leaf(node))
+        {
+            auto children = &b.node(node.get_child(0));
+
+            auto hr1 = isect(ray, node_bounds(children[0], ray), inv_dir);
+            auto hr2 = isect(ray, node_bounds(children[1], ray), inv_dir);
+
+            auto b1 = any(todo && hr1.hit && hr1.tfar >= ray.tmin && hr1.tnear <= ray.tmax);
+            auto b2 = any(todo && hr2.hit && hr2.tfar >= ray.tmin && hr2.tnear <= ray.tmax);
+
+            if (b1 && b2)
+            {
+                st.push(node.get_child(1));
+                node = b.node(node.get_child(0));
+            }
+            else if (b1)
+            {
+                node = b.node(node.get_child(0));
+            }
+            else if (b2)
+            {
+                node = b.node(node.get_child(1));
+            }
+            else
+            {
+                goto next;
+            }
+        }
+
+        for (auto i = node.get_indices().first; i != node.get_indices().last; ++i)
+        {
+            result = result || occluded_prim(is_any_bvh<P>{}, ray, b.primitive(i), isect, todo);
+            todo = active && !result;
+
+            if (!any(todo))
+            {
+                return result;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+// Overload for instances ---------------------------------
+
+template <
+    typename R,
+    typename BVH,
+    typename = typename std::enable_if<is_any_bvh_inst<BVH>::value>::type,
+    typename Intersector,
+    typename T = typename R::scalar_type
+    >
+VSNRAY_FUNC
+VSNRAY_FORCE_INLINE auto occluded(
+        R const&                    ray,
+        BVH const&                  b,
+        Intersector&                isect,
+        simd::mask_type_t<T> const& active
+        )
+    -> simd::mask_type_t<T>
+{
+    R transformed_ray = ray;
+    b.transform_ray(transformed_ray);
+
+    return occluded(transformed_ray, b.get_ref(), isect, active);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Default intersect returns closest hit!
 //
@@ -432,6 +603,7 @@ inline auto intersect(
 }
 
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #undef VSNRAY_FULL_STACK_TRAVERSAL_
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <array>
+#include <memory>
+#include <thread>
 
 #ifdef __CUDACC__
 #include <thrust/device_vector.h>
@@ -16,15 +18,21 @@
 
 #include <visionaray/aligned_vector.h>
 #include <visionaray/morton.h>
+#include <visionaray/profiling.h>
 
 #ifdef _WIN32
 #include <intrin.h>
 #endif
 
+#include "../parallel_algorithm.h"
+#include "../thread_pool.h"
 #include "build_top_down.h"
+#include "vertex_array_iterator.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -446,8 +454,17 @@ struct lbvh_builder
 
     using leaf_infos = std::array<leaf_info, 2>;
 
+    // Temporary data, kept between builds
     aligned_vector<prim_ref> prim_refs;
     aligned_vector<aabb> prim_bounds;
+    aligned_vector<vec3> centroids;
+    paralgo::radix_sort_buffer<prim_ref> sort_buffer;
+
+    // Primitive order for BVHs without index array
+    aligned_vector<unsigned> leaf_indices;
+
+    // Worker threads for sorting, created on first use and kept between builds
+    std::unique_ptr<thread_pool> pool;
 
     VSNRAY_FUNC
     int find_split(prim_ref const* refs, int first, int last) const
@@ -487,13 +504,47 @@ struct lbvh_builder
     template <typename Tree, typename P>
     Tree build(Tree /* */, P* primitives, size_t num_prims, int max_leaf_size = -1)
     {
-        Tree tree(primitives, num_prims);
+        Tree tree;
+
+        rebuild(tree, primitives, num_prims, max_leaf_size);
+
+        return tree;
+    }
+
+    // Build into an existing tree, reuses the memory of the tree and the builder
+    template <typename Tree, typename P>
+    void rebuild(Tree& tree, P* primitives, size_t num_prims, int max_leaf_size = -1)
+    {
+        VSNRAY_PROFILE_SCOPE_ID("bvh build (LBVH)", static_cast<int64_t>(num_prims));
+
+        tree.reset(primitives, num_prims);
 
         detail::build_top_down(tree, *this, primitives, primitives + num_prims, max_leaf_size);
+    }
+
+    // Build over primitives that reference a shared vertex array (e.g. indexed triangles)
+    template <typename Tree, typename P, typename V>
+    Tree build(Tree /* */, P* primitives, size_t num_prims, V const* vertices, int max_leaf_size = -1)
+    {
+        Tree tree;
+
+        rebuild(tree, primitives, num_prims, vertices, max_leaf_size);
 
         return tree;
     }
 
+    template <typename Tree, typename P, typename V>
+    void rebuild(Tree& tree, P* primitives, size_t num_prims, V const* vertices, int max_leaf_size = -1)
+    {
+        VSNRAY_PROFILE_SCOPE_ID("bvh build (LBVH)", static_cast<int64_t>(num_prims));
+
+        tree.reset(primitives, num_prims);
+
+        auto first = detail::make_vertex_array_iterator(primitives, vertices);
+
+        detail::build_top_down(tree, *this, first, first + num_prims, max_leaf_size);
+    }
+
     template <typename I>
     leaf_info init(I first, I last)
     {
@@ -510,7 +561,7 @@ struct lbvh_builder
 
 
         prim_bounds.resize(last - first);
-        aligned_vector<vec3> centroids(last - first);
+        centroids.resize(last - first);
 
         int i = 0;
         for (auto it = first; it != last; ++it, ++i)
@@ -546,7 +597,19 @@ struct lbvh_builder
                     );
         }
 
-        std::stable_sort(prim_refs.begin(), prim_refs.end());
+        // Sort by Morton code; stable, so that the hierarchy is deterministic
+        if (!pool)
+        {
+            pool.reset(new thread_pool(std::max(1U, std::thread::hardware_concurrency())));
+        }
+
+        paralgo::radix_sort(
+                *pool,
+                prim_refs.begin(),
+                prim_refs.end(),
+                [](prim_ref const& ref) { return ref.morton_code; },
+                sort_buffer
+                );
 
         return { 0, static_cast<int>(last - first), scene_bounds };
     }
@@ -734,6 +797,7 @@ struct lbvh_builder
     bool use_spatial_splits;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_LBVH_H
@@ -9,9 +9,11 @@
 #include <type_traits>
 
 #include <visionaray/prim_traits.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename BVH>
 struct num_vertices<BVH, typename std::enable_if<is_any_bvh<BVH>::value>::type>
@@ -31,6 +33,7 @@ struct num_tex_coords<BVH, typename std::enable_if<is_any_bvh<BVH>::value>::type
 {
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_PRIM_TRAITS_H
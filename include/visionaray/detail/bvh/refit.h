@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -18,14 +19,58 @@
 #include "../range.h"
 #include "../stack.h"
 #include "../thread_pool.h"
+#include "vertex_array_iterator.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 struct bvh_refitter
 {
     template <typename Tree, typename P>
     void refit(Tree& tree, P* primitives, size_t num_prims, thread_pool& pool)
+    {
+        refit_impl(tree, primitives, num_prims, primitives, pool);
+    }
+
+    template <typename Tree, typename P>
+    void refit(Tree& tree, P* primitives, size_t num_prims)
+    {
+        refit(tree, primitives, num_prims, get_pool());
+    }
+
+    // Refit over primitives that reference a shared vertex array (e.g. indexed triangles)
+    template <typename Tree, typename P, typename V>
+    void refit(Tree& tree, P* primitives, size_t num_prims, V const* vertices, thread_pool& pool)
+    {
+        refit_impl(tree, primitives, num_prims, detail::make_vertex_array_iterator(primitives, vertices), pool);
+    }
+
+    template <typename Tree, typename P, typename V>
+    void refit(Tree& tree, P* primitives, size_t num_prims, V const* vertices)
+    {
+        refit(tree, primitives, num_prims, vertices, get_pool());
+    }
+
+    // Worker threads, created on first use and kept between refits
+    std::unique_ptr<thread_pool> pool;
+
+private:
+
+    thread_pool& get_pool()
+    {
+        if (!pool)
+        {
+            pool.reset(new thread_pool(std::max(1U, std::thread::hardware_concurrency())));
+        }
+
+        return *pool;
+    }
+
+    // Data is random access and yields the values passed to get_bounds()
+    template <typename Tree, typename P, typename Data>
+    void refit_impl(Tree& tree, P* primitives, size_t num_prims, Data data, thread_pool& pool)
     {
         static_assert(is_index_bvh<Tree>::value, "Type mismatch");
 
@@ -41,7 +86,7 @@ struct bvh_refitter
             {
                 for (size_t i = r.begin(); i < r.end(); ++i)
                 {
-                    prim_bounds[i] = get_bounds(primitives[i]);
+                    prim_bounds[i] = get_bounds(data[i]);
                 }
             });
 
@@ -104,18 +149,9 @@ struct bvh_refitter
                 }
             });
     }
-
-    template <typename Tree, typename P>
-    void refit(Tree& tree, P* primitives, size_t num_prims)
-    {
-        // TODO: this freezes when the pool is not static
-        // and the function is called repeatedly
-        static thread_pool pool(std::thread::hardware_concurrency());
-
-        refit(tree, primitives, num_prims, pool);
-    }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_REFIT_H
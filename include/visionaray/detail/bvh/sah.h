@@ -13,14 +13,21 @@
 #include <vector>
 
 #include <visionaray/math/aabb.h>
+#include <visionaray/math/curve.h>
 #include <visionaray/math/cylinder.h>
+#include <visionaray/math/indexed_triangle.h>
+#include <visionaray/math/precomputed_triangle.h>
 #include <visionaray/math/sphere.h>
 #include <visionaray/math/triangle.h>
+#include <visionaray/profiling.h>
 
 #include "build_top_down.h"
+#include "vertex_array_iterator.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -67,6 +74,74 @@ void split_primitive(aabb& L, aabb& R, float plane, int axis, basic_triangle<Dim
     detail::split_edge(L, R, v2, v0, plane, axis);
 }
 
+template <typename T, typename P>
+void split_primitive(aabb& L, aabb& R, float plane, int axis, basic_bound_indexed_triangle<T, P> const& prim)
+{
+    L.invalidate();
+    R.invalidate();
+
+    auto const& v1 = prim.vertices[prim.triangle.i1];
+    auto const& v2 = prim.vertices[prim.triangle.i2];
+    auto const& v3 = prim.vertices[prim.triangle.i3];
+
+    detail::split_edge(L, R, v1, v2, plane, axis);
+    detail::split_edge(L, R, v2, v3, plane, axis);
+    detail::split_edge(L, R, v3, v1, plane, axis);
+}
+
+template <typename T, typename P>
+void split_primitive(aabb& L, aabb& R, float plane, int axis, basic_precomputed_triangle<T, P> const& prim)
+{
+    split_primitive(L, R, plane, axis, prim.triangle());
+}
+
+template <typename T, typename P>
+void split_primitive(aabb& L, aabb& R, float plane, int axis, basic_curve<T, P> const& prim)
+{
+    L.invalidate();
+    R.invalidate();
+
+    // Clip the bounds of detail::curve_segments pieces
+    basic_curve<T, P> rest = prim;
+
+    for (int i = 0; i < detail::curve_segments; ++i)
+    {
+        basic_curve<T, P> piece = rest;
+
+        if (i < detail::curve_segments - 1)
+        {
+            subdivide(rest, T(1.0) / T(detail::curve_segments - i), piece, rest);
+        }
+
+        auto bounds = get_bounds(piece);
+
+        if (bounds.max[axis] <= plane)
+        {
+            L.insert(bounds);
+        }
+        else if (bounds.min[axis] >= plane)
+        {
+            R.insert(bounds);
+        }
+        else
+        {
+            aabb left = bounds;
+            left.max[axis] = plane;
+            L.insert(left);
+
+            aabb right = bounds;
+            right.min[axis] = plane;
+            R.insert(right);
+        }
+    }
+}
+
+template <typename T, typename P>
+void split_primitive(aabb& L, aabb& R, float plane, int axis, basic_oriented_curve<T, P> const& prim)
+{
+    split_primitive(L, R, plane, axis, static_cast<basic_curve<T, P> const&>(prim));
+}
+
 template <typename T, typename P>
 void split_primitive(aabb&, aabb&, float, int, basic_cylinder<T, P> const&)
 {
@@ -142,13 +217,14 @@ template <
     >
 void split_primitive(aabb& L, aabb& R, float plane, int axis, BVH const& bvh)
 {
-    VSNRAY_UNUSED(L);
-    VSNRAY_UNUSED(R);
     VSNRAY_UNUSED(plane);
     VSNRAY_UNUSED(axis);
     VSNRAY_UNUSED(bvh);
 
     assert(0 && "not implemented");
+
+    L.invalidate();
+    R.invalidate();
 }
 
 template <
@@ -167,11 +243,13 @@ void split_primitive(aabb& L, aabb& R, float plane, int axis, Primitive const& p
     static_assert(sizeof(Primitive) == 0, "not implemented");
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // namespace visionaray
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 struct binned_sah_builder
 {
@@ -197,13 +275,47 @@ struct binned_sah_builder
     template <typename Tree, typename P>
     Tree build(Tree /* */, P* primitives, size_t num_prims, int max_leaf_size = -1)
     {
-        Tree tree(primitives, num_prims);
+        Tree tree;
+
+        rebuild(tree, primitives, num_prims, max_leaf_size);
+
+        return tree;
+    }
+
+    // Build into an existing tree, reuses the memory of the tree and the builder
+    template <typename Tree, typename P>
+    void rebuild(Tree& tree, P* primitives, size_t num_prims, int max_leaf_size = -1)
+    {
+        VSNRAY_PROFILE_SCOPE_ID("bvh build (binned SAH)", static_cast<int64_t>(num_prims));
+
+        tree.reset(primitives, num_prims);
 
         detail::build_top_down(tree, *this, primitives, primitives + num_prims, max_leaf_size);
+    }
+
+    // Build over primitives that reference a shared vertex array (e.g. indexed triangles)
+    template <typename Tree, typename P, typename V>
+    Tree build(Tree /* */, P* primitives, size_t num_prims, V const* vertices, int max_leaf_size = -1)
+    {
+        Tree tree;
+
+        rebuild(tree, primitives, num_prims, vertices, max_leaf_size);
 
         return tree;
     }
 
+    template <typename Tree, typename P, typename V>
+    void rebuild(Tree& tree, P* primitives, size_t num_prims, V const* vertices, int max_leaf_size = -1)
+    {
+        VSNRAY_PROFILE_SCOPE_ID("bvh build (binned SAH)", static_cast<int64_t>(num_prims));
+
+        tree.reset(primitives, num_prims);
+
+        auto first = detail::make_vertex_array_iterator(primitives, vertices);
+
+        detail::build_top_down(tree, *this, first, first + num_prims, max_leaf_size);
+    }
+
     template <typename I>
     static void init(prim_refs& refs, aabb& prim_bounds, aabb& cent_bounds, I first, I last)
     {
@@ -466,6 +578,10 @@ struct binned_sah_builder
     template <typename Data>
     static void split_reference(prim_ref& L, prim_ref& R, prim_ref const& ref, float plane, int axis, Data const& data)
     {
+        // Not all split_primitive() overloads assign the bounds (e.g. BVH instances)
+        L.bounds.invalidate();
+        R.bounds.invalidate();
+
         split_primitive(L.bounds, R.bounds, plane, axis, data[ref.index]);
 
         // Clip with current bounds
@@ -493,7 +609,11 @@ struct binned_sah_builder
         {
             auto plane = pr.unproject(i + 1);
 
-            aabb L, R;
+            aabb L;
+            aabb R;
+
+            L.invalidate();
+            R.invalidate();
 
             // Split triangle into left and right bounds
             split_primitive(L, R, plane, pr.axis, data[ref.index]);
@@ -659,6 +779,8 @@ struct binned_sah_builder
 
     // List of primitives references (will be modified during build)
     prim_refs refs;
+    // Primitive order for BVHs without index array
+    aligned_vector<unsigned> leaf_indices;
     // Surface area threshold for spatial splits
     float sa_threshold = 1.0e+38f;
     // Alpha (relative threshold)
@@ -752,7 +874,10 @@ struct binned_sah_builder
 
         bool do_spatial_split = false;
 
-        if (use_spatial_splits)
+        // BVH instances can't be split, build the top level with object splits only
+        using primitive_type = typename std::decay<decltype(data[0])>::type;
+
+        if (use_spatial_splits && !is_any_bvh<primitive_type>::value)
         {
             auto sa = safe_surface_area(intersect(sr.prim_bounds[0], sr.prim_bounds[1]));
 
@@ -806,6 +931,7 @@ struct binned_sah_builder
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_SAH_H
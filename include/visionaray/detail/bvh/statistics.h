@@ -7,9 +7,11 @@
 #define VSNRAY_DETAIL_BVH_STATISTICS_H 1
 
 #include <type_traits>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Compute the SAH cost for a BVH
@@ -104,6 +106,7 @@ inline float sah_cost(BVH const& b, bvh_node const& n, float ci = 1.2f, float cp
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_STATISTICS_H
@@ -9,9 +9,11 @@
 #include <algorithm>
 
 #include "../stack.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Traverse whole acceleration data structures
@@ -168,6 +170,7 @@ void traverse_parents(B const& b, N const& node, F func)
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_BVH_TRAVERSE_H
@@ -0,0 +1,95 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_DETAIL_BVH_VERTEX_ARRAY_ITERATOR_H
+#define VSNRAY_DETAIL_BVH_VERTEX_ARRAY_ITERATOR_H 1
+
+#include <cstddef>
+#include <utility>
+
+#include "../isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+//-------------------------------------------------------------------------------------------------
+// Iterator over primitives that reference a shared vertex array (e.g. indexed triangles)
+//
+// Dereferencing binds the vertex array to the primitive (see bind_vertices()), so that
+// the builders' and refitter's calls to get_bounds() and split_primitive() can access
+// the vertex positions. Supports the subset of random access the builders use
+//
+
+template <typename P, typename V>
+class vertex_array_iterator
+{
+public:
+
+    vertex_array_iterator(P const* prim, V const* vertices)
+        : prim_(prim)
+        , vertices_(vertices)
+    {
+    }
+
+    auto operator*() const
+        -> decltype( bind_vertices(std::declval<P const&>(), std::declval<V const*>()) )
+    {
+        return bind_vertices(*prim_, vertices_);
+    }
+
+    auto operator[](std::ptrdiff_t i) const
+        -> decltype( bind_vertices(std::declval<P const&>(), std::declval<V const*>()) )
+    {
+        return bind_vertices(prim_[i], vertices_);
+    }
+
+    vertex_array_iterator& operator++()
+    {
+        ++prim_;
+        return *this;
+    }
+
+    friend vertex_array_iterator operator+(vertex_array_iterator it, std::ptrdiff_t n)
+    {
+        it.prim_ += n;
+        return it;
+    }
+
+    friend std::ptrdiff_t operator-(vertex_array_iterator const& a, vertex_array_iterator const& b)
+    {
+        return a.prim_ - b.prim_;
+    }
+
+    friend bool operator==(vertex_array_iterator const& a, vertex_array_iterator const& b)
+    {
+        return a.prim_ == b.prim_;
+    }
+
+    friend bool operator!=(vertex_array_iterator const& a, vertex_array_iterator const& b)
+    {
+        return a.prim_ != b.prim_;
+    }
+
+private:
+
+    P const* prim_;
+    V const* vertices_;
+
+};
+
+template <typename P, typename V>
+inline vertex_array_iterator<P, V> make_vertex_array_iterator(P const* prim, V const* vertices)
+{
+    return vertex_array_iterator<P, V>(prim, vertices);
+}
+
+} // detail
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#endif // VSNRAY_DETAIL_BVH_VERTEX_ARRAY_ITERATOR_H
@@ -18,10 +18,12 @@
 
 #include "spd/blackbody.h"
 #include "macros.h"
+#include "isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // CIE 1931 color matching functions
@@ -401,6 +403,7 @@ inline void convert(
         );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 
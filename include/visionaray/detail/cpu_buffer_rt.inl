@@ -3,69 +3,96 @@
 
 #include <algorithm>
 
+#include "../profiling.h"
 #include "color_conversion.h"
+#include "isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // cpu_buffer_rt
 //
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::cpu_buffer_rt()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::cpu_buffer_rt()
     : compositor(nullptr)
 {
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::~cpu_buffer_rt() = default;
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::~cpu_buffer_rt() = default;
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color()
 {
     return color_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth()
 {
     return depth_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum()
 {
     return accum_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color() const
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::albedo()
+{
+    return albedo_buffer.data();
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::normal_depth()
+{
+    return normal_depth_buffer.data();
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color() const
 {
     return color_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth() const
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth() const
 {
     return depth_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum() const
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum() const
 {
     return accum_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::ref_type cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::ref()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::albedo() const
 {
-    return { color(), depth(), accum(), width(), height() };
+    return albedo_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_color_buffer(vec4 const& c)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type const* cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::normal_depth() const
+{
+    return normal_depth_buffer.data();
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::ref_type cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::ref()
+{
+    return { color(), depth(), accum(), width(), height(), albedo(), normal_depth() };
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_color_buffer(vec4 const& c)
 {
     // Convert from RGBA32F to internal color format
     color_type cc;
@@ -79,8 +106,8 @@ void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_color_buffer(ve
     std::fill(color_buffer.begin(), color_buffer.end(), cc);
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_depth_buffer(float d)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_depth_buffer(float d)
 {
     // Convert from DEPTH32F to internal depth format
     depth_type dd;
@@ -94,11 +121,11 @@ void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_depth_buffer(fl
     std::fill(depth_buffer.begin(), depth_buffer.end(), dd);
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_accum_buffer(vec4 const& c)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_accum_buffer(vec4 const& c)
 {
-    // Convert from RGBA32F to internal color format
-    color_type cc;
+    // Convert from RGBA32F to internal accum format
+    accum_type cc;
     convert(
         pixel_format_constant<AccumFormat>{},
         pixel_format_constant<PF_RGBA32F>{},
@@ -109,18 +136,33 @@ void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_accum_buffer(ve
     std::fill(accum_buffer.begin(), accum_buffer.end(), cc);
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::begin_frame()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_feature_buffers()
+{
+    feature_type zero;
+    convert(
+        pixel_format_constant<FeatureFormat>{},
+        pixel_format_constant<PF_RGBA32F>{},
+        zero,
+        vec4(0.0f)
+        );
+
+    std::fill(albedo_buffer.begin(), albedo_buffer.end(), zero);
+    std::fill(normal_depth_buffer.begin(), normal_depth_buffer.end(), zero);
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::begin_frame()
 {
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::end_frame()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::end_frame()
 {
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::resize(int w, int h)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::resize(int w, int h)
 {
     render_target::resize(w, h);
 
@@ -139,6 +181,12 @@ void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::resize(int w, int h)
         accum_buffer.resize(w * h);
     }
 
+    if (FeatureFormat != PF_UNSPECIFIED)
+    {
+        albedo_buffer.resize(w * h);
+        normal_depth_buffer.resize(w * h);
+    }
+
     if (!compositor)
     {
         compositor.reset(new gl::depth_compositor);
@@ -159,9 +207,11 @@ void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::resize(int w, int h)
     }
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::display_color_buffer() const
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::display_color_buffer() const
 {
+    VSNRAY_PROFILE_SCOPE("display_color_buffer");
+
     if (DepthFormat != PF_UNSPECIFIED)
     {
         // Update color texture
@@ -207,4 +257,5 @@ void cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::display_color_buffer(
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
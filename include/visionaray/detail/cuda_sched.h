@@ -12,9 +12,11 @@
 
 #include <visionaray/math/forward.h>
 #include <visionaray/math/vector.h>
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // NVIDIA CUDA-based scheduler
@@ -45,6 +47,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "cuda_sched.inl"
@@ -12,9 +12,11 @@
 #include "../make_random_seed.h"
 #include "../packet_traits.h"
 #include "sched_common.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -245,4 +247,5 @@ void cuda_sched<R>::frame(K kernel, SP sched_params, size_t smem, cudaStream_t c
     ++frame_id_;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
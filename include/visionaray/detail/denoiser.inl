@@ -0,0 +1,474 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../math/simd/simd.h"
+#include "../math/detail/math.h"
+#include "color_conversion.h"
+#include "parallel_for.h"
+#include "range.h"
+#include "isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+namespace atrous
+{
+
+//-------------------------------------------------------------------------------------------------
+// Scalar and SIMD helpers
+//
+
+inline float load_plane(float /* */, float const* ptr)
+{
+    return *ptr;
+}
+
+inline simd::float4 load_plane(simd::float4 /* */, float const* ptr)
+{
+    return simd::load_unaligned(ptr);
+}
+
+inline void store_plane(float* ptr, float value)
+{
+    *ptr = value;
+}
+
+inline void store_plane(float* ptr, simd::float4 const& value)
+{
+    simd::store_unaligned(ptr, value);
+}
+
+inline float exp_neg(float x)
+{
+    return std::exp(-x);
+}
+
+inline simd::float4 exp_neg(simd::float4 const& x)
+{
+    // simd::exp() does not handle denormals
+    return simd::exp(-min(x, simd::float4(80.0f)));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// One a-trous pass
+//
+
+struct pass_params
+{
+    float const*    color[3];
+    float const*    features[4];
+    float*          dst[3];
+
+    int             width;
+    int             height;
+    int             step;
+
+    float           inv_sigma_color2;
+    float           inv_sigma_normal2;
+    float           inv_sigma_depth;
+};
+
+// Filter the pixels [x..x+N) of row y, N is the SIMD width of S. If clip
+// is false, all taps must be inside the image horizontally.
+template <typename S>
+inline void filter_pixels(pass_params const& p, int x, int y, bool clip)
+{
+    static const float h[5] = { 1.0f / 16.0f, 1.0f / 4.0f, 3.0f / 8.0f, 1.0f / 4.0f, 1.0f / 16.0f };
+
+    size_t center = static_cast<size_t>(y) * p.width + x;
+
+    S r = load_plane(S{}, p.color[0] + center);
+    S g = load_plane(S{}, p.color[1] + center);
+    S b = load_plane(S{}, p.color[2] + center);
+    S nx = load_plane(S{}, p.features[0] + center);
+    S ny = load_plane(S{}, p.features[1] + center);
+    S nz = load_plane(S{}, p.features[2] + center);
+    S z = load_plane(S{}, p.features[3] + center);
+
+    S lum = r * S(0.2126f) + g * S(0.7152f) + b * S(0.0722f);
+    S inv_z = S(p.inv_sigma_depth) / (z * S(static_cast<float>(p.step)) + S(1e-6f));
+
+    S sum_w(0.0f);
+    S sum_r(0.0f);
+    S sum_g(0.0f);
+    S sum_b(0.0f);
+
+    for (int j = -2; j <= 2; ++j)
+    {
+        int yy = y + j * p.step;
+
+        if (yy < 0 || yy >= p.height)
+        {
+            continue;
+        }
+
+        for (int i = -2; i <= 2; ++i)
+        {
+            int xx = x + i * p.step;
+
+            if (clip && (xx < 0 || xx >= p.width))
+            {
+                continue;
+            }
+
+            size_t index = static_cast<size_t>(yy) * p.width + xx;
+
+            S qr = load_plane(S{}, p.color[0] + index);
+            S qg = load_plane(S{}, p.color[1] + index);
+            S qb = load_plane(S{}, p.color[2] + index);
+            S qz = load_plane(S{}, p.features[3] + index);
+
+            S dr = r - qr;
+            S dg = g - qg;
+            S db = b - qb;
+            S dnx = nx - load_plane(S{}, p.features[0] + index);
+            S dny = ny - load_plane(S{}, p.features[1] + index);
+            S dnz = nz - load_plane(S{}, p.features[2] + index);
+
+            S mean_lum = (lum + qr * S(0.2126f) + qg * S(0.7152f) + qb * S(0.0722f)) * S(0.5f);
+
+            S dist = (dr * dr + dg * dg + db * db) * S(p.inv_sigma_color2) / (mean_lum * mean_lum + S(1e-4f))
+                   + (dnx * dnx + dny * dny + dnz * dnz) * S(p.inv_sigma_normal2)
+                   + abs(z - qz) * inv_z;
+
+            // No contribution from pixels without a hit
+            S w = select(qz > S(0.0f), S(h[i + 2] * h[j + 2]) * exp_neg(dist), S(0.0f));
+
+            sum_w += w;
+            sum_r += w * qr;
+            sum_g += w * qg;
+            sum_b += w * qb;
+        }
+    }
+
+    // Pixels without a hit are not filtered
+    S inv_w = S(1.0f) / max(sum_w, S(1e-20f));
+    auto hit = z > S(0.0f);
+
+    store_plane(p.dst[0] + center, select(hit, sum_r * inv_w, r));
+    store_plane(p.dst[1] + center, select(hit, sum_g * inv_w, g));
+    store_plane(p.dst[2] + center, select(hit, sum_b * inv_w, b));
+}
+
+inline void filter_row(pass_params const& p, int y)
+{
+    int border = 2 * p.step;
+    int x = 0;
+
+    // Left border, interior in groups of four, right border
+    for (; x < min(border, p.width); ++x)
+    {
+        filter_pixels<float>(p, x, y, true);
+    }
+
+    for (; x + 4 + border <= p.width; x += 4)
+    {
+        filter_pixels<simd::float4>(p, x, y, false);
+    }
+
+    for (; x < p.width; ++x)
+    {
+        filter_pixels<float>(p, x, y, true);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Denoise source buffer of a render target
+//
+
+template <typename RenderTarget>
+inline vec4 const* source_buffer(RenderTarget& rt, std::true_type /* has accum buffer */)
+{
+    return rt.accum();
+}
+
+template <typename RenderTarget>
+inline vec4 const* source_buffer(RenderTarget& rt, std::false_type /* has accum buffer */)
+{
+    return rt.color();
+}
+
+// Treat small albedos as 1, illumination would be amplified otherwise
+inline vec3 safe_albedo(vec4 const& albedo)
+{
+    return vec3(
+            albedo.x > 1e-3f ? albedo.x : 1.0f,
+            albedo.y > 1e-3f ? albedo.y : 1.0f,
+            albedo.z > 1e-3f ? albedo.z : 1.0f
+            );
+}
+
+} // atrous
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// atrous_denoiser
+//
+
+inline atrous_denoiser::atrous_denoiser(unsigned num_threads)
+    : pool_(max(num_threads, 1U))
+{
+}
+
+inline void atrous_denoiser::set_num_iterations(unsigned num_iterations)
+{
+    num_iterations_ = num_iterations;
+}
+
+inline unsigned atrous_denoiser::num_iterations() const
+{
+    return num_iterations_;
+}
+
+inline void atrous_denoiser::set_sigma_color(float sigma)
+{
+    sigma_color_ = sigma;
+}
+
+inline float atrous_denoiser::sigma_color() const
+{
+    return sigma_color_;
+}
+
+inline void atrous_denoiser::set_sigma_normal(float sigma)
+{
+    sigma_normal_ = sigma;
+}
+
+inline float atrous_denoiser::sigma_normal() const
+{
+    return sigma_normal_;
+}
+
+inline void atrous_denoiser::set_sigma_depth(float sigma)
+{
+    sigma_depth_ = sigma;
+}
+
+inline float atrous_denoiser::sigma_depth() const
+{
+    return sigma_depth_;
+}
+
+inline void atrous_denoiser::set_demodulate_albedo(bool demodulate)
+{
+    demodulate_albedo_ = demodulate;
+}
+
+inline bool atrous_denoiser::demodulate_albedo() const
+{
+    return demodulate_albedo_;
+}
+
+template <pixel_format DF>
+inline void atrous_denoiser::filter(
+        pixel_format_constant<DF>                   /* */,
+        typename pixel_traits<DF>::type*            dst,
+        vec4 const*                                 src,
+        vec4 const*                                 albedo,
+        vec4 const*                                 normal_depth,
+        int                                         width,
+        int                                         height
+        )
+{
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    prepare(src, albedo, normal_depth, width, height);
+
+    for (unsigned i = 0; i < num_iterations_; ++i)
+    {
+        iterate(i, width, height);
+
+        for (int c = 0; c < 3; ++c)
+        {
+            std::swap(color_[c], scratch_[c]);
+        }
+    }
+
+
+    // Multiply by albedo, convert to output format
+
+    bool demodulate = demodulate_albedo_;
+
+    parallel_for(
+        pool_,
+        tiled_range1d<int>(0, height, 16),
+        [&](range1d<int> const& rows)
+        {
+            for (int y = rows.begin(); y != rows.end(); ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    size_t i = static_cast<size_t>(y) * width + x;
+
+                    vec3 rgb(color_[0][i], color_[1][i], color_[2][i]);
+
+                    if (demodulate)
+                    {
+                        rgb *= detail::atrous::safe_albedo(albedo[i]);
+                    }
+
+                    vec4 result(rgb, src[i].w);
+
+                    convert(
+                        pixel_format_constant<DF>{},
+                        pixel_format_constant<PF_RGBA32F>{},
+                        dst[i],
+                        result
+                        );
+                }
+            }
+        });
+}
+
+inline void atrous_denoiser::filter(
+        vec4*                                       dst,
+        vec4 const*                                 src,
+        vec4 const*                                 albedo,
+        vec4 const*                                 normal_depth,
+        int                                         width,
+        int                                         height
+        )
+{
+    filter(pixel_format_constant<PF_RGBA32F>{}, dst, src, albedo, normal_depth, width, height);
+}
+
+template <typename RenderTarget>
+inline void atrous_denoiser::filter(RenderTarget& rt)
+{
+    using ref_type = typename RenderTarget::ref_type;
+
+    constexpr bool has_accum = ref_type::accum_format != PF_UNSPECIFIED;
+
+    static_assert(
+            ref_type::feature_format == PF_RGBA32F,
+            "Denoising requires RGBA32F feature buffers"
+            );
+
+    static_assert(
+            has_accum ? ref_type::accum_format == PF_RGBA32F : ref_type::color_format == PF_RGBA32F,
+            "Denoising requires an RGBA32F accumulation or color buffer"
+            );
+
+    vec4 const* src = detail::atrous::source_buffer(rt, std::integral_constant<bool, has_accum>{});
+
+    filter(
+        pixel_format_constant<ref_type::color_format>{},
+        rt.color(),
+        src,
+        rt.albedo(),
+        rt.normal_depth(),
+        rt.width(),
+        rt.height()
+        );
+}
+
+inline void atrous_denoiser::prepare(
+        vec4 const*                                 src,
+        vec4 const*                                 albedo,
+        vec4 const*                                 normal_depth,
+        int                                         width,
+        int                                         height
+        )
+{
+    size_t size = static_cast<size_t>(width) * height;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        color_[c].resize(size);
+        scratch_[c].resize(size);
+    }
+
+    for (int c = 0; c < 4; ++c)
+    {
+        features_[c].resize(size);
+    }
+
+    bool demodulate = demodulate_albedo_;
+
+    parallel_for(
+        pool_,
+        tiled_range1d<int>(0, height, 16),
+        [&](range1d<int> const& rows)
+        {
+            for (int y = rows.begin(); y != rows.end(); ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    size_t i = static_cast<size_t>(y) * width + x;
+
+                    vec3 rgb = src[i].xyz();
+
+                    if (demodulate)
+                    {
+                        rgb /= detail::atrous::safe_albedo(albedo[i]);
+                    }
+
+                    // Blending may have shortened the normals
+                    vec3 n = normal_depth[i].xyz();
+                    float len = length(n);
+                    n = len > 0.0f ? n / len : vec3(0.0f);
+
+                    color_[0][i] = rgb.x;
+                    color_[1][i] = rgb.y;
+                    color_[2][i] = rgb.z;
+                    features_[0][i] = n.x;
+                    features_[1][i] = n.y;
+                    features_[2][i] = n.z;
+                    features_[3][i] = normal_depth[i].w;
+                }
+            }
+        });
+}
+
+inline void atrous_denoiser::iterate(unsigned iteration, int width, int height)
+{
+    float sigma_color = sigma_color_ / static_cast<float>(1 << iteration);
+
+    detail::atrous::pass_params params;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        params.color[c] = color_[c].data();
+        params.dst[c] = scratch_[c].data();
+    }
+
+    for (int c = 0; c < 4; ++c)
+    {
+        params.features[c] = features_[c].data();
+    }
+
+    params.width = width;
+    params.height = height;
+    params.step = 1 << iteration;
+    params.inv_sigma_color2 = 1.0f / (sigma_color * sigma_color);
+    params.inv_sigma_normal2 = 1.0f / (sigma_normal_ * sigma_normal_);
+    params.inv_sigma_depth = 1.0f / sigma_depth_;
+
+    parallel_for(
+        pool_,
+        tiled_range1d<int>(0, height, 4),
+        [&](range1d<int> const& rows)
+        {
+            for (int y = rows.begin(); y != rows.end(); ++y)
+            {
+                detail::atrous::filter_row(params, y);
+            }
+        });
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../math/constants.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // directional_light members
@@ -97,4 +99,5 @@ inline void directional_light<T>::set_angular_diameter(T const& ad)
     angular_diameter_ = ad;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
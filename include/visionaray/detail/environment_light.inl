@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T, typename Texture>
 template <typename U>
@@ -79,4 +82,5 @@ environment_light<T, Texture>::operator bool() const
     return static_cast<bool>(texture_);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
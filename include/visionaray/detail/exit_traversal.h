@@ -8,9 +8,11 @@
 
 #include "macros.h"
 #include "tags.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -57,6 +59,7 @@ struct exit_traversal<AnyHit>
 };
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_EXIT_TRAVERSAL_H
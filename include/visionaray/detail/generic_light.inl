@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -102,4 +105,5 @@ struct generic_light<T, Ts...>::position_visitor
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -3,9 +3,11 @@
 
 #include "../array.h"
 #include "../material.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -326,4 +328,5 @@ inline array<visionaray::generic_material<Ts...>, 16> unpack(generic_material<16
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <visionaray/math/intersect.h> // hit_record
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -129,4 +131,5 @@ void split_primitive(aabb& L, aabb& R, float plane, int axis, generic_primitive<
     apply_visitor( detail::generic_primitive_split_visitor(L, R, plane, axis), primitive );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
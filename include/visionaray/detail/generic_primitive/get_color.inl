@@ -4,9 +4,11 @@
 #include <iterator>
 
 #include <visionaray/get_color.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -76,4 +78,5 @@ inline auto get_color(
     return apply_visitor( visitor, prim );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -8,9 +8,11 @@
 #include <visionaray/get_shading_normal.h>
 #include <visionaray/prim_traits.h>
 #include <visionaray/variant.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -201,4 +203,5 @@ inline auto get_shading_normal(
     return apply_visitor(visitor, prim);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
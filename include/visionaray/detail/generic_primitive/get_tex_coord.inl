@@ -6,9 +6,11 @@
 
 #include <visionaray/get_tex_coord.h>
 #include <visionaray/prim_traits.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -92,4 +94,5 @@ inline auto get_tex_coord(
     return apply_visitor( visitor, prim );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
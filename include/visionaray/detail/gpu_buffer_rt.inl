@@ -5,9 +5,12 @@
 
 #include "../cuda/fill.h"
 #include "../cpu_buffer_rt.h"
+#include "../profiling.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
 typename gpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color_type* gpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color()
@@ -135,6 +138,8 @@ void gpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::resize(int w, int h)
 template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
 void gpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::display_color_buffer() const
 {
+    VSNRAY_PROFILE_SCOPE("display_color_buffer");
+
     cpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat> rt;
 
     rt.resize(width(), height());
@@ -159,4 +164,5 @@ void gpu_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::display_color_buffer(
     rt.display_color_buffer();
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -0,0 +1,30 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_DETAIL_ISA_NAMESPACE_H
+#define VSNRAY_DETAIL_ISA_NAMESPACE_H 1
+
+//-------------------------------------------------------------------------------------------------
+// Per-ISA inline namespace
+//
+// visionaray_add_isa_sources() compiles translation units with VSNRAY_ISA_NAMESPACE
+// set to a name per instruction set (e.g. isa_avx2). The header-only parts of the
+// library are then declared in the inline namespace visionaray::<name>, so that
+// inline functions and template instances compiled for different instruction sets
+// have distinct symbols and the linker cannot merge them (see isa_dispatch.h).
+//
+// Headers that declare functions compiled into the library (cpu_features.h,
+// pixel_format.h, profiling.h, gl/ and cuda/) don't use the namespace.
+//
+
+#ifdef VSNRAY_ISA_NAMESPACE
+#define VSNRAY_ISA_NAMESPACE_BEGIN inline namespace VSNRAY_ISA_NAMESPACE {
+#define VSNRAY_ISA_NAMESPACE_END }
+#else
+#define VSNRAY_ISA_NAMESPACE_BEGIN
+#define VSNRAY_ISA_NAMESPACE_END
+#endif
+
+#endif // VSNRAY_DETAIL_ISA_NAMESPACE_H
@@ -0,0 +1,431 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cassert>
+
+#include "../math/detail/math.h"
+#include "../math/intersect.h"
+#include "../math/limits.h"
+#include "parallel_for.h"
+#include "range.h"
+#include "isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+//-------------------------------------------------------------------------------------------------
+// Range of voxel values reconstructed inside a macrocell
+//
+
+template <typename Volume>
+inline vec2 macrocell_value_range(Volume const& volume, vec3i const& index, vec3i const& dims)
+{
+    vec3i vox_size(volume.width(), volume.height(), volume.depth());
+
+    // Voxels overlapped by the cell, extended by one voxel
+    // in each direction to account for interpolation
+    vec3i first = (index * vox_size) / dims - vec3i(1);
+    vec3i last = ((index + vec3i(1)) * vox_size + dims - vec3i(1)) / dims;
+
+    first = max(first, vec3i(0));
+    last = min(last, vox_size - vec3i(1));
+
+    vec2 range(numeric_limits<float>::max(), numeric_limits<float>::lowest());
+
+    for (int z = first.z; z <= last.z; ++z)
+    {
+        for (int y = first.y; y <= last.y; ++y)
+        {
+            for (int x = first.x; x <= last.x; ++x)
+            {
+                size_t i = z * size_t(vox_size.x) * vox_size.y + y * size_t(vox_size.x) + x;
+                float value = static_cast<float>(volume.data()[i]);
+
+                range.x = min(range.x, value);
+                range.y = max(range.y, value);
+            }
+        }
+    }
+
+    return range;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Range of function values sampled inside a macrocell
+//
+
+template <typename Func>
+inline vec2 macrocell_function_range(Func& func, aabb const& cell, vec3i const& samples)
+{
+    vec3 delta = cell.size() / vec3(max(samples - vec3i(1), vec3i(1)));
+
+    vec2 range(numeric_limits<float>::max(), numeric_limits<float>::lowest());
+
+    for (int z = 0; z < samples.z; ++z)
+    {
+        for (int y = 0; y < samples.y; ++y)
+        {
+            for (int x = 0; x < samples.x; ++x)
+            {
+                float value = static_cast<float>(func(cell.min + vec3(x, y, z) * delta));
+
+                range.x = min(range.x, value);
+                range.y = max(range.y, value);
+            }
+        }
+    }
+
+    return range;
+}
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// macrocell_grid members
+//
+
+inline macrocell_grid::macrocell_grid(vec3i const& dims, aabb const& bounds)
+    : dims_(dims)
+    , bounds_(bounds)
+    , value_ranges_(dims.x * size_t(dims.y) * dims.z, vec2(0.0f))
+    , majorants_(dims.x * size_t(dims.y) * dims.z, 0.0f)
+{
+    assert(dims.x > 0 && dims.y > 0 && dims.z > 0);
+}
+
+template <typename Volume>
+inline void macrocell_grid::build(Volume const& volume)
+{
+    for (int z = 0; z < dims_.z; ++z)
+    {
+        for (int y = 0; y < dims_.y; ++y)
+        {
+            for (int x = 0; x < dims_.x; ++x)
+            {
+                vec3i index(x, y, z);
+                value_ranges_[linear_index(index)] = detail::macrocell_value_range(volume, index, dims_);
+            }
+        }
+    }
+}
+
+template <typename Volume>
+inline void macrocell_grid::build(Volume const& volume, thread_pool& pool)
+{
+    // One work item per z-slab of cells
+    parallel_for(pool, range1d<int>(0, dims_.z), [&](int z)
+    {
+        for (int y = 0; y < dims_.y; ++y)
+        {
+            for (int x = 0; x < dims_.x; ++x)
+            {
+                vec3i index(x, y, z);
+                value_ranges_[linear_index(index)] = detail::macrocell_value_range(volume, index, dims_);
+            }
+        }
+    });
+}
+
+template <typename Func>
+inline void macrocell_grid::build_from_function(
+        Func func,
+        vec3i const& samples_per_cell,
+        float lipschitz
+        )
+{
+    for (int z = 0; z < dims_.z; ++z)
+    {
+        for (int y = 0; y < dims_.y; ++y)
+        {
+            for (int x = 0; x < dims_.x; ++x)
+            {
+                vec3i index(x, y, z);
+                value_ranges_[linear_index(index)] = detail::macrocell_function_range(
+                        func,
+                        cell_bounds(index),
+                        samples_per_cell
+                        );
+            }
+        }
+    }
+
+    pad_sampled_ranges(samples_per_cell, lipschitz);
+}
+
+template <typename Func>
+inline void macrocell_grid::build_from_function(
+        Func func,
+        vec3i const& samples_per_cell,
+        thread_pool& pool,
+        float lipschitz
+        )
+{
+    parallel_for(pool, range1d<int>(0, dims_.z), [&](int z)
+    {
+        for (int y = 0; y < dims_.y; ++y)
+        {
+            for (int x = 0; x < dims_.x; ++x)
+            {
+                vec3i index(x, y, z);
+                value_ranges_[linear_index(index)] = detail::macrocell_function_range(
+                        func,
+                        cell_bounds(index),
+                        samples_per_cell
+                        );
+            }
+        }
+    });
+
+    pad_sampled_ranges(samples_per_cell, lipschitz);
+}
+
+template <typename RangeFunc>
+inline void macrocell_grid::build_from_range_function(RangeFunc func)
+{
+    for (int z = 0; z < dims_.z; ++z)
+    {
+        for (int y = 0; y < dims_.y; ++y)
+        {
+            for (int x = 0; x < dims_.x; ++x)
+            {
+                vec3i index(x, y, z);
+                value_ranges_[linear_index(index)] = func(cell_bounds(index));
+            }
+        }
+    }
+}
+
+template <typename RangeFunc>
+inline void macrocell_grid::build_from_range_function(RangeFunc func, thread_pool& pool)
+{
+    parallel_for(pool, range1d<int>(0, dims_.z), [&](int z)
+    {
+        for (int y = 0; y < dims_.y; ++y)
+        {
+            for (int x = 0; x < dims_.x; ++x)
+            {
+                vec3i index(x, y, z);
+                value_ranges_[linear_index(index)] = func(cell_bounds(index));
+            }
+        }
+    });
+}
+
+template <typename Transfunc>
+inline void macrocell_grid::compute_opacity_majorants(Transfunc const& transfunc, vec2 const& value_range)
+{
+    int n = static_cast<int>(transfunc.width());
+    float scale = 1.0f / (value_range.y - value_range.x);
+
+    compute_majorants([&](vec2 const& range)
+    {
+        // Texels that contribute to linearly interpolated lookups in [lo..hi]
+        float lo = (range.x - value_range.x) * scale;
+        float hi = (range.y - value_range.x) * scale;
+
+        int first = clamp(static_cast<int>(floor(lo * n - 0.5f)), 0, n - 1);
+        int last = clamp(static_cast<int>(floor(hi * n - 0.5f)) + 1, 0, n - 1);
+
+        float result = 0.0f;
+
+        for (int i = first; i <= last; ++i)
+        {
+            result = max(result, static_cast<float>(transfunc.data()[i].w));
+        }
+
+        return result;
+    });
+}
+
+template <typename Func>
+inline void macrocell_grid::compute_majorants(Func func)
+{
+    for (size_t i = 0; i < value_ranges_.size(); ++i)
+    {
+        majorants_[i] = func(value_ranges_[i]);
+    }
+}
+
+inline vec3i macrocell_grid::dims() const
+{
+    return dims_;
+}
+
+inline aabb const& macrocell_grid::bounds() const
+{
+    return bounds_;
+}
+
+inline vec3 macrocell_grid::cell_size() const
+{
+    return bounds_.size() / vec3(dims_);
+}
+
+inline vec3i macrocell_grid::cell_index(vec3 const& pos) const
+{
+    vec3i index((pos - bounds_.min) / cell_size());
+    return clamp(index, vec3i(0), dims_ - vec3i(1));
+}
+
+inline aabb macrocell_grid::cell_bounds(vec3i const& index) const
+{
+    vec3 cs = cell_size();
+    vec3 min = bounds_.min + vec3(index) * cs;
+    return aabb(min, min + cs);
+}
+
+inline vec2 macrocell_grid::value_range(vec3i const& index) const
+{
+    return value_ranges_[linear_index(index)];
+}
+
+inline float macrocell_grid::majorant(vec3i const& index) const
+{
+    return majorants_[linear_index(index)];
+}
+
+inline float macrocell_grid::max_majorant() const
+{
+    float result = 0.0f;
+
+    for (auto m : majorants_)
+    {
+        result = max(result, m);
+    }
+
+    return result;
+}
+
+inline size_t macrocell_grid::linear_index(vec3i const& index) const
+{
+    assert(index.x >= 0 && index.x < dims_.x);
+    assert(index.y >= 0 && index.y < dims_.y);
+    assert(index.z >= 0 && index.z < dims_.z);
+
+    return index.z * size_t(dims_.x) * dims_.y + index.y * size_t(dims_.x) + index.x;
+}
+
+inline void macrocell_grid::pad_sampled_ranges(vec3i const& samples_per_cell, float lipschitz)
+{
+    // Any point inside a cell is at most half a sample cell diagonal
+    // away from the nearest sample
+    vec3 delta = cell_size() / vec3(max(samples_per_cell - vec3i(1), vec3i(1)));
+    float pad = lipschitz * 0.5f * length(delta);
+
+    aligned_vector<vec2> sampled(value_ranges_);
+
+    for (int z = 0; z < dims_.z; ++z)
+    {
+        for (int y = 0; y < dims_.y; ++y)
+        {
+            for (int x = 0; x < dims_.x; ++x)
+            {
+                vec3i index(x, y, z);
+                vec3i first = max(index - vec3i(1), vec3i(0));
+                vec3i last = min(index + vec3i(1), dims_ - vec3i(1));
+
+                // Only widen the upper bound, the lower bound is used as
+                // a control variate and not required to be conservative
+                vec2 range = sampled[linear_index(index)];
+
+                for (int zz = first.z; zz <= last.z; ++zz)
+                {
+                    for (int yy = first.y; yy <= last.y; ++yy)
+                    {
+                        for (int xx = first.x; xx <= last.x; ++xx)
+                        {
+                            range.y = max(range.y, sampled[linear_index(vec3i(xx, yy, zz))].y);
+                        }
+                    }
+                }
+
+                value_ranges_[linear_index(index)] = vec2(range.x - pad, range.y + pad);
+            }
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// 3D-DDA grid traversal
+//
+
+template <typename Func>
+inline void traverse_grid(basic_ray<float> const& ray, macrocell_grid const& grid, Func func)
+{
+    auto hr = intersect(ray, grid.bounds());
+
+    float tmin = max(ray.tmin, hr.tnear);
+    float tmax = min(ray.tmax, hr.tfar);
+
+    if (!hr.hit || tmin >= tmax)
+    {
+        return;
+    }
+
+    vec3i dims = grid.dims();
+    vec3 cell_size = grid.cell_size();
+    vec3i index = grid.cell_index(ray.ori + ray.dir * tmin);
+
+    vec3i step;
+    vec3 t_delta;
+    vec3 t_next;
+
+    for (int d = 0; d < 3; ++d)
+    {
+        if (ray.dir[d] > 0.0f)
+        {
+            float boundary = grid.bounds().min[d] + (index[d] + 1) * cell_size[d];
+            step[d] = 1;
+            t_delta[d] = cell_size[d] / ray.dir[d];
+            t_next[d] = (boundary - ray.ori[d]) / ray.dir[d];
+        }
+        else if (ray.dir[d] < 0.0f)
+        {
+            float boundary = grid.bounds().min[d] + index[d] * cell_size[d];
+            step[d] = -1;
+            t_delta[d] = -cell_size[d] / ray.dir[d];
+            t_next[d] = (boundary - ray.ori[d]) / ray.dir[d];
+        }
+        else
+        {
+            step[d] = 0;
+            t_delta[d] = numeric_limits<float>::max();
+            t_next[d] = numeric_limits<float>::max();
+        }
+    }
+
+    float t0 = tmin;
+
+    for (;;)
+    {
+        int axis = t_next.x < t_next.y
+            ? (t_next.x < t_next.z ? 0 : 2)
+            : (t_next.y < t_next.z ? 1 : 2);
+
+        float t1 = min(t_next[axis], tmax);
+
+        if (!func(index, t0, t1) || t1 >= tmax)
+        {
+            return;
+        }
+
+        index[axis] += step[axis];
+
+        if (index[axis] < 0 || index[axis] >= dims[axis])
+        {
+            return;
+        }
+
+        t0 = t1;
+        t_next[axis] += t_delta[axis];
+    }
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
@@ -5,9 +5,11 @@
 #include <type_traits>
 
 #include "../array.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -252,4 +254,5 @@ inline auto unpack(plastic<FloatT> const& mat)
 }
 
 } // simd
-} // visioanray
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
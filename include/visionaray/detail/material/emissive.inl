@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <visionaray/surface_interaction.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -81,4 +83,5 @@ inline T const& emissive<T>::ls() const
     return ls_;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
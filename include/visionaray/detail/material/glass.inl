@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -116,4 +119,5 @@ inline spectrum<T> const& glass<T>::ior() const
     return specular_bsdf_.ior;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
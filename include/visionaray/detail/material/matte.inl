@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <visionaray/math/constants.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -125,4 +127,5 @@ inline T const& matte<T>::kd() const
     return diffuse_brdf_.kd;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -97,4 +100,5 @@ inline spectrum<T> const& metal<T>::absorption() const
     return brdf_.absorption;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -111,4 +114,5 @@ inline spectrum<T> const& mirror<T>::absorption() const
     return specular_brdf_.absorption;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <visionaray/math/constants.h>
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Public interface
@@ -210,4 +212,5 @@ inline T const& plastic<T>::specular_exp() const
     return specular_brdf_.exp;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
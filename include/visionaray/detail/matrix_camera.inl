@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../math/limits.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 inline matrix_camera::matrix_camera(mat4 const& view, mat4 const& proj)
     : view_(view)
@@ -62,4 +64,5 @@ inline R matrix_camera::primary_ray(R /* */, T const& x, T const& y, T const& wi
     return r;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
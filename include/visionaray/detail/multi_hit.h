@@ -13,9 +13,11 @@
 #include <visionaray/array.h>
 
 #include "tags.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -232,6 +234,7 @@ inline simd::mask_type_t<T> is_closer(HR1 const& query, HR2 const& reference, T
     return simd::mask_type_t<T>(true);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_MULTI_HIT_H
@@ -9,20 +9,32 @@
 #include <visionaray/config.h>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #if VSNRAY_HAVE_TBB
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_reduce.h>
 #endif
 
+#include "../math/detail/math.h"
 #include "algorithm.h"
 #include "macros.h"
+#include "parallel_for.h"
+#include "range.h"
+#include "thread_pool.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace paralgo
 {
 
@@ -167,7 +179,878 @@ void counting_sort(InputIt first, InputIt last, OutputIt out, Counts& counts, Ke
 
 #endif // VSNRAY_HAVE_TBB
 
+
+//-------------------------------------------------------------------------------------------------
+// Parallel primitives based on thread_pool
+//
+// The input is split into a few contiguous blocks per thread. The algorithms first
+// process each block independently (count, reduce, histogram), then combine the
+// per-block results with a short serial scan, and finally make a second pass over
+// the blocks that writes the output. All algorithms are stable, i.e. they produce
+// the same output as their serial counterparts. Iterators must be random access.
+//
+
+namespace detail
+{
+
+// Small inputs are processed in a single block without the thread pool
+static size_t const min_block_size = 1 << 14;
+
+inline size_t num_blocks(thread_pool const& pool, size_t n)
+{
+    size_t max_blocks = std::max(size_t(1), size_t(pool.num_threads) * 4);
+    return std::max(size_t(1), std::min(max_blocks, n / min_block_size));
+}
+
+// Calls func(block_index, first, last) for num_blocks blocks of [0..n)
+template <typename Func>
+inline void for_each_block(thread_pool& pool, size_t n, size_t num_blocks, Func const& func)
+{
+    size_t block_size = div_up(n, num_blocks);
+
+    if (num_blocks == 1)
+    {
+        func(size_t(0), size_t(0), n);
+        return;
+    }
+
+    parallel_for(
+        pool,
+        range1d<size_t>(0, num_blocks),
+        [&](size_t b)
+        {
+            size_t first = std::min(b * block_size, n);
+            size_t last = std::min(first + block_size, n);
+            func(b, first, last);
+        });
+}
+
+// Scan with an initial value, inclusive or exclusive
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt scan(
+        thread_pool&    pool,
+        InputIt         first,
+        InputIt         last,
+        OutputIt        out,
+        T               init,
+        BinaryOp        op,
+        bool            inclusive
+        )
+{
+    size_t n = last - first;
+
+    if (n == 0)
+    {
+        return out;
+    }
+
+    size_t num_blocks = detail::num_blocks(pool, n);
+
+    // Reduce each block, then scan the block sums
+    std::vector<T> sums(num_blocks, init);
+    std::vector<char> empty(num_blocks, 1);
+
+    for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        if (i1 == i2)
+        {
+            return;
+        }
+
+        T sum = first[i1];
+
+        for (size_t i = i1 + 1; i < i2; ++i)
+        {
+            sum = op(sum, first[i]);
+        }
+
+        sums[b] = sum;
+        empty[b] = 0;
+    });
+
+    T carry = init;
+
+    for (size_t b = 0; b < num_blocks; ++b)
+    {
+        if (!empty[b])
+        {
+            T sum = sums[b];
+            sums[b] = carry;
+            carry = op(carry, sum);
+        }
+    }
+
+    for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        T sum = sums[b];
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            // Read first, out may alias the input
+            T value = first[i];
+
+            if (inclusive)
+            {
+                sum = op(sum, value);
+                out[i] = sum;
+            }
+            else
+            {
+                out[i] = sum;
+                sum = op(sum, value);
+            }
+        }
+    });
+
+    return out + n;
+}
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// exclusive_scan
+//
+// Writes init, init op a[0], init op a[0] op a[1], ... to the output sequence.
+// Can be used in-place (out == first). op must be associative.
+//
+// [in] POOL
+//      Thread pool.
+//
+// [in] FIRST
+//      Start of the input sequence.
+//
+// [in] LAST
+//      End of the input sequence.
+//
+// [out] OUT
+//      Start of the output sequence.
+//
+// [in] INIT
+//      Initial value.
+//
+// [in] OP
+//      Binary operation.
+//
+// Returns the end of the output sequence.
+//
+// Complexity: O(n/p + p)
+//
+
+template <
+    typename InputIt,
+    typename OutputIt,
+    typename T,
+    typename BinaryOp = std::plus<T>
+    >
+OutputIt exclusive_scan(
+        thread_pool&    pool,
+        InputIt         first,
+        InputIt         last,
+        OutputIt        out,
+        T               init,
+        BinaryOp        op = BinaryOp()
+        )
+{
+    return detail::scan(pool, first, last, out, init, op, false);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// inclusive_scan
+//
+// Writes a[0], a[0] op a[1], ... to the output sequence.
+// Can be used in-place (out == first). op must be associative.
+//
+// [in] POOL
+//      Thread pool.
+//
+// [in] FIRST
+//      Start of the input sequence.
+//
+// [in] LAST
+//      End of the input sequence.
+//
+// [out] OUT
+//      Start of the output sequence.
+//
+// [in] OP
+//      Binary operation.
+//
+// Returns the end of the output sequence.
+//
+// Complexity: O(n/p + p)
+//
+
+template <
+    typename InputIt,
+    typename OutputIt,
+    typename BinaryOp = std::plus<typename std::iterator_traits<InputIt>::value_type>
+    >
+OutputIt inclusive_scan(
+        thread_pool&    pool,
+        InputIt         first,
+        InputIt         last,
+        OutputIt        out,
+        BinaryOp        op = BinaryOp()
+        )
+{
+    using T = typename std::iterator_traits<InputIt>::value_type;
+
+    if (first == last)
+    {
+        return out;
+    }
+
+    // The first element is the initial value for the rest
+    T init = *first;
+    *out = init;
+
+    return detail::scan(pool, first + 1, last, out + 1, init, op, true);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// copy_if
+//
+// Stream compaction: copies the elements for which pred returns true to the
+// output sequence, preserving their order. pred is called once per element.
+//
+// [in] POOL
+//      Thread pool.
+//
+// [in] FIRST
+//      Start of the input sequence.
+//
+// [in] LAST
+//      End of the input sequence.
+//
+// [out] OUT
+//      Start of the output sequence, must not overlap the input.
+//
+// [in] PRED
+//      Unary predicate.
+//
+// Returns the end of the output sequence.
+//
+// Complexity: O(n/p + p)
+//
+
+template <typename InputIt, typename OutputIt, typename Pred>
+OutputIt copy_if(
+        thread_pool&    pool,
+        InputIt         first,
+        InputIt         last,
+        OutputIt        out,
+        Pred            pred
+        )
+{
+    size_t n = last - first;
+
+    if (n == 0)
+    {
+        return out;
+    }
+
+    size_t num_blocks = detail::num_blocks(pool, n);
+
+    std::vector<unsigned char> flags(n);
+    std::vector<size_t> offsets(num_blocks, 0);
+
+    detail::for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        size_t count = 0;
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            flags[i] = pred(first[i]) ? 1 : 0;
+            count += flags[i];
+        }
+
+        offsets[b] = count;
+    });
+
+    size_t total = 0;
+
+    for (size_t b = 0; b < num_blocks; ++b)
+    {
+        size_t count = offsets[b];
+        offsets[b] = total;
+        total += count;
+    }
+
+    detail::for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        size_t o = offsets[b];
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            if (flags[i])
+            {
+                out[o++] = first[i];
+            }
+        }
+    });
+
+    return out + total;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// stable_partition
+//
+// Reorders the elements so that those for which pred returns true precede those
+// for which it returns false. The relative order in both groups is preserved.
+// pred is called once per element. Uses a temporary copy of the sequence.
+//
+// [in] POOL
+//      Thread pool.
+//
+// [in,out] FIRST
+//      Start of the sequence.
+//
+// [in,out] LAST
+//      End of the sequence.
+//
+// [in] PRED
+//      Unary predicate.
+//
+// Returns an iterator to the first element of the second group.
+//
+// Complexity: O(n/p + p)
+//
+
+template <typename RandIt, typename Pred>
+RandIt stable_partition(thread_pool& pool, RandIt first, RandIt last, Pred pred)
+{
+    using T = typename std::iterator_traits<RandIt>::value_type;
+
+    size_t n = last - first;
+
+    if (n == 0)
+    {
+        return first;
+    }
+
+    size_t num_blocks = detail::num_blocks(pool, n);
+
+    std::vector<T> tmp(n);
+    std::vector<unsigned char> flags(n);
+    std::vector<size_t> true_offsets(num_blocks, 0);
+    std::vector<size_t> false_offsets(num_blocks, 0);
+
+    detail::for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        size_t count = 0;
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            tmp[i] = std::move(first[i]);
+            flags[i] = pred(tmp[i]) ? 1 : 0;
+            count += flags[i];
+        }
+
+        true_offsets[b] = count;
+        false_offsets[b] = (i2 - i1) - count;
+    });
+
+    size_t num_true = 0;
+
+    for (size_t b = 0; b < num_blocks; ++b)
+    {
+        num_true += true_offsets[b];
+    }
+
+    size_t t = 0;
+    size_t f = num_true;
+
+    for (size_t b = 0; b < num_blocks; ++b)
+    {
+        size_t count_true = true_offsets[b];
+        size_t count_false = false_offsets[b];
+        true_offsets[b] = t;
+        false_offsets[b] = f;
+        t += count_true;
+        f += count_false;
+    }
+
+    detail::for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        size_t ot = true_offsets[b];
+        size_t of = false_offsets[b];
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            first[flags[i] ? ot++ : of++] = std::move(tmp[i]);
+        }
+    });
+
+    return first + num_true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// counting_sort
+//
+// Sorts items based on integer keys in [0..k), k = counts.size(). Same interface
+// as the TBB version, but stable. After the call, counts[m] is the end offset of
+// the items with key m in the output sequence.
+//
+// [in] POOL
+//      Thread pool.
+//
+// [in] FIRST
+//      Start of the input sequence.
+//
+// [in] LAST
+//      End of the input sequence.
+//
+// [out] OUT
+//      Start of the output sequence, must not overlap the input.
+//
+// [in,out] COUNTS
+//      Modifiable counts sequence.
+//
+// [in] KEY
+//      Sort key function object.
+//
+// Complexity: O(n/p + k p)
+//
+
+template <
+    typename InputIt,
+    typename OutputIt,
+    typename Counts,
+    typename Key = visionaray::algo::detail::trivial_key
+    >
+void counting_sort(
+        thread_pool&    pool,
+        InputIt         first,
+        InputIt         last,
+        OutputIt        out,
+        Counts&         counts,
+        Key             key = Key()
+        )
+{
+    static_assert(
+            std::is_integral<decltype(key(*first))>::value,
+            "parallel_counting_sort requires integral key type"
+            );
+
+    size_t n = last - first;
+    size_t k = counts.size();
+
+    size_t num_blocks = detail::num_blocks(pool, n);
+
+    // Offsets: key major, block minor, so the sort is stable
+    std::vector<std::vector<size_t>> hist(num_blocks, std::vector<size_t>(k, 0));
+
+    detail::for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        for (size_t i = i1; i < i2; ++i)
+        {
+            ++hist[b][key(first[i])];
+        }
+    });
+
+    size_t offset = 0;
+
+    for (size_t m = 0; m < k; ++m)
+    {
+        for (size_t b = 0; b < num_blocks; ++b)
+        {
+            size_t count = hist[b][m];
+            hist[b][m] = offset;
+            offset += count;
+        }
+
+        counts[m] = offset;
+    }
+
+    detail::for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        auto& o = hist[b];
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            out[o[key(first[i])]++] = first[i];
+        }
+    });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// radix_sort
+//
+// LSD radix sort with 8-bit digits. Keys are integral or floating point types.
+// Floating point keys are sorted by value, negative zero precedes zero and NaNs
+// sort according to their sign bit. Passes whose digit is the same for all keys
+// are skipped, e.g. the upper bytes of 30-bit Morton codes stored in 32 bits.
+//
+//  radix_sort(pool, first, last)
+//      Sorts keys.
+//
+//  radix_sort(pool, first, last, key)
+//      Sorts arbitrary items by key(item).
+//
+//  radix_sort(pool, first, last, key, buffer)
+//      Same, with temporary storage that is kept between calls.
+//
+//  radix_sort_by_key(pool, keys_first, keys_last, values_first)
+//      Sorts keys and reorders the values (e.g. indices) accordingly.
+//
+// The sort is stable. Temporary storage for one copy of the items (and values) is
+// allocated, unless a radix_sort_buffer is passed.
+//
+// Complexity: O(d * (n/p + 256 p)), d: number of bytes in the key type
+//
+
+namespace detail
+{
+
+// Map keys to unsigned integers with the same order
+
+template <typename T, typename Enable = void>
+struct radix_traits;
+
+template <typename T>
+struct radix_traits<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+    using bits_type = typename std::make_unsigned<T>::type;
+
+    static bits_type encode(T key)
+    {
+        bits_type bits = static_cast<bits_type>(key);
+
+        // Flip the sign bit of signed types
+        if (std::is_signed<T>::value)
+        {
+            bits ^= bits_type(1) << (sizeof(T) * 8 - 1);
+        }
+
+        return bits;
+    }
+};
+
+template <typename T>
+struct radix_traits<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unsupported floating point type");
+
+    using bits_type = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+
+    static bits_type encode(T key)
+    {
+        bits_type bits;
+        std::memcpy(&bits, &key, sizeof(T));
+
+        bits_type sign = bits_type(1) << (sizeof(T) * 8 - 1);
+
+        // Negative numbers: flip all bits, positive numbers: flip the sign bit
+        return (bits & sign) ? ~bits : (bits | sign);
+    }
+};
+
+struct identity_key
+{
+    template <typename T>
+    T const& operator()(T const& t) const
+    {
+        return t;
+    }
+};
+
+// Placeholder for sorts without values
+struct no_values
+{
+    struct reference
+    {
+    };
+
+    reference operator[](size_t) const
+    {
+        return reference();
+    }
+};
+
+template <typename T>
+struct value_buffer
+{
+    explicit value_buffer(size_t n)
+        : data(n)
+    {
+    }
+
+    typename std::vector<T>::iterator begin()
+    {
+        return data.begin();
+    }
+
+    std::vector<T> data;
+};
+
+template <>
+struct value_buffer<no_values>
+{
+    explicit value_buffer(size_t)
+    {
+    }
+
+    no_values begin()
+    {
+        return no_values();
+    }
+};
+
+template <typename T>
+struct value_type_of
+{
+    using type = typename std::iterator_traits<T>::value_type;
+};
+
+template <>
+struct value_type_of<no_values>
+{
+    using type = no_values;
+};
+
+template <typename DstValueIt, typename SrcValueIt>
+inline void assign_value(DstValueIt dst, size_t d, SrcValueIt src, size_t s)
+{
+    dst[d] = std::move(src[s]);
+}
+
+inline void assign_value(no_values, size_t, no_values, size_t)
+{
+}
+
+using radix_histogram = std::array<size_t, 256>;
+
+// One counting pass over the digit at bit SHIFT, src -> dst
+template <
+    typename SrcIt,
+    typename SrcValueIt,
+    typename DstIt,
+    typename DstValueIt,
+    typename Key
+    >
+void radix_pass(
+        thread_pool&                        pool,
+        SrcIt                               src,
+        SrcValueIt                          src_values,
+        DstIt                               dst,
+        DstValueIt                          dst_values,
+        size_t                              n,
+        size_t                              num_blocks,
+        unsigned                            shift,
+        Key                                 key,
+        radix_histogram*                    hist,
+        bool                                have_hist
+        )
+{
+    using traits = radix_traits<typename std::decay<decltype(key(*src))>::type>;
+
+    if (!have_hist)
+    {
+        for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+        {
+            radix_histogram& h = hist[b];
+            h.fill(0);
+
+            for (size_t i = i1; i < i2; ++i)
+            {
+                ++h[(traits::encode(key(src[i])) >> shift) & 0xFF];
+            }
+        });
+    }
+
+    // Offsets: digit major, block minor, so the pass is stable
+    size_t offset = 0;
+
+    for (size_t d = 0; d < 256; ++d)
+    {
+        for (size_t b = 0; b < num_blocks; ++b)
+        {
+            size_t count = hist[b][d];
+            hist[b][d] = offset;
+            offset += count;
+        }
+    }
+
+    for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        radix_histogram& o = hist[b];
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            size_t pos = o[(traits::encode(key(src[i])) >> shift) & 0xFF]++;
+            dst[pos] = std::move(src[i]);
+            assign_value(dst_values, pos, src_values, i);
+        }
+    });
+}
+
+template <typename RandIt, typename ValueIt, typename Key, typename T>
+void radix_sort(
+        thread_pool&                    pool,
+        RandIt                          first,
+        RandIt                          last,
+        ValueIt                         values,
+        Key                             key,
+        std::vector<T>&                 tmp,
+        std::vector<radix_histogram>&   digit_hist
+        )
+{
+    using V = typename value_type_of<ValueIt>::type;
+    using traits = radix_traits<typename std::decay<decltype(key(*first))>::type>;
+
+    size_t n = last - first;
+
+    if (n <= 1)
+    {
+        return;
+    }
+
+    size_t num_blocks = detail::num_blocks(pool, n);
+    unsigned num_digits = sizeof(typename traits::bits_type);
+
+    // Histograms of all digits in one pass; these are also the block histograms
+    // for the first pass that isn't skipped. Block b, digit d: [d * num_blocks + b]
+    digit_hist.resize(num_digits * num_blocks);
+
+    for_each_block(pool, n, num_blocks, [&](size_t b, size_t i1, size_t i2)
+    {
+        for (unsigned d = 0; d < num_digits; ++d)
+        {
+            digit_hist[d * num_blocks + b].fill(0);
+        }
+
+        for (size_t i = i1; i < i2; ++i)
+        {
+            auto bits = traits::encode(key(first[i]));
+
+            for (unsigned d = 0; d < num_digits; ++d)
+            {
+                ++digit_hist[d * num_blocks + b][(bits >> (d * 8)) & 0xFF];
+            }
+        }
+    });
+
+    unsigned passes[sizeof(typename traits::bits_type)];
+    unsigned num_passes = 0;
+
+    for (unsigned d = 0; d < num_digits; ++d)
+    {
+        for (size_t v = 0; v < 256; ++v)
+        {
+            size_t count = 0;
+
+            for (size_t b = 0; b < num_blocks; ++b)
+            {
+                count += digit_hist[d * num_blocks + b][v];
+            }
+
+            if (count != 0)
+            {
+                // Skip if all keys have the same digit
+                if (count != n)
+                {
+                    passes[num_passes++] = d;
+                }
+
+                break;
+            }
+        }
+    }
+
+    if (num_passes == 0)
+    {
+        return;
+    }
+
+    tmp.resize(n);
+    value_buffer<V> tmp_values(n);
+
+    for (unsigned p = 0; p < num_passes; ++p)
+    {
+        unsigned shift = passes[p] * 8;
+
+        // Later passes recompute the histograms of their digit in place
+        radix_histogram* hist = digit_hist.data() + passes[p] * num_blocks;
+        bool have_hist = p == 0;
+
+        if (p % 2 == 0)
+        {
+            radix_pass(pool, first, values, tmp.begin(), tmp_values.begin(), n, num_blocks, shift, key, hist, have_hist);
+        }
+        else
+        {
+            radix_pass(pool, tmp.begin(), tmp_values.begin(), first, values, n, num_blocks, shift, key, hist, have_hist);
+        }
+    }
+
+    // Copy back after an odd number of passes
+    if (num_passes % 2 == 1)
+    {
+        auto tmp_first = tmp.begin();
+        auto tmp_values_first = tmp_values.begin();
+
+        for_each_block(pool, n, num_blocks, [&](size_t, size_t i1, size_t i2)
+        {
+            for (size_t i = i1; i < i2; ++i)
+            {
+                first[i] = std::move(tmp_first[i]);
+                assign_value(values, i, tmp_values_first, i);
+            }
+        });
+    }
+}
+
+} // detail
+
+// Temporary storage that can be reused for repeated sorts of items of type T
+template <typename T>
+struct radix_sort_buffer
+{
+    std::vector<T> items;
+    std::vector<detail::radix_histogram> histograms;
+};
+
+template <typename RandIt>
+void radix_sort(thread_pool& pool, RandIt first, RandIt last)
+{
+    radix_sort_buffer<typename std::iterator_traits<RandIt>::value_type> buffer;
+    detail::radix_sort(pool, first, last, detail::no_values(), detail::identity_key(), buffer.items, buffer.histograms);
+}
+
+template <typename RandIt, typename Key>
+void radix_sort(thread_pool& pool, RandIt first, RandIt last, Key key)
+{
+    radix_sort_buffer<typename std::iterator_traits<RandIt>::value_type> buffer;
+    detail::radix_sort(pool, first, last, detail::no_values(), key, buffer.items, buffer.histograms);
+}
+
+template <typename RandIt, typename Key>
+void radix_sort(
+        thread_pool&                                                            pool,
+        RandIt                                                                  first,
+        RandIt                                                                  last,
+        Key                                                                     key,
+        radix_sort_buffer<typename std::iterator_traits<RandIt>::value_type>&   buffer
+        )
+{
+    detail::radix_sort(pool, first, last, detail::no_values(), key, buffer.items, buffer.histograms);
+}
+
+template <typename KeyIt, typename ValueIt>
+void radix_sort_by_key(thread_pool& pool, KeyIt keys_first, KeyIt keys_last, ValueIt values_first)
+{
+    radix_sort_buffer<typename std::iterator_traits<KeyIt>::value_type> buffer;
+    detail::radix_sort(pool, keys_first, keys_last, values_first, detail::identity_key(), buffer.items, buffer.histograms);
+}
+
 } // namespace paralgo
+VSNRAY_ISA_NAMESPACE_END
 } // namespace visionaray
 
 #endif // VSNRAY_DETAIL_PARALLEL_ALGORITHM_H
@@ -7,11 +7,14 @@
 #define VSNRAY_DETAIL_PARALLEL_FOR_H 1
 
 #include "../math/detail/math.h"
+#include "../profiling.h"
 #include "range.h"
 #include "thread_pool.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // parallel_for
@@ -26,6 +29,8 @@ void parallel_for(thread_pool& pool, range1d<I> const& range, Func const& func)
 
     pool.run([=](long tile_index)
         {
+            VSNRAY_PROFILE_SCOPE_ID("parallel_for tile", tile_index);
+
             I first = static_cast<I>(tile_index) * tile_size;
             I last = min(first + tile_size, len);
 
@@ -47,6 +52,8 @@ void parallel_for(thread_pool& pool, tiled_range1d<I> const& range, Func const&
 
     pool.run([=](long tile_index)
         {
+            VSNRAY_PROFILE_SCOPE_ID("parallel_for tile", tile_index);
+
             I first = static_cast<I>(tile_index) * tile_size + beg;
             I last = min(first + tile_size, beg + len);
 
@@ -69,6 +76,44 @@ void parallel_for(thread_pool& pool, tiled_range2d<I> const& range, Func const&
 
     pool.run([=](long tile_index)
         {
+            VSNRAY_PROFILE_SCOPE_ID("parallel_for tile", tile_index);
+
+            I first_x = (tile_index % num_tiles_x) * tile_width + first_row;
+            I last_x = min(first_x + tile_width, first_row + width);
+
+            I first_y = (tile_index / num_tiles_x) * tile_height + first_col;
+            I last_y = min(first_y + tile_height, first_col + height);
+
+            func(range2d<I>(first_x, last_x, first_y, last_y));
+
+        }, static_cast<long>(num_tiles_x * num_tiles_y));
+}
+
+// Process the tiles in the order given by tile_indices, a permutation of the
+// linear tile indices (y * num_tiles_x + x)
+template <typename I, typename Func>
+void parallel_for(
+        thread_pool&                pool,
+        tiled_range2d<I> const&     range,
+        int const*                  tile_indices,
+        Func const&                 func
+        )
+{
+    I first_row = range.rows().begin();
+    I first_col  = range.cols().begin();
+    I width = range.rows().length();
+    I height = range.cols().length();
+    I tile_width = range.rows().tile_size();
+    I tile_height = range.cols().tile_size();
+    I num_tiles_x = div_up(width, tile_width);
+    I num_tiles_y = div_up(height, tile_height);
+
+    pool.run([=](long i)
+        {
+            I tile_index = static_cast<I>(tile_indices[i]);
+
+            VSNRAY_PROFILE_SCOPE_ID("parallel_for tile", tile_index);
+
             I first_x = (tile_index % num_tiles_x) * tile_width + first_row;
             I last_x = min(first_x + tile_width, first_row + width);
 
@@ -80,6 +125,7 @@ void parallel_for(thread_pool& pool, tiled_range2d<I> const& range, Func const&
         }, static_cast<long>(num_tiles_x * num_tiles_y));
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_PARALLEL_FOR_H
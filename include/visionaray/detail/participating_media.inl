@@ -0,0 +1,233 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cassert>
+
+#include "../math/detail/math.h"
+#include "isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+// Transmittance weights below this value are subject to Russian roulette
+static const float ratio_tracking_roulette_threshold = 0.1f;
+
+// Exponentially distributed free-flight distance for extinction mu
+template <typename Generator>
+inline float sample_free_flight(float mu, Generator& gen)
+{
+    return -log(1.0f - gen.next()) / mu;
+}
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// Delta tracking
+//
+
+template <typename SigmaT, typename Generator>
+inline bool delta_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        float&                      t,
+        tracking_stats&             stats
+        )
+{
+    bool hit = false;
+
+    traverse_grid(ray, grid, [&](vec3i const& cell, float t0, float t1)
+    {
+        ++stats.cells_visited;
+
+        float majorant = grid.majorant(cell);
+
+        if (majorant <= 0.0f)
+        {
+            return true;
+        }
+
+        // Free-flight distances are memoryless, so sampling can
+        // restart with the next cell's majorant at the cell boundary
+        for (float tt = t0 + detail::sample_free_flight(majorant, gen);
+             tt < t1;
+             tt += detail::sample_free_flight(majorant, gen))
+        {
+            ++stats.density_lookups;
+
+            float s = sigma_t(ray.ori + ray.dir * tt);
+
+            // Majorants that don't bound sigma_t bias the estimate,
+            // see macrocell_grid::build_from_function()
+            assert(s <= majorant * 1.001f + 1e-6f);
+
+            if (gen.next() * majorant < s)
+            {
+                t = tt;
+                hit = true;
+                return false;
+            }
+        }
+
+        return true;
+    });
+
+    return hit;
+}
+
+template <typename SigmaT, typename Generator>
+inline bool delta_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        float&                      t
+        )
+{
+    tracking_stats stats;
+    return delta_tracking(ray, sigma_t, grid, gen, t, stats);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Ratio tracking
+//
+
+template <typename SigmaT, typename Generator>
+inline float ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        tracking_stats&             stats
+        )
+{
+    float tr = 1.0f;
+
+    traverse_grid(ray, grid, [&](vec3i const& cell, float t0, float t1)
+    {
+        ++stats.cells_visited;
+
+        float majorant = grid.majorant(cell);
+
+        if (majorant <= 0.0f)
+        {
+            return true;
+        }
+
+        for (float tt = t0 + detail::sample_free_flight(majorant, gen);
+             tt < t1;
+             tt += detail::sample_free_flight(majorant, gen))
+        {
+            ++stats.density_lookups;
+
+            tr *= 1.0f - sigma_t(ray.ori + ray.dir * tt) / majorant;
+
+            if (tr < detail::ratio_tracking_roulette_threshold)
+            {
+                if (gen.next() >= 0.5f)
+                {
+                    tr = 0.0f;
+                    return false;
+                }
+
+                tr *= 2.0f;
+            }
+        }
+
+        return true;
+    });
+
+    return tr;
+}
+
+template <typename SigmaT, typename Generator>
+inline float ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen
+        )
+{
+    tracking_stats stats;
+    return ratio_tracking(ray, sigma_t, grid, gen, stats);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Residual ratio tracking
+//
+
+template <typename SigmaT, typename Generator>
+inline float residual_ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        tracking_stats&             stats
+        )
+{
+    float tr = 1.0f;
+
+    traverse_grid(ray, grid, [&](vec3i const& cell, float t0, float t1)
+    {
+        ++stats.cells_visited;
+
+        float majorant = grid.majorant(cell);
+        float control = clamp(grid.value_range(cell).x, 0.0f, majorant);
+        float residual_majorant = majorant - control;
+
+        // Analytic transmittance of the control extinction
+        tr *= exp(-control * (t1 - t0));
+
+        if (residual_majorant <= 0.0f)
+        {
+            return true;
+        }
+
+        for (float tt = t0 + detail::sample_free_flight(residual_majorant, gen);
+             tt < t1;
+             tt += detail::sample_free_flight(residual_majorant, gen))
+        {
+            ++stats.density_lookups;
+
+            float residual = sigma_t(ray.ori + ray.dir * tt) - control;
+            tr *= 1.0f - residual / residual_majorant;
+
+            if (tr < detail::ratio_tracking_roulette_threshold)
+            {
+                if (gen.next() >= 0.5f)
+                {
+                    tr = 0.0f;
+                    return false;
+                }
+
+                tr *= 2.0f;
+            }
+        }
+
+        return true;
+    });
+
+    return tr;
+}
+
+template <typename SigmaT, typename Generator>
+inline float residual_ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen
+        )
+{
+    tracking_stats stats;
+    return residual_ratio_tracking(ray, sigma_t, grid, gen, stats);
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
@@ -12,6 +12,7 @@
 #include "../spectrum.h"
 #include "../surface_interaction.h"
 #include "../traverse.h"
+#include "isa_namespace.h"
 
 #ifdef __CUDACC__
 #define CLOCK clock
@@ -21,6 +22,7 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace pathtracing
 {
 
@@ -90,6 +92,8 @@ struct kernel
             {
                 result.hit = hit_rec.hit;
                 result.depth = hit_rec.t;
+                result.prim_id = hit_rec.prim_id;
+                result.geom_id = hit_rec.geom_id;
             }
 
 
@@ -176,8 +180,13 @@ struct kernel
                     S(params.epsilon),                         // tmin
                     ld - S(params.epsilon)                     // tmax
                     );
+                shadow_ray.time = ray.time;
 
-                auto lhr = any_hit(shadow_ray, params.prims.begin, params.prims.end, isect);
+                // Only trace shadow rays that can contribute (tmin > tmax disables the others)
+                auto contributes = active_rays && ldotn > S(0.0) && ldotln > S(0.0);
+                shadow_ray.tmax = select(contributes, shadow_ray.tmax, S(-1.0));
+
+                auto occl = occluded(shadow_ray, params.prims.begin, params.prims.end, isect);
 
                 auto brdf_pdf = surf.pdf(view_dir, L, inter);
                 auto prob = max_element(throughput.samples());
@@ -189,7 +198,7 @@ struct kernel
                 S mis_weight = power_heuristic(ls.pdf / static_cast<float>(num_lights), brdf_pdf);
 
                 intensity += select(
-                    active_rays && !lhr.hit && ldotn > S(0.0) && ldotln > S(0.0),
+                    contributes && !occl,
                     mis_weight * throughput * src * (ldotn / ls.pdf) * S(static_cast<float>(num_lights)),
                     C(0.0)
                     );
@@ -198,6 +207,18 @@ struct kernel
             throughput *= src * (dot(n, refl_dir) / brdf_pdf);
             throughput = select(zero_pdf, C(0.0), throughput);
 
+            // Features for denoising: the first bounce's sample weight
+            // converges to the directional albedo
+            if (bounce == 0)
+            {
+                result.albedo = select(
+                    inter == surface_interaction::Emission,
+                    V(1.0),
+                    to_rgb(throughput)
+                    );
+                result.normal = n;
+            }
+
             if (bounce >= 2)
             {
                 // Russian roulette
@@ -244,4 +265,5 @@ struct kernel
 };
 
 } // pathtracing
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -5,9 +5,11 @@
 #include <cmath>
 
 #include <visionaray/math/limits.h>
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 inline void pinhole_camera::look_at(vec3 const& eye, vec3 const& center, vec3 const& up)
 {
@@ -140,4 +142,5 @@ inline bool operator!=(pinhole_camera const& a, pinhole_camera const& b)
     return !(a == b);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
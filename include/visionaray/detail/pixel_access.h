@@ -22,9 +22,11 @@
 
 #include "color_conversion.h"
 #include "macros.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -38,13 +40,113 @@ namespace pixel_access
 // Store ------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------------------------------------
+// Unpack SIMD values (single channel or vectors) to per-pixel values
+//
+
+template <typename T>
+struct is_simd_pixel : simd::is_simd_vector<T>
+{
+};
+
+template <size_t Dim, typename T>
+struct is_simd_pixel<vector<Dim, T>> : simd::is_simd_vector<T>
+{
+};
+
+template <typename T>
+struct simd_pixel_lanes
+{
+    using packet_type = simd::float_type_t<T>;
+    using element_type = simd::element_type_t<T>;
+
+    simd_pixel_lanes() = default;
+
+    VSNRAY_FUNC explicit simd_pixel_lanes(T const& value)
+    {
+        store(lanes, value);
+    }
+
+    VSNRAY_FUNC element_type operator[](int i) const
+    {
+        return lanes[i];
+    }
+
+    VSNRAY_FUNC void set(int i, element_type const& value)
+    {
+        lanes[i] = value;
+    }
+
+    VSNRAY_FUNC T pack() const
+    {
+        return T(lanes);
+    }
+
+    simd::aligned_array_t<T> lanes;
+};
+
+template <size_t Dim, typename T>
+struct simd_pixel_lanes<vector<Dim, T>>
+{
+    using packet_type = simd::float_type_t<T>;
+    using element_type = vector<Dim, simd::element_type_t<T>>;
+
+    simd_pixel_lanes() = default;
+
+    VSNRAY_FUNC explicit simd_pixel_lanes(vector<Dim, T> const& value)
+    {
+        for (size_t d = 0; d < Dim; ++d)
+        {
+            store(lanes[d], value[d]);
+        }
+    }
+
+    VSNRAY_FUNC element_type operator[](int i) const
+    {
+        element_type result;
+
+        for (size_t d = 0; d < Dim; ++d)
+        {
+            result[d] = lanes[d][i];
+        }
+
+        return result;
+    }
+
+    VSNRAY_FUNC void set(int i, element_type const& value)
+    {
+        for (size_t d = 0; d < Dim; ++d)
+        {
+            lanes[d][i] = value[d];
+        }
+    }
+
+    VSNRAY_FUNC vector<Dim, T> pack() const
+    {
+        vector<Dim, T> result;
+
+        for (size_t d = 0; d < Dim; ++d)
+        {
+            result[d] = T(lanes[d]);
+        }
+
+        return result;
+    }
+
+    simd::aligned_array_t<T> lanes[Dim];
+};
+
+
 //-------------------------------------------------------------------------------------------------
 // Store an input color to an output color buffer, apply color conversion
+// SIMD colors (e.g. for formats w/o specialized overloads) are stored
+// pixel by pixel
 //
 
 template <pixel_format DF, pixel_format SF, typename InputColor, typename OutputColor>
 VSNRAY_FUNC
-inline void store(
+inline void store_pixels(
+        std::false_type             /* scalar */,
         pixel_format_constant<DF>   /* dst format */,
         pixel_format_constant<SF>   /* src format */,
         int                         x,
@@ -65,6 +167,71 @@ inline void store(
         );
 }
 
+template <pixel_format DF, pixel_format SF, typename InputColor, typename OutputColor>
+VSNRAY_FUNC
+inline void store_pixels(
+        std::true_type              /* SIMD */,
+        pixel_format_constant<DF>   /* dst format */,
+        pixel_format_constant<SF>   /* src format */,
+        int                         x,
+        int                         y,
+        int                         width,
+        int                         height,
+        InputColor const&           color,
+        OutputColor*                buffer
+        )
+{
+    using lanes_type = simd_pixel_lanes<InputColor>;
+    using packet_type = typename lanes_type::packet_type;
+
+    lanes_type lanes(color);
+
+    const int w = packet_size<packet_type>::w;
+    const int h = packet_size<packet_type>::h;
+
+    for (int row = 0; row < h; ++row)
+    {
+        for (int col = 0; col < w; ++col)
+        {
+            if (x + col < width && y + row < height)
+            {
+                convert(
+                    pixel_format_constant<DF>{},
+                    pixel_format_constant<SF>{},
+                    buffer[(y + row) * width + (x + col)],
+                    lanes[row * w + col]
+                    );
+            }
+        }
+    }
+}
+
+template <pixel_format DF, pixel_format SF, typename InputColor, typename OutputColor>
+VSNRAY_FUNC
+inline void store(
+        pixel_format_constant<DF>   /* dst format */,
+        pixel_format_constant<SF>   /* src format */,
+        int                         x,
+        int                         y,
+        int                         width,
+        int                         height,
+        InputColor const&           color,
+        OutputColor*                buffer
+        )
+{
+    store_pixels(
+        std::integral_constant<bool, is_simd_pixel<InputColor>::value>{},
+        pixel_format_constant<DF>{},
+        pixel_format_constant<SF>{},
+        x,
+        y,
+        width,
+        height,
+        color,
+        buffer
+        );
+}
+
 //-------------------------------------------------------------------------------------------------
 // Store SIMD rgb color to RGB8 render target, apply conversion
 // OutputColor must be rgb
@@ -569,11 +736,14 @@ inline void store(
 
 //-------------------------------------------------------------------------------------------------
 // Get a color from an output color buffer, apply conversion
+// SIMD colors (e.g. for formats w/o specialized overloads) are read
+// pixel by pixel, pixels outside the buffer are value-initialized
 //
 
 template <pixel_format DF, pixel_format SF, typename InputColor, typename OutputColor>
 VSNRAY_FUNC
-inline void get(
+inline void get_pixels(
+        std::false_type             /* scalar */,
         pixel_format_constant<DF>   /* dst format */,
         pixel_format_constant<SF>   /* src format */,
         int                         x,
@@ -594,6 +764,78 @@ inline void get(
         );
 }
 
+template <pixel_format DF, pixel_format SF, typename InputColor, typename OutputColor>
+VSNRAY_FUNC
+inline void get_pixels(
+        std::true_type              /* SIMD */,
+        pixel_format_constant<DF>   /* dst format */,
+        pixel_format_constant<SF>   /* src format */,
+        int                         x,
+        int                         y,
+        int                         width,
+        int                         height,
+        InputColor&                 color,
+        OutputColor const*          buffer
+        )
+{
+    using lanes_type = simd_pixel_lanes<InputColor>;
+    using packet_type = typename lanes_type::packet_type;
+    using element_type = typename lanes_type::element_type;
+
+    lanes_type lanes;
+
+    const int w = packet_size<packet_type>::w;
+    const int h = packet_size<packet_type>::h;
+
+    for (int row = 0; row < h; ++row)
+    {
+        for (int col = 0; col < w; ++col)
+        {
+            element_type value{};
+
+            if (x + col < width && y + row < height)
+            {
+                convert(
+                    pixel_format_constant<DF>{},
+                    pixel_format_constant<SF>{},
+                    value,
+                    buffer[(y + row) * width + (x + col)]
+                    );
+            }
+
+            lanes.set(row * w + col, value);
+        }
+    }
+
+    color = lanes.pack();
+}
+
+template <pixel_format DF, pixel_format SF, typename InputColor, typename OutputColor>
+VSNRAY_FUNC
+inline void get(
+        pixel_format_constant<DF>   /* dst format */,
+        pixel_format_constant<SF>   /* src format */,
+        int                         x,
+        int                         y,
+        int                         width,
+        int                         height,
+        InputColor&                 color,
+        OutputColor const*          buffer
+        )
+{
+    get_pixels(
+        std::integral_constant<bool, is_simd_pixel<InputColor>::value>{},
+        pixel_format_constant<DF>{},
+        pixel_format_constant<SF>{},
+        x,
+        y,
+        width,
+        height,
+        color,
+        buffer
+        );
+}
+
 //-------------------------------------------------------------------------------------------------
 // Get SoA rgba color from RGB32F color buffer, let alpha = 1.0
 //
@@ -1134,6 +1376,7 @@ inline void blend(
 } // pixel_access
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #if defined(__GNUC__)
@@ -6,11 +6,14 @@
 
 #include "../cuda/fill.h"
 #include "../gl/util.h"
+#include "../profiling.h"
 #include "color_conversion.h"
+#include "isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
 pixel_unpack_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::pixel_unpack_buffer_rt()
@@ -177,6 +180,8 @@ void pixel_unpack_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::resize(int w
 template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
 void pixel_unpack_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::display_color_buffer() const
 {
+    VSNRAY_PROFILE_SCOPE("display_color_buffer");
+
     if (DepthFormat != PF_UNSPECIFIED)
     {
         // Update color texture
@@ -234,4 +239,5 @@ void pixel_unpack_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::display_colo
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
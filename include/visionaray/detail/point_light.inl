@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../math/constants.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // point_light members
@@ -125,4 +127,5 @@ inline void point_light<t>::set_quadratic_attenuation(t att)
     quadratic_attenuation_ = att;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -9,9 +9,11 @@
 #include <type_traits>
 
 #include "macros.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Simple 1-D range class
@@ -215,6 +217,7 @@ private:
     tiled_range1d<I> slices_;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_RANGE_H
@@ -6,8 +6,10 @@
 #ifndef VSNRAY_DETAIL_SCHED_COMMON_H
 #define VSNRAY_DETAIL_SCHED_COMMON_H 1
 
+#include <type_traits>
 #include <utility>
 
+#include "../aov.h"
 #include "../math/forward.h"
 #include "../math/matrix.h"
 #include "../math/vector.h"
@@ -20,9 +22,11 @@
 #include "macros.h"
 #include "pixel_access.h"
 #include "tags.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -208,7 +212,7 @@ template <typename R, typename Generator, typename Camera>
 VSNRAY_FUNC
 inline R make_primary_ray(
         R                               /* */,
-        pixel_sampler::jittered_type    /* */,
+        pixel_sampler::jittered_type    ps,
         Generator&                      gen,
         int                             x,
         int                             y,
@@ -221,7 +225,7 @@ inline R make_primary_ray(
 
     vector<2, T> jitter(gen.next() - T(0.5), gen.next() - T(0.5));
 
-    return invoke_cam_primary_ray(
+    R r = invoke_cam_primary_ray(
             R{},
             cam,
             gen,
@@ -230,6 +234,13 @@ inline R make_primary_ray(
             T(width),
             T(height)
             );
+
+    if (ps.motion_blur)
+    {
+        r.time = gen.next();
+    }
+
+    return r;
 }
 
 
@@ -260,6 +271,147 @@ inline T depth_transform(R const& r, T const& depth, matrix_camera const& cam)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// First hit features (denoiser inputs, see render_target_ref::albedo() and
+// normal_depth()) and AOV channels (see aov.h)
+//
+// The feature buffers are written as AOV channels aov::albedo and
+// aov::normal_depth, so features and AOVs share one store/blend path and
+// one convention for pixels w/o hit. Null buffers are not written.
+//
+
+template <typename RenderTargetRef>
+using has_feature_buffers = std::integral_constant<
+        bool,
+        RenderTargetRef::feature_format != PF_UNSPECIFIED
+        >;
+
+template <typename RenderTargetRef>
+using has_aovs = std::integral_constant<bool, (RenderTargetRef::num_aovs > 0)>;
+
+template <typename RenderTargetRef>
+VSNRAY_FUNC
+inline detail::aov_buffers<> feature_channels(std::false_type, RenderTargetRef)
+{
+    return {};
+}
+
+template <typename RenderTargetRef>
+VSNRAY_FUNC
+inline auto feature_channels(std::true_type, RenderTargetRef rt_ref)
+    -> detail::aov_buffers<
+            aov_channel<aov::albedo, RenderTargetRef::feature_format>,
+            aov_channel<aov::normal_depth, RenderTargetRef::feature_format>
+            >
+{
+    detail::aov_buffers<
+            aov_channel<aov::albedo, RenderTargetRef::feature_format>,
+            aov_channel<aov::normal_depth, RenderTargetRef::feature_format>
+            > result;
+
+    result.data = rt_ref.albedo();
+    result.rest.data = rt_ref.normal_depth();
+
+    return result;
+}
+
+template <typename RenderTargetRef, typename RR, typename R>
+VSNRAY_FUNC
+inline void store_aovs(std::false_type, RenderTargetRef, RR const&, R const&, int, int)
+{
+}
+
+template <typename RenderTargetRef, typename RR, typename R>
+VSNRAY_FUNC
+inline void store_aovs(
+        std::true_type      /* */,
+        RenderTargetRef     rt_ref,
+        RR const&           result,
+        R const&            r,
+        int                 x,
+        int                 y
+        )
+{
+    rt_ref.store_aovs(result, r, x, y);
+}
+
+template <typename RenderTargetRef, typename RR, typename R, typename T>
+VSNRAY_FUNC
+inline void blend_aovs(std::false_type, RenderTargetRef, RR const&, R const&, int, int, T const&, T const&)
+{
+}
+
+template <typename RenderTargetRef, typename RR, typename R, typename T>
+VSNRAY_FUNC
+inline void blend_aovs(
+        std::true_type      /* */,
+        RenderTargetRef     rt_ref,
+        RR const&           result,
+        R const&            r,
+        int                 x,
+        int                 y,
+        T const&            sfactor,
+        T const&            dfactor
+        )
+{
+    rt_ref.blend_aovs(result, r, x, y, sfactor, dfactor);
+}
+
+template <typename RenderTargetRef, typename RR, typename R>
+VSNRAY_FUNC
+inline void store_first_hit(
+        RenderTargetRef     rt_ref,
+        RR const&           result,
+        R const&            r,
+        int                 x,
+        int                 y,
+        int                 width,
+        int                 height
+        )
+{
+    feature_channels(has_feature_buffers<RenderTargetRef>{}, rt_ref).store(
+            result,
+            r,
+            nullptr,
+            x,
+            y,
+            width,
+            height
+            );
+
+    store_aovs(has_aovs<RenderTargetRef>{}, rt_ref, result, r, x, y);
+}
+
+template <typename RenderTargetRef, typename RR, typename R, typename T>
+VSNRAY_FUNC
+inline void blend_first_hit(
+        RenderTargetRef     rt_ref,
+        RR const&           result,
+        R const&            r,
+        int                 x,
+        int                 y,
+        int                 width,
+        int                 height,
+        T const&            sfactor,
+        T const&            dfactor
+        )
+{
+    feature_channels(has_feature_buffers<RenderTargetRef>{}, rt_ref).blend(
+            result,
+            r,
+            nullptr,
+            x,
+            y,
+            width,
+            height,
+            sfactor,
+            dfactor
+            );
+
+    blend_aovs(has_aovs<RenderTargetRef>{}, rt_ref, result, r, x, y, sfactor, dfactor);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Simple uniform pixel sampler
 //
@@ -306,6 +458,12 @@ inline void sample_pixel_impl(
 
         auto result = invoke_kernel(kernel, r, gen, x, y);
 
+        // Features and AOVs of the first sample only
+        if (s == 0)
+        {
+            store_first_hit(rt_ref, result, r, x, y, width, height);
+        }
+
         // Arbitrarily assign the depth of _one_ pixel that recorded a hit
         if (RenderTargetRef::depth_format != PF_UNSPECIFIED)
         {
@@ -390,6 +548,8 @@ inline void sample_pixel_impl(
 
     auto result = invoke_kernel(kernel, r, gen, x, y);
 
+    store_first_hit(rt_ref, result, r, x, y, width, height);
+
     // Arbitrarily assign the depth of _one_ pixel that recorded a hit
     if (RenderTargetRef::depth_format != PF_UNSPECIFIED)
     {
@@ -457,6 +617,12 @@ inline void sample_pixel_impl(
 
         auto result = invoke_kernel(kernel, r, gen, x, y);
 
+        // Features and AOVs of the first sample only, blended like the colors
+        if (s == 0)
+        {
+            blend_first_hit(rt_ref, result, r, x, y, width, height, ps.sfactor, ps.dfactor);
+        }
+
         // Arbitrarily assign the depth of _one_ pixel that recorded a hit
         if (RenderTargetRef::depth_format != PF_UNSPECIFIED)
         {
@@ -576,6 +742,7 @@ inline void sample_pixel(Args&&...  args)
     detail::sample_pixel_choose_intersector_impl(std::forward<Args>(args)...);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_SCHED_COMMON_H
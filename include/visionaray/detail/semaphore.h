@@ -7,6 +7,7 @@
 #define VSNRAY_DETAIL_SEMAPHORE_H 1
 
 #include "platform.h"
+#include "isa_namespace.h"
 
 #if defined(VSNRAY_OS_WIN32) || defined(VSNRAY_OS_DARWIN)
 #define VSNRAY_DETAIL_SEMAPHORE_USE_STD 1
@@ -22,6 +23,7 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 #ifdef VSNRAY_DETAIL_SEMAPHORE_USE_STD
 
@@ -91,6 +93,7 @@ private:
 
 #endif
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_SEMAPHORE_H
@@ -6,9 +6,11 @@
 #include "../result_record.h"
 #include "../spectrum.h"
 #include "../traverse.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simple
 {
 
@@ -51,6 +53,10 @@ struct kernel
 
             result.color = select(hit_rec.hit, to_rgba(shaded_clr), vector<4, S>(bgcolor, S(1.0)));
             result.depth = hit_rec.t;
+            result.normal = surf.shading_normal;
+            result.albedo = select(hit_rec.hit, to_rgb(surf.albedo(view_dir)), result.albedo);
+            result.prim_id = hit_rec.prim_id;
+            result.geom_id = hit_rec.geom_id;
         }
         else
         {
@@ -70,4 +76,5 @@ struct kernel
 };
 
 } // simple
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
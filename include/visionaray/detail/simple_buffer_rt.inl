@@ -3,62 +3,90 @@
 
 #include <algorithm>
 
+#include "color_conversion.h"
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Accessors
 //
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color()
 {
     return color_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth()
 {
     return depth_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum()
 {
     return accum_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::color() const
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::albedo()
+{
+    return albedo_buffer.data();
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::normal_depth()
+{
+    return normal_depth_buffer.data();
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::color() const
 {
     return color_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::depth() const
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::depth() const
 {
     return depth_buffer.data();
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::accum() const
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::accum() const
 {
     return accum_buffer.data();
 }
 
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::albedo() const
+{
+    return albedo_buffer.data();
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::feature_type const* simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::normal_depth() const
+{
+    return normal_depth_buffer.data();
+}
+
 
 //-------------------------------------------------------------------------------------------------
 // Interface
 //
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::ref_type simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::ref()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+typename simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::ref_type simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::ref()
 {
-    return { color(), depth(), accum(), width(), height() };
+    return { color(), depth(), accum(), width(), height(), albedo(), normal_depth() };
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_color_buffer(vec4 const& c)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_color_buffer(vec4 const& c)
 {
     // Convert from RGBA32F to internal color format
     color_type cc;
@@ -72,8 +100,8 @@ void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_color_buffer
     std::fill(color_buffer.begin(), color_buffer.end(), cc);
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_depth_buffer(float d)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_depth_buffer(float d)
 {
     // Convert from DEPTH32F to internal depth format
     depth_type dd;
@@ -87,11 +115,11 @@ void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_depth_buffer
     std::fill(depth_buffer.begin(), depth_buffer.end(), dd);
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_accum_buffer(vec4 const& c)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_accum_buffer(vec4 const& c)
 {
-    // Convert from RGBA32F to internal color format
-    color_type cc;
+    // Convert from RGBA32F to internal accum format
+    accum_type cc;
     convert(
         pixel_format_constant<AccumFormat>{},
         pixel_format_constant<PF_RGBA32F>{},
@@ -102,18 +130,33 @@ void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::clear_accum_buffer
     std::fill(accum_buffer.begin(), accum_buffer.end(), cc);
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::begin_frame()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::clear_feature_buffers()
+{
+    feature_type zero;
+    convert(
+        pixel_format_constant<FeatureFormat>{},
+        pixel_format_constant<PF_RGBA32F>{},
+        zero,
+        vec4(0.0f)
+        );
+
+    std::fill(albedo_buffer.begin(), albedo_buffer.end(), zero);
+    std::fill(normal_depth_buffer.begin(), normal_depth_buffer.end(), zero);
+}
+
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::begin_frame()
 {
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::end_frame()
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::end_frame()
 {
 }
 
-template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat>
-void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::resize(int w, int h)
+template <pixel_format ColorFormat, pixel_format DepthFormat, pixel_format AccumFormat, pixel_format FeatureFormat>
+void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat, FeatureFormat>::resize(int w, int h)
 {
     render_target::resize(w, h);
 
@@ -129,6 +172,13 @@ void simple_buffer_rt<ColorFormat, DepthFormat, AccumFormat>::resize(int w, int
     {
         accum_buffer.resize(w * h);
     }
+
+    if (FeatureFormat != PF_UNSPECIFIED)
+    {
+        albedo_buffer.resize(w * h);
+        normal_depth_buffer.resize(w * h);
+    }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
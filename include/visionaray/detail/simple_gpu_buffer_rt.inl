@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <thrust/fill.h>
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Accessors
@@ -99,4 +101,5 @@ void simple_gpu_buffer_rt<ColorFormat, DepthFormat>::resize(int w, int h)
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
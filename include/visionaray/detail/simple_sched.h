@@ -6,8 +6,11 @@
 #ifndef VSNRAY_DETAIL_SIMPLE_SCHED_H
 #define VSNRAY_DETAIL_SIMPLE_SCHED_H 1
 
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename R>
 class simple_sched
@@ -23,6 +26,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "simple_sched.inl"
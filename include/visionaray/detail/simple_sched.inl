@@ -3,12 +3,17 @@
 
 #include "../make_generator.h"
 #include "../make_random_seed.h"
+#include "../math/detail/math.h"
+#include "../math/rectangle.h"
 #include "../packet_traits.h"
+#include "../profiling.h"
 
 #include "sched_common.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Simple sched
@@ -21,14 +26,36 @@ void simple_sched<R>::frame(K kernel, SP sched_params)
     using S = typename R::scalar_type;
     using I = typename simd::int_type<S>::type;
 
+    VSNRAY_PROFILE_SCOPE_ID("frame", frame_id_);
+
     sched_params.cam.begin_frame();
 
-    sched_params.rt.begin_frame();
+    {
+        VSNRAY_PROFILE_SCOPE("begin_frame");
+        sched_params.rt.begin_frame();
+    }
+
+    int x0 = 0;
+    int y0 = 0;
+
+    int nx = sched_params.rt.width();
+    int ny = sched_params.rt.height();
 
+    // Region of interest
+    recti const& scissor = sched_params.scissor;
 
-    for (int y = 0; y < sched_params.rt.height(); ++y)
+    if (scissor.w > 0 && scissor.h > 0)
     {
-        for (int x = 0; x < sched_params.rt.width(); ++x)
+        x0 = max(scissor.x, 0);
+        y0 = max(scissor.y, 0);
+        nx = min(nx, scissor.x + scissor.w);
+        ny = min(ny, scissor.y + scissor.h);
+    }
+
+
+    for (int y = y0; y < ny; ++y)
+    {
+        for (int x = x0; x < nx; ++x)
         {
             expand_pixel<S> ep;
             auto seed = make_random_seed(
@@ -54,11 +81,15 @@ void simple_sched<R>::frame(K kernel, SP sched_params)
     }
 
 
-    sched_params.rt.end_frame();
+    {
+        VSNRAY_PROFILE_SCOPE("end_frame");
+        sched_params.rt.end_frame();
+    }
 
     sched_params.cam.end_frame();
 
     ++frame_id_;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -9,9 +9,11 @@
 #include <cmath>
 
 #include "../macros.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Spectral power distribution for blackbody radiator
@@ -53,6 +55,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_SPD_BLACKBODY_H
@@ -12,9 +12,11 @@
 #include <visionaray/math/detail/math.h>
 
 #include "../macros.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Measured spectrum for the cornell box data set
@@ -314,6 +316,7 @@ private:
             };
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_SPD_CORNELL_H
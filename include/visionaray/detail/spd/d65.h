@@ -7,9 +7,11 @@
 #define VSNRAY_DETAIL_SPD_D65_H 1
 
 #include "../../math/vector.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Spectral power distribution of D65 illuminant (daylight 6500 K)
@@ -94,6 +96,7 @@ public:
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_SPD_D65_H
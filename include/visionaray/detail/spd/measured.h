@@ -15,9 +15,11 @@
 #include "../../math/detail/math.h"
 
 #include "../macros.h"
+#include "../isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 //
@@ -82,6 +84,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_SPD_MEASURED_H
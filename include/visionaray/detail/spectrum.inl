@@ -8,9 +8,11 @@
 
 #include "../array.h"
 #include "color_conversion.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 
 //--------------------------------------------------------------------------------------------------
@@ -448,4 +450,5 @@ inline spectrum<float_from_simd_width_t<N>> pack(array<spectrum<float>, N> const
 
 } // simd
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
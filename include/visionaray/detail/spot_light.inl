@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // spot_light members
@@ -161,4 +164,5 @@ inline void spot_light<T>::set_quadratic_attenuation(T att)
     quadratic_attenuation_ = att;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -7,9 +7,11 @@
 #define VSNRAY_DETAIL_STACK_H 1
 
 #include "macros.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -51,6 +53,7 @@ struct stack
 };
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_STACK_H
@@ -5,9 +5,11 @@
 #include <utility>
 
 #include "../array.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -47,4 +49,5 @@ inline auto pack(array<surface<N, C, M>, Size> const& surfs)
 
 } // simd
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
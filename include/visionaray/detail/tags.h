@@ -7,6 +7,7 @@
 #define VSNRAY_DETAIL_TAGS_H 1
 
 #include <type_traits>
+#include "isa_namespace.h"
 
 
 //-------------------------------------------------------------------------------------------------
@@ -15,6 +16,7 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -35,7 +37,11 @@ using multi_hit_tag   = std::integral_constant<int, MultiHit>;
 
 struct have_intersector_tag {};
 
+// Occlusion queries, see occluded()
+struct occlusion_tag {};
+
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_TAGS_H
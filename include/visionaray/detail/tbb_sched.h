@@ -6,6 +6,7 @@
 #ifndef VSNRAY_DETAIL_TBB_SCHED_H
 #define VSNRAY_DETAIL_TBB_SCHED_H 1
 
+#include <tbb/blocked_range.h>
 #include <tbb/blocked_range2d.h>
 #include <tbb/parallel_for.h>
 #if 1 // TODO: find out when that API changed
@@ -15,11 +16,15 @@
 #include <tbb/task_scheduler_init.h>
 #endif
 
+#include "../math/detail/math.h"
+#include "../profiling.h"
 #include "basic_sched.h"
 #include "range.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 struct tbb_sched_backend
 {
@@ -29,11 +34,14 @@ struct tbb_sched_backend
 #else
         : init_(num_threads)
 #endif
+        , num_threads_(num_threads)
     {
     }
 
     void reset(unsigned num_threads)
     {
+        num_threads_ = num_threads;
+
 #if 1 // TODO: find out when that API changed
         tbb_gc_.reset(new tbb::global_control(tbb::global_control::max_allowed_parallelism, num_threads));
 #else
@@ -62,6 +70,8 @@ struct tbb_sched_backend
             tbb::blocked_range2d<int>(x0, nx, dx, y0, ny, dy),
             [=](tbb::blocked_range2d<int> const& r)
             {
+                VSNRAY_PROFILE_SCOPE("parallel_for tile");
+
                 for (int y = r.cols().begin(); y < r.cols().end(); y += packet_height)
                 {
                     for (int x = r.rows().begin(); x < r.rows().end(); x += packet_width)
@@ -72,16 +82,80 @@ struct tbb_sched_backend
             });
     }
 
+    unsigned num_threads() const
+    {
+        return num_threads_;
+    }
+
+    // Process tiles in the order given by tile_indices (see make_tile_order()),
+    // TBB's work stealing only approximately maintains that order
+    template <typename Func>
+    void for_each_packet(
+            tiled_range2d<int> const& tr,
+            int const* tile_indices,
+            int packet_width,
+            int packet_height,
+            Func const& func
+            )
+    {
+        if (tile_indices == nullptr)
+        {
+            for_each_packet(tr, packet_width, packet_height, func);
+            return;
+        }
+
+        int x0 = tr.rows().begin();
+        int y0 = tr.cols().begin();
+
+        int dx = tr.rows().tile_size();
+        int dy = tr.cols().tile_size();
+
+        int nx = tr.rows().end();
+        int ny = tr.cols().end();
+
+        int num_tiles_x = div_up(nx - x0, dx);
+        int num_tiles_y = div_up(ny - y0, dy);
+
+        tbb::parallel_for(
+            tbb::blocked_range<int>(0, num_tiles_x * num_tiles_y, 1),
+            [=](tbb::blocked_range<int> const& r)
+            {
+                for (int i = r.begin(); i != r.end(); ++i)
+                {
+                    int tile_index = tile_indices[i];
+
+                    VSNRAY_PROFILE_SCOPE_ID("parallel_for tile", tile_index);
+
+                    int first_x = (tile_index % num_tiles_x) * dx + x0;
+                    int last_x = min(first_x + dx, nx);
+
+                    int first_y = (tile_index / num_tiles_x) * dy + y0;
+                    int last_y = min(first_y + dy, ny);
+
+                    for (int y = first_y; y < last_y; y += packet_height)
+                    {
+                        for (int x = first_x; x < last_x; x += packet_width)
+                        {
+                            func(x, y);
+                        }
+                    }
+                }
+            });
+    }
+
 #if 1 // TODO: find out when that API changed
     std::unique_ptr<tbb::global_control> tbb_gc_;
 #else
     tbb::task_scheduler_init init_;
 #endif
+
+    unsigned num_threads_;
 };
 
 template <typename R>
 using tbb_sched = basic_sched<tbb_sched_backend, R>;
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_TBB_SCHED_H
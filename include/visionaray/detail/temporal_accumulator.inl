@@ -0,0 +1,389 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "../math/ray.h"
+#include "color_conversion.h"
+#include "parallel_for.h"
+#include "range.h"
+#include "isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+namespace temporal
+{
+
+//-------------------------------------------------------------------------------------------------
+// Parameters for reprojecting one frame
+//
+
+struct reproject_params
+{
+    pinhole_camera cam;
+    pinhole_camera prev_cam;
+    mat4 prev_view_proj;
+
+    int width;
+    int height;
+
+    vec4 const* prev_color;
+    vec4 const* prev_normal_depth;
+    float const* prev_length;
+
+    float depth_tolerance;
+    float normal_tolerance;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Position in the previous frame's pixel coordinates (pixel centers at
+// integer coordinates), point is homogeneous, w = 0 for points at infinity
+//
+
+inline bool project(reproject_params const& p, vec4 const& point, vec2& result)
+{
+    vec4 clip = p.prev_view_proj * point;
+
+    if (clip.w <= 0.0f)
+    {
+        return false;
+    }
+
+    vec2 screen = (clip.xy() / clip.w) * 0.5f + vec2(0.5f);
+
+    // Map from the full viewport to the image region
+    box2f region = p.prev_cam.get_image_region();
+    screen = (screen - region.min) / (region.max - region.min);
+
+    result = screen * vec2(p.width, p.height) - vec2(0.5f);
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Check if the history at pixel (x,y) belongs to the same surface as point
+//
+
+inline bool same_surface(
+        reproject_params const&                         p,
+        int                                             x,
+        int                                             y,
+        vec3 const&                                     point,
+        vec3 const&                                     normal,
+        float                                           distance
+        )
+{
+    vec4 nd = p.prev_normal_depth[y * p.width + x];
+
+    if (distance <= 0.0f || nd.w <= 0.0f)
+    {
+        // Background only matches background
+        return distance <= 0.0f && nd.w <= 0.0f;
+    }
+
+    auto r = p.prev_cam.primary_ray(
+            basic_ray<float>{},
+            static_cast<float>(x),
+            static_cast<float>(y),
+            static_cast<float>(p.width),
+            static_cast<float>(p.height)
+            );
+
+    vec3 prev_point = r.ori + r.dir * nd.w;
+    vec3 prev_normal = nd.xyz();
+
+    bool have_normals = dot(normal, normal) > 0.0f && dot(prev_normal, prev_normal) > 0.0f;
+
+    if (have_normals)
+    {
+        if (dot(normalize(normal), normalize(prev_normal)) < p.normal_tolerance)
+        {
+            return false;
+        }
+
+        // Tangent plane distance, robust at grazing angles
+        return std::abs(dot(prev_point - point, normalize(normal))) <= p.depth_tolerance * distance;
+    }
+    else
+    {
+        return length(prev_point - point) <= p.depth_tolerance * distance;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Fetch the history for pixel (x,y) of the current frame, returns the
+// history length, 0 if there is no valid history
+//
+
+inline float reproject(
+        reproject_params const&                         p,
+        int                                             x,
+        int                                             y,
+        vec4 const&                                     normal_depth,
+        vec4&                                           color,
+        vec2&                                           motion
+        )
+{
+    auto r = p.cam.primary_ray(
+            basic_ray<float>{},
+            static_cast<float>(x),
+            static_cast<float>(y),
+            static_cast<float>(p.width),
+            static_cast<float>(p.height)
+            );
+
+    float distance = normal_depth.w;
+
+    vec4 point = distance > 0.0f
+            ? vec4(r.ori + r.dir * distance, 1.0f)
+            : vec4(r.dir, 0.0f);
+
+    vec2 prev;
+    if (!project(p, point, prev))
+    {
+        motion = vec2(0.0f);
+        return 0.0f;
+    }
+
+    motion = prev - vec2(x, y);
+
+
+    // Bilinear fetch, skipping taps from other surfaces
+
+    int x0 = static_cast<int>(std::floor(prev.x));
+    int y0 = static_cast<int>(std::floor(prev.y));
+    float fx = prev.x - x0;
+    float fy = prev.y - y0;
+
+    vec4 color_sum(0.0f);
+    float length_sum = 0.0f;
+    float weight_sum = 0.0f;
+
+    for (int j = 0; j < 2; ++j)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            int xx = x0 + i;
+            int yy = y0 + j;
+
+            float w = (i ? fx : 1.0f - fx) * (j ? fy : 1.0f - fy);
+
+            if (w <= 0.0f || xx < 0 || yy < 0 || xx >= p.width || yy >= p.height)
+            {
+                continue;
+            }
+
+            if (!same_surface(p, xx, yy, point.xyz(), normal_depth.xyz(), distance))
+            {
+                continue;
+            }
+
+            size_t index = static_cast<size_t>(yy) * p.width + xx;
+            color_sum += p.prev_color[index] * w;
+            length_sum += p.prev_length[index] * w;
+            weight_sum += w;
+        }
+    }
+
+    if (weight_sum < 1e-3f)
+    {
+        return 0.0f;
+    }
+
+    color = color_sum / weight_sum;
+    return length_sum / weight_sum;
+}
+
+} // temporal
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// temporal_accumulator
+//
+
+inline temporal_accumulator::temporal_accumulator(unsigned num_threads)
+    : pool_(max(num_threads, 1U))
+{
+}
+
+inline void temporal_accumulator::set_max_history(unsigned max_history)
+{
+    max_history_ = max_history;
+}
+
+inline unsigned temporal_accumulator::max_history() const
+{
+    return max_history_;
+}
+
+inline void temporal_accumulator::set_depth_tolerance(float tolerance)
+{
+    depth_tolerance_ = tolerance;
+}
+
+inline float temporal_accumulator::depth_tolerance() const
+{
+    return depth_tolerance_;
+}
+
+inline void temporal_accumulator::set_normal_tolerance(float cos_angle)
+{
+    normal_tolerance_ = cos_angle;
+}
+
+inline float temporal_accumulator::normal_tolerance() const
+{
+    return normal_tolerance_;
+}
+
+inline void temporal_accumulator::reset()
+{
+    prev_width_ = 0;
+    prev_height_ = 0;
+}
+
+template <pixel_format DF>
+inline void temporal_accumulator::accumulate(
+        pixel_format_constant<DF>                   /* */,
+        typename pixel_traits<DF>::type*            dst,
+        vec4*                                       accum,
+        vec4 const*                                 normal_depth,
+        int                                         width,
+        int                                         height,
+        pinhole_camera const&                       cam
+        )
+{
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    size_t size = static_cast<size_t>(width) * height;
+
+    unsigned prev = curr_;
+    unsigned next = 1 - curr_;
+
+    color_[next].resize(size);
+    normal_depth_[next].resize(size);
+    length_[next].resize(size);
+    motion_.resize(size);
+
+    detail::temporal::reproject_params params;
+    params.cam = cam;
+    params.cam.begin_frame();
+    params.prev_cam = prev_cam_;
+    params.prev_view_proj = prev_cam_.get_proj_matrix() * prev_cam_.get_view_matrix();
+    params.width = width;
+    params.height = height;
+    params.prev_color = color_[prev].data();
+    params.prev_normal_depth = normal_depth_[prev].data();
+    params.prev_length = length_[prev].data();
+    params.depth_tolerance = depth_tolerance_;
+    params.normal_tolerance = normal_tolerance_;
+
+    bool have_history = prev_width_ == width && prev_height_ == height;
+
+    // If the camera did not move, pixels are reused as is (no resampling,
+    // and jittered samples at silhouettes do not reject the history)
+    bool static_camera = have_history && params.cam == prev_cam_;
+
+    float max_length = max_history_ > 0 ? static_cast<float>(max_history_) : numeric_limits<float>::max();
+
+    parallel_for(
+        pool_,
+        tiled_range1d<int>(0, height, 16),
+        [&](range1d<int> const& rows)
+        {
+            for (int y = rows.begin(); y != rows.end(); ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    size_t i = static_cast<size_t>(y) * width + x;
+
+                    vec4 history(0.0f);
+                    vec2 motion(0.0f);
+                    float len = 0.0f;
+
+                    if (static_camera)
+                    {
+                        history = params.prev_color[i];
+                        len = params.prev_length[i];
+                    }
+                    else if (have_history)
+                    {
+                        len = detail::temporal::reproject(params, x, y, normal_depth[i], history, motion);
+                    }
+
+                    len = min(len + 1.0f, max_length);
+
+                    vec4 result = lerp(history, accum[i], 1.0f / len);
+
+                    color_[next][i] = result;
+                    normal_depth_[next][i] = normal_depth[i];
+                    length_[next][i] = len;
+                    motion_[i] = motion;
+
+                    accum[i] = result;
+
+                    convert(
+                        pixel_format_constant<DF>{},
+                        pixel_format_constant<PF_RGBA32F>{},
+                        dst[i],
+                        result
+                        );
+                }
+            }
+        });
+
+    curr_ = next;
+    prev_cam_ = params.cam;
+    prev_width_ = width;
+    prev_height_ = height;
+}
+
+template <typename RenderTarget>
+inline void temporal_accumulator::accumulate(RenderTarget& rt, pinhole_camera const& cam)
+{
+    using ref_type = typename RenderTarget::ref_type;
+
+    static_assert(
+            ref_type::feature_format == PF_RGBA32F,
+            "Temporal accumulation requires RGBA32F feature buffers"
+            );
+
+    static_assert(
+            ref_type::accum_format == PF_RGBA32F,
+            "Temporal accumulation requires an RGBA32F accumulation buffer"
+            );
+
+    accumulate(
+        pixel_format_constant<ref_type::color_format>{},
+        rt.color(),
+        rt.accum(),
+        rt.normal_depth(),
+        rt.width(),
+        rt.height(),
+        cam
+        );
+}
+
+inline vec2 const* temporal_accumulator::motion_vectors() const
+{
+    return motion_.data();
+}
+
+inline float const* temporal_accumulator::history_length() const
+{
+    return length_[curr_].data();
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../sampling.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename R, typename Generator, typename T>
 VSNRAY_FUNC
@@ -30,4 +32,5 @@ inline R thin_lens_camera::primary_ray(
     return r;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
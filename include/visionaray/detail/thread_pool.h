@@ -14,10 +14,11 @@
 #include <mutex>
 #include <thread>
 
-#include "semaphore.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Thread pool
@@ -29,8 +30,6 @@ public:
 
     explicit thread_pool(unsigned num_threads)
     {
-        sync_params.start_threads = false;
-        sync_params.join_threads = false;
         reset(num_threads);
     }
 
@@ -59,8 +58,12 @@ public:
             return;
         }
 
-        sync_params.start_threads = true;
-        sync_params.join_threads = true;
+        // Flags are only changed while holding the mutex, otherwise a
+        // thread that just evaluated the wait predicate may miss the wakeup
+        {
+            std::unique_lock<std::mutex> lock(sync_params.mutex);
+            sync_params.join_threads = true;
+        }
         sync_params.threads_start.notify_all();
 
         for (unsigned i = 0; i < num_threads; ++i)
@@ -71,9 +74,9 @@ public:
             }
         }
 
-        sync_params.start_threads = false;
         sync_params.join_threads = false;
         threads.reset(nullptr);
+        num_threads = 0;
     }
 
     // Function to return an integer index in [0,N) given an opaque
@@ -91,26 +94,43 @@ public:
         return unsigned(-1);
     }
 
+    // Call f(i) for i in [0..queue_length) and wait until all calls have
+    // returned. Must not be called concurrently from several threads
     template <typename Func>
     void run(Func f, long queue_length)
     {
-        // Set worker function
-        func = f;
+        if (queue_length <= 0)
+        {
+            return;
+        }
 
-        // Set counters
-        sync_params.num_work_items = queue_length;
-        sync_params.work_item_counter = 0;
-        sync_params.work_items_finished_counter = 0;
+        {
+            std::unique_lock<std::mutex> lock(sync_params.mutex);
 
-        // Activate persistent threads
-        sync_params.start_threads = true;
-        sync_params.threads_start.notify_all();
+            // Set worker function
+            func = f;
+
+            // Set counters
+            sync_params.num_work_items = queue_length;
+            sync_params.work_item_counter = 0;
+            sync_params.work_items_finished_counter = 0;
 
-        // Wait for all threads to finish
-        sync_params.threads_ready.wait();
+            // Activate persistent threads
+            ++sync_params.generation;
+        }
+        sync_params.threads_start.notify_all();
 
-        // Idle w/o work
-        sync_params.start_threads = false;
+        // Wait until all work items are finished and no thread
+        // accesses the counters of this run anymore
+        std::unique_lock<std::mutex> lock(sync_params.mutex);
+        sync_params.threads_ready.wait(
+                lock,
+                [this]()
+                {
+                    return sync_params.work_items_finished_counter == sync_params.num_work_items
+                        && sync_params.active_threads == 0;
+                }
+                );
     }
 
     std::unique_ptr<std::thread[]> threads;
@@ -126,10 +146,12 @@ private:
     {
         std::mutex              mutex;
         std::condition_variable threads_start;
-        visionaray::semaphore   threads_ready;
+        std::condition_variable threads_ready;
 
-        std::atomic<bool>       start_threads;
-        std::atomic<bool>       join_threads;
+        // Protected by mutex
+        bool                    join_threads = false;
+        unsigned long           generation = 0;
+        unsigned                active_threads = 0;
 
         std::atomic<long>       num_work_items;
         std::atomic<long>       work_item_counter;
@@ -138,6 +160,8 @@ private:
 
     void thread_loop()
     {
+        unsigned long generation = 0;
+
         for (;;)
         {
             // Wait until activated
@@ -145,18 +169,20 @@ private:
                 std::unique_lock<std::mutex> lock(sync_params.mutex);
                 sync_params.threads_start.wait(
                         lock,
-                        [this]()
-                            -> std::atomic<bool> const&
+                        [&]()
                         {
-                            return sync_params.start_threads;
+                            return sync_params.join_threads || sync_params.generation != generation;
                         }
                         );
-            }
 
-            // Exit?
-            if (sync_params.join_threads)
-            {
-                break;
+                // Exit?
+                if (sync_params.join_threads)
+                {
+                    break;
+                }
+
+                generation = sync_params.generation;
+                ++sync_params.active_threads;
             }
 
 
@@ -172,19 +198,19 @@ private:
 
                 func(work_item);
 
-                auto finished = sync_params.work_items_finished_counter.fetch_add(1);
+                sync_params.work_items_finished_counter.fetch_add(1);
+            }
 
-                if (finished >= sync_params.num_work_items - 1)
-                {
-                    assert(finished == sync_params.num_work_items - 1);
-                    sync_params.threads_ready.notify();
-                    break;
-                }
+            {
+                std::unique_lock<std::mutex> lock(sync_params.mutex);
+                --sync_params.active_threads;
             }
+            sync_params.threads_ready.notify_one();
         }
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_THREAD_POOL_H
@@ -0,0 +1,170 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_DETAIL_TILE_ORDER_H
+#define VSNRAY_DETAIL_TILE_ORDER_H 1
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../math/detail/math.h"
+#include "../math/constants.h"
+#include "../morton.h"
+#include "isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Order in which the scheduler hands out image tiles to threads
+//
+//  RowMajorOrder:  left to right, top to bottom
+//  MortonOrder:    along a Z-order curve, neighboring tiles are rendered close in time
+//  HilbertOrder:   along a Hilbert curve, like Morton but without large jumps
+//  SpiralOrder:    center-out, the image center is available first
+//
+
+enum tile_order { RowMajorOrder, MortonOrder, HilbertOrder, SpiralOrder };
+
+
+namespace detail
+{
+
+//-------------------------------------------------------------------------------------------------
+// Distance of (x,y) along a Hilbert curve covering an n x n grid, n must be a power of two
+//
+
+inline unsigned hilbert_index(unsigned n, unsigned x, unsigned y)
+{
+    unsigned d = 0;
+
+    for (unsigned s = n / 2; s > 0; s /= 2)
+    {
+        unsigned rx = (x & s) > 0;
+        unsigned ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+
+        // Rotate quadrant
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+
+            std::swap(x, y);
+        }
+    }
+
+    return d;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Tile size for an image of width x height pixels
+//
+// Aims for at least 16 tiles per thread so that threads stay busy even if the
+// cost per tile varies a lot, but does not go below 8x8 pixels per tile so that
+// per-tile overhead stays small.
+//
+
+inline int auto_tile_size(int width, int height, unsigned num_threads)
+{
+    int min_tiles = 16 * static_cast<int>(max(num_threads, 1U));
+
+    int size = 64;
+
+    while (size > 8 && div_up(width, size) * div_up(height, size) < min_tiles)
+    {
+        size /= 2;
+    }
+
+    return size;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Compute the order of the tiles of a num_tiles_x * num_tiles_y grid
+//
+// Stores a permutation of the linear tile indices (y * num_tiles_x + x) in result
+//
+
+inline void make_tile_order(
+        tile_order          order,
+        int                 num_tiles_x,
+        int                 num_tiles_y,
+        std::vector<int>&   result
+        )
+{
+    int num_tiles = num_tiles_x * num_tiles_y;
+
+    result.resize(num_tiles);
+
+    for (int i = 0; i < num_tiles; ++i)
+    {
+        result[i] = i;
+    }
+
+    if (order == RowMajorOrder || num_tiles == 0)
+    {
+        return;
+    }
+
+    // Sort tiles by key
+    std::vector<std::pair<unsigned long long, int>> keys(num_tiles);
+
+    unsigned n = next_pow2(static_cast<unsigned>(max(num_tiles_x, num_tiles_y)));
+
+    float cx = (num_tiles_x - 1) * 0.5f;
+    float cy = (num_tiles_y - 1) * 0.5f;
+
+    for (int i = 0; i < num_tiles; ++i)
+    {
+        unsigned x = static_cast<unsigned>(i % num_tiles_x);
+        unsigned y = static_cast<unsigned>(i / num_tiles_x);
+
+        unsigned long long key = 0;
+
+        if (order == MortonOrder)
+        {
+            key = morton_encode2D(x, y);
+        }
+        else if (order == HilbertOrder)
+        {
+            key = hilbert_index(n, x, y);
+        }
+        else if (order == SpiralOrder)
+        {
+            // Square rings around the center, counter-clockwise inside each ring
+            float dx = x - cx;
+            float dy = y - cy;
+            float ring = max(std::abs(dx), std::abs(dy));
+            float angle = std::atan2(dy, dx) + constants::pi<float>();
+
+            key = (static_cast<unsigned long long>(ring * 2.0f) << 32)
+                | static_cast<unsigned long long>(angle * 65536.0f);
+        }
+
+        keys[i] = std::make_pair(key, i);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    for (int i = 0; i < num_tiles; ++i)
+    {
+        result[i] = keys[i].second;
+    }
+}
+
+} // detail
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#endif // VSNRAY_DETAIL_TILE_ORDER_H
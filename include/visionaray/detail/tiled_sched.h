@@ -11,9 +11,11 @@
 #include "parallel_for.h"
 #include "range.h"
 #include "thread_pool.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 struct int2
 {
@@ -47,9 +49,28 @@ struct tiled_sched_backend
         pool_.reset(num_threads);
     }
 
+    unsigned num_threads() const
+    {
+        return pool_.num_threads;
+    }
+
+    template <typename Func>
+    void for_each_packet(
+            tiled_range2d<int> const& tr,
+            int packet_width,
+            int packet_height,
+            Func const& func
+            )
+    {
+        for_each_packet(tr, nullptr, packet_width, packet_height, func);
+    }
+
+    // Process tiles in the order given by tile_indices (see make_tile_order()),
+    // or in row-major order if tile_indices is nullptr
     template <typename Func>
     void for_each_packet(
             tiled_range2d<int> const& tr,
+            int const* tile_indices,
             int packet_width,
             int packet_height,
             Func const& func
@@ -66,10 +87,7 @@ struct tiled_sched_backend
         launchDim.y = tr.cols().length();
 #endif
 
-        visionaray::parallel_for(
-            pool_,
-            tr,
-            [=](range2d<int> const& r)
+        auto tile_func = [=](range2d<int> const& r)
             {
 #ifdef VSNRAY_TILED_SCHED_CUDA_STYLE_THREAD_INTROSPECTION
                 blockIdx.x = r.rows().begin() / r.rows().length();
@@ -91,7 +109,16 @@ struct tiled_sched_backend
                         func(x, y);
                     }
                 }
-            });
+            };
+
+        if (tile_indices != nullptr)
+        {
+            visionaray::parallel_for(pool_, tr, tile_indices, tile_func);
+        }
+        else
+        {
+            visionaray::parallel_for(pool_, tr, tile_func);
+        }
     }
 
     thread_pool pool_;
@@ -100,6 +127,7 @@ struct tiled_sched_backend
 template <typename R>
 using tiled_sched = basic_sched<tiled_sched_backend, R>;
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_TILED_SCHED
@@ -10,9 +10,11 @@
 
 #include "../array.h"
 #include "tags.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -37,6 +39,7 @@ struct traversal_result<HR, MultiHit, MaxHits>
 };
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_DETAIL_TRAVERSAL_RESULT_H
@@ -6,6 +6,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <visionaray/math/simd/type_traits.h>
 #include <visionaray/bvh.h>
 #include <visionaray/intersector.h>
 #include <visionaray/update_if.h>
@@ -14,9 +15,11 @@
 #include "macros.h"
 #include "multi_hit.h"
 #include "traversal_result.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -197,6 +200,59 @@ inline auto any_hit(R const& r, P begin, P end)
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// occluded
+//
+// Returns a mask that is set for the rays that hit any primitive in [r.tmin..r.tmax].
+// Cheaper than any_hit() for shadow rays: no hit records are assembled and the
+// traversal of a packet ends as soon as all its rays are occluded. Rays with
+// tmin > tmax are inactive and are reported as not occluded.
+//
+
+template <
+    typename R,
+    typename Primitives,
+    typename Intersector,
+    typename Primitive = typename std::iterator_traits<Primitives>::value_type
+    >
+VSNRAY_FUNC
+VSNRAY_FORCE_INLINE auto occluded(
+        R const&        r,
+        Primitives      begin,
+        Primitives      end,
+        Intersector&    isect
+        )
+    -> simd::mask_type_t<typename R::scalar_type>
+{
+    using M = simd::mask_type_t<typename R::scalar_type>;
+
+    M active = r.tmin <= r.tmax;
+    M result(false);
+
+    for (Primitives it = begin; it != end && any(active && !result); ++it)
+    {
+        result = result || detail::occluded_prim(
+                is_any_bvh<Primitive>{},
+                r,
+                *it,
+                isect,
+                M(active && !result)
+                );
+    }
+
+    return result;
+}
+
+template <typename R, typename Primitives>
+VSNRAY_FUNC
+VSNRAY_FORCE_INLINE auto occluded(R const& r, Primitives begin, Primitives end)
+    -> simd::mask_type_t<typename R::scalar_type>
+{
+    default_intersector ignore;
+    return occluded(r, begin, end, ignore);
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // closest hit
 //
@@ -276,4 +332,5 @@ inline auto multi_hit(R const& r, Primitives begin, Primitives end)
     return multi_hit<N>(r, begin, end, ignore);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -0,0 +1,131 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include "../math/detail/math.h"
+#include "../texture/texture.h"
+#include "isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+//-------------------------------------------------------------------------------------------------
+// Step size so that a sample at majorant opacity m contributes at most max_step_opacity
+//
+
+inline float adaptive_step_size(float m, ray_marching_params const& params)
+{
+    if (m >= 1.0f)
+    {
+        return params.min_step;
+    }
+
+    // Transparent cells, or no limit for the opacity per sample
+    if (m <= 0.0f || params.max_step_opacity >= 1.0f)
+    {
+        return params.max_step;
+    }
+
+    // Solve 1 - (1 - m)^(dt / reference_step) = max_step_opacity for dt
+    float dt = params.reference_step * log(1.0f - params.max_step_opacity) / log(1.0f - m);
+    return clamp(dt, params.min_step, params.max_step);
+}
+
+} // detail
+
+
+template <typename Volume, typename Transfunc>
+inline vec4 integrate_emission_absorption(
+        basic_ray<float> const&     ray,
+        Volume const&               volume,
+        Transfunc const&            transfunc,
+        macrocell_grid const&       grid,
+        ray_marching_params const&  params,
+        ray_marching_stats&         stats
+        )
+{
+    vec4 result(0.0f);
+
+    aabb const& bounds = grid.bounds();
+    vec3 inv_size = vec3(1.0f) / bounds.size();
+    float value_scale = 1.0f / (params.value_range.y - params.value_range.x);
+
+    // Step sizes are distances, ray parameters are scaled by the direction's length
+    float dir_length = length(ray.dir);
+
+    traverse_grid(ray, grid, [&](vec3i const& cell, float t0, float t1)
+    {
+        ++stats.cells_visited;
+
+        float majorant = grid.majorant(cell);
+
+        if (majorant <= params.empty_threshold)
+        {
+            ++stats.cells_skipped;
+            return true;
+        }
+
+        float seg_length = (t1 - t0) * dir_length;
+
+        if (seg_length <= 0.0f)
+        {
+            return true;
+        }
+
+        // Divide the segment inside the cell into equal steps no longer than
+        // the adaptive step size, so that short segments get a sample, too
+        float max_dt = detail::adaptive_step_size(majorant, params);
+        int num_steps = max(1, static_cast<int>(ceil(seg_length / max_dt)));
+        float dt = (t1 - t0) / num_steps;
+        float exponent = seg_length / (num_steps * params.reference_step);
+
+        // Sample at the center of each step
+        for (int i = 0; i < num_steps; ++i)
+        {
+            float t = t0 + (i + 0.5f) * dt;
+
+            vec3 pos = ray.ori + ray.dir * t;
+            vec3 tex_coord = (pos - bounds.min) * inv_size;
+
+            float voxel = static_cast<float>(tex3D(volume, tex_coord));
+            vec4 color = tex1D(transfunc, (voxel - params.value_range.x) * value_scale);
+
+            ++stats.samples;
+
+            // Opacity correction for the actual step size
+            color.w = 1.0f - pow(1.0f - color.w, exponent);
+
+            // Premultiplied alpha, front-to-back compositing
+            color.xyz() *= color.w;
+            result += color * (1.0f - result.w);
+
+            // Early ray termination
+            if (result.w >= params.termination_opacity)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    });
+
+    return result;
+}
+
+template <typename Volume, typename Transfunc>
+inline vec4 integrate_emission_absorption(
+        basic_ray<float> const&     ray,
+        Volume const&               volume,
+        Transfunc const&            transfunc,
+        macrocell_grid const&       grid,
+        ray_marching_params const&  params
+        )
+{
+    ray_marching_stats stats;
+    return integrate_emission_absorption(ray, volume, transfunc, grid, params, stats);
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
@@ -11,9 +11,11 @@
 #include "../result_record.h"
 #include "../spectrum.h"
 #include "../traverse.h"
+#include "isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace whitted
 {
 
@@ -237,6 +239,8 @@ struct kernel
         {
             result.hit = hit_rec.hit;
             result.depth = hit_rec.t;
+            result.prim_id = hit_rec.prim_id;
+            result.geom_id = hit_rec.geom_id;
         }
         else
         {
@@ -255,12 +259,19 @@ struct kernel
             hit_rec.isect_pos = ray.ori + ray.dir * hit_rec.t;
 
             auto surf = get_surface(hit_rec, params);
+
             auto env = params.amb_light.intensity(ray.dir);
             auto bgcolor = params.background.intensity(ray.dir);
             auto ambient = surf.material.ambient() * C(from_rgb(env));
             auto shaded_clr = select( hit_rec.hit, ambient, C(from_rgb(bgcolor)) );
             auto view_dir = -ray.dir;
 
+            if (depth == 1)
+            {
+                result.normal = surf.shading_normal;
+                result.albedo = select(hit_rec.hit, to_rgb(surf.albedo(view_dir)), result.albedo);
+            }
+
             for (auto it = params.lights.begin; it != params.lights.end; ++it)
             {
                 auto light_dir = normalize( V(it->position()) - hit_rec.isect_pos );
@@ -273,9 +284,13 @@ struct kernel
                         S(0.0),                                            // tmin
                         length(hit_rec.isect_pos - V(it->position()))      // tmax
                         );
+                shadow_ray.time = ray.time;
+
+                // tmin > tmax disables the shadow rays of lanes that missed
+                shadow_ray.tmax = select(hit_rec.hit, shadow_ray.tmax, S(-1.0));
 
                 // only cast a shadow if occluder between light source and hit pos
-                auto shadow_rec = any_hit(
+                auto occl = occluded(
                         shadow_ray,
                         params.prims.begin,
                         params.prims.end,
@@ -283,7 +298,7 @@ struct kernel
                         );
 
                 shaded_clr += select(
-                        hit_rec.hit & !shadow_rec.hit,
+                        hit_rec.hit & !occl,
                         clr,
                         C(0.0)
                         );
@@ -296,10 +311,12 @@ struct kernel
             if (any(bounce.kr > S(0.0)))
             {
                 auto dir = bounce.reflected_dir;
+                auto time = ray.time;
                 ray = R(
                     hit_rec.isect_pos + dir * S(params.epsilon),
                     dir
                     );
+                ray.time = time;
                 hit_rec = closest_hit(ray, params.prims.begin, params.prims.end, isect);
             }
             throughput *= bounce.kr;
@@ -325,4 +342,5 @@ struct kernel
 };
 
 } // whitted
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
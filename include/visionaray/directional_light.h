@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "math/vector.h"
 #include "light_sample.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class directional_light
@@ -50,6 +52,7 @@ private:
     T           angular_diameter_;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/directional_light.inl"
@@ -10,9 +10,11 @@
 #include "math/matrix.h"
 #include "math/vector.h"
 #include "spectrum.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T, typename Texture>
 class environment_light
@@ -50,6 +52,7 @@ private:
     matrix<4, 4, T> world_to_light_transform_;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/environment_light.inl"
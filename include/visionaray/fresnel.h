@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "spectrum.h"
 #include "tags.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 VSNRAY_FUNC
@@ -55,6 +57,7 @@ inline spectrum<T> fresnel_reflectance(
     return (rs * rs + rp * rp) / T(2.0);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_FRESNEL_H
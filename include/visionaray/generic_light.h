@@ -10,9 +10,11 @@
 #include "math/vector.h"
 #include "light_sample.h"
 #include "variant.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Generic light
@@ -61,6 +63,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/generic_light.inl"
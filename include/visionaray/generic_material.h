@@ -10,9 +10,11 @@
 #include "math/vector.h"
 #include "spectrum.h"
 #include "variant.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Generic material
@@ -73,6 +75,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/generic_material.inl"
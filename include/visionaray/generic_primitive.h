@@ -8,9 +8,11 @@
 
 #include "detail/macros.h"
 #include "variant.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Generic primitive
@@ -41,6 +43,7 @@ public:
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/generic_primitive/get_color.inl"
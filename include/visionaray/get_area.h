@@ -13,9 +13,11 @@
 #include "detail/macros.h"
 #include "math/simd/type_traits.h"
 #include "bvh.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 #if 1
 // TODO!!
@@ -203,6 +205,7 @@ inline auto get_area(Primitives const& prims, HR const& hr, void* = nullptr)
     return T(result);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_GET_AREA_H
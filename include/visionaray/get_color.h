@@ -11,13 +11,17 @@
 
 #include "detail/macros.h"
 #include "math/simd/type_traits.h"
+#include "math/indexed_triangle.h"
+#include "math/precomputed_triangle.h"
 #include "math/triangle.h"
 #include "math/vector.h"
 #include "array.h"
 #include "tags.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Unspecified binding, just return white
@@ -95,6 +99,38 @@ inline auto get_color(
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Get indexed triangle vertex color from array
+//
+// Colors are indexed with the triangle's vertex indices. Only for scalar hit
+// records, get_surface() evaluates SIMD hit records per lane
+//
+
+template <
+    typename Colors,
+    typename HR,
+    typename T,
+    typename = typename std::enable_if<!simd::is_simd_vector<typename HR::scalar_type>::value>::type
+    >
+VSNRAY_FUNC
+inline auto get_color(
+        Colors                              colors,
+        HR const&                           hr,
+        basic_indexed_triangle<T> const&    prim,
+        colors_per_vertex_binding           /* */
+        )
+    -> typename std::iterator_traits<Colors>::value_type
+{
+    return lerp(
+            colors[prim.i1],
+            colors[prim.i2],
+            colors[prim.i3],
+            hr.u,
+            hr.v
+            );
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Gather N face colors for SIMD ray
 //
@@ -263,6 +299,26 @@ inline auto get_color(Colors colors, HR const& hr, ColorBinding /* */)
             );
 }
 
+
+
+//-------------------------------------------------------------------------------------------------
+// Get precomputed triangle vertex color from array, same as for triangles
+//
+
+template <typename Colors, typename HR, typename T>
+VSNRAY_FUNC
+inline auto get_color(
+        Colors                                  colors,
+        HR const&                               hr,
+        basic_precomputed_triangle<T> const&    /* */,
+        colors_per_vertex_binding               /* */
+        )
+    -> decltype( get_color(colors, hr, basic_triangle<3, T>{}, colors_per_vertex_binding{}) )
+{
+    return get_color(colors, hr, basic_triangle<3, T>{}, colors_per_vertex_binding{});
+}
+
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_GET_COLOR_H
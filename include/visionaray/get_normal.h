@@ -11,16 +11,21 @@
 
 #include "detail/macros.h"
 #include "math/simd/type_traits.h"
+#include "math/curve.h"
 #include "math/cylinder.h"
+#include "math/indexed_triangle.h"
 #include "math/plane.h"
+#include "math/precomputed_triangle.h"
 #include "math/sphere.h"
 #include "math/triangle.h"
 #include "math/vector.h"
 #include "prim_traits.h"
 #include "tags.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Default get_normal implementation, assumes that normal list is unused!
@@ -99,6 +104,38 @@ inline auto get_normal(
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Get face normal of indexed triangle from array, same as for triangles
+//
+
+template <typename Normals, typename HR, typename T>
+VSNRAY_FUNC
+inline auto get_normal(
+        Normals                             normals,
+        HR const&                           hr,
+        basic_indexed_triangle<T> const&    /* */
+        )
+{
+    return get_normal(normals, hr, basic_triangle<3, T>{});
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Get face normal of precomputed triangle from array, same as for triangles
+//
+
+template <typename Normals, typename HR, typename T>
+VSNRAY_FUNC
+inline auto get_normal(
+        Normals                                 normals,
+        HR const&                               hr,
+        basic_precomputed_triangle<T> const&    /* */
+        )
+{
+    return get_normal(normals, hr, basic_triangle<3, T>{});
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Get normal from triangle primitive
 //
@@ -113,6 +150,42 @@ inline vector<3, T> get_normal(HR const& hr, basic_triangle<3, T> const& triangl
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Get normal from precomputed triangle primitive, the transform's third row is
+// parallel to the normal
+//
+
+template <typename HR, typename T>
+VSNRAY_FUNC
+inline vector<3, T> get_normal(HR const& hr, basic_precomputed_triangle<T> const& triangle)
+{
+    VSNRAY_UNUSED(hr);
+
+    return normalize(triangle.row2.xyz());
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Get normal on curve surface, points away from the center line at the curve
+// parameter stored in hr.u. Ribbons (see intersect_ribbon()) have no meaningful
+// normal, shade them using the tangent, e.g. curve.dfdt(hr.u)
+//
+
+template <typename HR, typename T>
+VSNRAY_FUNC
+inline auto get_normal(HR const& hr, basic_curve<T> const& curve)
+{
+    return normalize(hr.isect_pos - curve.f(hr.u));
+}
+
+template <typename HR, typename T>
+VSNRAY_FUNC
+inline auto get_normal(HR const& hr, basic_oriented_curve<T> const& curve)
+{
+    return get_normal(hr, static_cast<basic_curve<T> const&>(curve));
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Get normal on cylinder surface
 //
@@ -170,6 +243,7 @@ inline auto get_normal(HR const& hr, basic_sphere<T> const& sphere)
     return (hr.isect_pos - V(sphere.center)) / S(sphere.radius);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_GET_NORMAL_H
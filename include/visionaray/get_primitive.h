@@ -10,9 +10,11 @@
 
 #include "detail/macros.h"
 #include "bvh.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Get primitive from iterable list
@@ -68,6 +70,7 @@ inline auto get_primitive(Primitives prims, HR const& hr)
     return prims[0].primitive(hr.primitive_list_index).primitive(hr.primitive_list_index_inst);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_GET_PRIMITIVE_H
@@ -12,13 +12,17 @@
 #include "detail/macros.h"
 #include "math/detail/math.h"
 #include "math/simd/type_traits.h"
+#include "math/indexed_triangle.h"
+#include "math/precomputed_triangle.h"
 #include "math/triangle.h"
 #include "get_normal.h"
 #include "prim_traits.h"
 #include "tags.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Default get_shading_normal w/o normal list, dispatches to get_normal (geometric!)
@@ -168,6 +172,57 @@ inline auto get_shading_normal(
     return normalize( lerp(n1, n2, n3, hr.u, hr.v) );
 }
 
+
+//-------------------------------------------------------------------------------------------------
+// get_shading_normal for indexed triangles with normals_per_vertex_binding
+//
+// Normals are indexed with the triangle's vertex indices. Only for scalar hit
+// records, get_surface() evaluates SIMD hit records per lane
+//
+
+template <
+    typename Normals,
+    typename HR,
+    typename T,
+    typename = typename std::enable_if<!simd::is_simd_vector<typename HR::scalar_type>::value>::type
+    >
+VSNRAY_FUNC
+inline auto get_shading_normal(
+        Normals                             normals,
+        HR const&                           hr,
+        basic_indexed_triangle<T> const&    prim,
+        normals_per_vertex_binding          /* */
+        )
+{
+    return normalize( lerp(
+            normals[prim.i1],
+            normals[prim.i2],
+            normals[prim.i3],
+            hr.u,
+            hr.v
+            ) );
+}
+
+
+
+//-------------------------------------------------------------------------------------------------
+// get_shading_normal for precomputed triangles, same as for triangles
+//
+
+template <typename Normals, typename HR, typename T>
+VSNRAY_FUNC
+inline auto get_shading_normal(
+        Normals                                 normals,
+        HR const&                               hr,
+        basic_precomputed_triangle<T> const&    /* */,
+        normals_per_vertex_binding              /* */
+        )
+    -> decltype( get_shading_normal(normals, hr, basic_triangle<3, T>{}, normals_per_vertex_binding{}) )
+{
+    return get_shading_normal(normals, hr, basic_triangle<3, T>{}, normals_per_vertex_binding{});
+}
+
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_GET_SHADING_NORMAL_H
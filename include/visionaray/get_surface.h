@@ -18,9 +18,11 @@
 #include "get_shading_normal.h"
 #include "get_tex_coord.h"
 #include "surface.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -199,6 +201,7 @@ inline auto get_surface(HR const& hr, Params const& p)
     return detail::get_surface_impl(hr, p);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_SURFACE_H
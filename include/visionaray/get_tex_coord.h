@@ -13,14 +13,18 @@
 #include "math/detail/math.h"
 #include "math/simd/type_traits.h"
 #include "math/constants.h"
+#include "math/indexed_triangle.h"
+#include "math/precomputed_triangle.h"
 #include "math/sphere.h"
 #include "math/triangle.h"
 #include "math/vector.h"
 #include "array.h"
+#include "detail/isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Default get_tex_coord implementation, assumes that tex coord list is unused!
@@ -113,6 +117,46 @@ inline auto get_tex_coord(TexCoords tex_coords, HR const& hr, basic_triangle<3,
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Indexed triangle
+//
+// Texture coordinates are indexed with the triangle's vertex indices. Only for
+// scalar hit records, get_surface() evaluates SIMD hit records per lane
+//
+
+template <
+    typename TexCoords,
+    typename HR,
+    typename T,
+    typename = typename std::enable_if<!simd::is_simd_vector<typename HR::scalar_type>::value>::type
+    >
+VSNRAY_FUNC
+inline auto get_tex_coord(TexCoords tex_coords, HR const& hr, basic_indexed_triangle<T> const& prim)
+    -> typename std::iterator_traits<TexCoords>::value_type
+{
+    return lerp(
+            tex_coords[prim.i1],
+            tex_coords[prim.i2],
+            tex_coords[prim.i3],
+            hr.u,
+            hr.v
+            );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Precomputed triangle, same as for triangles
+//
+
+template <typename TexCoords, typename HR, typename T>
+VSNRAY_FUNC
+inline auto get_tex_coord(TexCoords tex_coords, HR const& hr, basic_precomputed_triangle<T> const& /* */)
+    -> decltype( get_tex_coord(tex_coords, hr, basic_triangle<3, T>{}) )
+{
+    return get_tex_coord(tex_coords, hr, basic_triangle<3, T>{});
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Sphere
 //
@@ -206,6 +250,7 @@ inline auto get_tex_coord(TexCoords coords, HR const& hr)
     return get_tex_coord(coords, hr, basic_triangle<3, typename HR::scalar_type>{});
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_GET_TEX_COORD_H
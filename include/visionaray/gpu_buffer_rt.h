@@ -10,9 +10,11 @@
 #include "math/vector.h"
 #include "pixel_traits.h"
 #include "render_target.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 // TODO: have a *single* buffered render target template
 // from either std::vector or thrust::device_vector???
@@ -59,6 +61,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/gpu_buffer_rt.inl"
@@ -13,9 +13,11 @@
 #include "detail/macros.h"
 #include "detail/tags.h"
 #include "bvh.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Base type for custom intersectors
@@ -113,6 +115,27 @@ struct basic_intersector
     {
         return intersect<detail::MultiHit, N>(ray, prim, *static_cast<Derived*>(this), update_cond);
     }
+
+
+    // BVH occlusion --------------------------------------
+
+    template <
+        typename R,
+        typename P,
+        typename M,
+        typename = typename std::enable_if<is_any_bvh<P>::value>::type
+        >
+    VSNRAY_FUNC
+    VSNRAY_FORCE_INLINE auto operator()(
+            detail::occlusion_tag   /* */,
+            R const&                ray,
+            P const&                prim,
+            M const&                active
+            )
+        -> decltype( occluded(ray, prim, std::declval<Derived&>(), active) )
+    {
+        return occluded(ray, prim, *static_cast<Derived*>(this), active);
+    }
 };
 
 
@@ -124,6 +147,78 @@ struct default_intersector : basic_intersector<default_intersector>
 {
 };
 
+
+//-------------------------------------------------------------------------------------------------
+// Intersector with a watertight ray / triangle test, see intersect_watertight()
+//
+
+struct watertight_intersector : basic_intersector<watertight_intersector>
+{
+    using basic_intersector<watertight_intersector>::operator();
+
+    template <typename R, typename U>
+    VSNRAY_FUNC
+    auto operator()(R const& ray, basic_triangle<3, U, unsigned> const& tri)
+        -> decltype( intersect_watertight(ray, tri) )
+    {
+        return intersect_watertight(ray, tri);
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Intersector for indexed triangles, holds the vertex array the triangles reference
+//
+
+template <typename T>
+struct indexed_triangle_intersector : basic_intersector<indexed_triangle_intersector<T>>
+{
+    using basic_intersector<indexed_triangle_intersector<T>>::operator();
+
+    VSNRAY_FUNC
+    explicit indexed_triangle_intersector(vector<3, T> const* vertices)
+        : vertices(vertices)
+    {
+    }
+
+    template <typename R>
+    VSNRAY_FUNC
+    auto operator()(R const& ray, basic_indexed_triangle<T, unsigned> const& tri)
+        -> decltype( intersect(ray, tri, std::declval<vector<3, T> const*>()) )
+    {
+        return intersect(ray, tri, vertices);
+    }
+
+    vector<3, T> const* vertices;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Intersector that treats curves as flat ribbons that face the ray, see intersect_ribbon()
+//
+
+struct ribbon_curve_intersector : basic_intersector<ribbon_curve_intersector>
+{
+    using basic_intersector<ribbon_curve_intersector>::operator();
+
+    template <typename R, typename U>
+    VSNRAY_FUNC
+    auto operator()(R const& ray, basic_curve<U, unsigned> const& curve)
+        -> decltype( intersect_ribbon(ray, curve) )
+    {
+        return intersect_ribbon(ray, curve);
+    }
+
+    template <typename R, typename U>
+    VSNRAY_FUNC
+    auto operator()(R const& ray, basic_oriented_curve<U, unsigned> const& curve)
+        -> decltype( intersect_ribbon(ray, curve) )
+    {
+        return intersect_ribbon(ray, curve);
+    }
+};
+
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_INTERSECTOR_H
@@ -0,0 +1,218 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_ISA_DISPATCH_H
+#define VSNRAY_ISA_DISPATCH_H 1
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "math/simd/intrinsics.h"
+#include "math/simd/type_traits.h"
+#include "cpu_features.h"
+#include "packet_traits.h"
+#include "detail/isa_namespace.h"
+
+//-------------------------------------------------------------------------------------------------
+// Per-ISA compilation and runtime dispatch
+//
+// The SIMD backend (VSNRAY_SIMD_ISA_) and with it the packet types are fixed at
+// compile time. To use the widest packets the host supports from a single binary,
+// compile kernels (code that calls the scheduler's frame(), traverses BVHs, filters
+// textures, ...) in separate translation units, once per instruction set and with
+// the respective compiler flags (see visionaray_add_isa_sources() in CMake). Inside
+// such a translation unit, VSNRAY_ISA_FUNCTION(name) gives a function a per-ISA name
+// and simd::isa_float is the widest float type of that ISA:
+//
+//     // kernel.cpp, compiled once per ISA
+//     void VSNRAY_ISA_FUNCTION(render)(params const& p)
+//     {
+//         using ray_type = basic_ray<simd::isa_float>;
+//         ...
+//     }
+//
+// At startup, an isa_dispatcher collects the implementations and selects the widest
+// one the host supports (see cpu_features.h):
+//
+//     isa_dispatcher<void(params const&)> render;
+//     render.add(VSNRAY_SIMD_ISA_SSE4_1, render_sse4_1);
+//     render.add(VSNRAY_SIMD_ISA_AVX2, render_avx2);
+//     render.select();
+//     render(p);
+//
+// Caveats:
+//
+//  - visionaray_add_isa_sources() defines VSNRAY_ISA_NAMESPACE, so that the library's
+//    inline functions and templates are declared in a per-ISA inline namespace (see
+//    detail/isa_namespace.h) and the linker cannot replace the baseline definitions
+//    with ones that use instructions the host may lack. Inline functions and templates
+//    of your own that are shared between the per-ISA and the baseline translation
+//    units need the same treatment: declare them between VSNRAY_ISA_NAMESPACE_BEGIN
+//    and VSNRAY_ISA_NAMESPACE_END. Standard library templates that are instantiated
+//    only with fundamental types (e.g. std::vector<float>) are still shared, keep
+//    such code in the baseline translation units.
+//
+//  - Translation units compiled for an ISA must not define namespace scope objects
+//    with dynamic initialization, their initializers run on any host.
+//
+
+
+//-------------------------------------------------------------------------------------------------
+// Name suffix and SIMD width of the ISA compiled for
+//
+
+#if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX512F)
+#define VSNRAY_ISA_SUFFIX avx512f
+#define VSNRAY_ISA_SIMD_WIDTH 16
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX2)
+#define VSNRAY_ISA_SUFFIX avx2
+#define VSNRAY_ISA_SIMD_WIDTH 8
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX)
+#define VSNRAY_ISA_SUFFIX avx
+#define VSNRAY_ISA_SIMD_WIDTH 8
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_SSE4_2)
+#define VSNRAY_ISA_SUFFIX sse4_2
+#define VSNRAY_ISA_SIMD_WIDTH 4
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_SSE4_1)
+#define VSNRAY_ISA_SUFFIX sse4_1
+#define VSNRAY_ISA_SIMD_WIDTH 4
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_SSSE3)
+#define VSNRAY_ISA_SUFFIX ssse3
+#define VSNRAY_ISA_SIMD_WIDTH 4
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_SSE3)
+#define VSNRAY_ISA_SUFFIX sse3
+#define VSNRAY_ISA_SIMD_WIDTH 4
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_SSE2)
+#define VSNRAY_ISA_SUFFIX sse2
+#define VSNRAY_ISA_SIMD_WIDTH 4
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_NEON_FP)
+#define VSNRAY_ISA_SUFFIX neon_fp
+#define VSNRAY_ISA_SIMD_WIDTH 4
+#elif VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_NEON)
+#define VSNRAY_ISA_SUFFIX neon
+#define VSNRAY_ISA_SIMD_WIDTH 4
+#else
+#define VSNRAY_ISA_SUFFIX generic
+#define VSNRAY_ISA_SIMD_WIDTH 1
+#endif
+
+#define VSNRAY_ISA_CONCAT_(A, B) A ## _ ## B
+#define VSNRAY_ISA_CONCAT(A, B) VSNRAY_ISA_CONCAT_(A, B)
+
+// name_<suffix>, e.g. render_avx2
+#define VSNRAY_ISA_FUNCTION(NAME) VSNRAY_ISA_CONCAT(NAME, VSNRAY_ISA_SUFFIX)
+
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace simd
+{
+
+//-------------------------------------------------------------------------------------------------
+// Widest float type of the ISA compiled for
+//
+
+#if VSNRAY_ISA_SIMD_WIDTH > 1
+using isa_float = float_from_simd_width_t<VSNRAY_ISA_SIMD_WIDTH>;
+#else
+using isa_float = float;
+#endif
+
+} // simd
+
+
+//-------------------------------------------------------------------------------------------------
+// ISA that the calling translation unit was compiled for
+//
+
+inline int compiled_simd_isa()
+{
+    return VSNRAY_SIMD_ISA_;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Select one of several per-ISA implementations of a function at runtime
+//
+
+template <typename Signature>
+class isa_dispatcher;
+
+template <typename R, typename ...Args>
+class isa_dispatcher<R(Args...)>
+{
+public:
+
+    using function_type = R(*)(Args...);
+
+public:
+
+    // Register an implementation that was compiled for isa
+    void add(int isa, function_type func)
+    {
+        impls_.push_back({ isa, func });
+    }
+
+    // Select the widest registered implementation that the host supports and that
+    // does not exceed max_isa, returns false if there is none
+    bool select(int max_isa)
+    {
+        selected_ = nullptr;
+        selected_isa_ = -1;
+
+        for (auto const& impl : impls_)
+        {
+            if (impl.isa <= max_isa && impl.isa > selected_isa_ && host_supports_simd_isa(impl.isa))
+            {
+                selected_ = impl.func;
+                selected_isa_ = impl.isa;
+            }
+        }
+
+        return selected_ != nullptr;
+    }
+
+    bool select()
+    {
+        return select(host_simd_isa());
+    }
+
+    // ISA of the selected implementation, -1 if none was selected
+    int selected_isa() const
+    {
+        return selected_isa_;
+    }
+
+    bool valid() const
+    {
+        return selected_ != nullptr;
+    }
+
+    R operator()(Args... args) const
+    {
+        assert(selected_ != nullptr);
+        return selected_(std::forward<Args>(args)...);
+    }
+
+private:
+
+    struct impl
+    {
+        int isa;
+        function_type func;
+    };
+
+    std::vector<impl> impls_;
+    function_type selected_ = nullptr;
+    int selected_isa_ = -1;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#endif // VSNRAY_ISA_DISPATCH_H
@@ -14,9 +14,11 @@
 #include "prim_traits.h"
 #include "ambient_light.h"
 #include "tags.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Parameter struct for built-in kernels
@@ -453,6 +455,7 @@ auto make_kernel_params(
         amb_light
         };
 }
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/pathtracing.inl"
@@ -8,9 +8,11 @@
 
 #include "math/simd/type_traits.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 struct light_sample
@@ -37,6 +39,7 @@ struct light_sample
     simd::mask_type_t<T> delta_light;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_LIGHT_SAMPLE_H
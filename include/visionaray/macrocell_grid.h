@@ -0,0 +1,139 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_MACROCELL_GRID_H
+#define VSNRAY_MACROCELL_GRID_H 1
+
+#include <cstddef>
+
+#include "detail/thread_pool.h"
+#include "math/aabb.h"
+#include "math/forward.h"
+#include "math/ray.h"
+#include "math/vector.h"
+#include "aligned_vector.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Macrocell grid
+//
+// Coarse uniform grid over the bounds of a volume. For each cell, the grid stores
+// the range of voxel values that can be reconstructed inside the cell (including
+// the neighboring voxels that trilinear interpolation reaches into), and a
+// majorant derived from that range, e.g. the maximum opacity a transfer function
+// assigns to those values, or the maximum extinction of a participating medium.
+// Cells with a majorant of zero are empty and can be skipped by traversal.
+//
+
+class macrocell_grid
+{
+public:
+
+    macrocell_grid() = default;
+    macrocell_grid(vec3i const& dims, aabb const& bounds);
+
+    // Compute the value range of each cell from a 3D texture spanning bounds()
+    template <typename Volume>
+    void build(Volume const& volume);
+
+    // Compute the value range of each cell, cells are processed in parallel
+    template <typename Volume>
+    void build(Volume const& volume, thread_pool& pool);
+
+    // Compute the value range of each cell by evaluating func(world_pos) at
+    // samples_per_cell^3 positions evenly distributed over the cell, including
+    // the cell boundaries. Use this for procedural densities.
+    //
+    // Point samples can miss features that lie between them, so the upper bound
+    // of each range is widened to also cover the samples of the neighboring cells.
+    // This is only a heuristic. If func is Lipschitz continuous and lipschitz > 0
+    // is an upper bound for its Lipschitz constant, the range is additionally
+    // padded by the max. deviation from the nearest sample and is then guaranteed
+    // to be conservative.
+    // For discontinuous functions, use build_from_range_function() instead
+    template <typename Func>
+    void build_from_function(
+            Func func,
+            vec3i const& samples_per_cell = vec3i(8),
+            float lipschitz = 0.0f
+            );
+
+    // Same as above, cells are processed in parallel
+    template <typename Func>
+    void build_from_function(
+            Func func,
+            vec3i const& samples_per_cell,
+            thread_pool& pool,
+            float lipschitz = 0.0f
+            );
+
+    // Set the value range of each cell to func(cell_bounds). func must return a
+    // conservative range [lo..hi] of the values inside the given box
+    template <typename RangeFunc>
+    void build_from_range_function(RangeFunc func);
+
+    // Same as above, cells are processed in parallel
+    template <typename RangeFunc>
+    void build_from_range_function(RangeFunc func, thread_pool& pool);
+
+    // Set the majorant of each cell to the max. opacity the 1D transfer function
+    // assigns to the cell's value range. Voxel values in value_range are mapped
+    // to transfer function coordinates [0..1]
+    template <typename Transfunc>
+    void compute_opacity_majorants(Transfunc const& transfunc, vec2 const& value_range = vec2(0.0f, 1.0f));
+
+    // Set the majorant of each cell to func(cell_value_range)
+    template <typename Func>
+    void compute_majorants(Func func);
+
+    vec3i dims() const;
+    aabb const& bounds() const;
+    vec3 cell_size() const;
+
+    // Index of the cell containing pos, clamped to the grid
+    vec3i cell_index(vec3 const& pos) const;
+    aabb cell_bounds(vec3i const& index) const;
+
+    vec2 value_range(vec3i const& index) const;
+
+    float majorant(vec3i const& index) const;
+    float max_majorant() const;
+
+private:
+
+    size_t linear_index(vec3i const& index) const;
+
+    // Widen sampled value ranges, see build_from_function()
+    void pad_sampled_ranges(vec3i const& samples_per_cell, float lipschitz);
+
+    vec3i                   dims_ = vec3i(0);
+    aabb                    bounds_;
+    aligned_vector<vec2>    value_ranges_;
+    aligned_vector<float>   majorants_;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// 3D-DDA grid traversal (Amanatides and Woo)
+//
+// Visits the cells pierced by the ray segment [ray.tmin..ray.tmax] in front-to-back
+// order and calls func(index, t0, t1) for each cell, where [t0..t1] is the ray
+// parameter interval inside the cell. Traversal stops early if func returns false
+//
+
+template <typename Func>
+void traverse_grid(basic_ray<float> const& ray, macrocell_grid const& grid, Func func);
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#include "detail/macrocell_grid.inl"
+
+#endif // VSNRAY_MACROCELL_GRID_H
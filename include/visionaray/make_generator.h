@@ -11,9 +11,11 @@
 #include "detail/macros.h"
 #include "pixel_sampler_types.h"
 #include "random_generator.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -62,6 +64,7 @@ auto make_generator(T /* */, PixelSampler /* */, Args&&... args)
             );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_MAKE_GENERATOR_H
@@ -10,9 +10,11 @@
 #include "math/simd/type_traits.h"
 #include "array.h"
 #include "packet_traits.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Make random seed for LCG
@@ -66,6 +68,7 @@ inline array<unsigned, simd::num_elements<I>::value> make_random_seed(I val0, I
     return result;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_MAKE_RANDOM_SEED_H
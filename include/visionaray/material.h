@@ -11,10 +11,12 @@
 #include "brdf.h"
 #include "shade_record.h"
 #include "spectrum.h"
+#include "detail/isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Material classes
@@ -424,6 +426,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/material/emissive.inl"
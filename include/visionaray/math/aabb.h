@@ -10,9 +10,11 @@
 
 #include "config.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T, size_t Dim>
 class basic_aabb
@@ -56,6 +58,7 @@ public:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/aabb.inl"
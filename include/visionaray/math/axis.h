@@ -10,9 +10,11 @@
 
 #include "config.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <size_t Dim>
 class cartesian_axis;
@@ -63,6 +65,7 @@ vector<Dim, float> to_vector(cartesian_axis<Dim> const& a)
     return result;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_AXIS_H
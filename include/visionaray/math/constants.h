@@ -7,9 +7,11 @@
 #define VSNRAY_MATH_CONSTANTS_H 1
 
 #include "config.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace constants
 {
 
@@ -28,6 +30,7 @@ template <typename T> MATH_FUNC T pi_over_two()         { return T(1.57079632679
 template <typename T> MATH_FUNC T pi_over_four()        { return T(7.85398163397448278999490867136e-01); }
 
 } // constants
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_CONSTANTS_H
@@ -9,9 +9,11 @@
 #include "detail/math.h"
 #include "config.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Convert from spherical to cartesian coordinates
@@ -28,6 +30,7 @@ vector<3, T> spherical_to_cartesian(T const& theta, T const& phi, T const& r)
         );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_COORDINATES_H
@@ -0,0 +1,105 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_MATH_CURVE_H
+#define VSNRAY_MATH_CURVE_H 1
+
+#include "config.h"
+#include "primitive.h"
+#include "vector.h"
+#include "../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+// Number of linear segments curves are approximated with
+enum { curve_segments = 8 };
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// Cubic Bezier curve with constant radius, e.g. a hair or fur segment
+//
+// Curves are intersected as a chain of linear segments (see intersect() in
+// intersect.h), either as round tubes or as flat ribbons that face the ray.
+// The curve's parameter at the hit point is returned in hit_record::u, the
+// signed offset from the center line (in [-1..1], relative to the radius)
+// in hit_record::v.
+//
+// Uniform B-splines can be converted with make_bspline_curve().
+//
+
+template <typename T, typename P>
+class basic_curve : public primitive<P>
+{
+public:
+
+    using scalar_type   = T;
+    using vec_type      = vector<3, T>;
+
+public:
+
+    basic_curve() = default;
+    MATH_FUNC basic_curve(
+            vector<3, T> const& w0,
+            vector<3, T> const& w1,
+            vector<3, T> const& w2,
+            vector<3, T> const& w3,
+            T const& r
+            );
+
+    // Position on the curve, t in [0..1]
+    template <typename U>
+    MATH_FUNC vector<3, U> f(U const& t) const;
+
+    // Tangent (not normalized)
+    template <typename U>
+    MATH_FUNC vector<3, U> dfdt(U const& t) const;
+
+    // Control points
+    vec_type w0;
+    vec_type w1;
+    vec_type w2;
+    vec_type w3;
+
+    scalar_type radius;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Curve with an oriented bounding box
+//
+// The box is aligned with the chord w0->w3 and is tested before the curve. For long,
+// thin and diagonal segments, that axis-aligned BVH leaves bound badly, this culls
+// most of the rays that hit the leaf's box but miss the curve. The box is stored as
+// the rows of the transform from world space to the unit cube [0..1]^3, this costs
+// another 48 bytes per curve.
+//
+
+template <typename T, typename P>
+class basic_oriented_curve : public basic_curve<T, P>
+{
+public:
+
+    basic_oriented_curve() = default;
+    MATH_FUNC explicit basic_oriented_curve(basic_curve<T, P> const& curve);
+
+    vector<4, T> obb_row0;
+    vector<4, T> obb_row1;
+    vector<4, T> obb_row2;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
+
+#include "detail/curve.inl"
+
+#endif // VSNRAY_MATH_CURVE_H
@@ -9,9 +9,11 @@
 #include "config.h"
 #include "primitive.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T, typename P>
 class basic_cylinder : public primitive<P>
@@ -32,6 +34,7 @@ public:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/cylinder.inl"
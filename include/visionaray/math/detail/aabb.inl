@@ -7,10 +7,12 @@
 #include "../axis.h"
 #include "../config.h"
 #include "../limits.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // aabb members
@@ -363,4 +365,5 @@ inline basic_aabb<float_from_simd_width_t<N>, 3> pack(array<basic_aabb<T, 3>, N>
 
 } // simd
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -0,0 +1,226 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include "../aabb.h"
+#include "../limits.h"
+#include "../../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Curve members
+//
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_curve<T, P>::basic_curve(
+        vector<3, T> const& w0,
+        vector<3, T> const& w1,
+        vector<3, T> const& w2,
+        vector<3, T> const& w3,
+        T const& r
+        )
+    : w0(w0)
+    , w1(w1)
+    , w2(w2)
+    , w3(w3)
+    , radius(r)
+{
+}
+
+template <typename T, typename P>
+template <typename U>
+MATH_FUNC
+inline vector<3, U> basic_curve<T, P>::f(U const& t) const
+{
+    U tinv = U(1.0) - t;
+
+    return tinv * tinv * tinv * vector<3, U>(w0)
+         + U(3.0) * tinv * tinv * t * vector<3, U>(w1)
+         + U(3.0) * tinv * t * t * vector<3, U>(w2)
+         + t * t * t * vector<3, U>(w3);
+}
+
+template <typename T, typename P>
+template <typename U>
+MATH_FUNC
+inline vector<3, U> basic_curve<T, P>::dfdt(U const& t) const
+{
+    U tinv = U(1.0) - t;
+
+    return U(3.0) * tinv * tinv * vector<3, U>(w1 - w0)
+         + U(6.0) * tinv * t * vector<3, U>(w2 - w1)
+         + U(3.0) * t * t * vector<3, U>(w3 - w2);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Oriented curve members
+//
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_oriented_curve<T, P>::basic_oriented_curve(basic_curve<T, P> const& curve)
+    : basic_curve<T, P>(curve)
+{
+    vector<3, T> chord = curve.w3 - curve.w0;
+
+    // x is the chord, y points towards the inner control point that deviates most
+    vector<3, T> x = length(chord) > T(0.0) ? normalize(chord) : vector<3, T>(T(1.0), T(0.0), T(0.0));
+
+    vector<3, T> d1 = curve.w1 - curve.w0;
+    vector<3, T> d2 = curve.w2 - curve.w0;
+    d1 -= x * dot(d1, x);
+    d2 -= x * dot(d2, x);
+
+    vector<3, T> dev = length(d1) > length(d2) ? d1 : d2;
+
+    vector<3, T> y;
+    vector<3, T> z;
+
+    if (length(dev) > T(0.0))
+    {
+        y = normalize(dev);
+        z = cross(x, y);
+    }
+    else
+    {
+        make_orthonormal_basis(y, z, x);
+    }
+
+    // The curve lies in the convex hull of its control points
+    vector<3, T> axes[] = { x, y, z };
+    vector<4, T>* rows[] = { &obb_row0, &obb_row1, &obb_row2 };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        T p0 = dot(axes[i], curve.w0);
+        T p1 = dot(axes[i], curve.w1);
+        T p2 = dot(axes[i], curve.w2);
+        T p3 = dot(axes[i], curve.w3);
+
+        T lo = min(min(p0, p1), min(p2, p3)) - curve.radius;
+        T hi = max(max(p0, p1), max(p2, p3)) + curve.radius;
+
+        T extent = max(hi - lo, numeric_limits<T>::min());
+
+        *rows[i] = vector<4, T>(axes[i] / extent, -lo / extent);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Geometric functions
+//
+
+// Curve from the control points of a uniform cubic B-spline
+template <typename T>
+MATH_FUNC
+inline basic_curve<T> make_bspline_curve(
+        vector<3, T> const& p0,
+        vector<3, T> const& p1,
+        vector<3, T> const& p2,
+        vector<3, T> const& p3,
+        T const& r
+        )
+{
+    return basic_curve<T>(
+            (p0 + T(4.0) * p1 + p2) / T(6.0),
+            (T(4.0) * p1 + T(2.0) * p2) / T(6.0),
+            (T(2.0) * p1 + T(4.0) * p2) / T(6.0),
+            (p1 + T(4.0) * p2 + p3) / T(6.0),
+            r
+            );
+}
+
+// Split the curve at t (de Casteljau)
+template <typename T, typename P>
+MATH_FUNC
+inline void subdivide(
+        basic_curve<T, P> const&    curve,
+        T const&                    t,
+        basic_curve<T, P>&          left,
+        basic_curve<T, P>&          right
+        )
+{
+    vector<3, T> q0 = lerp(curve.w0, curve.w1, t);
+    vector<3, T> q1 = lerp(curve.w1, curve.w2, t);
+    vector<3, T> q2 = lerp(curve.w2, curve.w3, t);
+
+    vector<3, T> r0 = lerp(q0, q1, t);
+    vector<3, T> r1 = lerp(q1, q2, t);
+
+    vector<3, T> s0 = lerp(r0, r1, t);
+
+    left = curve;
+    left.w1 = q0;
+    left.w2 = r0;
+    left.w3 = s0;
+
+    right = curve;
+    right.w0 = s0;
+    right.w1 = r1;
+    right.w2 = q2;
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_aabb<T> get_bounds(basic_curve<T, P> const& curve)
+{
+    basic_aabb<T> result;
+    result.invalidate();
+    result.insert(curve.w0);
+    result.insert(curve.w3);
+
+    // Extrema where the derivative (a quadratic) is zero
+    for (int i = 0; i < 3; ++i)
+    {
+        T a = -curve.w0[i] + T(3.0) * curve.w1[i] - T(3.0) * curve.w2[i] + curve.w3[i];
+        T b = curve.w0[i] - T(2.0) * curve.w1[i] + curve.w2[i];
+        T c = curve.w1[i] - curve.w0[i];
+
+        T roots[2] = { T(-1.0), T(-1.0) };
+
+        if (a != T(0.0))
+        {
+            T h = b * b - a * c;
+
+            if (h >= T(0.0))
+            {
+                h = sqrt(h);
+                roots[0] = (-b - h) / a;
+                roots[1] = (-b + h) / a;
+            }
+        }
+        else if (b != T(0.0))
+        {
+            roots[0] = -c / (T(2.0) * b);
+        }
+
+        for (int j = 0; j < 2; ++j)
+        {
+            if (roots[j] > T(0.0) && roots[j] < T(1.0))
+            {
+                T p = curve.f(roots[j])[i];
+                result.min[i] = min(result.min[i], p);
+                result.max[i] = max(result.max[i], p);
+            }
+        }
+    }
+
+    result.min -= vector<3, T>(curve.radius);
+    result.max += vector<3, T>(curve.radius);
+    return result;
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_aabb<T> get_bounds(basic_oriented_curve<T, P> const& curve)
+{
+    return get_bounds(static_cast<basic_curve<T, P> const&>(curve));
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../aabb.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Cylinder members
@@ -43,4 +45,5 @@ inline basic_aabb<T> get_bounds(basic_cylinder<T, P> const& c)
     return result;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
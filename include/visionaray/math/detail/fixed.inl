@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <cmath>
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -462,4 +464,5 @@ inline fixed<I, F> select(bool k, fixed<I, F> const& a, fixed<I, F> const& b)
     return k ? a : b;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -0,0 +1,145 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include "../../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+namespace detail
+{
+
+union float_bits
+{
+    float    f;
+    uint32_t u;
+};
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// Bit conversion
+//
+
+MATH_FUNC
+inline uint16_t float_to_half_bits(float f)
+{
+    detail::float_bits fb;
+    fb.f = f;
+    uint32_t x = fb.u;
+
+    uint32_t sign = (x >> 16) & 0x8000;
+    uint32_t exp  = (x >> 23) & 0xFF;
+    uint32_t mant = x & 0x7FFFFF;
+
+    if (exp == 0xFF)
+    {
+        // Inf or NaN (keep a quiet NaN)
+        return static_cast<uint16_t>(sign | 0x7C00 | (mant ? 0x200 : 0));
+    }
+
+    int e = static_cast<int>(exp) - 127 + 15;
+
+    if (e >= 31)
+    {
+        // Overflow
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+
+    if (e <= 0)
+    {
+        if (e < -10)
+        {
+            // Underflow to zero
+            return static_cast<uint16_t>(sign);
+        }
+
+        // Denormal, shift in the implicit one
+        mant |= 0x800000;
+        uint32_t shift = static_cast<uint32_t>(14 - e);
+        uint32_t h = mant >> shift;
+        uint32_t rem = mant & ((1U << shift) - 1);
+        uint32_t halfway = 1U << (shift - 1);
+
+        if (rem > halfway || (rem == halfway && (h & 1)))
+        {
+            ++h;
+        }
+
+        return static_cast<uint16_t>(sign | h);
+    }
+
+    uint32_t h = (static_cast<uint32_t>(e) << 10) | (mant >> 13);
+    uint32_t rem = mant & 0x1FFF;
+
+    // Round to nearest even, a carry into the exponent is correct
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+    {
+        ++h;
+    }
+
+    return static_cast<uint16_t>(sign | h);
+}
+
+MATH_FUNC
+inline float half_bits_to_float(uint16_t h)
+{
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t exp  = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+
+    detail::float_bits fb;
+
+    if (exp == 0x1F)
+    {
+        // Inf or NaN
+        fb.u = sign | 0x7F800000 | (mant << 13);
+    }
+    else if (exp == 0)
+    {
+        if (mant == 0)
+        {
+            fb.u = sign;
+        }
+        else
+        {
+            // Denormal, normalize
+            int e = -1;
+            do
+            {
+                ++e;
+                mant <<= 1;
+            }
+            while ((mant & 0x400) == 0);
+
+            fb.u = sign | (static_cast<uint32_t>(127 - 15 - e) << 23) | ((mant & 0x3FF) << 13);
+        }
+    }
+    else
+    {
+        fb.u = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+
+    return fb.f;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// half members
+//
+
+MATH_FUNC
+inline half::half(float f)
+    : value(float_to_half_bits(f))
+{
+}
+
+MATH_FUNC
+inline half::operator float() const
+{
+    return half_bits_to_float(value);
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
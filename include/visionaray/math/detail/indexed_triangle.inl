@@ -0,0 +1,98 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include "../aabb.h"
+#include "../triangle.h"
+#include "../../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Indexed triangle members
+//
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_indexed_triangle<T, P>::basic_indexed_triangle(
+        index_type i1,
+        index_type i2,
+        index_type i3
+        )
+    : i1(i1)
+    , i2(i2)
+    , i3(i3)
+{
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Geometric functions
+//
+
+template <typename T, typename P>
+MATH_FUNC
+inline T area(basic_indexed_triangle<T, P> const& t, vector<3, T> const* vertices)
+{
+    return T(0.5) * length(cross(vertices[t.i2] - vertices[t.i1], vertices[t.i3] - vertices[t.i1]));
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_aabb<T> get_bounds(basic_indexed_triangle<T, P> const& t, vector<3, T> const* vertices)
+{
+    basic_aabb<T> bounds;
+
+    bounds.invalidate();
+    bounds.insert(vertices[t.i1]);
+    bounds.insert(vertices[t.i2]);
+    bounds.insert(vertices[t.i3]);
+
+    return bounds;
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline array<vector<3, T>, 3> compute_vertices(basic_indexed_triangle<T, P> const& t, vector<3, T> const* vertices)
+{
+    return {{ vertices[t.i1], vertices[t.i2], vertices[t.i3] }};
+}
+
+// Triangle with the same vertices and ids, with vertex and edge vectors
+template <typename T, typename P>
+MATH_FUNC
+inline basic_triangle<3, T, P> make_triangle(basic_indexed_triangle<T, P> const& t, vector<3, T> const* vertices)
+{
+    vector<3, T> const& v1 = vertices[t.i1];
+
+    basic_triangle<3, T, P> result(v1, vertices[t.i2] - v1, vertices[t.i3] - v1);
+    result.prim_id = t.prim_id;
+    result.geom_id = t.geom_id;
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Bound indexed triangle
+//
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_bound_indexed_triangle<T, P> bind_vertices(
+        basic_indexed_triangle<T, P> const& t,
+        vector<3, T> const*                 vertices
+        )
+{
+    return { t, vertices };
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_aabb<T> get_bounds(basic_bound_indexed_triangle<T, P> const& t)
+{
+    return get_bounds(t.triangle, t.vertices);
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../../detail/isa_namespace.h"
+
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 MATH_FUNC
@@ -45,4 +48,5 @@ inline bool operator==(interval<T> const& a, interval<T> const& b)
     return a.min == b.min && a.max == b.max;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
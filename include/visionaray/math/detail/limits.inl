@@ -4,9 +4,11 @@
 #include <cfloat>
 #include <climits>
 #include <limits>
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // generic limits: no CUDA
@@ -409,4 +411,5 @@ MATH_FUNC inline simd::basic_int<T> numeric_limits<simd::basic_int<T>>::max()
     return simd::basic_int<T>(INT_MAX);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -21,10 +21,12 @@
 #endif
 
 #include "../config.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // Import required math functions from the standard library.
@@ -599,6 +601,7 @@ inline T det2(T const& m00, T const& m01, T const& m10, T const& m11)
     return m00 * m11 - m10 * m01;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_DETAIL_MATH_H
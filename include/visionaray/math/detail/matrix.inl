@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../../detail/isa_namespace.h"
+
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // matrix members
@@ -99,4 +102,5 @@ inline bool operator!=(matrix<N, M, T> const& a, matrix<N, M, T> const& b)
     return !(a == b);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
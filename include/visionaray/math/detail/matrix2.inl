@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../../detail/isa_namespace.h"
+
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // matrix2 members
@@ -211,4 +214,5 @@ inline matrix<2, 2, T> transpose(matrix<2, 2, T> const& m)
     return result;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../quaternion.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // matrix3 members
@@ -404,4 +406,5 @@ inline quaternion<T> rotation(matrix<3, 3, T> const& m)
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../config.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // matrix4 members
@@ -598,4 +600,5 @@ inline array<matrix<4, 4, element_type_t<T>>, num_elements<T>::value> unpack(mat
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
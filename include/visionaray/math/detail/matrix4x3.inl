@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include "../config.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // matrix4x3 members
@@ -293,4 +295,5 @@ inline array<matrix<4, 3, element_type_t<T>>, num_elements<T>::value> unpack(mat
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../../detail/isa_namespace.h"
+
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // plane members
@@ -45,4 +48,5 @@ inline auto operator!=(basic_plane<Dim, T, P> const& a, basic_plane<Dim, T, P> c
     return a.normal != b.normal || a.offset != b.offset;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -0,0 +1,106 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include "../aabb.h"
+#include "../triangle.h"
+#include "../../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Precomputed triangle members
+//
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_precomputed_triangle<T, P>::basic_precomputed_triangle(basic_triangle<3, T, P> const& tri)
+{
+    this->prim_id = tri.prim_id;
+    this->geom_id = tri.geom_id;
+
+    vector<3, T> n = cross(tri.e1, tri.e2);
+    T det = dot(n, n);
+
+    if (det == T(0.0))
+    {
+        // Degenerate, the direction is never transformed to z != 0
+        row0 = vector<4, T>(vector<3, T>(0.0), tri.v1.x);
+        row1 = vector<4, T>(vector<3, T>(0.0), tri.v1.y);
+        row2 = vector<4, T>(vector<3, T>(0.0), tri.v1.z);
+        return;
+    }
+
+    // Inverse of [e1 e2 n], det([e1 e2 n]) = dot(n, n)
+    vector<3, T> r0 = cross(tri.e2, n) / det;
+    vector<3, T> r1 = cross(n, tri.e1) / det;
+    vector<3, T> r2 = n / det;
+
+    row0 = vector<4, T>(r0, -dot(r0, tri.v1));
+    row1 = vector<4, T>(r1, -dot(r1, tri.v1));
+    row2 = vector<4, T>(r2, -dot(r2, tri.v1));
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_triangle<3, T, P> basic_precomputed_triangle<T, P>::triangle() const
+{
+    basic_triangle<3, T, P> result;
+    result.prim_id = this->prim_id;
+    result.geom_id = this->geom_id;
+
+    vector<3, T> r0 = row0.xyz();
+    vector<3, T> r1 = row1.xyz();
+    vector<3, T> r2 = row2.xyz();
+
+    T det = dot(r0, cross(r1, r2));
+
+    if (det == T(0.0))
+    {
+        result.v1 = vector<3, T>(row0.w, row1.w, row2.w);
+        result.e1 = vector<3, T>(0.0);
+        result.e2 = vector<3, T>(0.0);
+        return result;
+    }
+
+    // Columns of the inverse of the rows
+    vector<3, T> e1 = cross(r1, r2) / det;
+    vector<3, T> e2 = cross(r2, r0) / det;
+    vector<3, T> n  = cross(r0, r1) / det;
+
+    result.v1 = -(e1 * row0.w + e2 * row1.w + n * row2.w);
+    result.e1 = e1;
+    result.e2 = e2;
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Geometric functions
+//
+
+template <typename T, typename P>
+MATH_FUNC
+inline T area(basic_precomputed_triangle<T, P> const& t)
+{
+    return area(t.triangle());
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline basic_aabb<T> get_bounds(basic_precomputed_triangle<T, P> const& t)
+{
+    return get_bounds(t.triangle());
+}
+
+template <typename T, typename P>
+MATH_FUNC
+inline array<vector<3, T>, 3> compute_vertices(basic_precomputed_triangle<T, P> const& t)
+{
+    auto tri = t.triangle();
+    return {{ tri.v1, tri.v1 + tri.e1, tri.v1 + tri.e2 }};
+}
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
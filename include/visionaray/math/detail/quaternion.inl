@@ -3,9 +3,11 @@
 
 #include "../matrix.h"
 #include "math.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // quaternion members
@@ -200,4 +202,5 @@ inline vector<3, T> rotation_axis(quaternion<T> const& q)
     return normalize(vector<3, T>(q.x, q.y, q.z));
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
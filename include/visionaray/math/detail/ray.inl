@@ -6,9 +6,11 @@
 #include "../simd/type_traits.h"
 #include "../config.h"
 #include "../limits.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Constructors
@@ -66,6 +68,7 @@ inline auto pack(array<basic_ray<T>, N> const& rays)
 
     float_array tmin;
     float_array tmax;
+    float_array time;
 
     for (size_t i = 0; i < N; ++i)
     {
@@ -79,14 +82,17 @@ inline auto pack(array<basic_ray<T>, N> const& rays)
 
         tmin[i] = rays[i].tmin;
         tmax[i] = rays[i].tmax;
+        time[i] = rays[i].time;
     }
 
-    return basic_ray<U>(
+    basic_ray<U> result(
             vector<3, U>(ori_x, ori_y, ori_z),
             vector<3, U>(dir_x, dir_y, dir_z),
             tmin,
             tmax
             );
+    result.time = time;
+    return result;
 }
 
 // pack four rays
@@ -146,6 +152,7 @@ inline auto unpack(basic_ray<FloatT> const& ray)
 
     float_array tmin;
     float_array tmax;
+    float_array time;
 
     store(ori_x, ray.ori.x);
     store(ori_y, ray.ori.y);
@@ -157,6 +164,7 @@ inline auto unpack(basic_ray<FloatT> const& ray)
 
     store(tmin, ray.tmin);
     store(tmax, ray.tmax);
+    store(time, ray.time);
 
     array<basic_ray<float>, num_elements<FloatT>::value> result;
 
@@ -172,10 +180,12 @@ inline auto unpack(basic_ray<FloatT> const& ray)
 
         result[i].tmin = tmin[i];
         result[i].tmax = tmax[i];
+        result[i].time = time[i];
     }
 
     return result;
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -3,9 +3,11 @@
 
 #include "../limits.h"
 #include "../vector.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // rectangle : min_max_layout
@@ -295,4 +297,5 @@ inline rectangle<xywh_layout<T>, T> intersect(
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
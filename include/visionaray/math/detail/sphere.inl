@@ -6,10 +6,12 @@
 #include "../aabb.h"
 #include "../constants.h"
 #include "math.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Sphere members
@@ -87,4 +89,5 @@ inline T volume(basic_sphere<T, P> const& s)
     return T(4.0) / T(3.0) * constants::pi<T>() * r3;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -5,9 +5,11 @@
 #include "../aabb.h"
 #include "../config.h"
 #include "../rectangle.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Triangle members
@@ -146,4 +148,5 @@ inline basic_triangle<3, float_from_simd_width_t<N>, int_from_simd_width_t<N>> p
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
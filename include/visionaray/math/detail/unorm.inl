@@ -5,9 +5,11 @@
 
 #include "../simd/type_traits.h"
 #include "math.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -135,4 +137,5 @@ inline bool operator>=(unorm<Bits> a, unorm<Bits> b)
     return static_cast<T>(a) >= static_cast<T>(b);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -8,9 +8,11 @@
 #include "../simd/type_traits.h"
 #include "../config.h"
 #include "math.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 
 //--------------------------------------------------------------------------------------------------
@@ -1111,4 +1113,5 @@ inline array<vector<Dim, element_type_t<T>>, num_elements<T>::value> unpack(vect
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
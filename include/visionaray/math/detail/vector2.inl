@@ -5,9 +5,11 @@
 
 #include "../config.h"
 #include "math.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // vector2 members
@@ -412,4 +414,5 @@ inline array<vector<2, element_type_t<T>>, num_elements<T>::value> unpack(vector
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
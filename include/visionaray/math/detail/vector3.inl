@@ -6,9 +6,11 @@
 #include "../simd/type_traits.h"
 #include "../config.h"
 #include "math.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // vector3 members
@@ -483,4 +485,5 @@ inline array<vector<3, element_type_t<T>>, num_elements<T>::value> unpack(vector
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
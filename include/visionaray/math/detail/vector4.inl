@@ -9,9 +9,11 @@
 #include "../simd/type_traits.h"
 #include "../config.h"
 #include "math.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // vector4 members
@@ -501,4 +503,5 @@ inline vector<4, float4> transpose(vector<4, float4> const& v)
 // TODO: transpose for AVX?
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
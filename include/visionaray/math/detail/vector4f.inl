@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../../detail/isa_namespace.h"
+
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Specialization vector<4, float> has 16-byte alignment!
@@ -132,4 +135,5 @@ public:
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -9,9 +9,11 @@
 #include <cstdint>
 
 #include "config.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <unsigned Bits>
 struct best_fixed_rep;
@@ -96,6 +98,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/fixed.inl"
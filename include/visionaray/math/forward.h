@@ -9,6 +9,7 @@
 #include <cstddef>
 
 #include "config.h"
+#include "../detail/isa_namespace.h"
 
 #undef min
 #undef max
@@ -16,6 +17,7 @@
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 
 //--------------------------------------------------------------------------------------------------
@@ -25,6 +27,8 @@ namespace MATH_NAMESPACE
 template <size_t Dim>
 class cartesian_axis;
 
+class half;
+
 template <unsigned Bits>
 class snorm;
 
@@ -49,9 +53,21 @@ class basic_aabb;
 template <typename T>
 class basic_ray;
 
+template <typename T, typename P = unsigned>
+class basic_curve;
+
 template <typename T, typename P = unsigned>
 class basic_cylinder;
 
+template <typename T, typename P = unsigned>
+class basic_indexed_triangle;
+
+template <typename T, typename P = unsigned>
+class basic_oriented_curve;
+
+template <typename T, typename P = unsigned>
+class basic_precomputed_triangle;
+
 template <typename T, typename P = unsigned>
 class basic_sphere;
 
@@ -168,6 +184,7 @@ typedef interval<vec3f>                        box3f;
 typedef interval<vec3d>                        box3d;
 typedef interval<vec3>                         box3;
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 
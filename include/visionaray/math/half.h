@@ -0,0 +1,52 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_MATH_HALF_H
+#define VSNRAY_MATH_HALF_H 1
+
+#include <cstdint>
+
+#include "config.h"
+#include "../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// IEEE 754 binary16 floating point number
+//
+// Storage type only, arithmetic is performed after converting to float.
+// Conversion from float rounds to nearest even, overflows to infinity and
+// keeps NaNs and denormals.
+//
+
+class half
+{
+public:
+
+    uint16_t value;
+
+    half() = default;
+
+    MATH_FUNC /* implicit */ half(float f);
+
+    MATH_FUNC operator float() const;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Bit conversion
+//
+
+MATH_FUNC uint16_t float_to_half_bits(float f);
+MATH_FUNC float half_bits_to_float(uint16_t h);
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
+
+#include "detail/half.inl"
+
+#endif // VSNRAY_MATH_HALF_H
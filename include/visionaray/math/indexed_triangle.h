@@ -0,0 +1,71 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_MATH_INDEXED_TRIANGLE_H
+#define VSNRAY_MATH_INDEXED_TRIANGLE_H 1
+
+#include <cstdint>
+
+#include "config.h"
+#include "primitive.h"
+#include "vector.h"
+#include "../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Triangle that references three vertices of a shared vertex array
+//
+// Stores only 32-bit vertex indices (and the primitive's ids), so that meshes need
+// not be de-indexed. The vertex array is not part of the primitive, functions that
+// need the vertex positions take it as an extra parameter. BVHs over indexed
+// triangles are built with the builders' vertex array overloads and traversed
+// with an indexed_triangle_intersector. Per-vertex attributes (shading normals,
+// texture coordinates, colors) are looked up with the same indices.
+//
+
+template <typename T, typename P>
+class basic_indexed_triangle : public primitive<P>
+{
+public:
+
+    using scalar_type   = T;
+    using vec_type      = vector<3, T>;
+    using index_type    = uint32_t;
+
+public:
+
+    basic_indexed_triangle() = default;
+    MATH_FUNC basic_indexed_triangle(index_type i1, index_type i2, index_type i3);
+
+    index_type i1;
+    index_type i2;
+    index_type i3;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Indexed triangle together with the vertex array it references
+//
+// Short-lived handle for code that only passes a primitive along, e.g. get_bounds()
+// and split_primitive() in the BVH builders
+//
+
+template <typename T, typename P>
+struct basic_bound_indexed_triangle
+{
+    basic_indexed_triangle<T, P> const& triangle;
+    vector<3, T> const*                 vertices;
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
+
+#include "detail/indexed_triangle.inl"
+
+#endif // VSNRAY_MATH_INDEXED_TRIANGLE_H
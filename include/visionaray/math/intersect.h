@@ -11,16 +11,21 @@
 #include "simd/type_traits.h"
 #include "aabb.h"
 #include "config.h"
+#include "curve.h"
 #include "cylinder.h"
+#include "indexed_triangle.h"
 #include "limits.h"
 #include "plane.h"
+#include "precomputed_triangle.h"
 #include "ray.h"
 #include "sphere.h"
 #include "triangle.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T1, typename T2>
 struct hit_record;
@@ -221,6 +226,145 @@ inline hit_record<R, primitive<unsigned>> intersect(R const& ray, basic_triangle
     return result;
 }
 
+//-------------------------------------------------------------------------------------------------
+// ray / triangle, watertight (Woop, Benthin and Wald 2013)
+//
+// Shears the triangle into a space where the ray starts at the origin and points
+// along +z, and evaluates the 2D edge functions there. Rays through shared edges
+// and vertices hit at least one of the adjacent triangles. Edge functions that
+// evaluate to exactly zero count as inside (no double precision fallback), so
+// both adjacent triangles may report a hit. Use with watertight_intersector
+//
+
+template <typename R, typename U>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect_watertight(
+        R const&                                ray,
+        basic_triangle<3, U, unsigned> const&   tri
+        )
+{
+    using T = typename R::scalar_type;
+    using vec_type = vector<3, T>;
+
+    hit_record<R, primitive<unsigned>> result;
+
+    // Permute so that z is the ray direction's dominant axis, swap x and y to
+    // preserve the winding direction
+    vec_type ad(abs(ray.dir.x), abs(ray.dir.y), abs(ray.dir.z));
+    auto kzx = ad.x >= ad.y && ad.x >= ad.z;
+    auto kzy = !kzx && ad.y >= ad.z;
+
+    auto permute = [&](vec_type const& v)
+    {
+        vec_type p(
+                select(kzx, v.y, select(kzy, v.z, v.x)),
+                select(kzx, v.z, select(kzy, v.x, v.y)),
+                select(kzx, v.x, select(kzy, v.y, v.z))
+                );
+
+        auto swap = select(kzx, ray.dir.x, select(kzy, ray.dir.y, ray.dir.z)) < T(0.0);
+        return vec_type(select(swap, p.y, p.x), select(swap, p.x, p.y), p.z);
+    };
+
+    vec_type dir = permute(ray.dir);
+
+    T sz = T(1.0) / dir.z;
+    T sx = dir.x * sz;
+    T sy = dir.y * sz;
+
+    // Vertices relative to the ray origin
+    vec_type a = permute(vec_type(tri.v1) - ray.ori);
+    vec_type b = permute(vec_type(tri.v1 + tri.e1) - ray.ori);
+    vec_type c = permute(vec_type(tri.v1 + tri.e2) - ray.ori);
+
+    // Shear
+    T ax = a.x - sx * a.z;
+    T ay = a.y - sy * a.z;
+    T bx = b.x - sx * b.z;
+    T by = b.y - sy * b.z;
+    T cx = c.x - sx * c.z;
+    T cy = c.y - sy * c.z;
+
+    // Scaled barycentric coordinates
+    T u = cx * by - cy * bx;
+    T v = ax * cy - ay * cx;
+    T w = bx * ay - by * ax;
+
+    T det = u + v + w;
+
+    result.hit = !((u < T(0.0) || v < T(0.0) || w < T(0.0)) && (u > T(0.0) || v > T(0.0) || w > T(0.0)));
+    result.hit &= det != T(0.0);
+
+    T inv_det = T(1.0) / det;
+
+    // Scaled hit distance
+    T t = (u * a.z + v * b.z + w * c.z) * sz;
+
+    result.prim_id = tri.prim_id;
+    result.geom_id = tri.geom_id;
+    result.t = select(result.hit, t * inv_det, T(-1.0));
+    result.u = v * inv_det;
+    result.v = w * inv_det;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+// ray / precomputed triangle
+//
+// Branchless, so that packets do not diverge on early outs
+//
+
+template <typename R, typename U>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect(
+        R const&                                        ray,
+        basic_precomputed_triangle<U, unsigned> const&  tri
+        )
+{
+    using T = typename R::scalar_type;
+    using vec_type = vector<3, T>;
+
+    hit_record<R, primitive<unsigned>> result;
+
+    // case T != U
+    vec_type r0(tri.row0.xyz());
+    vec_type r1(tri.row1.xyz());
+    vec_type r2(tri.row2.xyz());
+
+    // Transform the ray to unit triangle space
+    T oz = dot(r2, ray.ori) + T(tri.row2.w);
+    T dz = dot(r2, ray.dir);
+
+    T t = -oz / dz;
+
+    T b1 = dot(r0, ray.ori) + T(tri.row0.w) + t * dot(r0, ray.dir);
+    T b2 = dot(r1, ray.ori) + T(tri.row1.w) + t * dot(r1, ray.dir);
+
+    result.hit = dz != T(0.0) && b1 >= T(0.0) && b2 >= T(0.0) && b1 + b2 <= T(1.0);
+
+    result.prim_id = tri.prim_id;
+    result.geom_id = tri.geom_id;
+    result.t = select(result.hit, t, T(-1.0));
+    result.u = b1;
+    result.v = b2;
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+// ray / indexed triangle, with the vertex array the triangle references
+//
+
+template <typename R, typename U>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect(
+        R const&                                    ray,
+        basic_indexed_triangle<U, unsigned> const&  tri,
+        vector<3, U> const*                         vertices
+        )
+{
+    return intersect(ray, make_triangle(tri, vertices));
+}
+
 //-------------------------------------------------------------------------------------------------
 // simd overload: ray1 / triangleN
 //
@@ -405,6 +549,355 @@ inline hit_record<R, primitive<unsigned>> intersect(R const& ray, basic_cylinder
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// ray / curve
+//
+// The curve is transformed to a coordinate system where the ray is the z axis and
+// approximated with curve_segments linear segments. The ray hits a segment if the
+// segment's projection comes closer to the origin than the radius. Ribbons are hit
+// at the depth of the center line, tubes at the front of a sphere around the
+// closest point on the center line (sphere swept segments).
+//
+// With single rays, the segments are tested in parallel (SIMD lanes over segments),
+// with SIMD rays, they are tested one after another (SIMD lanes over rays).
+//
+
+namespace detail
+{
+
+struct curve_round_tag {};
+struct curve_ribbon_tag {};
+
+// Depth at the hit point, the front of the tube for round curves
+template <typename L>
+MATH_FUNC
+inline L curve_hit_depth(L const& z, L const& r2, L const& dist2, curve_round_tag)
+{
+    return z - sqrt(max(r2 - dist2, L(0.0)));
+}
+
+template <typename L>
+MATH_FUNC
+inline L curve_hit_depth(L const& z, L const& /* */, L const& /* */, curve_ribbon_tag)
+{
+    return z;
+}
+
+// Intersect the z axis with the linear segments a->b, for each lane return if the
+// segment is hit, the depth, the segment parameter and the signed distance to the
+// segment (relative to r)
+template <typename L, typename Shape>
+MATH_FUNC
+inline simd::mask_type_t<L> intersect_curve_segment(
+        vector<3, L> const& a,
+        vector<3, L> const& b,
+        L const&            r,
+        L&                  depth,
+        L&                  s,
+        L&                  v,
+        Shape               shape
+        )
+{
+    vector<3, L> d = b - a;
+
+    L dd = d.x * d.x + d.y * d.y;
+    auto valid = dd > L(0.0);
+
+    // Closest point to the origin in the xy plane
+    s = select(valid, -(a.x * d.x + a.y * d.y) / dd, L(0.0));
+    s = clamp(s, L(0.0), L(1.0));
+
+    vector<3, L> p = a + d * s;
+
+    L dist2 = p.x * p.x + p.y * p.y;
+    L r2 = r * r;
+
+    depth = curve_hit_depth(p.z, r2, dist2, shape);
+    v = select(valid, (d.x * p.y - d.y * p.x) / sqrt(dd), sqrt(dist2)) / r;
+
+    return dist2 <= r2;
+}
+
+// Orthonormal frame with the ray direction as z axis
+template <typename T>
+struct curve_ray_frame
+{
+    template <typename R>
+    MATH_FUNC
+    explicit curve_ray_frame(R const& ray)
+        : ori(ray.ori)
+        , len(length(ray.dir))
+        , ez(ray.dir / len)
+    {
+        make_orthonormal_basis(ex, ey, ez);
+    }
+
+    template <typename U>
+    MATH_FUNC
+    vector<3, T> transform(vector<3, U> const& p) const
+    {
+        vector<3, T> v = vector<3, T>(p) - ori;
+        return vector<3, T>(dot(v, ex), dot(v, ey), dot(v, ez));
+    }
+
+    vector<3, T> ori;
+    T len;
+    vector<3, T> ex;
+    vector<3, T> ey;
+    vector<3, T> ez;
+};
+
+// Curve in ray space, returns false for lanes where the control points' bounds
+// don't overlap the ray
+template <typename T, typename U, typename P>
+MATH_FUNC
+inline simd::mask_type_t<T> transform_curve(
+        basic_ray<T> const&         ray,
+        basic_curve<U, P> const&    curve,
+        curve_ray_frame<T> const&   frame,
+        vector<3, T>                (&c)[4]
+        )
+{
+    c[0] = frame.transform(curve.w0);
+    c[1] = frame.transform(curve.w1);
+    c[2] = frame.transform(curve.w2);
+    c[3] = frame.transform(curve.w3);
+
+    T r(curve.radius);
+
+    vector<3, T> lo = min(min(c[0], c[1]), min(c[2], c[3])) - vector<3, T>(r);
+    vector<3, T> hi = max(max(c[0], c[1]), max(c[2], c[3])) + vector<3, T>(r);
+
+    return lo.x <= T(0.0) && hi.x >= T(0.0)
+        && lo.y <= T(0.0) && hi.y >= T(0.0)
+        && hi.z >= ray.tmin * frame.len && lo.z <= ray.tmax * frame.len;
+}
+
+// Lanes are rays
+template <typename R, typename U, typename Shape>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect_curve(
+        R const&                        ray,
+        basic_curve<U, unsigned> const& curve,
+        Shape                           shape
+        )
+{
+    using T = typename R::scalar_type;
+
+    hit_record<R, primitive<unsigned>> result;
+    result.hit = false;
+    result.t = T(-1.0);
+    result.prim_id = curve.prim_id;
+    result.geom_id = curve.geom_id;
+
+    curve_ray_frame<T> frame(ray);
+
+    vector<3, T> c[4];
+    if ( !any(transform_curve(ray, curve, frame, c)) )
+    {
+        return result;
+    }
+
+    basic_curve<T> xcurve(c[0], c[1], c[2], c[3], T(curve.radius));
+
+    T tmin = ray.tmin * frame.len;
+    T best = ray.tmax * frame.len;
+
+    vector<3, T> a = c[0];
+
+    for (int i = 0; i < curve_segments; ++i)
+    {
+        vector<3, T> b = xcurve.f(T((i + 1) / float(curve_segments)));
+
+        T depth;
+        T s;
+        T v;
+        auto hit = intersect_curve_segment(a, b, T(curve.radius), depth, s, v, shape);
+        hit = hit && depth > tmin && depth < best;
+
+        result.hit = result.hit || hit;
+        best = select(hit, depth, best);
+        result.u = select(hit, (T(i) + s) / T(curve_segments), result.u);
+        result.v = select(hit, v, result.v);
+
+        a = b;
+    }
+
+    result.t = select(result.hit, best / frame.len, result.t);
+    return result;
+}
+
+#if !defined(__CUDA_ARCH__)
+
+// Lanes are segments
+template <typename U, typename Shape>
+inline hit_record<basic_ray<float>, primitive<unsigned>> intersect_curve(
+        basic_ray<float> const&         ray,
+        basic_curve<U, unsigned> const& curve,
+        Shape                           shape
+        )
+{
+    using L = simd::float4;
+    using float_array = simd::aligned_array_t<L>;
+
+    enum { lanes = simd::num_elements<L>::value };
+
+    hit_record<basic_ray<float>, primitive<unsigned>> result;
+    result.hit = false;
+    result.t = -1.0f;
+    result.prim_id = curve.prim_id;
+    result.geom_id = curve.geom_id;
+
+    curve_ray_frame<float> frame(ray);
+
+    vec3 c[4];
+    if (!transform_curve(ray, curve, frame, c))
+    {
+        return result;
+    }
+
+    basic_curve<L> xcurve;
+    xcurve.w0 = vector<3, L>(c[0]);
+    xcurve.w1 = vector<3, L>(c[1]);
+    xcurve.w2 = vector<3, L>(c[2]);
+    xcurve.w3 = vector<3, L>(c[3]);
+
+    float tmin = ray.tmin * frame.len;
+    float best = ray.tmax * frame.len;
+
+    L dt(1.0f / curve_segments);
+
+    for (int i = 0; i < curve_segments; i += lanes)
+    {
+        L t0 = (L(0.0f, 1.0f, 2.0f, 3.0f) + L(float(i))) * dt;
+
+        vector<3, L> a = xcurve.f(t0);
+        vector<3, L> b = xcurve.f(t0 + dt);
+
+        L depth;
+        L s;
+        L v;
+        auto hit = intersect_curve_segment(a, b, L(curve.radius), depth, s, v, shape);
+        hit = hit && depth > L(tmin) && depth < L(best);
+
+        if (!any(hit))
+        {
+            continue;
+        }
+
+        float_array depths;
+        float_array ss;
+        float_array vs;
+        store(depths, select(hit, depth, L(best)));
+        store(ss, s);
+        store(vs, v);
+
+        for (int j = 0; j < lanes; ++j)
+        {
+            if (depths[j] < best)
+            {
+                best = depths[j];
+                result.hit = true;
+                result.u = (i + j + ss[j]) / curve_segments;
+                result.v = vs[j];
+            }
+        }
+    }
+
+    result.t = result.hit ? best / frame.len : result.t;
+    return result;
+}
+
+#endif // !__CUDA_ARCH__
+
+// Test the oriented bounding box, returns false for lanes that miss it
+template <typename R, typename U>
+MATH_FUNC
+inline auto intersect_obb(R const& ray, basic_oriented_curve<U, unsigned> const& curve)
+    -> simd::mask_type_t<typename R::scalar_type>
+{
+    using T = typename R::scalar_type;
+
+    vector<4, T> rows[] = {
+            vector<4, T>(curve.obb_row0),
+            vector<4, T>(curve.obb_row1),
+            vector<4, T>(curve.obb_row2)
+            };
+
+    T tnear = ray.tmin;
+    T tfar  = ray.tmax;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        T o = dot(rows[i].xyz(), ray.ori) + rows[i].w;
+        T d = dot(rows[i].xyz(), ray.dir);
+        T inv = T(1.0) / d;
+
+        T t1 = -o * inv;
+        T t2 = (T(1.0) - o) * inv;
+
+        tnear = max(tnear, min(t1, t2));
+        tfar  = min(tfar, max(t1, t2));
+    }
+
+    return tfar >= tnear;
+}
+
+} // detail
+
+// Round curves
+template <typename R, typename U>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect(R const& ray, basic_curve<U, unsigned> const& curve)
+{
+    return detail::intersect_curve(ray, curve, detail::curve_round_tag{});
+}
+
+template <typename R, typename U>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect(R const& ray, basic_oriented_curve<U, unsigned> const& curve)
+{
+    auto obb_hit = detail::intersect_obb(ray, curve);
+
+    if (!any(obb_hit))
+    {
+        hit_record<R, primitive<unsigned>> result;
+        result.hit = false;
+        return result;
+    }
+
+    auto result = intersect(ray, static_cast<basic_curve<U, unsigned> const&>(curve));
+    result.hit = result.hit && obb_hit;
+    return result;
+}
+
+// Flat curves that face the ray, see ribbon_curve_intersector
+template <typename R, typename U>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect_ribbon(R const& ray, basic_curve<U, unsigned> const& curve)
+{
+    return detail::intersect_curve(ray, curve, detail::curve_ribbon_tag{});
+}
+
+template <typename R, typename U>
+MATH_FUNC
+inline hit_record<R, primitive<unsigned>> intersect_ribbon(R const& ray, basic_oriented_curve<U, unsigned> const& curve)
+{
+    auto obb_hit = detail::intersect_obb(ray, curve);
+
+    if (!any(obb_hit))
+    {
+        hit_record<R, primitive<unsigned>> result;
+        result.hit = false;
+        return result;
+    }
+
+    auto result = intersect_ribbon(ray, static_cast<basic_curve<U, unsigned> const&>(curve));
+    result.hit = result.hit && obb_hit;
+    return result;
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // ray / plane
 //
@@ -639,6 +1132,7 @@ inline array<hit_record<ray, primitive<unsigned>>, num_elements<simd::float16>::
 
 } // simd
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_INTERSECT_H
@@ -8,9 +8,11 @@
 
 #include "config.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class interval
@@ -30,6 +32,7 @@ public:
     interval& extend(interval<T> const& t);
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/interval.inl"
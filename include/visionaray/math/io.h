@@ -20,10 +20,12 @@
 #include "quaternion.h"
 #include "rectangle.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -348,6 +350,7 @@ operator<<(std::basic_ostream<CharT, Traits>& out, interval<T> const& ival)
     return out << s.str();
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_IO_H
@@ -9,9 +9,11 @@
 #include "simd/simd.h"
 
 #include "norm.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // generic limits: no CUDA
@@ -229,6 +231,7 @@ public:
     MATH_FUNC static simd::basic_int<T> max();
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/limits.inl"
@@ -13,8 +13,11 @@
 #include "axis.h"
 #include "constants.h"
 #include "coordinates.h"
+#include "curve.h"
 #include "cylinder.h"
 #include "fixed.h"
+#include "half.h"
+#include "indexed_triangle.h"
 #include "intersect.h"
 #include "interval.h"
 #include "io.h"
@@ -28,6 +31,7 @@
 #include "ray.h"
 #include "rectangle.h"
 #include "snorm.h"
+#include "precomputed_triangle.h"
 #include "sphere.h"
 #include "triangle.h"
 #include "unorm.h"
@@ -10,9 +10,11 @@
 
 #include "forward.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class matrix<2, 2, T>
@@ -331,6 +333,7 @@ public:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/matrix.inl"
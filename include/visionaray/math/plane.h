@@ -11,9 +11,11 @@
 #include "config.h"
 #include "primitive.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <size_t Dim, typename T, typename P>
 class basic_plane : public primitive<P>
@@ -34,6 +36,7 @@ public:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/plane.inl"
@@ -0,0 +1,63 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_MATH_PRECOMPUTED_TRIANGLE_H
+#define VSNRAY_MATH_PRECOMPUTED_TRIANGLE_H 1
+
+#include "config.h"
+#include "primitive.h"
+#include "triangle.h"
+#include "vector.h"
+#include "../detail/isa_namespace.h"
+
+namespace MATH_NAMESPACE
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Triangle with a precomputed affine transform (Baldwin and Weber 2016)
+//
+// Stores the rows of the transform from world space to a space where the triangle
+// is the unit triangle (0,0,0), (1,0,0), (0,1,0) in the xy plane. The ray/triangle
+// test then transforms the ray with three dot products each for origin and
+// direction, and needs a single division for the hit distance (Moeller-Trumbore
+// needs two cross products and a division). The three rows take 48 bytes, with
+// the ids the primitive fills a 64 byte cache line.
+//
+// Constructed from a basic_triangle; the vertices (and thus bounds) are recovered
+// by inverting the transform. Degenerate triangles (zero area) are never hit,
+// their bounds collapse to the first vertex.
+//
+
+template <typename T, typename P>
+class basic_precomputed_triangle : public primitive<P>
+{
+public:
+
+    using scalar_type   = T;
+    using vec_type      = vector<3, T>;
+
+public:
+
+    basic_precomputed_triangle() = default;
+    MATH_FUNC explicit basic_precomputed_triangle(basic_triangle<3, T, P> const& tri);
+
+    // Vertex and edge vectors, computed from the transform
+    MATH_FUNC basic_triangle<3, T, P> triangle() const;
+
+    // row0.xyz / row1.xyz / row2.xyz form the inverse of [e1 e2 n],
+    // w components hold the translation
+    vector<4, T> row0;
+    vector<4, T> row1;
+    vector<4, T> row2;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // MATH_NAMESPACE
+
+#include "detail/precomputed_triangle.inl"
+
+#endif // VSNRAY_MATH_PRECOMPUTED_TRIANGLE_H
@@ -7,9 +7,11 @@
 #define VSNRAY_MATH_PRIMITIVE_H 1
 
 #include "config.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T /* (unsigned) int type */>
 struct primitive
@@ -20,6 +22,7 @@ struct primitive
     id_type prim_id;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_PRIMITIVE_H
@@ -10,9 +10,11 @@
 #include "matrix.h"
 #include "rectangle.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 MATH_FUNC
@@ -57,6 +59,7 @@ inline void unproject(
     obj = v.xyz() / v.w;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_PROJECT_H
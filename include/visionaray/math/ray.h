@@ -8,9 +8,11 @@
 
 #include "config.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class basic_ray
@@ -28,6 +30,10 @@ public:
     T tmin;
     T tmax;
 
+    // Time in the shutter interval [0..1], motion BVHs and instances
+    // interpolate between their states at 0 and 1
+    T time = T(0.0);
+
     basic_ray() = default;
 
     // Constructor with origin and direction, tmin is 0.0 and tmax is
@@ -44,6 +50,7 @@ public:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/ray.inl"
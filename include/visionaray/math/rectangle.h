@@ -7,10 +7,12 @@
 #define VSNRAY_MATH_RECTANGLE_H 1
 
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Layout policies
@@ -122,6 +124,7 @@ public:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/rectangle.inl"
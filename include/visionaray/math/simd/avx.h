@@ -11,11 +11,13 @@
 #include "detail/common.h"
 #include "forward.h"
 #include "intrinsics.h"
+#include "../../detail/isa_namespace.h"
 
 #if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX)
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -114,6 +116,7 @@ public:
 };
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/avx/mask8.inl"
@@ -11,11 +11,13 @@
 #include "detail/common.h"
 #include "forward.h"
 #include "intrinsics.h"
+#include "../../detail/isa_namespace.h"
 
 #if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX512F)
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -89,6 +91,7 @@ public:
 
     basic_mask() = default;
     basic_mask(__mmask16 const& m);
+    basic_mask(__m512i const& m);
     basic_mask(bool b);
     basic_mask(
             bool  x1, bool  x2, bool  x3, bool  x4,
@@ -102,6 +105,7 @@ public:
 };
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/avx512/mask16.inl"
@@ -11,11 +11,13 @@
 #include "detail/common.h"
 #include "forward.h"
 #include "intrinsics.h"
+#include "../../detail/isa_namespace.h"
 
 #if VSNRAY_NO_SIMD_ISA
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -76,6 +78,7 @@ public:
 };
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/builtin/mask4.inl"
@@ -88,6 +91,7 @@ public:
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -175,6 +179,7 @@ public:
 };
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/builtin/mask8.inl"
@@ -187,6 +192,7 @@ public:
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -262,6 +268,7 @@ public:
 };
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/builtin/mask16.inl"
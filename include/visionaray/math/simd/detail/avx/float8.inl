@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <cmath>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -341,4 +343,5 @@ VSNRAY_FORCE_INLINE float8 approx_rsqrt(float8 const& v)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
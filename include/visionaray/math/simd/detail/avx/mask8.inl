@@ -1,8 +1,11 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include "../../../../detail/isa_namespace.h"
+
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -184,4 +187,5 @@ using simd::store;
 using simd::any;
 using simd::all;
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
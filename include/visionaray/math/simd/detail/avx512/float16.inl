@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <cmath>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -303,4 +305,5 @@ VSNRAY_FORCE_INLINE mask16 isfinite(float16 const& v)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
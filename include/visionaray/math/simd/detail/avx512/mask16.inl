@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <type_traits>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -17,6 +19,12 @@ VSNRAY_FORCE_INLINE mask16::basic_mask(__mmask16 const& m)
 {
 }
 
+// Lanes with the sign bit set, as with SSE and AVX masks
+VSNRAY_FORCE_INLINE mask16::basic_mask(__m512i const& m)
+    : value(_mm512_cmplt_epi32_mask(m, _mm512_setzero_si512()))
+{
+}
+
 VSNRAY_FORCE_INLINE mask16::basic_mask(bool b)
     : value(b ? 0xFFFF : 0x0000)
 {
@@ -59,9 +67,7 @@ VSNRAY_FORCE_INLINE mask16::operator __mmask16() const
 
 VSNRAY_FORCE_INLINE int16 convert_to_int(mask16 const& a)
 {
-    VSNRAY_ALIGN(64) int arr[16];
-    store(arr, a);
-    return int16(arr);
+    return int16(_mm512_maskz_set1_epi32(a.value, -1));
 }
 
 
@@ -274,4 +280,5 @@ using simd::store;
 using simd::any;
 using simd::all;
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
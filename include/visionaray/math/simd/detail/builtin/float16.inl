@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <visionaray/math/detail/math.h>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -945,4 +947,5 @@ VSNRAY_FORCE_INLINE float16 rsqrt(float16 const& v)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <visionaray/math/detail/math.h>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -732,4 +734,5 @@ VSNRAY_FORCE_INLINE int16 max(int16 const& u, int16 const& v)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
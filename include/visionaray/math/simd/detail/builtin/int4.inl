@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <visionaray/math/detail/math.h>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -395,4 +397,5 @@ VSNRAY_FORCE_INLINE int4 max(int4 const& u, int4 const& v)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
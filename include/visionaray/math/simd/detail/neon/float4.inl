@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <cmath>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -84,11 +86,21 @@ VSNRAY_FORCE_INLINE float4 load(float const src[4])
     return vld1q_f32(src);
 }
 
+VSNRAY_FORCE_INLINE float4 load_unaligned(float const src[4])
+{
+    return vld1q_f32(src);
+}
+
 VSNRAY_FORCE_INLINE void store(float dst[4], float4 const& v)
 {
     vst1q_f32(dst, v);
 }
 
+VSNRAY_FORCE_INLINE void store_unaligned(float dst[4], float4 const& v)
+{
+    vst1q_f32(dst, v);
+}
+
 template <unsigned I>
 VSNRAY_FORCE_INLINE float& get(float4& v)
 {
@@ -389,4 +401,5 @@ VSNRAY_FORCE_INLINE mask4 isfinite(float4 const& v)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
@@ -2,9 +2,11 @@
 // See the LICENSE file for details.
 
 #include <cmath>
+#include "../../../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -410,4 +412,5 @@ VSNRAY_FORCE_INLINE float4 copysign(float4 x, float4 y)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
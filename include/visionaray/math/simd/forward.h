@@ -14,10 +14,12 @@
 #include "intrinsics.h"
 #include "../config.h"
 #include "../forward.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -75,6 +77,7 @@ typedef basic_ray<float16>                      ray16;
 
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #if defined(__GNUC__)
@@ -25,9 +25,11 @@
 // Insert math headers after platform headers to inhibit ADL!
 #include "../norm.h"
 #include "../vector.h"
+#include "../../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -807,6 +809,7 @@ VSNRAY_FORCE_INLINE vector<Dim, float16> gather(vector<Dim, unorm<Bits>> const*
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #if defined(__GNUC__)
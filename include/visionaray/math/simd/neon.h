@@ -11,11 +11,13 @@
 #include "detail/common.h"
 #include "forward.h"
 #include "intrinsics.h"
+#include "../../detail/isa_namespace.h"
 
 #if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_NEON_FP)
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -85,6 +87,7 @@ public:
 };
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/neon/mask4.inl"
@@ -16,11 +16,13 @@
 #include "detail/common.h"
 #include "forward.h"
 #include "intrinsics.h"
+#include "../../detail/isa_namespace.h"
 
 #if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_SSE2)
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 
@@ -92,6 +94,7 @@ public:
 };
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/sse/mask4.inl"
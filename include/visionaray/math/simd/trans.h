@@ -21,10 +21,12 @@
 #include "neon.h"
 #include "sse.h"
 #include "type_traits.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace simd
 {
 namespace detail
@@ -594,6 +596,7 @@ VSNRAY_FORCE_INLINE float16 pow(float16 const& x, float16 const& y)
 }
 
 } // simd
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #endif // VSNRAY_MATH_SIMD_TRANS_H
@@ -9,9 +9,11 @@
 #include "config.h"
 #include "primitive.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T, typename P>
 class basic_sphere : public primitive<P>
@@ -31,6 +33,7 @@ public:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/sphere.inl"
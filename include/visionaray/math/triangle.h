@@ -10,9 +10,11 @@
 
 #include "primitive.h"
 #include "vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <size_t Dim, typename T, typename P>
 class basic_triangle : public primitive<P>
@@ -36,6 +38,7 @@ public:
     vec_type e2;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/triangle.inl"
@@ -9,9 +9,11 @@
 #include <cstdint>
 
 #include "config.h"
+#include "../detail/isa_namespace.h"
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -50,6 +52,7 @@ public:
     MATH_FUNC operator float() const;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/unorm.inl"
@@ -9,10 +9,12 @@
 #include <cstddef>
 
 #include "forward.h"
+#include "../detail/isa_namespace.h"
 
 
 namespace MATH_NAMESPACE
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 // vector2
@@ -193,6 +195,7 @@ private:
 };
 
 
+VSNRAY_ISA_NAMESPACE_END
 } // MATH_NAMESPACE
 
 #include "detail/vector.inl"
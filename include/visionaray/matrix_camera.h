@@ -10,8 +10,11 @@
 #include "math/forward.h"
 #include "math/matrix.h"
 
+#include "detail/isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Camera class that internally stores view and projection matrices
@@ -57,6 +60,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/matrix_camera.inl"
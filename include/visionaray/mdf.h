@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "math/constants.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class ggx
@@ -53,6 +55,7 @@ public:
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_MDF_H
@@ -8,9 +8,11 @@
 
 #include "phase_function.h"
 #include "spectrum.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class anisotropic_medium
@@ -53,6 +55,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_MEDIUM_H
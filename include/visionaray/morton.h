@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "math/forward.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 VSNRAY_FUNC
 inline unsigned morton_encode2D(unsigned x, unsigned y)
@@ -94,6 +96,7 @@ inline vec3ui morton_decode3D(unsigned index)
     return { compact_bits(index), compact_bits(index >> 1), compact_bits(index >> 2) };
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_MORTON_H
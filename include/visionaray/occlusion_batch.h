@@ -0,0 +1,161 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_OCCLUSION_BATCH_H
+#define VSNRAY_OCCLUSION_BATCH_H 1
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "math/simd/simd.h"
+#include "math/simd/type_traits.h"
+#include "math/ray.h"
+#include "math/vector.h"
+#include "aligned_vector.h"
+#include "array.h"
+#include "intersector.h"
+#include "traverse.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Batch of shadow rays that are traced together as a SIMD stream
+//
+// Collect the shadow rays of a tile (or any other set of rays) with push_back(),
+// then trace() them all with occluded(). Rays are grouped by the octant of their
+// direction and packed into packets of FloatT, so that the packets are more
+// coherent than the per-pixel packets of the kernel. The buffers are kept between
+// batches; use one batch per thread.
+//
+// Usage:
+//
+//     batch.clear();
+//     for (...) { index[i] = batch.push_back(shadow_ray); }
+//     batch.trace(prims.begin, prims.end, isect);
+//     for (...) { if (!batch.occluded(index[i])) ... }
+//
+
+template <typename FloatT>
+class occlusion_batch
+{
+public:
+
+    using scalar_ray = basic_ray<float>;
+    using packet_ray = basic_ray<FloatT>;
+
+    enum { PacketSize = simd::num_elements<FloatT>::value };
+
+public:
+
+    void clear()
+    {
+        rays_.clear();
+        occluded_.clear();
+    }
+
+    // Returns the index of the ray in the batch
+    size_t push_back(scalar_ray const& ray)
+    {
+        rays_.push_back(ray);
+        return rays_.size() - 1;
+    }
+
+    size_t size() const
+    {
+        return rays_.size();
+    }
+
+    template <typename Primitives, typename Intersector>
+    void trace(Primitives begin, Primitives end, Intersector& isect)
+    {
+        size_t n = rays_.size();
+
+        occluded_.assign(n, 0);
+
+        // Group by direction octant (counting sort)
+        std::array<size_t, 9> offsets = {{ 0 }};
+
+        for (auto const& r : rays_)
+        {
+            ++offsets[octant(r) + 1];
+        }
+
+        for (size_t i = 1; i < offsets.size(); ++i)
+        {
+            offsets[i] += offsets[i - 1];
+        }
+
+        order_.resize(n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            order_[offsets[octant(rays_[i])]++] = static_cast<unsigned>(i);
+        }
+
+        // Trace packets; unused lanes are inactive (tmin > tmax)
+        array<scalar_ray, PacketSize> packet;
+        simd::aligned_array_t<simd::int_type_t<FloatT>> result;
+
+        for (size_t first = 0; first < n; first += PacketSize)
+        {
+            size_t count = std::min(size_t(PacketSize), n - first);
+
+            for (size_t i = 0; i < PacketSize; ++i)
+            {
+                if (i < count)
+                {
+                    packet[i] = rays_[order_[first + i]];
+                }
+                else
+                {
+                    packet[i] = scalar_ray(vec3(0.0f), vec3(1.0f), 1.0f, 0.0f);
+                }
+            }
+
+            auto mask = visionaray::occluded(simd::pack(packet), begin, end, isect);
+            store(result, convert_to_int(mask));
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                occluded_[order_[first + i]] = result[i] != 0;
+            }
+        }
+    }
+
+    template <typename Primitives>
+    void trace(Primitives begin, Primitives end)
+    {
+        default_intersector ignore;
+        trace(begin, end, ignore);
+    }
+
+    // Valid after trace()
+    bool occluded(size_t index) const
+    {
+        return occluded_[index] != 0;
+    }
+
+private:
+
+    static unsigned octant(scalar_ray const& r)
+    {
+        return (r.dir.x < 0.0f ? 1 : 0) | (r.dir.y < 0.0f ? 2 : 0) | (r.dir.z < 0.0f ? 4 : 0);
+    }
+
+    aligned_vector<scalar_ray> rays_;
+    std::vector<unsigned> order_;
+    std::vector<unsigned char> occluded_;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#endif // VSNRAY_OCCLUSION_BATCH_H
@@ -12,9 +12,11 @@
 #include "math/simd/builtin.h"
 #include "math/simd/neon.h"
 #include "math/simd/sse.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Traits to determine size and layout of ray packets
@@ -117,6 +119,7 @@ struct expand_pixel<simd::float16>
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_PACKET_TRAITS_H
@@ -0,0 +1,140 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_PARTICIPATING_MEDIA_H
+#define VSNRAY_PARTICIPATING_MEDIA_H 1
+
+#include "math/forward.h"
+#include "math/ray.h"
+#include "math/vector.h"
+#include "macrocell_grid.h"
+#include "medium.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Unbiased free-flight and transmittance estimators for heterogeneous media
+//
+// The medium is given by its extinction coefficient sigma_t(world_pos), a callable
+// returning float. The macrocell grid spans the medium and must be built over the
+// same extinction values, its majorants must bound sigma_t from above inside each
+// cell. Majorants computed from point samples alone are not guaranteed bounds and
+// bias the estimators where sigma_t exceeds them. Either pass an upper bound for
+// the Lipschitz constant of sigma_t, or provide a conservative range per cell
+// (see macrocell_grid::build_from_function() and build_from_range_function()), e.g.:
+//
+//     grid.build_from_function(sigma_t, vec3i(8), max_gradient_magnitude);
+//     grid.compute_majorants([](vec2 const& range) { return range.y; });
+//
+// The estimators traverse the grid with a 3D-DDA and sample tentative collisions
+// with the local majorant of each cell instead of a global one, so that thin and
+// empty regions are crossed with few (or no) density lookups. All functions
+// consider the ray segment [ray.tmin..ray.tmax] and operate on scalar rays.
+// ray.dir must be normalized: ray parameters are used as distances, and sigma_t
+// and the majorants are given per unit length.
+//
+
+
+//-------------------------------------------------------------------------------------------------
+// Optional per-ray counters
+//
+
+struct tracking_stats
+{
+    unsigned density_lookups = 0;
+    unsigned cells_visited = 0;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Delta tracking (Woodcock tracking)
+//
+// Samples the distance to the next real collision. Returns true and the ray
+// parameter of the collision in t, or false if the ray leaves the segment. Whether
+// the collision is an absorption or a scattering event is up to the caller, e.g.
+// with probability sigma_a(pos) / sigma_t(pos), followed by sampling a phase
+// function from medium.h
+//
+
+template <typename SigmaT, typename Generator>
+bool delta_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        float&                      t,
+        tracking_stats&             stats
+        );
+
+template <typename SigmaT, typename Generator>
+bool delta_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        float&                      t
+        );
+
+
+//-------------------------------------------------------------------------------------------------
+// Ratio tracking
+//
+// Unbiased estimate of the transmittance along the ray segment. Weights that
+// become small are subject to Russian roulette
+//
+
+template <typename SigmaT, typename Generator>
+float ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        tracking_stats&             stats
+        );
+
+template <typename SigmaT, typename Generator>
+float ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen
+        );
+
+
+//-------------------------------------------------------------------------------------------------
+// Residual ratio tracking (Novak et al. 2014)
+//
+// Like ratio tracking, but uses the minimum extinction of each cell (the lower
+// bound of macrocell_grid::value_range()) as a control variate whose transmittance
+// is computed analytically. Only the residual extinction is tracked, so cells of
+// (nearly) homogeneous density need few or no lookups at all
+//
+
+template <typename SigmaT, typename Generator>
+float residual_ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen,
+        tracking_stats&             stats
+        );
+
+template <typename SigmaT, typename Generator>
+float residual_ratio_tracking(
+        basic_ray<float> const&     ray,
+        SigmaT const&               sigma_t,
+        macrocell_grid const&       grid,
+        Generator&                  gen
+        );
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#include "detail/participating_media.inl"
+
+#endif // VSNRAY_PARTICIPATING_MEDIA_H
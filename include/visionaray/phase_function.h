@@ -10,9 +10,11 @@
 #include "math/constants.h"
 #include "math/limits.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Henyey-Greenstein phase function
@@ -78,6 +80,7 @@ public:
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_PHASE_FUNCTION
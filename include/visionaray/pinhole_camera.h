@@ -12,9 +12,11 @@
 #include "math/matrix.h"
 #include "math/rectangle.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Simple pinhole camera class, similar interface to OpenGL/GLU
@@ -118,6 +120,7 @@ private:
     vec3 W;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/pinhole_camera.inl"
@@ -6,8 +6,11 @@
 #ifndef VSNRAY_PIXEL_SAMPLER_TYPES_H
 #define VSNRAY_PIXEL_SAMPLER_TYPES_H 1
 
+#include "detail/isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Blending scale factors for compositing pixel samplers
@@ -54,7 +57,11 @@ struct uniform_type : base_type
 };
 
 // Jittered pixel positions
-struct jittered_type : base_type {};
+struct jittered_type : base_type
+{
+    // Also jitter ray.time over the shutter interval for motion blur
+    bool motion_blur = false;
+};
 
 // Jittered and successive blending
 template <typename T>
@@ -69,6 +76,7 @@ struct basic_jittered_blend_type : jittered_type
 using jittered_blend_type = basic_jittered_blend_type<float>;
 
 } // pixel_sampler
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_PIXEL_SAMPLER_TYPES_H
@@ -6,12 +6,15 @@
 #ifndef VSNRAY_PIXEL_TRAITS_H
 #define VSNRAY_PIXEL_TRAITS_H 1
 
+#include "math/half.h"
 #include "math/unorm.h"
 #include "math/vector.h"
 #include "pixel_format.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <pixel_format PF>
 struct pixel_traits
@@ -42,12 +45,42 @@ struct pixel_traits<PF_RGBA8>
     typedef vector<4, unorm< 8>> type;
 };
 
+template <>
+struct pixel_traits<PF_R16F>
+{
+    typedef half type;
+};
+
+template <>
+struct pixel_traits<PF_RG16F>
+{
+    typedef vector<2, half> type;
+};
+
+template <>
+struct pixel_traits<PF_RGB16F>
+{
+    typedef vector<3, half> type;
+};
+
+template <>
+struct pixel_traits<PF_RGBA16F>
+{
+    typedef vector<4, half> type;
+};
+
 template <>
 struct pixel_traits<PF_R32F>
 {
     typedef float type;
 };
 
+template <>
+struct pixel_traits<PF_RG32F>
+{
+    typedef vector<2, float> type;
+};
+
 template <>
 struct pixel_traits<PF_RGB32F>
 {
@@ -60,6 +93,18 @@ struct pixel_traits<PF_RGBA32F>
     typedef vector<4, float> type;
 };
 
+template <>
+struct pixel_traits<PF_R32I>
+{
+    typedef int type;
+};
+
+template <>
+struct pixel_traits<PF_R32UI>
+{
+    typedef unsigned type;
+};
+
 
 //-------------------------------------------------------------------------------------------------
 // Depth / stencil formats
@@ -77,6 +122,7 @@ struct pixel_traits<PF_DEPTH32F>
     typedef float type;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_PIXEL_TRAITS_H
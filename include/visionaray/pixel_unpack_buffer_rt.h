@@ -23,8 +23,11 @@
 #include "pixel_traits.h"
 #include "render_target.h"
 
+#include "detail/isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <
     pixel_format ColorFormat,
@@ -78,6 +81,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/pixel_unpack_buffer_rt.inl"
@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "math/vector.h"
 #include "light_sample.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class point_light
@@ -55,6 +57,7 @@ private:
     T quadratic_attenuation_;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/point_light.inl"
@@ -0,0 +1,153 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_PREVIEW_CONTROLLER_H
+#define VSNRAY_PREVIEW_CONTROLLER_H 1
+
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Choose the preview factor for progressive rendering from a frame time budget
+//
+// While the camera moves, frames are rendered with the smallest power of two
+// preview factor (see basic_sched::set_preview_factor()) whose estimated frame
+// time fits into the budget. When the camera stops, the preview is kept for a
+// short hold time, so that pauses between discrete motion events (e.g. key
+// repeat) don't toggle between preview and full resolution. After that, the
+// factor is reset to 1 and the image is refined at full resolution. The hold
+// time is measured in reported frame time (see end_frame()). The estimate
+// assumes that frame time is proportional to the number of traced pixels.
+//
+// Usage:
+//
+//     sched.set_preview_factor(preview.begin_frame(camera_moved));
+//     timer t;
+//     sched.frame(...);
+//     preview.end_frame(t.elapsed());
+//
+
+class preview_controller
+{
+public:
+
+    // Budget in seconds per frame during interaction, hold time in seconds
+    explicit preview_controller(double frame_budget = 1.0 / 30.0, int max_factor = 8, double hold_time = 0.2)
+        : frame_budget_(frame_budget)
+        , max_factor_(max_factor)
+        , hold_time_(hold_time)
+    {
+    }
+
+    void set_frame_budget(double budget)
+    {
+        frame_budget_ = budget;
+    }
+
+    double frame_budget() const
+    {
+        return frame_budget_;
+    }
+
+    void set_max_factor(int factor)
+    {
+        max_factor_ = factor;
+    }
+
+    int max_factor() const
+    {
+        return max_factor_;
+    }
+
+    void set_hold_time(double seconds)
+    {
+        hold_time_ = seconds;
+    }
+
+    double hold_time() const
+    {
+        return hold_time_;
+    }
+
+    // Returns the preview factor for the next frame
+    int begin_frame(bool moving)
+    {
+        if (moving)
+        {
+            idle_time_ = 0.0;
+            previewing_ = true;
+        }
+        else if (idle_time_ >= hold_time_)
+        {
+            previewing_ = false;
+        }
+
+        factor_ = 1;
+
+        if (!previewing_ || full_frame_time_ <= 0.0)
+        {
+            return factor_;
+        }
+
+        while (factor_ < max_factor_ && full_frame_time_ / (factor_ * factor_) > frame_budget_)
+        {
+            factor_ *= 2;
+        }
+
+        return factor_;
+    }
+
+    // Report the time the last frame took (in seconds)
+    void end_frame(double seconds)
+    {
+        idle_time_ += seconds;
+
+        double estimate = seconds * factor_ * factor_;
+
+        // Exponential moving average, smooths out outliers
+        if (full_frame_time_ <= 0.0)
+        {
+            full_frame_time_ = estimate;
+        }
+        else
+        {
+            full_frame_time_ = 0.75 * full_frame_time_ + 0.25 * estimate;
+        }
+    }
+
+    // Preview factor of the current frame
+    int factor() const
+    {
+        return factor_;
+    }
+
+    // Estimated time for a full resolution frame, 0 if no frame was reported yet
+    double full_frame_time() const
+    {
+        return full_frame_time_;
+    }
+
+private:
+
+    double frame_budget_;
+    int max_factor_;
+    double hold_time_;
+
+    int factor_ = 1;
+    double full_frame_time_ = 0.0;
+
+    // Frame time since the camera last moved
+    double idle_time_ = 0.0;
+    bool previewing_ = false;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#endif // VSNRAY_PREVIEW_CONTROLLER_H
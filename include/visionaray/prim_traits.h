@@ -8,14 +8,19 @@
 
 #include <cstddef>
 
+#include "math/curve.h"
+#include "math/indexed_triangle.h"
 #include "math/plane.h"
+#include "math/precomputed_triangle.h"
 #include "math/sphere.h"
 #include "math/triangle.h"
 
 #include "tags.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Primitive traits, can optionally be reimplemented for custom types by the user
@@ -57,12 +62,36 @@ struct scalar_type
 
 // specializations ----------------------------------------
 
+template <typename T, typename P>
+struct scalar_type<basic_curve<T, P>>
+{
+    using type = T;
+};
+
 template <size_t Dim, typename T, typename P>
 struct scalar_type<basic_plane<Dim, T, P>>
 {
     using type = T;
 };
 
+template <typename T, typename P>
+struct scalar_type<basic_indexed_triangle<T, P>>
+{
+    using type = T;
+};
+
+template <typename T, typename P>
+struct scalar_type<basic_oriented_curve<T, P>>
+{
+    using type = T;
+};
+
+template <typename T, typename P>
+struct scalar_type<basic_precomputed_triangle<T, P>>
+{
+    using type = T;
+};
+
 template <typename T, typename P>
 struct scalar_type<basic_sphere<T, P>>
 {
@@ -89,6 +118,18 @@ struct num_vertices
 
 // specializations ----------------------------------------
 
+template <typename T, typename P>
+struct num_vertices<basic_indexed_triangle<T, P>>
+{
+    enum { value = 3 };
+};
+
+template <typename T, typename P>
+struct num_vertices<basic_precomputed_triangle<T, P>>
+{
+    enum { value = 3 };
+};
+
 template <size_t Dim, typename T, typename P>
 struct num_vertices<basic_triangle<Dim, T, P>>
 {
@@ -110,6 +151,30 @@ struct num_normals
 
 // specializations ----------------------------------------
 
+template <typename T, typename P>
+struct num_normals<basic_indexed_triangle<T, P>, normals_per_face_binding>
+{
+    enum { value = 1 };
+};
+
+template <typename T, typename P>
+struct num_normals<basic_indexed_triangle<T, P>, normals_per_vertex_binding>
+{
+    enum { value = 3 };
+};
+
+template <typename T, typename P>
+struct num_normals<basic_precomputed_triangle<T, P>, normals_per_face_binding>
+{
+    enum { value = 1 };
+};
+
+template <typename T, typename P>
+struct num_normals<basic_precomputed_triangle<T, P>, normals_per_vertex_binding>
+{
+    enum { value = 3 };
+};
+
 template <size_t Dim, typename T, typename P>
 struct num_normals<basic_triangle<Dim, T, P>, normals_per_face_binding>
 {
@@ -137,12 +202,25 @@ struct num_tex_coords
 
 // specializations ----------------------------------------
 
+template <typename T, typename P>
+struct num_tex_coords<basic_indexed_triangle<T, P>>
+{
+    enum { value = 3 };
+};
+
+template <typename T, typename P>
+struct num_tex_coords<basic_precomputed_triangle<T, P>>
+{
+    enum { value = 3 };
+};
+
 template <size_t Dim, typename T, typename P>
 struct num_tex_coords<basic_triangle<Dim, T, P>>
 {
     enum { value = 3 };
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_PRIM_TRAITS_H
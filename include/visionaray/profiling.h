@@ -0,0 +1,145 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_PROFILING_H
+#define VSNRAY_PROFILING_H 1
+
+#include <visionaray/config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "export.h"
+
+namespace visionaray
+{
+namespace profiling
+{
+
+//-------------------------------------------------------------------------------------------------
+// Per-frame profiling timeline
+//
+// Records begin/end events in per-thread ring buffers and exports them in the
+// Chrome trace event format (load the file in chrome://tracing or Perfetto).
+//
+// The library records the scheduler frame, each parallel_for tile, the render
+// target's begin_frame(), end_frame() and display_color_buffer(), and BVH builds
+// when it is configured with VSNRAY_ENABLE_PROFILING; otherwise the macros below
+// expand to nothing. Recording must also be enabled at runtime with enable().
+//
+// Each thread records into its own buffer, only registering a new thread takes
+// a lock. When a buffer is full, the oldest events are overwritten. events(),
+// write_chrome_trace() and clear() must not be called while other threads record,
+// e.g. call them between frames.
+//
+// Usage:
+//
+//     profiling::enable();
+//     for (...) { sched.frame(kernel, sparams); }
+//     profiling::write_chrome_trace("frames.json");
+//
+
+struct event
+{
+    // Static string, e.g. a string literal
+    char const* name;
+
+    // Frame or tile index etc., or -1
+    int64_t id;
+
+    // Nanoseconds since the timeline was started
+    uint64_t begin;
+    uint64_t end;
+
+    // Threads are numbered in the order they record their first event
+    unsigned thread;
+};
+
+// Enable or disable recording (disabled by default)
+VSNRAY_EXPORT void enable(bool enable = true);
+VSNRAY_EXPORT bool enabled();
+
+// Maximum number of events per thread; clears the timeline
+VSNRAY_EXPORT void set_capacity(size_t events_per_thread);
+VSNRAY_EXPORT size_t capacity();
+
+// Remove all events
+VSNRAY_EXPORT void clear();
+
+// Current time in nanoseconds since the timeline was started
+VSNRAY_EXPORT uint64_t now();
+
+// Record an event on the calling thread (ignored if recording is disabled)
+VSNRAY_EXPORT void record(char const* name, uint64_t begin, uint64_t end, int64_t id = -1);
+
+// All events of all threads, sorted by begin time
+VSNRAY_EXPORT std::vector<event> events();
+
+// Export events as Chrome trace event JSON
+VSNRAY_EXPORT void write_chrome_trace(std::ostream& out);
+VSNRAY_EXPORT bool write_chrome_trace(std::string const& filename);
+
+
+//-------------------------------------------------------------------------------------------------
+// Record an event for the lifetime of an object
+//
+
+class scoped_event
+{
+public:
+
+    explicit scoped_event(char const* name, int64_t id = -1)
+        : name_(enabled() ? name : nullptr)
+        , id_(id)
+        , begin_(name_ != nullptr ? now() : 0)
+    {
+    }
+
+    ~scoped_event()
+    {
+        if (name_ != nullptr)
+        {
+            record(name_, begin_, now(), id_);
+        }
+    }
+
+    scoped_event(scoped_event const&) = delete;
+    scoped_event& operator=(scoped_event const&) = delete;
+
+private:
+
+    char const* name_;
+    int64_t id_;
+    uint64_t begin_;
+
+};
+
+} // profiling
+} // visionaray
+
+
+//-------------------------------------------------------------------------------------------------
+// Instrumentation macros, no-ops unless the library is built with VSNRAY_ENABLE_PROFILING
+//
+
+#define VSNRAY_PROFILING_CONCAT_IMPL_(A, B) A##B
+#define VSNRAY_PROFILING_CONCAT_(A, B) VSNRAY_PROFILING_CONCAT_IMPL_(A, B)
+
+#if VSNRAY_HAVE_PROFILING
+#define VSNRAY_PROFILE_SCOPE(NAME)                                              \
+    visionaray::profiling::scoped_event                                         \
+    VSNRAY_PROFILING_CONCAT_(vsnray_profile_scope_, __LINE__)(NAME)
+#define VSNRAY_PROFILE_SCOPE_ID(NAME, ID)                                       \
+    visionaray::profiling::scoped_event                                         \
+    VSNRAY_PROFILING_CONCAT_(vsnray_profile_scope_, __LINE__)(NAME, ID)
+#else
+#define VSNRAY_PROFILE_SCOPE(NAME)
+#define VSNRAY_PROFILE_SCOPE_ID(NAME, ID)
+#endif
+
+#endif // VSNRAY_PROFILING_H
@@ -17,9 +17,11 @@
 #include "detail/macros.h"
 #include "math/simd/type_traits.h"
 #include "array.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // random_generator classes, uses a standard pseudo RNG to generate samples
@@ -105,6 +107,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_RANDOM_GENERATOR_H
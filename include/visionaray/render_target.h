@@ -8,9 +8,11 @@
 
 #include "detail/macros.h"
 #include "pixel_traits.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Render target base
@@ -40,17 +42,26 @@ private:
 //-------------------------------------------------------------------------------------------------
 // Render target ref
 //
+// If FeatureFormat is specified, the schedulers also store the albedo, the
+// normal and the hit distance of the first hit (see result_record) in the
+// feature buffers, e.g. as input for the denoiser
+//
 
 template <
     pixel_format ColorFormat,
     pixel_format DepthFormat = PF_UNSPECIFIED,
-    pixel_format AccumFormat = PF_UNSPECIFIED
+    pixel_format AccumFormat = PF_UNSPECIFIED,
+    pixel_format FeatureFormat = PF_UNSPECIFIED
     >
 struct render_target_ref
 {
     constexpr static pixel_format color_format = ColorFormat;
     constexpr static pixel_format depth_format = DepthFormat;
     constexpr static pixel_format accum_format = AccumFormat;
+    constexpr static pixel_format feature_format = FeatureFormat;
+
+    // Number of AOV channels (see aov_render_target_ref)
+    constexpr static unsigned num_aovs = 0;
 
     // Storage type used by the color buffer
     using color_type = typename pixel_traits<ColorFormat>::type;
@@ -61,6 +72,9 @@ struct render_target_ref
     // Storage type used by the accumulation buffer
     using accum_type = typename pixel_traits<AccumFormat>::type;
 
+    // Storage type used by the feature buffers
+    using feature_type = typename pixel_traits<FeatureFormat>::type;
+
 
     VSNRAY_FUNC color_type* color()
     {
@@ -92,6 +106,28 @@ struct render_target_ref
         return accum_;
     }
 
+    // RGB: albedo
+    VSNRAY_FUNC feature_type* albedo()
+    {
+        return albedo_;
+    }
+
+    // XYZ: normal, W: distance along the primary ray
+    VSNRAY_FUNC feature_type* normal_depth()
+    {
+        return normal_depth_;
+    }
+
+    VSNRAY_FUNC feature_type const* albedo() const
+    {
+        return albedo_;
+    }
+
+    VSNRAY_FUNC feature_type const* normal_depth() const
+    {
+        return normal_depth_;
+    }
+
     VSNRAY_FUNC int width() const
     {
         return width_;
@@ -110,8 +146,15 @@ struct render_target_ref
     int width_;
     int height_;
 
+    feature_type* albedo_ = nullptr;
+    feature_type* normal_depth_ = nullptr;
+
 };
 
+template <pixel_format CF, pixel_format DF, pixel_format AF, pixel_format FF>
+constexpr unsigned render_target_ref<CF, DF, AF, FF>::num_aovs;
+
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_RENDER_TARGET_H
@@ -8,9 +8,11 @@
 
 #include "math/simd/type_traits.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Result record that the builtin visionaray kernels return
@@ -22,12 +24,24 @@ struct result_record
     using scalar_type = T;
     using mask_type   = simd::mask_type_t<T>;
     using color_type  = vector<4, T>;
+    using int_type    = simd::int_type_t<T>;
 
     mask_type   hit   = mask_type(false);
     color_type  color = color_type(0.0);
     scalar_type depth = scalar_type(0.0);
+
+    // First hit features, stored by the schedulers if the render target
+    // has feature buffers (see render_target_ref)
+    vector<3, T> albedo = vector<3, T>(1.0);
+    vector<3, T> normal = vector<3, T>(0.0);
+
+    // First hit primitive and geometry id, stored by the schedulers if the
+    // render target has AOV channels (see aov_render_target_ref)
+    int_type prim_id = int_type(-1);
+    int_type geom_id = int_type(-1);
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_RESULT_RECORD_H
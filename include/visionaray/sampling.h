@@ -16,9 +16,11 @@
 #include "math/vector.h"
 #include "array.h"
 #include "light_sample.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -266,6 +268,7 @@ light_sample<T> sample_random_light(Lights begin, Lights end, vector<3, T> const
     return result;
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_SAMPLING_H
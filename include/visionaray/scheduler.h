@@ -12,12 +12,16 @@
 #include <utility>
 
 #include "detail/sched_common.h"
+#include "detail/tile_order.h"
 #include "math/forward.h"
 #include "math/matrix.h"
+#include "math/rectangle.h"
 #include "matrix_camera.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Base classes for scheduler params
@@ -25,6 +29,17 @@ namespace visionaray
 
 struct sched_params_base
 {
+    // Order in which image tiles are handed out to threads
+    tile_order order = RowMajorOrder;
+
+    // Tile size in pixels, rounded up to a multiple of the packet size; 0 chooses
+    // a size based on image size and number of threads
+    int tile_width = 0;
+    int tile_height = 0;
+
+    // Only render pixels inside this rectangle (expanded to packet boundaries), if
+    // empty, render the whole render target. Other pixels keep their contents.
+    recti scissor = recti(0, 0, 0, 0);
 };
 
 template <typename Intersector>
@@ -195,6 +210,7 @@ auto make_sched_params(First first, Args&&... args)
     return make_sched_params(pixel_sampler::uniform_type{}, first, std::forward<Args>(args)...);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #ifdef __CUDACC__
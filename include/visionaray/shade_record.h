@@ -11,9 +11,11 @@
 #include "math/simd/type_traits.h"
 #include "math/vector.h"
 #include "array.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 struct shade_record
@@ -69,6 +71,7 @@ inline array<shade_record<element_type_t<T>>, num_elements<T>::value> unpack(sha
 
 } // simd
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_SHADE_RECORD_H
@@ -10,9 +10,11 @@
 
 #include "pixel_traits.h"
 #include "render_target.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // The most simple GPU render target, only provides buffers for color and depth.
@@ -52,6 +54,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/simple_gpu_buffer_rt.inl"
@@ -8,6 +8,7 @@
 
 #include "detail/macros.h"
 #include "math/vector.h"
+#include "detail/isa_namespace.h"
 
 
 //-------------------------------------------------------------------------------------------------
@@ -18,6 +19,7 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Spectral power distribution
@@ -63,6 +65,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/spectrum.inl"
@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "math/vector.h"
 #include "light_sample.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename T>
 class spot_light
@@ -69,6 +71,7 @@ private:
     T quadratic_attenuation_;
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/spot_light.inl"
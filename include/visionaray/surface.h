@@ -10,9 +10,11 @@
 #include "math/vector.h"
 #include "material.h"
 #include "shade_record.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename N, typename C, typename M>
 struct surface
@@ -39,6 +41,16 @@ struct surface
         return material.shade(shade_rec);
     }
 
+    // Reflectance for light from the normal direction, i.e. the (textured) diffuse
+    // color of matte and plastic materials. Approximates the albedo without sampling
+    template <typename U>
+    VSNRAY_FUNC
+    spectrum<scalar_type> albedo(vector<3, U> const& view_dir)
+    {
+        auto n = faceforward(shading_normal, view_dir, geometric_normal);
+        return shade(view_dir, n, vector<3, U>(1.0));
+    }
+
     template <typename U, typename Interaction, typename Generator>
     VSNRAY_FUNC
     spectrum<scalar_type> sample(
@@ -72,6 +84,7 @@ struct surface
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/surface.inl"
@@ -6,8 +6,11 @@
 #ifndef VSNRAY_SURFACE_INTERACTION_H
 #define VSNRAY_SURFACE_INTERACTION_H 1
 
+#include "detail/isa_namespace.h"
+
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Interaction type to track the surface interaction that occurred
@@ -24,6 +27,7 @@ struct surface_interaction
     enum { GlossyTransmission   = 1 << 6 };
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_SURFACE_INTERACTION_H
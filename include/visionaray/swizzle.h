@@ -11,9 +11,11 @@
 #include "math/unorm.h"
 #include "math/vector.h"
 #include "pixel_format.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 enum swizzle_hint
 {
@@ -663,6 +665,7 @@ inline void swizzle(
     detail::swizzle_expand_types( data, format_dst, format_src, len );
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_SWIZZLE_H
@@ -7,6 +7,7 @@
 #define VSNRAY_TAGS_H 1
 
 #include <type_traits>
+#include "detail/isa_namespace.h"
 
 //-------------------------------------------------------------------------------------------------
 // Tags for API use
@@ -14,6 +15,7 @@
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 struct conductor_tag {};
 struct dielectric_tag {};
@@ -64,6 +66,7 @@ using is_color_binding   = std::is_base_of<color_binding, T>;
 template <typename T>
 using is_normal_binding  = std::is_base_of<normal_binding, T>;
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TAGS_H
@@ -0,0 +1,127 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_TEMPORAL_ACCUMULATOR_H
+#define VSNRAY_TEMPORAL_ACCUMULATOR_H 1
+
+#include <thread>
+
+#include "detail/thread_pool.h"
+#include "math/vector.h"
+#include "aligned_vector.h"
+#include "pinhole_camera.h"
+#include "pixel_format.h"
+#include "pixel_traits.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Temporal accumulation with reprojection
+//
+// Blends each new frame with the history of previous frames, like the
+// jittered blend pixel sampler, but keeps the history when the camera
+// moves: every pixel's first hit is reconstructed from the distance in
+// the normal/depth feature buffer (see render_target_ref), projected into
+// the previous frame, and the history there is fetched bilinearly. History
+// samples are rejected on disocclusion, i.e. if they belong to a different
+// surface (tangent plane distance) or orientation (normals).
+//
+// Each pixel keeps its own history length, the new frame is blended in
+// with weight 1/(length+1), so pixels converge as if the camera had not
+// moved, while disoccluded pixels restart from the new sample.
+//
+// Usage:
+//
+//     cpu_buffer_rt<PF_RGBA8, PF_UNSPECIFIED, PF_RGBA32F, PF_RGBA32F> rt;
+//     ...
+//     blend_params.sfactor = 1.0f;    // replace, the accumulator blends
+//     blend_params.dfactor = 0.0f;
+//     sched.frame(kernel, sparams);
+//     accumulator.accumulate(rt, cam); // accum buffer -> accum and color buffer
+//
+
+class temporal_accumulator
+{
+public:
+
+    explicit temporal_accumulator(unsigned num_threads = std::thread::hardware_concurrency());
+
+    // Maximum history length in frames, 0: unlimited (default). Limiting the
+    // history lets pixels adapt faster to changes, at the cost of more noise
+    void set_max_history(unsigned max_history);
+    unsigned max_history() const;
+
+    // History is rejected if the reprojected point is farther away from the
+    // previous surface's tangent plane than tolerance times its distance
+    void set_depth_tolerance(float tolerance);
+    float depth_tolerance() const;
+
+    // History is rejected if the cosine between the normals is smaller
+    void set_normal_tolerance(float cos_angle);
+    float normal_tolerance() const;
+
+    // Discard the history, e.g. when the scene has changed
+    void reset();
+
+    // Blend the RGBA32F samples of the current frame with the history.
+    // accum is replaced with the accumulated colors, which are also
+    // converted to dst's pixel format. normal_depth is the RGBA32F feature
+    // buffer of the current frame, cam the camera it was rendered with.
+    template <pixel_format DF>
+    void accumulate(
+            pixel_format_constant<DF>                   dst_format,
+            typename pixel_traits<DF>::type*            dst,
+            vec4*                                       accum,
+            vec4 const*                                 normal_depth,
+            int                                         width,
+            int                                         height,
+            pinhole_camera const&                       cam
+            );
+
+    // Accumulate the render target's accumulation buffer and store the
+    // result in its accumulation and color buffer
+    template <typename RenderTarget>
+    void accumulate(RenderTarget& rt, pinhole_camera const& cam);
+
+    // Per pixel screen space motion of the last frame, in pixels
+    // (previous minus current position)
+    vec2 const* motion_vectors() const;
+
+    // Per pixel history length after the last frame, 1 where the history
+    // was rejected
+    float const* history_length() const;
+
+private:
+
+    thread_pool pool_;
+
+    unsigned max_history_ = 0;
+    float depth_tolerance_ = 0.02f;
+    float normal_tolerance_ = 0.9f;
+
+    // Camera and size of the previous frame, history is valid if size > 0
+    pinhole_camera prev_cam_;
+    int prev_width_ = 0;
+    int prev_height_ = 0;
+
+    // History color, features and length, ping-pong between frames
+    aligned_vector<vec4> color_[2];
+    aligned_vector<vec4> normal_depth_[2];
+    aligned_vector<float> length_[2];
+    unsigned curr_ = 0;
+
+    aligned_vector<vec2> motion_;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#include "detail/temporal_accumulator.inl"
+
+#endif // VSNRAY_TEMPORAL_ACCUMULATOR_H
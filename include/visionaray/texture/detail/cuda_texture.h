@@ -14,10 +14,12 @@
 #include "../../math/vector.h"
 
 #include "texture_common.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -104,6 +106,7 @@ class cuda_texture;
 template <typename T, unsigned Dim>
 class cuda_texture_ref;
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "cuda_texture1d.inl"
@@ -8,9 +8,11 @@
 
 #include "../../cuda/array.h"
 #include "../../cuda/texture_object.h"
+#include "../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // CUDA texture1d
@@ -465,4 +467,5 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
@@ -8,9 +8,11 @@
 
 #include "../../cuda/pitch2d.h"
 #include "../../cuda/texture_object.h"
+#include "../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // CUDA texture2d
@@ -480,4 +482,5 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
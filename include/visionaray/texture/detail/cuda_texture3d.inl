@@ -8,9 +8,11 @@
 
 #include "../../cuda/array.h"
 #include "../../cuda/texture_object.h"
+#include "../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // CUDA texture3d
@@ -510,4 +512,5 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
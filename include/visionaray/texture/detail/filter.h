@@ -12,9 +12,11 @@
 #include "filter/nearest.h"
 
 #include "texture_common.h"
+#include "../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -56,6 +58,9 @@ inline ReturnT choose_filter(
                 coord
                 );
 
+    // Expects coefficients, see convert_for_bspline_interpol()
+    case visionaray::BSplineInterpol:
+        // fall-through
     case visionaray::BSpline:
         return cubic_opt(
                 ReturnT{},
@@ -80,6 +85,7 @@ inline ReturnT choose_filter(
 }
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_FILTER_H
@@ -10,9 +10,11 @@
 
 #include <visionaray/math/simd/simd.h>
 #include <visionaray/math/vector.h>
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Deduce types used by the filtering algorithm based on the texture and coordinate types
@@ -63,6 +65,17 @@ struct arithmetic_types<TexelType, simd::float8>
     using return_type = simd::float8;
 };
 
+// Same for AVX-512
+template <typename  TexelType>
+struct arithmetic_types<TexelType, simd::float16>
+{
+    // Type used for internal calculations by the filter functions
+    using internal_type = simd::float16;
+
+    // Type returned by the filter functions
+    using return_type = simd::float16;
+};
+
 // Vector texture, but calculations are simd, therefore the
 // return type is simd, too!
 template <size_t Dim, typename  T>
@@ -86,6 +99,18 @@ struct arithmetic_types<vector<Dim, T>, simd::float8>
     using return_type = vector<Dim, simd::float8>;
 };
 
+// Same for AVX-512
+template <size_t Dim, typename  T>
+struct arithmetic_types<vector<Dim, T>, simd::float16>
+{
+    // Type used for internal calculations by the filter functions
+    using internal_type = vector<Dim, simd::float16>;
+
+    // Type returned by the filter functions
+    using return_type = vector<Dim, simd::float16>;
+};
+
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_FILTER_ARITHMETIC_TYPES_H
@@ -6,10 +6,15 @@
 #ifndef VSNRAY_TEXTURE_DETAIL_FILTER_COMMON_H
 #define VSNRAY_TEXTURE_DETAIL_FILTER_COMMON_H 1
 
+#include <type_traits>
+
 #include <visionaray/math/detail/math.h>
+#include <visionaray/math/vector.h>
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -136,7 +141,115 @@ inline T h1(T const& x)
     return ((floor( x ) + T(1.0) + w3(x)) / (w2(x) + w3(x))) - x;
 }
 
+
+
+//-------------------------------------------------------------------------------------------------
+// Texel footprint of a 3D filter kernel: N texel coordinates per dimension, texels
+// are fetched at (pos[i].x, pos[j].y, pos[k].z)
+//
+// Storage types with haloed bricks (see bricked_layout) export their halo width.
+// If all texels lie within the halo of the brick containing pos[Base], they are
+// addressed relative to a single base index instead of computing a full address
+// per texel. Footprints that wrap around the texture fall back to per texel
+// addressing
+//
+
+template <typename Tex, typename = void>
+struct has_halo : std::false_type
+{
+};
+
+template <typename Tex>
+struct has_halo<Tex, decltype(void(Tex::halo))>
+    : std::integral_constant<bool, (Tex::halo > 0)>
+{
+};
+
+template <typename Tex, typename I, int N, int Base, bool Halo = has_halo<Tex>::value>
+class texel_footprint
+{
+public:
+
+    texel_footprint(Tex const& tex, vector<3, I> const* pos)
+        : tex_(tex)
+        , pos_(pos)
+    {
+    }
+
+    template <typename U>
+    U operator()(U /* */, int i, int j, int k) const
+    {
+        return tex_.value(U{}, pos_[i].x, pos_[j].y, pos_[k].z);
+    }
+
+private:
+
+    Tex const& tex_;
+    vector<3, I> const* pos_;
+
+};
+
+template <typename Tex, typename I, int N, int Base>
+class texel_footprint<Tex, I, N, Base, true>
+{
+public:
+
+    // 64-bit for scalar coordinates, see bricked_layout
+    using index_type = typename Tex::template index_type<I>;
+
+    texel_footprint(Tex const& tex, vector<3, I> const* pos)
+        : tex_(tex)
+        , pos_(pos)
+    {
+        I h(static_cast<int>(Tex::halo));
+
+        for (int i = 0; i < N; ++i)
+        {
+            vector<3, I> d = pos[i] - pos[Base];
+
+            relative_ &= !any((d.x < -h) | (d.x > h));
+            relative_ &= !any((d.y < -h) | (d.y > h));
+            relative_ &= !any((d.z < -h) | (d.z > h));
+
+            offset_x_[i] = index_type(d.x);
+            offset_y_[i] = index_type(d.y * I(static_cast<int>(Tex::stride_y)));
+            offset_z_[i] = index_type(d.z * I(static_cast<int>(Tex::stride_z)));
+        }
+
+        if (relative_)
+        {
+            base_ = tex.index(pos[Base].x, pos[Base].y, pos[Base].z);
+        }
+    }
+
+    template <typename U>
+    U operator()(U /* */, int i, int j, int k) const
+    {
+        if (relative_)
+        {
+            return tex_.fetch(U{}, base_ + offset_x_[i] + offset_y_[j] + offset_z_[k]);
+        }
+        else
+        {
+            return tex_.value(U{}, pos_[i].x, pos_[j].y, pos_[k].z);
+        }
+    }
+
+private:
+
+    Tex const& tex_;
+    vector<3, I> const* pos_;
+
+    bool relative_ = true;
+    index_type base_;
+    index_type offset_x_[N];
+    index_type offset_y_[N];
+    index_type offset_z_[N];
+
+};
+
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_FILTER_COMMON_H
@@ -10,9 +10,11 @@
 #include <visionaray/math/vector.h>
 
 #include "common.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -169,9 +171,11 @@ inline ReturnT cubic(
 
     auto uvw = (coord2 * texsizef) - vector<3, FloatT>(pos[1]);
 
+    texel_footprint<Tex, decltype(convert_to_int(FloatT{})), 4, 1> texel(tex, pos);
+
     auto sample = [&](int i, int j, int k) -> InternalT
     {
-        return InternalT(tex.value(ReturnT{}, pos[i].x, pos[j].y, pos[k].z));
+        return InternalT(texel(ReturnT{}, i, j, k));
     };
 
     auto f00 = w0(uvw.x) * sample(0, 0, 0) + w1(uvw.x) * sample(1, 0, 0) + w2(uvw.x) * sample(2, 0, 0) + w3(uvw.x) * sample(3, 0, 0);
@@ -203,6 +207,7 @@ inline ReturnT cubic(
 }
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_FILTER_CUBIC_H
@@ -11,9 +11,11 @@
 
 #include "common.h"
 #include "linear.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -200,6 +202,7 @@ inline ReturnT cubic_opt(
 }
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_FILTER_CUBIC_OPT_H
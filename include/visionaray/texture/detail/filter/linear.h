@@ -10,9 +10,11 @@
 #include <visionaray/math/vector.h>
 
 #include "common.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -39,8 +41,13 @@ inline ReturnT linear(
     vector<1, F> texsizef(F((float)texsize[0]));
     vector<1, I> texsize_minus_one(texsize[0] - 1);
 
-    auto coord1 = tex.remap_texture_coordinate(coord - FloatT(0.5) / texsizef);
-    auto coord2 = tex.remap_texture_coordinate(coord + FloatT(0.5) / texsizef);
+    // Texel space; the neighbors' indices are computed from their centers, so
+    // that they are adjacent regardless of rounding
+    auto x = coord * texsizef - FloatT(0.5);
+    auto xf = floor(x);
+
+    auto coord1 = tex.remap_texture_coordinate((xf + FloatT(0.5)) / texsizef);
+    auto coord2 = tex.remap_texture_coordinate((xf + FloatT(1.5)) / texsizef);
 
     auto lo = min(convert_to_int(coord1 * texsizef), texsize_minus_one);
     auto hi = min(convert_to_int(coord2 * texsizef), texsize_minus_one);
@@ -50,7 +57,7 @@ inline ReturnT linear(
         InternalT(tex.value(ReturnT{}, hi[0]))
         };
 
-    auto u = coord1[0] * FloatT(texsize[0]) - FloatT(lo[0]);
+    auto u = x[0] - xf[0];
 
     return ReturnT(lerp(samples[0], samples[1], u));
 }
@@ -79,8 +86,13 @@ inline ReturnT linear(
     vector<2, F> texsizef(F((float)texsize[0]), F((float)texsize[1]));
     vector<2, I> texsize_minus_one(texsize[0] - 1, texsize[1] - 1);
 
-    auto coord1 = tex.remap_texture_coordinate(coord - FloatT(0.5) / texsizef);
-    auto coord2 = tex.remap_texture_coordinate(coord + FloatT(0.5) / texsizef);
+    // Texel space; the neighbors' indices are computed from their centers, so
+    // that they are adjacent regardless of rounding
+    auto x = coord * texsizef - FloatT(0.5);
+    auto xf = floor(x);
+
+    auto coord1 = tex.remap_texture_coordinate((xf + FloatT(0.5)) / texsizef);
+    auto coord2 = tex.remap_texture_coordinate((xf + FloatT(1.5)) / texsizef);
 
     auto lo = min(convert_to_int(coord1 * texsizef), texsize_minus_one);
     auto hi = min(convert_to_int(coord2 * texsizef), texsize_minus_one);
@@ -93,7 +105,7 @@ inline ReturnT linear(
         };
 
 
-    auto uv = coord1 * texsizef - vector<2, FloatT>(lo);
+    auto uv = x - xf;
 
     auto p1 = lerp(samples[0], samples[1], uv[0]);
     auto p2 = lerp(samples[2], samples[3], uv[0]);
@@ -125,25 +137,33 @@ inline ReturnT linear(
     vector<3, F> texsizef(F((float)texsize[0]), F((float)texsize[1]), F((float)texsize[2]));
     vector<3, I> texsize_minus_one(texsize[0] - 1, texsize[1] - 1, texsize[2] - 1);
 
-    auto coord1 = tex.remap_texture_coordinate(coord - FloatT(0.5) / texsizef);
-    auto coord2 = tex.remap_texture_coordinate(coord + FloatT(0.5) / texsizef);
+    // Texel space; the neighbors' indices are computed from their centers, so
+    // that they are adjacent regardless of rounding
+    auto x = coord * texsizef - FloatT(0.5);
+    auto xf = floor(x);
+
+    auto coord1 = tex.remap_texture_coordinate((xf + FloatT(0.5)) / texsizef);
+    auto coord2 = tex.remap_texture_coordinate((xf + FloatT(1.5)) / texsizef);
 
     auto lo = min(convert_to_int(coord1 * texsizef), texsize_minus_one);
     auto hi = min(convert_to_int(coord2 * texsizef), texsize_minus_one);
 
+    vector<3, I> pos[2] = { lo, hi };
+    texel_footprint<Tex, I, 2, 0> texel(tex, pos);
+
     InternalT samples[8] = {
-        InternalT(tex.value(ReturnT{}, lo.x, lo.y, lo.z)),
-        InternalT(tex.value(ReturnT{}, hi.x, lo.y, lo.z)),
-        InternalT(tex.value(ReturnT{}, lo.x, hi.y, lo.z)),
-        InternalT(tex.value(ReturnT{}, hi.x, hi.y, lo.z)),
-        InternalT(tex.value(ReturnT{}, lo.x, lo.y, hi.z)),
-        InternalT(tex.value(ReturnT{}, hi.x, lo.y, hi.z)),
-        InternalT(tex.value(ReturnT{}, lo.x, hi.y, hi.z)),
-        InternalT(tex.value(ReturnT{}, hi.x, hi.y, hi.z))
+        InternalT(texel(ReturnT{}, 0, 0, 0)),
+        InternalT(texel(ReturnT{}, 1, 0, 0)),
+        InternalT(texel(ReturnT{}, 0, 1, 0)),
+        InternalT(texel(ReturnT{}, 1, 1, 0)),
+        InternalT(texel(ReturnT{}, 0, 0, 1)),
+        InternalT(texel(ReturnT{}, 1, 0, 1)),
+        InternalT(texel(ReturnT{}, 0, 1, 1)),
+        InternalT(texel(ReturnT{}, 1, 1, 1))
         };
 
 
-    auto uvw = coord1 * texsizef - vector<3, FloatT>(lo);
+    auto uvw = x - xf;
 
     auto p1  = lerp(samples[0], samples[1], uvw[0]);
     auto p2  = lerp(samples[2], samples[3], uvw[0]);
@@ -157,6 +177,7 @@ inline ReturnT linear(
 }
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_FILTER_LINEAR_H
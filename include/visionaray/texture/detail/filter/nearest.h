@@ -10,9 +10,11 @@
 #include <visionaray/math/vector.h>
 
 #include "common.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -103,6 +105,7 @@ inline ReturnT nearest(
 }
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_FILTER_NEAREST_H
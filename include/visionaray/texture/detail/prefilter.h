@@ -6,15 +6,31 @@
 #ifndef VSNRAY_TEXTURE_DETAIL_PREFILTER_H
 #define VSNRAY_TEXTURE_DETAIL_PREFILTER_H 1
 
-#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <type_traits>
 
 #include <visionaray/math/detail/math.h>
-
+#include <visionaray/math/simd/simd.h>
+#include <visionaray/math/simd/type_traits.h>
+#include <visionaray/math/unorm.h>
+#include <visionaray/math/vector.h>
+#include <visionaray/aligned_vector.h>
+
+#include "../../detail/parallel_for.h"
+#include "../../detail/range.h"
+#include "../../detail/thread_pool.h"
 #include "texture_common.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -22,138 +38,364 @@ namespace detail
 // Prefilter for B-Spline interpolation
 // Ported from http://dannyruijters.nl/docs/cudaPrefilter3.pdf
 //
+// The causal and anticausal recursive filters are applied along each dimension.
+// The boundary conditions (initial coefficients) correspond to clamping, use
+// the Clamp address mode with the coefficients.
+//
 
 static float const Pole = sqrt(3.0f) - 2.0f;
+static float const Lambda = 6.0f;
 
-inline float init_causal_coeff(short* c, unsigned len, unsigned stride)
+template <typename F>
+inline F init_causal_coeff(F const* c, unsigned len, size_t stride)
 {
-
-    typedef float float_type;
-//  typedef short voxel_type;
-
     unsigned const Horizon = min(12U, len);
 
-    float_type zk(Pole);
-    float_type sum = float_type(*c) ;
+    float zk(Pole);
+    F sum = *c;
     for (unsigned k = 0; k < Horizon; ++k)
     {
-        sum += zk * float_type(*c);
-        zk *= float_type(Pole);
+        sum += zk * *c;
+        zk *= Pole;
         c += stride;
     }
 
     return sum;
 }
 
-inline float init_anticausal_coeff(short* c)
+template <typename F>
+inline F init_anticausal_coeff(F const* c)
 {
-    typedef float float_type;
-    return (Pole / (Pole - float_type(1.0))) * float_type(*c);
+    return (Pole / (Pole - 1.0f)) * *c;
 }
 
-template <typename T>
-inline void convert_to_bspline_coeffs(T*, unsigned, unsigned)
+// F is float, vector<N, float> or a SIMD type; in-place
+template <typename F>
+inline void convert_to_bspline_coeffs(F* c, unsigned len, size_t stride)
 {
-    throw std::runtime_error("not implemented yet");
-}
-
-inline void convert_to_bspline_coeffs(short* c, unsigned len, unsigned stride)
-{
-
-    typedef float float_type;
-    typedef short voxel_type;
-
-    static float_type const Lambda = 6.0;
-
     // causal
 
-    *c = voxel_type( Lambda * init_causal_coeff(c, len, stride) );
+    *c = Lambda * init_causal_coeff(c, len, stride);
 
     for (unsigned k = 1; k < len; ++k)
     {
         c += stride;
-        *c = voxel_type( Lambda * float_type(*c) + Pole * *(c - stride) );
+        *c = Lambda * *c + Pole * *(c - stride);
     }
 
     // anticausal
 
-    *c = voxel_type( init_anticausal_coeff(c) );
+    *c = init_anticausal_coeff(c);
 
     for (int k = len - 2; 0 <= k; --k)
     {
         c -= stride;
-        *c = voxel_type( Pole * (*(c + stride) - float_type(*c)) );
+        *c = Pole * (*(c + stride) - *c);
     }
-
 }
 
-} // detail
 
+//-------------------------------------------------------------------------------------------------
+// Prefilter traits: B-spline coefficients are computed in floating point, with
+// one channel per vector component
+//
 
 template <typename T>
-inline void convert_for_bspline_interpol(texture_ref<T, 1> const* tex)
+struct bspline_coeff_traits
 {
-    using namespace detail;
+    using coeff_type = float;
+    enum { channels = 1 };
 
-    T const* ptr = &(*tex)(0);
-    convert_to_bspline_coeffs(ptr, tex->size(), 1);
+    static float get(T const& t, int /* */)
+    {
+        return static_cast<float>(t);
+    }
+
+    // Integer types are rounded and clamped to their range
+    template <typename U = T>
+    static typename std::enable_if<std::is_integral<U>::value>::type set(U& t, int /* */, float f)
+    {
+        f = std::max(f, static_cast<float>(std::numeric_limits<U>::lowest()));
+        f = std::min(f, static_cast<float>(std::numeric_limits<U>::max()));
+        t = static_cast<U>(std::round(f));
+    }
+
+    template <typename U = T>
+    static typename std::enable_if<!std::is_integral<U>::value>::type set(U& t, int /* */, float f)
+    {
+        t = static_cast<U>(f);
+    }
+};
+
+template <unsigned Bits>
+struct bspline_coeff_traits<unorm<Bits>>
+{
+    using coeff_type = float;
+    enum { channels = 1 };
+
+    static float get(unorm<Bits> const& t, int /* */)
+    {
+        return static_cast<float>(t);
+    }
+
+    // Rounded, clamped to [0..1]
+    static void set(unorm<Bits>& t, int /* */, float f)
+    {
+        t = unorm<Bits>(f + 0.5f / ((1ULL << Bits) - 1));
+    }
+};
+
+template <size_t Dim, typename T>
+struct bspline_coeff_traits<vector<Dim, T>>
+{
+    using coeff_type = vector<Dim, float>;
+    enum { channels = Dim };
+
+    static float get(vector<Dim, T> const& t, int c)
+    {
+        return bspline_coeff_traits<T>::get(t[c], 0);
+    }
+
+    static void set(vector<Dim, T>& t, int c, float f)
+    {
+        bspline_coeff_traits<T>::set(t[c], 0, f);
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Apply the prefilter to all lines along one dimension of an array
+//
+// Lines are distributed over the thread pool in tiles. Each SIMD lane processes one
+// line; lanes hold adjacent lines, these are consecutive in memory for all but the
+// first dimension. Lines are filtered in a per-thread float buffer, so that the
+// recursion runs on aligned SIMD registers. The filtered lines are written to dst,
+// which has the same layout as src and may be the same array.
+//
+
+#if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX)
+using prefilter_float = simd::float8;
+#else
+using prefilter_float = simd::float4;
+#endif
+
+template <typename Src, typename Dst>
+inline void convert_to_bspline_coeffs(
+        Src const*  src,
+        Dst*        dst,
+        size_t      len,
+        size_t      stride,
+        size_t      num_lines,
+        thread_pool& pool
+        )
+{
+    using src_traits = bspline_coeff_traits<Src>;
+    using dst_traits = bspline_coeff_traits<Dst>;
+
+    static_assert(int(src_traits::channels) == int(dst_traits::channels), "Type mismatch");
+
+    enum { C = src_traits::channels };
+    enum { L = simd::num_elements<prefilter_float>::value };
+
+    if (len < 2)
+    {
+        return;
+    }
+
+    // Offset of the first element of a line; line i + 1 follows line i in the
+    // dimensions below the filtered one
+    auto line_offset = [=](size_t i)
+    {
+        return (i % stride) + (i / stride) * stride * len;
+    };
+
+    size_t num_blocks = div_up(num_lines, size_t(L));
+    size_t blocks_per_tile = std::max(size_t(1), std::min(size_t(64), num_blocks / (pool.num_threads * 8)));
+
+    parallel_for(
+        pool,
+        tiled_range1d<size_t>(0, num_blocks, blocks_per_tile),
+        [&](range1d<size_t> const& r)
+        {
+            // Channel c of element k at buf[k * C + c]
+            aligned_vector<prefilter_float, alignof(prefilter_float)> buf(len * C);
+
+            size_t offsets[L];
+            simd::aligned_array_t<prefilter_float> lanes;
+
+            for (size_t b = r.begin(); b != r.end(); ++b)
+            {
+                size_t first = b * L;
+                size_t active = std::min(size_t(L), num_lines - first);
+
+                // Inactive lanes duplicate the last line, they are not written
+                for (size_t i = 0; i < L; ++i)
+                {
+                    offsets[i] = line_offset(first + std::min(i, active - 1));
+                }
+
+                for (size_t k = 0; k < len; ++k)
+                {
+                    for (int c = 0; c < C; ++c)
+                    {
+                        for (size_t i = 0; i < L; ++i)
+                        {
+                            lanes[i] = src_traits::get(src[offsets[i] + k * stride], c);
+                        }
+
+                        buf[k * C + c] = prefilter_float(lanes);
+                    }
+                }
+
+                for (int c = 0; c < C; ++c)
+                {
+                    convert_to_bspline_coeffs(buf.data() + c, static_cast<unsigned>(len), C);
+                }
+
+                for (size_t k = 0; k < len; ++k)
+                {
+                    for (int c = 0; c < C; ++c)
+                    {
+                        store(lanes, buf[k * C + c]);
+
+                        for (size_t i = 0; i < active; ++i)
+                        {
+                            dst_traits::set(dst[offsets[i] + k * stride], c, lanes[i]);
+                        }
+                    }
+                }
+            }
+        });
 }
 
-template <typename T>
-inline void convert_for_bspline_interpol(texture_ref<T, 2> const* tex)
+// Prefilter all dimensions, reads src and writes dst; intermediate results of
+// all but the last dimension are stored in tmp (which may be dst if it has the
+// same type as tmp, or src if it is tmp)
+template <typename Src, typename Tmp, typename Dst, size_t Dim>
+inline void convert_to_bspline_coeffs(
+        Src const*                          src,
+        Tmp*                                tmp,
+        Dst*                                dst,
+        std::array<unsigned, Dim> const&    size,
+        thread_pool&                        pool
+        )
 {
-    using namespace detail;
+    size_t total = 1;
+
+    for (size_t d = 0; d < Dim; ++d)
+    {
+        total *= size[d];
+    }
 
-    // row-wise
-    for (unsigned row = 0; row < tex->height(); ++row)
+    if (total == 0)
     {
-        T const* ptr = &(*tex)[row * tex->width()]; // TODO: use operator()
-        convert_to_bspline_coeffs(ptr, tex->width(), 1);
+        return;
     }
 
-    // column-wise
-    for (unsigned col = 0; col < tex->width(); ++col)
+    if (Dim == 1)
     {
-        T const* ptr = &(*tex)[col]; // TODO: use operator()
-        convert_to_bspline_coeffs(ptr, tex->height(), tex->width());
+        convert_to_bspline_coeffs(src, dst, size[0], 1, total / size[0], pool);
+        return;
+    }
+
+    size_t stride = 1;
+
+    for (size_t d = 0; d < Dim; ++d)
+    {
+        size_t num_lines = total / size[d];
+
+        if (d == 0)
+        {
+            convert_to_bspline_coeffs(src, tmp, size[d], stride, num_lines, pool);
+        }
+        else if (d + 1 < Dim)
+        {
+            convert_to_bspline_coeffs(tmp, tmp, size[d], stride, num_lines, pool);
+        }
+        else
+        {
+            convert_to_bspline_coeffs(tmp, dst, size[d], stride, num_lines, pool);
+        }
+
+        stride *= size[d];
     }
 }
 
 template <typename T>
-inline void convert_for_bspline_interpol(texture_ref<T, 3> const* tex)
+struct is_float_based : std::is_same<typename bspline_coeff_traits<T>::coeff_type, T>
+{
+};
+
+} // detail
+
+
+//-------------------------------------------------------------------------------------------------
+// Convert texel values to coefficients for BSplineInterpol filtering
+//
+// Supports scalar and vector textures of floating point, integer and unorm type in
+// 1D, 2D and 3D. Coefficients are computed in single precision, in place for float
+// textures. Other textures are filtered line by line in float buffers; in 2D and
+// 3D, the results of all but the last dimension are kept in a temporary float array,
+// so that only the final coefficients are rounded. Coefficients overshoot the value
+// range at sharp edges; for integer and unorm types they are clamped there, so
+// interpolation is only approximate in that case.
+//
+
+template <typename T, size_t Dim>
+inline void convert_for_bspline_interpol(T* data, std::array<unsigned, Dim> const& size, thread_pool& pool)
 {
     using namespace detail;
 
-    short* tmp = tex->prefiltered_data;
+    using coeff_type = typename bspline_coeff_traits<T>::coeff_type;
 
-    for (unsigned z = 0; z < tex->depth(); ++z)
+    static_assert(Dim >= 1 && Dim <= 3, "Incompatible texture type");
+
+    if (is_float_based<T>::value)
     {
-        for (unsigned y = 0; y < tex->height(); ++y)
-        {
-            short* ptr = &tmp[z * tex->width() * tex->height() + y * tex->width()];
-            convert_to_bspline_coeffs(ptr, tex->width(), 1);
-        }
+        auto coeffs = reinterpret_cast<coeff_type*>(data);
+        convert_to_bspline_coeffs(coeffs, coeffs, coeffs, size, pool);
+        return;
     }
 
-    for (unsigned x = 0; x < tex->width(); ++x)
+    if (Dim == 1)
     {
-        for (unsigned z = 0; z < tex->depth(); ++z)
-        {
-            short* ptr = &tmp[z * tex->width() * tex->height() + x];
-            convert_to_bspline_coeffs(ptr, tex->height(), tex->width());
-        }
+        convert_to_bspline_coeffs(data, static_cast<coeff_type*>(nullptr), data, size, pool);
+        return;
     }
 
-    for (unsigned y = 0; y < tex->height(); ++y)
+    size_t total = 1;
+
+    for (size_t d = 0; d < Dim; ++d)
     {
-        for (unsigned x = 0; x < tex->width(); ++x)
-        {
-            short const* ptr = &tmp[y * tex->width() + x];
-            convert_to_bspline_coeffs(ptr, tex->depth(), tex->width() * tex->height());
-        }
+        total *= size[d];
     }
+
+    aligned_vector<coeff_type> tmp(total);
+    convert_to_bspline_coeffs(data, tmp.data(), data, size, pool);
+}
+
+template <typename T, size_t Dim>
+inline void convert_for_bspline_interpol(T* data, std::array<unsigned, Dim> const& size)
+{
+    thread_pool pool(std::max(1U, std::thread::hardware_concurrency()));
+    convert_for_bspline_interpol(data, size, pool);
+}
+
+// Textures that own their data, filtered in place
+template <typename T, unsigned Dim>
+inline void convert_for_bspline_interpol(texture<T, Dim>& tex, thread_pool& pool)
+{
+    convert_for_bspline_interpol(tex.data(), tex.size(), pool);
+}
+
+template <typename T, unsigned Dim>
+inline void convert_for_bspline_interpol(texture<T, Dim>& tex)
+{
+    thread_pool pool(std::max(1U, std::thread::hardware_concurrency()));
+    convert_for_bspline_interpol(tex, pool);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_PREFILTER_H
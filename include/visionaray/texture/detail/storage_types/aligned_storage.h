@@ -16,9 +16,11 @@
 #include "../../../aligned_vector.h"
 #include "../../../pixel_format.h"
 #include "../../../swizzle.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Simple linear storage type. Data is aligned to allow for SIMD access
@@ -76,7 +78,7 @@ public:
     template <typename U, typename I>
     U value(U /* */, I const& x, I const& y, I const& z) const
     {
-        return access(z * I(size()[0]) * I(size()[1]) + y * I(size()[0]) + x);
+        return access(U{}, z * I(size()[0]) * I(size()[1]) + y * I(size()[0]) + x);
     }
 
     void realloc(unsigned w)
@@ -152,6 +154,11 @@ public:
         reset(dst.data());
     }
 
+    value_type* data()
+    {
+        return data_.data();
+    }
+
     value_type const* data() const
     {
         return data_.data();
@@ -179,8 +186,8 @@ protected:
         return size[0] * size[1] * size_t(size[2]);
     }
 
-    template <typename U, typename I>
-    U access(U /* */, I const& index) const
+    template <typename U>
+    U access(U /* */, size_t index) const
     {
         return U(data_[index]);
     }
@@ -192,7 +199,7 @@ protected:
         >
     U access(U /* */, I const& index) const
     {
-        return U(gather(data_, index));
+        return U(gather(data_.data(), index));
     }
 
     aligned_vector<T, A> data_;
@@ -200,6 +207,7 @@ protected:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_ALIGNED_STORAGE_H
@@ -6,7 +6,6 @@
 #ifndef VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_ACCESSOR_H
 #define VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_ACCESSOR_H 1
 
-#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <type_traits>
@@ -17,93 +16,62 @@
 #include "../../../aligned_vector.h"
 #include "../../../pixel_format.h"
 #include "../../../swizzle.h"
+#include "bricked_layout.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
-// Simple linear storage type. Data is aligned to allow for SIMD access
+// View to user-managed memory that is already laid out in bricks, see bricked_layout
+// Defaults to 4^3 bricks in row-major order (w/o halos), the layout bricked_accessor
+// has always expected
 //
 
-template <typename T>
-class bricked_accessor
+template <
+    typename T,
+    unsigned BrickSize = 4,
+    unsigned Halo = 0,
+    brick_order::type Order = brick_order::RowMajor
+    >
+class bricked_accessor : public bricked_layout<BrickSize, Halo, Order>
 {
 public:
 
     using value_type = T;
-
-    static constexpr unsigned BW = 4;
-    static constexpr unsigned BH = 4;
-    static constexpr unsigned BD = 4;
+    using layout_type = bricked_layout<BrickSize, Halo, Order>;
 
 public:
 
     bricked_accessor() = default;
 
     explicit bricked_accessor(std::array<unsigned, 3> size)
-        : data_(nullptr)
-        , size_(size)
+        : layout_type(size)
     {
-        rounded_size_[0] = div_up(size_[0], BW) * BW;
-        rounded_size_[1] = div_up(size_[1], BH) * BH;
-        rounded_size_[2] = div_up(size_[2], BD) * BD;
-
-        num_bricks_[0] = div_up(size_[0], BW);
-        num_bricks_[1] = div_up(size_[1], BH);
-        num_bricks_[2] = div_up(size_[2], BD);
     }
 
     explicit bricked_accessor(T const* data, std::array<unsigned, 3> size)
-        : data_(data)
-        , size_(size)
+        : layout_type(size)
+        , data_(data)
     {
-        rounded_size_[0] = div_up(size_[0], BW) * BW;
-        rounded_size_[1] = div_up(size_[1], BH) * BH;
-        rounded_size_[2] = div_up(size_[2], BD) * BD;
-
-        num_bricks_[0] = div_up(size_[0], BW);
-        num_bricks_[1] = div_up(size_[1], BH);
-        num_bricks_[2] = div_up(size_[2], BD);
     }
 
     explicit bricked_accessor(unsigned w, unsigned h, unsigned d)
+        : layout_type(w, h, d)
     {
-        size_[0] = w;
-        size_[1] = h;
-        size_[2] = d;
-
-        rounded_size_[0] = div_up(size_[0], BW) * BW;
-        rounded_size_[1] = div_up(size_[1], BH) * BH;
-        rounded_size_[2] = div_up(size_[2], BD) * BD;
-
-        num_bricks_[0] = div_up(size_[0], BW);
-        num_bricks_[1] = div_up(size_[1], BH);
-        num_bricks_[2] = div_up(size_[2], BD);
     }
 
-    std::array<unsigned, 3> size() const
+    template <typename U, typename I>
+    U value(U /* */, I const& x, I const& y, I const& z) const
     {
-        return size_;
+        return access(U{}, layout_type::index(x, y, z));
     }
 
+    // Fetch by memory index, see bricked_layout::index()
     template <typename U, typename I>
-    U value(U /* */, I const& x, I const& y, I const& z) const
+    U fetch(U /* */, I const& index) const
     {
-        I bx = x / BW;
-        I by = y / BH;
-        I bz = z / BD;
-
-        I brick_id = bz * num_bricks_[0] * num_bricks_[1]
-                   + by * num_bricks_[0]
-                   + bx;
-        I brick_offset = brick_id * BW * BH * BD;
-
-        I ix = x % BW;
-        I iy = y % BH;
-        I iz = z % BD;
-
-        I index = brick_offset + iz * BW * BH + iy * BW + ix;
-
         return access(U{}, index);
     }
 
@@ -124,8 +92,8 @@ public:
 
 protected:
 
-    template <typename U, typename I>
-    U access(U /* */, I const& index) const
+    template <typename U>
+    U access(U /* */, size_t index) const
     {
         return U(data_[index]);
     }
@@ -141,12 +109,10 @@ protected:
     }
 
     T const* data_ = nullptr;
-    std::array<unsigned, 3> size_;
-    std::array<unsigned, 3> rounded_size_;
-    std::array<unsigned, 3> num_bricks_;
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_ACCESSOR_H
@@ -0,0 +1,294 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_LAYOUT_H
+#define VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_LAYOUT_H 1
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "../../../math/detail/math.h"
+#include "../../../math/simd/gather.h"
+#include "../../../math/simd/type_traits.h"
+#include "../../../detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Order of the bricks in memory
+//
+
+namespace brick_order
+{
+
+enum type
+{
+    RowMajor,   // Bricks in row-major order
+    Morton      // Morton order inside row-major super bricks
+};
+
+} // brick_order
+
+
+//-------------------------------------------------------------------------------------------------
+// Address computation for bricked 3D textures
+//
+// The texture is split into cubic bricks of BrickSize^3 texels (BrickSize must be a
+// power of two, texel to brick coordinates are computed with shifts and masks).
+// Each brick additionally stores a halo of Halo texels on all sides, copied from the
+// neighboring bricks (or clamped to the texture boundary). Filters that know the
+// halo width can address all texels of their footprint relative to a single base
+// index without leaving the brick: Halo >= 1 suffices for linear filtering,
+// Halo >= 2 for cubic filtering.
+//
+// With brick_order::Morton, bricks are grouped into super bricks of up to 8^3 bricks.
+// Super bricks are laid out in row-major order, bricks inside a super brick are laid
+// out in Morton order, so that spatially close bricks are also close in memory. With
+// brick_order::RowMajor, the bricks themselves are laid out in row-major order. Brick
+// offsets are looked up from three small per-axis tables (gathered for SIMD
+// coordinates).
+//
+// Memory indices are 64-bit for scalar coordinates. SIMD coordinates gather 32-bit
+// indices, so SIMD access requires storage_size() <= INT_MAX (simd_addressable()).
+//
+
+template <unsigned BrickSize, unsigned Halo, brick_order::type Order = brick_order::Morton>
+class bricked_layout
+{
+public:
+
+    static_assert(BrickSize > 0 && (BrickSize & (BrickSize - 1)) == 0, "Brick size must be a power of two");
+    static_assert(BrickSize <= 64, "Brick size too large");
+
+    static constexpr unsigned BW = BrickSize;
+    static constexpr unsigned BH = BrickSize;
+    static constexpr unsigned BD = BrickSize;
+
+    static constexpr unsigned brick_size = BrickSize;
+    static constexpr unsigned halo = Halo;
+    static constexpr brick_order::type order = Order;
+
+    // Size of a brick in memory, including the halo
+    static constexpr unsigned stride_x = 1;
+    static constexpr unsigned stride_y = BrickSize + 2 * Halo;
+    static constexpr unsigned stride_z = stride_y * stride_y;
+    static constexpr unsigned brick_volume = stride_z * stride_y;
+
+    // Type of the memory index for coordinates of type I
+    template <typename I>
+    using index_type = typename std::conditional<
+            simd::is_simd_vector<I>::value,
+            I,
+            typename std::conditional<std::is_signed<I>::value, ptrdiff_t, size_t>::type
+            >::type;
+
+public:
+
+    bricked_layout() = default;
+
+    explicit bricked_layout(std::array<unsigned, 3> size)
+    {
+        resize(size[0], size[1], size[2]);
+    }
+
+    explicit bricked_layout(unsigned w, unsigned h, unsigned d)
+    {
+        resize(w, h, d);
+    }
+
+    std::array<unsigned, 3> size() const
+    {
+        return size_;
+    }
+
+    // Number of texels (including halos and padding) the layout occupies in memory
+    size_t storage_size() const
+    {
+        return (size_t(num_super_[0]) * num_super_[1] * num_super_[2] << (3 * super_shift_)) * brick_volume;
+    }
+
+    // True if the layout can be addressed with 32-bit (SIMD) indices
+    bool simd_addressable() const
+    {
+        return storage_size() <= static_cast<size_t>(INT_MAX);
+    }
+
+    // Memory index of texel (x,y,z)
+    template <typename I>
+    index_type<I> index(I const& x, I const& y, I const& z) const
+    {
+        I mask(brick_mask());
+
+        return brick_offset(x >> brick_shift(), y >> brick_shift(), z >> brick_shift())
+             + index_type<I>(
+                    ((z & mask) + I(Halo)) * I(stride_z)
+                  + ((y & mask) + I(Halo)) * I(stride_y)
+                  + ((x & mask) + I(Halo))
+                    );
+    }
+
+    // Copy row-major texel data to bricked (and haloed) memory
+    template <typename T, typename U>
+    void brick(T* dst, U const* src) const
+    {
+        std::array<unsigned, 3> num_bricks = {{
+                div_up(size_[0], BrickSize),
+                div_up(size_[1], BrickSize),
+                div_up(size_[2], BrickSize)
+                }};
+
+        for (unsigned bz = 0; bz < num_bricks[2]; ++bz)
+        {
+            for (unsigned by = 0; by < num_bricks[1]; ++by)
+            {
+                for (unsigned bx = 0; bx < num_bricks[0]; ++bx)
+                {
+                    T* brick = dst + brick_offset(bx, by, bz);
+
+                    for (unsigned iz = 0; iz < stride_y; ++iz)
+                    {
+                        for (unsigned iy = 0; iy < stride_y; ++iy)
+                        {
+                            for (unsigned ix = 0; ix < stride_y; ++ix)
+                            {
+                                size_t x = clamp_texel(bx, ix, size_[0]);
+                                size_t y = clamp_texel(by, iy, size_[1]);
+                                size_t z = clamp_texel(bz, iz, size_[2]);
+
+                                brick[iz * stride_z + iy * stride_y + ix] = T(src[z * size_[0] * size_[1] + y * size_[0] + x]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+protected:
+
+    void resize(unsigned w, unsigned h, unsigned d)
+    {
+        size_[0] = w;
+        size_[1] = h;
+        size_[2] = d;
+
+        unsigned num_bricks[3] = {
+                div_up(w, BrickSize),
+                div_up(h, BrickSize),
+                div_up(d, BrickSize)
+                };
+
+        // Super bricks of 2^k bricks per dimension, with k chosen so that
+        // small textures are not padded excessively. Row-major bricks are
+        // super bricks of a single brick
+        unsigned min_bricks = std::min({ num_bricks[0], num_bricks[1], num_bricks[2] });
+
+        super_shift_ = 0;
+        while (Order == brick_order::Morton && super_shift_ < 3 && (2u << super_shift_) <= min_bricks)
+        {
+            ++super_shift_;
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            num_super_[i] = div_up(num_bricks[i], 1u << super_shift_);
+        }
+
+        // Brick offsets are separable: the row-major super brick index is a
+        // linear function of the super brick coordinates, and the Morton code
+        // of the brick inside its super brick interleaves disjoint bits
+        size_t super_stride[3] = { 1, num_super_[0], size_t(num_super_[0]) * num_super_[1] };
+        unsigned local_mask = (1u << super_shift_) - 1;
+
+        bool simd = simd_addressable();
+
+        for (int i = 0; i < 3; ++i)
+        {
+            brick_offsets_[i].resize(num_super_[i] << super_shift_);
+            simd_brick_offsets_[i].clear();
+
+            for (unsigned b = 0; b < brick_offsets_[i].size(); ++b)
+            {
+                size_t super_part = (size_t(b >> super_shift_) * super_stride[i]) << (3 * super_shift_);
+                size_t local_part = size_t(spread_bits(b & local_mask)) << i;
+                brick_offsets_[i][b] = (super_part + local_part) * brick_volume;
+            }
+
+            // 32-bit copy of the table for gathers
+            if (simd)
+            {
+                simd_brick_offsets_[i].assign(brick_offsets_[i].begin(), brick_offsets_[i].end());
+            }
+        }
+    }
+
+    // Memory offset of brick (bx,by,bz)
+    template <typename I>
+    index_type<I> brick_offset(I const& bx, I const& by, I const& bz) const
+    {
+        return lookup(0, bx) + lookup(1, by) + lookup(2, bz);
+    }
+
+    ptrdiff_t lookup(int axis, int i) const
+    {
+        return static_cast<ptrdiff_t>(brick_offsets_[axis][i]);
+    }
+
+    size_t lookup(int axis, unsigned i) const
+    {
+        return brick_offsets_[axis][i];
+    }
+
+    template <typename I>
+    I lookup(int axis, I const& i) const
+    {
+        assert(simd_addressable());
+        return gather(simd_brick_offsets_[axis].data(), i);
+    }
+
+    // Insert two zero bits between each of the three lower bits of v
+    template <typename I>
+    static I spread_bits(I const& v)
+    {
+        return (v & I(1)) | ((v & I(2)) << 2) | ((v & I(4)) << 4);
+    }
+
+    // Texel coordinate that halo/brick position i of brick b maps to, clamped to the texture
+    static size_t clamp_texel(unsigned b, unsigned i, unsigned size)
+    {
+        int t = static_cast<int>(b * BrickSize + i) - static_cast<int>(Halo);
+        return static_cast<size_t>(clamp(t, 0, static_cast<int>(size) - 1));
+    }
+
+    static constexpr int brick_shift()
+    {
+        return BrickSize ==  1 ? 0 : BrickSize ==  2 ? 1 : BrickSize ==  4 ? 2
+             : BrickSize ==  8 ? 3 : BrickSize == 16 ? 4 : BrickSize == 32 ? 5 : 6;
+    }
+
+    static constexpr int brick_mask()
+    {
+        return static_cast<int>(BrickSize) - 1;
+    }
+
+    std::array<unsigned, 3> size_ = {{ 0, 0, 0 }};
+    std::array<unsigned, 3> num_super_ = {{ 0, 0, 0 }};
+    unsigned super_shift_ = 0;
+    std::array<std::vector<size_t>, 3> brick_offsets_;
+    std::array<std::vector<int>, 3> simd_brick_offsets_;
+
+};
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#endif // VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_LAYOUT_H
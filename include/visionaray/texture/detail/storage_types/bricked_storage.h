@@ -6,7 +6,6 @@
 #ifndef VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_STORAGE_H
 #define VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_STORAGE_H 1
 
-#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <type_traits>
@@ -17,24 +16,25 @@
 #include "../../../aligned_vector.h"
 #include "../../../pixel_format.h"
 #include "../../../swizzle.h"
+#include "bricked_layout.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
-// Simple linear storage type. Data is aligned to allow for SIMD access
+// Bricked storage type, see bricked_layout for the memory layout. Data is aligned
+// to allow for SIMD access
 //
 
-template <typename T, size_t A = 16>
-class bricked_storage
+template <typename T, unsigned BrickSize = 4, unsigned Halo = 0, size_t A = 16>
+class bricked_storage : public bricked_layout<BrickSize, Halo>
 {
 public:
 
     using value_type = T;
-
-    static constexpr unsigned BW = 4;
-    static constexpr unsigned BH = 4;
-    static constexpr unsigned BD = 4;
+    using layout_type = bricked_layout<BrickSize, Halo>;
 
 public:
 
@@ -50,87 +50,29 @@ public:
         realloc(w, h, d);
     }
 
-    std::array<unsigned, 3> size() const
+    template <typename U, typename I>
+    U value(U /* */, I const& x, I const& y, I const& z) const
     {
-        return size_;
+        return access(U{}, layout_type::index(x, y, z));
     }
 
+    // Fetch by memory index, see bricked_layout::index()
     template <typename U, typename I>
-    U value(U /* */, I const& x, I const& y, I const& z) const
+    U fetch(U /* */, I const& index) const
     {
-        I bx = x / BW;
-        I by = y / BH;
-        I bz = z / BD;
-
-        I brick_id = bz * num_bricks_[0] * num_bricks_[1]
-                   + by * num_bricks_[0]
-                   + bx;
-        I brick_offset = brick_id * BW * BH * BD;
-
-        I ix = x % BW;
-        I iy = y % BH;
-        I iz = z % BD;
-
-        I index = brick_offset + iz * BW * BH + iy * BW + ix;
-
         return access(U{}, index);
     }
 
     void realloc(unsigned w, unsigned h, unsigned d)
     {
-        size_[0] = w;
-        size_[1] = h;
-        size_[2] = d;
-
-        rounded_size_[0] = div_up(size_[0], BW) * BW;
-        rounded_size_[1] = div_up(size_[1], BH) * BH;
-        rounded_size_[2] = div_up(size_[2], BD) * BD;
+        layout_type::resize(w, h, d);
 
-        num_bricks_[0] = div_up(size_[0], BW);
-        num_bricks_[1] = div_up(size_[1], BH);
-        num_bricks_[2] = div_up(size_[2], BD);
-
-        data_.resize(rounded_size_[0] * rounded_size_[1] * rounded_size_[2]);
+        data_.resize(layout_type::storage_size());
     }
 
     void reset(T const* data)
     {
-        for (unsigned bz = 0; bz < num_bricks_[2]; ++bz)
-        {
-            for (unsigned by = 0; by < num_bricks_[1]; ++by)
-            {
-                for (unsigned bx = 0; bx < num_bricks_[0]; ++bx)
-                {
-                    for (unsigned iz = 0; iz < BD; ++iz)
-                    {
-                        for (unsigned iy = 0; iy < BH; ++iy)
-                        {
-                            for (unsigned ix = 0; ix < BW; ++ix)
-                            {
-                                unsigned x = bx * BW + ix;
-                                unsigned y = by * BH + iy;
-                                unsigned z = bz * BD + iz;
-
-                                if (x >= size_[0] || y >= size_[1] || z >= size_[2])
-                                {
-                                    continue;
-                                }
-
-                                size_t brick_id = size_t(bz) * num_bricks_[0] * num_bricks_[1]
-                                                        + by * num_bricks_[0]
-                                                        + bx;
-                                size_t brick_offset = brick_id * BW * BH * BD;
-                                size_t dest_index = brick_offset + iz * BW * BH + iy * BW + ix;
-
-                                size_t source_index = size_t(z) * size_[0] * size_[1] + y * size_[0] + x;
-
-                                data_[dest_index] = data[source_index];
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        layout_type::brick(data_.data(), data);
     }
 
     void reset(
@@ -142,7 +84,7 @@ public:
         if (format != internal_format)
         {
             // Swizzle in-place
-            aligned_vector<T> tmp(data, data + data_.size());
+            aligned_vector<T> tmp(data, data + num_texels());
             swizzle(tmp.data(), internal_format, format, tmp.size());
             reset(tmp.data());
         }
@@ -161,7 +103,7 @@ public:
             )
     {
         // Copy to temporary array, then swizzle
-        aligned_vector<T> dst(data_.size());
+        aligned_vector<T> dst(num_texels());
         swizzle(dst.data(), internal_format, data, format, dst.size());
         reset(dst.data());
     }
@@ -175,7 +117,7 @@ public:
             )
     {
         // Copy with temporary array, hint about how to handle alpha
-        aligned_vector<T> dst(data_.size());
+        aligned_vector<T> dst(num_texels());
         swizzle(dst.data(), internal_format, data, format, dst.size(), hint);
         reset(dst.data());
     }
@@ -192,8 +134,14 @@ public:
 
 protected:
 
-    template <typename U, typename I>
-    U access(U /* */, I const& index) const
+    size_t num_texels() const
+    {
+        auto size = layout_type::size();
+        return size_t(size[0]) * size[1] * size[2];
+    }
+
+    template <typename U>
+    U access(U /* */, size_t index) const
     {
         return U(data_[index]);
     }
@@ -205,16 +153,14 @@ protected:
         >
     U access(U /* */, I const& index) const
     {
-        return U(gather(data_, index));
+        return U(gather(data_.data(), index));
     }
 
     aligned_vector<T, A> data_;
-    std::array<unsigned, 3> size_;
-    std::array<unsigned, 3> rounded_size_;
-    std::array<unsigned, 3> num_bricks_;
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_BRICKED_STORAGE_H
@@ -12,9 +12,11 @@
 
 #include "../../../math/simd/gather.h"
 #include "../../../math/simd/type_traits.h"
+#include "../../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Storage that is managed by the user; we only store a pointer and in addition know
@@ -170,6 +172,7 @@ protected:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_STORAGE_TYPES_POINTER_STORAGE_H
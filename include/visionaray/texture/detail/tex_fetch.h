@@ -12,10 +12,12 @@
 #include "filter/arithmetic_types.h"
 #include "filter.h"
 #include "texture_common.h"
+#include "../../detail/isa_namespace.h"
 
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 namespace detail
 {
 
@@ -197,6 +199,7 @@ inline auto tex_fetch_impl(Tex const& tex, vector<Tex::dimensions, FloatT> coord
 }
 
 } // detail
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_SAMPLER_H
@@ -17,9 +17,11 @@
 
 #include "storage_types/aligned_storage.h"
 #include "storage_types/pointer_storage.h"
+#include "../../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------------------------------
 //
@@ -312,6 +314,7 @@ inline vector<4, T> apply_color_conversion(vector<4, T> const& t, tex_color_spac
     }
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_DETAIL_TEXTURE_COMMON_H
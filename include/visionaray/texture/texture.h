@@ -16,9 +16,11 @@
 
 #include "detail/tex_fetch.h"
 #include "detail/texture_common.h"
+#include "../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 template <typename Tex, typename FloatT>
 inline auto tex1D(Tex const& tex, FloatT const& coord)
@@ -135,6 +137,7 @@ tex3D(cuda_texture_ref<T, 3> const& tex, vector<3, float> coord)
 
 #endif // __CUDACC__
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_H
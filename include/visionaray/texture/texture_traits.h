@@ -10,9 +10,11 @@
 #include <utility>
 
 #include "../math/vector.h"
+#include "../detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Traits for texture types
@@ -93,6 +95,7 @@ struct texture_dimensions<std::nullptr_t>
 //     enum { value = T::dimensions };
 // };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_TEXTURE_TEXTURE_TRAITS_H
@@ -7,9 +7,11 @@
 #define VSNRAY_THIN_LENS_CAMERA_H 1
 
 #include "pinhole_camera.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Thin lens camera class
@@ -39,6 +41,7 @@ private:
 
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #include "detail/thin_lens_camera.inl"
@@ -9,9 +9,11 @@
 #include "detail/macros.h"
 #include "math/aabb.h"
 #include "math/intersect.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // Utility functions that can be reimplemented for user-supplied hit records
@@ -126,6 +128,7 @@ struct is_closer_t
     }
 };
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_UPDATE_IF_H
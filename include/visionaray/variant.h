@@ -9,9 +9,11 @@
 #include <type_traits>
 
 #include "detail/macros.h"
+#include "detail/isa_namespace.h"
 
 namespace visionaray
 {
+VSNRAY_ISA_NAMESPACE_BEGIN
 
 //-------------------------------------------------------------------------------------------------
 // A most simple variant type that is compatible with CUDA
@@ -210,6 +212,7 @@ typename Visitor::return_type apply_visitor(Visitor const& visitor, variant<Ts..
     return apply_visitor_impl<sizeof...(Ts), Ts...>()(visitor, var);
 }
 
+VSNRAY_ISA_NAMESPACE_END
 } // visionaray
 
 #endif // VSNRAY_VARIANT_H
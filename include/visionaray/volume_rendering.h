@@ -0,0 +1,92 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_VOLUME_RENDERING_H
+#define VSNRAY_VOLUME_RENDERING_H 1
+
+#include "math/forward.h"
+#include "math/ray.h"
+#include "math/vector.h"
+#include "macrocell_grid.h"
+#include "detail/isa_namespace.h"
+
+namespace visionaray
+{
+VSNRAY_ISA_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------------------------------------------
+// Parameters for emission/absorption ray marching
+//
+
+struct ray_marching_params
+{
+    // Step size the transfer function opacities refer to
+    float reference_step = 0.01f;
+
+    // The step size is chosen per macrocell so that a sample at the cell's
+    // majorant contributes at most max_step_opacity, within [min_step..max_step]
+    float min_step = 0.0025f;
+    float max_step = 0.04f;
+    float max_step_opacity = 0.05f;
+
+    // Early ray termination threshold
+    float termination_opacity = 0.999f;
+
+    // Macrocells with majorant <= this value are skipped
+    float empty_threshold = 0.0f;
+
+    // Map voxel values in this range to transfer function coordinates [0..1]
+    vec2 value_range = vec2(0.0f, 1.0f);
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Optional per-ray counters
+//
+
+struct ray_marching_stats
+{
+    unsigned samples = 0;
+    unsigned cells_visited = 0;
+    unsigned cells_skipped = 0;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Front-to-back emission/absorption integration with post-classification
+//
+// The volume spans grid.bounds() and is sampled with tex3D(), the transfer function
+// is a 1D RGBA texture. Empty macrocells (majorant w.r.t. the transfer function is
+// zero, see macrocell_grid::compute_opacity_majorants()) are skipped with a 3D-DDA.
+// The ray segment inside each cell is divided into equal steps no longer than the
+// step size for the cell's majorant, and opacities are corrected for the actual
+// step length. Returns premultiplied RGBA.
+//
+
+template <typename Volume, typename Transfunc>
+vec4 integrate_emission_absorption(
+        basic_ray<float> const&     ray,
+        Volume const&               volume,
+        Transfunc const&            transfunc,
+        macrocell_grid const&       grid,
+        ray_marching_params const&  params,
+        ray_marching_stats&         stats
+        );
+
+template <typename Volume, typename Transfunc>
+vec4 integrate_emission_absorption(
+        basic_ray<float> const&     ray,
+        Volume const&               volume,
+        Transfunc const&            transfunc,
+        macrocell_grid const&       grid,
+        ray_marching_params const&  params = ray_marching_params()
+        );
+
+VSNRAY_ISA_NAMESPACE_END
+} // visionaray
+
+#include "detail/volume_rendering.inl"
+
+#endif // VSNRAY_VOLUME_RENDERING_H
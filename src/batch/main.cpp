@@ -0,0 +1,1340 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <common/config.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Support/CmdLine.h>
+#include <Support/CmdLineUtil.h>
+
+#include <visionaray/math/math.h>
+#include <visionaray/math/io.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+#include <visionaray/cpu_buffer_rt.h>
+#include <visionaray/generic_material.h>
+#include <visionaray/kernels.h>
+#include <visionaray/material.h>
+#include <visionaray/pinhole_camera.h>
+#include <visionaray/point_light.h>
+#include <visionaray/scheduler.h>
+#include <visionaray/swizzle.h>
+
+#include <common/image.h>
+#include <common/make_materials.h>
+#include <common/model.h>
+#include <common/remote/communicator.h>
+#include <common/remote/compositor.h>
+#include <common/remote/partition.h>
+#include <common/remote/render_server.h>
+#include <common/sg.h>
+#include <common/timer.h>
+
+using namespace support;
+using namespace visionaray;
+
+using generic_material_t = generic_material<
+        emissive<float>,
+        glass<float>,
+        matte<float>,
+        metal<float>,
+        mirror<float>,
+        plastic<float>
+        >;
+
+using triangle_t = basic_triangle<3, float>;
+using host_bvh_t = index_bvh<triangle_t>;
+using render_target_t = cpu_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED>;
+
+// Sort-last rendering composites by depth
+using sort_last_rt_t = cpu_buffer_rt<PF_RGBA32F, PF_DEPTH32F>;
+
+
+//-------------------------------------------------------------------------------------------------
+// Command line parameters
+//
+
+enum algorithm { Simple, Whitted, Pathtracing };
+
+enum bvh_build_strategy
+{
+    Binned = 0, // Binned SAH builder, no spatial splits
+    Split,      // Split BVH, also binned and with SAH
+    LBVH        // LBVH builder on the CPU
+};
+
+struct batch_params
+{
+    std::vector<std::string>    filenames;
+    std::string                 camera_path;
+    std::string                 output;
+    int                         width           = 512;
+    int                         height          = 512;
+    algorithm                   algo            = Simple;
+    bvh_build_strategy          build_strategy  = Binned;
+    unsigned                    spp             = 1;
+    unsigned                    spp_target      = 0;
+    unsigned                    frames          = 1;
+    unsigned                    bounces         = 4;
+    unsigned                    num_threads     = std::thread::hardware_concurrency();
+    vec3                        bgcolor         = { 0.1f, 0.4f, 1.0f };
+    unsigned short              server_port     = 0;
+    int                         max_image_size  = 8192;
+    unsigned                    num_ranks       = 1;
+    unsigned                    rank            = 0;
+    std::string                 hosts           = "localhost";
+    unsigned short              base_port       = 31100;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Structured output, one JSON object per line so that results can be diffed and
+// processed with standard tools
+//
+
+class json_line
+{
+public:
+
+    explicit json_line(std::string const& event)
+    {
+        out_ << std::setprecision(6) << "{\"event\":" << quote(event);
+    }
+
+    json_line& operator()(std::string const& key, std::string const& value)
+    {
+        out_ << ',' << quote(key) << ':' << quote(value);
+        return *this;
+    }
+
+    template <typename T>
+    json_line& operator()(std::string const& key, T const& value)
+    {
+        out_ << ',' << quote(key) << ':' << value;
+        return *this;
+    }
+
+   ~json_line()
+    {
+        std::cout << out_.str() << "}\n" << std::flush;
+    }
+
+private:
+
+    std::ostringstream out_;
+
+    static std::string quote(std::string const& str)
+    {
+        std::string result = "\"";
+
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                result += '\\';
+            }
+
+            result += c;
+        }
+
+        return result + '"';
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Map scene graph materials to generic materials
+//
+
+generic_material_t map_material(sg::obj_material const& mat)
+{
+    // Add emissive material if emissive component > 0
+    if (length(mat.ce) > 0.0f)
+    {
+        emissive<float> em;
+        em.ce() = from_rgb(mat.ce);
+        em.ls() = 1.0f;
+        return em;
+    }
+    else if (mat.illum == 1)
+    {
+        matte<float> ma;
+        ma.ca() = from_rgb(mat.ca);
+        ma.cd() = from_rgb(mat.cd);
+        ma.ka() = 1.0f;
+        ma.kd() = 1.0f;
+        return ma;
+    }
+    else if (mat.illum == 3)
+    {
+        mirror<float> mi;
+        mi.cr() = from_rgb(mat.cs);
+        mi.kr() = 1.0f;
+        mi.ior() = spectrum<float>(0.0f);
+        mi.absorption() = spectrum<float>(0.0f);
+        return mi;
+    }
+    else if (mat.illum == 4 && mat.transmission > 0.0f)
+    {
+        glass<float> gl;
+        gl.ct() = from_rgb(mat.cd);
+        gl.kt() = 1.0f;
+        gl.cr() = from_rgb(mat.cs);
+        gl.kr() = 1.0f;
+        gl.ior() = from_rgb(mat.ior);
+        return gl;
+    }
+    else
+    {
+        plastic<float> pl;
+        pl.ca() = from_rgb(mat.ca);
+        pl.cd() = from_rgb(mat.cd);
+        pl.cs() = from_rgb(mat.cs);
+        pl.ka() = 1.0f;
+        pl.kd() = 1.0f;
+        pl.ks() = 1.0f;
+        pl.specular_exp() = mat.specular_exp;
+        return pl;
+    }
+}
+
+generic_material_t map_material(std::shared_ptr<sg::material> const& mat)
+{
+    if (auto obj = std::dynamic_pointer_cast<sg::obj_material>(mat))
+    {
+        return map_material(*obj);
+    }
+    else if (auto disney = std::dynamic_pointer_cast<sg::disney_material>(mat))
+    {
+        matte<float> ma;
+        ma.ca() = from_rgb(vec3(0.0f));
+        ma.cd() = from_rgb(disney->base_color.xyz());
+        ma.ka() = 1.0f;
+        ma.kd() = 1.0f;
+        return ma;
+    }
+    else if (auto mt = std::dynamic_pointer_cast<sg::metal_material>(mat))
+    {
+        metal<float> result;
+        result.roughness() = mt->roughness;
+        result.absorption() = from_rgb(mt->absorption);
+        result.ior() = from_rgb(mt->ior);
+        return result;
+    }
+    else if (auto gl = std::dynamic_pointer_cast<sg::glass_material>(mat))
+    {
+        glass<float> result;
+        result.ct() = from_rgb(gl->ct);
+        result.kt() = 1.0f;
+        result.cr() = from_rgb(gl->cr);
+        result.kr() = 1.0f;
+        result.ior() = from_rgb(gl->ior);
+        return result;
+    }
+
+    return map_material(sg::obj_material{});
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Flatten the scene graph into a single list of world space triangles
+//
+// Instances are expanded, so the scene can be rendered with a single BVH. Spheres
+// and textures are ignored.
+//
+
+struct flatten_visitor : sg::node_visitor
+{
+    using node_visitor::apply;
+
+    flatten_visitor(
+            aligned_vector<triangle_t>&         triangles,
+            aligned_vector<vec3>&               geometric_normals,
+            aligned_vector<generic_material_t>& materials
+            )
+        : triangles_(triangles)
+        , geometric_normals_(geometric_normals)
+        , materials_(materials)
+    {
+    }
+
+    void apply(sg::transform& t)
+    {
+        mat4 prev = current_transform_;
+
+        current_transform_ = current_transform_ * t.matrix();
+
+        node_visitor::apply(t);
+
+        current_transform_ = prev;
+    }
+
+    void apply(sg::surface_properties& sp)
+    {
+        unsigned prev = current_geom_id_;
+
+        if (sp.material())
+        {
+            auto it = std::find(surfaces_.begin(), surfaces_.end(), sp.material());
+
+            if (it == surfaces_.end())
+            {
+                current_geom_id_ = static_cast<unsigned>(surfaces_.size());
+                surfaces_.push_back(sp.material());
+                materials_.push_back(map_material(sp.material()));
+            }
+            else
+            {
+                current_geom_id_ = static_cast<unsigned>(std::distance(surfaces_.begin(), it));
+            }
+        }
+
+        node_visitor::apply(sp);
+
+        current_geom_id_ = prev;
+    }
+
+    void apply(sg::triangle_mesh& tm)
+    {
+        for (size_t i = 0; i + 2 < tm.vertices.size(); i += 3)
+        {
+            add_triangle(tm.vertices[i], tm.vertices[i + 1], tm.vertices[i + 2]);
+        }
+
+        node_visitor::apply(tm);
+    }
+
+    void apply(sg::indexed_triangle_mesh& itm)
+    {
+        auto const& vertices = *itm.vertices;
+
+        for (size_t i = 0; i + 2 < itm.vertex_indices.size(); i += 3)
+        {
+            add_triangle(
+                    vertices[itm.vertex_indices[i]],
+                    vertices[itm.vertex_indices[i + 1]],
+                    vertices[itm.vertex_indices[i + 2]]
+                    );
+        }
+
+        node_visitor::apply(itm);
+    }
+
+    void add_triangle(vec3 v1, vec3 v2, vec3 v3)
+    {
+        v1 = (current_transform_ * vec4(v1, 1.0f)).xyz();
+        v2 = (current_transform_ * vec4(v2, 1.0f)).xyz();
+        v3 = (current_transform_ * vec4(v3, 1.0f)).xyz();
+
+        triangle_t tri(v1, v2 - v1, v3 - v1);
+        tri.prim_id = static_cast<unsigned>(triangles_.size());
+        tri.geom_id = current_geom_id_;
+        triangles_.push_back(tri);
+
+        geometric_normals_.push_back(normalize(cross(v2 - v1, v3 - v1)));
+    }
+
+    aligned_vector<triangle_t>&             triangles_;
+    aligned_vector<vec3>&                   geometric_normals_;
+    aligned_vector<generic_material_t>&     materials_;
+
+    std::vector<std::shared_ptr<sg::material>> surfaces_;
+
+    mat4 current_transform_ = mat4::identity();
+
+    unsigned current_geom_id_ = 0;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Load the camera path
+//
+// The file contains a sequence of (eye, center, up) triples, the same format that
+// vsnray-viewer uses to store its camera. Each triple is one camera position.
+//
+
+bool load_camera_path(std::string const& filename, std::vector<pinhole_camera>& path, pinhole_camera const& proto)
+{
+    std::ifstream file(filename);
+
+    if (!file.good())
+    {
+        return false;
+    }
+
+    file >> std::ws;
+
+    while (file.good() && !file.eof())
+    {
+        vec3 eye;
+        vec3 center;
+        vec3 up;
+
+        file >> eye >> std::ws >> center >> std::ws >> up >> std::ws;
+
+        if (file.fail())
+        {
+            return false;
+        }
+
+        pinhole_camera cam = proto;
+        cam.look_at(eye, center, up);
+        path.push_back(cam);
+    }
+
+    return !path.empty();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Write the color buffer to file, the format is determined from the file name suffix
+//
+
+template <typename RT>
+bool write_image(RT const& rt, std::string const& filename)
+{
+    int w = rt.width();
+    int h = rt.height();
+
+    bool exr = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".exr") == 0;
+
+    image::save_options options;
+
+    if (exr)
+    {
+        // Flip so that origin is (top|left)
+        std::vector<vec4> flipped(w * h);
+
+        for (int y = 0; y < h; ++y)
+        {
+            std::copy(rt.color() + y * w, rt.color() + (y + 1) * w, flipped.data() + (h - y - 1) * w);
+        }
+
+        image img(w, h, PF_RGBA32F, reinterpret_cast<uint8_t const*>(flipped.data()));
+        return img.save(filename, options);
+    }
+    else
+    {
+        // Swizzle to RGB8 for compatibility with pnm image
+        std::vector<vector<3, unorm<8>>> rgb(w * h);
+        swizzle(rgb.data(), PF_RGB8, rt.color(), PF_RGBA32F, w * h, TruncateAlpha);
+
+        std::vector<vector<3, unorm<8>>> flipped(w * h);
+
+        for (int y = 0; y < h; ++y)
+        {
+            std::copy(rgb.data() + y * w, rgb.data() + (y + 1) * w, flipped.data() + (h - y - 1) * w);
+        }
+
+        options.emplace_back("binary", true);
+
+        image img(w, h, PF_RGB8, reinterpret_cast<uint8_t const*>(flipped.data()));
+        return img.save(filename, options);
+    }
+}
+
+std::string image_filename(std::string const& output, size_t index)
+{
+    auto dot = output.rfind('.');
+    std::string base = dot == std::string::npos ? output : output.substr(0, dot);
+    std::string suffix = dot == std::string::npos ? ".pnm" : output.substr(dot);
+
+    std::ostringstream str;
+    str << base << '-' << std::setw(4) << std::setfill('0') << index << suffix;
+    return str.str();
+}
+
+
+template <typename RT>
+bool save_image(batch_params const& params, RT const& rt, size_t camera_index)
+{
+    if (params.output.empty())
+    {
+        return true;
+    }
+
+    auto filename = image_filename(params.output, camera_index);
+
+    if (!write_image(rt, filename))
+    {
+        std::cerr << "Failed writing image: " << filename << '\n';
+        return false;
+    }
+
+    json_line("image")
+        ("camera", camera_index)
+        ("filename", filename);
+
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Parse command line
+//
+
+void parse_cmd_line(int argc, char** argv, batch_params& params)
+{
+    cl::CmdLine cmd;
+
+    std::vector<std::shared_ptr<cl::OptionBase>> options;
+
+    options.emplace_back( cl::makeOption<std::vector<std::string>&>(
+        cl::Parser<>(),
+        "filenames",
+        cl::Desc("Input files in any format supported by the model loader"),
+        cl::Positional,
+        cl::OneOrMore,
+        cl::init(params.filenames)
+        ) );
+
+    options.emplace_back( cl::makeOption<std::string&>(
+        cl::Parser<>(),
+        "camera",
+        cl::Desc("Text file with a sequence of cameras (eye, center, up)"),
+        cl::ArgRequired,
+        cl::init(params.camera_path)
+        ) );
+
+    options.emplace_back( cl::makeOption<std::string&>(
+        cl::Parser<>(),
+        "o",
+        cl::Desc("Output file name, the suffix (.png, .pnm, .exr) determines the format"),
+        cl::ArgRequired,
+        cl::init(params.output)
+        ) );
+
+    options.emplace_back( cl::makeOption<int&>(
+        cl::Parser<>(),
+        "width",
+        cl::Desc("Image width"),
+        cl::ArgRequired,
+        cl::init(params.width)
+        ) );
+
+    options.emplace_back( cl::makeOption<int&>(
+        cl::Parser<>(),
+        "height",
+        cl::Desc("Image height"),
+        cl::ArgRequired,
+        cl::init(params.height)
+        ) );
+
+    options.emplace_back( cl::makeOption<algorithm&>({
+            { "simple",             Simple,         "Simple ray casting kernel" },
+            { "whitted",            Whitted,        "Whitted style ray tracing kernel" },
+            { "pathtracing",        Pathtracing,    "Pathtracing global illumination kernel" }
+        },
+        "algorithm",
+        cl::Desc("Rendering algorithm"),
+        cl::ArgRequired,
+        cl::init(params.algo)
+        ) );
+
+    options.emplace_back( cl::makeOption<bvh_build_strategy&>({
+            { "default",            Binned,         "Binned SAH" },
+            { "split",              Split,          "Binned SAH with spatial splits" },
+            { "lbvh",               LBVH,           "LBVH (CPU)" }
+        },
+        "bvh",
+        cl::Desc("BVH build strategy"),
+        cl::ArgRequired,
+        cl::init(params.build_strategy)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned&>(
+        cl::Parser<>(),
+        "spp",
+        cl::Desc("Samples per pixel and frame (SSAA factor 1, 2, 4 or 8 for simple and whitted)"),
+        cl::ArgRequired,
+        cl::init(params.spp)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned&>(
+        cl::Parser<>(),
+        "spp-target",
+        cl::Desc("Render frames until this many samples per pixel were accumulated (overrides -frames)"),
+        cl::ArgRequired,
+        cl::init(params.spp_target)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned&>(
+        cl::Parser<>(),
+        "frames",
+        cl::Desc("Number of frames per camera"),
+        cl::ArgRequired,
+        cl::init(params.frames)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned&>(
+        cl::Parser<>(),
+        "bounces",
+        cl::Desc("Number of bounces for recursive ray tracing"),
+        cl::ArgRequired,
+        cl::init(params.bounces)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned&>(
+        cl::Parser<>(),
+        "threads",
+        cl::Desc("Number of render threads"),
+        cl::ArgRequired,
+        cl::init(params.num_threads)
+        ) );
+
+    options.emplace_back( cl::makeOption<vec3&, cl::ScalarType>(
+        [&](StringRef name, StringRef /*arg*/, vec3& value)
+        {
+            cl::Parser<>()(name + "-r", cmd.bump(), value.x);
+            cl::Parser<>()(name + "-g", cmd.bump(), value.y);
+            cl::Parser<>()(name + "-b", cmd.bump(), value.z);
+        },
+        "bgcolor",
+        cl::Desc("Background color"),
+        cl::ArgDisallowed,
+        cl::init(params.bgcolor)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned short&>(
+        cl::Parser<>(),
+        "server",
+        cl::Desc("Don't write images, serve frames to remote viewers on this port instead"),
+        cl::ArgRequired,
+        cl::init(params.server_port)
+        ) );
+
+    options.emplace_back( cl::makeOption<int&>(
+        cl::Parser<>(),
+        "max-size",
+        cl::Desc("Server mode: largest image width and height remote viewers may request"),
+        cl::ArgRequired,
+        cl::init(params.max_image_size)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned&>(
+        cl::Parser<>(),
+        "ranks",
+        cl::Desc("Sort-last rendering: number of processes, each renders a part of the scene"),
+        cl::ArgRequired,
+        cl::init(params.num_ranks)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned&>(
+        cl::Parser<>(),
+        "rank",
+        cl::Desc("Sort-last rendering: rank of this process (0..ranks-1), rank 0 writes the images"),
+        cl::ArgRequired,
+        cl::init(params.rank)
+        ) );
+
+    options.emplace_back( cl::makeOption<std::string&>(
+        cl::Parser<>(),
+        "hosts",
+        cl::Desc("Sort-last rendering: comma separated list with the host of each rank, or a single host"),
+        cl::ArgRequired,
+        cl::init(params.hosts)
+        ) );
+
+    options.emplace_back( cl::makeOption<unsigned short&>(
+        cl::Parser<>(),
+        "base-port",
+        cl::Desc("Sort-last rendering: rank r listens on base-port + r"),
+        cl::ArgRequired,
+        cl::init(params.base_port)
+        ) );
+
+    for (auto& opt : options)
+    {
+        cmd.add(*opt);
+    }
+
+    try
+    {
+        auto args = std::vector<std::string>(argv + 1, argv + argc);
+        cl::expandWildcards(args);
+        cl::expandResponseFiles(args, cl::TokenizeUnix());
+
+        cmd.parse(args, false);
+    }
+    catch (...)
+    {
+        std::cout << cmd.help(argv[0]) << '\n';
+        throw;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Build the BVH with the selected strategy
+//
+
+host_bvh_t build_bvh(batch_params const& params, aligned_vector<triangle_t>& triangles)
+{
+    if (params.build_strategy == LBVH)
+    {
+        lbvh_builder builder;
+
+        return builder.build(host_bvh_t{}, triangles.data(), triangles.size());
+    }
+    else
+    {
+        binned_sah_builder builder;
+        builder.enable_spatial_splits(params.build_strategy == Split);
+
+        return builder.build(host_bvh_t{}, triangles.data(), triangles.size());
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Sort-last: union of the scene bounds of all ranks
+//
+
+bool exchange_bounds(remote::communicator& comm, aabb& bounds)
+{
+    // Communicator tag, the compositor uses tags below 16
+    enum { BoundsTag = 16 };
+
+    std::vector<char> data(sizeof(aabb));
+    std::memcpy(data.data(), &bounds, sizeof(aabb));
+
+    for (int r = 0; r < comm.size(); ++r)
+    {
+        if (r != comm.rank())
+        {
+            comm.send(r, BoundsTag, data);
+        }
+    }
+
+    aabb result = bounds;
+
+    for (int r = 0; r < comm.size(); ++r)
+    {
+        if (r == comm.rank())
+        {
+            continue;
+        }
+
+        if (!comm.receive(r, BoundsTag, data, 60.0) || data.size() != sizeof(aabb))
+        {
+            return false;
+        }
+
+        aabb other;
+        std::memcpy(&other, data.data(), sizeof(aabb));
+        result.insert(other);
+    }
+
+    bounds = result;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Number of frames rendered (and accumulated when pathtracing) per camera
+//
+
+unsigned frames_per_camera(batch_params const& params)
+{
+    if (params.spp_target > 0)
+    {
+        return div_up(params.spp_target, max(params.spp, 1U));
+    }
+
+    return params.frames;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Headlight, same as vsnray-viewer
+//
+
+aligned_vector<point_light<float>> make_headlight(vec3 const& eye)
+{
+    aligned_vector<point_light<float>> lights(1);
+    lights[0].set_cl(vec3(1.0f));
+    lights[0].set_kl(1.0f);
+    lights[0].set_position(eye);
+    lights[0].set_constant_attenuation(1.0f);
+    lights[0].set_linear_attenuation(0.0f);
+    lights[0].set_quadratic_attenuation(0.0f);
+    return lights;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Kernel parameters for the flattened scene
+//
+
+template <typename Primitives, typename Lights>
+auto make_kparams(
+        batch_params const&                         params,
+        Primitives const&                           primitives,
+        aligned_vector<vec3> const&                 geometric_normals,
+        aligned_vector<generic_material_t> const&   materials,
+        Lights const&                               lights,
+        float                                       epsilon
+        )
+{
+    return make_kernel_params(
+            normals_per_face_binding{},
+            primitives.data(),
+            primitives.data() + primitives.size(),
+            geometric_normals.data(),
+            geometric_normals.data(),
+            materials.data(),
+            lights.data(),
+            lights.data() + lights.size(),
+            params.bounces,
+            epsilon,
+            vec4(params.bgcolor, 1.0f),
+            vec4(0.0f)
+            );
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Render one frame with the selected algorithm, camera and render target are
+// passed on to make_sched_params()
+//
+// Pathtracing blends with the previous frames, frame_num counts the frames
+// accumulated so far
+//
+
+template <typename Sched, typename KParams, typename ...Args>
+void render_frame(
+        batch_params const&     params,
+        Sched&                  sched,
+        KParams const&          kparams,
+        unsigned&               frame_num,
+        Args&&...               args
+        )
+{
+    switch (params.algo)
+    {
+    case Simple:
+    {
+        pixel_sampler::uniform_type ups;
+        ups.ssaa_factor = params.spp;
+        sched.frame(simple::kernel<KParams>({kparams}), make_sched_params(ups, std::forward<Args>(args)...));
+        break;
+    }
+    case Whitted:
+    {
+        pixel_sampler::uniform_type ups;
+        ups.ssaa_factor = params.spp;
+        sched.frame(whitted::kernel<KParams>({kparams}), make_sched_params(ups, std::forward<Args>(args)...));
+        break;
+    }
+    case Pathtracing:
+    {
+        float alpha = 1.0f / ++frame_num;
+        pixel_sampler::jittered_blend_type jps;
+        jps.spp = params.spp;
+        jps.sfactor = alpha;
+        jps.dfactor = 1.0f - alpha;
+        sched.frame(pathtracing::kernel<KParams>({kparams}), make_sched_params(jps, std::forward<Args>(args)...));
+        break;
+    }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Render all frames for one camera, returns the number of primary rays traced
+//
+// Throughput is reported in primary rays (width * height * spp) per second.
+// Camera and render target are passed on to render_frame().
+//
+
+template <typename Sched, typename KParams, typename ...Args>
+double render_frames(
+        batch_params const&     params,
+        Sched&                  sched,
+        KParams const&          kparams,
+        size_t                  camera_index,
+        double&                 total_seconds,
+        Args&...                args
+        )
+{
+    unsigned num_frames = frames_per_camera(params);
+
+    double rays_per_frame = double(params.width) * params.height * params.spp;
+    double total_rays = 0.0;
+
+    unsigned frame_num = 0;
+
+    for (unsigned f = 0; f < num_frames; ++f)
+    {
+        timer t;
+
+        render_frame(params, sched, kparams, frame_num, args...);
+
+        double seconds = t.elapsed();
+
+        total_seconds += seconds;
+        total_rays += rays_per_frame;
+
+        json_line("frame")
+            ("camera", camera_index)
+            ("frame", f)
+            ("spp", (f + 1) * params.spp)
+            ("seconds", seconds)
+            ("mrays_per_second", rays_per_frame / seconds / 1e6);
+    }
+
+    return total_rays;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Server mode: render with the cameras sent by remote viewers (cf. common/remote)
+//
+// Pathtracing refines progressively until frames_per_camera() frames were
+// accumulated or the camera changes. Statistics are reported every few seconds.
+//
+
+template <typename Sched, typename Primitives>
+void serve(
+        batch_params const&                         params,
+        Sched&                                      sched,
+        Primitives const&                           primitives,
+        aligned_vector<vec3> const&                 geometric_normals,
+        aligned_vector<generic_material_t> const&   materials,
+        float                                       epsilon
+        )
+{
+    render_target_t rt;
+    unsigned frame_num = 0;
+    unsigned num_frames = frames_per_camera(params);
+
+    // The server ignores cameras with an empty viewport or one larger than max_image_size
+    auto render = [&](remote::camera_update const& cam, bool camera_changed, remote::render_server::pixel_type* pixels)
+    {
+        if (camera_changed || rt.width() != cam.width || rt.height() != cam.height)
+        {
+            rt.resize(cam.width, cam.height);
+            rt.clear_color_buffer();
+            frame_num = 0;
+        }
+
+        auto eye = inverse(cam.view) * vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        auto lights = make_headlight(eye.xyz() / eye.w);
+
+        auto kparams = make_kparams(params, primitives, geometric_normals, materials, lights, epsilon);
+
+        render_frame(params, sched, kparams, frame_num, cam.view, cam.proj, rt);
+
+        swizzle(pixels, PF_RGBA8, rt.color(), PF_RGBA32F, static_cast<size_t>(cam.width) * cam.height);
+
+        return params.algo == Pathtracing && frame_num < num_frames;
+    };
+
+    remote::render_server server(params.server_port, render);
+    server.set_max_image_size(params.max_image_size);
+    server.start();
+
+    json_line("server")
+        ("port", server.port())
+        ("max_image_size", server.max_image_size());
+
+    unsigned frames_sent = 0;
+
+    for (;;)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(5));
+
+        auto stats = server.stats();
+
+        if (stats.frames_sent == frames_sent)
+        {
+            continue;
+        }
+
+        frames_sent = stats.frames_sent;
+
+        json_line("server_stats")
+            ("frames", stats.frames_sent)
+            ("bytes", stats.bytes_sent)
+            ("render_seconds", stats.render.average())
+            ("encode_seconds", stats.encode.average())
+            ("send_seconds", stats.send.average())
+            ("latency_seconds", stats.latency.average())
+            ("max_latency_seconds", stats.latency.max)
+            ("cameras_rejected", stats.cameras_rejected);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+
+int main(int argc, char** argv)
+{
+    batch_params params;
+
+    try
+    {
+        parse_cmd_line(argc, argv, params);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (params.width <= 0 || params.height <= 0 || params.max_image_size <= 0 || params.spp == 0)
+    {
+        std::cerr << "Invalid image size or sample count\n";
+        return EXIT_FAILURE;
+    }
+
+    if (params.rank >= params.num_ranks || (params.num_ranks > 1 && params.server_port != 0))
+    {
+        std::cerr << "Invalid rank, or sort-last rendering combined with server mode\n";
+        return EXIT_FAILURE;
+    }
+
+    // Secondary rays would only see this rank's partition
+    if (params.num_ranks > 1 && params.algo != Simple)
+    {
+        std::cerr << "Sort-last rendering only supports -algorithm=simple\n";
+        return EXIT_FAILURE;
+    }
+
+
+    // Sort-last: connect to the other ranks ------------------
+
+    std::unique_ptr<remote::communicator> comm;
+
+    if (params.num_ranks > 1)
+    {
+        std::vector<std::string> hosts;
+        std::istringstream str(params.hosts);
+
+        for (std::string host; std::getline(str, host, ','); )
+        {
+            hosts.push_back(host);
+        }
+
+        if (hosts.size() != 1 && hosts.size() != params.num_ranks)
+        {
+            std::cerr << "Number of hosts does not match number of ranks\n";
+            return EXIT_FAILURE;
+        }
+
+        timer connect_timer;
+
+        comm.reset(new remote::communicator(params.rank, params.num_ranks, hosts, params.base_port));
+
+        if (!comm->connect(60.0))
+        {
+            std::cerr << "Failed connecting to the other ranks\n";
+            return EXIT_FAILURE;
+        }
+
+        json_line("connect")
+            ("rank", params.rank)
+            ("ranks", params.num_ranks)
+            ("seconds", connect_timer.elapsed());
+    }
+
+
+    // Load ---------------------------------------------------
+
+    // Sort-last: with at least as many files as ranks, each rank only loads
+    // its share of the files; otherwise each rank loads the whole model and
+    // keeps a spatial partition of the triangles before building the BVH
+    bool distribute_files = comm != nullptr && params.filenames.size() >= params.num_ranks;
+
+    std::vector<std::string> filenames;
+
+    for (size_t i = 0; i < params.filenames.size(); ++i)
+    {
+        if (!distribute_files || i % params.num_ranks == params.rank)
+        {
+            filenames.push_back(params.filenames[i]);
+        }
+    }
+
+    aligned_vector<triangle_t> triangles;
+    aligned_vector<vec3> geometric_normals;
+    aligned_vector<generic_material_t> materials;
+
+    timer load_timer;
+
+    {
+        // Released at the end of this block, only the flattened triangles are kept
+        model mod;
+
+        if (!mod.load(filenames))
+        {
+            std::cerr << "Failed loading model\n";
+            return EXIT_FAILURE;
+        }
+
+        if (mod.scene_graph == nullptr)
+        {
+            triangles.swap(mod.primitives);
+            geometric_normals.swap(mod.geometric_normals);
+
+            materials = make_materials(
+                    generic_material_t{},
+                    mod.materials,
+                    [](aligned_vector<generic_material_t>& cont, model::material_type mat)
+                    {
+                        cont.emplace_back(map_material(mat));
+                    }
+                    );
+        }
+        else
+        {
+            flatten_visitor visitor(triangles, geometric_normals, materials);
+            mod.scene_graph->accept(visitor);
+        }
+    }
+
+    if (materials.empty())
+    {
+        materials.push_back(map_material(sg::obj_material{}));
+    }
+
+    // Surfaces without material use the first one
+    for (auto& tri : triangles)
+    {
+        if (tri.geom_id >= materials.size())
+        {
+            tri.geom_id = 0;
+        }
+    }
+
+    json_line("load")
+        ("files", filenames.size())
+        ("triangles", triangles.size())
+        ("materials", materials.size())
+        ("seconds", load_timer.elapsed());
+
+
+    // Sort-last: keep only this rank's spatial partition -----
+
+    if (comm != nullptr && !distribute_files)
+    {
+        timer partition_timer;
+
+        auto parts = remote::partition_primitives(triangles.begin(), triangles.end(), params.num_ranks);
+
+        aligned_vector<triangle_t> part_triangles;
+        aligned_vector<vec3> part_normals;
+
+        part_triangles.reserve(parts[params.rank].size());
+        part_normals.reserve(parts[params.rank].size());
+
+        for (auto index : parts[params.rank])
+        {
+            auto tri = triangles[index];
+            part_normals.push_back(geometric_normals[tri.prim_id]);
+            tri.prim_id = static_cast<unsigned>(part_triangles.size());
+            part_triangles.push_back(tri);
+        }
+
+        // Release the rest of the scene
+        triangles.swap(part_triangles);
+        geometric_normals.swap(part_normals);
+        part_triangles = {};
+        part_normals = {};
+
+        json_line("partition")
+            ("rank", params.rank)
+            ("triangles", triangles.size())
+            ("seconds", partition_timer.elapsed());
+    }
+
+    if (triangles.empty() && comm == nullptr)
+    {
+        std::cerr << "No triangles to render\n";
+        return EXIT_FAILURE;
+    }
+
+
+    // BVH ----------------------------------------------------
+
+    timer bvh_timer;
+
+    host_bvh_t bvh = triangles.empty() ? host_bvh_t{} : build_bvh(params, triangles);
+
+    json_line("bvh")
+        ("builder", std::string(params.build_strategy == LBVH ? "lbvh" : params.build_strategy == Split ? "split" : "sah"))
+        ("nodes", bvh.num_nodes())
+        ("seconds", bvh_timer.elapsed());
+
+    aabb scene_bounds;
+    scene_bounds.invalidate();
+
+    if (bvh.num_nodes() > 0)
+    {
+        scene_bounds = bvh.node(0).get_bounds();
+    }
+
+    // Sort-last: all ranks use the cameras of the whole scene
+    if (comm != nullptr && !exchange_bounds(*comm, scene_bounds))
+    {
+        std::cerr << "Failed exchanging the scene bounds with the other ranks\n";
+        return EXIT_FAILURE;
+    }
+
+    if (scene_bounds.invalid())
+    {
+        std::cerr << "No triangles to render\n";
+        return EXIT_FAILURE;
+    }
+
+
+    // Cameras ------------------------------------------------
+
+    pinhole_camera proto;
+    proto.perspective(
+            45.0f * constants::degrees_to_radians<float>(),
+            params.width / static_cast<float>(params.height),
+            0.001f,
+            1000.0f
+            );
+    proto.set_viewport(0, 0, params.width, params.height);
+
+    std::vector<pinhole_camera> cameras;
+
+    if (!params.camera_path.empty())
+    {
+        if (!load_camera_path(params.camera_path, cameras, proto))
+        {
+            std::cerr << "Failed loading camera path: " << params.camera_path << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        pinhole_camera cam = proto;
+        cam.view_all(scene_bounds);
+        cameras.push_back(cam);
+    }
+
+
+    // Render -------------------------------------------------
+
+    using bvh_ref = host_bvh_t::bvh_ref;
+
+    aligned_vector<bvh_ref> primitives;
+
+    if (bvh.num_nodes() > 0)
+    {
+        primitives.push_back(bvh.ref());
+    }
+
+    tiled_sched<basic_ray<simd::float4>> sched(max(params.num_threads, 1U));
+
+    vec3 diagonal = scene_bounds.size();
+    float epsilon = std::max(1E-3f, length(diagonal) * 1E-5f);
+
+    if (params.server_port != 0)
+    {
+        serve(params, sched, primitives, geometric_normals, materials, epsilon);
+        return EXIT_SUCCESS;
+    }
+
+    double total_seconds = 0.0;
+    double total_rays = 0.0;
+
+    if (comm != nullptr)
+    {
+        // Sort-last: render this rank's part with depth, composite on rank 0
+
+        remote::binary_swap_compositor compositor(*comm);
+
+        sort_last_rt_t rt;
+        rt.resize(params.width, params.height);
+
+        for (size_t i = 0; i < cameras.size(); ++i)
+        {
+            auto const& cam = cameras[i];
+
+            auto lights = make_headlight(cam.eye());
+
+            auto kparams = make_kparams(params, primitives, geometric_normals, materials, lights, epsilon);
+
+            rt.clear_color_buffer();
+            rt.clear_depth_buffer();
+
+            // Depth is only written with a matrix camera
+            total_rays += render_frames(
+                    params,
+                    sched,
+                    kparams,
+                    i,
+                    total_seconds,
+                    cam.get_view_matrix(),
+                    cam.get_proj_matrix(),
+                    rt
+                    );
+
+            if (!compositor.composite(rt.color(), rt.depth(), params.width, params.height))
+            {
+                std::cerr << "Compositing failed\n";
+                return EXIT_FAILURE;
+            }
+
+            json_line("composite")
+                ("camera", i)
+                ("seconds", compositor.stats().composite.last)
+                ("bytes_sent", compositor.stats().bytes_sent);
+
+            if (params.rank == 0 && !save_image(params, rt, i))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    else
+    {
+        render_target_t rt;
+        rt.resize(params.width, params.height);
+
+        for (size_t i = 0; i < cameras.size(); ++i)
+        {
+            auto const& cam = cameras[i];
+
+            auto lights = make_headlight(cam.eye());
+
+            auto kparams = make_kparams(params, primitives, geometric_normals, materials, lights, epsilon);
+
+            rt.clear_color_buffer();
+
+            total_rays += render_frames(params, sched, kparams, i, total_seconds, cam, rt);
+
+            if (!save_image(params, rt, i))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    json_line("summary")
+        ("cameras", cameras.size())
+        ("seconds", total_seconds)
+        ("mrays_per_second", total_rays / total_seconds / 1e6);
+}
@@ -0,0 +1,220 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+
+#include <common/timer.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Allocation counting
+//
+// Counts operator new (std::vector etc.) and, with glibc, posix_memalign (which
+// aligned_vector uses via _mm_malloc).
+//
+
+static std::atomic<size_t> num_allocations(0);
+
+void* operator new(size_t size)
+{
+    ++num_allocations;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /* */) noexcept
+{
+    std::free(ptr);
+}
+
+#if defined(__GLIBC__)
+extern "C" int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept
+{
+    ++num_allocations;
+
+    *ptr = memalign(alignment, size);
+    return *ptr != nullptr || size == 0 ? 0 : ENOMEM;
+}
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Meshes with small random triangles
+//
+
+using triangle_type = basic_triangle<3, float>;
+using tree_type = index_bvh<triangle_type>;
+
+aligned_vector<triangle_type> make_mesh(size_t num_triangles, std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    aligned_vector<triangle_type> result(num_triangles);
+
+    for (size_t i = 0; i < num_triangles; ++i)
+    {
+        vec3 v1(dist(rng), dist(rng), dist(rng));
+        vec3 v2 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.05f;
+        vec3 v3 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.05f;
+
+        result[i] = triangle_type(v1, v2 - v1, v3 - v1);
+        result[i].prim_id = static_cast<unsigned>(i);
+        result[i].geom_id = 0;
+    }
+
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Measure time and allocations per build
+//
+
+template <typename Func>
+void measure(char const* name, size_t num_builds, Func func)
+{
+    size_t allocs = num_allocations;
+    timer t;
+
+    func();
+
+    double elapsed = t.elapsed();
+    allocs = num_allocations - allocs;
+
+    std::cout << std::left << std::setw(36) << name << std::right
+              << std::setw(10) << elapsed / num_builds * 1000.0 << " ms/build"
+              << std::setw(10) << static_cast<double>(allocs) / num_builds << " allocs/build\n";
+}
+
+template <typename Builder>
+void bench(
+        char const*                                         name,
+        Builder                                             prototype,
+        std::vector<aligned_vector<triangle_type>> const&   meshes,
+        aligned_vector<triangle_type> const&                large_mesh,
+        size_t                                              num_frames
+        )
+{
+    std::cout << name << ":\n";
+
+    // Many small meshes, as in a scene graph
+    {
+        std::vector<tree_type> trees;
+        trees.reserve(meshes.size());
+
+        measure("  small meshes, builder per mesh", meshes.size(), [&]()
+        {
+            for (auto const& mesh : meshes)
+            {
+                Builder builder(prototype);
+                trees.emplace_back(builder.build(tree_type{}, mesh.data(), mesh.size()));
+            }
+        });
+    }
+
+    {
+        std::vector<tree_type> trees;
+        trees.reserve(meshes.size());
+
+        Builder builder(prototype);
+
+        measure("  small meshes, shared builder", meshes.size(), [&]()
+        {
+            for (auto const& mesh : meshes)
+            {
+                trees.emplace_back(builder.build(tree_type{}, mesh.data(), mesh.size()));
+            }
+        });
+    }
+
+    // Per-frame rebuild of one large mesh; the first build is not timed
+    {
+        Builder builder(prototype);
+        tree_type tree = builder.build(tree_type{}, large_mesh.data(), large_mesh.size());
+
+        measure("  per-frame, build()", num_frames, [&]()
+        {
+            for (size_t i = 0; i < num_frames; ++i)
+            {
+                tree = builder.build(tree_type{}, large_mesh.data(), large_mesh.size());
+            }
+        });
+
+        measure("  per-frame, rebuild()", num_frames, [&]()
+        {
+            for (size_t i = 0; i < num_frames; ++i)
+            {
+                builder.rebuild(tree, large_mesh.data(), large_mesh.size());
+            }
+        });
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_bvh_build [num_meshes] [triangles_per_mesh] [large_mesh_triangles] [num_frames]
+//
+
+int main(int argc, char** argv)
+{
+    size_t num_meshes       = argc > 1 ? std::atoi(argv[1]) : 10000;
+    size_t mesh_size        = argc > 2 ? std::atoi(argv[2]) : 64;
+    size_t large_mesh_size  = argc > 3 ? std::atoi(argv[3]) : 200000;
+    size_t num_frames       = argc > 4 ? std::atoi(argv[4]) : 20;
+
+    std::default_random_engine rng(0);
+
+    std::vector<aligned_vector<triangle_type>> meshes(num_meshes);
+
+    for (auto& mesh : meshes)
+    {
+        mesh = make_mesh(mesh_size, rng);
+    }
+
+    auto large_mesh = make_mesh(large_mesh_size, rng);
+
+    std::cout << num_meshes << " meshes with " << mesh_size << " triangles, "
+              << num_frames << " frames with " << large_mesh_size << " triangles\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    binned_sah_builder sah;
+    bench("Binned SAH", sah, meshes, large_mesh, num_frames);
+
+    binned_sah_builder split;
+    split.enable_spatial_splits(true);
+    bench("Binned SAH, spatial splits", split, meshes, large_mesh, num_frames);
+
+    lbvh_builder lbvh;
+    bench("LBVH", lbvh, meshes, large_mesh, num_frames);
+}
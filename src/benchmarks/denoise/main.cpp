@@ -0,0 +1,226 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/denoiser.h>
+#include <visionaray/generic_material.h>
+#include <visionaray/kernels.h>
+#include <visionaray/material.h>
+#include <visionaray/pinhole_camera.h>
+#include <visionaray/point_light.h>
+#include <visionaray/scheduler.h>
+#include <visionaray/simple_buffer_rt.h>
+
+#include <common/timer.h>
+
+using namespace visionaray;
+
+using material_type = generic_material<matte<float>, mirror<float>>;
+using light_type = point_light<float>;
+using render_target_t = simple_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED, PF_RGBA32F, PF_RGBA32F>;
+
+
+//-------------------------------------------------------------------------------------------------
+// Cornell box made of spheres (as in smallpt), lit by a point light
+//
+
+struct scene
+{
+    aligned_vector<basic_sphere<float>> spheres;
+    aligned_vector<material_type>       materials;
+    aligned_vector<light_type>          lights;
+
+    void add_sphere(vec3 center, float radius, material_type mat)
+    {
+        basic_sphere<float> sphere(center, radius);
+        sphere.prim_id = static_cast<int>(spheres.size());
+        sphere.geom_id = static_cast<int>(spheres.size());
+        spheres.push_back(sphere);
+        materials.push_back(mat);
+    }
+};
+
+matte<float> make_matte(vec3 cd)
+{
+    matte<float> mat;
+    mat.cd() = from_rgb(cd);
+    mat.kd() = 1.0f;
+    return mat;
+}
+
+scene make_scene()
+{
+    scene s;
+
+    float base_size = 1e4f;
+
+    s.add_sphere(vec3(base_size + 1.0f, 40.8f, 81.6f), base_size, make_matte(vec3(0.75f, 0.25f, 0.25f)));
+    s.add_sphere(vec3(-base_size + 99.0f, 40.8f, 81.6f), base_size, make_matte(vec3(0.25f, 0.25f, 0.75f)));
+    s.add_sphere(vec3(50.0f, 40.8f, base_size), base_size, make_matte(vec3(0.75f)));
+    s.add_sphere(vec3(50.0f, base_size, 81.6f), base_size, make_matte(vec3(0.75f)));
+    s.add_sphere(vec3(50.0f, -base_size + 81.6f, 81.6f), base_size, make_matte(vec3(0.75f)));
+    s.add_sphere(vec3(27.0f, 16.5f, 47.0f), 16.5f, make_matte(vec3(0.9f, 0.8f, 0.2f)));
+
+    mirror<float> mirr;
+    mirr.cr() = from_rgb(vec3(0.999f));
+    mirr.kr() = 0.9f;
+    mirr.ior() = spectrum<float>(0.0f);
+    mirr.absorption() = spectrum<float>(0.0f);
+    s.add_sphere(vec3(73.0f, 16.5f, 78.0f), 16.5f, mirr);
+
+    // Light below the ceiling
+    light_type light;
+    light.set_cl(vec3(1.0f));
+    light.set_kl(1.0f);
+    light.set_position(vec3(50.0f, 75.0f, 81.6f));
+    light.set_constant_attenuation(1.0f);
+    light.set_linear_attenuation(0.0f);
+    light.set_quadratic_attenuation(0.0f);
+    s.lights.push_back(light);
+
+    return s;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Render spp frames, blending them in the accumulation buffer, returns seconds
+//
+
+double render(
+        scene const&                                    s,
+        pinhole_camera const&                           cam,
+        render_target_t&                                rt,
+        tiled_sched<basic_ray<simd::float4>>&           sched,
+        unsigned                                        spp
+        )
+{
+    auto kparams = make_kernel_params(
+            s.spheres.data(),
+            s.spheres.data() + s.spheres.size(),
+            s.materials.data(),
+            s.lights.data(),
+            s.lights.data() + s.lights.size(),
+            8,
+            1e-3f,
+            vec4(0.0f),
+            vec4(0.0f)
+            );
+
+    pathtracing::kernel<decltype(kparams)> kernel;
+    kernel.params = kparams;
+
+    rt.clear_accum_buffer();
+    rt.clear_feature_buffers();
+
+    timer t;
+
+    for (unsigned frame = 0; frame < spp; ++frame)
+    {
+        pixel_sampler::basic_jittered_blend_type<float> blend_params;
+        blend_params.spp = 1;
+        blend_params.sfactor = 1.0f / (frame + 1);
+        blend_params.dfactor = 1.0f - blend_params.sfactor;
+
+        auto sparams = make_sched_params(blend_params, cam, rt);
+        sched.frame(kernel, sparams);
+    }
+
+    return t.elapsed();
+}
+
+double mse(vec4 const* a, vec4 const* b, size_t n)
+{
+    double sum = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        // Compare in display range
+        vec3 d = clamp(a[i].xyz(), vec3(0.0f), vec3(1.0f)) - clamp(b[i].xyz(), vec3(0.0f), vec3(1.0f));
+        sum += dot(d, d) / 3.0;
+    }
+
+    return sum / n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_denoise [width] [reference_spp]
+//
+
+int main(int argc, char** argv)
+{
+    int width             = argc > 1 ? std::atoi(argv[1]) : 384;
+    unsigned ref_spp      = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 1024;
+
+    int height = width;
+    size_t num_pixels = static_cast<size_t>(width) * height;
+
+    auto s = make_scene();
+
+    pinhole_camera cam;
+    cam.perspective(40.0f * constants::degrees_to_radians<float>(), 1.0f, 0.1f, 1000.0f);
+    cam.set_viewport(0, 0, width, height);
+    cam.look_at(vec3(50.0f, 45.0f, 220.0f), vec3(50.0f, 40.0f, 81.6f), vec3(0.0f, 1.0f, 0.0f));
+
+    render_target_t rt;
+    rt.resize(width, height);
+
+    tiled_sched<basic_ray<simd::float4>> sched(std::thread::hardware_concurrency());
+
+    std::cout << "Rendering reference (" << ref_spp << " spp)..." << std::endl;
+    render(s, cam, rt, sched, ref_spp);
+    std::vector<vec4> reference(rt.accum(), rt.accum() + num_pixels);
+
+    atrous_denoiser denoiser;
+    std::vector<vec4> denoised(num_pixels);
+
+    std::cout << std::setw(6) << "spp"
+              << std::setw(12) << "render ms"
+              << std::setw(12) << "denoise ms"
+              << std::setw(12) << "MSE noisy"
+              << std::setw(12) << "MSE filt."
+              << std::setw(14) << "MSE ratio/ms" << '\n';
+
+    std::cout << std::fixed;
+
+    for (unsigned spp : { 1U, 4U, 16U, 64U })
+    {
+        double render_seconds = render(s, cam, rt, sched, spp);
+
+        // Warm up, then average
+        int runs = 5;
+        denoiser.filter(denoised.data(), rt.accum(), rt.albedo(), rt.normal_depth(), width, height);
+
+        timer t;
+
+        for (int i = 0; i < runs; ++i)
+        {
+            denoiser.filter(denoised.data(), rt.accum(), rt.albedo(), rt.normal_depth(), width, height);
+        }
+
+        double denoise_ms = t.elapsed() * 1000.0 / runs;
+
+        double noisy = mse(rt.accum(), reference.data(), num_pixels);
+        double filtered = mse(denoised.data(), reference.data(), num_pixels);
+
+        std::cout << std::setw(6) << spp
+                  << std::setprecision(1)
+                  << std::setw(12) << render_seconds * 1000.0
+                  << std::setw(12) << denoise_ms
+                  << std::setprecision(5)
+                  << std::setw(12) << noisy
+                  << std::setw(12) << filtered
+                  << std::setprecision(2)
+                  << std::setw(14) << noisy / filtered / denoise_ms << '\n';
+    }
+}
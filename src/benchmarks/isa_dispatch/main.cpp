@@ -0,0 +1,203 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/texture.h>
+#include <visionaray/bvh.h>
+#include <visionaray/cpu_buffer_rt.h>
+#include <visionaray/cpu_features.h>
+#include <visionaray/isa_dispatch.h>
+#include <visionaray/pinhole_camera.h>
+
+#include <common/timer.h>
+
+#include "render.h"
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Synthetic scene: small random triangles inside the unit cube, and a noise volume
+// that is sampled at the hit positions
+//
+
+aligned_vector<basic_triangle<3, float>> make_triangles(size_t n, unsigned seed)
+{
+    std::default_random_engine rng(seed);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+
+    aligned_vector<basic_triangle<3, float>> result(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        vec3 v1(dist(rng), dist(rng), dist(rng));
+        vec3 v2 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.05f;
+        vec3 v3 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.05f;
+
+        result[i] = basic_triangle<3, float>(v1, v2 - v1, v3 - v1);
+        result[i].prim_id = static_cast<unsigned>(i);
+        result[i].geom_id = 0;
+    }
+
+    return result;
+}
+
+std::vector<float> make_noise(int size, unsigned seed)
+{
+    std::default_random_engine rng(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<float> result(size_t(size) * size * size);
+
+    for (auto& v : result)
+    {
+        v = dist(rng);
+    }
+
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_isa_dispatch [num_triangles] [frames]
+//
+
+int main(int argc, char** argv)
+{
+    size_t num_triangles = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int frames           = argc > 2 ? std::atoi(argv[2]) : 8;
+
+    int width = 512;
+    int height = 512;
+    int volume_size = 64;
+
+    auto triangles = make_triangles(num_triangles, 0);
+
+    binned_sah_builder builder;
+    auto bvh = builder.build(index_bvh<basic_triangle<3, float>>{}, triangles.data(), triangles.size());
+
+    auto noise = make_noise(volume_size, 1);
+
+    texture_ref<float, 3> volume(volume_size, volume_size, volume_size);
+    volume.reset(noise.data());
+    volume.set_address_mode(Clamp);
+    volume.set_filter_mode(Linear);
+
+    aabb bbox(vec3(-0.5f), vec3(0.5f));
+
+    pinhole_camera cam;
+    cam.perspective(45.0f * constants::degrees_to_radians<float>(), width / float(height), 0.001f, 1000.0f);
+    cam.set_viewport(0, 0, width, height);
+    cam.view_all(bbox);
+
+    render_params::render_target rt;
+    rt.resize(width, height);
+
+    render_params params;
+    params.bvh = bvh.ref();
+    params.volume = volume;
+    params.bbox = bbox;
+    params.cam = cam;
+    params.rt = &rt;
+    params.num_threads = std::thread::hardware_concurrency();
+    params.frames = frames;
+
+    // All implementations that were compiled, lowest ISA first
+    isa_dispatcher<void(render_params const&)> render;
+
+    struct
+    {
+        int isa;
+        void (*func)(render_params const&);
+    } impls[] = {
+#ifdef VSNRAY_DISPATCH_SSE2
+        { VSNRAY_SIMD_ISA_SSE2,     render_sse2     },
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_1
+        { VSNRAY_SIMD_ISA_SSE4_1,   render_sse4_1   },
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_2
+        { VSNRAY_SIMD_ISA_SSE4_2,   render_sse4_2   },
+#endif
+#ifdef VSNRAY_DISPATCH_AVX
+        { VSNRAY_SIMD_ISA_AVX,      render_avx      },
+#endif
+#ifdef VSNRAY_DISPATCH_AVX2
+        { VSNRAY_SIMD_ISA_AVX2,     render_avx2     },
+#endif
+#ifdef VSNRAY_DISPATCH_AVX512F
+        { VSNRAY_SIMD_ISA_AVX512F,  render_avx512f  },
+#endif
+        { -1, nullptr }
+        };
+
+    std::cout << "Host ISA: " << simd_isa_name(host_simd_isa()) << '\n';
+    std::cout << num_triangles << " triangles, " << width << 'x' << height << ", "
+              << frames << " frames\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    double baseline = 0.0;
+
+    for (auto const& impl : impls)
+    {
+        if (impl.func == nullptr)
+        {
+            continue;
+        }
+
+        render.add(impl.isa, impl.func);
+
+        std::cout << std::left << std::setw(12) << simd_isa_name(impl.isa) << std::right;
+
+        if (!host_supports_simd_isa(impl.isa))
+        {
+            std::cout << "not supported by host\n";
+            continue;
+        }
+
+        // Warm up (also starts the scheduler's threads)
+        params.frames = 1;
+        impl.func(params);
+
+        params.frames = frames;
+        timer t;
+        impl.func(params);
+        double seconds_per_frame = t.elapsed() / frames;
+
+        if (baseline == 0.0)
+        {
+            baseline = seconds_per_frame;
+        }
+
+        // Print the sum of all pixels, should be (about) the same for all ISAs
+        double sum = 0.0;
+        for (int i = 0; i < width * height; ++i)
+        {
+            sum += rt.color()[i].x;
+        }
+
+        std::cout << std::setw(10) << seconds_per_frame * 1000.0 << " ms/frame"
+                  << std::setw(10) << width * height / seconds_per_frame / 1e6 << " Mrays/s"
+                  << std::setw(8) << baseline / seconds_per_frame << "x"
+                  << "  (" << sum << ")\n";
+    }
+
+    if (render.select())
+    {
+        std::cout << "Dispatching to " << simd_isa_name(render.selected_isa()) << '\n';
+    }
+    else
+    {
+        std::cout << "No implementation supported by host\n";
+    }
+}
@@ -0,0 +1,48 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+// Compiled once per ISA, see visionaray/isa_dispatch.h
+
+#include <visionaray/isa_dispatch.h>
+#include <visionaray/scheduler.h>
+#include <visionaray/traverse.h>
+
+#include "render.h"
+
+using namespace visionaray;
+
+void VSNRAY_ISA_FUNCTION(render)(render_params const& params)
+{
+    using R = basic_ray<simd::isa_float>;
+    using S = R::scalar_type;
+    using C = vector<4, S>;
+    using V = vector<3, S>;
+
+    // Constructed on first use, so that hosts lacking the ISA never execute it
+    static tiled_sched<R> sched(params.num_threads);
+
+    auto sparams = make_sched_params(params.cam, *params.rt);
+
+    auto bvh = params.bvh;
+    auto const& volume = params.volume;
+
+    V bbox_min(params.bbox.min);
+    V bbox_scale(1.0f / params.bbox.size());
+
+    for (int f = 0; f < params.frames; ++f)
+    {
+        sched.frame([&](R ray) -> result_record<S>
+        {
+            result_record<S> result;
+
+            auto hit_rec = closest_hit(ray, &bvh, &bvh + 1);
+
+            V pos = ray.ori + ray.dir * hit_rec.t;
+            S value = tex3D(volume, (pos - bbox_min) * bbox_scale);
+
+            result.hit = hit_rec.hit;
+            result.color = select(hit_rec.hit, C(V(value), S(1.0f)), C(0.0f));
+            return result;
+        }, sparams);
+    }
+}
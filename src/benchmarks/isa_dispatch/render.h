@@ -0,0 +1,59 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_BENCH_ISA_DISPATCH_RENDER_H
+#define VSNRAY_BENCH_ISA_DISPATCH_RENDER_H 1
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/texture.h>
+#include <visionaray/bvh.h>
+#include <visionaray/cpu_buffer_rt.h>
+#include <visionaray/pinhole_camera.h>
+
+//-------------------------------------------------------------------------------------------------
+// Parameters shared by the per-ISA implementations
+//
+// Only contains types whose layout does not depend on the ISA compiled for
+//
+
+struct render_params
+{
+    using bvh_ref = visionaray::index_bvh<visionaray::basic_triangle<3, float>>::bvh_ref;
+    using render_target = visionaray::cpu_buffer_rt<visionaray::PF_RGBA32F, visionaray::PF_UNSPECIFIED>;
+
+    bvh_ref                                     bvh;
+    visionaray::texture_ref<float, 3>           volume;
+    visionaray::aabb                            bbox;
+    visionaray::pinhole_camera                  cam;
+    render_target*                              rt;
+    unsigned                                    num_threads;
+    int                                         frames;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Ray cast triangles, shade hits with a filtered 3D texture lookup (render.cpp)
+//
+
+#ifdef VSNRAY_DISPATCH_SSE2
+void render_sse2(render_params const& params);
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_1
+void render_sse4_1(render_params const& params);
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_2
+void render_sse4_2(render_params const& params);
+#endif
+#ifdef VSNRAY_DISPATCH_AVX
+void render_avx(render_params const& params);
+#endif
+#ifdef VSNRAY_DISPATCH_AVX2
+void render_avx2(render_params const& params);
+#endif
+#ifdef VSNRAY_DISPATCH_AVX512F
+void render_avx512f(render_params const& params);
+#endif
+
+#endif // VSNRAY_BENCH_ISA_DISPATCH_RENDER_H
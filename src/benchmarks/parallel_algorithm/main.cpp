@@ -0,0 +1,166 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <visionaray/detail/parallel_algorithm.h>
+#include <visionaray/detail/thread_pool.h>
+
+#include <common/timer.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Run func() on a fresh copy of the input, best of three runs
+//
+
+template <typename T, typename Func>
+double best_of_three(std::vector<T> const& input, Func func)
+{
+    double result = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < 3; ++run)
+    {
+        std::vector<T> data(input);
+
+        timer t;
+        func(data);
+        result = std::min(result, t.elapsed());
+    }
+
+    return result;
+}
+
+void print(char const* name, size_t n, double serial, double parallel)
+{
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << n / serial / 1e6 << " / "
+              << std::setw(10) << n / parallel / 1e6 << " Mitems/s"
+              << "  (" << serial / parallel << "x)\n";
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Benchmarks, serial STL algorithm vs. thread_pool based algorithm
+//
+
+void bench(thread_pool& pool, size_t n)
+{
+    std::default_random_engine rng(0);
+    std::uniform_int_distribution<uint32_t> dist;
+
+    std::vector<uint32_t> keys(n);
+    std::vector<uint32_t> morton(n);
+    std::vector<float> floats(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        keys[i] = dist(rng);
+        morton[i] = keys[i] & 0x3FFFFFFF;
+        floats[i] = static_cast<float>(keys[i]) / std::numeric_limits<uint32_t>::max() - 0.5f;
+    }
+
+    std::cout << "n = " << n << ", serial / parallel (" << pool.num_threads << " threads)\n";
+
+    print("sort (uint32)", n,
+        best_of_three(keys, [](std::vector<uint32_t>& v) { std::sort(v.begin(), v.end()); }),
+        best_of_three(keys, [&](std::vector<uint32_t>& v) { paralgo::radix_sort(pool, v.begin(), v.end()); })
+        );
+
+    print("sort (30-bit Morton codes)", n,
+        best_of_three(morton, [](std::vector<uint32_t>& v) { std::sort(v.begin(), v.end()); }),
+        best_of_three(morton, [&](std::vector<uint32_t>& v) { paralgo::radix_sort(pool, v.begin(), v.end()); })
+        );
+
+    print("sort (float)", n,
+        best_of_three(floats, [](std::vector<float>& v) { std::sort(v.begin(), v.end()); }),
+        best_of_three(floats, [&](std::vector<float>& v) { paralgo::radix_sort(pool, v.begin(), v.end()); })
+        );
+
+    // Key/index pairs, as sorted by the BVH builders
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        pairs[i] = { morton[i], static_cast<uint32_t>(i) };
+    }
+
+    using pair_type = std::pair<uint32_t, uint32_t>;
+
+    print("stable_sort (key/index)", n,
+        best_of_three(pairs, [](std::vector<pair_type>& v)
+        {
+            std::stable_sort(v.begin(), v.end(), [](pair_type const& a, pair_type const& b) { return a.first < b.first; });
+        }),
+        best_of_three(pairs, [&](std::vector<pair_type>& v)
+        {
+            paralgo::radix_sort(pool, v.begin(), v.end(), [](pair_type const& p) { return p.first; });
+        })
+        );
+
+    std::vector<uint32_t> out(n);
+
+    print("inclusive_scan", n,
+        best_of_three(keys, [&](std::vector<uint32_t>& v) { std::partial_sum(v.begin(), v.end(), out.begin()); }),
+        best_of_three(keys, [&](std::vector<uint32_t>& v) { paralgo::inclusive_scan(pool, v.begin(), v.end(), out.begin()); })
+        );
+
+    auto pred = [](uint32_t k) { return (k & 3) == 0; };
+
+    print("copy_if", n,
+        best_of_three(keys, [&](std::vector<uint32_t>& v) { std::copy_if(v.begin(), v.end(), out.begin(), pred); }),
+        best_of_three(keys, [&](std::vector<uint32_t>& v) { paralgo::copy_if(pool, v.begin(), v.end(), out.begin(), pred); })
+        );
+
+    print("stable_partition", n,
+        best_of_three(keys, [&](std::vector<uint32_t>& v) { std::stable_partition(v.begin(), v.end(), pred); }),
+        best_of_three(keys, [&](std::vector<uint32_t>& v) { paralgo::stable_partition(pool, v.begin(), v.end(), pred); })
+        );
+
+    std::cout << '\n';
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_parallel_algorithm [num_items] [num_threads]
+//
+// Without num_items, runs 10^6, 10^7 and 10^8 items.
+//
+
+int main(int argc, char** argv)
+{
+    size_t n             = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 0;
+    unsigned num_threads = argc > 2 ? std::atoi(argv[2]) : std::thread::hardware_concurrency();
+
+    thread_pool pool(std::max(1U, num_threads));
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    if (n > 0)
+    {
+        bench(pool, n);
+    }
+    else
+    {
+        for (size_t m : { size_t(1000000), size_t(10000000), size_t(100000000) })
+        {
+            bench(pool, m);
+        }
+    }
+}
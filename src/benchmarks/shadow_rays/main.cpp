@@ -0,0 +1,208 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <random>
+
+#include <visionaray/math/simd/simd.h>
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/array.h>
+#include <visionaray/bvh.h>
+#include <visionaray/occlusion_batch.h>
+#include <visionaray/traverse.h>
+
+#include <common/timer.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Scene: small random triangles in the unit cube, shadow rays between random points
+//
+
+using triangle_type = basic_triangle<3, float>;
+
+aligned_vector<triangle_type> make_triangles(size_t num_triangles, std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    aligned_vector<triangle_type> result(num_triangles);
+
+    for (size_t i = 0; i < num_triangles; ++i)
+    {
+        vec3 v1(dist(rng), dist(rng), dist(rng));
+        vec3 v2 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.02f;
+        vec3 v3 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.02f;
+
+        result[i] = triangle_type(v1, v2 - v1, v3 - v1);
+        result[i].prim_id = static_cast<unsigned>(i);
+        result[i].geom_id = 0;
+    }
+
+    return result;
+}
+
+aligned_vector<basic_ray<float>> make_rays(size_t num_rays, std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    aligned_vector<basic_ray<float>> result(num_rays);
+
+    for (size_t i = 0; i < num_rays; ++i)
+    {
+        vec3 p1(dist(rng), dist(rng), dist(rng));
+        vec3 p2(dist(rng), dist(rng), dist(rng));
+
+        float len = length(p2 - p1);
+
+        result[i] = basic_ray<float>(p1, (p2 - p1) / len, 0.0f, len);
+    }
+
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Trace the rays as packets with any_hit() and occluded(), and as a batch
+//
+
+template <typename Func>
+void measure(char const* name, size_t num_rays, Func func)
+{
+    timer t;
+
+    size_t num_occluded = func();
+
+    double elapsed = t.elapsed();
+
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(10) << num_rays / elapsed / 1e6 << " Mrays/s"
+              << std::setw(10) << num_occluded << " occluded\n";
+}
+
+template <typename FloatT, typename Primitives>
+void bench(
+        char const*                             name,
+        aligned_vector<basic_ray<float>> const& rays,
+        Primitives                              begin,
+        Primitives                              end
+        )
+{
+    enum { N = simd::num_elements<FloatT>::value };
+
+    using int_array = simd::aligned_array_t<simd::int_type_t<FloatT>>;
+
+    std::cout << name << ":\n";
+
+    measure("  any_hit()", rays.size(), [&]()
+    {
+        size_t num_occluded = 0;
+
+        for (size_t first = 0; first + N <= rays.size(); first += N)
+        {
+            array<basic_ray<float>, N> packet;
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                packet[i] = rays[first + i];
+            }
+
+            auto hr = any_hit(simd::pack(packet), begin, end);
+
+            int_array hit;
+            store(hit, convert_to_int(hr.hit));
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                num_occluded += hit[i] != 0 ? 1 : 0;
+            }
+        }
+
+        return num_occluded;
+    });
+
+    measure("  occluded()", rays.size(), [&]()
+    {
+        size_t num_occluded = 0;
+
+        for (size_t first = 0; first + N <= rays.size(); first += N)
+        {
+            array<basic_ray<float>, N> packet;
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                packet[i] = rays[first + i];
+            }
+
+            auto occl = occluded(simd::pack(packet), begin, end);
+
+            int_array hit;
+            store(hit, convert_to_int(occl));
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                num_occluded += hit[i] != 0 ? 1 : 0;
+            }
+        }
+
+        return num_occluded;
+    });
+
+    occlusion_batch<FloatT> batch;
+
+    measure("  occlusion_batch", rays.size(), [&]()
+    {
+        batch.clear();
+
+        for (auto const& r : rays)
+        {
+            batch.push_back(r);
+        }
+
+        batch.trace(begin, end);
+
+        size_t num_occluded = 0;
+
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            num_occluded += batch.occluded(i) ? 1 : 0;
+        }
+
+        return num_occluded;
+    });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_shadow_rays [num_triangles] [num_rays]
+//
+
+int main(int argc, char** argv)
+{
+    size_t num_triangles    = argc > 1 ? std::atoi(argv[1]) : 200000;
+    size_t num_rays         = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    std::default_random_engine rng(0);
+
+    auto triangles = make_triangles(num_triangles, rng);
+    auto rays = make_rays(num_rays, rng);
+
+    binned_sah_builder builder;
+    auto tree = builder.build(index_bvh<triangle_type>{}, triangles.data(), triangles.size());
+    auto ref = tree.ref();
+
+    std::cout << num_triangles << " triangles, " << num_rays << " shadow rays\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    bench<simd::float4>("float4", rays, &ref, &ref + 1);
+#if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX)
+    bench<simd::float8>("float8", rays, &ref, &ref + 1);
+#endif
+}
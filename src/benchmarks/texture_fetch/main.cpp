@@ -0,0 +1,217 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/detail/storage_types/bricked_storage.h>
+#include <visionaray/texture/texture.h>
+
+#include <common/timer.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// 3D texture with bricked storage
+//
+
+template <typename T, unsigned BrickSize, unsigned Halo>
+struct bricked_texture : texture_base<3, bricked_storage<T, BrickSize, Halo>>
+{
+    using value_type = T;
+    using base_type = texture_base<3, bricked_storage<T, BrickSize, Halo>>;
+    enum { dimensions = 3 };
+    using base_type::base_type;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Sample positions
+//
+// Incoherent: uniformly distributed over the volume
+// Coherent: short ray segments with small steps, as in ray marching
+//
+
+std::vector<vec3> make_incoherent_coords(size_t n)
+{
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<vec3> result(n);
+
+    for (auto& c : result)
+    {
+        c = vec3(dist(rng), dist(rng), dist(rng));
+    }
+
+    return result;
+}
+
+std::vector<vec3> make_coherent_coords(size_t n, float step)
+{
+    std::default_random_engine rng(1);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<vec3> result(n);
+
+    static const size_t SegmentLength = 256;
+
+    for (size_t i = 0; i < n; i += SegmentLength)
+    {
+        vec3 pos(dist(rng), dist(rng), dist(rng));
+        vec3 dir = normalize(vec3(dist(rng), dist(rng), dist(rng)) - vec3(0.5f));
+
+        for (size_t j = i; j < std::min(n, i + SegmentLength); ++j)
+        {
+            result[j] = pos;
+            pos += dir * step;
+        }
+    }
+
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Timed lookups, scalar and SIMD
+//
+
+template <typename Tex>
+void bench(char const* name, Tex& tex, std::vector<vec3> const& coords)
+{
+    tex_filter_mode filter_modes[] = { Linear, CardinalSpline };
+    char const* filter_names[] = { "linear", "cubic" };
+
+    std::cout << std::left << std::setw(24) << name << std::right;
+
+    for (int f = 0; f < 2; ++f)
+    {
+        tex.set_filter_mode(filter_modes[f]);
+
+        float sum = 0.0f;
+        simd::float4 sum4(0.0f);
+
+        double scalar = std::numeric_limits<double>::max();
+        double simd4 = std::numeric_limits<double>::max();
+
+        // Best of three runs
+        for (int run = 0; run < 3; ++run)
+        {
+            // Scalar
+            timer t;
+
+            for (auto const& c : coords)
+            {
+                sum += tex3D(tex, c);
+            }
+
+            scalar = std::min(scalar, t.elapsed());
+
+            // SIMD
+            t.reset();
+
+            for (size_t i = 0; i + 4 <= coords.size(); i += 4)
+            {
+                vector<3, simd::float4> c(
+                        simd::float4(coords[i].x, coords[i + 1].x, coords[i + 2].x, coords[i + 3].x),
+                        simd::float4(coords[i].y, coords[i + 1].y, coords[i + 2].y, coords[i + 3].y),
+                        simd::float4(coords[i].z, coords[i + 1].z, coords[i + 2].z, coords[i + 3].z)
+                        );
+                sum4 += tex3D(tex, c);
+            }
+
+            simd4 = std::min(simd4, t.elapsed());
+        }
+
+        simd::aligned_array_t<simd::float4> sums;
+        store(sums, sum4);
+        sum += sums[0] + sums[1] + sums[2] + sums[3];
+
+        // Print the sums so lookups are not optimized away
+        std::cout << std::setw(8) << filter_names[f] << ": "
+                  << std::setw(8) << coords.size() / scalar / 1e6 << " / "
+                  << std::setw(8) << coords.size() / simd4 / 1e6 << " Mlookups/s"
+                  << " (" << sum << ")";
+    }
+
+    std::cout << '\n';
+}
+
+template <typename Tex>
+void bench(char const* name, Tex& tex, std::vector<vec3> const& incoherent, std::vector<vec3> const& coherent)
+{
+    tex.set_address_mode(Clamp);
+
+    std::cout << "incoherent ";
+    bench(name, tex, incoherent);
+
+    std::cout << "coherent   ";
+    bench(name, tex, coherent);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_texture_fetch [volume_size] [num_lookups]
+//
+
+int main(int argc, char** argv)
+{
+    unsigned size = argc > 1 ? std::atoi(argv[1]) : 256;
+    size_t n      = argc > 2 ? std::atoi(argv[2]) : (1 << 22);
+
+    std::vector<float> data(size_t(size) * size * size);
+
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    for (auto& v : data)
+    {
+        v = dist(rng);
+    }
+
+    auto incoherent = make_incoherent_coords(n);
+    auto coherent = make_coherent_coords(n, 0.5f / size);
+
+    std::cout << "Volume: " << size << "^3, " << n << " lookups, scalar / SIMD (4-wide)\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    {
+        texture<float, 3> tex(size, size, size);
+        tex.reset(data.data());
+        bench("row-major", tex, incoherent, coherent);
+    }
+
+    {
+        bricked_texture<float, 4, 0> tex(size, size, size);
+        tex.reset(data.data());
+        bench("bricked 4^3", tex, incoherent, coherent);
+    }
+
+    {
+        bricked_texture<float, 4, 1> tex(size, size, size);
+        tex.reset(data.data());
+        bench("bricked 4^3, halo 1", tex, incoherent, coherent);
+    }
+
+    {
+        bricked_texture<float, 8, 1> tex(size, size, size);
+        tex.reset(data.data());
+        bench("bricked 8^3, halo 1", tex, incoherent, coherent);
+    }
+
+    {
+        bricked_texture<float, 16, 2> tex(size, size, size);
+        tex.reset(data.data());
+        bench("bricked 16^3, halo 2", tex, incoherent, coherent);
+    }
+}
@@ -0,0 +1,238 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+#include <visionaray/intersector.h>
+#include <visionaray/pinhole_camera.h>
+#include <visionaray/result_record.h>
+#include <visionaray/scheduler.h>
+#include <visionaray/simple_buffer_rt.h>
+#include <visionaray/traverse.h>
+
+#include <common/model.h>
+#include <common/timer.h>
+
+using namespace visionaray;
+
+using triangle_type = basic_triangle<3, float>;
+using precomputed_triangle_type = basic_precomputed_triangle<float>;
+using render_target_t = simple_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED>;
+
+
+//-------------------------------------------------------------------------------------------------
+// Synthetic scene: small random triangles inside the unit cube
+//
+
+aligned_vector<triangle_type> make_triangles(size_t n, unsigned seed)
+{
+    std::default_random_engine rng(seed);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+
+    aligned_vector<triangle_type> result(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        vec3 v1(dist(rng), dist(rng), dist(rng));
+        vec3 v2 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.05f;
+        vec3 v3 = v1 + vec3(dist(rng), dist(rng), dist(rng)) * 0.05f;
+
+        result[i] = triangle_type(v1, v2 - v1, v3 - v1);
+        result[i].prim_id = static_cast<unsigned>(i);
+        result[i].geom_id = 0;
+    }
+
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Render primary rays, return the best time per frame of three runs, and the
+// number of pixels with hits
+//
+
+template <typename R, typename BVH, typename Intersector>
+double render(
+        BVH const&              bvh,
+        Intersector&            isect,
+        pinhole_camera const&   cam,
+        render_target_t&        rt,
+        int                     frames,
+        int&                    num_hits
+        )
+{
+    using S = typename R::scalar_type;
+    using C = vector<4, S>;
+
+    static tiled_sched<R> sched(std::thread::hardware_concurrency());
+
+    auto sparams = make_sched_params(cam, rt);
+
+    auto ref = bvh.ref();
+
+    auto kernel = [&](R ray) -> result_record<S>
+    {
+        result_record<S> result;
+
+        auto hit_rec = closest_hit(ray, &ref, &ref + 1, isect);
+
+        result.hit = hit_rec.hit;
+        result.color = select(hit_rec.hit, C(S(1.0f)), C(0.0f));
+        return result;
+    };
+
+    // Warm up
+    sched.frame(kernel, sparams);
+
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < 3; ++run)
+    {
+        timer t;
+
+        for (int f = 0; f < frames; ++f)
+        {
+            sched.frame(kernel, sparams);
+        }
+
+        best = std::min(best, t.elapsed() / frames);
+    }
+
+    num_hits = 0;
+
+    for (int i = 0; i < rt.width() * rt.height(); ++i)
+    {
+        num_hits += rt.color()[i].x > 0.0f;
+    }
+
+    return best;
+}
+
+template <typename BVH, typename Intersector>
+void bench(
+        char const*             name,
+        BVH const&              bvh,
+        Intersector&            isect,
+        pinhole_camera const&   cam,
+        render_target_t&        rt,
+        int                     frames
+        )
+{
+    int hits1 = 0;
+    int hits4 = 0;
+
+    double scalar = render<basic_ray<float>>(bvh, isect, cam, rt, frames, hits1);
+    double simd4 = render<basic_ray<simd::float4>>(bvh, isect, cam, rt, frames, hits4);
+
+    double num_rays = static_cast<double>(rt.width()) * rt.height();
+
+    // Hit counts should be (about) the same for all tests
+    std::cout << std::left << std::setw(20) << name << std::right
+              << std::setw(10) << num_rays / scalar / 1e6 << " / "
+              << std::setw(8) << num_rays / simd4 / 1e6 << " Mrays/s"
+              << "  (" << hits1 << " / " << hits4 << " hits)\n";
+}
+
+void bench_scene(aligned_vector<triangle_type> const& triangles, aabb const& bbox, int frames)
+{
+    int width = 512;
+    int height = 512;
+
+    pinhole_camera cam;
+    cam.perspective(45.0f * constants::degrees_to_radians<float>(), width / float(height), 0.001f, 1000.0f);
+    cam.set_viewport(0, 0, width, height);
+    cam.view_all(bbox);
+
+    render_target_t rt;
+    rt.resize(width, height);
+
+    aligned_vector<precomputed_triangle_type> precomputed;
+    precomputed.reserve(triangles.size());
+
+    for (auto const& t : triangles)
+    {
+        precomputed.emplace_back(t);
+    }
+
+    binned_sah_builder builder;
+    builder.enable_spatial_splits(true);
+
+    auto bvh = builder.build(index_bvh<triangle_type>{}, triangles.data(), triangles.size());
+    auto precomputed_bvh = builder.build(index_bvh<precomputed_triangle_type>{}, precomputed.data(), precomputed.size());
+
+    default_intersector default_isect;
+    watertight_intersector watertight_isect;
+
+    std::cout << triangles.size() << " triangles, " << width << 'x' << height << ", "
+              << frames << " frames, scalar / SIMD (4-wide)\n";
+
+    bench("Moeller-Trumbore", bvh, default_isect, cam, rt, frames);
+    bench("watertight", bvh, watertight_isect, cam, rt, frames);
+    bench("precomputed", precomputed_bvh, default_isect, cam, rt, frames);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_triangle_isect [num_triangles | model files...] [-frames N]
+//
+
+int main(int argc, char** argv)
+{
+    size_t num_triangles = 200000;
+    int frames = 8;
+    std::vector<std::string> filenames;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+
+        if (arg == "-frames" && i + 1 < argc)
+        {
+            frames = std::atoi(argv[++i]);
+        }
+        else if (std::all_of(arg.begin(), arg.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        {
+            num_triangles = std::atoi(arg.c_str());
+        }
+        else
+        {
+            filenames.push_back(arg);
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    if (filenames.empty())
+    {
+        std::cout << "Random triangles: ";
+        bench_scene(make_triangles(num_triangles, 0), aabb(vec3(-0.5f), vec3(0.5f)), frames);
+        return EXIT_SUCCESS;
+    }
+
+    for (auto const& filename : filenames)
+    {
+        model mod;
+
+        if (!mod.load(filename) || mod.scene_graph != nullptr)
+        {
+            std::cerr << "Failed loading " << filename << " (only files w/o scene graph are supported)\n";
+            continue;
+        }
+
+        std::cout << filename << ": ";
+        bench_scene(mod.primitives, mod.bbox, frames);
+    }
+}
@@ -0,0 +1,233 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/texture.h>
+#include <visionaray/cpu_buffer_rt.h>
+#include <visionaray/macrocell_grid.h>
+#include <visionaray/pinhole_camera.h>
+#include <visionaray/scheduler.h>
+#include <visionaray/volume_rendering.h>
+
+#include <common/timer.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Synthetic sparse volume: a few smooth blobs in an otherwise empty domain
+//
+
+texture<float, 3> make_sparse_volume(int size, int num_blobs, unsigned seed)
+{
+    std::vector<float> data(size_t(size) * size * size, 0.0f);
+
+    std::default_random_engine rng(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    for (int b = 0; b < num_blobs; ++b)
+    {
+        vec3 center(dist(rng), dist(rng), dist(rng));
+        float radius = 0.03f + 0.07f * dist(rng);
+
+        vec3i first = max(vec3i((center - vec3(radius)) * float(size)), vec3i(0));
+        vec3i last = min(vec3i((center + vec3(radius)) * float(size)) + vec3i(1), vec3i(size));
+
+        for (int z = first.z; z < last.z; ++z)
+        {
+            for (int y = first.y; y < last.y; ++y)
+            {
+                for (int x = first.x; x < last.x; ++x)
+                {
+                    vec3 p = (vec3(x, y, z) + vec3(0.5f)) / float(size);
+                    float d = length(p - center) / radius;
+                    float& v = data[z * size_t(size) * size + y * size_t(size) + x];
+                    v = max(v, saturate(1.0f - d * d));
+                }
+            }
+        }
+    }
+
+    texture<float, 3> volume(size, size, size);
+    volume.reset(data.data());
+    volume.set_address_mode(Clamp);
+    volume.set_filter_mode(Linear);
+    return volume;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Transfer function: transparent below 0.1, then an opacity ramp
+//
+
+texture<vec4, 1> make_transfunc()
+{
+    static const int N = 256;
+
+    std::vector<vec4> data(N);
+
+    for (int i = 0; i < N; ++i)
+    {
+        float v = i / float(N - 1);
+        float a = v < 0.1f ? 0.0f : 0.1f * (v - 0.1f) / 0.9f;
+        data[i] = vec4(v, 0.5f * v, 1.0f - v, a);
+    }
+
+    texture<vec4, 1> transfunc(N);
+    transfunc.reset(data.data());
+    transfunc.set_address_mode(Clamp);
+    transfunc.set_filter_mode(Linear);
+    return transfunc;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Render a number of frames and report timings
+//
+
+struct bench_result
+{
+    double seconds_per_frame;
+    double samples_per_ray;
+};
+
+template <typename Volume, typename Transfunc>
+bench_result render(
+        Volume const&                                   volume,
+        Transfunc const&                                transfunc,
+        macrocell_grid const&                           grid,
+        ray_marching_params const&                      params,
+        pinhole_camera const&                           cam,
+        cpu_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED>&      rt,
+        tiled_sched<basic_ray<float>>&                  sched,
+        int                                             frames
+        )
+{
+    std::atomic<unsigned long long> samples(0);
+
+    auto sparams = make_sched_params(cam, rt);
+
+    timer t;
+
+    for (int f = 0; f < frames; ++f)
+    {
+        sched.frame([&](basic_ray<float> ray) -> result_record<float>
+        {
+            ray_marching_stats stats;
+
+            result_record<float> result;
+            result.color = integrate_emission_absorption(ray, volume, transfunc, grid, params, stats);
+            result.hit = result.color.w > 0.0f;
+
+            samples += stats.samples;
+
+            return result;
+        }, sparams);
+    }
+
+    double elapsed = t.elapsed();
+    double num_rays = double(rt.width()) * rt.height() * frames;
+
+    return { elapsed / frames, samples / num_rays };
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function
+//
+// Usage: bench_volume_rendering [volume_size] [num_blobs] [frames]
+//
+
+int main(int argc, char** argv)
+{
+    int size      = argc > 1 ? std::atoi(argv[1]) : 256;
+    int num_blobs = argc > 2 ? std::atoi(argv[2]) : 24;
+    int frames    = argc > 3 ? std::atoi(argv[3]) : 8;
+
+    int width = 512;
+    int height = 512;
+
+    aabb bbox(vec3(-1.0f), vec3(1.0f));
+
+    auto volume = make_sparse_volume(size, num_blobs, 0);
+    auto transfunc = make_transfunc();
+
+    // Fraction of voxels that are not fully transparent
+    size_t occupied = 0;
+    for (size_t i = 0; i < size_t(size) * size * size; ++i)
+    {
+        occupied += volume.data()[i] >= 0.1f;
+    }
+
+    std::cout << "Volume: " << size << "^3, " << std::fixed << std::setprecision(1)
+              << 100.0 * occupied / (double(size) * size * size) << "% occupied\n";
+
+    thread_pool pool(std::thread::hardware_concurrency());
+
+    // Baseline: one macrocell that is never empty
+    macrocell_grid dense_grid(vec3i(1), bbox);
+    dense_grid.build(volume, pool);
+    dense_grid.compute_majorants([](vec2 const&) { return 1.0f; });
+
+    timer t;
+    macrocell_grid grid(vec3i(max(1, size / 8)), bbox);
+    grid.build(volume, pool);
+    grid.compute_opacity_majorants(transfunc);
+    std::cout << "Macrocell grid build: " << std::setprecision(2) << t.elapsed() * 1000.0 << " ms\n";
+
+    pinhole_camera cam;
+    cam.perspective(45.0f * constants::degrees_to_radians<float>(), width / float(height), 0.001f, 1000.0f);
+    cam.set_viewport(0, 0, width, height);
+    cam.view_all(bbox);
+
+    cpu_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED> rt;
+    rt.resize(width, height);
+
+    tiled_sched<basic_ray<float>> sched(std::thread::hardware_concurrency());
+
+    ray_marching_params fixed_step;
+    fixed_step.min_step = fixed_step.max_step = fixed_step.reference_step = 2.0f / size;
+
+    ray_marching_params adaptive = fixed_step;
+    adaptive.min_step = fixed_step.reference_step * 0.5f;
+    adaptive.max_step = fixed_step.reference_step * 4.0f;
+
+    struct
+    {
+        char const*             name;
+        macrocell_grid const*   grid;
+        ray_marching_params     params;
+    } configs[] = {
+        { "fixed step",                 &dense_grid, fixed_step },
+        { "empty space skipping",       &grid,       fixed_step },
+        { "skipping + adaptive step",   &grid,       adaptive   }
+        };
+
+    double baseline = 0.0;
+
+    for (auto const& c : configs)
+    {
+        auto r = render(volume, transfunc, *c.grid, c.params, cam, rt, sched, frames);
+
+        if (baseline == 0.0)
+        {
+            baseline = r.seconds_per_frame;
+        }
+
+        std::cout << std::left << std::setw(28) << c.name << std::right
+                  << std::setw(10) << r.seconds_per_frame * 1000.0 << " ms/frame"
+                  << std::setw(10) << width * height / r.seconds_per_frame / 1e6 << " Mrays/s"
+                  << std::setw(10) << r.samples_per_ray << " samples/ray"
+                  << std::setw(8) << baseline / r.seconds_per_frame << "x\n";
+    }
+}
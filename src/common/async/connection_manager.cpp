@@ -71,6 +71,9 @@ connection_manager::~connection_manager()
 
 void connection_manager::run()
 {
+    // Restart after a previous call to stop()
+    io_service_.reset();
+
 #ifndef NDEBUG
     try
     {
@@ -100,8 +103,9 @@ void connection_manager::stop()
 {
     work_.reset();
 
+    // Don't reset the io service here: if run() did not yet return,
+    // it would continue to process the pending operations
     io_service_.stop();
-    io_service_.reset();
 }
 
 void connection_manager::accept(handler h)
@@ -182,9 +186,11 @@ void connection_manager::close(connection_pointer conn)
 
 void connection_manager::close_all()
 {
-    std::for_each(connections_.begin(), connections_.end(), [&](connection_pointer conn) { close(conn); });
-
-    connections_.clear();
+    // close() removes the connection from the list
+    while (!connections_.empty())
+    {
+        close(*connections_.begin());
+    }
 }
 
 connection_pointer connection_manager::find(std::string const& host, unsigned short port)
@@ -211,6 +217,15 @@ connection_pointer connection_manager::find(std::string const& host, unsigned sh
     return connection_pointer();
 }
 
+unsigned short connection_manager::port() const
+{
+    boost::system::error_code e;
+
+    auto endpoint = acceptor_.local_endpoint(e);
+
+    return e ? 0 : endpoint.port();
+}
+
 //--------------------------------------------------------------------------------------------------
 // Implementation
 //--------------------------------------------------------------------------------------------------
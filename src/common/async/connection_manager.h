@@ -76,6 +76,10 @@ public:
     // Search for an existing connection
     connection_pointer find(std::string const& host, unsigned short port);
 
+    // Returns the port the acceptor is bound to, e.g. the one chosen for port 0.
+    // Returns 0 if the manager doesn't accept connections
+    unsigned short port() const;
+
 private:
     // Start an accept operation
     void do_accept(handler h);
@@ -0,0 +1,536 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/assign.hpp>
+
+#include <visionaray/detail/parallel_for.h>
+#include <visionaray/detail/range.h>
+#include <visionaray/math/detail/math.h>
+
+#include "data_file.h"
+
+namespace visionaray
+{
+namespace data_file
+{
+
+boost::bimap<meta_data::data_type_t, std::string> meta_data::data_type_map
+    = boost::assign::list_of<typename boost::bimap<meta_data::data_type_t, std::string>::relation>
+        ( U8,     "u8" )
+        ( Float,  "float" )
+        ( Vec2u8, "vec2u8" )
+        ( Vec2f,  "vec2f" )
+        ( Vec3u8, "vec3u8" )
+        ( Vec3f,  "vec3f" )
+        ( Vec4u8, "vec4u8" )
+        ( Vec4f,  "vec4f" )
+        ( I32,    "int" );
+
+boost::bimap<meta_data::compression_t, std::string> meta_data::compression_map
+    = boost::assign::list_of<typename boost::bimap<meta_data::compression_t, std::string>::relation>
+        ( Raw,       "none" )
+        ( Delta,     "delta" )
+        ( Quantized, "quantized" );
+
+
+namespace blocked
+{
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+// Call func(b) for all blocks b in [0..num_blocks). Blocks are independent and are
+// processed in parallel, the first exception thrown by func is rethrown on the
+// calling thread
+template <typename Func>
+inline void for_each_block(worker_pool& pool, size_t num_blocks, Func func)
+{
+    if (num_blocks == 1)
+    {
+        func(size_t(0));
+        return;
+    }
+
+    if (num_blocks == 0)
+    {
+        return;
+    }
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    parallel_for(pool.get(), range1d<size_t>(0, num_blocks), [&](size_t b)
+    {
+        try
+        {
+            func(b);
+        }
+        catch (...)
+        {
+            std::unique_lock<std::mutex> lock(error_mutex);
+
+            if (error == nullptr)
+            {
+                error = std::current_exception();
+            }
+        }
+    });
+
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+inline void put_u32(std::vector<char>& out, uint32_t u)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<char>((u >> (i * 8)) & 0xFF));
+    }
+}
+
+inline void put_u64(std::vector<char>& out, uint64_t u)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        out.push_back(static_cast<char>((u >> (i * 8)) & 0xFF));
+    }
+}
+
+inline void put_varint(std::vector<char>& out, uint32_t u)
+{
+    while (u >= 0x80)
+    {
+        out.push_back(static_cast<char>((u & 0x7F) | 0x80));
+        u >>= 7;
+    }
+
+    out.push_back(static_cast<char>(u));
+}
+
+inline uint32_t get_u32(char const* in)
+{
+    uint32_t u = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        u |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (i * 8);
+    }
+    return u;
+}
+
+inline uint64_t get_u64(char const* in)
+{
+    uint64_t u = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        u |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (i * 8);
+    }
+    return u;
+}
+
+inline uint32_t get_varint(char const*& in, char const* last)
+{
+    uint32_t u = 0;
+
+    for (int shift = 0; in != last && shift < 35; shift += 7)
+    {
+        auto byte = static_cast<unsigned char>(*in++);
+        u |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return u;
+        }
+    }
+
+    throw std::runtime_error("Corrupt compressed data block");
+}
+
+inline uint32_t zigzag(uint32_t diff)
+{
+    auto i = static_cast<int32_t>(diff);
+    return (static_cast<uint32_t>(i) << 1) ^ static_cast<uint32_t>(i >> 31);
+}
+
+inline uint32_t unzigzag(uint32_t z)
+{
+    return (z >> 1) ^ (0U - (z & 1));
+}
+
+inline uint32_t load_word(char const* src, size_t word_size)
+{
+    uint32_t word = 0;
+    if (word_size == 1)
+    {
+        word = static_cast<unsigned char>(*src);
+    }
+    else
+    {
+        std::memcpy(&word, src, sizeof(word));
+    }
+    return word;
+}
+
+inline void store_word(char* dst, uint32_t word, size_t word_size)
+{
+    if (word_size == 1)
+    {
+        *dst = static_cast<char>(word & 0xFF);
+    }
+    else
+    {
+        std::memcpy(dst, &word, sizeof(word));
+    }
+}
+
+inline float word_as_float(uint32_t word)
+{
+    float f;
+    std::memcpy(&f, &word, sizeof(f));
+    return f;
+}
+
+inline uint32_t float_as_word(float f)
+{
+    uint32_t word;
+    std::memcpy(&word, &f, sizeof(word));
+    return word;
+}
+
+// Per-component min and max of items [first,last) of the float array src
+inline void compute_range(
+        meta_data const&    md,
+        char const*         src,
+        size_t              first,
+        size_t              last,
+        float*              lo,
+        float*              hi
+        )
+{
+    size_t comps = meta_data::num_components(md.data_type);
+    float const* f = reinterpret_cast<float const*>(src);
+
+    for (size_t c = 0; c < comps; ++c)
+    {
+        lo[c] =  std::numeric_limits<float>::max();
+        hi[c] = -std::numeric_limits<float>::max();
+    }
+
+    for (size_t i = first; i != last; ++i)
+    {
+        for (size_t c = 0; c < comps; ++c)
+        {
+            float x = f[i * comps + c];
+
+            if (!std::isfinite(x))
+            {
+                throw std::runtime_error("Quantized compression requires finite values");
+            }
+
+            lo[c] = std::min(lo[c], x);
+            hi[c] = std::max(hi[c], x);
+        }
+    }
+}
+
+// Encode items [first,last) of the (host byte order) scalar array src. lo and hi
+// are the quantization range of the whole stream (Quantized only)
+inline std::vector<char> encode_block(
+        meta_data const&    md,
+        char const*         src,
+        size_t              first,
+        size_t              last,
+        float const*        lo,
+        float const*        hi
+        )
+{
+    std::vector<char> out;
+
+    size_t comps = meta_data::num_components(md.data_type);
+    size_t word_size = meta_data::word_size(md.data_type);
+    size_t item_size = comps * word_size;
+
+    auto word = [&](size_t item, size_t c)
+    {
+        return load_word(src + item * item_size + c * word_size, word_size);
+    };
+
+    if (md.compression == meta_data::Quantized)
+    {
+        for (size_t c = 0; c < comps; ++c)
+        {
+            put_u32(out, float_as_word(lo[c]));
+            put_u32(out, float_as_word(hi[c]));
+        }
+
+        std::vector<uint32_t> prev(comps, 0);
+
+        for (size_t i = first; i != last; ++i)
+        {
+            for (size_t c = 0; c < comps; ++c)
+            {
+                // Double precision, the range of finite floats may overflow
+                double range = static_cast<double>(hi[c]) - lo[c];
+                double f = word_as_float(word(i, c));
+                uint32_t q = range > 0.0
+                        ? static_cast<uint32_t>((f - lo[c]) / range * 65535.0 + 0.5)
+                        : 0U;
+                q = std::min(q, 65535U);
+
+                put_varint(out, zigzag(q - prev[c]));
+                prev[c] = q;
+            }
+        }
+    }
+    else // Delta
+    {
+        bool is_float = meta_data::is_floating_point(md.data_type);
+
+        std::vector<uint32_t> prev(comps, 0);
+
+        for (size_t i = first; i != last; ++i)
+        {
+            for (size_t c = 0; c < comps; ++c)
+            {
+                uint32_t w = word(i, c);
+                put_varint(out, is_float ? w ^ prev[c] : zigzag(w - prev[c]));
+                prev[c] = w;
+            }
+        }
+    }
+
+    return out;
+}
+
+// Decode the block [in,last) holding items [first,last_item) into dst
+inline void decode_block(
+        meta_data const&    md,
+        char const*         in,
+        char const*         last,
+        char*               dst,
+        size_t              first,
+        size_t              last_item
+        )
+{
+    size_t comps = meta_data::num_components(md.data_type);
+    size_t word_size = meta_data::word_size(md.data_type);
+    size_t item_size = comps * word_size;
+
+    if (md.compression == meta_data::Quantized)
+    {
+        if (!meta_data::is_floating_point(md.data_type))
+        {
+            throw std::runtime_error("Quantized compression requires floating point data");
+        }
+
+        if (static_cast<size_t>(last - in) < comps * 2 * sizeof(float))
+        {
+            throw std::runtime_error("Corrupt compressed data block");
+        }
+
+        std::vector<double> lo(comps);
+        std::vector<double> scale(comps);
+
+        for (size_t c = 0; c < comps; ++c)
+        {
+            lo[c] = word_as_float(get_u32(in));
+            double hi = word_as_float(get_u32(in + 4));
+            scale[c] = (hi - lo[c]) / 65535.0;
+            in += 8;
+        }
+
+        std::vector<uint32_t> prev(comps, 0);
+
+        for (size_t i = first; i != last_item; ++i)
+        {
+            for (size_t c = 0; c < comps; ++c)
+            {
+                prev[c] += unzigzag(get_varint(in, last));
+                float f = static_cast<float>(lo[c] + prev[c] * scale[c]);
+                store_word(dst + i * item_size + c * word_size, float_as_word(f), word_size);
+            }
+        }
+    }
+    else // Delta
+    {
+        bool is_float = meta_data::is_floating_point(md.data_type);
+
+        std::vector<uint32_t> prev(comps, 0);
+
+        for (size_t i = first; i != last_item; ++i)
+        {
+            for (size_t c = 0; c < comps; ++c)
+            {
+                uint32_t v = get_varint(in, last);
+                prev[c] = is_float ? prev[c] ^ v : prev[c] + unzigzag(v);
+                store_word(dst + i * item_size + c * word_size, prev[c], word_size);
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Interface
+//
+
+std::vector<char> encode(meta_data const& md, char const* src, worker_pool& pool)
+{
+    size_t num_items = static_cast<size_t>(md.num_items);
+    size_t num_blocks = div_up(num_items, static_cast<size_t>(items_per_block));
+
+    size_t comps = meta_data::num_components(md.data_type);
+
+    // Quantization range of the whole stream, reduced from the block ranges
+    std::vector<float> lo(comps);
+    std::vector<float> hi(comps);
+
+    if (md.compression == meta_data::Quantized)
+    {
+        if (!meta_data::is_floating_point(md.data_type))
+        {
+            throw std::runtime_error("Quantized compression requires floating point data");
+        }
+
+        std::vector<float> block_lo(num_blocks * comps);
+        std::vector<float> block_hi(num_blocks * comps);
+
+        for_each_block(pool, num_blocks, [&](size_t b)
+        {
+            size_t first = b * items_per_block;
+            size_t last = std::min(first + items_per_block, num_items);
+            compute_range(md, src, first, last, &block_lo[b * comps], &block_hi[b * comps]);
+        });
+
+        for (size_t c = 0; c < comps; ++c)
+        {
+            lo[c] =  std::numeric_limits<float>::max();
+            hi[c] = -std::numeric_limits<float>::max();
+
+            for (size_t b = 0; b < num_blocks; ++b)
+            {
+                lo[c] = std::min(lo[c], block_lo[b * comps + c]);
+                hi[c] = std::max(hi[c], block_hi[b * comps + c]);
+            }
+        }
+    }
+
+    std::vector<std::vector<char>> blocks(num_blocks);
+
+    auto encode_range = [&](size_t b)
+    {
+        size_t first = b * items_per_block;
+        size_t last = std::min(first + items_per_block, num_items);
+        blocks[b] = encode_block(md, src, first, last, lo.data(), hi.data());
+    };
+
+    for_each_block(pool, num_blocks, encode_range);
+
+    std::vector<char> out(std::begin(magic), std::end(magic));
+    put_u32(out, version);
+    put_u32(out, static_cast<uint32_t>(md.compression));
+    put_u32(out, static_cast<uint32_t>(md.data_type));
+    put_u32(out, static_cast<uint32_t>(num_items));
+    put_u32(out, items_per_block);
+    put_u32(out, static_cast<uint32_t>(num_blocks));
+
+    uint64_t offset = 0;
+    for (auto const& b : blocks)
+    {
+        put_u64(out, offset);
+        offset += b.size();
+    }
+    put_u64(out, offset);
+
+    for (auto const& b : blocks)
+    {
+        out.insert(out.end(), b.begin(), b.end());
+    }
+
+    return out;
+}
+
+bool can_quantize(meta_data const& md, char const* src)
+{
+    if (!meta_data::is_floating_point(md.data_type))
+    {
+        return false;
+    }
+
+    size_t num_scalars = static_cast<size_t>(md.num_items) * meta_data::num_components(md.data_type);
+    float const* f = reinterpret_cast<float const*>(src);
+
+    return std::all_of(f, f + num_scalars, [](float x) { return std::isfinite(x); });
+}
+
+void decode(meta_data const& md, char const* in, size_t size, char* dst, worker_pool& pool)
+{
+    if (size < header_size || !std::equal(std::begin(magic), std::end(magic), in))
+    {
+        throw std::runtime_error("Invalid compressed data file");
+    }
+
+    if (get_u32(in + 4) != version
+     || get_u32(in + 8) != static_cast<uint32_t>(md.compression)
+     || get_u32(in + 12) != static_cast<uint32_t>(md.data_type)
+     || get_u32(in + 16) != static_cast<uint32_t>(md.num_items))
+    {
+        throw std::runtime_error("Compressed data file does not match meta data");
+    }
+
+    size_t block_size = get_u32(in + 20);
+    size_t num_blocks = get_u32(in + 24);
+    size_t num_items = static_cast<size_t>(md.num_items);
+
+    if (block_size == 0 || num_blocks != div_up(num_items, block_size)
+     || size < header_size + (num_blocks + 1) * sizeof(uint64_t))
+    {
+        throw std::runtime_error("Invalid compressed data file");
+    }
+
+    char const* offsets = in + header_size;
+    char const* blocks = offsets + (num_blocks + 1) * sizeof(uint64_t);
+    size_t payload_size = size - (blocks - in);
+
+    if (get_u64(offsets + num_blocks * sizeof(uint64_t)) > payload_size)
+    {
+        throw std::runtime_error("Invalid compressed data file");
+    }
+
+    auto decode_range = [&](size_t b)
+    {
+        uint64_t first_byte = get_u64(offsets + b * sizeof(uint64_t));
+        uint64_t last_byte = get_u64(offsets + (b + 1) * sizeof(uint64_t));
+
+        if (first_byte > last_byte || last_byte > payload_size)
+        {
+            throw std::runtime_error("Invalid compressed data file");
+        }
+
+        size_t first = b * block_size;
+        size_t last = std::min(first + block_size, num_items);
+
+        decode_block(md, blocks + first_byte, blocks + last_byte, dst, first, last);
+    };
+
+    for_each_block(pool, num_blocks, decode_range);
+}
+
+} // blocked
+} // data_file
+} // visionaray
@@ -0,0 +1,279 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_DATA_FILE_H
+#define VSNRAY_COMMON_DATA_FILE_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/bimap.hpp>
+
+#include <visionaray/detail/thread_pool.h>
+
+namespace visionaray
+{
+namespace data_file
+{
+
+//-------------------------------------------------------------------------------------------------
+// (included) data file meta data
+//
+
+struct meta_data
+{
+    enum encoding_t
+    {
+        Ascii,
+        Binary
+    };
+
+    // VecN are binary compatible w/ visionaray::vecN
+    enum data_type_t
+    {
+        U8,
+        Float,
+        Vec2u8,
+        Vec2f,
+        Vec3u8,
+        Vec3f,
+        Vec4u8,
+        Vec4f,
+        I32,
+    };
+
+    static boost::bimap<data_type_t, std::string> data_type_map;
+
+    enum compression_t
+    {
+        Raw,
+        Delta,
+        Quantized
+    };
+
+    static boost::bimap<compression_t, std::string> compression_map;
+
+    enum byte_order_t
+    {
+        LittleEndian,
+        BigEndian
+    };
+
+    std::string   path;
+    encoding_t    encoding    = Binary;
+    data_type_t   data_type   = U8;
+    int           num_items   = 0;
+    compression_t compression = Raw;
+    byte_order_t  byte_order  = LittleEndian;
+    char          separator   = ' ';
+
+    // Number of scalar components per item
+    static size_t num_components(data_type_t dt)
+    {
+        switch (dt)
+        {
+        case U8:     // fall-through
+        case Float:  // fall-through
+        case I32:    return 1;
+        case Vec2u8: // fall-through
+        case Vec2f:  return 2;
+        case Vec3u8: // fall-through
+        case Vec3f:  return 3;
+        case Vec4u8: // fall-through
+        case Vec4f:  return 4;
+        }
+
+        return 0;
+    }
+
+    // Size in bytes of a single scalar component
+    static size_t word_size(data_type_t dt)
+    {
+        switch (dt)
+        {
+        case U8:     // fall-through
+        case Vec2u8: // fall-through
+        case Vec3u8: // fall-through
+        case Vec4u8: return 1;
+        case Float:  // fall-through
+        case Vec2f:  // fall-through
+        case Vec3f:  // fall-through
+        case Vec4f:  return sizeof(float);
+        case I32:    return sizeof(int32_t);
+        }
+
+        return 0;
+    }
+
+    static bool is_floating_point(data_type_t dt)
+    {
+        return dt == Float || dt == Vec2f || dt == Vec3f || dt == Vec4f;
+    }
+
+    static byte_order_t host_byte_order()
+    {
+        uint32_t i = 1;
+        unsigned char c = 0;
+        std::memcpy(&c, &i, 1);
+        return c == 1 ? LittleEndian : BigEndian;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Read-only view of the payload of a binary data file
+//
+// The file is memory-mapped and the items are accessed in place. The
+// payload is only copied (into properly aligned memory) if the mapping
+// is not suitably aligned for T, or if the file was written on a host
+// with a different byte order and the words have to be swapped.
+//
+
+template <typename T>
+class binary_view
+{
+public:
+
+    explicit binary_view(meta_data const& md)
+        : file_(md.path)
+        , size_(file_.size() / sizeof(T))
+    {
+        char const* bytes = file_.data();
+        size_t word_size = meta_data::word_size(md.data_type);
+
+        bool swap = md.byte_order != meta_data::host_byte_order() && word_size > 1;
+        bool misaligned = reinterpret_cast<uintptr_t>(bytes) % alignof(T) != 0;
+
+        if (swap || misaligned)
+        {
+            copy_.resize(size_);
+            char* dst = reinterpret_cast<char*>(copy_.data());
+            std::memcpy(dst, bytes, size_ * sizeof(T));
+
+            if (swap)
+            {
+                for (size_t i = 0; i + word_size <= size_ * sizeof(T); i += word_size)
+                {
+                    std::reverse(dst + i, dst + i + word_size);
+                }
+            }
+
+            data_ = copy_.data();
+        }
+        else
+        {
+            data_ = reinterpret_cast<T const*>(bytes);
+        }
+    }
+
+    T const* data() const { return data_; }
+    T const* begin() const { return data_; }
+    T const* end() const { return data_ + size_; }
+
+    size_t size() const { return size_; }
+
+    // True if the items are accessed directly through the file mapping
+    bool mapped() const { return copy_.empty(); }
+
+private:
+
+    boost::iostreams::mapped_file_source file_;
+    size_t size_ = 0;
+    std::vector<T> copy_;
+    T const* data_ = nullptr;
+
+};
+
+//-------------------------------------------------------------------------------------------------
+// Block-compressed data streams
+//
+// Layout (all multi-byte values little-endian):
+//
+//  char[4]     magic ("VSNB")
+//  uint32      version
+//  uint32      compression
+//  uint32      data_type
+//  uint32      num_items
+//  uint32      items_per_block
+//  uint32      num_blocks
+//  uint64[]    num_blocks + 1 byte offsets of the blocks, relative to the first block
+//  block[]     independently decodable blocks
+//
+// Delta (lossless): each scalar word is coded relative to the same component of the
+// previous item in the block. Integer words store the zig-zag encoded difference,
+// floating point words the XOR with their predecessor. Differences are stored as
+// LEB128 varints.
+//
+// Quantized (lossy, finite floating point data only): each block stores the
+// per-component min and max of the whole stream, the scalar words are quantized
+// to 16 bits inside that range and are then delta coded like integer words. All
+// blocks use the same range, so that equal values (e.g. vertices shared by
+// triangles in different blocks) decode to equal values.
+//
+
+namespace blocked
+{
+
+static char const magic[4] = { 'V', 'S', 'N', 'B' };
+static uint32_t const version = 1;
+static uint32_t const items_per_block = 4096;
+static size_t const header_size = 4 + 6 * sizeof(uint32_t);
+
+
+//-------------------------------------------------------------------------------------------------
+// Worker threads shared by all data files of a load or save operation
+//
+// The threads are only started when the first data file with more than one
+// block is encoded or decoded.
+//
+
+class worker_pool
+{
+public:
+
+    thread_pool& get()
+    {
+        if (pool_ == nullptr)
+        {
+            pool_.reset(new thread_pool(std::max(1U, std::thread::hardware_concurrency())));
+        }
+
+        return *pool_;
+    }
+
+private:
+
+    std::unique_ptr<thread_pool> pool_;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Interface
+//
+
+// Encode md.num_items items stored at src (host byte order). Throws std::runtime_error
+// if md requests quantization and the data is not finite floating point data
+std::vector<char> encode(meta_data const& md, char const* src, worker_pool& pool);
+
+// True if the md.num_items items stored at src can be encoded with quantization
+bool can_quantize(meta_data const& md, char const* src);
+
+// Decode compressed stream [in,in+size) into dst, dst must hold md.num_items items.
+// Throws std::runtime_error if the stream is invalid or does not match md
+void decode(meta_data const& md, char const* in, size_t size, char* dst, worker_pool& pool);
+
+} // blocked
+} // data_file
+} // visionaray
+
+#endif // VSNRAY_COMMON_DATA_FILE_H
@@ -73,6 +73,11 @@ static void store_rgba32f(
 }
 #endif // VSNRAY_COMMON_HAVE_OPENEXR
 
+exr_image::exr_image(int width, int height, pixel_format format, uint8_t const* data)
+    : image_base(width, height, format, data)
+{
+}
+
 bool exr_image::load(std::string const& filename)
 {
 #if VSNRAY_COMMON_HAVE_OPENEXR
@@ -124,4 +129,64 @@ bool exr_image::load(std::string const& filename)
 #endif
 }
 
+bool exr_image::save(std::string const& filename, file_base::save_options const& options)
+{
+#if VSNRAY_COMMON_HAVE_OPENEXR
+    VSNRAY_UNUSED(options);
+
+    if (format_ != PF_RGB32F && format_ != PF_RGBA32F)
+    {
+        std::cerr << "Error: unsupported pixel format\n";
+        return false;
+    }
+
+    Imf::Array2D<Imf::Rgba> pixels(height_, width_);
+
+    for (int y = 0; y < height_; ++y)
+    {
+        for (int x = 0; x < width_; ++x)
+        {
+            if (format_ == PF_RGBA32F)
+            {
+                vec4 const* arr = reinterpret_cast<vec4 const*>(data_.data());
+                vec4 c = arr[y * width_ + x];
+                pixels[y][x] = Imf::Rgba(c.x, c.y, c.z, c.w);
+            }
+            else
+            {
+                vec3 const* arr = reinterpret_cast<vec3 const*>(data_.data());
+                vec3 c = arr[y * width_ + x];
+                pixels[y][x] = Imf::Rgba(c.x, c.y, c.z, 1.0f);
+            }
+        }
+    }
+
+    try
+    {
+        Imf::RgbaOutputFile file(
+                filename.c_str(),
+                width_,
+                height_,
+                format_ == PF_RGBA32F ? Imf::WRITE_RGBA : Imf::WRITE_RGB
+                );
+
+        file.setFrameBuffer(&pixels[0][0], 1, width_);
+        file.writePixels(height_);
+
+        return true;
+    }
+    catch(Iex::BaseExc& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+
+        return false;
+    }
+#else
+    VSNRAY_UNUSED(filename);
+    VSNRAY_UNUSED(options);
+
+    return false;
+#endif
+}
+
 } // visionaray
@@ -1,14 +1,20 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
+#include <cstring>
+#include <exception>
 #include <iostream>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "hdr_image.h"
@@ -16,15 +22,61 @@
 namespace visionaray
 {
 
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+// Reads the next line from the mapped file, advances pos past the line break
+static bool get_line(char const* data, size_t size, size_t& pos, std::string& line)
+{
+    if (pos >= size)
+    {
+        return false;
+    }
+
+    char const* first = data + pos;
+    char const* last = static_cast<char const*>(std::memchr(first, '\n', size - pos));
+
+    if (last == nullptr)
+    {
+        last = data + size;
+    }
+
+    line.assign(first, last);
+    pos = std::min(size, static_cast<size_t>(last - data) + 1);
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// hdr_image
+//
+
 bool hdr_image::load(std::string const& filename)
 {
-    std::ifstream file(filename);
+    // Decode straight from the mapped file. Mapping throws if the
+    // file doesn't exist or is empty
+    boost::iostreams::mapped_file_source file;
+
+    try
+    {
+        file.open(filename);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Cannot open file " << filename << ": " << e.what() << '\n';
+        return false;
+    }
+
+    char const* bytes = file.data();
+    size_t size = file.size();
+    size_t pos = 0;
 
     // parse information header ---------------------------
 
     std::string line;
 
-    std::getline(file, line);
+    get_line(bytes, size, pos, line);
 
     if (line != "#?RADIANCE")
     {
@@ -32,12 +84,13 @@ bool hdr_image::load(std::string const& filename)
         return false;
     }
 
-    enum cformat { RGBE, XYZE };
-    cformat format = RGBE;
-
     while (!line.empty())
     {
-        std::getline(file, line);
+        if (!get_line(bytes, size, pos, line))
+        {
+            std::cerr << "Error: invalid HDR file header\n";
+            return false;
+        }
 
         std::vector<std::string> vars;
         boost::split(vars, line, boost::is_any_of("="));
@@ -49,17 +102,12 @@ bool hdr_image::load(std::string const& filename)
             vars.erase(vars.begin());
             std::string value = boost::algorithm::join(vars, "");
 
-            if (key == "FORMAT" && value == "32-bit_rle_rgbe")
-            {
-                format = RGBE;
-            }
-            else if (key == "FORMAT" && value == "32-bit_rle_xyze")
+            if (key == "FORMAT" && value == "32-bit_rle_xyze")
             {
-                format = XYZE;
                 std::cerr << "Error: XYZE format in HDR files not yet supported\n";
                 return false;
             }
-            else if (key == "FORMAT")
+            else if (key == "FORMAT" && value != "32-bit_rle_rgbe")
             {
                 std::cerr << "Error: unsupported format string in HDR file\n";
                 return false;
@@ -69,7 +117,7 @@ bool hdr_image::load(std::string const& filename)
 
     // resolution string ----------------------------------
 
-    std::getline(file, line);
+    get_line(bytes, size, pos, line);
 
     std::vector<std::string> res;
     boost::split(res, line, boost::is_any_of("\t "));
@@ -99,64 +147,81 @@ bool hdr_image::load(std::string const& filename)
 
     // scanlines ------------------------------------------
 
+    uint8_t const* in = reinterpret_cast<uint8_t const*>(bytes) + pos;
+    uint8_t const* end = reinterpret_cast<uint8_t const*>(bytes) + size;
+
+    using RGBE = std::array<uint8_t, 4>;
+    std::vector<RGBE> rgbe(width_);
+
     for (int y = 0; y < height_; ++y)
     {
         // Read the scanline header
         // two bytes equal 2 indicate new format
         // followed by upper and lower byte of
         // the scanline length (< 32768)
-        uint8_t header[4];
-        file.read((char*)&header, sizeof(header));
+        if (end - in < 4)
+        {
+            std::cerr << "Error: unexpected end of HDR file\n";
+            return false;
+        }
+
+        uint8_t const* header = in;
+        in += 4;
 
         if (header[0] == 2 && header[1] == 2)
         {
             unsigned len = (header[2] << 8) | header[3];
 
-            using RGBE = std::array<uint8_t, 4>;
-            std::vector<RGBE> rgbe(len);
+            if (len != static_cast<unsigned>(width_))
+            {
+                std::cerr << "Error: invalid scanline length in HDR file\n";
+                return false;
+            }
 
             for (unsigned c = 0; c < 4; ++c)
             {
-                uint8_t rl = 0;
-                uint8_t bytes[128];
                 unsigned x = 0;
 
                 while (x < len)
                 {
-                    file.read((char*)&rl, sizeof(rl));
+                    if (in == end)
+                    {
+                        std::cerr << "Error: unexpected end of HDR file\n";
+                        return false;
+                    }
 
-                    unsigned num_pixels = 0;
+                    uint8_t rl = *in++;
 
-                    if (rl > 128)
+                    unsigned num_pixels = rl > 128 ? rl & 127 : rl;
+
+                    if (num_pixels == 0 || x + num_pixels > len)
                     {
-                        // This is a run
-                        num_pixels = rl & 127;
-                        file.read((char*)bytes, 1);
-
-                        for (unsigned i = 0; i < num_pixels; ++i)
-                        {
-                            rgbe[x + i][c] = bytes[0];
-                        }
+                        std::cerr << "Error: invalid run length in HDR file\n";
+                        return false;
                     }
-                    else
+
+                    size_t num_bytes = rl > 128 ? 1 : num_pixels;
+
+                    if (static_cast<size_t>(end - in) < num_bytes)
                     {
-                        num_pixels = rl;
-                        file.read((char*)bytes, num_pixels);
+                        std::cerr << "Error: unexpected end of HDR file\n";
+                        return false;
+                    }
 
-                        for (unsigned i = 0; i < num_pixels; ++i)
-                        {
-                            rgbe[x + i][c] = bytes[i];
-                        }
+                    for (unsigned i = 0; i < num_pixels; ++i)
+                    {
+                        // Runs repeat a single byte
+                        rgbe[x + i][c] = rl > 128 ? in[0] : in[i];
                     }
 
+                    in += num_bytes;
                     x += num_pixels;
                 }
             }
 
             for (unsigned x = 0; x < len; ++x)
             {
-                float e = rgbe[x][3] - 128;
-                float be = powf(2.0f, e);
+                float be = std::ldexp(1.0f, rgbe[x][3] - 128);
                 *data++ = (rgbe[x][0] / 256.0f) * be;
                 *data++ = (rgbe[x][1] / 256.0f) * be;
                 *data++ = (rgbe[x][2] / 256.0f) * be;
@@ -0,0 +1,257 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "image_loader.h"
+
+namespace visionaray
+{
+
+//-------------------------------------------------------------------------------------------------
+// image_loader private implementation
+//
+
+struct image_loader::impl
+{
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_done;
+
+    std::deque<std::function<void()>> queue;
+    size_t active = 0;
+    bool stop = false;
+
+    std::vector<std::thread> threads;
+
+    // Type-erased futures of all requests so far
+    std::unordered_map<std::string, std::shared_ptr<void>> requests;
+
+    statistics stats;
+
+    void thread_loop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> l(mutex);
+                work_available.wait(l, [this]() { return stop || !queue.empty(); });
+
+                // Drain the queue before stopping
+                if (queue.empty())
+                {
+                    return;
+                }
+
+                task = std::move(queue.front());
+                queue.pop_front();
+                ++active;
+            }
+
+            task();
+
+            {
+                std::unique_lock<std::mutex> l(mutex);
+                --active;
+
+                if (queue.empty() && active == 0)
+                {
+                    work_done.notify_all();
+                }
+            }
+        }
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// image_loader
+//
+
+image_loader::image_loader(unsigned num_threads)
+    : impl_(new impl)
+{
+    if (num_threads == 0)
+    {
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned i = 0; i < num_threads; ++i)
+    {
+        impl_->threads.emplace_back([this]() { impl_->thread_loop(); });
+    }
+}
+
+image_loader::~image_loader()
+{
+    {
+        std::unique_lock<std::mutex> l(impl_->mutex);
+        impl_->stop = true;
+    }
+
+    impl_->work_available.notify_all();
+
+    for (auto& t : impl_->threads)
+    {
+        t.join();
+    }
+}
+
+image_loader::future<image> image_loader::load(std::string const& filename)
+{
+    auto promise = std::make_shared<std::promise<std::shared_ptr<image>>>();
+    future<image> result = promise->get_future().share();
+
+    auto existing = insert_request(filename, typeid(image), std::make_shared<future<image>>(result));
+
+    if (existing != nullptr)
+    {
+        return *std::static_pointer_cast<future<image>>(existing);
+    }
+
+    enqueue([this, promise, filename]()
+    {
+        std::shared_ptr<image> img = nullptr;
+
+        try
+        {
+            img = std::make_shared<image>();
+
+            if (!decode(filename, *img))
+            {
+                img = nullptr;
+            }
+        }
+        catch (std::exception& e)
+        {
+            img = nullptr;
+            report_failure(filename, e.what());
+        }
+
+        promise->set_value(img);
+    });
+
+    return result;
+}
+
+void image_loader::wait()
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    impl_->work_done.wait(l, [this]() { return impl_->queue.empty() && impl_->active == 0; });
+}
+
+unsigned image_loader::num_threads() const
+{
+    return static_cast<unsigned>(impl_->threads.size());
+}
+
+image_loader::statistics image_loader::stats() const
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    return impl_->stats;
+}
+
+std::shared_ptr<void> image_loader::insert_request(
+        std::string const&      filename,
+        std::type_info const&   type,
+        std::shared_ptr<void>   fut
+        )
+{
+    std::string fn(filename);
+    std::replace(fn.begin(), fn.end(), '\\', '/');
+
+    // Resolve relative paths and links, so that different spellings of
+    // the same file share a request
+    boost::system::error_code ec;
+    auto p = boost::filesystem::canonical(fn, ec);
+
+    if (!ec)
+    {
+        fn = p.string();
+    }
+
+    std::string key = fn + '\n' + type.name();
+
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    ++impl_->stats.requests;
+
+    auto r = impl_->requests.insert({ key, fut });
+
+    if (!r.second)
+    {
+        return r.first->second;
+    }
+
+    ++impl_->stats.decodes;
+
+    return nullptr;
+}
+
+void image_loader::enqueue(std::function<void()> task)
+{
+    {
+        std::unique_lock<std::mutex> l(impl_->mutex);
+        impl_->queue.push_back(std::move(task));
+    }
+
+    impl_->work_available.notify_one();
+}
+
+bool image_loader::decode(std::string const& filename, image& img)
+{
+    bool ok = false;
+
+    try
+    {
+        ok = img.load(filename);
+    }
+    catch (std::exception& e)
+    {
+        report_failure(filename, e.what());
+        return false;
+    }
+    catch (...)
+    {
+        report_failure(filename);
+        return false;
+    }
+
+    if (!ok)
+    {
+        report_failure(filename);
+    }
+
+    return ok;
+}
+
+void image_loader::report_failure(std::string const& filename, char const* what)
+{
+    if (what != nullptr)
+    {
+        std::cerr << "Error loading image " << filename << ": " << what << '\n';
+    }
+    else
+    {
+        std::cerr << "Warning: cannot load image from file: " << filename << '\n';
+    }
+
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    ++impl_->stats.failures;
+}
+
+} // visionaray
@@ -0,0 +1,146 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_IMAGE_LOADER_H
+#define VSNRAY_COMMON_IMAGE_LOADER_H 1
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#include "image.h"
+#include "make_texture.h"
+
+namespace visionaray
+{
+
+//-------------------------------------------------------------------------------------------------
+// Asynchronous image and texture loading
+//
+// Requests are queued and decoded by a pool of worker threads, the caller receives
+// a future. Requests for the same file share a single decode. load_texture() also
+// converts the decoded image to the texture's storage format on the worker thread
+// (see make_texture()), the intermediate image is released right after that.
+//
+// Files that cannot be loaded yield a nullptr. The destructor completes all
+// requests that are still queued.
+//
+
+class image_loader
+{
+public:
+
+    template <typename T>
+    using future = std::shared_future<std::shared_ptr<T>>;
+
+    struct statistics
+    {
+        size_t requests = 0;    // calls to load() and load_texture()
+        size_t decodes  = 0;    // unique requests, each decodes a file once
+        size_t failures = 0;    // decodes that yielded a nullptr
+    };
+
+public:
+
+    // num_threads == 0: one worker per hardware thread
+    explicit image_loader(unsigned num_threads = 0);
+   ~image_loader();
+
+    image_loader(image_loader const&) = delete;
+    image_loader& operator=(image_loader const&) = delete;
+
+    future<image> load(std::string const& filename);
+
+    // Texture must be constructible from width and height and have a make_texture() overload
+    template <typename Texture>
+    future<Texture> load_texture(std::string const& filename);
+
+    // Blocks until all queued requests are done
+    void wait();
+
+    unsigned num_threads() const;
+
+    statistics stats() const;
+
+private:
+
+    // Requests are identified by the canonical path and the result type; returns the
+    // future of an existing request, or nullptr if the request was inserted
+    std::shared_ptr<void> insert_request(
+            std::string const&      filename,
+            std::type_info const&   type,
+            std::shared_ptr<void>   fut
+            );
+
+    void enqueue(std::function<void()> task);
+
+    // Called from the workers, catches all exceptions from the decoders
+    bool decode(std::string const& filename, image& img);
+
+    // Logs a failed request and counts it in the statistics
+    void report_failure(std::string const& filename, char const* what = nullptr);
+
+    // Lock, request map, queue and worker threads
+    struct impl;
+    std::unique_ptr<impl> impl_;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation of template functions
+//
+
+template <typename Texture>
+inline image_loader::future<Texture> image_loader::load_texture(std::string const& filename)
+{
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Texture>>>();
+    future<Texture> result = promise->get_future().share();
+
+    auto existing = insert_request(filename, typeid(Texture), std::make_shared<future<Texture>>(result));
+
+    if (existing != nullptr)
+    {
+        return *std::static_pointer_cast<future<Texture>>(existing);
+    }
+
+    enqueue([this, promise, filename]()
+    {
+        std::shared_ptr<Texture> tex = nullptr;
+
+        // Allocating and converting the texture may throw as well
+        try
+        {
+            image img;
+            if (decode(filename, img))
+            {
+                tex = std::make_shared<Texture>(img.width(), img.height());
+                make_texture(*tex, img);
+            }
+        }
+        catch (std::exception& e)
+        {
+            tex = nullptr;
+            report_failure(filename, e.what());
+        }
+        catch (...)
+        {
+            tex = nullptr;
+            report_failure(filename);
+        }
+
+        promise->set_value(tex);
+    });
+
+    return result;
+}
+
+} // visionaray
+
+#endif // VSNRAY_COMMON_IMAGE_LOADER_H
@@ -9,6 +9,7 @@
 #include <memory>
 #include <ostream>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/iostreams/device/mapped_file.hpp>
@@ -29,6 +30,7 @@
 
 #include "cfile.h"
 #include "image.h"
+#include "image_loader.h"
 #include "make_texture.h"
 #include "moana_loader.h"
 #include "model.h"
@@ -348,6 +350,12 @@ static void load_light_file(
     rapidjson::Document doc;
     doc.ParseStream(frs);
 
+    // Dome light textures are decoded in parallel
+    image_loader loader;
+
+    using environment_texture = sg::texture2d<vec4>;
+    std::vector<std::pair<std::shared_ptr<sg::environment_light>, image_loader::future<image>>> pending;
+
     for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it)
     {
         auto entry = it->value.GetObject();
@@ -370,29 +378,33 @@ static void load_light_file(
 
             if (!map.empty())
             {
-                std::shared_ptr<sg::texture2d<vec4>> tex = std::make_shared<sg::texture2d<vec4>>();
-
                 boost::filesystem::path image_filename = island_base_path; // remove leading "island"
                 image_filename /= remove_first(map);
 
-                image img;
-                if (img.load(image_filename.string()))
-                {
-                    assert(img.format() == PF_RGBA32F);
-
-                    tex->resize(img.width(), img.height());
-                    tex->set_address_mode(Wrap);
-                    tex->set_filter_mode(Linear);
-                    make_texture(*tex, img);
-
-                    auto el = std::dynamic_pointer_cast<sg::environment_light>(light);
-                    el->texture() = tex;
-                }
+                auto el = std::dynamic_pointer_cast<sg::environment_light>(light);
+                pending.push_back(std::make_pair(el, loader.load(image_filename.string())));
             }
         }
 
         root->add_child(light);
     }
+
+    for (auto& p : pending)
+    {
+        auto img = p.second.get();
+
+        if (img != nullptr)
+        {
+            assert(img->format() == PF_RGBA32F);
+
+            auto tex = std::make_shared<environment_texture>(img->width(), img->height());
+            tex->set_address_mode(Wrap);
+            tex->set_filter_mode(Linear);
+            make_texture(*tex, *img);
+
+            p.first->texture() = tex;
+        }
+    }
 }
 
 
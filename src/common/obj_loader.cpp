@@ -8,6 +8,7 @@
 #include <ostream>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
@@ -19,8 +20,7 @@
 #include <visionaray/math/vector.h>
 #include <visionaray/texture/texture.h>
 
-#include "image.h"
-#include "make_texture.h"
+#include "image_loader.h"
 #include "model.h"
 #include "obj_grammar.h"
 #include "obj_loader.h"
@@ -319,6 +319,13 @@ void load_obj(std::vector<std::string> const& filenames, model& mod)
     string_ref mtl_file;
     string_ref mtl_name;
 
+    // Textures are decoded in parallel while parsing
+    image_loader loader;
+    std::map<std::string, image_loader::future<model::texture_type>> pending_textures;
+
+    // Indices into mod.textures that refer to pending textures
+    std::vector<std::pair<size_t, std::string>> texture_refs;
+
     for (auto filename : filenames)
     {
         boost::iostreams::mapped_file_source file(filename);
@@ -419,33 +426,28 @@ void load_obj(std::vector<std::string> const& filenames, model& mod)
 
                         if (boost::filesystem::exists(tex_filename))
                         {
-                            // Load the texture if we haven't done so yet
                             auto tex_it = mod.texture_map.find(mat_it->second.map_kd);
-                            if (tex_it == mod.texture_map.end())
-                            {
-                                image img;
-                                if (img.load(tex_filename))
-                                {
-                                    model::texture_type tex(img.width(), img.height());
-                                    make_texture(tex, img);
-
-                                    mod.texture_map.insert(std::make_pair(mat_it->second.map_kd, std::move(tex)));
-                                    // Will be ref()'d below
-                                    tex_it = mod.texture_map.find(mat_it->second.map_kd);
-                                }
-                                else
-                                {
-                                    std::cerr << "Warning: cannot load texture from file: " << tex_filename << '\n';
-                                }
-                            }
-
                             if (tex_it != mod.texture_map.end())
                             {
-                                // File was already present in map or was
-                                // just loaded. Push a reference to it!
+                                // File was already present in map. Push a reference to it!
                                 auto& loaded_tex = tex_it->second;
                                 mod.textures.push_back(tex_type::ref_type(loaded_tex));
                             }
+                            else
+                            {
+                                // Load the texture in the background if we haven't requested
+                                // it yet, a dummy is replaced with it after parsing
+                                if (pending_textures.find(mat_it->second.map_kd) == pending_textures.end())
+                                {
+                                    pending_textures.insert(std::make_pair(
+                                            mat_it->second.map_kd,
+                                            loader.load_texture<tex_type>(tex_filename)
+                                            ));
+                                }
+
+                                insert_dummy_texture(mod);
+                                texture_refs.push_back(std::make_pair(mod.textures.size() - 1, mat_it->second.map_kd));
+                            }
                         }
                         else
                         {
@@ -503,6 +505,27 @@ void load_obj(std::vector<std::string> const& filenames, model& mod)
         }
     }
 
+    // Wait for the textures, replace the dummies with refs to them
+    for (auto& pt : pending_textures)
+    {
+        auto tex = pt.second.get();
+
+        if (tex != nullptr)
+        {
+            mod.texture_map.insert(std::make_pair(pt.first, std::move(*tex)));
+        }
+    }
+
+    for (auto const& tr : texture_refs)
+    {
+        auto tex_it = mod.texture_map.find(tr.second);
+
+        if (tex_it != mod.texture_map.end())
+        {
+            mod.textures[tr.first] = model::texture_type::ref_type(tex_it->second);
+        }
+    }
+
     // Calculate geometric normals
     for (auto const& tri : mod.primitives)
     {
@@ -8,6 +8,8 @@
 #include <cstring> // memcpy
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -24,6 +26,7 @@
 #include <visionaray/math/vector.h>
 
 #include "image.h"
+#include "image_loader.h"
 #include "make_texture.h"
 #include "model.h"
 #include "sg.h"
@@ -35,10 +38,75 @@ namespace visionaray
 
 using namespace pbrt;
 
+//-------------------------------------------------------------------------------------------------
+// Image textures are decoded in the background while the scene graph is built,
+// their nodes are filled in when it is complete
+//
+
+struct texture_requests
+{
+    using diffuse_texture = sg::texture2d<vector<4, unorm<8>>>;
+
+    image_loader loader;
+
+    std::vector<std::pair<std::shared_ptr<diffuse_texture>, image_loader::future<image>>> diffuse;
+
+    // Environment lights are only added if their texture can be loaded
+    struct environment
+    {
+        sg::node* parent;
+        std::shared_ptr<sg::environment_light> light;
+        image_loader::future<image> img;
+    };
+
+    std::vector<environment> environments;
+
+    void finish()
+    {
+        for (auto& d : diffuse)
+        {
+            auto img = d.second.get();
+
+            if (img != nullptr)
+            {
+                d.first->resize(img->width(), img->height());
+                make_texture(*d.first, *img);
+            }
+            else
+            {
+                // Node is already referenced, make it a white dummy
+                vector<4, unorm<8>> dummy_texel(1.0f, 1.0f, 1.0f, 1.0f);
+                d.first->resize(1, 1);
+                d.first->set_address_mode(Wrap);
+                d.first->set_filter_mode(Nearest);
+                d.first->reset(&dummy_texel);
+            }
+        }
+
+        for (auto& e : environments)
+        {
+            auto img = e.img.get();
+
+            if (img != nullptr)
+            {
+                auto tex = std::dynamic_pointer_cast<sg::texture2d<vec4>>(e.light->texture());
+                tex->resize(img->width(), img->height());
+                make_texture(*tex, *img);
+
+                e.parent->add_child(e.light);
+            }
+        }
+
+        diffuse.clear();
+        environments.clear();
+    }
+};
+
 static void add_diffuse_texture(
         std::shared_ptr<sg::surface_properties>& sp,
         Texture::SP texture,
-        std::string base_filename
+        std::string base_filename,
+        texture_requests& requests
         )
 {
     if (auto t = std::dynamic_pointer_cast<ImageTexture>(texture))
@@ -73,16 +141,12 @@ static void add_diffuse_texture(
 
         if (boost::filesystem::exists(tex_filename))
         {
-            image img;
-            if (img.load(tex_filename))
-            {
-                auto tex = std::make_shared<sg::texture2d<vector<4, unorm<8>>>>();
-                tex->resize(img.width(), img.height());
-                tex->name() = t->fileName;
-                make_texture(*tex, img);
+            auto tex = std::make_shared<texture_requests::diffuse_texture>();
+            tex->name() = t->fileName;
 
-                sp->add_texture(tex, "diffuse");
-            }
+            requests.diffuse.push_back(std::make_pair(tex, requests.loader.load(tex_filename)));
+
+            sp->add_texture(tex, "diffuse");
         }
     }
     else if (auto t = std::dynamic_pointer_cast<ConstantTexture>(texture))
@@ -126,7 +190,11 @@ static mat4 make_mat4(affine3f const& aff)
     return result;
 }
 
-static std::shared_ptr<sg::surface_properties> make_surface_properties(Shape::SP shape, std::string base_filename)
+static std::shared_ptr<sg::surface_properties> make_surface_properties(
+        Shape::SP shape,
+        std::string base_filename,
+        texture_requests& requests
+        )
 {
     auto sp = std::make_shared<sg::surface_properties>();
 
@@ -188,7 +256,7 @@ static std::shared_ptr<sg::surface_properties> make_surface_properties(Shape::SP
 
         sp->material() = obj;
 
-        add_diffuse_texture(sp, m->map_kd, base_filename);
+        add_diffuse_texture(sp, m->map_kd, base_filename, requests);
     }
     else if (auto m = std::dynamic_pointer_cast<SubstrateMaterial>(shape->material))
     {
@@ -204,7 +272,7 @@ static std::shared_ptr<sg::surface_properties> make_surface_properties(Shape::SP
 
         sp->material() = obj;
 
-        add_diffuse_texture(sp, m->map_kd, base_filename);
+        add_diffuse_texture(sp, m->map_kd, base_filename, requests);
     }
     else if (auto m = std::dynamic_pointer_cast<MirrorMaterial>(shape->material))
     {
@@ -228,7 +296,7 @@ static std::shared_ptr<sg::surface_properties> make_surface_properties(Shape::SP
 
         sp->material() = obj;
 
-        add_diffuse_texture(sp, m->map_kd, base_filename);
+        add_diffuse_texture(sp, m->map_kd, base_filename, requests);
     }
     else if (auto m = std::dynamic_pointer_cast<GlassMaterial>(shape->material))
     {
@@ -255,7 +323,7 @@ static std::shared_ptr<sg::surface_properties> make_surface_properties(Shape::SP
         obj->specular_exp = m->roughness;
         sp->material() = obj;
 
-        add_diffuse_texture(sp, m->map_kd, base_filename);
+        add_diffuse_texture(sp, m->map_kd, base_filename, requests);
     }
     else if (auto m = std::dynamic_pointer_cast<MixMaterial>(shape->material))
     {
@@ -273,7 +341,7 @@ static std::shared_ptr<sg::surface_properties> make_surface_properties(Shape::SP
             obj->specular_exp = m0->roughness;
             sp->material() = obj;
 
-            add_diffuse_texture(sp, m0->map_kd, base_filename);
+            add_diffuse_texture(sp, m0->map_kd, base_filename, requests);
         }
     }
     else
@@ -290,7 +358,8 @@ static void make_scene_graph(
         sg::node& parent,
         std::unordered_map<Shape::SP, std::shared_ptr<sg::indexed_triangle_mesh>>& shape2itm,
         std::unordered_map<Material::SP, std::shared_ptr<sg::surface_properties>>& mat2prop,
-        std::string base_filename
+        std::string base_filename,
+        texture_requests& requests
         )
 {
     for (auto shape : object->shapes)
@@ -342,7 +411,7 @@ static void make_scene_graph(
                 }
                 else
                 {
-                    sp = make_surface_properties(sphere, base_filename);
+                    sp = make_surface_properties(sphere, base_filename, requests);
                     mat2prop.insert({ sphere->material, sp });
                 }
             }
@@ -473,7 +542,7 @@ static void make_scene_graph(
                 }
                 else
                 {
-                    sp = make_surface_properties(mesh, base_filename);
+                    sp = make_surface_properties(mesh, base_filename, requests);
                     mat2prop.insert({ mesh->material, sp });
                 }
             }
@@ -504,7 +573,7 @@ static void make_scene_graph(
 
         trans->matrix() = make_mat4(inst->xfm);
 
-        make_scene_graph(inst->object, *trans, shape2itm, mat2prop, base_filename);
+        make_scene_graph(inst->object, *trans, shape2itm, mat2prop, base_filename, requests);
 
         parent.add_child(trans);
     }
@@ -543,23 +612,17 @@ static void make_scene_graph(
 
             if (boost::filesystem::exists(tex_filename))
             {
-                image img;
-                if (img.load(tex_filename))
-                {
-                    auto tex = std::make_shared<sg::texture2d<vec4>>();
-                    tex->resize(img.width(), img.height());
-                    tex->name() = ils->mapName;
-                    tex->set_filter_mode(Linear);
-                    tex->set_address_mode(Clamp);
-                    make_texture(*tex, img);
-
-                    auto el = std::make_shared<sg::environment_light>();
-                    el->texture() = tex;
-                    el->scale() = vec3(ils->scale.x, ils->scale.y, ils->scale.z);
-                    el->light_to_world_transform() = make_mat4(ils->transform);
-
-                    parent.add_child(el);
-                }
+                auto tex = std::make_shared<sg::texture2d<vec4>>();
+                tex->name() = ils->mapName;
+                tex->set_filter_mode(Linear);
+                tex->set_address_mode(Clamp);
+
+                auto el = std::make_shared<sg::environment_light>();
+                el->texture() = tex;
+                el->scale() = vec3(ils->scale.x, ils->scale.y, ils->scale.z);
+                el->light_to_world_transform() = make_mat4(ils->transform);
+
+                requests.environments.push_back({ &parent, el, requests.loader.load(tex_filename) });
             }
         }
     }
@@ -600,7 +663,11 @@ void load_pbrt(std::string const& filename, model& mod)
             scene = importPBRT(filename);
         }
 
-        make_scene_graph(scene->world, *root, shape2itm, mat2prop, filename);
+        texture_requests requests;
+
+        make_scene_graph(scene->world, *root, shape2itm, mat2prop, filename, requests);
+
+        requests.finish();
     }
     catch (std::runtime_error& e)
     {
@@ -6,6 +6,8 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <ostream>
@@ -13,6 +15,7 @@
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 #include "pnm_image.h"
 
@@ -23,10 +26,31 @@ namespace visionaray
 // Helper functions
 //
 
+// Reads the next line from the mapped file, advances pos past the line break
+static bool get_line(char const*& pos, char const* end, std::string& line)
+{
+    if (pos >= end)
+    {
+        return false;
+    }
+
+    char const* last = static_cast<char const*>(std::memchr(pos, '\n', end - pos));
+
+    if (last == nullptr)
+    {
+        last = end;
+    }
+
+    line.assign(pos, last);
+    pos = last == end ? end : last + 1;
+    return true;
+}
+
 template <typename AssignFunc>
-static void load_ascii(
+static bool load_ascii(
         uint8_t*        dst,
-        std::ifstream&  file,
+        char const*     pos,
+        char const*     end,
         size_t          pitch,
         size_t          height,
         int             max_value,
@@ -35,47 +59,44 @@ static void load_ascii(
 {
     assert(max_value < 256);    // TODO: 16-bit
 
-    for (size_t y = 0; y < height; ++y)
+    size_t size = pitch * height;
+
+    for (size_t i = 0; i < size; ++i)
     {
-        std::string line;
-        std::getline(file, line);
-
-        std::vector<std::string> tokens;
-        boost::algorithm::split(
-                tokens,
-                line,
-                boost::algorithm::is_any_of(" \t")
-                );
+        // Values are separated by arbitrary whitespace
+        while (pos != end && std::isspace(static_cast<unsigned char>(*pos)))
+        {
+            ++pos;
+        }
 
-        // Remove empty tokens and spaces
-        tokens.erase(
-                std::remove_if(
-                        tokens.begin(),
-                        tokens.end(),
-                        [](std::string str) { return str.empty() || std::isspace(str[0]); }
-                        ),
-                tokens.end()
-                );
+        if (pos == end || !std::isdigit(static_cast<unsigned char>(*pos)))
+        {
+            return false;
+        }
 
-        assert(tokens.size() == pitch);
+        int val = 0;
 
-        for (size_t x = 0; x < pitch; ++x)
+        while (pos != end && std::isdigit(static_cast<unsigned char>(*pos)))
         {
-            int val = std::stoi(tokens[x]);
-            if (max_value != 255)
-            {
-                double n = val / static_cast<double>(max_value); // scale down to [0..1]
-                val = static_cast<int>(n * 255);                 // scale up to [0..255]
-            }
+            val = val * 10 + (*pos++ - '0');
+        }
 
-            dst[y * pitch + x] = assign_func(val);
+        if (max_value != 255)
+        {
+            double n = val / static_cast<double>(max_value); // scale down to [0..1]
+            val = static_cast<int>(n * 255);                 // scale up to [0..255]
         }
+
+        dst[i] = assign_func(val);
     }
+
+    return true;
 }
 
-static void load_binary(
+static bool load_binary(
         uint8_t*        dst,
-        std::ifstream&  file,
+        char const*     pos,
+        char const*     end,
         size_t          pitch,
         size_t          height,
         int             max_value
@@ -83,18 +104,26 @@ static void load_binary(
 {
     assert(max_value < 256);    // TODO: 16-bit
 
-    file.read(reinterpret_cast<char*>(dst), pitch * height);
+    size_t size = height * pitch;
+
+    if (static_cast<size_t>(end - pos) < size)
+    {
+        return false;
+    }
+
+    std::memcpy(dst, pos, size);
 
     if (max_value != 255)
     {
         double scale = (1.0 / max_value) * 255;
 
-        size_t size = height * pitch;
         for (size_t i = 0; i < size; ++i)
         {
             dst[i] = static_cast<uint8_t>(dst[i] * scale);
         }
     }
+
+    return true;
 }
 
 static void save_ascii(
@@ -156,7 +185,22 @@ bool pnm_image::load(std::string const& filename)
 {
     enum format { P1 = 1, P2, P3, P4, P5, P6 };
 
-    std::ifstream file(filename);
+    // Decode straight from the mapped file. Mapping throws if the
+    // file doesn't exist or is empty
+    boost::iostreams::mapped_file_source file;
+
+    try
+    {
+        file.open(filename);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Cannot open file " << filename << ": " << e.what() << '\n';
+        return false;
+    }
+
+    char const* pos = file.data();
+    char const* end = file.data() + file.size();
 
     std::string line;
 
@@ -166,7 +210,7 @@ bool pnm_image::load(std::string const& filename)
     // P2: ASCII gray scale | P5: binary gray scale
     // P3: ASCII RGB        | P6: binary RGB
     //
-    std::getline(file, line);
+    get_line(pos, end, line);
 
     if (line.size() < 2 || line[0] != 'P' || line[1] < '0' || line[1] > '6')
     {
@@ -177,16 +221,20 @@ bool pnm_image::load(std::string const& filename)
     format fmt = static_cast<format>(line[1] - '0');
 
     // Header
-    int header[3]; // width, height, max. value
+    int header[3] = { 0, 0, 255 }; // width, height, max. value
     int index = 0;
 
     bool is_bitmap = (fmt == P1 || fmt == P4);
 
     for (;;)
     {
-        std::getline(file, line);
+        if (!get_line(pos, end, line))
+        {
+            std::cerr << "Invalid pnm file header\n";
+            return false;
+        }
 
-        if (line[0] == '#')
+        if (!line.empty() && line[0] == '#')
         {
             // Skip comments
             continue;
@@ -197,7 +245,14 @@ bool pnm_image::load(std::string const& filename)
             boost::algorithm::split(
                     tokens,
                     line,
-                    boost::algorithm::is_any_of(" \t")
+                    boost::algorithm::is_any_of(" \t\r"),
+                    boost::algorithm::token_compress_on
+                    );
+
+            // Remove empty tokens
+            tokens.erase(
+                    std::remove(tokens.begin(), tokens.end(), std::string()),
+                    tokens.end()
                     );
 
             if (tokens.size() > 3)
@@ -208,13 +263,13 @@ bool pnm_image::load(std::string const& filename)
 
             for (auto t : tokens)
             {
-                header[index++] = std::stoi(t);
-
-                if ((is_bitmap && index > 2) || (!is_bitmap && index > 3))
+                if ((is_bitmap && index >= 2) || (!is_bitmap && index >= 3))
                 {
                     std::cerr << "Invalid pnm file header\n";
                     return false;
                 }
+
+                header[index++] = std::stoi(t);
             }
 
             // BitMap: width and height read ==> break
@@ -237,10 +292,18 @@ bool pnm_image::load(std::string const& filename)
         return false;
     }
 
+    if (header[2] <= 0 || header[2] > 255)
+    {
+        std::cerr << "Unsupported max. value: " << header[2] << '\n';
+        return false;
+    }
+
     width_  = header[0];
     height_ = header[1];
     int max_value = header[2];
 
+    bool ok = false;
+
     switch (fmt)
     {
     default:
@@ -256,9 +319,10 @@ bool pnm_image::load(std::string const& filename)
         data_.resize(width_ * height_);
 
         // black or white
-        load_ascii(
+        ok = load_ascii(
                 data_.data(),
-                file,
+                pos,
+                end,
                 width_,
                 height_,
                 max_value,
@@ -268,16 +332,17 @@ bool pnm_image::load(std::string const& filename)
                         return val ? 0U : 255U;
                     }
                 );
-        return true;
+        break;
 
     case P2:
         format_ = PF_R8;
         data_.resize(width_ * height_);
 
         // single gray component
-        load_ascii(
+        ok = load_ascii(
                 data_.data(),
-                file,
+                pos,
+                end,
                 width_,
                 height_,
                 max_value,
@@ -286,16 +351,17 @@ bool pnm_image::load(std::string const& filename)
                         return static_cast<uint8_t>(val);
                     }
                 );
-        return true;
+        break;
 
     case P3:
         format_ = PF_RGB8;
         data_.resize(width_ * height_ * 3);
 
         // RGB color components
-        load_ascii(
+        ok = load_ascii(
                 data_.data(),
-                file,
+                pos,
+                end,
                 width_ * 3,
                 height_,
                 max_value,
@@ -304,36 +370,44 @@ bool pnm_image::load(std::string const& filename)
                         return static_cast<uint8_t>(val);
                     }
                 );
-        return true;
+        break;
 
     case P5:
         format_ = PF_R8;
         data_.resize(width_ * height_);
 
-        load_binary(
+        ok = load_binary(
                 data_.data(),
-                file,
+                pos,
+                end,
                 width_,
                 height_,
                 max_value
                 );
-        return true;
+        break;
 
     case P6:
         format_ = PF_RGB8;
         data_.resize(width_ * height_ * 3);
 
-        load_binary(
+        ok = load_binary(
                 data_.data(),
-                file,
+                pos,
+                end,
                 width_ * 3,
                 height_,
                 max_value
                 );
-        return true;
+        break;
+    }
+
+    if (!ok)
+    {
+        std::cerr << "Unexpected end of pnm file\n";
+        return false;
     }
 
-    return false;
+    return true;
 }
 
 bool pnm_image::save(std::string const& filename, file_base::save_options const& options)
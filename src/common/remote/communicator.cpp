@@ -0,0 +1,368 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "../async/connection_manager.h"
+#include "communicator.h"
+#include "render_protocol.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Private implementation
+//
+
+struct communicator::impl
+{
+    using clock = std::chrono::steady_clock;
+
+    // The connecting rank introduces itself with this message type, user
+    // tags are sent as tag + 1
+    enum { HelloMessage = 0 };
+
+    impl(int rank, int size, std::vector<std::string> const& hosts, unsigned short base_port)
+        : rank(rank)
+        , size(size)
+        , hosts(hosts)
+        , base_port(base_port)
+        , peers(size)
+    {
+    }
+
+    int                                 rank;
+    int                                 size;
+    std::vector<std::string>            hosts;
+    unsigned short                      base_port;
+
+    async::connection_manager_pointer   manager;
+
+    std::mutex                          mutex;
+    std::condition_variable             cond;
+
+    // Connections to the other ranks, indexed by rank
+    std::vector<async::connection_pointer> peers;
+
+    // Received messages by (sender, tag)
+    std::map<std::pair<int, unsigned>, std::deque<std::vector<char>>> mailbox;
+
+    // Connections accepted from higher ranks
+    int                                 num_accepted = 0;
+
+    // Set when a connection was closed
+    bool                                failed = false;
+
+    std::string const& host(int r) const
+    {
+        return hosts.size() == 1 ? hosts[0] : hosts[r];
+    }
+
+    int num_connected() const
+    {
+        int n = 0;
+
+        for (auto const& p : peers)
+        {
+            n += p != nullptr;
+        }
+
+        return n;
+    }
+
+    bool handle_accept(async::connection_pointer c, boost::system::error_code const& e);
+
+    void set_handler(async::connection_pointer c, int peer);
+
+    bool connect_to(int r, clock::time_point deadline);
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Network callbacks, called from the connection manager's thread
+//
+
+bool communicator::impl::handle_accept(async::connection_pointer c, boost::system::error_code const& e)
+{
+    if (e)
+    {
+        return false;
+    }
+
+    set_handler(c, -1);
+
+    // Wait for the remaining higher ranks
+    if (++num_accepted < size - rank - 1)
+    {
+        manager->accept([this](async::connection_pointer c, boost::system::error_code const& e)
+        {
+            return handle_accept(c, e);
+        });
+    }
+
+    return true;
+}
+
+// Received messages go to the mailbox, peer is -1 for accepted connections
+// until the hello message arrived
+void communicator::impl::set_handler(async::connection_pointer c, int peer)
+{
+    auto peer_rank = std::make_shared<int>(peer);
+
+    c->set_handler([this, c, peer_rank](
+            async::connection::reason   reason,
+            async::message_pointer      message,
+            boost::system::error_code const& e
+            )
+    {
+        std::unique_lock<std::mutex> l(mutex);
+
+        if (e)
+        {
+            failed = true;
+            cond.notify_all();
+            return;
+        }
+
+        if (reason != async::connection::Read)
+        {
+            return;
+        }
+
+        if (message->type() == HelloMessage)
+        {
+            int32_t r = -1;
+
+            if (deserialize(message->data(), message->size(), r) && r >= 0 && r < size && r != rank)
+            {
+                *peer_rank = r;
+                peers[r] = c;
+                cond.notify_all();
+            }
+
+            return;
+        }
+
+        if (*peer_rank < 0)
+        {
+            return;
+        }
+
+        std::vector<char> data(message->begin(), message->end());
+        mailbox[std::make_pair(*peer_rank, message->type() - 1)].push_back(std::move(data));
+        cond.notify_all();
+    });
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Connect to rank r, retry until it is listening
+//
+
+bool communicator::impl::connect_to(int r, clock::time_point deadline)
+{
+    for (;;)
+    {
+        auto result = std::make_shared<std::promise<async::connection_pointer>>();
+
+        // Connect on the manager's thread, accept handlers run there, too
+        manager->connect(
+                host(r),
+                static_cast<unsigned short>(base_port + r),
+                [this, r, result](async::connection_pointer c, boost::system::error_code const& e)
+                {
+                    if (e)
+                    {
+                        result->set_value(nullptr);
+                        return false;
+                    }
+
+                    set_handler(c, r);
+                    result->set_value(c);
+                    return true;
+                });
+
+        auto c = result->get_future().get();
+
+        if (c)
+        {
+            std::vector<char> hello;
+            serialize(static_cast<int32_t>(rank), hello);
+            c->write(HelloMessage, hello);
+
+            std::unique_lock<std::mutex> l(mutex);
+            peers[r] = c;
+            return true;
+        }
+
+        if (clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// communicator
+//
+
+communicator::communicator(int rank, int size, std::vector<std::string> const& hosts, unsigned short base_port)
+    : impl_(new impl(rank, size, hosts, base_port))
+{
+    assert(rank >= 0 && rank < size);
+    assert(hosts.size() == 1 || static_cast<int>(hosts.size()) == size);
+}
+
+communicator::~communicator()
+{
+    disconnect();
+}
+
+bool communicator::connect(double timeout_seconds)
+{
+    disconnect();
+
+    if (impl_->size == 1)
+    {
+        return true;
+    }
+
+    auto deadline = impl::clock::now()
+        + std::chrono::duration_cast<impl::clock::duration>(std::chrono::duration<double>(timeout_seconds));
+
+    impl_->manager = async::make_connection_manager(static_cast<unsigned short>(impl_->base_port + impl_->rank));
+
+    impl_->num_accepted = 0;
+
+    // Higher ranks connect to this one
+    if (impl_->rank < impl_->size - 1)
+    {
+        impl_->manager->accept([this](async::connection_pointer c, boost::system::error_code const& e)
+        {
+            return impl_->handle_accept(c, e);
+        });
+    }
+
+    impl_->manager->run_in_thread();
+
+    bool ok = true;
+
+    for (int r = 0; r < impl_->rank && ok; ++r)
+    {
+        ok = impl_->connect_to(r, deadline);
+    }
+
+    if (ok)
+    {
+        std::unique_lock<std::mutex> l(impl_->mutex);
+
+        ok = impl_->cond.wait_until(l, deadline, [this]()
+        {
+            return impl_->failed || impl_->num_connected() == impl_->size - 1;
+        }) && !impl_->failed;
+    }
+
+    if (!ok)
+    {
+        disconnect();
+    }
+
+    return ok;
+}
+
+void communicator::disconnect()
+{
+    if (impl_->manager == nullptr)
+    {
+        return;
+    }
+
+    impl_->manager->stop();
+    impl_->manager->wait();
+
+    // Destroying the manager closes the connections and calls the handlers,
+    // so release it without holding the lock
+    async::connection_manager_pointer manager;
+    std::vector<async::connection_pointer> peers(impl_->size);
+
+    {
+        std::unique_lock<std::mutex> l(impl_->mutex);
+        std::swap(manager, impl_->manager);
+        std::swap(peers, impl_->peers);
+        impl_->mailbox.clear();
+        impl_->failed = false;
+        impl_->cond.notify_all();
+    }
+}
+
+int communicator::rank() const
+{
+    return impl_->rank;
+}
+
+int communicator::size() const
+{
+    return impl_->size;
+}
+
+void communicator::send(int to, unsigned tag, std::vector<char> const& data)
+{
+    assert(!data.empty());
+
+    async::connection_pointer c;
+
+    {
+        std::unique_lock<std::mutex> l(impl_->mutex);
+        c = impl_->peers[to];
+    }
+
+    if (c)
+    {
+        c->write(tag + 1, data);
+    }
+}
+
+bool communicator::receive(int from, unsigned tag, std::vector<char>& data, double timeout_seconds)
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    auto& queue = impl_->mailbox[std::make_pair(from, tag)];
+
+    auto ready = [&]() { return !queue.empty() || impl_->failed; };
+
+    if (timeout_seconds < 0.0)
+    {
+        impl_->cond.wait(l, ready);
+    }
+    else
+    {
+        impl_->cond.wait_for(l, std::chrono::duration<double>(timeout_seconds), ready);
+    }
+
+    if (queue.empty())
+    {
+        return false;
+    }
+
+    data = std::move(queue.front());
+    queue.pop_front();
+
+    return true;
+}
+
+} // remote
+} // visionaray
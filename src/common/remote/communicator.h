@@ -0,0 +1,66 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_REMOTE_COMMUNICATOR_H
+#define VSNRAY_COMMON_REMOTE_COMMUNICATOR_H 1
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Communicator
+//
+// Connects a group of processes (ranks 0..size-1) with each other over TCP,
+// one async::connection per pair of ranks. Rank r listens on base_port + r
+// and connects to all lower ranks.
+//
+// Messages are delivered in order per sender and tag. send() returns
+// immediately, receive() blocks until a message with the given tag arrived
+// from the given rank.
+//
+
+class communicator
+{
+public:
+
+    // hosts[r] is the host rank r runs on; if hosts has a single entry,
+    // all ranks run on that host
+    communicator(int rank, int size, std::vector<std::string> const& hosts, unsigned short base_port);
+   ~communicator();
+
+    // Connect to all other ranks, blocks until all connections are
+    // established or the timeout expired
+    bool connect(double timeout_seconds = 30.0);
+
+    void disconnect();
+
+    int rank() const;
+    int size() const;
+
+    // Send a message to rank to, data must not be empty
+    void send(int to, unsigned tag, std::vector<char> const& data);
+
+    // Receive the next message with tag from rank from, returns false on
+    // timeout or if a connection was closed. With a negative timeout, waits
+    // until a message arrives or a connection is closed.
+    bool receive(int from, unsigned tag, std::vector<char>& data, double timeout_seconds = -1.0);
+
+private:
+
+    struct impl;
+    std::unique_ptr<impl> impl_;
+
+};
+
+} // remote
+} // visionaray
+
+#endif // VSNRAY_COMMON_REMOTE_COMMUNICATOR_H
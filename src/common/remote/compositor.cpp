@@ -0,0 +1,251 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "../timer.h"
+#include "compositor.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+namespace
+{
+
+// Communicator tags
+enum { FoldTag = 1, SwapTag = 2, GatherTag = 3 };
+
+// Pixel range [first..last) of the image, followed by the colors and depths
+struct region_header
+{
+    uint32_t first;
+    uint32_t last;
+};
+
+void pack(
+        char const*         color,
+        float const*        depth,
+        size_t              color_size,
+        size_t              first,
+        size_t              last,
+        std::vector<char>&  out
+        )
+{
+    size_t n = last - first;
+
+    out.clear();
+    serialize(region_header{ static_cast<uint32_t>(first), static_cast<uint32_t>(last) }, out);
+
+    size_t offset = out.size();
+    out.resize(offset + n * color_size + n * sizeof(float));
+
+    std::memcpy(out.data() + offset, color + first * color_size, n * color_size);
+    std::memcpy(out.data() + offset + n * color_size, depth + first, n * sizeof(float));
+}
+
+bool unpack(
+        std::vector<char> const&    data,
+        size_t                      color_size,
+        size_t                      num_pixels,
+        region_header&              header,
+        std::vector<float>&         depth
+        )
+{
+    if (!deserialize(data.data(), data.size(), header)
+     || header.first > header.last
+     || header.last > num_pixels)
+    {
+        return false;
+    }
+
+    size_t n = header.last - header.first;
+
+    if (data.size() != sizeof(header) + n * color_size + n * sizeof(float))
+    {
+        return false;
+    }
+
+    // Copy, the depth values in the message need not be aligned
+    depth.resize(n);
+    std::memcpy(depth.data(), data.data() + sizeof(header) + n * color_size, n * sizeof(float));
+
+    return true;
+}
+
+} // namespace
+
+
+//-------------------------------------------------------------------------------------------------
+// Depth compositing
+//
+
+void depth_composite(
+        char*           dst_color,
+        float*          dst_depth,
+        char const*     src_color,
+        float const*    src_depth,
+        size_t          color_size,
+        size_t          count
+        )
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (src_depth[i] < dst_depth[i])
+        {
+            std::memcpy(dst_color + i * color_size, src_color + i * color_size, color_size);
+            dst_depth[i] = src_depth[i];
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// binary_swap_compositor
+//
+
+binary_swap_compositor::binary_swap_compositor(communicator& comm)
+    : comm_(comm)
+{
+}
+
+bool binary_swap_compositor::composite(char* color, size_t color_size, float* depth, int width, int height)
+{
+    timer t;
+
+    int rank = comm_.rank();
+    int size = comm_.size();
+    size_t num_pixels = static_cast<size_t>(width) * height;
+
+    std::vector<char> buffer;
+    std::vector<float> received_depth;
+
+    auto send = [&](int to, unsigned tag, size_t first, size_t last)
+    {
+        pack(color, depth, color_size, first, last, buffer);
+        stats_.bytes_sent += buffer.size();
+        comm_.send(to, tag, buffer);
+    };
+
+    // Receive a region and composite it with the local image (or copy it if
+    // the sender's pixels are final), the region is checked against expected
+    // if not null
+    auto receive = [&](int from, unsigned tag, bool blend, size_t const* expected) -> bool
+    {
+        region_header header;
+
+        if (!comm_.receive(from, tag, buffer) || !unpack(buffer, color_size, num_pixels, header, received_depth))
+        {
+            return false;
+        }
+
+        if (expected != nullptr && (header.first != expected[0] || header.last != expected[1]))
+        {
+            return false;
+        }
+
+        size_t n = header.last - header.first;
+        char const* src_color = buffer.data() + sizeof(header);
+
+        if (blend)
+        {
+            depth_composite(
+                    color + header.first * color_size,
+                    depth + header.first,
+                    src_color,
+                    received_depth.data(),
+                    color_size,
+                    n
+                    );
+        }
+        else
+        {
+            std::memcpy(color + header.first * color_size, src_color, n * color_size);
+            std::memcpy(depth + header.first, received_depth.data(), n * sizeof(float));
+        }
+
+        return true;
+    };
+
+    // Largest power of two <= size
+    int pot = 1;
+
+    while (pot * 2 <= size)
+    {
+        pot *= 2;
+    }
+
+    size_t region[2] = { 0, num_pixels };
+
+    // Surplus ranks hand off their whole image
+    if (rank >= pot)
+    {
+        send(rank - pot, FoldTag, region[0], region[1]);
+        stats_.composite.add(t.elapsed());
+        return true;
+    }
+
+    if (rank + pot < size && !receive(rank + pot, FoldTag, true, region))
+    {
+        return false;
+    }
+
+    // Binary swap, the lower rank of each pair keeps the lower half
+    for (int bit = 1; bit < pot; bit <<= 1)
+    {
+        int partner = rank ^ bit;
+        size_t mid = region[0] + (region[1] - region[0]) / 2;
+        bool lower = (rank & bit) == 0;
+
+        if (lower)
+        {
+            send(partner, SwapTag, mid, region[1]);
+            region[1] = mid;
+        }
+        else
+        {
+            send(partner, SwapTag, region[0], mid);
+            region[0] = mid;
+        }
+
+        if (!receive(partner, SwapTag, true, region))
+        {
+            return false;
+        }
+    }
+
+    // Gather
+    if (rank != 0)
+    {
+        send(0, GatherTag, region[0], region[1]);
+    }
+    else
+    {
+        for (int r = 1; r < pot; ++r)
+        {
+            if (!receive(r, GatherTag, false, nullptr))
+            {
+                return false;
+            }
+        }
+    }
+
+    stats_.composite.add(t.elapsed());
+
+    return true;
+}
+
+binary_swap_compositor::statistics const& binary_swap_compositor::stats() const
+{
+    return stats_;
+}
+
+} // remote
+} // visionaray
@@ -0,0 +1,84 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_REMOTE_COMPOSITOR_H
+#define VSNRAY_COMMON_REMOTE_COMPOSITOR_H 1
+
+#include <cstddef>
+
+#include "communicator.h"
+#include "render_protocol.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Depth compositing of count pixels, keeps the closer fragment
+//
+// color_size is the size of one color in bytes, smaller depth values are closer
+// (as with OpenGL's GL_LESS and the depth written by the builtin kernels)
+//
+
+void depth_composite(
+        char*           dst_color,
+        float*          dst_depth,
+        char const*     src_color,
+        float const*    src_depth,
+        size_t          color_size,
+        size_t          count
+        );
+
+
+//-------------------------------------------------------------------------------------------------
+// Sort-last compositor (binary swap)
+//
+// Each rank renders its part of the scene into a color and depth buffer of
+// the full image size. In log2(n) rounds, pairs of ranks exchange one half of
+// the image region they are responsible for and depth composite the half they
+// keep. Each rank then owns 1/n of the final image, which is gathered on rank 0.
+// If the number of ranks is not a power of two, the surplus ranks first send
+// their whole image to a partner.
+//
+
+class binary_swap_compositor
+{
+public:
+
+    struct statistics
+    {
+        stage_stats composite;
+        size_t bytes_sent = 0;
+    };
+
+public:
+
+    explicit binary_swap_compositor(communicator& comm);
+
+    // Composite the images of all ranks, on rank 0, color and depth contain the
+    // final image afterwards, on the other ranks they are clobbered.
+    // Returns false if communication failed.
+    template <typename Color>
+    bool composite(Color* color, float* depth, int width, int height)
+    {
+        return composite(reinterpret_cast<char*>(color), sizeof(Color), depth, width, height);
+    }
+
+    bool composite(char* color, size_t color_size, float* depth, int width, int height);
+
+    statistics const& stats() const;
+
+private:
+
+    communicator& comm_;
+    statistics stats_;
+
+};
+
+} // remote
+} // visionaray
+
+#endif // VSNRAY_COMMON_REMOTE_COMPOSITOR_H
@@ -0,0 +1,324 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cstring>
+
+#include <visionaray/math/detail/math.h>
+
+#include "frame_codec.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static const int TileSize = 16;
+
+struct frame_header
+{
+    uint32_t encoding;
+    uint32_t key_frame;
+    int32_t  width;
+    int32_t  height;
+};
+
+template <typename T>
+static void append(std::vector<char>& out, T const* data, size_t count)
+{
+    size_t offset = out.size();
+    out.resize(offset + sizeof(T) * count);
+    std::memcpy(out.data() + offset, data, sizeof(T) * count);
+}
+
+template <typename T>
+static bool read(char const*& data, char const* end, T* dst, size_t count)
+{
+    if (static_cast<size_t>(end - data) < sizeof(T) * count)
+    {
+        return false;
+    }
+
+    std::memcpy(dst, data, sizeof(T) * count);
+    data += sizeof(T) * count;
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// frame_encoder
+//
+
+frame_encoder::frame_encoder(frame_encoding encoding)
+    : encoding_(encoding)
+{
+}
+
+void frame_encoder::set_encoding(frame_encoding encoding)
+{
+    if (encoding != encoding_)
+    {
+        encoding_ = encoding;
+        key_frame_ = true;
+    }
+}
+
+frame_encoding frame_encoder::encoding() const
+{
+    return encoding_;
+}
+
+void frame_encoder::encode(pixel_type const* pixels, int width, int height, std::vector<char>& out)
+{
+    static_assert(sizeof(pixel_type) == sizeof(uint32_t), "Size mismatch");
+
+    size_t num_pixels = static_cast<size_t>(width) * height;
+
+    if (width != width_ || height != height_)
+    {
+        width_ = width;
+        height_ = height;
+        key_frame_ = true;
+    }
+
+    if (key_frame_)
+    {
+        // Key frames are encoded relative to a black image
+        prev_.assign(num_pixels, 0U);
+    }
+
+    frame_header header;
+    header.encoding = static_cast<uint32_t>(encoding_);
+    header.key_frame = key_frame_ ? 1U : 0U;
+    header.width = width;
+    header.height = height;
+    append(out, &header, 1);
+
+    std::vector<uint32_t> curr(num_pixels);
+    std::memcpy(curr.data(), pixels, num_pixels * sizeof(uint32_t));
+
+    if (encoding_ == RawEncoding)
+    {
+        append(out, curr.data(), num_pixels);
+    }
+    else if (encoding_ == DeltaEncoding)
+    {
+        // Runs of [unchanged count][changed count][changed pixels XOR previous]
+        size_t i = 0;
+
+        while (i < num_pixels)
+        {
+            size_t first = i;
+
+            while (i < num_pixels && curr[i] == prev_[i])
+            {
+                ++i;
+            }
+
+            uint32_t skip = static_cast<uint32_t>(i - first);
+
+            first = i;
+
+            while (i < num_pixels && curr[i] != prev_[i])
+            {
+                prev_[i] ^= curr[i];
+                ++i;
+            }
+
+            uint32_t count = static_cast<uint32_t>(i - first);
+
+            append(out, &skip, 1);
+            append(out, &count, 1);
+            append(out, prev_.data() + first, count);
+        }
+    }
+    else if (encoding_ == TileEncoding)
+    {
+        int num_tiles_x = div_up(width, TileSize);
+        int num_tiles_y = div_up(height, TileSize);
+
+        size_t flags_offset = out.size();
+        out.resize(out.size() + num_tiles_x * num_tiles_y, 0);
+
+        for (int ty = 0; ty < num_tiles_y; ++ty)
+        {
+            for (int tx = 0; tx < num_tiles_x; ++tx)
+            {
+                int x0 = tx * TileSize;
+                int y0 = ty * TileSize;
+                int x1 = std::min(x0 + TileSize, width);
+                int y1 = std::min(y0 + TileSize, height);
+
+                bool changed = key_frame_;
+
+                for (int y = y0; y < y1 && !changed; ++y)
+                {
+                    size_t row = static_cast<size_t>(y) * width;
+                    changed = !std::equal(curr.data() + row + x0, curr.data() + row + x1, prev_.data() + row + x0);
+                }
+
+                if (!changed)
+                {
+                    continue;
+                }
+
+                out[flags_offset + ty * num_tiles_x + tx] = 1;
+
+                for (int y = y0; y < y1; ++y)
+                {
+                    size_t row = static_cast<size_t>(y) * width;
+                    append(out, curr.data() + row + x0, x1 - x0);
+                }
+            }
+        }
+    }
+
+    prev_.swap(curr);
+    key_frame_ = false;
+}
+
+void frame_encoder::reset()
+{
+    key_frame_ = true;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// frame_decoder
+//
+
+bool frame_decoder::decode(char const* data, size_t size)
+{
+    char const* end = data + size;
+
+    frame_header header;
+
+    if (!read(data, end, &header, 1) || header.width < 0 || header.height < 0)
+    {
+        return false;
+    }
+
+    bool key_frame = header.key_frame != 0;
+
+    if (!key_frame && (header.width != width_ || header.height != height_))
+    {
+        // Delta to a frame we don't have
+        return false;
+    }
+
+    size_t num_pixels = static_cast<size_t>(header.width) * header.height;
+
+    if (key_frame)
+    {
+        width_ = header.width;
+        height_ = header.height;
+        pixels_.assign(num_pixels, 0U);
+    }
+
+    key_frame_ = key_frame;
+
+    if (header.encoding == RawEncoding)
+    {
+        return read(data, end, pixels_.data(), num_pixels);
+    }
+    else if (header.encoding == DeltaEncoding)
+    {
+        size_t i = 0;
+
+        while (i < num_pixels)
+        {
+            uint32_t skip = 0;
+            uint32_t count = 0;
+
+            if (!read(data, end, &skip, 1) || !read(data, end, &count, 1))
+            {
+                return false;
+            }
+
+            i += skip;
+
+            if (i + count > num_pixels || static_cast<size_t>(end - data) < count * sizeof(uint32_t))
+            {
+                return false;
+            }
+
+            for (uint32_t j = 0; j < count; ++j, ++i)
+            {
+                uint32_t delta = 0;
+                read(data, end, &delta, 1);
+                pixels_[i] ^= delta;
+            }
+        }
+
+        return i == num_pixels;
+    }
+    else if (header.encoding == TileEncoding)
+    {
+        int num_tiles_x = div_up(width_, TileSize);
+        int num_tiles_y = div_up(height_, TileSize);
+
+        std::vector<char> flags(num_tiles_x * num_tiles_y);
+
+        if (!read(data, end, flags.data(), flags.size()))
+        {
+            return false;
+        }
+
+        for (int ty = 0; ty < num_tiles_y; ++ty)
+        {
+            for (int tx = 0; tx < num_tiles_x; ++tx)
+            {
+                if (!flags[ty * num_tiles_x + tx])
+                {
+                    continue;
+                }
+
+                int x0 = tx * TileSize;
+                int y0 = ty * TileSize;
+                int x1 = std::min(x0 + TileSize, width_);
+                int y1 = std::min(y0 + TileSize, height_);
+
+                for (int y = y0; y < y1; ++y)
+                {
+                    size_t row = static_cast<size_t>(y) * width_;
+
+                    if (!read(data, end, pixels_.data() + row + x0, x1 - x0))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+frame_decoder::pixel_type const* frame_decoder::pixels() const
+{
+    return reinterpret_cast<pixel_type const*>(pixels_.data());
+}
+
+int frame_decoder::width() const
+{
+    return width_;
+}
+
+int frame_decoder::height() const
+{
+    return height_;
+}
+
+bool frame_decoder::key_frame() const
+{
+    return key_frame_;
+}
+
+} // remote
+} // visionaray
@@ -0,0 +1,110 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_REMOTE_FRAME_CODEC_H
+#define VSNRAY_COMMON_REMOTE_FRAME_CODEC_H 1
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <visionaray/math/forward.h>
+#include <visionaray/math/unorm.h>
+#include <visionaray/math/vector.h>
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Frame encodings
+//
+//  RawEncoding:    RGBA8 pixels, uncompressed
+//  DeltaEncoding:  XOR with the previous frame, run-length encoded; compresses
+//                  well when only parts of the image change between frames
+//  TileEncoding:   only tiles of 16x16 pixels that differ from the previous
+//                  frame are sent
+//
+// The first frame, and the first frame after a resize or a call to
+// frame_encoder::reset(), is a key frame that does not depend on previous
+// frames.
+//
+
+enum frame_encoding { RawEncoding, DeltaEncoding, TileEncoding };
+
+
+//-------------------------------------------------------------------------------------------------
+// Encoder, holds the last frame that was encoded
+//
+
+class frame_encoder
+{
+public:
+
+    using pixel_type = vector<4, unorm<8>>;
+
+public:
+
+    explicit frame_encoder(frame_encoding encoding = DeltaEncoding);
+
+    void set_encoding(frame_encoding encoding);
+    frame_encoding encoding() const;
+
+    // Encode an image of width x height pixels, result is appended to out
+    void encode(pixel_type const* pixels, int width, int height, std::vector<char>& out);
+
+    // Make the next frame a key frame
+    void reset();
+
+private:
+
+    frame_encoding encoding_;
+    bool key_frame_ = true;
+
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<uint32_t> prev_;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Decoder, holds the last frame that was decoded
+//
+
+class frame_decoder
+{
+public:
+
+    using pixel_type = vector<4, unorm<8>>;
+
+public:
+
+    // Decode a frame, returns false if the data is corrupt or if it refers to a
+    // previous frame that was not decoded
+    bool decode(char const* data, size_t size);
+
+    pixel_type const* pixels() const;
+
+    int width() const;
+    int height() const;
+
+    // True if the last decoded frame was a key frame
+    bool key_frame() const;
+
+private:
+
+    int width_ = 0;
+    int height_ = 0;
+    bool key_frame_ = false;
+    std::vector<uint32_t> pixels_;
+
+};
+
+} // remote
+} // visionaray
+
+#endif // VSNRAY_COMMON_REMOTE_FRAME_CODEC_H
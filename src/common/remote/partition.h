@@ -0,0 +1,223 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_REMOTE_PARTITION_H
+#define VSNRAY_COMMON_REMOTE_PARTITION_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include <visionaray/math/aabb.h>
+#include <visionaray/math/vector.h>
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Spatially partition the primitives of an index BVH for sort-last rendering
+//
+// Starting at the root, the subtree with the most primitive references is
+// replaced by its children until there are num_parts subtrees (or only
+// leaves are left). Returns the primitive indices (into bvh.primitives())
+// of each subtree. Primitives that were split by the builder may be part of
+// more than one partition, depth compositing resolves that.
+//
+
+template <typename BVH>
+std::vector<std::vector<unsigned>> partition_bvh(BVH const& bvh, unsigned num_parts)
+{
+    std::vector<std::vector<unsigned>> result(num_parts);
+
+    if (bvh.num_nodes() == 0 || num_parts == 0)
+    {
+        return result;
+    }
+
+    // Number of primitive references per subtree, visit nodes in reverse
+    // pre-order so that children come before their parents
+    std::vector<unsigned> order;
+    std::vector<unsigned> stack(1, 0);
+
+    while (!stack.empty())
+    {
+        unsigned index = stack.back();
+        stack.pop_back();
+        order.push_back(index);
+
+        auto const& node = bvh.node(index);
+
+        if (node.is_inner())
+        {
+            stack.push_back(node.get_child(0));
+            stack.push_back(node.get_child(1));
+        }
+    }
+
+    std::vector<size_t> counts(bvh.num_nodes(), 0);
+
+    for (auto i = order.rbegin(); i != order.rend(); ++i)
+    {
+        auto const& node = bvh.node(*i);
+
+        if (node.is_leaf())
+        {
+            counts[*i] = node.get_num_primitives();
+        }
+        else
+        {
+            counts[*i] = counts[node.get_child(0)] + counts[node.get_child(1)];
+        }
+    }
+
+    std::vector<unsigned> subtrees(1, 0);
+
+    while (subtrees.size() < num_parts)
+    {
+        // Largest inner node
+        auto it = subtrees.end();
+
+        for (auto s = subtrees.begin(); s != subtrees.end(); ++s)
+        {
+            if (bvh.node(*s).is_inner() && (it == subtrees.end() || counts[*s] > counts[*it]))
+            {
+                it = s;
+            }
+        }
+
+        if (it == subtrees.end())
+        {
+            break;
+        }
+
+        auto const& node = bvh.node(*it);
+        *it = node.get_child(0);
+        subtrees.push_back(node.get_child(1));
+    }
+
+    for (size_t p = 0; p < subtrees.size(); ++p)
+    {
+        stack.assign(1, subtrees[p]);
+
+        while (!stack.empty())
+        {
+            auto const& node = bvh.node(stack.back());
+            stack.pop_back();
+
+            if (node.is_leaf())
+            {
+                for (unsigned i = node.get_indices().first; i != node.get_indices().last; ++i)
+                {
+                    result[p].push_back(bvh.indices()[i]);
+                }
+            }
+            else
+            {
+                stack.push_back(node.get_child(0));
+                stack.push_back(node.get_child(1));
+            }
+        }
+
+        std::sort(result[p].begin(), result[p].end());
+        result[p].erase(std::unique(result[p].begin(), result[p].end()), result[p].end());
+    }
+
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Spatially partition primitives by their centroids for sort-last rendering
+//
+// Recursively splits the primitives at the median centroid along the longest
+// axis of the centroid bounds, so that the partitions are spatially compact
+// and have (about) the same number of primitives. Only needs the centroids,
+// so primitives can be distributed before building any BVH. Returns the
+// primitive indices (into [first, last)) of each partition, sorted.
+//
+
+template <typename It>
+std::vector<std::vector<unsigned>> partition_primitives(It first, It last, unsigned num_parts)
+{
+    std::vector<std::vector<unsigned>> result(num_parts);
+
+    if (num_parts == 0)
+    {
+        return result;
+    }
+
+    size_t num_prims = static_cast<size_t>(std::distance(first, last));
+
+    std::vector<vec3> centroids;
+    centroids.reserve(num_prims);
+
+    for (It it = first; it != last; ++it)
+    {
+        centroids.push_back(get_bounds(*it).center());
+    }
+
+    std::vector<unsigned> indices(num_prims);
+    std::iota(indices.begin(), indices.end(), 0U);
+
+    // Ranges of indices that are assigned to a range of partitions
+    struct task
+    {
+        size_t begin;
+        size_t end;
+        unsigned first_part;
+        unsigned num_parts;
+    };
+
+    std::vector<task> stack(1, { 0, num_prims, 0, num_parts });
+
+    while (!stack.empty())
+    {
+        task t = stack.back();
+        stack.pop_back();
+
+        if (t.num_parts == 1 || t.end - t.begin <= 1)
+        {
+            auto& part = result[t.first_part];
+            part.assign(indices.begin() + t.begin, indices.begin() + t.end);
+            std::sort(part.begin(), part.end());
+            continue;
+        }
+
+        aabb bounds;
+        bounds.invalidate();
+
+        for (size_t i = t.begin; i != t.end; ++i)
+        {
+            bounds.insert(centroids[indices[i]]);
+        }
+
+        vec3 size = bounds.size();
+        int axis = size.x >= size.y && size.x >= size.z ? 0 : size.y >= size.z ? 1 : 2;
+
+        unsigned left_parts = t.num_parts / 2;
+        size_t mid = t.begin + (t.end - t.begin) * left_parts / t.num_parts;
+
+        std::nth_element(
+                indices.begin() + t.begin,
+                indices.begin() + mid,
+                indices.begin() + t.end,
+                [&](unsigned a, unsigned b) { return centroids[a][axis] < centroids[b][axis]; }
+                );
+
+        stack.push_back({ t.begin, mid, t.first_part, left_parts });
+        stack.push_back({ mid, t.end, t.first_part + left_parts, t.num_parts - left_parts });
+    }
+
+    return result;
+}
+
+} // remote
+} // visionaray
+
+#endif // VSNRAY_COMMON_REMOTE_PARTITION_H
@@ -0,0 +1,270 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "../async/connection_manager.h"
+#include "../timer.h"
+#include "render_client.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Private implementation
+//
+
+struct render_client::impl
+{
+    using clock = timer::clock;
+    using time_point = timer::time_point;
+
+    async::connection_manager_pointer   manager;
+    async::connection_pointer           conn;
+
+    mutable std::mutex                  mutex;
+    std::condition_variable             cond;
+
+    // Sequence number of the last camera update, and send times of the
+    // updates that no frame was received for yet
+    uint32_t                            seq = 0;
+    std::map<uint32_t, time_point>      send_times;
+
+    frame_decoder                       decoder;
+    frame_info                          info;
+    bool                                new_frame = false;
+    bool                                have_current_frame = false;
+
+    statistics                          stats;
+
+    void handle_message(
+            async::connection::reason   reason,
+            async::message_pointer      message,
+            boost::system::error_code const& e
+            );
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Network callback, called from the connection manager's thread
+//
+
+void render_client::impl::handle_message(
+        async::connection::reason   reason,
+        async::message_pointer      message,
+        boost::system::error_code const& e
+        )
+{
+    std::unique_lock<std::mutex> l(mutex);
+
+    if (e)
+    {
+        // Server closed the connection
+        conn = nullptr;
+        cond.notify_all();
+        return;
+    }
+
+    if (reason != async::connection::Read || message->type() != FrameMessage)
+    {
+        return;
+    }
+
+    frame_info fi;
+
+    if (!deserialize(message->data(), message->size(), fi))
+    {
+        ++stats.errors;
+        return;
+    }
+
+    timer t;
+
+    if (!decoder.decode(message->data() + sizeof(fi), message->size() - sizeof(fi)))
+    {
+        ++stats.errors;
+        return;
+    }
+
+    stats.decode.add(t.elapsed());
+    stats.server_render.add(fi.render_time);
+    stats.server_encode.add(fi.encode_time);
+    stats.bytes_received += message->size();
+    ++stats.frames_received;
+
+    auto it = send_times.find(fi.seq);
+
+    if (it != send_times.end())
+    {
+        stats.round_trip.add(std::chrono::duration<double>(clock::now() - it->second).count());
+
+        // Frames for older cameras won't arrive anymore
+        send_times.erase(send_times.begin(), ++it);
+    }
+
+    info = fi;
+    new_frame = true;
+    have_current_frame = fi.seq == seq;
+
+    cond.notify_all();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// render_client
+//
+
+render_client::render_client()
+    : impl_(new impl)
+{
+}
+
+render_client::~render_client()
+{
+    disconnect();
+}
+
+bool render_client::connect(std::string const& host, unsigned short port)
+{
+    disconnect();
+
+    impl_->manager = async::make_connection_manager();
+    impl_->manager->run_in_thread();
+
+    auto c = impl_->manager->connect(host, port);
+
+    if (!c)
+    {
+        disconnect();
+        return false;
+    }
+
+    c->set_handler([this](
+            async::connection::reason   reason,
+            async::message_pointer      message,
+            boost::system::error_code const& e
+            )
+    {
+        impl_->handle_message(reason, message, e);
+    });
+
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    impl_->conn = c;
+
+    return true;
+}
+
+void render_client::disconnect()
+{
+    if (impl_->manager == nullptr)
+    {
+        return;
+    }
+
+    impl_->manager->stop();
+    impl_->manager->wait();
+
+    // Destroying the manager closes the connection and calls the handler,
+    // so release it without holding the lock
+    async::connection_manager_pointer manager;
+    async::connection_pointer conn;
+
+    {
+        std::unique_lock<std::mutex> l(impl_->mutex);
+        std::swap(manager, impl_->manager);
+        std::swap(conn, impl_->conn);
+        impl_->send_times.clear();
+        impl_->cond.notify_all();
+    }
+}
+
+bool render_client::connected() const
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    return impl_->conn != nullptr;
+}
+
+void render_client::send_camera(
+        mat4 const&     view,
+        mat4 const&     proj,
+        int             width,
+        int             height,
+        frame_encoding  encoding
+        )
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    if (!impl_->conn)
+    {
+        return;
+    }
+
+    camera_update cam;
+    cam.seq = ++impl_->seq;
+    cam.width = width;
+    cam.height = height;
+    cam.encoding = static_cast<uint32_t>(encoding);
+    cam.view = view;
+    cam.proj = proj;
+
+    impl_->send_times[cam.seq] = impl::clock::now();
+    impl_->have_current_frame = false;
+
+    std::vector<char> data;
+    serialize(cam, data);
+
+    auto c = impl_->conn;
+
+    l.unlock();
+
+    c->write(CameraMessage, data);
+}
+
+bool render_client::latest_frame(std::vector<pixel_type>& pixels, int& width, int& height, frame_info* info)
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    if (!impl_->new_frame)
+    {
+        return false;
+    }
+
+    width = impl_->decoder.width();
+    height = impl_->decoder.height();
+    pixels.assign(impl_->decoder.pixels(), impl_->decoder.pixels() + static_cast<size_t>(width) * height);
+
+    if (info != nullptr)
+    {
+        *info = impl_->info;
+    }
+
+    impl_->new_frame = false;
+
+    return true;
+}
+
+bool render_client::wait_for_frame(double timeout_seconds)
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    return impl_->cond.wait_for(
+            l,
+            std::chrono::duration<double>(timeout_seconds),
+            [this]() { return impl_->have_current_frame || !impl_->conn; }
+            ) && impl_->have_current_frame;
+}
+
+render_client::statistics render_client::stats() const
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    return impl_->stats;
+}
+
+} // remote
+} // visionaray
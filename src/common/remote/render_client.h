@@ -0,0 +1,99 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_REMOTE_RENDER_CLIENT_H
+#define VSNRAY_COMMON_REMOTE_RENDER_CLIENT_H 1
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <visionaray/math/forward.h>
+#include <visionaray/math/matrix.h>
+
+#include "frame_codec.h"
+#include "render_protocol.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Render client
+//
+// Sends camera updates to a render_server and decodes the frames it sends back.
+// Frames are decoded on the network thread, latest_frame() returns the most
+// recent one.
+//
+
+class render_client
+{
+public:
+
+    using pixel_type = frame_decoder::pixel_type;
+
+    struct statistics
+    {
+        // Decoding on the client
+        stage_stats decode;
+
+        // Time from sending a camera update until the first frame rendered
+        // with that camera was decoded
+        stage_stats round_trip;
+
+        // As reported by the server
+        stage_stats server_render;
+        stage_stats server_encode;
+
+        size_t bytes_received = 0;
+        unsigned frames_received = 0;
+
+        // Frames that could not be decoded
+        unsigned errors = 0;
+    };
+
+public:
+
+    render_client();
+   ~render_client();
+
+    // Connect to a render server, blocks until the connection is established
+    bool connect(std::string const& host, unsigned short port);
+
+    void disconnect();
+
+    bool connected() const;
+
+    // Send a camera update, the server will render frames for the most recent one
+    void send_camera(
+            mat4 const&     view,
+            mat4 const&     proj,
+            int             width,
+            int             height,
+            frame_encoding  encoding = DeltaEncoding
+            );
+
+    // Copy the most recent frame, returns false if no frame arrived since the last call
+    bool latest_frame(std::vector<pixel_type>& pixels, int& width, int& height, frame_info* info = nullptr);
+
+    // Block until a frame rendered with the most recent camera update arrived,
+    // returns false on timeout or if the connection was closed
+    bool wait_for_frame(double timeout_seconds);
+
+    statistics stats() const;
+
+private:
+
+    struct impl;
+    std::unique_ptr<impl> impl_;
+
+};
+
+} // remote
+} // visionaray
+
+#endif // VSNRAY_COMMON_REMOTE_RENDER_CLIENT_H
@@ -0,0 +1,130 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_REMOTE_RENDER_PROTOCOL_H
+#define VSNRAY_COMMON_REMOTE_RENDER_PROTOCOL_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <visionaray/math/forward.h>
+#include <visionaray/math/matrix.h>
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Message types, used as async::message::type()
+//
+//  CameraMessage:  client -> server, camera_update
+//  FrameMessage:   server -> client, frame_info followed by an encoded frame
+//                  (see frame_codec.h)
+//
+
+enum message_type { CameraMessage = 1, FrameMessage = 2 };
+
+
+//-------------------------------------------------------------------------------------------------
+// Camera and viewport the client wants to see
+//
+
+struct camera_update
+{
+    // Incremented by the client for each update, echoed in frame_info
+    uint32_t seq;
+
+    // Viewport
+    int32_t width;
+    int32_t height;
+
+    // Requested frame_encoding
+    uint32_t encoding;
+
+    mat4 view;
+    mat4 proj;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Header of a frame message, timings are server-side and in seconds
+//
+
+struct frame_info
+{
+    // Sequence number of the camera_update the frame was rendered with
+    uint32_t seq;
+
+    // Frame counter for this camera (> 0 for progressive refinement)
+    uint32_t frame_num;
+
+    float render_time;
+    float encode_time;
+
+    // Time from receiving the camera update until the frame was encoded
+    float latency;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Latency statistics of one pipeline stage (in seconds)
+//
+
+struct stage_stats
+{
+    unsigned count = 0;
+    double last = 0.0;
+    double sum = 0.0;
+    double max = 0.0;
+
+    void add(double seconds)
+    {
+        ++count;
+        last = seconds;
+        sum += seconds;
+        max = std::max(max, seconds);
+    }
+
+    double average() const
+    {
+        return count > 0 ? sum / count : 0.0;
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// (De)serialize plain old data messages
+//
+// Like async::message's header, data is sent in host byte order
+//
+
+template <typename T>
+inline void serialize(T const& value, std::vector<char>& out)
+{
+    size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+inline bool deserialize(char const* data, size_t size, T& value)
+{
+    if (size < sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(&value, data, sizeof(T));
+    return true;
+}
+
+} // remote
+} // visionaray
+
+#endif // VSNRAY_COMMON_REMOTE_RENDER_PROTOCOL_H
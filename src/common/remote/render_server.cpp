@@ -0,0 +1,441 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../async/connection_manager.h"
+#include "../timer.h"
+#include "render_server.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Private implementation
+//
+
+struct render_server::impl
+{
+    using clock = timer::clock;
+    using time_point = timer::time_point;
+
+    // A rendered frame waiting to be encoded
+    struct frame
+    {
+        camera_update cam;
+        uint32_t frame_num;
+        std::vector<pixel_type> pixels;
+        time_point start;
+        double render_time;
+    };
+
+    // A frame that was handed to the network layer
+    struct pending_send
+    {
+        time_point send_start;
+        time_point start;
+    };
+
+    impl(unsigned short port, render_func func)
+        : port(port)
+        , func(func)
+    {
+    }
+
+    unsigned short                      port;
+    render_func                         func;
+
+    async::connection_manager_pointer   manager;
+    async::connection_pointer           conn;
+
+    mutable std::mutex                  mutex;
+    std::condition_variable             cond;
+    bool                                running = false;
+
+    // Most recent camera update
+    camera_update                       camera;
+    time_point                          camera_received;
+    bool                                camera_new = false;
+
+    std::deque<frame>                   encode_queue;
+    std::deque<pending_send>            pending_sends;
+    unsigned                            max_in_flight = 2;
+    int                                 max_size = 8192;
+    bool                                reset_encoder = false;
+
+    frame_encoder                       encoder;
+    statistics                          stats;
+
+    std::thread                         render_thread;
+    std::thread                         encode_thread;
+
+    bool handle_accept(async::connection_pointer c, boost::system::error_code const& e);
+
+    void handle_message(
+            async::connection::reason   reason,
+            async::message_pointer      message,
+            boost::system::error_code const& e
+            );
+
+    void render_loop();
+    void encode_loop();
+
+    static double seconds(clock::duration d)
+    {
+        return std::chrono::duration<double>(d).count();
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Network callbacks, called from the connection manager's thread
+//
+
+bool render_server::impl::handle_accept(async::connection_pointer c, boost::system::error_code const& e)
+{
+    if (e)
+    {
+        return false;
+    }
+
+    // Accept the next client
+    manager->accept([this](async::connection_pointer c, boost::system::error_code const& e)
+    {
+        return handle_accept(c, e);
+    });
+
+    std::unique_lock<std::mutex> l(mutex);
+
+    if (conn)
+    {
+        conn->close();
+    }
+
+    conn = c;
+    conn->set_handler([this](
+            async::connection::reason   reason,
+            async::message_pointer      message,
+            boost::system::error_code const& e
+            )
+    {
+        handle_message(reason, message, e);
+    });
+
+    // The new client has not seen a key frame yet
+    camera_new = false;
+    reset_encoder = true;
+    pending_sends.clear();
+
+    return true;
+}
+
+void render_server::impl::handle_message(
+        async::connection::reason   reason,
+        async::message_pointer      message,
+        boost::system::error_code const& e
+        )
+{
+    std::unique_lock<std::mutex> l(mutex);
+
+    if (e)
+    {
+        // Client disconnected
+        conn = nullptr;
+        camera_new = false;
+        pending_sends.clear();
+        cond.notify_all();
+        return;
+    }
+
+    if (reason == async::connection::Read && message->type() == CameraMessage)
+    {
+        camera_update cam;
+
+        if (!deserialize(message->data(), message->size(), cam))
+        {
+            return;
+        }
+
+        // The render thread allocates width * height pixels per frame
+        if (cam.width <= 0 || cam.height <= 0 || cam.width > max_size || cam.height > max_size)
+        {
+            ++stats.cameras_rejected;
+            return;
+        }
+
+        camera = cam;
+        camera_received = clock::now();
+        camera_new = true;
+        cond.notify_all();
+    }
+    else if (reason == async::connection::Write && message->type() == FrameMessage)
+    {
+        if (!pending_sends.empty())
+        {
+            auto now = clock::now();
+            auto ps = pending_sends.front();
+            pending_sends.pop_front();
+
+            stats.send.add(seconds(now - ps.send_start));
+            stats.latency.add(seconds(now - ps.start));
+            stats.bytes_sent += message->size();
+            ++stats.frames_sent;
+        }
+
+        cond.notify_all();
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Render thread
+//
+
+void render_server::impl::render_loop()
+{
+    camera_update cam;
+    uint32_t frame_num = 0;
+    bool progressive = false;
+
+    for (;;)
+    {
+        std::unique_lock<std::mutex> l(mutex);
+
+        cond.wait(l, [&]() { return !running || (conn && (camera_new || progressive)); });
+
+        if (!running)
+        {
+            break;
+        }
+
+        bool camera_changed = camera_new;
+        time_point start = clock::now();
+
+        if (camera_new)
+        {
+            cam = camera;
+            start = camera_received;
+            camera_new = false;
+            frame_num = 0;
+        }
+
+        l.unlock();
+
+        std::vector<pixel_type> pixels(static_cast<size_t>(cam.width) * cam.height);
+
+        timer t;
+        progressive = func(cam, camera_changed, pixels.data());
+        double render_time = t.elapsed();
+
+        l.lock();
+
+        stats.render.add(render_time);
+
+        // Wait until the encoder has picked up the previous frame
+        cond.wait(l, [&]() { return !running || encode_queue.empty(); });
+
+        if (!running)
+        {
+            break;
+        }
+
+        encode_queue.push_back({ cam, frame_num++, std::move(pixels), start, render_time });
+        cond.notify_all();
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Encode thread
+//
+
+void render_server::impl::encode_loop()
+{
+    for (;;)
+    {
+        std::unique_lock<std::mutex> l(mutex);
+
+        cond.wait(l, [&]()
+        {
+            return !running || (!encode_queue.empty() && pending_sends.size() < max_in_flight);
+        });
+
+        if (!running)
+        {
+            break;
+        }
+
+        frame f = std::move(encode_queue.front());
+        encode_queue.pop_front();
+        cond.notify_all();
+
+        auto c = conn;
+
+        if (reset_encoder)
+        {
+            encoder.reset();
+            reset_encoder = false;
+        }
+
+        l.unlock();
+
+        if (!c)
+        {
+            continue;
+        }
+
+        timer t;
+
+        std::vector<char> data;
+        serialize(frame_info{}, data);
+
+        encoder.set_encoding(f.cam.encoding <= TileEncoding ? static_cast<frame_encoding>(f.cam.encoding) : RawEncoding);
+        encoder.encode(f.pixels.data(), f.cam.width, f.cam.height, data);
+
+        double encode_time = t.elapsed();
+
+        auto now = clock::now();
+
+        frame_info info;
+        info.seq = f.cam.seq;
+        info.frame_num = f.frame_num;
+        info.render_time = static_cast<float>(f.render_time);
+        info.encode_time = static_cast<float>(encode_time);
+        info.latency = static_cast<float>(seconds(now - f.start));
+        std::memcpy(data.data(), &info, sizeof(info));
+
+        l.lock();
+
+        stats.encode.add(encode_time);
+
+        if (c != conn)
+        {
+            // Client changed while encoding
+            continue;
+        }
+
+        pending_sends.push_back({ now, f.start });
+
+        l.unlock();
+
+        c->write(FrameMessage, data);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// render_server
+//
+
+render_server::render_server(unsigned short port, render_func func)
+    : impl_(new impl(port, func))
+{
+}
+
+render_server::~render_server()
+{
+    stop();
+}
+
+void render_server::start()
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    if (impl_->running)
+    {
+        return;
+    }
+
+    impl_->running = true;
+
+    impl_->manager = async::make_connection_manager(impl_->port);
+    impl_->manager->accept([this](async::connection_pointer c, boost::system::error_code const& e)
+    {
+        return impl_->handle_accept(c, e);
+    });
+    impl_->manager->run_in_thread();
+
+    impl_->render_thread = std::thread(&impl::render_loop, impl_.get());
+    impl_->encode_thread = std::thread(&impl::encode_loop, impl_.get());
+}
+
+void render_server::stop()
+{
+    {
+        std::unique_lock<std::mutex> l(impl_->mutex);
+
+        if (!impl_->running)
+        {
+            return;
+        }
+
+        impl_->running = false;
+        impl_->cond.notify_all();
+    }
+
+    impl_->render_thread.join();
+    impl_->encode_thread.join();
+
+    impl_->manager->stop();
+    impl_->manager->wait();
+
+    impl_->conn = nullptr;
+    impl_->manager = nullptr;
+    impl_->encode_queue.clear();
+    impl_->pending_sends.clear();
+}
+
+void render_server::wait()
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    impl_->cond.wait(l, [this]() { return !impl_->running; });
+}
+
+unsigned short render_server::port() const
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    return impl_->manager ? impl_->manager->port() : impl_->port;
+}
+
+void render_server::set_max_frames_in_flight(unsigned num_frames)
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    impl_->max_in_flight = max(num_frames, 1U);
+    impl_->cond.notify_all();
+}
+
+unsigned render_server::max_frames_in_flight() const
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    return impl_->max_in_flight;
+}
+
+void render_server::set_max_image_size(int size)
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    impl_->max_size = max(size, 1);
+}
+
+int render_server::max_image_size() const
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    return impl_->max_size;
+}
+
+render_server::statistics render_server::stats() const
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+    return impl_->stats;
+}
+
+} // remote
+} // visionaray
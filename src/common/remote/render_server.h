@@ -0,0 +1,104 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_REMOTE_RENDER_SERVER_H
+#define VSNRAY_COMMON_REMOTE_RENDER_SERVER_H 1
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "frame_codec.h"
+#include "render_protocol.h"
+
+namespace visionaray
+{
+namespace remote
+{
+
+//-------------------------------------------------------------------------------------------------
+// Render server
+//
+// Accepts a client (see render_client), receives camera updates and sends back
+// encoded frames. Rendering and encoding run in separate threads, so that the
+// next frame is rendered while the previous one is encoded and sent. If the
+// network is slower than rendering, at most max_frames_in_flight() encoded
+// frames are queued for sending; the render thread then waits, and the next
+// frame uses the most recent camera.
+//
+// Only one client is served at a time, a new connection replaces the previous.
+// Camera updates with an empty viewport or one larger than max_image_size() in
+// either dimension are ignored, so that clients cannot make the server allocate
+// arbitrarily large frames.
+//
+
+class render_server
+{
+public:
+
+    using pixel_type = frame_encoder::pixel_type;
+
+    // Render the frame for camera cam into pixels (cam.width * cam.height, origin
+    // at the bottom left). camera_changed is false if called again for the same
+    // camera. Return true to be called again with the same camera (progressive
+    // refinement), false to wait for the next camera update.
+    using render_func = std::function<bool(camera_update const& cam, bool camera_changed, pixel_type* pixels)>;
+
+    struct statistics
+    {
+        stage_stats render;
+        stage_stats encode;
+
+        // Time from handing the frame to the network layer until it was written
+        stage_stats send;
+
+        // Time from receiving the camera update until the frame was written
+        stage_stats latency;
+
+        size_t bytes_sent = 0;
+        unsigned frames_sent = 0;
+
+        // Camera updates ignored because of their viewport size
+        unsigned cameras_rejected = 0;
+    };
+
+public:
+
+    render_server(unsigned short port, render_func func);
+   ~render_server();
+
+    // Start accepting clients and rendering, returns immediately
+    void start();
+
+    // Stop all threads, blocks until they have finished
+    void stop();
+
+    // Block until stop() is called from another thread
+    void wait();
+
+    // Port the server listens on. After start(), this is the port chosen by the
+    // system if the server was constructed with port 0
+    unsigned short port() const;
+
+    void set_max_frames_in_flight(unsigned num_frames);
+    unsigned max_frames_in_flight() const;
+
+    // Largest viewport width and height accepted from clients
+    void set_max_image_size(int size);
+    int max_image_size() const;
+
+    statistics stats() const;
+
+private:
+
+    struct impl;
+    std::unique_ptr<impl> impl_;
+
+};
+
+} // remote
+} // visionaray
+
+#endif // VSNRAY_COMMON_REMOTE_RENDER_SERVER_H
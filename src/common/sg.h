@@ -123,6 +123,11 @@ public:
     texture2d(texture2d const&) = default;
     texture2d(texture2d&&) = default;
 
+    texture2d(int w, int h)
+    {
+        resize(w, h);
+    }
+
     // Copy-construct from base
     texture2d(visionaray::texture<T, 2> const& base)
         : visionaray::texture<T, 2>(base)
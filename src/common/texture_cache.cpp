@@ -0,0 +1,485 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "image.h"
+#include "make_texture.h"
+#include "texture_cache.h"
+
+namespace visionaray
+{
+
+//-------------------------------------------------------------------------------------------------
+// File format helpers
+//
+
+namespace tiled
+{
+
+static char const magic[4] = { 'V', 'S', 'N', 'T' };
+static uint32_t const version = 1;
+static size_t const header_size = 4 + 3 * sizeof(uint32_t);
+static size_t const level_header_size = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+static size_t const tile_alignment = 4096;
+
+inline void put_u32(std::vector<char>& out, uint32_t u)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<char>((u >> (i * 8)) & 0xFF));
+    }
+}
+
+inline void put_u64(std::vector<char>& out, uint64_t u)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        out.push_back(static_cast<char>((u >> (i * 8)) & 0xFF));
+    }
+}
+
+inline uint32_t get_u32(char const* in)
+{
+    uint32_t u = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        u |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (i * 8);
+    }
+
+    return u;
+}
+
+inline uint64_t get_u64(char const* in)
+{
+    uint64_t u = 0;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        u |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (i * 8);
+    }
+
+    return u;
+}
+
+inline unsigned num_tiles(unsigned size, unsigned tile_size)
+{
+    return (size + tile_size - 1) / tile_size;
+}
+
+// 2x2 box filter, odd sizes replicate the last row / column
+std::vector<vector<4, unorm<8>>> downsample(
+        vector<4, unorm<8>> const*  src,
+        unsigned                    width,
+        unsigned                    height
+        )
+{
+    unsigned w = std::max(width / 2, 1U);
+    unsigned h = std::max(height / 2, 1U);
+
+    std::vector<vector<4, unorm<8>>> dst(size_t(w) * h);
+
+    for (unsigned y = 0; y < h; ++y)
+    {
+        size_t row0 = size_t(std::min(y * 2, height - 1)) * width;
+        size_t row1 = size_t(std::min(y * 2 + 1, height - 1)) * width;
+
+        for (unsigned x = 0; x < w; ++x)
+        {
+            unsigned x0 = std::min(x * 2, width - 1);
+            unsigned x1 = std::min(x * 2 + 1, width - 1);
+
+            vec4 sum = vec4(src[row0 + x0])
+                     + vec4(src[row0 + x1])
+                     + vec4(src[row1 + x0])
+                     + vec4(src[row1 + x1]);
+
+            dst[size_t(y) * w + x] = vector<4, unorm<8>>(sum * 0.25f);
+        }
+    }
+
+    return dst;
+}
+
+} // tiled
+
+
+//-------------------------------------------------------------------------------------------------
+// Conversion to tiled texture files
+//
+
+bool make_tiled_texture_file(
+        vector<4, unorm<8>> const*  data,
+        int                         width,
+        int                         height,
+        std::string const&          filename,
+        unsigned                    tile_size
+        )
+{
+    using texel_type = vector<4, unorm<8>>;
+
+    if (data == nullptr || width <= 0 || height <= 0 || tile_size == 0)
+    {
+        return false;
+    }
+
+    // Mip chain down to 1x1, level 0 is read from data
+    std::vector<texel_type const*> levels;
+    std::vector<std::vector<texel_type>> downsampled;
+    std::vector<std::pair<unsigned, unsigned>> sizes;
+
+    levels.push_back(data);
+    sizes.emplace_back(width, height);
+
+    while (sizes.back().first > 1 || sizes.back().second > 1)
+    {
+        auto size = sizes.back();
+        downsampled.push_back(tiled::downsample(levels.back(), size.first, size.second));
+        levels.push_back(downsampled.back().data());
+        sizes.emplace_back(std::max(size.first / 2, 1U), std::max(size.second / 2, 1U));
+    }
+
+    size_t tile_bytes = size_t(tile_size) * tile_size * sizeof(texel_type);
+
+    // Header
+    std::vector<char> header(tiled::magic, tiled::magic + 4);
+    tiled::put_u32(header, tiled::version);
+    tiled::put_u32(header, tile_size);
+    tiled::put_u32(header, static_cast<uint32_t>(levels.size()));
+
+    size_t header_bytes = tiled::header_size + levels.size() * tiled::level_header_size;
+    uint64_t offset = (header_bytes + tiled::tile_alignment - 1) / tiled::tile_alignment * tiled::tile_alignment;
+
+    for (auto const& size : sizes)
+    {
+        tiled::put_u32(header, size.first);
+        tiled::put_u32(header, size.second);
+        tiled::put_u64(header, offset);
+
+        offset += uint64_t(tiled::num_tiles(size.first, tile_size)) * tiled::num_tiles(size.second, tile_size) * tile_bytes;
+    }
+
+    header.resize((header_bytes + tiled::tile_alignment - 1) / tiled::tile_alignment * tiled::tile_alignment, 0);
+
+    std::ofstream file(filename, std::ios::binary);
+
+    if (!file.good())
+    {
+        return false;
+    }
+
+    file.write(header.data(), header.size());
+
+    // Tiles, padded by replicating the border texels
+    std::vector<texel_type> tile(size_t(tile_size) * tile_size);
+
+    for (size_t l = 0; l < levels.size(); ++l)
+    {
+        unsigned w = sizes[l].first;
+        unsigned h = sizes[l].second;
+
+        for (unsigned ty = 0; ty < tiled::num_tiles(h, tile_size); ++ty)
+        {
+            for (unsigned tx = 0; tx < tiled::num_tiles(w, tile_size); ++tx)
+            {
+                for (unsigned y = 0; y < tile_size; ++y)
+                {
+                    for (unsigned x = 0; x < tile_size; ++x)
+                    {
+                        unsigned xx = std::min(tx * tile_size + x, w - 1);
+                        unsigned yy = std::min(ty * tile_size + y, h - 1);
+                        tile[y * tile_size + x] = levels[l][size_t(yy) * w + xx];
+                    }
+                }
+
+                file.write(reinterpret_cast<char const*>(tile.data()), tile_bytes);
+            }
+        }
+    }
+
+    return file.good();
+}
+
+bool make_tiled_texture_file(
+        image const&                img,
+        std::string const&          filename,
+        unsigned                    tile_size
+        )
+{
+    texture<vector<4, unorm<8>>, 2> tex(img.width(), img.height());
+    make_texture(tex, img);
+
+    return make_tiled_texture_file(tex.data(), img.width(), img.height(), filename, tile_size);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// texture_cache private implementation
+//
+
+struct texture_cache::impl
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<boost::iostreams::mapped_file_source>> files;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// texture_cache
+//
+
+texture_cache::texture_cache(size_t capacity_bytes, unsigned tile_size)
+    : tile_size_(tile_size)
+    , tile_texels_(static_cast<size_t>(tile_size) * tile_size)
+    , capacity_(std::max(capacity_bytes / (tile_texels_ * sizeof(texel_type)), size_t(1)))
+    , slots_(capacity_)
+    , hit_counters_(NumHitCounters)
+    , data_(capacity_ * tile_texels_)
+    , clock_(0)
+    , misses_(0)
+    , evictions_(0)
+    , impl_(new impl)
+{
+    assert(tile_size > 0);
+
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+        slots_[i].key = ~uint64_t(0);
+        slots_[i].pins = 0;
+        slots_[i].last_use = 0;
+    }
+
+    for (auto& counter : hit_counters_)
+    {
+        counter.value = 0;
+    }
+}
+
+texture_cache::~texture_cache() = default;
+
+int texture_cache::open(std::string const& filename)
+{
+    std::unique_ptr<boost::iostreams::mapped_file_source> file(
+            new boost::iostreams::mapped_file_source(filename)
+            );
+
+    char const* bytes = file->data();
+    size_t file_size = file->size();
+
+    if (file_size < tiled::header_size || std::memcmp(bytes, tiled::magic, 4) != 0)
+    {
+        throw std::runtime_error("Invalid tiled texture file");
+    }
+
+    if (tiled::get_u32(bytes + 4) != tiled::version)
+    {
+        throw std::runtime_error("Unsupported tiled texture file version");
+    }
+
+    if (tiled::get_u32(bytes + 8) != tile_size_)
+    {
+        throw std::runtime_error("Tiled texture file does not match the cache's tile size");
+    }
+
+    uint32_t num_levels = tiled::get_u32(bytes + 12);
+
+    if (num_levels == 0 || file_size < tiled::header_size + num_levels * tiled::level_header_size)
+    {
+        throw std::runtime_error("Invalid tiled texture file");
+    }
+
+    texture_desc tex;
+    tex.num_pages = 0;
+
+    for (uint32_t l = 0; l < num_levels; ++l)
+    {
+        char const* lh = bytes + tiled::header_size + l * tiled::level_header_size;
+
+        level_desc lvl;
+        lvl.width = tiled::get_u32(lh);
+        lvl.height = tiled::get_u32(lh + 4);
+        lvl.offset = tiled::get_u64(lh + 8);
+        lvl.tiles_x = tiled::num_tiles(lvl.width, tile_size_);
+        lvl.tiles_y = tiled::num_tiles(lvl.height, tile_size_);
+        lvl.first_page = tex.num_pages;
+
+        uint64_t level_bytes = uint64_t(lvl.tiles_x) * lvl.tiles_y * tile_texels_ * sizeof(texel_type);
+
+        if (lvl.width == 0 || lvl.height == 0 || lvl.offset + level_bytes > file_size)
+        {
+            throw std::runtime_error("Invalid tiled texture file");
+        }
+
+        tex.levels.push_back(lvl);
+        tex.num_pages += size_t(lvl.tiles_x) * lvl.tiles_y;
+    }
+
+    tex.pages.reset(new std::atomic<int>[tex.num_pages]);
+
+    for (size_t i = 0; i < tex.num_pages; ++i)
+    {
+        tex.pages[i] = -1;
+    }
+
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    textures_.push_back(std::move(tex));
+    impl_->files.push_back(std::move(file));
+
+    return static_cast<int>(textures_.size() - 1);
+}
+
+unsigned texture_cache::num_levels(int texture) const
+{
+    return static_cast<unsigned>(textures_[texture].levels.size());
+}
+
+std::array<unsigned, 2> texture_cache::size(int texture, unsigned level) const
+{
+    level_desc const& lvl = textures_[texture].levels[level];
+    return {{ lvl.width, lvl.height }};
+}
+
+cached_texture_ref texture_cache::ref(int texture, unsigned level)
+{
+    return cached_texture_ref(this, texture, level);
+}
+
+unsigned texture_cache::tile_size() const
+{
+    return tile_size_;
+}
+
+texture_cache::statistics texture_cache::stats() const
+{
+    statistics result;
+    result.misses = misses_.load();
+    result.evictions = evictions_.load();
+    result.capacity_tiles = capacity_;
+
+    for (auto const& counter : hit_counters_)
+    {
+        result.hits += counter.value.load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+        if (slots_[i].key.load(std::memory_order_relaxed) != ~uint64_t(0))
+        {
+            ++result.resident_tiles;
+        }
+    }
+
+    return result;
+}
+
+void texture_cache::reset_stats()
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    for (auto& counter : hit_counters_)
+    {
+        counter.value = 0;
+    }
+
+    misses_ = 0;
+    evictions_ = 0;
+}
+
+bool texture_cache::load_tile(int texture, unsigned level, size_t page)
+{
+    std::unique_lock<std::mutex> l(impl_->mutex);
+
+    texture_desc& tex = textures_[texture];
+    uint64_t key = make_key(texture, page);
+
+    // Another thread might have loaded the tile in the meantime
+    int resident = tex.pages[page].load();
+
+    if (resident >= 0 && slots_[resident].key.load() == key)
+    {
+        return false;
+    }
+
+    ++misses_;
+    uint64_t now = ++clock_;
+
+    // Find a slot: unused slots first, then the least recently used one that is not pinned
+    int s = -1;
+
+    for (;;)
+    {
+        uint64_t oldest = ~uint64_t(0);
+
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            slot& sl = slots_[i];
+
+            if (sl.texture < 0)
+            {
+                s = static_cast<int>(i);
+                break;
+            }
+
+            if (sl.pins.load(std::memory_order_relaxed) == 0 && sl.last_use.load(std::memory_order_relaxed) < oldest)
+            {
+                oldest = sl.last_use.load(std::memory_order_relaxed);
+                s = static_cast<int>(i);
+            }
+        }
+
+        if (s < 0)
+        {
+            // All slots pinned, fetches don't hold pins for long
+            continue;
+        }
+
+        slot& victim = slots_[s];
+
+        if (victim.texture < 0)
+        {
+            break;
+        }
+
+        // Invalidate, then check that no fetch pinned the slot in between; a fetch
+        // that pins after this point sees the invalid key
+        uint64_t old_key = victim.key.exchange(~uint64_t(0));
+
+        if (victim.pins.load() == 0)
+        {
+            textures_[victim.texture].pages[victim.page].store(-1);
+            ++evictions_;
+            break;
+        }
+
+        victim.key.store(old_key);
+        s = -1;
+    }
+
+    slot& sl = slots_[s];
+
+    level_desc const& lvl = tex.levels[level];
+    size_t tile_bytes = tile_texels_ * sizeof(texel_type);
+    char const* src = impl_->files[texture]->data() + lvl.offset + (page - lvl.first_page) * tile_bytes;
+
+    std::memcpy(data_.data() + s * tile_texels_, src, tile_bytes);
+
+    sl.texture = texture;
+    sl.page = page;
+    sl.last_use.store(now, std::memory_order_relaxed);
+    sl.key.store(key);
+    tex.pages[page].store(s, std::memory_order_release);
+
+    return true;
+}
+
+} // visionaray
@@ -0,0 +1,391 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_COMMON_TEXTURE_CACHE_H
+#define VSNRAY_COMMON_TEXTURE_CACHE_H 1
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <visionaray/math/simd/gather.h>
+#include <visionaray/math/simd/type_traits.h>
+#include <visionaray/math/unorm.h>
+#include <visionaray/math/vector.h>
+#include <visionaray/texture/texture.h>
+#include <visionaray/aligned_vector.h>
+
+namespace visionaray
+{
+
+class image;
+class texture_cache;
+
+//-------------------------------------------------------------------------------------------------
+// Tiled texture files
+//
+// Textures are converted once into a mip-mapped file that stores each level as
+// square tiles of RGBA8 texels (tiles at the right and bottom border are padded).
+// Tiles are stored contiguously and row-major, the texels in a tile are row-major.
+//
+// Layout (all multi-byte values little-endian):
+//
+//  char[4]     magic ("VSNT")
+//  uint32      version
+//  uint32      tile_size
+//  uint32      num_levels
+//  level[]     uint32 width, uint32 height, uint64 byte offset of the level's first tile
+//  tile[]      tile_size * tile_size texels; the first tile is 4K aligned
+//
+
+bool make_tiled_texture_file(
+        vector<4, unorm<8>> const*  data,
+        int                         width,
+        int                         height,
+        std::string const&          filename,
+        unsigned                    tile_size = 64
+        );
+
+// Converts the image to RGBA8 first, see make_texture()
+bool make_tiled_texture_file(
+        image const&                img,
+        std::string const&          filename,
+        unsigned                    tile_size = 64
+        );
+
+
+//-------------------------------------------------------------------------------------------------
+// Texture storage that fetches texels through a texture_cache, see cached_texture_ref
+//
+
+class cached_texture_storage
+{
+public:
+
+    using value_type = vector<4, unorm<8>>;
+    enum { dimensions = 2 };
+
+public:
+
+    cached_texture_storage() = default;
+
+    cached_texture_storage(texture_cache* cache, int texture, unsigned level);
+
+    std::array<unsigned, 2> size() const
+    {
+        return size_;
+    }
+
+    template <
+        typename U,
+        typename I,
+        typename = typename std::enable_if<!simd::is_simd_vector<I>::value>::type
+        >
+    U value(U /* */, I const& x, I const& y) const;
+
+    template <
+        typename U,
+        typename I,
+        typename = typename std::enable_if<simd::is_simd_vector<I>::value>::type,
+        typename = void
+        >
+    U value(U /* */, I const& x, I const& y) const;
+
+    texture_cache* cache() const
+    {
+        return cache_;
+    }
+
+    operator bool() const
+    {
+        return cache_ != nullptr;
+    }
+
+protected:
+
+    texture_cache* cache_ = nullptr;
+    int texture_ = -1;
+    unsigned level_ = 0;
+    std::array<unsigned, 2> size_ {{ 0, 0 }};
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// View to one mip level of a cached texture, use with tex2D()
+//
+
+struct cached_texture_ref : texture_base<2, cached_texture_storage>
+{
+    using value_type = vector<4, unorm<8>>;
+    using base_type = texture_base<2, cached_texture_storage>;
+    enum { dimensions = 2 };
+
+    cached_texture_ref() = default;
+
+    // Same defaults as make_texture()
+    cached_texture_ref(texture_cache* cache, int texture, unsigned level)
+        : base_type(cache, texture, level)
+    {
+        set_address_mode(Wrap);
+        set_filter_mode(Linear);
+        set_color_space(sRGB);
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Fixed-size cache of texture tiles, shared by all textures opened with it
+//
+// Texture files are memory-mapped, tiles are copied into the cache when a texel
+// fetch misses. When the cache is full, the least recently used tile is evicted.
+// Recency is tracked per miss: a hit stamps its tile with the number of misses so
+// far, so tiles that were hit since the last miss are not distinguished.
+//
+// Lookups don't lock. Each texture has a table that maps its tiles to cache slots.
+// A fetch pins the slot and checks that it still holds the tile before reading
+// from it, a miss loads the tile under a lock. Slots are only reused when they
+// are not pinned. open() must not be called concurrently with texel fetches.
+//
+// Apart from the pin, a hit only writes shared memory when the tile's recency
+// changes; hits are counted per thread (see hit_counter).
+//
+
+class texture_cache
+{
+public:
+
+    using texel_type = vector<4, unorm<8>>;
+
+    struct statistics
+    {
+        uint64_t hits               = 0;
+        uint64_t misses             = 0;
+        uint64_t evictions          = 0;
+        size_t   resident_tiles     = 0;
+        size_t   capacity_tiles     = 0;
+
+        double hit_rate() const
+        {
+            uint64_t fetches = hits + misses;
+            return fetches > 0 ? static_cast<double>(hits) / fetches : 0.0;
+        }
+    };
+
+public:
+
+    // Holds as many tiles of tile_size * tile_size texels as fit into capacity_bytes
+    // (at least one); tiled texture files must have the same tile size
+    explicit texture_cache(size_t capacity_bytes, unsigned tile_size = 64);
+   ~texture_cache();
+
+    texture_cache(texture_cache const&) = delete;
+    texture_cache& operator=(texture_cache const&) = delete;
+
+    // Maps a tiled texture file, returns the texture id; throws if the file is invalid
+    int open(std::string const& filename);
+
+    unsigned num_levels(int texture) const;
+
+    std::array<unsigned, 2> size(int texture, unsigned level) const;
+
+    // View for tex2D()
+    cached_texture_ref ref(int texture, unsigned level = 0);
+
+    // Texel (x,y) of a mip level, loads the tile if not resident
+    texel_type texel(int texture, unsigned level, int x, int y);
+
+    unsigned tile_size() const;
+
+    statistics stats() const;
+
+    void reset_stats();
+
+private:
+
+    struct VSNRAY_ALIGN(64) slot
+    {
+        std::atomic<uint64_t> key;
+        std::atomic<uint32_t> pins;
+        std::atomic<uint64_t> last_use;
+
+        // Guarded by the lock
+        int texture = -1;
+        size_t page = 0;
+    };
+
+    // Hit counters on separate cache lines. Threads are assigned a counter
+    // round-robin on their first fetch, so unless there are more threads than
+    // counters, each thread increments a cache line no other thread writes to
+    enum { NumHitCounters = 64 };
+
+    struct VSNRAY_ALIGN(64) hit_counter
+    {
+        std::atomic<uint64_t> value;
+    };
+
+    static unsigned hit_counter_index();
+
+    struct level_desc
+    {
+        unsigned width;
+        unsigned height;
+        unsigned tiles_x;
+        unsigned tiles_y;
+        size_t first_page;
+        uint64_t offset;
+    };
+
+    struct texture_desc
+    {
+        std::vector<level_desc> levels;
+        std::unique_ptr<std::atomic<int>[]> pages;
+        size_t num_pages;
+    };
+
+    static uint64_t make_key(int texture, size_t page)
+    {
+        return (static_cast<uint64_t>(texture) << 40) | page;
+    }
+
+    // Miss path, loads the tile into a free or the least recently used slot;
+    // returns false if another thread loaded the tile in the meantime
+    bool load_tile(int texture, unsigned level, size_t page);
+
+    unsigned tile_size_;
+    size_t tile_texels_;
+    size_t capacity_;
+
+    aligned_vector<slot, 64> slots_;
+    aligned_vector<hit_counter, 64> hit_counters_;
+    aligned_vector<texel_type> data_;
+    std::vector<texture_desc> textures_;
+
+    std::atomic<uint64_t> clock_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> evictions_;
+
+    // Lock and file mappings
+    struct impl;
+    std::unique_ptr<impl> impl_;
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Implementation of inline functions
+//
+
+inline texture_cache::texel_type texture_cache::texel(int texture, unsigned level, int x, int y)
+{
+    texture_desc const& tex = textures_[texture];
+    level_desc const& lvl = tex.levels[level];
+
+    unsigned ux = static_cast<unsigned>(x);
+    unsigned uy = static_cast<unsigned>(y);
+
+    size_t page = lvl.first_page + (uy / tile_size_) * lvl.tiles_x + ux / tile_size_;
+    size_t offset = (uy % tile_size_) * tile_size_ + ux % tile_size_;
+    uint64_t key = make_key(texture, page);
+
+    // Fetches that loaded the tile count as misses only
+    bool missed = false;
+
+    for (;;)
+    {
+        int s = tex.pages[page].load(std::memory_order_acquire);
+
+        if (s >= 0)
+        {
+            slot& sl = slots_[s];
+
+            // Pin before checking the key, eviction invalidates the key before
+            // checking the pins (see load_tile())
+            sl.pins.fetch_add(1);
+
+            if (sl.key.load() == key)
+            {
+                texel_type result = data_[s * tile_texels_ + offset];
+
+                // Recency only changes with misses, don't write the slot's cache
+                // line if the tile was already used since the last miss
+                uint64_t now = clock_.load(std::memory_order_relaxed);
+
+                if (sl.last_use.load(std::memory_order_relaxed) != now)
+                {
+                    sl.last_use.store(now, std::memory_order_relaxed);
+                }
+
+                sl.pins.fetch_sub(1, std::memory_order_release);
+
+                if (!missed)
+                {
+                    hit_counters_[hit_counter_index()].value.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                return result;
+            }
+
+            sl.pins.fetch_sub(1, std::memory_order_release);
+        }
+
+        missed |= load_tile(texture, level, page);
+    }
+}
+
+inline unsigned texture_cache::hit_counter_index()
+{
+    static std::atomic<unsigned> next_index(0);
+    static thread_local unsigned index = next_index.fetch_add(1, std::memory_order_relaxed) % NumHitCounters;
+
+    return index;
+}
+
+inline cached_texture_storage::cached_texture_storage(texture_cache* cache, int texture, unsigned level)
+    : cache_(cache)
+    , texture_(texture)
+    , level_(level)
+    , size_(cache->size(texture, level))
+{
+}
+
+template <typename U, typename I, typename>
+inline U cached_texture_storage::value(U /* */, I const& x, I const& y) const
+{
+    return U(cache_->texel(texture_, level_, static_cast<int>(x), static_cast<int>(y)));
+}
+
+template <typename U, typename I, typename, typename>
+inline U cached_texture_storage::value(U /* */, I const& x, I const& y) const
+{
+    enum { N = simd::num_elements<I>::value };
+
+    simd::aligned_array_t<I> xs;
+    simd::aligned_array_t<I> ys;
+    simd::aligned_array_t<I> lanes;
+
+    store(xs, x);
+    store(ys, y);
+
+    // Fetch per lane, then let gather() convert to SIMD
+    value_type texels[N];
+
+    for (int i = 0; i < N; ++i)
+    {
+        texels[i] = cache_->texel(texture_, level_, xs[i], ys[i]);
+        lanes[i] = i;
+    }
+
+    return U(gather(texels, I(lanes)));
+}
+
+} // visionaray
+
+#endif // VSNRAY_COMMON_TEXTURE_CACHE_H
@@ -1,13 +1,17 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
-#include <cstring> // for memset
-#include <fstream>
+#include <cstring> // for memcpy
+#include <exception>
 #include <iostream>
 #include <ostream>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 #include <visionaray/swizzle.h>
 
 #include "tga_image.h"
@@ -60,37 +64,46 @@ pixel_format map_pixel_depth(uint8_t bits_per_pixel)
 }
 
 
-void load_true_color_uncompressed(
+static bool load_true_color_uncompressed(
         uint8_t*        dst,
-        std::ifstream&  file,
+        uint8_t const*  src,
+        size_t          size,
         int             width,
         int             height,
         int             bytes_per_pixel,
         bool            flip_y
         )
 {
-    int pitch = width * bytes_per_pixel;
+    size_t pitch = static_cast<size_t>(width) * bytes_per_pixel;
+
+    if (size < pitch * height)
+    {
+        return false;
+    }
 
     if (!flip_y)
     {
         // Origin is bottom/left corner - same as visionaray image format
-        file.read(reinterpret_cast<char*>(dst), pitch * height * sizeof(uint8_t));
+        std::memcpy(dst, src, pitch * height);
     }
     else
     {
         // Origin is top/left corner - convert to bottom/left
         for (int y = 0; y < height; ++y)
         {
-            auto ptr = dst + (height - 1) * pitch - y * pitch;
-            file.read(reinterpret_cast<char*>(ptr), pitch * sizeof(uint8_t));
+            auto ptr = dst + (height - 1 - y) * pitch;
+            std::memcpy(ptr, src + y * pitch, pitch);
         }
     }
+
+    return true;
 }
 
 
-void load_true_color_rle(
+static bool load_true_color_rle(
         uint8_t*        dst,
-        std::ifstream&  file,
+        uint8_t const*  src,
+        size_t          size,
         int             width,
         int             height,
         int             bytes_per_pixel,
@@ -99,6 +112,8 @@ void load_true_color_rle(
 {
     assert(width > 0 && height > 0);
 
+    uint8_t const* end = src + size;
+
     int pixels  = 0;
     int x       = 0;
     int y       = flip_y ? height - 1 : 0;
@@ -106,9 +121,12 @@ void load_true_color_rle(
 
     while (pixels < width * height)
     {
-        uint8_t hdr = 0;
+        if (src == end)
+        {
+            return false;
+        }
 
-        file.read((char*)&hdr, sizeof(hdr));
+        uint8_t hdr = *src++;
 
         // Run-length packet or raw packet?
         bool rle = (hdr & 0x80) != 0;
@@ -116,23 +134,29 @@ void load_true_color_rle(
         // Get number of pixels or repetition count
         int count = 1 + (hdr & 0x7f);
 
-        pixels += count;
+        // Packets may span rows, but not the image
+        count = std::min(count, width * height - pixels);
 
-        char buffer[4];
-        if (rle)
+        // Run-length packets store one pixel for the next COUNT pixels
+        size_t packet_size = static_cast<size_t>(rle ? 1 : count) * bytes_per_pixel;
+
+        if (static_cast<size_t>(end - src) < packet_size)
         {
-            // Read the RGB value for the next COUNT pixels
-            file.read(buffer, bytes_per_pixel);
+            return false;
         }
 
+        pixels += count;
+
         while (count-- > 0)
         {
             auto p = dst + (x + y * width) * bytes_per_pixel;
 
-            if (rle)
-                memcpy(p, buffer, bytes_per_pixel);
-            else
-                file.read((char*)p, bytes_per_pixel);
+            std::memcpy(p, src, bytes_per_pixel);
+
+            if (!rle)
+            {
+                src += bytes_per_pixel;
+            }
 
             // Adjust current pixel position
             ++x;
@@ -142,7 +166,14 @@ void load_true_color_rle(
                 y += yinc;
             }
         }
+
+        if (rle)
+        {
+            src += bytes_per_pixel;
+        }
     }
+
+    return true;
 }
 
 
@@ -152,21 +183,39 @@ void load_true_color_rle(
 
 bool tga_image::load(std::string const& filename)
 {
-    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    // Decode straight from the mapped file. Mapping throws if the
+    // file doesn't exist or is empty
+    boost::iostreams::mapped_file_source file;
+
+    try
+    {
+        file.open(filename);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Cannot open file " << filename << ": " << e.what() << '\n';
+        return false;
+    }
+
+    uint8_t const* bytes = reinterpret_cast<uint8_t const*>(file.data());
+    size_t size = file.size();
 
 
     // Read header
 
     tga_header header;
 
-    memset(&header, 0, sizeof(header));
+    if (size < sizeof(header))
+    {
+        std::cerr << "Invalid TGA file\n";
+        return false;
+    }
 
-    file.seekg (0, file.beg);
     //
     // XXX:
     // Values are always stored little-endian...
     //
-    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::memcpy(&header, bytes, sizeof(header));
 
 
     // Check header
@@ -189,13 +238,21 @@ bool tga_image::load(std::string const& filename)
 
     // Read image data
 
-    file.seekg(sizeof(header) + header.id_length, file.beg);
+    size_t offset = std::min(size, sizeof(header) + header.id_length);
 
     // Bit 5 specifies the screen origin:
     // 0 = Origin in lower left-hand corner.
     // 1 = Origin in upper left-hand corner.
     bool flip_y = (header.image_desc & (1 << 5)) != 0;
 
+    bool ok = true;
+
+    if (format_ == PF_UNSPECIFIED)
+    {
+        std::cerr << "Unsupported TGA pixel depth (" << (int)header.bits_per_pixel << ")\n";
+        return false;
+    }
+
     switch (header.image_type)
     {
     default:
@@ -210,9 +267,10 @@ bool tga_image::load(std::string const& filename)
         break;
 
     case 2:
-        load_true_color_uncompressed(
+        ok = load_true_color_uncompressed(
                 data_.data(),
-                file,
+                bytes + offset,
+                size - offset,
                 header.width,
                 header.height,
                 header.bits_per_pixel / 8,
@@ -221,9 +279,10 @@ bool tga_image::load(std::string const& filename)
         break;
 
     case 10:
-        load_true_color_rle(
+        ok = load_true_color_rle(
                 data_.data(),
-                file,
+                bytes + offset,
+                size - offset,
                 header.width,
                 header.height,
                 header.bits_per_pixel / 8,
@@ -233,6 +292,12 @@ bool tga_image::load(std::string const& filename)
 
     }
 
+    if (!ok)
+    {
+        std::cerr << "Unexpected end of TGA file\n";
+        return false;
+    }
+
 
     // Swizzle from BGR(A) to RGB(A)
 
@@ -21,8 +21,6 @@
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/spirit/include/qi.hpp>
 #include <boost/utility/string_ref.hpp>
-#include <boost/assign.hpp>
-#include <boost/bimap.hpp>
 #include <boost/filesystem.hpp>
 
 #include <rapidjson/document.h>
@@ -37,6 +35,7 @@
 #include <visionaray/texture/texture.h>
 
 #include "cfile.h"
+#include "data_file.h"
 #include "image.h"
 #include "make_texture.h"
 #include "model.h"
@@ -46,63 +45,6 @@
 using namespace visionaray;
 
 
-namespace data_file
-{
-
-//-------------------------------------------------------------------------------------------------
-// (included) data file meta data
-//
-
-struct meta_data
-{
-    enum encoding_t
-    {
-        Ascii,
-        Binary
-    };
-
-    // VecN are binary compatible w/ visionaray::vecN
-    enum data_type_t
-    {
-        U8,
-        Float,
-        Vec2u8,
-        Vec2f,
-        Vec3u8,
-        Vec3f,
-        Vec4u8,
-        Vec4f,
-    };
-
-    static boost::bimap<data_type_t, std::string> data_type_map;
-
-    enum compression_t
-    {
-        Raw
-    };
-
-    std::string   path;
-    encoding_t    encoding    = Binary;
-    data_type_t   data_type   = U8;
-    int           num_items   = 0;
-    compression_t compression = Raw;
-    char          separator   = ' ';
-};
-
-boost::bimap<meta_data::data_type_t, std::string> meta_data::data_type_map
-    = boost::assign::list_of<typename boost::bimap<meta_data::data_type_t, std::string>::relation>
-        ( U8,     "u8" )
-        ( Float,  "float" )
-        ( Vec2u8, "vec2u8" )
-        ( Vec2f,  "vec2f" )
-        ( Vec3u8, "vec3u8" )
-        ( Vec3f,  "vec3f" )
-        ( Vec4u8, "vec4u8" )
-        ( Vec4f,  "vec4f" );
-
-} // data_file
-
-
 //-------------------------------------------------------------------------------------------------
 // Floating point number parser
 //
@@ -121,11 +63,52 @@ bool parse_floats(It first, It last, Vector& vec, char separator = ' ')
             );
 }
 
-template <size_t N, typename Container>
-bool parse_as_vecN(data_file::meta_data md, Container& vecNs)
+//-------------------------------------------------------------------------------------------------
+// Read binary data file into a container with binary compatible value_type
+//
+
+template <typename Container>
+bool read_binary(data_file::meta_data const& md, Container& cont, data_file::blocked::worker_pool& pool)
 {
-    boost::iostreams::mapped_file_source file(md.path);
+    using value_type = typename Container::value_type;
+
+    size_t item_size = data_file::meta_data::num_components(md.data_type)
+                     * data_file::meta_data::word_size(md.data_type);
+    size_t num_bytes = static_cast<size_t>(md.num_items) * item_size;
+
+    if (num_bytes % sizeof(value_type) != 0)
+    {
+        return false;
+    }
+
+    if (md.compression == data_file::meta_data::Raw)
+    {
+        // Read the items in place from the mapped file
+        data_file::binary_view<value_type> items(md);
+
+        if (items.size() * sizeof(value_type) != num_bytes)
+        {
+            return false;
+        }
+
+        cont.resize(items.size());
+        std::copy(items.begin(), items.end(), cont.begin());
+    }
+    else
+    {
+        // Decompress straight into the container
+        boost::iostreams::mapped_file_source file(md.path);
+
+        cont.resize(num_bytes / sizeof(value_type));
+        data_file::blocked::decode(md, file.data(), file.size(), reinterpret_cast<char*>(cont.data()), pool);
+    }
+
+    return true;
+}
 
+template <size_t N, typename Container>
+bool parse_as_vecN(data_file::meta_data md, Container& vecNs, data_file::blocked::worker_pool& pool)
+{
     if (md.data_type == data_file::meta_data::Float)
     {
         if (md.num_items % N != 0)
@@ -133,65 +116,41 @@ bool parse_as_vecN(data_file::meta_data md, Container& vecNs)
             return false;
         }
 
-        std::vector<float> floats;
-
         if (md.encoding == data_file::meta_data::Ascii)
         {
+            boost::iostreams::mapped_file_source file(md.path);
             boost::string_ref text(file.data(), file.size());
 
+            std::vector<float> floats;
             parse_floats(text.cbegin(), text.cend(), floats, md.separator);
 
             if (static_cast<int>(floats.size()) != md.num_items)
             {
                 return false;
             }
-        }
-        else // Binary
-        {
-            floats.resize(md.num_items);
-            std::copy(
-                file.data(),
-                file.data() + file.size(),
-                reinterpret_cast<char*>(floats.data())
-                );
-        }
 
-        vecNs.resize(md.num_items / N);
-        for (size_t i = 0; i < vecNs.size(); ++i)
-        {
-            for (size_t j = 0; j < N; ++j)
+            vecNs.resize(md.num_items / N);
+            for (size_t i = 0; i < vecNs.size(); ++i)
             {
-                vecNs[i][j] = floats[i * N + j];
+                for (size_t j = 0; j < N; ++j)
+                {
+                    vecNs[i][j] = floats[i * N + j];
+                }
             }
         }
-    }
-    else if (md.data_type == data_file::meta_data::Vec2u8)
-    {
-        if (N != 2)
-        {
-            throw std::runtime_error("Type is Vec2u8 but N != 2");
-        }
-
-        if (md.encoding == data_file::meta_data::Ascii)
-        {
-            // Not implemented yet
-            return false;
-        }
         else // Binary
         {
-            vecNs.resize(md.num_items);
-            std::copy(
-                file.data(),
-                file.data() + file.size(),
-                reinterpret_cast<char*>(vecNs.data())
-                );
+            // N consecutive floats are binary compatible w/ visionaray::vecN
+            return read_binary(md, vecNs, pool);
         }
     }
-    else if (md.data_type == data_file::meta_data::Vec2f)
+    else if (data_file::meta_data::num_components(md.data_type) > 1)
     {
-        if (N != 2)
+        if (data_file::meta_data::num_components(md.data_type) != N)
         {
-            throw std::runtime_error("Type is Vec2f but N != 2");
+            throw std::runtime_error("Type has " + std::to_string(
+                    data_file::meta_data::num_components(md.data_type))
+                    + " components but N != " + std::to_string(N));
         }
 
         if (md.encoding == data_file::meta_data::Ascii)
@@ -201,116 +160,40 @@ bool parse_as_vecN(data_file::meta_data md, Container& vecNs)
         }
         else // Binary
         {
-            vecNs.resize(md.num_items);
-            std::copy(
-                file.data(),
-                file.data() + file.size(),
-                reinterpret_cast<char*>(vecNs.data())
-                );
+            return read_binary(md, vecNs, pool);
         }
     }
-    else if (md.data_type == data_file::meta_data::Vec3u8)
-    {
-        if (N != 3)
-        {
-            throw std::runtime_error("Type is Vec3u8 but N != 3");
-        }
 
-        if (md.encoding == data_file::meta_data::Ascii)
-        {
-            // Not implemented yet
-            return false;
-        }
-        else // Binary
-        {
-            vecNs.resize(md.num_items);
-            std::copy(
-                file.data(),
-                file.data() + file.size(),
-                reinterpret_cast<char*>(vecNs.data())
-                );
-        }
-    }
-    else if (md.data_type == data_file::meta_data::Vec3f)
-    {
-        if (N != 3)
-        {
-            throw std::runtime_error("Type is Vec3f but N != 3");
-        }
+    return true;
+}
 
-        if (md.encoding == data_file::meta_data::Ascii)
-        {
-            // Not implemented yet
-            return false;
-        }
-        else // Binary
-        {
-            vecNs.resize(md.num_items);
-            std::copy(
-                file.data(),
-                file.data() + file.size(),
-                reinterpret_cast<char*>(vecNs.data())
-                );
-        }
-    }
-    else if (md.data_type == data_file::meta_data::Vec4u8)
+template <typename Container>
+bool parse_as_ints(data_file::meta_data md, Container& ints, data_file::blocked::worker_pool& pool)
+{
+    if (md.data_type != data_file::meta_data::I32)
     {
-        if (N != 4)
-        {
-            throw std::runtime_error("Type is Vec3u8 but N != 4");
-        }
-
-        if (md.encoding == data_file::meta_data::Ascii)
-        {
-            // Not implemented yet
-            return false;
-        }
-        else // Binary
-        {
-            vecNs.resize(md.num_items);
-            std::copy(
-                file.data(),
-                file.data() + file.size(),
-                reinterpret_cast<char*>(vecNs.data())
-                );
-        }
+        throw std::runtime_error("Type is not int");
     }
-    else if (md.data_type == data_file::meta_data::Vec4f)
-    {
-        if (N != 4)
-        {
-            throw std::runtime_error("Type is Vec4f but N != 4");
-        }
 
-        if (md.encoding == data_file::meta_data::Ascii)
-        {
-            // Not implemented yet
-            return false;
-        }
-        else // Binary
-        {
-            vecNs.resize(md.num_items);
-            std::copy(
-                file.data(),
-                file.data() + file.size(),
-                reinterpret_cast<char*>(vecNs.data())
-                );
-        }
+    if (md.encoding == data_file::meta_data::Ascii)
+    {
+        // Not implemented yet
+        return false;
     }
 
-    return true;
+    return read_binary(md, ints, pool);
 }
 
 template <typename Container>
-bool parse_as_vec2f(data_file::meta_data md, Container& vec2fs)
+bool parse_as_vec2f(data_file::meta_data md, Container& vec2fs, data_file::blocked::worker_pool& pool)
 {
-    return parse_as_vecN<2>(md, vec2fs);
+    return parse_as_vecN<2>(md, vec2fs, pool);
 }
 
 template <typename Container>
-bool parse_as_vec3f(data_file::meta_data md, Container& vec3fs)
+bool parse_as_vec3f(data_file::meta_data md, Container& vec3fs, data_file::blocked::worker_pool& pool)
 {
-    return parse_as_vecN<3>(md, vec3fs);
+    return parse_as_vecN<3>(md, vec3fs, pool);
 }
 
 
@@ -576,8 +459,9 @@ class vsnray_parser
 {
 public:
 
-    vsnray_parser(std::string filename)
+    vsnray_parser(std::string filename, data_file::blocked::worker_pool& pool)
         : filename_(filename)
+        , pool_(pool)
     {
     }
 
@@ -617,10 +501,16 @@ public:
     template <typename Object>
     data_file::meta_data parse_file_meta_data(Object const& obj);
 
+    template <typename Value, typename Container>
+    void parse_indices(Value const& indices, Container& cont);
+
 private:
 
     std::string filename_;
 
+    // Decodes compressed data files
+    data_file::blocked::worker_pool& pool_;
+
 };
 
 
@@ -1254,7 +1144,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_triangle_mesh(Object const& obj)
             {
                 auto md = parse_file_meta_data(verts);
 
-                if (!parse_as_vec3f(md, mesh->vertices))
+                if (!parse_as_vec3f(md, mesh->vertices, pool_))
                 {
                     throw std::runtime_error("Couldn't parse vertices");
                 }
@@ -1288,7 +1178,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_triangle_mesh(Object const& obj)
             {
                 auto md = parse_file_meta_data(normals);
 
-                if (!parse_as_vec3f(md, mesh->normals))
+                if (!parse_as_vec3f(md, mesh->normals, pool_))
                 {
                     throw std::runtime_error("Couldn't parse normals");
                 }
@@ -1339,7 +1229,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_triangle_mesh(Object const& obj)
             {
                 auto md = parse_file_meta_data(tex_coords);
 
-                if (!parse_as_vec2f(md, mesh->tex_coords))
+                if (!parse_as_vec2f(md, mesh->tex_coords, pool_))
                 {
                     throw std::runtime_error("Couldn't parse texture coordinates");
                 }
@@ -1382,7 +1272,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_triangle_mesh(Object const& obj)
             {
                 auto md = parse_file_meta_data(colors);
 
-                if (!parse_as_vec3f(md, mesh->colors))
+                if (!parse_as_vec3f(md, mesh->colors, pool_))
                 {
                     throw std::runtime_error("Couldn't parse colors");
                 }
@@ -1413,12 +1303,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_indexed_triangle_mesh(Object cons
 
     if (obj.HasMember("vertex_indices"))
     {
-        auto const& vertex_indices = obj["vertex_indices"];
-
-        for (auto const& item : vertex_indices.GetArray())
-        {
-            mesh->vertex_indices.push_back(item.GetInt());
-        }
+        parse_indices(obj["vertex_indices"], mesh->vertex_indices);
     }
     else
     {
@@ -1427,32 +1312,17 @@ std::shared_ptr<sg::node> vsnray_parser::parse_indexed_triangle_mesh(Object cons
 
     if (obj.HasMember("normal_indices"))
     {
-        auto const& normal_indices = obj["normal_indices"];
-
-        for (auto const& item : normal_indices.GetArray())
-        {
-            mesh->normal_indices.push_back(item.GetInt());
-        }
+        parse_indices(obj["normal_indices"], mesh->normal_indices);
     }
 
     if (obj.HasMember("tex_coord_indices"))
     {
-        auto const& tex_coord_indices = obj["tex_coord_indices"];
-
-        for (auto const& item : tex_coord_indices.GetArray())
-        {
-            mesh->tex_coord_indices.push_back(item.GetInt());
-        }
+        parse_indices(obj["tex_coord_indices"], mesh->tex_coord_indices);
     }
 
     if (obj.HasMember("color_indices"))
     {
-        auto const& color_indices = obj["color_indices"];
-
-        for (auto const& item : color_indices.GetArray())
-        {
-            mesh->color_indices.push_back(item.GetInt());
-        }
+        parse_indices(obj["color_indices"], mesh->color_indices);
     }
 
     if (obj.HasMember("vertices"))
@@ -1479,7 +1349,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_indexed_triangle_mesh(Object cons
             {
                 auto md = parse_file_meta_data(verts);
 
-                if (!parse_as_vec3f(md, *mesh->vertices))
+                if (!parse_as_vec3f(md, *mesh->vertices, pool_))
                 {
                     throw std::runtime_error("Couldn't parse vertices");
                 }
@@ -1511,7 +1381,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_indexed_triangle_mesh(Object cons
             {
                 auto md = parse_file_meta_data(normals);
 
-                if (!parse_as_vec3f(md, *mesh->normals))
+                if (!parse_as_vec3f(md, *mesh->normals, pool_))
                 {
                     throw std::runtime_error("Couldn't parse normals");
                 }
@@ -1546,7 +1416,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_indexed_triangle_mesh(Object cons
             {
                 auto md = parse_file_meta_data(tex_coords);
 
-                if (!parse_as_vec2f(md, *mesh->tex_coords))
+                if (!parse_as_vec2f(md, *mesh->tex_coords, pool_))
                 {
                     throw std::runtime_error("Couldn't parse texture coordinates");
                 }
@@ -1582,7 +1452,7 @@ std::shared_ptr<sg::node> vsnray_parser::parse_indexed_triangle_mesh(Object cons
             {
                 auto md = parse_file_meta_data(colors);
 
-                if (!parse_as_vec3f(md, *mesh->colors))
+                if (!parse_as_vec3f(md, *mesh->colors, pool_))
                 {
                     throw std::runtime_error("Couldn't parse colors");
                 }
@@ -1666,7 +1536,16 @@ data_file::meta_data vsnray_parser::parse_file_meta_data(Object const& obj)
     if (obj.HasMember("compression"))
     {
         std::string compression = obj["compression"].GetString();
-        if (compression == "none" || compression == "raw")
+
+        auto& compression_map = data_file::meta_data::compression_map;
+
+        auto it = compression_map.right.find(compression);
+
+        if (it != compression_map.right.end())
+        {
+            result.compression = it->second;
+        }
+        else if (compression == "raw")
         {
             result.compression = data_file::meta_data::Raw;
         }
@@ -1676,6 +1555,23 @@ data_file::meta_data vsnray_parser::parse_file_meta_data(Object const& obj)
         }
     }
 
+    if (obj.HasMember("byte_order"))
+    {
+        std::string byte_order = obj["byte_order"].GetString();
+        if (byte_order == "little")
+        {
+            result.byte_order = data_file::meta_data::LittleEndian;
+        }
+        else if (byte_order == "big")
+        {
+            result.byte_order = data_file::meta_data::BigEndian;
+        }
+        else
+        {
+            throw std::runtime_error("Invalid byte order");
+        }
+    }
+
     if (obj.HasMember("separator"))
     {
         std::string separator = obj["separator"].GetString();
@@ -1686,6 +1582,36 @@ data_file::meta_data vsnray_parser::parse_file_meta_data(Object const& obj)
 }
 
 
+template <typename Value, typename Container>
+void vsnray_parser::parse_indices(Value const& indices, Container& cont)
+{
+    if (indices.IsArray())
+    {
+        for (auto const& item : indices.GetArray())
+        {
+            cont.push_back(item.GetInt());
+        }
+    }
+    else if (indices.IsObject())
+    {
+        auto const& type_string = indices["type"];
+        if (strncmp(type_string.GetString(), "file", 4) == 0)
+        {
+            auto md = parse_file_meta_data(indices);
+
+            if (!parse_as_ints(md, cont, pool_))
+            {
+                throw std::runtime_error("Couldn't parse indices");
+            }
+        }
+    }
+    else
+    {
+        throw std::runtime_error("Indices object is invalid");
+    }
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // .vsnray writer
 //
@@ -1694,9 +1620,16 @@ class vsnray_writer
 {
 public:
 
-    vsnray_writer(rapidjson::Document& doc, std::string filename)
+    vsnray_writer(
+            rapidjson::Document&                doc,
+            std::string                         filename,
+            data_file::blocked::worker_pool&    pool,
+            data_file::meta_data::compression_t compression = data_file::meta_data::Raw
+            )
         : document_(doc)
         , filename_(filename)
+        , pool_(pool)
+        , compression_(compression)
     {
     }
 
@@ -1727,6 +1660,12 @@ private:
 
     std::string filename_;
 
+    // Encodes compressed data files
+    data_file::blocked::worker_pool& pool_;
+
+    // Compression used for binary data files
+    data_file::meta_data::compression_t compression_;
+
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -2096,8 +2035,139 @@ void vsnray_writer::write_triangle_mesh(Object obj, std::shared_ptr<sg::triangle
 }
 
 template <typename Object>
-void vsnray_writer::write_indexed_triangle_mesh(Object /*obj*/, std::shared_ptr<sg::indexed_triangle_mesh> const& /*itm*/)
+void vsnray_writer::write_indexed_triangle_mesh(Object obj, std::shared_ptr<sg::indexed_triangle_mesh> const& itm)
 {
+    auto& allocator = document_.GetAllocator();
+
+    // Write binary files
+
+    if (!itm->vertex_indices.empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "vind");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::I32;
+        md.num_items = itm->vertex_indices.size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, itm->vertex_indices);
+
+        obj.AddMember("vertex_indices", val, allocator);
+    }
+
+    if (!itm->normal_indices.empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "nind");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::I32;
+        md.num_items = itm->normal_indices.size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, itm->normal_indices);
+
+        obj.AddMember("normal_indices", val, allocator);
+    }
+
+    if (!itm->tex_coord_indices.empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "tind");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::I32;
+        md.num_items = itm->tex_coord_indices.size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, itm->tex_coord_indices);
+
+        obj.AddMember("tex_coord_indices", val, allocator);
+    }
+
+    if (!itm->color_indices.empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "cind");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::I32;
+        md.num_items = itm->color_indices.size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, itm->color_indices);
+
+        obj.AddMember("color_indices", val, allocator);
+    }
+
+    if (itm->vertices != nullptr && !itm->vertices->empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "vert");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::Vec3f;
+        md.num_items = itm->vertices->size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, *itm->vertices);
+
+        obj.AddMember("vertices", val, allocator);
+    }
+
+    if (itm->normals != nullptr && !itm->normals->empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "norm");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::Vec3f;
+        md.num_items = itm->normals->size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, *itm->normals);
+
+        obj.AddMember("normals", val, allocator);
+    }
+
+    if (itm->tex_coords != nullptr && !itm->tex_coords->empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "texc");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::Vec2f;
+        md.num_items = itm->tex_coords->size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, *itm->tex_coords);
+
+        obj.AddMember("tex_coords", val, allocator);
+    }
+
+    if (itm->colors != nullptr && !itm->colors->empty())
+    {
+        data_file::meta_data md;
+        md.path = make_inline_filename(itm->name(), "colo");
+        md.encoding = data_file::meta_data::Binary;
+        md.data_type = data_file::meta_data::Vec3u8;
+        md.num_items = itm->colors->size();
+
+        rapidjson::Value val;
+        val.SetObject();
+
+        write_data_file(val.GetObject(), md, *itm->colors);
+
+        obj.AddMember("colors", val, allocator);
+    }
 }
 
 template <typename Object, typename Container>
@@ -2124,10 +2194,28 @@ void vsnray_writer::write_data_file(Object obj, data_file::meta_data md, Contain
         throw std::runtime_error("Cannot open file");
     }
 
+    // Quantization is lossy and only defined for finite floating point data,
+    // fall back to lossless delta compression for other data
+    md.compression = compression_;
+
+    if (md.compression == data_file::meta_data::Quantized
+     && !data_file::blocked::can_quantize(md, reinterpret_cast<char const*>(cont.data())))
+    {
+        md.compression = data_file::meta_data::Delta;
+    }
+
     // Write data
     try
     {
-        file.write(reinterpret_cast<char const*>(cont.data()), cont.size() * sizeof(typename Container::value_type));
+        if (md.compression == data_file::meta_data::Raw)
+        {
+            file.write(reinterpret_cast<char const*>(cont.data()), cont.size() * sizeof(typename Container::value_type));
+        }
+        else
+        {
+            auto blocks = data_file::blocked::encode(md, reinterpret_cast<char const*>(cont.data()), pool_);
+            file.write(blocks.data(), blocks.size());
+        }
     }
     catch (std::ios_base::failure&)
     {
@@ -2189,11 +2277,26 @@ void vsnray_writer::write_data_file(Object obj, data_file::meta_data md, Contain
         num_items.SetInt(md.num_items);
         obj.AddMember("num_items", num_items, allocator);
 
+        auto& compression_map = data_file::meta_data::compression_map;
+
+        rapidjson::Value compression(compression_map.left.at(md.compression).c_str(), allocator);
         obj.AddMember(
             rapidjson::StringRef("compression"),
-            rapidjson::StringRef("none"),
+            compression,
             allocator
             );
+
+        // Uncompressed data is written in host byte order,
+        // compressed data streams are byte order independent
+        if (md.compression == data_file::meta_data::Raw)
+        {
+            bool little = data_file::meta_data::host_byte_order() == data_file::meta_data::LittleEndian;
+            obj.AddMember(
+                rapidjson::StringRef("byte_order"),
+                rapidjson::StringRef(little ? "little" : "big"),
+                allocator
+                );
+        }
     }
     else
     {
@@ -2276,8 +2379,32 @@ void load_vsnray(std::string const& filename, model& mod)
     load_vsnray(filenames, mod);
 }
 
-void save_vsnray(std::string const& filename, model const& mod, file_base::save_options const& /*options*/)
+void save_vsnray(std::string const& filename, model const& mod, file_base::save_options const& options)
 {
+    // Optional: compression of binary data files ("none", "delta", "quantized")
+    auto compression = data_file::meta_data::Raw;
+
+    auto it = std::find_if(
+            options.begin(),
+            options.end(),
+            [](file_base::save_option const& opt) { return opt.first == "compression"; }
+            );
+
+    if (it != options.end())
+    {
+        auto& compression_map = data_file::meta_data::compression_map;
+
+        auto cit = compression_map.right.find(boost::any_cast<std::string>(it->second));
+
+        if (cit == compression_map.right.end())
+        {
+            std::cerr << "Invalid compression kind\n";
+            return;
+        }
+
+        compression = cit->second;
+    }
+
     cfile file(filename, "w+");
     if (!file.good())
     {
@@ -2288,7 +2415,10 @@ void save_vsnray(std::string const& filename, model const& mod, file_base::save_
     rapidjson::Document doc;
     doc.SetObject();
 
-    vsnray_writer writer(doc, filename);
+    // One set of worker threads for all data files
+    data_file::blocked::worker_pool pool;
+
+    vsnray_writer writer(doc, filename, pool, compression);
     writer.write_node(doc.GetObject(), mod.scene_graph);
 
     char buffer[65536];
@@ -2302,6 +2432,9 @@ void load_vsnray(std::vector<std::string> const& filenames, model& mod)
 {
     auto root = std::make_shared<sg::node>();
 
+    // One set of worker threads for all data files
+    data_file::blocked::worker_pool pool;
+
     for (auto filename : filenames)
     {
         cfile file(filename, "r");
@@ -2318,7 +2451,7 @@ void load_vsnray(std::vector<std::string> const& filenames, model& mod)
 
         if (doc.IsObject())
         {
-            vsnray_parser parser(filename);
+            vsnray_parser parser(filename, pool);
             root = parser.parse_node(doc.GetObject());
         }
         else
@@ -0,0 +1,308 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <Support/CmdLine.h>
+#include <Support/CmdLineUtil.h>
+
+#include <visionaray/detail/platform.h>
+
+#include <visionaray/math/io.h>
+#include <visionaray/cpu_buffer_rt.h>
+#include <visionaray/pinhole_camera.h>
+
+#include <common/manip/arcball_manipulator.h>
+#include <common/manip/pan_manipulator.h>
+#include <common/manip/zoom_manipulator.h>
+
+#include <common/remote/render_client.h>
+#include <common/viewer_glut.h>
+
+using namespace visionaray;
+
+using viewer_type = viewer_glut;
+
+
+//-------------------------------------------------------------------------------------------------
+// Thin client for vsnray-batch -server=<port>
+//
+// Sends the camera whenever it changes and displays the most recent frame that
+// the server sent back
+//
+
+struct renderer : viewer_type
+{
+    using pixel_type = remote::render_client::pixel_type;
+
+    renderer()
+        : viewer_type(512, 512, "Visionaray Remote Viewer Example")
+    {
+        using namespace support;
+
+        add_cmdline_option( cl::makeOption<std::string&>(
+            cl::Parser<>(),
+            "host",
+            cl::Desc("Host running the render server"),
+            cl::ArgRequired,
+            cl::init(this->host)
+            ) );
+
+        add_cmdline_option( cl::makeOption<unsigned short&>(
+            cl::Parser<>(),
+            "port",
+            cl::Desc("Port the render server listens on"),
+            cl::ArgRequired,
+            cl::init(this->port)
+            ) );
+
+        add_cmdline_option( cl::makeOption<remote::frame_encoding&>({
+                { "raw",                remote::RawEncoding,    "Uncompressed frames" },
+                { "delta",              remote::DeltaEncoding,  "XOR delta to the previous frame, run length encoded" },
+                { "tile",               remote::TileEncoding,   "Only send 16x16 tiles that changed" }
+            },
+            "encoding",
+            cl::Desc("Frame encoding"),
+            cl::ArgRequired,
+            cl::init(this->encoding)
+            ) );
+
+        add_cmdline_option( cl::makeOption<std::string&>(
+            cl::Parser<>(),
+            "camera",
+            cl::Desc("Text file with camera parameters"),
+            cl::ArgRequired,
+            cl::init(this->initial_camera)
+            ) );
+    }
+
+    pinhole_camera                              cam;
+    cpu_buffer_rt<PF_RGBA8, PF_UNSPECIFIED>     host_rt;
+
+    std::string                                 host            = "localhost";
+    unsigned short                              port            = 31050;
+    remote::frame_encoding                      encoding        = remote::DeltaEncoding;
+    std::string                                 initial_camera;
+
+    remote::render_client                       client;
+
+    // Last camera sent to the server
+    mat4                                        view            = mat4::identity();
+    mat4                                        proj            = mat4::identity();
+    int                                         sent_width      = 0;
+    int                                         sent_height     = 0;
+
+    std::vector<pixel_type>                     pixels;
+
+    void print_stats();
+
+protected:
+
+    void on_display();
+    void on_key_press(visionaray::key_event const& event);
+    void on_resize(int w, int h);
+
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// I/O utility for camera lookat only - not fit for the general case!
+//
+
+std::istream& operator>>(std::istream& in, pinhole_camera& cam)
+{
+    vec3 eye;
+    vec3 center;
+    vec3 up;
+
+    in >> eye >> std::ws >> center >> std::ws >> up >> std::ws;
+    cam.look_at(eye, center, up);
+
+    return in;
+}
+
+std::ostream& operator<<(std::ostream& out, pinhole_camera const& cam)
+{
+    out << cam.eye() << '\n';
+    out << cam.center() << '\n';
+    out << cam.up() << '\n';
+    return out;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Print latency statistics
+//
+
+void renderer::print_stats()
+{
+    auto stats = client.stats();
+
+    std::cout << "Frames received: " << stats.frames_received
+              << ", " << stats.bytes_received / 1024 << " KB"
+              << ", errors: " << stats.errors << '\n';
+    std::cout << "Round trip:      " << stats.round_trip.average() * 1000.0 << " ms (avg), "
+              << stats.round_trip.max * 1000.0 << " ms (max)\n";
+    std::cout << "Server render:   " << stats.server_render.average() * 1000.0 << " ms (avg)\n";
+    std::cout << "Server encode:   " << stats.server_encode.average() * 1000.0 << " ms (avg)\n";
+    std::cout << "Client decode:   " << stats.decode.average() * 1000.0 << " ms (avg)\n";
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Display function, sends camera updates and displays the latest frame
+//
+
+void renderer::on_display()
+{
+    auto const& v = cam.get_view_matrix();
+    auto const& p = cam.get_proj_matrix();
+
+    if (v != view || p != proj || width() != sent_width || height() != sent_height)
+    {
+        view = v;
+        proj = p;
+        sent_width = width();
+        sent_height = height();
+
+        client.send_camera(view, proj, sent_width, sent_height, encoding);
+    }
+
+    int w = 0;
+    int h = 0;
+
+    if (client.latest_frame(pixels, w, h))
+    {
+        if (w != host_rt.width() || h != host_rt.height())
+        {
+            host_rt.resize(w, h);
+        }
+
+        std::memcpy(host_rt.color(), pixels.data(), pixels.size() * sizeof(pixel_type));
+    }
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    host_rt.display_color_buffer();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// keyboard handling
+//
+
+void renderer::on_key_press(key_event const& event)
+{
+    static const std::string camera_filename = "visionaray-camera.txt";
+
+    switch (event.key())
+    {
+    case 's':
+        print_stats();
+        break;
+
+    case 'u':
+        {
+            std::ofstream file( camera_filename );
+            if (file.good())
+            {
+                std::cout << "Storing camera to file: " << camera_filename << '\n';
+                file << cam;
+            }
+        }
+        break;
+
+    case 'v':
+        {
+            std::ifstream file( camera_filename );
+            if (file.good())
+            {
+                file >> cam;
+                std::cout << "Load camera from file: " << camera_filename << '\n';
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    viewer_type::on_key_press(event);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// resize event
+//
+
+void renderer::on_resize(int w, int h)
+{
+    cam.set_viewport(0, 0, w, h);
+    float aspect = w / static_cast<float>(h);
+    cam.perspective(45.0f * constants::degrees_to_radians<float>(), aspect, 0.001f, 1000.0f);
+
+    viewer_type::on_resize(w, h);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Main function, performs initialization
+//
+
+int main(int argc, char** argv)
+{
+    renderer rend;
+
+    try
+    {
+        rend.init(argc, argv);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Connecting to " << rend.host << ':' << rend.port << "...\n";
+
+    if (!rend.client.connect(rend.host, rend.port))
+    {
+        std::cerr << "Failed connecting to render server\n";
+        return EXIT_FAILURE;
+    }
+
+    float aspect = rend.width() / static_cast<float>(rend.height());
+
+    rend.cam.perspective(45.0f * constants::degrees_to_radians<float>(), aspect, 0.001f, 1000.0f);
+
+    // Load camera from file, the scene bounds are not known to the client
+    std::ifstream file(rend.initial_camera);
+    if (file.good())
+    {
+        file >> rend.cam;
+    }
+    else
+    {
+        rend.cam.view_all( aabb(vec3(-1.0f), vec3(1.0f)) );
+    }
+
+    rend.add_manipulator( std::make_shared<arcball_manipulator>(rend.cam, mouse::Left) );
+    rend.add_manipulator( std::make_shared<pan_manipulator>(rend.cam, mouse::Middle) );
+    // Additional "Alt + LMB" pan manipulator for setups w/o middle mouse button
+    rend.add_manipulator( std::make_shared<pan_manipulator>(rend.cam, mouse::Left, keyboard::Alt) );
+    rend.add_manipulator( std::make_shared<zoom_manipulator>(rend.cam, mouse::Right) );
+
+    rend.event_loop();
+
+    rend.print_stats();
+}
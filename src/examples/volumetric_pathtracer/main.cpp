@@ -14,6 +14,8 @@
 #include <visionaray/math/math.h>
 
 #include <visionaray/cpu_buffer_rt.h>
+#include <visionaray/macrocell_grid.h>
+#include <visionaray/participating_media.h>
 #include <visionaray/phase_function.h>
 #include <visionaray/pinhole_camera.h>
 #include <visionaray/random_generator.h>
@@ -70,6 +72,44 @@ struct volume
         }
     }
 
+    // Conservative range of sigma_t inside box, used to build the majorant grid
+    vec2 sigma_t_range(aabb const& box) const
+    {
+        if (Mode == 0) // spiral
+        {
+            return vec2(0.0f, sigma_());
+        }
+        else // menger sponge
+        {
+            // The box is empty if, on any subdivision level, it lies inside
+            // a single odd cell along at least two axes (cf. sigma_t())
+            vec3 lo = box.min + vec3(0.5f, 0.5f, 0.5f);
+            vec3 hi = box.max + vec3(0.5f, 0.5f, 0.5f);
+            const unsigned int steps = 3;
+            for (unsigned int i = 0; i < steps; ++i)
+            {
+                lo *= 3.0f;
+                hi *= 3.0f;
+
+                int s = 0;
+                for (int d = 0; d < 3; ++d)
+                {
+                    float cell = floorf(lo[d]);
+                    if (((int)cell & 1) && hi[d] <= cell + 1.0f)
+                    {
+                        ++s;
+                    }
+                }
+
+                if (s >= 2)
+                {
+                    return vec2(0.0f);
+                }
+            }
+            return vec2(0.0f, sigma_());
+        }
+    }
+
     float sigma_a(vec3 const& pos) const
     {
         // Model extinction as 1:1 absorption and out-scattering
@@ -105,84 +145,6 @@ struct volume
 };
 
 
-//-------------------------------------------------------------------------------------------------
-//
-//
-
-struct uniform_grid
-{
-    template <int Mode>
-    void build(::volume<Mode> const& vol, vec3i num_cells, aabb const& world_bounds)
-    {
-        dims = num_cells;
-        value_ranges.resize(dims.x * size_t(dims.y) * dims.z, { FLT_MAX, -FLT_MAX });
-        vec3 world_size = world_bounds.size();
-
-        // We try to use very fine sampling to make sure that
-        // our majorants are a relatively tight fit
-        vec3i sampling_rate(64);
-        vec3i sampling_dims = dims * sampling_rate;
-
-        auto linear_index = [this](int x, int y, int z)
-        {
-            return z * dims.x * size_t(dims.y) + y * dims.x + x;
-        };
-
-        auto to_world = [&](int x, int y, int z)
-        {
-            float fx = x / (float)(sampling_dims.x - 1);
-            float fy = y / (float)(sampling_dims.y - 1);
-            float fz = z / (float)(sampling_dims.z - 1);
-
-            fx *= world_size.x;
-            fy *= world_size.y;
-            fz *= world_size.z;
-
-            fx += world_bounds.min.x;
-            fy += world_bounds.min.y;
-            fz += world_bounds.min.z;
-
-            return vec3(fx, fy, fz);
-        };
-
-        for (int z = 0; z < dims.z; ++z)
-        {
-            for (int y = 0; y < dims.y; ++y)
-            {
-                for (int x = 0; x < dims.x; ++x)
-                {
-                    for (int zz = 0; zz < sampling_rate.z; ++zz)
-                    {
-                        for (int yy = 0; yy < sampling_rate.y; ++yy)
-                        {
-                            for (int xx = 0; xx < sampling_rate.x; ++xx)
-                            {
-                                vec3i cell(
-                                    x * sampling_rate.x + xx,
-                                    y * sampling_rate.y + yy,
-                                    z * sampling_rate.z + zz
-                                    );
-                                vec3 world_coord = to_world(cell.x, cell.y, cell.z);
-
-                                float extinction = vol.sigma_t(world_coord);
-
-                                size_t index = linear_index(cell.x, cell.y, cell.z);
-
-                                value_ranges[index].x = min(value_ranges[index].x, extinction);
-                                value_ranges[index].y = max(value_ranges[index].y, extinction);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    std::vector<vec2> value_ranges;
-    vec3i             dims;
-};
-
-
 //-------------------------------------------------------------------------------------------------
 //
 //
@@ -194,50 +156,59 @@ enum collision_type
     Boundary,
 };
 
-namespace delta_tracking
-{
-
 template <int Mode>
-collision_type sample_interaction(ray& r, ::volume<Mode> const& vol, vec3& Le, float& Tr,float d, random_generator<float>& gen)
+collision_type sample_interaction(
+        ray&                        r,
+        ::volume<Mode> const&       vol,
+        macrocell_grid const&       grid,
+        vec3&                       Le,
+        float                       d,
+        random_generator<float>&    gen
+        )
 {
-    collision_type result;
+    Le = vec3(0.0f);
 
-    float t = 0.0f;
-    vec3 pos;
+    ray segment = r;
+    segment.tmin = 0.0f;
+    segment.tmax = d;
 
-    Le = vec3(0.0f);
+    auto sigma_t = [&](vec3 const& pos) { return vol.sigma_t(pos); };
 
-    while (true)
+    // Free-flight sampling with the local majorants of the grid
+    float t = 0.0f;
+    if (!delta_tracking(segment, sigma_t, grid, gen, t))
     {
-        t -= log(1.0f - gen.next()) / vol.sigma_();
+        r.ori += r.dir * d;
+        return Boundary;
+    }
 
-        pos = r.ori + r.dir * t;
-        if (t >= d)
-        {
-            result = Boundary;
-            break;
-        }
+    r.ori += r.dir * t;
 
-        float u2 = gen.next();
-        if (u2 < vol.sigma_a(pos) / vol.sigma_t(pos))
-        {
-            Le = vol.Le(pos);
-            result = Emission;
-            break;
-        }
-        else if (vol.sigma_t(pos) >= u2 * vol.sigma_())
-        {
-            result = Scattering;
-            break;
-        }
+    if (gen.next() < vol.sigma_a(r.ori) / vol.sigma_t(r.ori))
+    {
+        Le = vol.Le(r.ori);
+        return Emission;
     }
 
-    Tr = result == Boundary ? 1.0f : 0.0f;
-    r.ori = pos;
-
-    return result;
+    return Scattering;
 }
 
+template <int Mode>
+float transmittance(
+        ray const&                  r,
+        ::volume<Mode> const&       vol,
+        macrocell_grid const&       grid,
+        float                       d,
+        random_generator<float>&    gen
+        )
+{
+    ray segment = r;
+    segment.tmin = 0.0f;
+    segment.tmax = d;
+
+    auto sigma_t = [&](vec3 const& pos) { return vol.sigma_t(pos); };
+
+    return ratio_tracking(segment, sigma_t, grid, gen);
 }
 
 
@@ -263,14 +234,18 @@ struct renderer : viewer_type
                 mouse::Left
                 ) );
 
-        grid.build(vol, {16,16,16}, bbox);
+        // Majorant grid for delta and ratio tracking. The volumes are
+        // discontinuous, so sampling them can't guarantee an upper bound
+        grid = macrocell_grid(vec3i(27), bbox);
+        grid.build_from_range_function([this](aabb const& box) { return vol.sigma_t_range(box); });
+        grid.compute_majorants([](vec2 const& range) { return range.y; });
     }
 
     aabb                                        bbox;
     pinhole_camera                              cam;
     cpu_buffer_rt<PF_RGBA8, PF_UNSPECIFIED, PF_RGBA32F> host_rt;
     tiled_sched<host_ray_type>                  host_sched;
-    uniform_grid                                grid;
+    macrocell_grid                              grid;
     frame_counter                               counter;
     double                                      last_frame_time = 0.0;
     bool                                        print_fps = true;
@@ -351,14 +326,13 @@ void renderer::on_display()
             while (true)
             {
                 vec3 Le;
-                float Tr;
 
                 float d = hit_rec.tfar;
                 auto sph_rec = intersect(r, sph);
                 if (sph_rec.hit)
                     d = min(d, sph_rec.t);
 
-                collision_type coll = delta_tracking::sample_interaction(r, vol, Le, Tr, d, gen);
+                collision_type coll = sample_interaction(r, vol, grid, Le, d, gen);
 
                 if (coll == Boundary)
                 {
@@ -405,16 +379,8 @@ void renderer::on_display()
 
                     if (front_facing_hemisphere)
                     {
-                        vec3 ignoreLe;
-                        collision_type shadow_coll = delta_tracking::sample_interaction(
-                                shadow_ray,
-                                vol,
-                                ignoreLe,
-                                Tr,
-                                d,
-                                gen
-                                );
-                        if (front_facing_hemisphere && shadow_coll == Boundary)
+                        float Tr = transmittance(shadow_ray, vol, grid, d, gen);
+                        if (Tr > 0.0f)
                         {
                             float u1 = gen.next();
                             float u2 = gen.next();
@@ -38,8 +38,8 @@ struct host_device_rt::impl
     // Framebuffer color space, either RGB or SRGB
     color_space_type color_space;
 
-    // Host render target
-    cpu_buffer_rt<PF_RGBA8, PF_UNSPECIFIED, PF_RGBA32F> host_rt[2];
+    // Host render target, with feature buffers for temporal accumulation
+    cpu_buffer_rt<PF_RGBA8, PF_UNSPECIFIED, PF_RGBA32F, PF_RGBA32F> host_rt[2];
 
 #if VSNRAY_HAVE_CUDA
     // Device render target, uses PBO
@@ -149,13 +149,16 @@ host_device_rt::ref_type host_device_rt::ref(buffer buf)
     else
     {
 #if VSNRAY_HAVE_CUDA
+        // Device render targets have no feature buffers
         if (impl_->direct_rendering)
         {
-            return impl_->direct_rt[impl_->buffer_index[buf]].ref();
+            auto ref = impl_->direct_rt[impl_->buffer_index[buf]].ref();
+            return { ref.color(), ref.depth(), ref.accum(), ref.width(), ref.height() };
         }
         else
         {
-            return impl_->indirect_rt[impl_->buffer_index[buf]].ref();
+            auto ref = impl_->indirect_rt[impl_->buffer_index[buf]].ref();
+            return { ref.color(), ref.depth(), ref.accum(), ref.width(), ref.height() };
         }
 #else
         assert(0);
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -50,8 +51,10 @@
 #include <visionaray/material.h>
 #include <visionaray/pinhole_camera.h>
 #include <visionaray/point_light.h>
+#include <visionaray/preview_controller.h>
 #include <visionaray/scheduler.h>
 #include <visionaray/spot_light.h>
+#include <visionaray/temporal_accumulator.h>
 #include <visionaray/thin_lens_camera.h>
 
 #if defined(__INTEL_COMPILER) || defined(__MINGW32__) || defined(__MINGW64__)
@@ -379,6 +382,22 @@ struct renderer : viewer_type
             cl::init(this->frames)
             ) );
 
+        add_cmdline_option( cl::makeOption<float&>(
+            cl::Parser<>(),
+            "preview",
+            cl::Desc("Frame time budget (ms) for low resolution preview during interaction (0: off)"),
+            cl::ArgRequired,
+            cl::init(this->preview_budget)
+            ) );
+
+        add_cmdline_option( cl::makeOption<bool&>(
+            cl::Parser<>(),
+            "temporal",
+            cl::Desc("Keep path tracer samples when the camera moves, reprojected to the new view (CPU only)"),
+            cl::ArgRequired,
+            cl::init(this->use_temporal)
+            ) );
+
         add_cmdline_option( cl::makeOption<vec3&, cl::ScalarType>(
             [&](StringRef name, StringRef /*arg*/, vec3& value)
             {
@@ -566,6 +585,22 @@ struct renderer : viewer_type
                     use_headlight = headlight;
                 }
 
+                // preview
+                float preview = preview_budget;
+                err = ini.get_float("preview", preview);
+                if (err == inifile::Ok)
+                {
+                    preview_budget = preview;
+                }
+
+                // temporal accumulation
+                bool temporal = use_temporal;
+                err = ini.get_bool("temporal", temporal);
+                if (err == inifile::Ok)
+                {
+                    use_temporal = temporal;
+                }
+
                 // ground plane
                 bool groundplane = use_groundplane;
                 err = ini.get_bool("groundplane", groundplane);
@@ -704,6 +739,15 @@ struct renderer : viewer_type
     // Number of path tracer convergece frames to be rendered (default: inf)
     unsigned                                    frames = unsigned(-1);
 
+    // Progressive preview while the camera moves, frame time budget in ms (0: off)
+    float                                       preview_budget = 0.0f;
+    preview_controller                          preview;
+    std::atomic<bool>                           camera_moved{false};
+
+    // Reproject accumulated path tracer samples when the camera moves
+    bool                                        use_temporal = false;
+    temporal_accumulator                        temporal;
+
     bool                                        render_async  = false;
     std::future<void>                           render_future;
     std::mutex                                  display_mutex;
@@ -728,6 +772,8 @@ private:
     void load_camera(std::string filename);
     void init_bvh_outlines();
     void clear_frame();
+    void camera_changed();
+    bool temporal_active() const;
     void screenshot();
     void render_hud();
     void render_impl();
@@ -1174,19 +1220,7 @@ struct build_scene_visitor : sg::node_visitor
             }
 
             // Build single bvh
-            if (build_strategy_ == renderer::LBVH)
-            {
-                lbvh_builder builder;
-
-                bvhs_.emplace_back(builder.build(renderer::host_bvh_type{}, ico.triangles.data(), ico.triangles.size()));
-            }
-            else
-            {
-                binned_sah_builder builder;
-                builder.enable_spatial_splits(build_strategy_ == renderer::Split);
-
-                bvhs_.emplace_back(builder.build(renderer::host_bvh_type{}, ico.triangles.data(), ico.triangles.size()));
-            }
+            build_bvh(ico.triangles.data(), ico.triangles.size());
 
             sph.flags() = ~(bvhs_.size() - 1);
         }
@@ -1242,19 +1276,7 @@ struct build_scene_visitor : sg::node_visitor
             }
 
             // Build single bvh
-            if (build_strategy_ == renderer::LBVH)
-            {
-                lbvh_builder builder;
-
-                bvhs_.emplace_back(builder.build(renderer::host_bvh_type{}, triangles.data(), triangles.size()));
-            }
-            else
-            {
-                binned_sah_builder builder;
-                builder.enable_spatial_splits(build_strategy_ == renderer::Split);
-
-                bvhs_.emplace_back(builder.build(renderer::host_bvh_type{}, triangles.data(), triangles.size()));
-            }
+            build_bvh(triangles.data(), triangles.size());
 
             tm.flags() = ~(bvhs_.size() - 1);
         }
@@ -1264,6 +1286,11 @@ struct build_scene_visitor : sg::node_visitor
         node_visitor::apply(tm);
     }
 
+    // TODO: build basic_indexed_triangle over *itm.vertices instead of
+    // de-indexing the positions. This requires bottom-level BVHs of more
+    // than one primitive type (host_bvh_type is shared by all instances,
+    // area lights and the CUDA path). Normals, texture coordinates and
+    // colors would still be de-indexed (they are looked up by prim_id).
     void apply(sg::indexed_triangle_mesh& itm)
     {
         if (itm.flags() == 0 && itm.vertex_indices.size() > 0)
@@ -1350,19 +1377,7 @@ struct build_scene_visitor : sg::node_visitor
 
 
             // Build single bvh
-            if (build_strategy_ == renderer::LBVH)
-            {
-                lbvh_builder builder;
-
-                bvhs_.emplace_back(builder.build(renderer::host_bvh_type{}, triangles.data(), triangles.size()));
-            }
-            else
-            {
-                binned_sah_builder builder;
-                builder.enable_spatial_splits(build_strategy_ == renderer::Split);
-
-                bvhs_.emplace_back(builder.build(renderer::host_bvh_type{}, triangles.data(), triangles.size()));
-            }
+            build_bvh(triangles.data(), triangles.size());
 
             itm.flags() = ~(bvhs_.size() - 1);
         }
@@ -1372,6 +1387,21 @@ struct build_scene_visitor : sg::node_visitor
         node_visitor::apply(itm);
     }
 
+    template <typename P>
+    void build_bvh(P* primitives, size_t num_prims)
+    {
+        if (build_strategy_ == renderer::LBVH)
+        {
+            bvhs_.emplace_back(lbvh_builder_.build(renderer::host_bvh_type{}, primitives, num_prims));
+        }
+        else
+        {
+            sah_builder_.enable_spatial_splits(build_strategy_ == renderer::Split);
+
+            bvhs_.emplace_back(sah_builder_.build(renderer::host_bvh_type{}, primitives, num_prims));
+        }
+    }
+
     // List of surface properties to derive geom_ids from
     std::vector<std::pair<std::shared_ptr<sg::material>, std::shared_ptr<sg::texture>>> surfaces;
 
@@ -1426,6 +1456,11 @@ struct build_scene_visitor : sg::node_visitor
     // BVH build strategy
     renderer::bvh_build_strategy build_strategy_;
 
+    // Builders are shared by all meshes, so that their temporary
+    // buffers are only allocated once
+    lbvh_builder lbvh_builder_;
+    binned_sah_builder sah_builder_;
+
 };
 
 
@@ -1727,6 +1762,7 @@ void renderer::clear_frame()
     }
 
     frame_num = 0;
+    temporal.reset();
 
     if (algo == Pathtracing)
     {
@@ -1735,6 +1771,33 @@ void renderer::clear_frame()
 }
 
 
+//-------------------------------------------------------------------------------------------------
+// Camera was moved, clear frame unless the samples are reprojected
+//
+
+void renderer::camera_changed()
+{
+    if (temporal_active())
+    {
+        if (render_future.valid() && render_async)
+        {
+            render_future.wait();
+        }
+    }
+    else
+    {
+        clear_frame();
+    }
+
+    camera_moved = true;
+}
+
+bool renderer::temporal_active() const
+{
+    return use_temporal && algo == Pathtracing && rt.mode() == host_device_rt::CPU;
+}
+
+
 //-------------------------------------------------------------------------------------------------
 // Take a screenshot
 //
@@ -2344,6 +2407,34 @@ void renderer::render_impl()
         camx.set_lens_radius(0.0f);
     }
 
+    // Render a single frame, the temporal accumulator blends it with the
+    // reprojected history below
+    bool use_temporal_accum = temporal_active();
+    unsigned accum_frames = frame_num;
+    if (use_temporal_accum)
+    {
+        frame_num = 0;
+    }
+
+    // Reduce resolution while the camera moves, refine when it stops
+    // (not with temporal accumulation, the history would be low resolution)
+    bool use_preview = preview_budget > 0.0f && rt.mode() == host_device_rt::CPU && !use_temporal_accum;
+    int preview_factor = 1;
+    if (use_preview)
+    {
+        preview.set_frame_budget(preview_budget / 1000.0);
+        preview_factor = preview.begin_frame(camera_moved.exchange(false));
+    }
+
+    if (preview_factor == 1 && host_sched.preview_factor() > 1)
+    {
+        // Restart accumulation at full resolution
+        frame_num = 0;
+    }
+
+    host_sched.set_preview_factor(preview_factor);
+    timer preview_timer;
+
     if (rt.mode() == host_device_rt::CPU)
     {
         if (host_top_level_bvh.num_primitives() > 0)
@@ -2553,6 +2644,26 @@ void renderer::render_impl()
     }
 #endif
 
+    if (use_temporal_accum)
+    {
+        auto ref = rt.ref();
+        temporal.accumulate(
+                pixel_format_constant<PF_RGBA8>{},
+                ref.color(),
+                ref.accum(),
+                ref.normal_depth(),
+                ref.width(),
+                ref.height(),
+                camx
+                );
+        frame_num = accum_frames + 1;
+    }
+
+    if (use_preview)
+    {
+        preview.end_frame(preview_timer.elapsed());
+    }
+
     last_frame_time = counter.register_frame();
 
 #if VSNRAY_COMMON_HAVE_PTEX
@@ -2846,14 +2957,24 @@ void renderer::on_key_press(key_event const& event)
         break;
     }
 
+    // Manipulators (e.g. first person) may move the camera on key press
+    vec3 eye = cam.eye();
+    vec3 center = cam.center();
+    vec3 up = cam.up();
+
     viewer_type::on_key_press(event);
+
+    if (cam.eye() != eye || cam.center() != center || cam.up() != up)
+    {
+        camera_changed();
+    }
 }
 
 void renderer::on_mouse_move(visionaray::mouse_event const& event)
 {
     if (event.buttons() != mouse::NoButton)
     {
-        clear_frame();
+        camera_changed();
     }
 
     mouse_pos = event.pos();
@@ -2862,7 +2983,7 @@ void renderer::on_mouse_move(visionaray::mouse_event const& event)
 
 void renderer::on_space_mouse_move(visionaray::space_mouse_event const& event)
 {
-    clear_frame();
+    camera_changed();
 
     viewer_type::on_space_mouse_move(event);
 }
@@ -0,0 +1,195 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <visionaray/math/simd/intrinsics.h>
+
+#if VSNRAY_BASE_ARCH == VSNRAY_BASE_ARCH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include <visionaray/cpu_features.h>
+
+namespace visionaray
+{
+
+#if VSNRAY_BASE_ARCH == VSNRAY_BASE_ARCH_X86
+
+//-------------------------------------------------------------------------------------------------
+// CPUID and XGETBV wrappers
+//
+
+struct cpuid_regs
+{
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+};
+
+static cpuid_regs cpuid(unsigned leaf, unsigned subleaf = 0)
+{
+    cpuid_regs result;
+
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    result.eax = static_cast<unsigned>(regs[0]);
+    result.ebx = static_cast<unsigned>(regs[1]);
+    result.ecx = static_cast<unsigned>(regs[2]);
+    result.edx = static_cast<unsigned>(regs[3]);
+#else
+    if (leaf > __get_cpuid_max(leaf & 0x80000000, nullptr))
+    {
+        return result;
+    }
+
+    __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+
+    return result;
+}
+
+// Register state enabled by the OS (XCR0), only valid if OSXSAVE is set
+static unsigned long long xgetbv()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax = 0;
+    unsigned edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+static int detect_simd_isa()
+{
+    auto leaf1 = cpuid(1);
+
+    bool sse     = (leaf1.edx & (1u << 25)) != 0;
+    bool sse2    = (leaf1.edx & (1u << 26)) != 0;
+    bool sse3    = (leaf1.ecx & (1u <<  0)) != 0;
+    bool ssse3   = (leaf1.ecx & (1u <<  9)) != 0;
+    bool sse4_1  = (leaf1.ecx & (1u << 19)) != 0;
+    bool sse4_2  = (leaf1.ecx & (1u << 20)) != 0;
+    bool osxsave = (leaf1.ecx & (1u << 27)) != 0;
+    bool avx     = (leaf1.ecx & (1u << 28)) != 0;
+
+    // XMM and YMM state (bits 1,2), opmask and ZMM state (bits 5,6,7)
+    unsigned long long xcr0 = osxsave ? xgetbv() : 0;
+    bool os_avx    = (xcr0 & 0x06) == 0x06;
+    bool os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+    auto leaf7 = cpuid(7);
+
+    bool avx2    = (leaf7.ebx & (1u <<  5)) != 0;
+    bool avx512f = (leaf7.ebx & (1u << 16)) != 0;
+
+    if (!sse)
+    {
+        return 0;
+    }
+
+    if (!sse2)
+    {
+        return VSNRAY_SIMD_ISA_SSE;
+    }
+
+    if (!sse3)
+    {
+        return VSNRAY_SIMD_ISA_SSE2;
+    }
+
+    if (!ssse3)
+    {
+        return VSNRAY_SIMD_ISA_SSE3;
+    }
+
+    if (!sse4_1)
+    {
+        return VSNRAY_SIMD_ISA_SSSE3;
+    }
+
+    if (!sse4_2)
+    {
+        return VSNRAY_SIMD_ISA_SSE4_1;
+    }
+
+    if (!avx || !os_avx)
+    {
+        return VSNRAY_SIMD_ISA_SSE4_2;
+    }
+
+    if (!avx2)
+    {
+        return VSNRAY_SIMD_ISA_AVX;
+    }
+
+    if (!avx512f || !os_avx512)
+    {
+        return VSNRAY_SIMD_ISA_AVX2;
+    }
+
+    return VSNRAY_SIMD_ISA_AVX512F;
+}
+
+#else
+
+static int detect_simd_isa()
+{
+    // No runtime detection on other architectures, report
+    // what the library was compiled for
+    return VSNRAY_SIMD_ISA_;
+}
+
+#endif
+
+
+//-------------------------------------------------------------------------------------------------
+// Public interface
+//
+
+int host_simd_isa()
+{
+    static const int isa = detect_simd_isa();
+    return isa;
+}
+
+bool host_supports_simd_isa(int isa)
+{
+    if (isa == 0)
+    {
+        return true;
+    }
+
+    // Instruction sets of the same base arch are ordered by inclusion
+    int host = host_simd_isa();
+    return isa - VSNRAY_BASE_ARCH >= 0 && isa - VSNRAY_BASE_ARCH < 1000 && isa <= host;
+}
+
+char const* simd_isa_name(int isa)
+{
+    switch (isa)
+    {
+    case 0:                         return "none";
+    case VSNRAY_SIMD_ISA_SSE:       return "SSE";
+    case VSNRAY_SIMD_ISA_SSE2:      return "SSE2";
+    case VSNRAY_SIMD_ISA_SSE3:      return "SSE3";
+    case VSNRAY_SIMD_ISA_SSSE3:     return "SSSE3";
+    case VSNRAY_SIMD_ISA_SSE4_1:    return "SSE4.1";
+    case VSNRAY_SIMD_ISA_SSE4_2:    return "SSE4.2";
+    case VSNRAY_SIMD_ISA_AVX:       return "AVX";
+    case VSNRAY_SIMD_ISA_AVX2:      return "AVX2";
+    case VSNRAY_SIMD_ISA_AVX512F:   return "AVX-512F";
+    case VSNRAY_SIMD_ISA_NEON:      return "NEON";
+    case VSNRAY_SIMD_ISA_NEON_FP:   return "NEON (FP)";
+    default:                        return "unknown";
+    }
+}
+
+} // visionaray
@@ -0,0 +1,304 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include <visionaray/profiling.h>
+
+namespace visionaray
+{
+namespace profiling
+{
+
+//-------------------------------------------------------------------------------------------------
+// Per-thread ring buffers
+//
+
+struct thread_buffer
+{
+    unsigned thread;
+
+    std::vector<event> events;
+
+    // Number of events recorded so far, events[count % events.size()] is written next
+    std::atomic<uint64_t> count;
+};
+
+struct timeline
+{
+    using clock = std::chrono::steady_clock;
+
+    std::mutex mutex;
+
+    std::vector<std::shared_ptr<thread_buffer>> buffers;
+
+    std::atomic<bool> enabled;
+
+    size_t capacity = 65536;
+
+    unsigned num_threads = 0;
+
+    clock::time_point start;
+
+    timeline()
+        : enabled(false)
+        , start(clock::now())
+    {
+    }
+};
+
+static timeline& get_timeline()
+{
+    static timeline tl;
+    return tl;
+}
+
+// The buffer is shared with the timeline, so that the events of a thread
+// remain available after it has exited
+static thread_buffer& get_thread_buffer()
+{
+    static thread_local std::shared_ptr<thread_buffer> buffer = nullptr;
+
+    if (buffer == nullptr)
+    {
+        auto& tl = get_timeline();
+
+        std::unique_lock<std::mutex> l(tl.mutex);
+
+        buffer = std::make_shared<thread_buffer>();
+        buffer->thread = tl.num_threads++;
+        buffer->events.resize(tl.capacity);
+        buffer->count = 0;
+
+        tl.buffers.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+// Escape a string for JSON
+static void write_string(std::ostream& out, char const* str)
+{
+    out << '"';
+
+    for (char const* c = str; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            out << '\\' << *c;
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+        {
+            out << ' ';
+        }
+        else
+        {
+            out << *c;
+        }
+    }
+
+    out << '"';
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// API
+//
+
+void enable(bool enable)
+{
+    get_timeline().enabled = enable;
+}
+
+bool enabled()
+{
+    return get_timeline().enabled.load(std::memory_order_relaxed);
+}
+
+void set_capacity(size_t events_per_thread)
+{
+    auto& tl = get_timeline();
+
+    std::unique_lock<std::mutex> l(tl.mutex);
+
+    tl.capacity = events_per_thread;
+
+    for (auto& b : tl.buffers)
+    {
+        b->events.clear();
+        b->events.resize(events_per_thread);
+        b->count = 0;
+    }
+}
+
+size_t capacity()
+{
+    auto& tl = get_timeline();
+
+    std::unique_lock<std::mutex> l(tl.mutex);
+
+    return tl.capacity;
+}
+
+void clear()
+{
+    auto& tl = get_timeline();
+
+    std::unique_lock<std::mutex> l(tl.mutex);
+
+    // Drop the buffers of threads that have exited
+    tl.buffers.erase(
+            std::remove_if(
+                tl.buffers.begin(),
+                tl.buffers.end(),
+                [](std::shared_ptr<thread_buffer> const& b) { return b.use_count() == 1; }
+                ),
+            tl.buffers.end()
+            );
+
+    for (auto& b : tl.buffers)
+    {
+        b->count = 0;
+    }
+}
+
+uint64_t now()
+{
+    auto d = timeline::clock::now() - get_timeline().start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+void record(char const* name, uint64_t begin, uint64_t end, int64_t id)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    auto& b = get_thread_buffer();
+
+    if (b.events.empty())
+    {
+        return;
+    }
+
+    uint64_t n = b.count.load(std::memory_order_relaxed);
+
+    event& e = b.events[n % b.events.size()];
+    e.name = name;
+    e.id = id;
+    e.begin = begin;
+    e.end = end;
+    e.thread = b.thread;
+
+    b.count.store(n + 1, std::memory_order_release);
+}
+
+std::vector<event> events()
+{
+    auto& tl = get_timeline();
+
+    std::vector<event> result;
+
+    {
+        std::unique_lock<std::mutex> l(tl.mutex);
+
+        for (auto const& b : tl.buffers)
+        {
+            uint64_t n = b->count.load(std::memory_order_acquire);
+            uint64_t cap = b->events.size();
+            uint64_t first = n > cap ? n - cap : 0;
+
+            for (uint64_t i = first; i < n; ++i)
+            {
+                result.push_back(b->events[i % cap]);
+            }
+        }
+    }
+
+    std::stable_sort(
+            result.begin(),
+            result.end(),
+            [](event const& a, event const& b) { return a.begin < b.begin; }
+            );
+
+    return result;
+}
+
+void write_chrome_trace(std::ostream& out)
+{
+    auto evts = events();
+
+    std::set<unsigned> threads;
+
+    for (auto const& e : evts)
+    {
+        threads.insert(e.thread);
+    }
+
+    // Timestamps are in microseconds
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+
+    for (unsigned t : threads)
+    {
+        out << (first ? "\n" : ",\n");
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << t
+            << ",\"args\":{\"name\":\"thread " << t << "\"}}";
+        first = false;
+    }
+
+    for (auto const& e : evts)
+    {
+        out << (first ? "\n" : ",\n");
+        out << "{\"name\":";
+        write_string(out, e.name);
+        out << ",\"cat\":\"visionaray\",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.thread
+            << ",\"ts\":" << e.begin / 1000.0
+            << ",\"dur\":" << (e.end >= e.begin ? e.end - e.begin : 0) / 1000.0;
+
+        if (e.id >= 0)
+        {
+            out << ",\"args\":{\"id\":" << e.id << '}';
+        }
+
+        out << '}';
+        first = false;
+    }
+
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool write_chrome_trace(std::string const& filename)
+{
+    std::ofstream out(filename);
+
+    if (!out.good())
+    {
+        return false;
+    }
+
+    write_chrome_trace(out);
+
+    return out.good();
+}
+
+} // profiling
+} // visionaray
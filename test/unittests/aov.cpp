@@ -0,0 +1,327 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+
+#include <visionaray/math/simd/simd.h>
+#include <visionaray/math/math.h>
+#include <visionaray/aov_buffer_rt.h>
+#include <visionaray/kernels.h>
+#include <visionaray/material.h>
+#include <visionaray/pinhole_camera.h>
+#include <visionaray/point_light.h>
+#include <visionaray/result_record.h>
+#include <visionaray/scheduler.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+using render_target_t = aov_buffer_rt<
+        PF_RGBA8,
+        PF_UNSPECIFIED,
+        PF_UNSPECIFIED,
+        aov_channel<aov::normal, PF_RGB16F>,
+        aov_channel<aov::depth, PF_R32F>,
+        aov_channel<aov::prim_id, PF_R32I>,
+        aov_channel<aov::geom_id, PF_R32I>,
+        aov_channel<aov::motion, PF_RG32F>
+        >;
+
+// Kernel that intersects a unit sphere at the origin
+template <typename S>
+struct kernel
+{
+    result_record<S> operator()(basic_ray<S> const& r) const
+    {
+        basic_sphere<float> sphere(vec3(0.0f), 1.0f);
+        sphere.prim_id = 7;
+        sphere.geom_id = 3;
+
+        auto hr = intersect(r, sphere);
+
+        result_record<S> result;
+        result.hit = hr.hit;
+        result.color = vector<4, S>(1.0f);
+        result.depth = hr.t;
+        result.normal = normalize(r.ori + r.dir * hr.t);
+        result.prim_id = hr.prim_id;
+        result.geom_id = hr.geom_id;
+        return result;
+    }
+};
+
+static pinhole_camera make_camera(vec3 eye, int width, int height)
+{
+    pinhole_camera cam;
+    cam.perspective(45.0f * constants::degrees_to_radians<float>(), width / static_cast<float>(height), 0.1f, 100.0f);
+    cam.set_viewport(0, 0, width, height);
+    cam.look_at(eye, eye - vec3(0.0f, 0.0f, 1.0f), vec3(0.0f, 1.0f, 0.0f));
+    return cam;
+}
+
+template <typename Sched>
+static void test_aovs(Sched& sched)
+{
+    using S = typename Sched::ray_type::scalar_type;
+
+    int width = 33;
+    int height = 27;
+
+    render_target_t rt;
+    rt.resize(width, height);
+    rt.clear_aovs();
+
+    EXPECT_EQ(rt.aov<aov::prim_id>()[0], -1);
+    EXPECT_EQ(rt.aov<aov::geom_id>()[0], -1);
+
+
+    // Frame 0: no motion
+
+    auto cam0 = make_camera(vec3(0.0f, 0.0f, 5.0f), width, height);
+    rt.set_camera_transform(cam0.get_proj_matrix() * cam0.get_view_matrix());
+
+    auto sparams0 = make_sched_params(cam0, rt);
+    sched.frame(kernel<S>{}, sparams0);
+
+    int center = (height / 2) * width + width / 2;
+    int corner = 0;
+
+    vector<3, half> n = rt.aov<aov::normal>()[center];
+    EXPECT_NEAR(static_cast<float>(n.x), 0.0f, 1e-2f);
+    EXPECT_NEAR(static_cast<float>(n.y), 0.0f, 1e-2f);
+    EXPECT_NEAR(static_cast<float>(n.z), 1.0f, 1e-3f);
+    EXPECT_NEAR(rt.aov<aov::depth>()[center], 4.0f, 1e-2f);
+    EXPECT_EQ(rt.aov<aov::prim_id>()[center], 7);
+    EXPECT_EQ(rt.aov<aov::geom_id>()[center], 3);
+    EXPECT_FLOAT_EQ(rt.aov<aov::motion>()[center].x, 0.0f);
+
+    n = rt.aov<aov::normal>()[corner];
+    EXPECT_EQ(static_cast<float>(n.z), 0.0f);
+    EXPECT_FLOAT_EQ(rt.aov<aov::depth>()[corner], 0.0f);
+    EXPECT_EQ(rt.aov<aov::prim_id>()[corner], -1);
+    EXPECT_EQ(rt.aov<aov::geom_id>()[corner], -1);
+
+    // All pixels were written, including the ones outside the last packet
+    int hits = 0;
+    for (int i = 0; i < width * height; ++i)
+    {
+        hits += rt.aov<aov::prim_id>()[i] == 7;
+    }
+    EXPECT_GT(hits, 0);
+    EXPECT_LT(hits, width * height);
+
+
+    // Frame 1: camera moved to the right, the sphere moves to the left,
+    // the background (points at infinity) does not move
+
+    auto cam1 = make_camera(vec3(0.5f, 0.0f, 5.0f), width, height);
+    rt.set_camera_transform(cam1.get_proj_matrix() * cam1.get_view_matrix());
+
+    auto sparams1 = make_sched_params(cam1, rt);
+    sched.frame(kernel<S>{}, sparams1);
+
+    EXPECT_GT(rt.aov<aov::motion>()[center].x, 0.5f);
+    EXPECT_NEAR(rt.aov<aov::motion>()[center].y, 0.0f, 1e-3f);
+    EXPECT_NEAR(rt.aov<aov::motion>()[corner].x, 0.0f, 1e-3f);
+    EXPECT_NEAR(rt.aov<aov::motion>()[corner].y, 0.0f, 1e-3f);
+}
+
+template <typename R>
+struct tiled_sched_test : tiled_sched<R>
+{
+    using ray_type = R;
+    using tiled_sched<R>::tiled_sched;
+};
+
+template <typename R>
+struct simple_sched_test : simple_sched<R>
+{
+    using ray_type = R;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Test AOV render targets
+//
+
+TEST(AOV, SimpleSched)
+{
+    simple_sched_test<basic_ray<float>> sched;
+    test_aovs(sched);
+}
+
+TEST(AOV, TiledSchedSIMD)
+{
+    tiled_sched_test<basic_ray<simd::float4>> sched(2);
+    test_aovs(sched);
+}
+
+TEST(AOV, RenderTargetRef)
+{
+    render_target_t rt;
+    rt.resize(16, 16);
+
+    auto ref = rt.ref();
+    EXPECT_EQ(ref.num_aovs, 5U);
+    EXPECT_EQ(ref.aov<aov::prim_id>(), rt.aov<aov::prim_id>());
+    EXPECT_EQ(ref.aov<aov::motion>(), rt.aov<aov::motion>());
+    EXPECT_EQ(ref.camera_transform_, nullptr);
+
+    EXPECT_EQ((render_target_ref<PF_RGBA8, PF_UNSPECIFIED>::num_aovs), 0U);
+}
+
+TEST(AOV, KernelAlbedo)
+{
+    using albedo_rt_t = aov_buffer_rt<PF_RGBA8, PF_UNSPECIFIED, PF_UNSPECIFIED, aov_channel<aov::albedo, PF_RGB32F>>;
+
+    int width = 16;
+    int height = 16;
+
+    basic_sphere<float> sphere(vec3(0.0f), 1.0f);
+    sphere.prim_id = 0;
+    sphere.geom_id = 0;
+
+    plastic<float> mat;
+    mat.ca() = from_rgb(0.0f, 0.0f, 0.0f);
+    mat.cd() = from_rgb(0.8f, 0.4f, 0.2f);
+    mat.cs() = from_rgb(0.0f, 0.0f, 0.0f);
+    mat.ka() = 0.0f;
+    mat.kd() = 0.5f;
+    mat.ks() = 0.0f;
+    mat.specular_exp() = 1.0f;
+
+    point_light<float> const* no_lights = nullptr;
+
+    auto kparams = make_kernel_params(&sphere, &sphere + 1, &mat, no_lights, no_lights, 2, 1e-4f);
+
+    auto cam = make_camera(vec3(0.0f, 0.0f, 5.0f), width, height);
+
+    int center = (height / 2) * width + width / 2;
+
+    auto test = [&](albedo_rt_t const& rt)
+    {
+        vec3 albedo = rt.aov<aov::albedo>()[center];
+        EXPECT_NEAR(albedo.x, 0.4f, 1e-4f);
+        EXPECT_NEAR(albedo.y, 0.2f, 1e-4f);
+        EXPECT_NEAR(albedo.z, 0.1f, 1e-4f);
+
+        // Background, same convention as the feature buffers
+        EXPECT_EQ(rt.aov<aov::albedo>()[0], vec3(1.0f));
+    };
+
+    albedo_rt_t rt;
+    rt.resize(width, height);
+
+    simple_sched_test<basic_ray<float>> sched;
+
+    rt.clear_aovs();
+    sched.frame(simple::kernel<decltype(kparams)>{ kparams }, make_sched_params(cam, rt));
+    test(rt);
+
+    rt.clear_aovs();
+    sched.frame(whitted::kernel<decltype(kparams)>{ kparams }, make_sched_params(cam, rt));
+    test(rt);
+
+    tiled_sched_test<basic_ray<simd::float4>> simd_sched(2);
+
+    rt.clear_aovs();
+    simd_sched.frame(simple::kernel<decltype(kparams)>{ kparams }, make_sched_params(cam, rt));
+    test(rt);
+
+    rt.clear_aovs();
+    simd_sched.frame(whitted::kernel<decltype(kparams)>{ kparams }, make_sched_params(cam, rt));
+    test(rt);
+}
+
+TEST(AOV, Blend)
+{
+    // Blend samplers blend the AOVs like the colors, ids are overwritten
+    using blend_rt_t = aov_buffer_rt<
+            PF_RGBA32F,
+            PF_UNSPECIFIED,
+            PF_RGBA32F,
+            aov_channel<aov::normal, PF_RGB16F>,
+            aov_channel<aov::depth, PF_R32F>,
+            aov_channel<aov::prim_id, PF_R32I>
+            >;
+
+    int width = 33;
+    int height = 27;
+
+    blend_rt_t rt;
+    rt.resize(width, height);
+    rt.clear_accum_buffer();
+    rt.clear_aovs();
+
+    int center = (height / 2) * width + width / 2;
+
+    pixel_sampler::jittered_blend_type blend_params;
+    blend_params.spp = 1;
+
+    tiled_sched_test<basic_ray<simd::float4>> sched(2);
+
+
+    // Frame 0: replace
+
+    blend_params.sfactor = 1.0f;
+    blend_params.dfactor = 0.0f;
+
+    auto cam0 = make_camera(vec3(0.0f, 0.0f, 5.0f), width, height);
+    sched.frame(kernel<simd::float4>{}, make_sched_params(blend_params, cam0, rt));
+
+    EXPECT_NEAR(rt.aov<aov::depth>()[center], 4.0f, 1e-2f);
+    EXPECT_EQ(rt.aov<aov::prim_id>()[center], 7);
+
+
+    // Frame 1: average w/ a closer view
+
+    blend_params.sfactor = 0.5f;
+    blend_params.dfactor = 0.5f;
+
+    auto cam1 = make_camera(vec3(0.0f, 0.0f, 3.0f), width, height);
+    sched.frame(kernel<simd::float4>{}, make_sched_params(blend_params, cam1, rt));
+
+    vector<3, half> n = rt.aov<aov::normal>()[center];
+    EXPECT_NEAR(static_cast<float>(n.z), 1.0f, 1e-3f);
+    EXPECT_NEAR(rt.aov<aov::depth>()[center], 3.0f, 1e-2f);
+    EXPECT_EQ(rt.aov<aov::prim_id>()[center], 7);
+    EXPECT_EQ(rt.aov<aov::prim_id>()[0], -1);
+    EXPECT_FLOAT_EQ(rt.aov<aov::depth>()[0], 0.0f);
+}
+
+TEST(AOV, HalfStore)
+{
+    // 2x2 SIMD packet stored to a 3x2 half float buffer, partially outside
+    vector<3, half> buffer[6];
+    std::fill(buffer, buffer + 6, vector<3, half>(half(-7.0f)));
+
+    simd::float4 x(1.0f, 2.0f, 3.0f, 4.0f);
+    vector<3, simd::float4> v(x, x * 2.0f, x * -1.0f);
+
+    detail::pixel_access::store(
+            pixel_format_constant<PF_RGB16F>{},
+            pixel_format_constant<PF_RGB32F>{},
+            1,
+            0,
+            3,
+            2,
+            v,
+            buffer
+            );
+
+    int lanes[] = { -1, 0, 1, -1, 2, 3 };
+
+    for (int i = 0; i < 6; ++i)
+    {
+        float expected = lanes[i] < 0 ? -7.0f : lanes[i] + 1.0f;
+        float scale = lanes[i] < 0 ? 1.0f : 2.0f;
+        EXPECT_FLOAT_EQ(static_cast<float>(buffer[i].x), expected);
+        EXPECT_FLOAT_EQ(static_cast<float>(buffer[i].y), lanes[i] < 0 ? -7.0f : expected * scale);
+    }
+}
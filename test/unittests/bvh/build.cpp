@@ -1,6 +1,8 @@
 // This file is distributed under the MIT license.
 // See the LICENSE file for details.
 
+#include <thread>
+
 #include <visionaray/aligned_vector.h>
 #include <visionaray/array_ref.h>
 #include <visionaray/bvh.h>
@@ -120,3 +122,141 @@ TEST(BVH, BuildArrayRefBvh)
     EXPECT_TRUE(triangle_bvh.primitives().size() == triangles.size());
     EXPECT_TRUE(sphere_bvh.primitives().size()   == spheres.size());
 }
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that reused builders and rebuild() produce the same trees as fresh builders
+//
+
+template <typename Tree>
+static bool equal_trees(Tree const& a, Tree const& b)
+{
+    if (a.num_nodes() != b.num_nodes() || a.num_primitives() != b.num_primitives())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.num_nodes(); ++i)
+    {
+        auto const& na = a.node(i);
+        auto const& nb = b.node(i);
+
+        if (na.is_leaf() != nb.is_leaf() || na.get_bounds().min != nb.get_bounds().min
+         || na.get_bounds().max != nb.get_bounds().max)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename Builder>
+static void test_rebuild(Builder& builder)
+{
+    aligned_vector<triangle_t, 32> triangles;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        vec3 v(static_cast<float>(i % 10), static_cast<float>((i / 10) % 10), static_cast<float>(i / 100));
+        triangles.emplace_back(v, vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    Builder fresh;
+    auto ref_index = fresh.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+    auto ref_bvh   = fresh.build(bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    // Reused builder: build a small tree in between
+    auto spheres = make_spheres();
+    builder.build(index_bvh<sphere_t>{}, spheres.data(), spheres.size());
+
+    auto index_tree = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+    auto tree       = builder.build(bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    EXPECT_TRUE(equal_trees(index_tree, ref_index));
+    EXPECT_TRUE(index_tree.indices() == ref_index.indices());
+    EXPECT_TRUE(equal_trees(tree, ref_bvh));
+
+    // Rebuild in place, the memory is reused
+    auto nodes_ptr = index_tree.nodes().data();
+    auto indices_ptr = index_tree.indices().data();
+
+    builder.rebuild(index_tree, triangles.data(), triangles.size());
+    builder.rebuild(tree, triangles.data(), triangles.size());
+
+    EXPECT_TRUE(equal_trees(index_tree, ref_index));
+    EXPECT_TRUE(index_tree.indices() == ref_index.indices());
+    EXPECT_TRUE(equal_trees(tree, ref_bvh));
+
+    EXPECT_EQ(index_tree.nodes().data(), nodes_ptr);
+    EXPECT_EQ(index_tree.indices().data(), indices_ptr);
+
+    // Rebuild with fewer primitives
+    builder.rebuild(index_tree, triangles.data(), 10);
+    EXPECT_EQ(index_tree.num_primitives(), size_t(10));
+    EXPECT_EQ(index_tree.num_indices(), size_t(10));
+    EXPECT_EQ(index_tree.nodes().data(), nodes_ptr);
+}
+
+TEST(BVH, Rebuild)
+{
+    binned_sah_builder sah;
+    test_rebuild(sah);
+
+    sah.enable_spatial_splits(true);
+    test_rebuild(sah);
+
+    lbvh_builder lbvh;
+    test_rebuild(lbvh);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that LBVH builders can be used on several threads at once
+//
+
+TEST(BVH, ConcurrentLBVH)
+{
+    aligned_vector<triangle_t, 32> triangles;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        vec3 v(static_cast<float>(i % 30), static_cast<float>((i / 30) % 30), static_cast<float>(i / 900));
+        triangles.emplace_back(v, vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    lbvh_builder fresh;
+    auto ref = fresh.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    static const int NumThreads = 4;
+    static const int NumBuilds = 10;
+
+    bool equal[NumThreads][NumBuilds] = {};
+    std::thread threads[NumThreads];
+
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        threads[t] = std::thread([&, t]()
+        {
+            for (int i = 0; i < NumBuilds; ++i)
+            {
+                lbvh_builder builder;
+                auto tree = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+                equal[t][i] = equal_trees(tree, ref) && tree.indices() == ref.indices();
+            }
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        for (int i = 0; i < NumBuilds; ++i)
+        {
+            EXPECT_TRUE(equal[t][i]);
+        }
+    }
+}
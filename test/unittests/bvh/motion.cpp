@@ -0,0 +1,269 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <random>
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+#include <visionaray/traverse.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+using triangle_t = basic_triangle<3, float>;
+using inst_t = index_bvh<triangle_t>::bvh_inst;
+
+// Unit square in the xy plane
+static aligned_vector<triangle_t> make_square()
+{
+    aligned_vector<triangle_t> triangles;
+    triangles.emplace_back(vec3(0.0f, 0.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(1.0f, 1.0f, 0.0f));
+    triangles.emplace_back(vec3(0.0f, 0.0f, 0.0f), vec3(1.0f, 1.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f));
+
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        triangles[i].prim_id = static_cast<unsigned>(i);
+        triangles[i].geom_id = 0;
+    }
+
+    return triangles;
+}
+
+static mat4x3 make_transform(vec3 const& translation, float scale)
+{
+    return mat4x3(mat3(scale, scale, scale), translation);
+}
+
+// Squares on a 4x4 grid, odd squares move to the right, even ones grow
+struct motion_scene
+{
+    static const int num_instances = 16;
+
+    vec3 corner(int i, float time) const
+    {
+        vec3 c0(float(i % 4) * 4.0f, float(i / 4) * 4.0f, 0.0f);
+        return i % 2 ? c0 + vec3(2.0f * time, 0.0f, 0.0f) : c0;
+    }
+
+    float size(int i, float time) const
+    {
+        return i % 2 ? 1.0f : 1.0f + time;
+    }
+
+    // Instance hit at time, -1 if none
+    int expected_hit(vec2 const& pos, float time) const
+    {
+        for (int i = 0; i < num_instances; ++i)
+        {
+            vec3 c = corner(i, time);
+            float s = size(i, time);
+
+            if (pos.x > c.x && pos.x < c.x + s && pos.y > c.y && pos.y < c.y + s)
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    aligned_vector<inst_t> make_instances(index_bvh<triangle_t>& square) const
+    {
+        aligned_vector<inst_t> result;
+
+        for (int i = 0; i < num_instances; ++i)
+        {
+            result.emplace_back(
+                    square.ref(),
+                    make_transform(corner(i, 0.0f), size(i, 0.0f)),
+                    make_transform(corner(i, 1.0f), size(i, 1.0f))
+                    );
+            result.back().set_inst_id(i);
+        }
+
+        return result;
+    }
+};
+
+static basic_ray<float> make_ray(vec2 const& pos, float time)
+{
+    basic_ray<float> ray(vec3(pos, 5.0f), vec3(0.0f, 0.0f, -1.0f));
+    ray.time = time;
+    return ray;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that rays carry time through SIMD conversions
+//
+
+TEST(MotionBVH, RayTime)
+{
+    basic_ray<float> r(vec3(0.0f), vec3(0.0f, 0.0f, 1.0f));
+    EXPECT_FLOAT_EQ(r.time, 0.0f);
+
+    array<basic_ray<float>, 4> rays;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        rays[i] = r;
+        rays[i].time = i * 0.25f;
+    }
+
+    auto packet = simd::pack(rays);
+    EXPECT_TRUE( all(packet.time == simd::float4(0.0f, 0.25f, 0.5f, 0.75f)) );
+
+    auto unpacked = simd::unpack(packet);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_FLOAT_EQ(unpacked[i].time, i * 0.25f);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test node bounds
+//
+
+TEST(MotionBVH, Bounds)
+{
+    auto triangles = make_square();
+
+    binned_sah_builder builder;
+    auto square = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    motion_scene scene;
+    auto instances = scene.make_instances(square);
+
+    // Instance bounds
+    auto bounds = get_motion_bounds(instances[1]);
+    EXPECT_FLOAT_EQ(bounds[0].min.x, 0.0f + 4.0f);
+    EXPECT_FLOAT_EQ(bounds[1].min.x, 2.0f + 4.0f);
+
+    auto all_bounds = get_bounds(instances[1]);
+    EXPECT_FLOAT_EQ(all_bounds.min.x, 4.0f);
+    EXPECT_FLOAT_EQ(all_bounds.max.x, 7.0f);
+
+    // Static primitives have the same bounds at both times
+    auto static_bounds = get_motion_bounds(triangles[0]);
+    EXPECT_EQ(static_bounds[0], static_bounds[1]);
+
+    // Root node bounds at time 0 and 1, and interpolated
+    auto bvh = builder.build(index_motion_bvh<inst_t>{}, instances.data(), instances.size());
+
+    auto const& root = bvh.node(0);
+    EXPECT_FLOAT_EQ(root.bbox0.max.x, 13.0f);
+    EXPECT_FLOAT_EQ(root.bbox1.max.x, 15.0f);
+    EXPECT_FLOAT_EQ(root.get_bounds(0.5f).max.x, 14.0f);
+    EXPECT_FLOAT_EQ(root.get_bounds().max.x, 15.0f);
+
+    // Inner nodes bound their children at both times
+    for (size_t i = 0; i < bvh.num_nodes(); ++i)
+    {
+        auto const& node = bvh.node(i);
+
+        if (node.is_inner())
+        {
+            for (int j = 0; j < 2; ++j)
+            {
+                auto const& child = bvh.node(node.get_child(j));
+                EXPECT_EQ(combine(node.bbox0, child.bbox0), node.bbox0);
+                EXPECT_EQ(combine(node.bbox1, child.bbox1), node.bbox1);
+            }
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test traversal of motion BVHs over motion blurred instances
+//
+
+TEST(MotionBVH, Traversal)
+{
+    auto triangles = make_square();
+
+    binned_sah_builder builder;
+    auto square = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    motion_scene scene;
+    auto instances = scene.make_instances(square);
+
+    auto motion_bvh = builder.build(index_motion_bvh<inst_t>{}, instances.data(), instances.size());
+    auto static_bvh = builder.build(index_bvh<inst_t>{}, instances.data(), instances.size());
+
+    lbvh_builder lbuilder;
+    auto motion_lbvh = lbuilder.build(index_motion_bvh<inst_t>{}, instances.data(), instances.size());
+
+    auto r1 = motion_bvh.ref();
+    auto r2 = static_bvh.ref();
+    auto r3 = motion_lbvh.ref();
+
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    int num_hits = 0;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        vec2 pos(dist(rng) * 16.0f, dist(rng) * 16.0f);
+        float time = dist(rng);
+
+        auto ray = make_ray(pos, time);
+
+        int expected = scene.expected_hit(pos, time);
+
+        auto hr1 = closest_hit(ray, &r1, &r1 + 1);
+        auto hr2 = closest_hit(ray, &r2, &r2 + 1);
+        auto hr3 = closest_hit(ray, &r3, &r3 + 1);
+
+        ASSERT_EQ(hr1.hit, expected >= 0);
+        ASSERT_EQ(hr2.hit, expected >= 0);
+        ASSERT_EQ(hr3.hit, expected >= 0);
+
+        if (expected >= 0)
+        {
+            EXPECT_EQ(hr1.inst_id, expected);
+            EXPECT_EQ(hr2.inst_id, expected);
+            EXPECT_EQ(hr3.inst_id, expected);
+            EXPECT_FLOAT_EQ(hr1.t, 5.0f);
+            ++num_hits;
+        }
+    }
+
+    EXPECT_GT(num_hits, 1000);
+
+
+    // SIMD rays with a different time per ray
+    for (int i = 0; i < 1000; ++i)
+    {
+        array<basic_ray<float>, 4> rays;
+
+        for (int j = 0; j < 4; ++j)
+        {
+            rays[j] = make_ray(vec2(dist(rng) * 16.0f, dist(rng) * 16.0f), dist(rng));
+        }
+
+        auto hrs = simd::unpack(closest_hit(simd::pack(rays), &r1, &r1 + 1));
+
+        for (int j = 0; j < 4; ++j)
+        {
+            auto hr = closest_hit(rays[j], &r1, &r1 + 1);
+
+            ASSERT_EQ(hr.hit, hrs[j].hit);
+
+            if (hr.hit)
+            {
+                EXPECT_EQ(hr.inst_id, hrs[j].inst_id);
+            }
+        }
+    }
+}
@@ -0,0 +1,204 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstddef>
+#include <random>
+
+#include <visionaray/math/simd/simd.h>
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/array.h>
+#include <visionaray/bvh.h>
+#include <visionaray/occlusion_batch.h>
+#include <visionaray/traverse.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+using triangle_t = basic_triangle<3, float>;
+
+// Small random triangles in the unit cube
+static aligned_vector<triangle_t> make_triangles(size_t n, std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    aligned_vector<triangle_t> result(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        vec3 v1(dist(rng), dist(rng), dist(rng));
+        vec3 e1 = vec3(dist(rng), dist(rng), dist(rng)) * 0.1f;
+        vec3 e2 = vec3(dist(rng), dist(rng), dist(rng)) * 0.1f;
+
+        result[i] = triangle_t(v1, e1, e2);
+        result[i].prim_id = static_cast<unsigned>(i);
+        result[i].geom_id = 0;
+    }
+
+    return result;
+}
+
+// Shadow rays between random points in and around the unit cube
+static aligned_vector<basic_ray<float>> make_rays(size_t n, std::default_random_engine& rng)
+{
+    std::uniform_real_distribution<float> dist(-0.5f, 1.5f);
+
+    aligned_vector<basic_ray<float>> result(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        vec3 p1(dist(rng), dist(rng), dist(rng));
+        vec3 p2(dist(rng), dist(rng), dist(rng));
+
+        float len = length(p2 - p1);
+
+        result[i] = basic_ray<float>(p1, (p2 - p1) / len, 0.0f, len);
+    }
+
+    return result;
+}
+
+template <typename FloatT, typename Primitives>
+static void test_packets(aligned_vector<basic_ray<float>> const& rays, Primitives begin, Primitives end)
+{
+    enum { N = simd::num_elements<FloatT>::value };
+
+    for (size_t first = 0; first + N <= rays.size(); first += N)
+    {
+        array<basic_ray<float>, N> scalar_rays;
+
+        for (size_t i = 0; i < N; ++i)
+        {
+            scalar_rays[i] = rays[first + i];
+        }
+
+        auto ray = simd::pack(scalar_rays);
+
+        auto hr = any_hit(ray, begin, end);
+        auto occl = occluded(ray, begin, end);
+
+        simd::aligned_array_t<simd::int_type_t<FloatT>> hit;
+        simd::aligned_array_t<simd::int_type_t<FloatT>> occ;
+        store(hit, convert_to_int(hr.hit));
+        store(occ, convert_to_int(occl));
+
+        for (size_t i = 0; i < N; ++i)
+        {
+            EXPECT_EQ(hit[i] != 0, occ[i] != 0);
+        }
+    }
+}
+
+template <typename Primitives>
+static size_t test_occluded(aligned_vector<basic_ray<float>> const& rays, Primitives begin, Primitives end)
+{
+    size_t num_occluded = 0;
+
+    // Scalar
+    for (auto const& r : rays)
+    {
+        bool occl = occluded(r, begin, end);
+        EXPECT_EQ(any_hit(r, begin, end).hit, occl);
+        num_occluded += occl ? 1 : 0;
+    }
+
+    // Packets
+    test_packets<simd::float4>(rays, begin, end);
+#if VSNRAY_SIMD_ISA_GE(VSNRAY_SIMD_ISA_AVX)
+    test_packets<simd::float8>(rays, begin, end);
+#endif
+
+    // Batch
+    occlusion_batch<simd::float4> batch;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        batch.clear();
+
+        for (auto const& r : rays)
+        {
+            batch.push_back(r);
+        }
+
+        batch.trace(begin, end);
+
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            EXPECT_EQ(any_hit(rays[i], begin, end).hit, batch.occluded(i));
+        }
+    }
+
+    return num_occluded;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test occluded() against any_hit()
+//
+
+TEST(BVH, Occluded)
+{
+    std::default_random_engine rng(0);
+
+    auto triangles = make_triangles(500, rng);
+    auto rays = make_rays(1003, rng);
+
+    binned_sah_builder builder;
+
+    auto index_tree = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+    auto tree = builder.build(bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    auto index_ref = index_tree.ref();
+    auto ref = tree.ref();
+
+    size_t num_occluded = test_occluded(rays, &index_ref, &index_ref + 1);
+    test_occluded(rays, &ref, &ref + 1);
+
+    // Both occluded and unoccluded rays are tested
+    EXPECT_GT(num_occluded, rays.size() / 10);
+    EXPECT_LT(num_occluded, rays.size() - rays.size() / 10);
+
+    // Plain list of primitives
+    test_occluded(rays, triangles.data(), triangles.data() + 100);
+
+    // Inactive rays (tmin > tmax) are not occluded
+    basic_ray<float> inactive(vec3(0.5f, 0.5f, -1.0f), vec3(0.0f, 0.0f, 1.0f), 1.0f, 0.0f);
+    EXPECT_FALSE(occluded(inactive, &index_ref, &index_ref + 1));
+}
+
+TEST(BVH, OccludedInstances)
+{
+    std::default_random_engine rng(1);
+
+    auto triangles = make_triangles(200, rng);
+    auto rays = make_rays(1003, rng);
+
+    // Spatial splits for the mesh, the builder uses object splits only for the top level
+    binned_sah_builder builder;
+    builder.enable_spatial_splits(true);
+
+    auto mesh = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    using inst_t = index_bvh<triangle_t>::bvh_inst;
+
+    aligned_vector<inst_t> instances;
+    instances.push_back(mesh.inst(mat4x3(mat3::identity(), vec3(0.0f))));
+    instances.push_back(mesh.inst(mat4x3(mat3::identity() * 0.5f, vec3(0.5f, 0.0f, 0.2f))));
+    instances.push_back(mesh.inst(mat4x3(mat3::identity(), vec3(-0.7f, 0.3f, 0.0f))));
+
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        instances[i].set_inst_id(static_cast<int>(i));
+    }
+
+    auto top_level = builder.build(index_bvh<inst_t>{}, instances.data(), instances.size());
+    auto top_level_ref = top_level.ref();
+
+    test_occluded(rays, &top_level_ref, &top_level_ref + 1);
+}
@@ -0,0 +1,322 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <visionaray/math/math.h>
+
+#include <common/data_file.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+using namespace visionaray::data_file;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+// Vertex positions, normals and indices of a mesh with num_vertices vertices
+struct mesh_data
+{
+    explicit mesh_data(int num_vertices)
+    {
+        for (int i = 0; i < num_vertices; ++i)
+        {
+            float f = static_cast<float>(i);
+            positions.emplace_back(sin(f) * 10.0f, f * 0.01f, -cos(f * 0.5f) * 3.0f);
+            normals.push_back(normalize(vec3(cos(f), sin(f), 0.5f)));
+        }
+
+        for (int i = 0; i < num_vertices * 3; ++i)
+        {
+            // Mostly small differences, some large jumps
+            indices.push_back(i % 17 == 0 ? (i * 7919) % num_vertices : i / 3);
+        }
+    }
+
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<int> indices;
+};
+
+static meta_data make_meta_data(meta_data::data_type_t dt, size_t num_items, meta_data::compression_t comp)
+{
+    meta_data md;
+    md.encoding = meta_data::Binary;
+    md.data_type = dt;
+    md.num_items = static_cast<int>(num_items);
+    md.compression = comp;
+    return md;
+}
+
+template <typename T>
+static std::vector<T> round_trip(
+        std::vector<T> const&   items,
+        meta_data const&        md,
+        blocked::worker_pool&   pool
+        )
+{
+    auto stream = blocked::encode(md, reinterpret_cast<char const*>(items.data()), pool);
+
+    std::vector<T> result(items.size());
+    blocked::decode(md, stream.data(), stream.size(), reinterpret_cast<char*>(result.data()), pool);
+    return result;
+}
+
+static void expect_near(std::vector<vec3> const& a, std::vector<vec3> const& b, float tolerance)
+{
+    ASSERT_EQ(a.size(), b.size());
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            ASSERT_NEAR(a[i][c], b[i][c], tolerance) << "item " << i;
+        }
+    }
+}
+
+static uint64_t get_u64(std::vector<char> const& bytes, size_t offset)
+{
+    uint64_t u = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        u |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[offset + i])) << (i * 8);
+    }
+    return u;
+}
+
+static void set_u64(std::vector<char>& bytes, size_t offset, uint64_t u)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        bytes[offset + i] = static_cast<char>((u >> (i * 8)) & 0xFF);
+    }
+}
+
+static std::string decode_error(meta_data const& md, std::vector<char> const& stream, blocked::worker_pool& pool)
+{
+    std::vector<char> dst(md.num_items * meta_data::num_components(md.data_type) * meta_data::word_size(md.data_type));
+
+    try
+    {
+        blocked::decode(md, stream.data(), stream.size(), dst.data(), pool);
+    }
+    catch (std::runtime_error const& e)
+    {
+        return e.what();
+    }
+
+    return "";
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that positions, normals and indices survive an encode/decode round trip
+//
+
+TEST(DataFile, RoundTrip)
+{
+    blocked::worker_pool pool;
+
+    // Single block and several blocks (the last one partially filled)
+    for (int num_vertices : { 100, int(blocked::items_per_block), 10000 })
+    {
+        SCOPED_TRACE(std::to_string(num_vertices) + " vertices");
+
+        mesh_data mesh(num_vertices);
+
+        size_t num_indices = mesh.indices.size();
+
+        // Lossless
+        auto md = make_meta_data(meta_data::Vec3f, num_vertices, meta_data::Delta);
+        EXPECT_TRUE(round_trip(mesh.positions, md, pool) == mesh.positions);
+        EXPECT_TRUE(round_trip(mesh.normals, md, pool) == mesh.normals);
+
+        md = make_meta_data(meta_data::I32, num_indices, meta_data::Delta);
+        EXPECT_TRUE(round_trip(mesh.indices, md, pool) == mesh.indices);
+
+        // Quantization error is at most half a step of 16 bits over the range of
+        // the stream (< 101 for positions, <= 2 for normals), plus rounding
+        md = make_meta_data(meta_data::Vec3f, num_vertices, meta_data::Quantized);
+        expect_near(round_trip(mesh.positions, md, pool), mesh.positions, 50.5f / 65535.0f + 1e-5f);
+        expect_near(round_trip(mesh.normals, md, pool), mesh.normals, 1.0f / 65535.0f + 1e-6f);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that equal positions in different blocks decode to equal positions
+//
+
+TEST(DataFile, QuantizedSharedPositions)
+{
+    blocked::worker_pool pool;
+
+    // De-indexed mesh: the corners of the triangles around the block
+    // boundary are repeated in both blocks
+    mesh_data mesh(blocked::items_per_block * 2);
+    std::vector<vec3> positions;
+
+    for (int i : mesh.indices)
+    {
+        positions.push_back(mesh.positions[i]);
+    }
+
+    size_t boundary = blocked::items_per_block;
+    positions[boundary - 1] = vec3(3.14159f, -0.001f, 2.71828f);
+    positions[boundary] = positions[boundary - 1];
+    positions[boundary + 5] = positions[boundary - 1];
+
+    // Different value ranges in the two blocks
+    positions[7] = vec3(-1000.0f, 0.0f, 0.0f);
+
+    auto md = make_meta_data(meta_data::Vec3f, positions.size(), meta_data::Quantized);
+    auto result = round_trip(positions, md, pool);
+
+    EXPECT_TRUE(result[boundary - 1] == result[boundary]);
+    EXPECT_TRUE(result[boundary - 1] == result[boundary + 5]);
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        for (size_t j = i + 1; j < std::min(positions.size(), i + 64); ++j)
+        {
+            if (positions[i] == positions[j])
+            {
+                ASSERT_TRUE(result[i] == result[j]) << i << ' ' << j;
+            }
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that non-finite values are not quantized
+//
+
+TEST(DataFile, QuantizedNonFinite)
+{
+    blocked::worker_pool pool;
+
+    for (float x : { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity() })
+    {
+        mesh_data mesh(100);
+        mesh.positions[42].y = x;
+
+        auto md = make_meta_data(meta_data::Vec3f, mesh.positions.size(), meta_data::Quantized);
+        char const* src = reinterpret_cast<char const*>(mesh.positions.data());
+
+        EXPECT_FALSE(blocked::can_quantize(md, src));
+        EXPECT_THROW(blocked::encode(md, src, pool), std::runtime_error);
+    }
+
+    mesh_data mesh(100);
+    auto md = make_meta_data(meta_data::Vec3f, mesh.positions.size(), meta_data::Quantized);
+    EXPECT_TRUE(blocked::can_quantize(md, reinterpret_cast<char const*>(mesh.positions.data())));
+
+    // Extreme but finite values
+    std::vector<vec3> extreme = { vec3(-3e38f), vec3(3e38f), vec3(0.0f) };
+    md = make_meta_data(meta_data::Vec3f, extreme.size(), meta_data::Quantized);
+    auto result = round_trip(extreme, md, pool);
+    EXPECT_TRUE(result[0] == extreme[0]);
+    EXPECT_TRUE(result[1] == extreme[1]);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that raw data files are read in place
+//
+
+TEST(DataFile, Raw)
+{
+    mesh_data mesh(1000);
+
+    auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+
+    auto md = make_meta_data(meta_data::Vec3f, mesh.positions.size(), meta_data::Raw);
+    md.path = (dir / "positions.bin").string();
+
+    {
+        std::ofstream file(md.path, std::ios::binary);
+        file.write(reinterpret_cast<char const*>(mesh.positions.data()), mesh.positions.size() * sizeof(vec3));
+    }
+
+    {
+        binary_view<vec3> view(md);
+
+        ASSERT_EQ(view.size(), mesh.positions.size());
+        EXPECT_TRUE(std::vector<vec3>(view.begin(), view.end()) == mesh.positions);
+    }
+
+    boost::filesystem::remove_all(dir);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that corrupt and truncated streams are rejected with the decoder's error
+//
+
+TEST(DataFile, CorruptStream)
+{
+    blocked::worker_pool pool;
+
+    for (int num_vertices : { 100, 10000 })
+    {
+        SCOPED_TRACE(std::to_string(num_vertices) + " vertices");
+
+        mesh_data mesh(num_vertices);
+
+        auto md = make_meta_data(meta_data::Vec3f, num_vertices, meta_data::Delta);
+        auto stream = blocked::encode(md, reinterpret_cast<char const*>(mesh.positions.data()), pool);
+
+        size_t num_blocks = (num_vertices + blocked::items_per_block - 1) / blocked::items_per_block;
+        size_t first_block = blocked::header_size + (num_blocks + 1) * sizeof(uint64_t);
+
+        EXPECT_EQ(decode_error(md, stream, pool), "");
+
+        // Varints that never terminate in the last block
+        auto corrupt = stream;
+        for (size_t i = corrupt.size() - 16; i < corrupt.size(); ++i)
+        {
+            corrupt[i] = char(0xFF);
+        }
+        EXPECT_EQ(decode_error(md, corrupt, pool), "Corrupt compressed data block");
+
+        // Last block is one byte too short
+        auto offsets = stream;
+        set_u64(offsets, first_block - 8, get_u64(offsets, first_block - 8) - 1);
+        EXPECT_EQ(decode_error(md, offsets, pool), "Corrupt compressed data block");
+
+        // Block offset past the end of the stream
+        if (num_blocks > 1)
+        {
+            offsets = stream;
+            set_u64(offsets, blocked::header_size + 8, uint64_t(1) << 40);
+            EXPECT_EQ(decode_error(md, offsets, pool), "Invalid compressed data file");
+        }
+
+        // Truncated stream
+        auto truncated = stream;
+        truncated.resize(truncated.size() - 1);
+        EXPECT_EQ(decode_error(md, truncated, pool), "Invalid compressed data file");
+
+        truncated.resize(blocked::header_size);
+        EXPECT_EQ(decode_error(md, truncated, pool), "Invalid compressed data file");
+
+        // Meta data that doesn't match
+        auto other = make_meta_data(meta_data::Vec3f, num_vertices + 1, meta_data::Delta);
+        EXPECT_EQ(decode_error(other, stream, pool), "Compressed data file does not match meta data");
+    }
+}
@@ -0,0 +1,502 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/texture.h>
+
+#include <common/hdr_image.h>
+#include <common/image.h>
+#include <common/image_loader.h>
+#include <common/pnm_image.h>
+#include <common/tga_image.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+// Removes the directory when going out of scope
+struct temp_dir
+{
+    temp_dir()
+        : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+    {
+        boost::filesystem::create_directories(path);
+    }
+
+   ~temp_dir()
+    {
+        boost::filesystem::remove_all(path);
+    }
+
+    std::string file(std::string const& name) const
+    {
+        return (path / name).string();
+    }
+
+    boost::filesystem::path path;
+};
+
+static std::vector<uint8_t> make_pixels(int width, int height, int components, int seed = 0)
+{
+    std::vector<uint8_t> result(width * height * components);
+
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        // Some runs, some noise
+        size_t pixel = i / components;
+        result[i] = (pixel % 7) < 3 ? uint8_t(seed * 10 + i % components) : uint8_t((i * 37 + seed) % 251);
+    }
+
+    return result;
+}
+
+static void write_bytes(std::string const& filename, std::vector<uint8_t> const& bytes)
+{
+    std::ofstream file(filename, std::ios::binary);
+    file.write(reinterpret_cast<char const*>(bytes.data()), bytes.size());
+}
+
+// rgb(a) in bottom-up row order, as visionaray stores images
+static std::vector<uint8_t> make_tga(
+        int                         width,
+        int                         height,
+        int                         components,
+        std::vector<uint8_t> const& rgb,
+        bool                        rle,
+        bool                        top_down
+        )
+{
+    std::vector<uint8_t> bytes = {
+            0, 0, uint8_t(rle ? 10 : 2),
+            0, 0, 0, 0, 0,
+            0, 0, 0, 0,
+            uint8_t(width & 0xFF), uint8_t(width >> 8),
+            uint8_t(height & 0xFF), uint8_t(height >> 8),
+            uint8_t(components * 8),
+            uint8_t(top_down ? 0x20 : 0x00)
+            };
+
+    // BGR(A), file row order
+    std::vector<uint8_t> pixels;
+
+    for (int y = 0; y < height; ++y)
+    {
+        int row = top_down ? height - 1 - y : y;
+
+        for (int x = 0; x < width; ++x)
+        {
+            uint8_t const* p = rgb.data() + (row * width + x) * components;
+            pixels.push_back(p[2]);
+            pixels.push_back(p[1]);
+            pixels.push_back(p[0]);
+
+            if (components == 4)
+            {
+                pixels.push_back(p[3]);
+            }
+        }
+    }
+
+    if (!rle)
+    {
+        bytes.insert(bytes.end(), pixels.begin(), pixels.end());
+        return bytes;
+    }
+
+    // Packets may span rows
+    size_t num_pixels = width * height;
+    size_t i = 0;
+
+    while (i < num_pixels)
+    {
+        size_t run = 1;
+
+        while (i + run < num_pixels && run < 128
+            && std::memcmp(&pixels[(i + run) * components], &pixels[i * components], components) == 0)
+        {
+            ++run;
+        }
+
+        if (run > 1)
+        {
+            bytes.push_back(uint8_t(0x80 | (run - 1)));
+            bytes.insert(bytes.end(), &pixels[i * components], &pixels[i * components] + components);
+            i += run;
+        }
+        else
+        {
+            size_t count = std::min(size_t(3), num_pixels - i);
+            bytes.push_back(uint8_t(count - 1));
+            bytes.insert(bytes.end(), &pixels[i * components], &pixels[(i + count) * components]);
+            i += count;
+        }
+    }
+
+    return bytes;
+}
+
+// RLE (new-style) Radiance file from RGBE texels, top row first
+static std::vector<uint8_t> make_hdr(int width, int height, std::vector<uint8_t> const& rgbe)
+{
+    std::string header = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y "
+            + std::to_string(height) + " +X " + std::to_string(width) + "\n";
+
+    std::vector<uint8_t> bytes(header.begin(), header.end());
+
+    for (int y = 0; y < height; ++y)
+    {
+        bytes.push_back(2);
+        bytes.push_back(2);
+        bytes.push_back(uint8_t(width >> 8));
+        bytes.push_back(uint8_t(width & 0xFF));
+
+        for (int c = 0; c < 4; ++c)
+        {
+            int x = 0;
+
+            while (x < width)
+            {
+                uint8_t value = rgbe[(y * width + x) * 4 + c];
+                int run = 1;
+
+                while (x + run < width && run < 127 && rgbe[(y * width + x + run) * 4 + c] == value)
+                {
+                    ++run;
+                }
+
+                if (run > 2)
+                {
+                    bytes.push_back(uint8_t(128 + run));
+                    bytes.push_back(value);
+                    x += run;
+                }
+                else
+                {
+                    int count = std::min(width - x, 2);
+                    bytes.push_back(uint8_t(count));
+
+                    for (int i = 0; i < count; ++i)
+                    {
+                        bytes.push_back(rgbe[(y * width + x + i) * 4 + c]);
+                    }
+
+                    x += count;
+                }
+            }
+        }
+    }
+
+    return bytes;
+}
+
+// Texture type whose allocation fails
+struct throwing_texture
+{
+    throwing_texture(int, int)
+    {
+        throw std::bad_alloc();
+    }
+};
+
+static void make_texture(throwing_texture&, image const&)
+{
+}
+
+static bool equal(image_base const& img, int width, int height, pixel_format format, std::vector<uint8_t> const& data)
+{
+    return img.width() == width
+        && img.height() == height
+        && img.format() == format
+        && std::memcmp(img.data(), data.data(), data.size()) == 0;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test the in-tree decoders
+//
+
+TEST(ImageLoader, TGA)
+{
+    temp_dir dir;
+
+    int width = 37;
+    int height = 21;
+
+    for (int components : { 3, 4 })
+    {
+        auto rgb = make_pixels(width, height, components);
+        pixel_format format = components == 3 ? PF_RGB8 : PF_RGBA8;
+
+        for (bool rle : { false, true })
+        {
+            for (bool top_down : { false, true })
+            {
+                std::string fn = dir.file("test.tga");
+                write_bytes(fn, make_tga(width, height, components, rgb, rle, top_down));
+
+                tga_image tga;
+                ASSERT_TRUE(tga.load(fn));
+
+                EXPECT_TRUE(equal(tga, width, height, format, rgb)) << components << ' ' << rle << ' ' << top_down;
+            }
+        }
+
+        // Truncated files fail
+        std::string fn = dir.file("truncated.tga");
+        auto bytes = make_tga(width, height, components, rgb, true, false);
+        bytes.resize(bytes.size() / 2);
+        write_bytes(fn, bytes);
+
+        tga_image tga;
+        EXPECT_FALSE(tga.load(fn));
+    }
+}
+
+TEST(ImageLoader, HDR)
+{
+    temp_dir dir;
+
+    int width = 45;
+    int height = 8;
+
+    auto rgbe = make_pixels(width, height, 4, 3);
+
+    for (size_t i = 3; i < rgbe.size(); i += 4)
+    {
+        rgbe[i] = uint8_t(120 + rgbe[i] % 16);
+    }
+
+    std::string fn = dir.file("test.hdr");
+    write_bytes(fn, make_hdr(width, height, rgbe));
+
+    hdr_image hdr;
+    ASSERT_TRUE(hdr.load(fn));
+    ASSERT_EQ(hdr.width(), width);
+    ASSERT_EQ(hdr.height(), height);
+    ASSERT_EQ(hdr.format(), PF_RGB32F);
+
+    float const* data = reinterpret_cast<float const*>(hdr.data());
+
+    for (int i = 0; i < width * height; ++i)
+    {
+        float scale = std::ldexp(1.0f, rgbe[i * 4 + 3] - 128) / 256.0f;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            EXPECT_FLOAT_EQ(data[i * 3 + c], rgbe[i * 4 + c] * scale);
+        }
+    }
+
+    // Truncated files fail
+    auto bytes = make_hdr(width, height, rgbe);
+    bytes.resize(bytes.size() - 10);
+    write_bytes(fn, bytes);
+
+    EXPECT_FALSE(hdr.load(fn));
+}
+
+TEST(ImageLoader, PNM)
+{
+    temp_dir dir;
+
+    int width = 23;
+    int height = 17;
+
+    for (int components : { 1, 3 })
+    {
+        auto pixels = make_pixels(width, height, components);
+        pixel_format format = components == 1 ? PF_R8 : PF_RGB8;
+
+        for (bool binary : { false, true })
+        {
+            char magic = components == 1 ? (binary ? '5' : '2') : (binary ? '6' : '3');
+            std::string text = std::string("P") + magic + "\n" + std::to_string(width) + ' ' + std::to_string(height) + "\n255\n";
+            std::vector<uint8_t> bytes(text.begin(), text.end());
+
+            if (binary)
+            {
+                bytes.insert(bytes.end(), pixels.begin(), pixels.end());
+            }
+            else
+            {
+                for (int y = 0; y < height; ++y)
+                {
+                    std::string line;
+
+                    for (int x = 0; x < width * components; ++x)
+                    {
+                        line += std::to_string(pixels[y * width * components + x]) + (x % 2 ? "  " : " ");
+                    }
+
+                    line += '\n';
+                    bytes.insert(bytes.end(), line.begin(), line.end());
+                }
+            }
+
+            std::string fn = dir.file("test.pnm");
+            write_bytes(fn, bytes);
+
+            pnm_image pnm;
+            ASSERT_TRUE(pnm.load(fn));
+            EXPECT_TRUE(equal(pnm, width, height, format, pixels)) << components << ' ' << binary;
+
+            // Truncated files fail
+            bytes.resize(bytes.size() - 10);
+            write_bytes(fn, bytes);
+            EXPECT_FALSE(pnm.load(fn));
+        }
+    }
+
+    // Comments and max. value
+    std::string text = "P2\n# comment\n3 2\n# another comment\n15\n0 1 2\n3 14 15\n";
+    std::string fn = dir.file("comment.pgm");
+    write_bytes(fn, std::vector<uint8_t>(text.begin(), text.end()));
+
+    pnm_image pnm;
+    ASSERT_TRUE(pnm.load(fn));
+    ASSERT_EQ(pnm.width(), 3);
+    ASSERT_EQ(pnm.height(), 2);
+    EXPECT_EQ(pnm.data()[0], 0);
+    EXPECT_EQ(pnm.data()[2], 34);
+    EXPECT_EQ(pnm.data()[5], 255);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test asynchronous loading, deduplication and texture conversion
+//
+
+TEST(ImageLoader, Async)
+{
+    temp_dir dir;
+
+    int num_files = 32;
+    int width = 64;
+    int height = 48;
+
+    std::vector<std::vector<uint8_t>> pixels;
+
+    for (int i = 0; i < num_files; ++i)
+    {
+        pixels.push_back(make_pixels(width, height, 4, i));
+        write_bytes(
+                dir.file(std::to_string(i) + ".tga"),
+                make_tga(width, height, 4, pixels.back(), i % 2 == 0, i % 3 == 0)
+                );
+    }
+
+    image_loader loader(4);
+    EXPECT_EQ(loader.num_threads(), 4U);
+
+    std::vector<image_loader::future<image>> images;
+
+    for (int i = 0; i < num_files; ++i)
+    {
+        images.push_back(loader.load(dir.file(std::to_string(i) + ".tga")));
+    }
+
+    // Same files, different spelling
+    auto again = loader.load((dir.path / "." / "5.tga").string());
+    auto missing = loader.load(dir.file("missing.tga"));
+
+    for (int i = 0; i < num_files; ++i)
+    {
+        auto img = images[i].get();
+        ASSERT_NE(img, nullptr);
+        EXPECT_TRUE(equal(*img, width, height, PF_RGBA8, pixels[i]));
+    }
+
+    EXPECT_EQ(again.get(), images[5].get());
+    EXPECT_EQ(missing.get(), nullptr);
+
+    // Textures in their final format, one per file and texture type
+    using texture_type = texture<vector<4, unorm<8>>, 2>;
+
+    std::vector<image_loader::future<texture_type>> textures;
+
+    for (int i = 0; i < num_files; ++i)
+    {
+        textures.push_back(loader.load_texture<texture_type>(dir.file(std::to_string(i) + ".tga")));
+    }
+
+    auto tex_again = loader.load_texture<texture_type>(dir.file("7.tga"));
+    auto tex_float = loader.load_texture<texture<vec4, 2>>(dir.file("7.tga"));
+
+    loader.wait();
+
+    for (int i = 0; i < num_files; ++i)
+    {
+        auto tex = textures[i].get();
+        ASSERT_NE(tex, nullptr);
+        ASSERT_EQ(tex->width(), unsigned(width));
+        ASSERT_EQ(tex->height(), unsigned(height));
+        EXPECT_EQ(std::memcmp(tex->data(), pixels[i].data(), pixels[i].size()), 0);
+    }
+
+    EXPECT_EQ(tex_again.get(), textures[7].get());
+    ASSERT_NE(tex_float.get(), nullptr);
+    EXPECT_FLOAT_EQ(tex_float.get()->data()[0].x, pixels[7][0] / 255.0f);
+
+    auto stats = loader.stats();
+    EXPECT_EQ(stats.requests, size_t(num_files * 2 + 4));
+    EXPECT_EQ(stats.decodes, size_t(num_files * 2 + 2));
+    EXPECT_EQ(stats.failures, 1U);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that missing and empty files, and exceptions in the workers, yield failures
+//
+
+TEST(ImageLoader, Failures)
+{
+    temp_dir dir;
+
+    std::string missing = dir.file("missing");
+    std::string empty = dir.file("empty");
+
+    for (auto ext : { ".tga", ".hdr", ".pnm" })
+    {
+        write_bytes(empty + ext, {});
+    }
+
+    for (auto fn : { missing, empty })
+    {
+        tga_image tga;
+        EXPECT_FALSE(tga.load(fn + ".tga"));
+
+        hdr_image hdr;
+        EXPECT_FALSE(hdr.load(fn + ".hdr"));
+
+        pnm_image pnm;
+        EXPECT_FALSE(pnm.load(fn + ".pnm"));
+    }
+
+    std::string fn = dir.file("test.tga");
+    write_bytes(fn, make_tga(4, 4, 3, make_pixels(4, 4, 3), false, false));
+
+    image_loader loader(2);
+
+    auto empty_img = loader.load(empty + ".tga");
+    auto tex = loader.load_texture<throwing_texture>(fn);
+
+    EXPECT_EQ(empty_img.get(), nullptr);
+    EXPECT_EQ(tex.get(), nullptr);
+    EXPECT_EQ(loader.stats().failures, 2U);
+}
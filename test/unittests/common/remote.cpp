@@ -0,0 +1,466 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+
+#include <common/remote/communicator.h>
+#include <common/remote/compositor.h>
+#include <common/remote/frame_codec.h>
+#include <common/remote/partition.h>
+#include <common/remote/render_client.h>
+#include <common/remote/render_server.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+using namespace visionaray::remote;
+
+using pixel_type = frame_encoder::pixel_type;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static bool equal(pixel_type const* a, pixel_type const* b, size_t n)
+{
+    return std::memcmp(a, b, n * sizeof(pixel_type)) == 0;
+}
+
+// Image with a moving square in front of a noisy background
+static std::vector<pixel_type> make_image(int width, int height, int frame)
+{
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<pixel_type> result(width * height);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            bool inside = x >= frame * 3 && x < frame * 3 + 10 && y >= 5 && y < 15;
+            vec4 c = inside ? vec4(1.0f, 0.0f, 0.0f, 1.0f) : vec4(dist(rng), dist(rng), dist(rng), 1.0f);
+            result[y * width + x] = pixel_type(c);
+        }
+    }
+
+    return result;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that all encodings reproduce the input exactly
+//
+
+TEST(Remote, FrameCodec)
+{
+    frame_encoding encodings[] = { RawEncoding, DeltaEncoding, TileEncoding };
+
+    for (auto encoding : encodings)
+    {
+        frame_encoder encoder(encoding);
+        frame_decoder decoder;
+
+        size_t key_frame_size = 0;
+
+        for (int frame = 0; frame < 5; ++frame)
+        {
+            // Resize after three frames
+            int width = frame < 3 ? 53 : 40;
+            int height = frame < 3 ? 37 : 20;
+
+            auto image = make_image(width, height, frame);
+
+            std::vector<char> data;
+            encoder.encode(image.data(), width, height, data);
+
+            ASSERT_TRUE(decoder.decode(data.data(), data.size()));
+            EXPECT_EQ(decoder.width(), width);
+            EXPECT_EQ(decoder.height(), height);
+            EXPECT_EQ(decoder.key_frame(), frame == 0 || frame == 3);
+            EXPECT_TRUE(equal(decoder.pixels(), image.data(), image.size()));
+
+            if (frame == 0)
+            {
+                key_frame_size = data.size();
+            }
+            else if (frame < 3 && encoding != RawEncoding)
+            {
+                // Only the moving square changed
+                EXPECT_LT(data.size(), key_frame_size / 4);
+            }
+        }
+
+        // Identical frames are cheap
+        auto image = make_image(40, 20, 4);
+        std::vector<char> data;
+        encoder.encode(image.data(), 40, 20, data);
+        ASSERT_TRUE(decoder.decode(data.data(), data.size()));
+        EXPECT_TRUE(equal(decoder.pixels(), image.data(), image.size()));
+
+        if (encoding != RawEncoding)
+        {
+            EXPECT_LT(data.size(), size_t(64));
+        }
+
+        // reset() makes a key frame
+        encoder.reset();
+        data.clear();
+        encoder.encode(image.data(), 40, 20, data);
+
+        frame_decoder other;
+        ASSERT_TRUE(other.decode(data.data(), data.size()));
+        EXPECT_TRUE(other.key_frame());
+        EXPECT_TRUE(equal(other.pixels(), image.data(), image.size()));
+
+        // Truncated data is rejected
+        EXPECT_FALSE(other.decode(data.data(), data.size() / 2));
+    }
+
+    // A delta frame without the frame it refers to is rejected
+    frame_encoder encoder(DeltaEncoding);
+    std::vector<char> data;
+    auto image = make_image(16, 16, 0);
+    encoder.encode(image.data(), 16, 16, data);
+    data.clear();
+    encoder.encode(image.data(), 16, 16, data);
+
+    frame_decoder decoder;
+    EXPECT_FALSE(decoder.decode(data.data(), data.size()));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test render server and client over loopback
+//
+
+TEST(Remote, Loopback)
+{
+    // Fills the image with a color derived from the camera, refines once
+    auto render = [](camera_update const& cam, bool camera_changed, pixel_type* pixels)
+    {
+        float r = cam.view(0, 3) / 255.0f;
+        float g = camera_changed ? 0.0f : 1.0f;
+
+        for (int i = 0; i < cam.width * cam.height; ++i)
+        {
+            pixels[i] = pixel_type(vec4(r, g, 0.0f, 1.0f));
+        }
+
+        return camera_changed;
+    };
+
+    // Let the system choose a free port
+    render_server server(0, render);
+    server.set_max_image_size(64);
+    server.start();
+
+    unsigned short port = server.port();
+    ASSERT_NE(port, 0);
+
+    render_client client;
+    ASSERT_TRUE(client.connect("localhost", port));
+
+    frame_encoding encodings[] = { RawEncoding, DeltaEncoding, TileEncoding };
+
+    for (int i = 0; i < 6; ++i)
+    {
+        mat4 view = mat4::identity();
+        view(0, 3) = static_cast<float>(i * 10);
+
+        int width = 32 + i;
+        int height = 24;
+
+        client.send_camera(view, mat4::identity(), width, height, encodings[i % 3]);
+        ASSERT_TRUE(client.wait_for_frame(10.0));
+
+        std::vector<pixel_type> pixels;
+        int w = 0;
+        int h = 0;
+        frame_info info;
+
+        ASSERT_TRUE(client.latest_frame(pixels, w, h, &info));
+        EXPECT_EQ(w, width);
+        EXPECT_EQ(h, height);
+        EXPECT_EQ(info.seq, static_cast<uint32_t>(i + 1));
+        EXPECT_EQ(static_cast<int>(static_cast<float>(pixels[0].x) * 255.0f + 0.5f), i * 10);
+    }
+
+    // Cameras larger than the maximum image size are ignored, the server keeps running
+    client.send_camera(mat4::identity(), mat4::identity(), 1 << 20, 1 << 20, RawEncoding);
+    EXPECT_FALSE(client.wait_for_frame(0.5));
+    EXPECT_EQ(server.stats().cameras_rejected, 1U);
+
+    client.send_camera(mat4::identity(), mat4::identity(), 64, 64, RawEncoding);
+    ASSERT_TRUE(client.wait_for_frame(10.0));
+
+    auto cs = client.stats();
+    EXPECT_GE(cs.frames_received, 7U);
+    EXPECT_EQ(cs.errors, 0U);
+    EXPECT_EQ(cs.round_trip.count, 7U);
+    EXPECT_GT(cs.round_trip.average(), 0.0);
+
+    client.disconnect();
+    server.stop();
+
+    auto ss = server.stats();
+    EXPECT_GE(ss.render.count, 6U);
+    EXPECT_GE(ss.encode.count, 6U);
+    EXPECT_GE(ss.frames_sent, 6U);
+    EXPECT_GT(ss.bytes_sent, size_t(0));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test BVH partitioning for sort-last rendering
+//
+
+TEST(Remote, PartitionBVH)
+{
+    using triangle_t = basic_triangle<3, float>;
+
+    // Row of unit triangles along the x axis
+    aligned_vector<triangle_t> triangles;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        vec3 v1(i * 2.0f, 0.0f, 0.0f);
+        triangles.emplace_back(v1, vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    binned_sah_builder builder;
+    auto bvh = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    for (unsigned num_parts : { 1U, 3U, 4U, 7U })
+    {
+        auto parts = remote::partition_bvh(bvh, num_parts);
+        ASSERT_EQ(parts.size(), num_parts);
+
+        std::vector<int> seen(triangles.size(), 0);
+
+        for (auto const& part : parts)
+        {
+            // Balanced and spatially compact
+            EXPECT_GT(part.size(), size_t(100 / num_parts / 3));
+
+            float min_x = 1e9f;
+            float max_x = -1e9f;
+
+            for (auto index : part)
+            {
+                ++seen[index];
+                min_x = std::min(min_x, triangles[index].v1.x);
+                max_x = std::max(max_x, triangles[index].v1.x);
+            }
+
+            EXPECT_LT(max_x - min_x, (part.size() + 1) * 2.0f);
+        }
+
+        for (auto s : seen)
+        {
+            EXPECT_EQ(s, 1);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test partitioning primitives by their centroids for sort-last rendering
+//
+
+TEST(Remote, PartitionPrimitives)
+{
+    using triangle_t = basic_triangle<3, float>;
+
+    // Grid of unit triangles in the xy plane, in shuffled order
+    aligned_vector<triangle_t> triangles;
+
+    for (int i = 0; i < 400; ++i)
+    {
+        int j = (i * 37) % 400;
+        vec3 v1((j % 20) * 2.0f, (j / 20) * 2.0f, 0.0f);
+        triangles.emplace_back(v1, vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    for (unsigned num_parts : { 1U, 2U, 3U, 4U, 7U })
+    {
+        auto parts = remote::partition_primitives(triangles.begin(), triangles.end(), num_parts);
+        ASSERT_EQ(parts.size(), num_parts);
+
+        std::vector<int> seen(triangles.size(), 0);
+
+        for (auto const& part : parts)
+        {
+            // Balanced
+            EXPECT_GE(part.size(), size_t(400 / num_parts));
+            EXPECT_LE(part.size(), size_t(400 / num_parts + 1));
+
+            // Sorted
+            EXPECT_TRUE(std::is_sorted(part.begin(), part.end()));
+
+            aabb bounds;
+            bounds.invalidate();
+
+            for (auto index : part)
+            {
+                ++seen[index];
+                bounds.insert(get_bounds(triangles[index]));
+            }
+
+            // Spatially compact, not larger than a quarter of the grid plus
+            // some slack for partitions that aren't powers of two
+            if (num_parts >= 4)
+            {
+                EXPECT_LE(bounds.size().x * bounds.size().y, 41.0f * 41.0f / 2.0f);
+            }
+        }
+
+        for (auto s : seen)
+        {
+            EXPECT_EQ(s, 1);
+        }
+    }
+
+    // No primitives
+    auto parts = remote::partition_primitives(triangles.begin(), triangles.begin(), 3);
+    ASSERT_EQ(parts.size(), size_t(3));
+
+    for (auto const& part : parts)
+    {
+        EXPECT_TRUE(part.empty());
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test binary swap compositing with several ranks in one process
+//
+
+TEST(Remote, BinarySwapCompositor)
+{
+    int width = 37;
+    int height = 23;
+
+    // Pseudo random depth per rank and pixel
+    auto make_depth = [](int rank, int i)
+    {
+        return static_cast<float>((i * 7919 + rank * 104729) % 1013) / 1013.0f;
+    };
+
+    unsigned short base_port = 31300;
+
+    for (int size : { 1, 2, 3, 4, 6 })
+    {
+        std::vector<vec4> result_color(width * height);
+        std::vector<float> result_depth(width * height);
+        std::vector<int> ok(size, 0);
+
+        auto rank_func = [&](int rank)
+        {
+            remote::communicator comm(rank, size, { "localhost" }, base_port);
+
+            if (!comm.connect(10.0))
+            {
+                return;
+            }
+
+            std::vector<vec4> color(width * height);
+            std::vector<float> depth(width * height);
+
+            for (int i = 0; i < width * height; ++i)
+            {
+                color[i] = vec4(static_cast<float>(rank));
+                depth[i] = make_depth(rank, i);
+            }
+
+            remote::binary_swap_compositor compositor(comm);
+
+            // Two frames, messages of the second must not mix with the first
+            for (int frame = 0; frame < 2; ++frame)
+            {
+                auto c = color;
+                auto d = depth;
+
+                if (!compositor.composite(c.data(), d.data(), width, height))
+                {
+                    return;
+                }
+
+                if (rank == 0)
+                {
+                    result_color = c;
+                    result_depth = d;
+                }
+            }
+
+            ok[rank] = 1;
+
+            // Keep the connections until all ranks are done
+            std::vector<char> done(1);
+
+            if (rank == 0)
+            {
+                for (int r = 1; r < size; ++r)
+                {
+                    comm.receive(r, 100, done, 10.0);
+                }
+
+                for (int r = 1; r < size; ++r)
+                {
+                    comm.send(r, 101, done);
+                }
+            }
+            else
+            {
+                comm.send(0, 100, done);
+                comm.receive(0, 101, done, 10.0);
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (int rank = 0; rank < size; ++rank)
+        {
+            threads.emplace_back(rank_func, rank);
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        for (int rank = 0; rank < size; ++rank)
+        {
+            EXPECT_EQ(ok[rank], 1) << "size " << size << ", rank " << rank;
+        }
+
+        for (int i = 0; i < width * height; ++i)
+        {
+            int closest = 0;
+
+            for (int rank = 1; rank < size; ++rank)
+            {
+                if (make_depth(rank, i) < make_depth(closest, i))
+                {
+                    closest = rank;
+                }
+            }
+
+            EXPECT_FLOAT_EQ(result_depth[i], make_depth(closest, i));
+            EXPECT_FLOAT_EQ(result_color[i].x, static_cast<float>(closest));
+        }
+
+        // Don't reuse ports that may still be in TIME_WAIT
+        base_port += 10;
+    }
+}
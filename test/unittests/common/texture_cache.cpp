@@ -0,0 +1,323 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/texture.h>
+
+#include <common/texture_cache.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+using texel_type = texture_cache::texel_type;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static std::vector<texel_type> make_image(int width, int height)
+{
+    std::vector<texel_type> result(width * height);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            result[y * width + x] = texel_type(
+                    unorm<8>((x % 256) / 255.0f),
+                    unorm<8>((y % 256) / 255.0f),
+                    unorm<8>(((x * 7 + y * 13) % 256) / 255.0f),
+                    unorm<8>(1.0f)
+                    );
+        }
+    }
+
+    return result;
+}
+
+static bool equal(texel_type const& a, texel_type const& b)
+{
+    return std::memcmp(&a, &b, sizeof(texel_type)) == 0;
+}
+
+// Removes the file when going out of scope
+struct temp_file
+{
+    temp_file()
+        : path((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string())
+    {
+    }
+
+   ~temp_file()
+    {
+        boost::filesystem::remove(path);
+    }
+
+    std::string path;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Test tiled texture files and mip levels
+//
+
+TEST(TextureCache, TiledFile)
+{
+    int width = 200;
+    int height = 150;
+    auto img = make_image(width, height);
+
+    temp_file file;
+    ASSERT_TRUE(make_tiled_texture_file(img.data(), width, height, file.path, 32));
+
+    // Tile size must match the cache's
+    texture_cache other(1 << 20, 64);
+    EXPECT_THROW(other.open(file.path), std::runtime_error);
+
+    texture_cache cache(1 << 20, 32);
+    int tex = cache.open(file.path);
+
+    // 200x150 .. 1x1
+    ASSERT_EQ(cache.num_levels(tex), 8U);
+    EXPECT_EQ(cache.size(tex, 1)[0], 100U);
+    EXPECT_EQ(cache.size(tex, 1)[1], 75U);
+    EXPECT_EQ(cache.size(tex, 7)[0], 1U);
+    EXPECT_EQ(cache.size(tex, 7)[1], 1U);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            ASSERT_TRUE(equal(cache.texel(tex, 0, x, y), img[y * width + x]));
+        }
+    }
+
+    // Box filtered
+    for (int y = 0; y < 75; ++y)
+    {
+        for (int x = 0; x < 100; ++x)
+        {
+            vec4 expected = (vec4(img[(y * 2) * width + x * 2])
+                           + vec4(img[(y * 2) * width + x * 2 + 1])
+                           + vec4(img[(y * 2 + 1) * width + x * 2])
+                           + vec4(img[(y * 2 + 1) * width + x * 2 + 1])) * 0.25f;
+
+            vec4 t(cache.texel(tex, 1, x, y));
+
+            for (int c = 0; c < 4; ++c)
+            {
+                EXPECT_NEAR(t[c], expected[c], 1.0f / 255.0f);
+            }
+        }
+    }
+
+    // Invalid files
+    EXPECT_THROW(cache.open(file.path + ".missing"), std::exception);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test LRU eviction and statistics
+//
+
+TEST(TextureCache, Eviction)
+{
+    int width = 128;
+    int height = 128;
+    auto img = make_image(width, height);
+
+    temp_file file;
+    ASSERT_TRUE(make_tiled_texture_file(img.data(), width, height, file.path, 32));
+
+    // Four tiles
+    texture_cache cache(4 * 32 * 32 * sizeof(texel_type), 32);
+    int tex = cache.open(file.path);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.capacity_tiles, 4U);
+    EXPECT_EQ(stats.resident_tiles, 0U);
+
+    // Touch tiles (0,0), (1,0), (2,0), (3,0)
+    for (int i = 0; i < 4; ++i)
+    {
+        cache.texel(tex, 0, i * 32, 0);
+    }
+
+    stats = cache.stats();
+    EXPECT_EQ(stats.misses, 4U);
+    EXPECT_EQ(stats.hits, 0U);
+    EXPECT_EQ(stats.evictions, 0U);
+    EXPECT_EQ(stats.resident_tiles, 4U);
+
+    // Hit tile (0,0), then load tile (0,1); (1,0) is the least recently used one
+    cache.texel(tex, 0, 5, 5);
+    cache.texel(tex, 0, 0, 32);
+
+    stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1U);
+    EXPECT_EQ(stats.misses, 5U);
+    EXPECT_EQ(stats.evictions, 1U);
+
+    cache.texel(tex, 0, 1, 1);
+    EXPECT_EQ(cache.stats().misses, 5U);
+
+    cache.texel(tex, 0, 32, 0);
+    EXPECT_EQ(cache.stats().misses, 6U);
+
+    // Sweep the whole texture, values stay correct while tiles are evicted
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            ASSERT_TRUE(equal(cache.texel(tex, 0, x, y), img[y * width + x]));
+        }
+    }
+
+    stats = cache.stats();
+    EXPECT_EQ(stats.resident_tiles, 4U);
+    EXPECT_GT(stats.evictions, 10U);
+    EXPECT_GT(stats.hit_rate(), 0.9);
+
+    cache.reset_stats();
+    stats = cache.stats();
+    EXPECT_EQ(stats.hits, 0U);
+    EXPECT_EQ(stats.misses, 0U);
+    EXPECT_EQ(stats.evictions, 0U);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that tex2D() on cached textures matches in-memory textures
+//
+
+TEST(TextureCache, Tex2D)
+{
+    int width = 100;
+    int height = 70;
+    auto img = make_image(width, height);
+
+    temp_file file;
+    ASSERT_TRUE(make_tiled_texture_file(img.data(), width, height, file.path, 16));
+
+    texture_cache cache(16 * 16 * 16 * sizeof(texel_type), 16);
+    int tex = cache.open(file.path);
+
+    cached_texture_ref cached = cache.ref(tex);
+    EXPECT_EQ(cached.width(), 100U);
+    EXPECT_EQ(cached.height(), 70U);
+
+    texture_ref<texel_type, 2> ref(width, height);
+    ref.reset(img.data());
+    ref.set_address_mode(Wrap);
+    ref.set_color_space(sRGB);
+
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(-0.5f, 1.5f);
+
+    tex_filter_mode modes[] = { Nearest, Linear, BSpline };
+
+    for (auto mode : modes)
+    {
+        cached.set_filter_mode(mode);
+        ref.set_filter_mode(mode);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            vec2 coord(dist(rng), dist(rng));
+
+            vec4 expected = tex2D(ref, coord);
+            vec4 value = tex2D(cached, coord);
+
+            for (int c = 0; c < 4; ++c)
+            {
+                ASSERT_FLOAT_EQ(value[c], expected[c]);
+            }
+        }
+
+        // SIMD coordinates
+        for (int i = 0; i < 100; ++i)
+        {
+            vector<2, simd::float4> coord(
+                    simd::float4(dist(rng), dist(rng), dist(rng), dist(rng)),
+                    simd::float4(dist(rng), dist(rng), dist(rng), dist(rng))
+                    );
+
+            auto expected = tex2D(ref, coord);
+            auto value = tex2D(cached, coord);
+
+            for (int c = 0; c < 4; ++c)
+            {
+                ASSERT_TRUE( all(value[c] == expected[c]) );
+            }
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test concurrent fetches through a cache that is much smaller than the texture
+//
+
+TEST(TextureCache, Concurrent)
+{
+    int width = 256;
+    int height = 256;
+    auto img = make_image(width, height);
+
+    temp_file file;
+    ASSERT_TRUE(make_tiled_texture_file(img.data(), width, height, file.path, 16));
+
+    texture_cache cache(8 * 16 * 16 * sizeof(texel_type), 16);
+    int tex = cache.open(file.path);
+
+    int num_threads = 8;
+    std::vector<int> errors(num_threads, 0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            std::default_random_engine rng(t);
+            std::uniform_int_distribution<int> dist(0, 255);
+
+            for (int i = 0; i < 100000; ++i)
+            {
+                int x = dist(rng);
+                int y = dist(rng);
+
+                if (!equal(cache.texel(tex, 0, x, y), img[y * width + x]))
+                {
+                    ++errors[t];
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        EXPECT_EQ(errors[t], 0);
+    }
+
+    auto stats = cache.stats();
+    // Fetches that raced with a concurrent load of the same tile count as hits
+    EXPECT_GE(stats.hits + stats.misses, uint64_t(num_threads) * 100000);
+    EXPECT_LE(stats.hits, uint64_t(num_threads) * 100000);
+    EXPECT_LE(stats.resident_tiles, 8U);
+}
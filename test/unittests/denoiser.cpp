@@ -0,0 +1,149 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <random>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/denoiser.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+struct test_image
+{
+    test_image(int w, int h)
+        : width(w)
+        , height(h)
+        , color(w * h)
+        , albedo(w * h, vec4(1.0f))
+        , normal_depth(w * h, vec4(0.0f, 0.0f, 1.0f, 1.0f))
+    {
+    }
+
+    int width;
+    int height;
+    std::vector<vec4> color;
+    std::vector<vec4> albedo;
+    std::vector<vec4> normal_depth;
+};
+
+static float mse(std::vector<vec4> const& a, std::vector<vec4> const& b)
+{
+    double sum = 0.0;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        vec3 d = a[i].xyz() - b[i].xyz();
+        sum += dot(d, d) / 3.0;
+    }
+
+    return static_cast<float>(sum / a.size());
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test atrous_denoiser
+//
+
+TEST(Denoiser, ReducesNoise)
+{
+    // Odd width so that both the SIMD and the scalar path are used
+    test_image img(61, 47);
+
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    // Constant illumination of 1, albedo 0.5, noisy
+    std::vector<vec4> reference(img.color.size(), vec4(0.5f, 0.5f, 0.5f, 1.0f));
+
+    for (size_t i = 0; i < img.color.size(); ++i)
+    {
+        float e = 0.5f + dist(rng);
+        img.albedo[i] = vec4(0.5f, 0.5f, 0.5f, 1.0f);
+        img.color[i] = vec4(vec3(0.5f * e), 1.0f);
+    }
+
+    std::vector<vec4> result(img.color.size());
+
+    atrous_denoiser denoiser(2);
+    denoiser.filter(result.data(), img.color.data(), img.albedo.data(), img.normal_depth.data(), img.width, img.height);
+
+    EXPECT_LT(mse(result, reference), mse(img.color, reference) * 0.1f);
+
+    // Alpha is passed through
+    for (auto const& c : result)
+    {
+        EXPECT_FLOAT_EQ(c.w, 1.0f);
+    }
+}
+
+TEST(Denoiser, PreservesEdges)
+{
+    test_image img(64, 16);
+
+    // Left: white, facing the camera; right: black, facing sideways
+    for (int y = 0; y < img.height; ++y)
+    {
+        for (int x = 0; x < img.width; ++x)
+        {
+            int i = y * img.width + x;
+            bool left = x < img.width / 2;
+            img.color[i] = left ? vec4(1.0f) : vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            img.normal_depth[i] = left ? vec4(0.0f, 0.0f, 1.0f, 1.0f) : vec4(1.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+
+    // Filter in place
+    std::vector<vec4> result(img.color);
+
+    atrous_denoiser denoiser(2);
+    denoiser.set_sigma_color(1e3f); // rely on the normals only
+    denoiser.filter(result.data(), result.data(), img.albedo.data(), img.normal_depth.data(), img.width, img.height);
+
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        EXPECT_NEAR(result[i].x, img.color[i].x, 0.01f);
+    }
+}
+
+TEST(Denoiser, Background)
+{
+    test_image img(32, 32);
+
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    // Top half without hits (depth 0) is not filtered
+    for (int y = 0; y < img.height; ++y)
+    {
+        for (int x = 0; x < img.width; ++x)
+        {
+            int i = y * img.width + x;
+            img.color[i] = vec4(dist(rng), dist(rng), dist(rng), 1.0f);
+
+            if (y < img.height / 2)
+            {
+                img.normal_depth[i] = vec4(0.0f);
+            }
+        }
+    }
+
+    std::vector<vec4> result(img.color.size());
+
+    atrous_denoiser denoiser(2);
+    denoiser.filter(result.data(), img.color.data(), img.albedo.data(), img.normal_depth.data(), img.width, img.height);
+
+    for (int i = 0; i < img.width * img.height / 2; ++i)
+    {
+        EXPECT_FLOAT_EQ(result[i].x, img.color[i].x);
+        EXPECT_FLOAT_EQ(result[i].y, img.color[i].y);
+        EXPECT_FLOAT_EQ(result[i].z, img.color[i].z);
+    }
+}
@@ -5,10 +5,17 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <iterator>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 #include <visionaray/detail/parallel_algorithm.h>
+#include <visionaray/detail/thread_pool.h>
 
 #include <gtest/gtest.h>
 
@@ -114,3 +121,256 @@ TEST(ParallelAlgorithm, CountingSort)
 }
 
 #endif // VSNRAY_HAVE_TBB
+
+
+//-------------------------------------------------------------------------------------------------
+// Test exclusive_scan() and inclusive_scan()
+//
+
+TEST(ParallelAlgorithm, Scan)
+{
+    thread_pool pool(4);
+
+    // Sizes around the block size, so that both the serial and the parallel path are tested
+    for (size_t n : { size_t(0), size_t(1), size_t(17), size_t(100000), size_t(1000003) })
+    {
+        std::vector<unsigned> a(n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = rand() % 100;
+        }
+
+        std::vector<unsigned> ref(n);
+        std::vector<unsigned> b(n);
+
+        // Exclusive
+        unsigned sum = 7;
+        for (size_t i = 0; i < n; ++i)
+        {
+            ref[i] = sum;
+            sum += a[i];
+        }
+
+        auto end = paralgo::exclusive_scan(pool, a.begin(), a.end(), b.begin(), 7U);
+        EXPECT_TRUE(end == b.end());
+        EXPECT_TRUE(b == ref);
+
+        // Inclusive
+        std::partial_sum(a.begin(), a.end(), ref.begin());
+
+        end = paralgo::inclusive_scan(pool, a.begin(), a.end(), b.begin());
+        EXPECT_TRUE(end == b.end());
+        EXPECT_TRUE(b == ref);
+
+        // In-place, non-commutative operation
+        std::vector<unsigned> c(a);
+        auto op = [](unsigned x, unsigned y) { return std::max(x, y); };
+        std::partial_sum(a.begin(), a.end(), ref.begin(), op);
+
+        paralgo::inclusive_scan(pool, c.begin(), c.end(), c.begin(), op);
+        EXPECT_TRUE(c == ref);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test copy_if() and stable_partition()
+//
+
+TEST(ParallelAlgorithm, Compaction)
+{
+    thread_pool pool(4);
+
+    for (size_t n : { size_t(0), size_t(1), size_t(1000), size_t(1000003) })
+    {
+        std::vector<std::pair<int, size_t>> a(n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = { rand() % 10, i };
+        }
+
+        auto pred = [](std::pair<int, size_t> const& p) { return p.first < 3; };
+
+        // copy_if
+        std::vector<std::pair<int, size_t>> ref;
+        std::copy_if(a.begin(), a.end(), std::back_inserter(ref), pred);
+
+        std::vector<std::pair<int, size_t>> b(n);
+        auto end = paralgo::copy_if(pool, a.begin(), a.end(), b.begin(), pred);
+        b.erase(end, b.end());
+        EXPECT_TRUE(b == ref);
+
+        // stable_partition
+        ref = a;
+        auto ref_mid = std::stable_partition(ref.begin(), ref.end(), pred);
+
+        auto mid = paralgo::stable_partition(pool, a.begin(), a.end(), pred);
+        EXPECT_EQ(mid - a.begin(), ref_mid - ref.begin());
+        EXPECT_TRUE(a == ref);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test counting_sort() with thread_pool
+//
+
+TEST(ParallelAlgorithm, CountingSortThreadPool)
+{
+    thread_pool pool(4);
+
+    static const size_t N = 1000003;
+    static const size_t K = 256;
+
+    std::vector<std::pair<int, size_t>> a(N);
+    std::vector<std::pair<int, size_t>> b(N);
+    std::array<int, K> counts;
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        a[i] = { rand() % K, i };
+    }
+
+    paralgo::counting_sort(
+            pool,
+            a.begin(),
+            a.end(),
+            b.begin(),
+            counts,
+            [](std::pair<int, size_t> const& p) { return p.first; }
+            );
+
+    std::stable_sort(
+            a.begin(),
+            a.end(),
+            [](std::pair<int, size_t> const& p, std::pair<int, size_t> const& q) { return p.first < q.first; }
+            );
+    EXPECT_TRUE(a == b);
+
+    // End offsets
+    for (size_t m = 0; m < K; ++m)
+    {
+        auto it = std::upper_bound(
+                a.begin(),
+                a.end(),
+                static_cast<int>(m),
+                [](int key, std::pair<int, size_t> const& p) { return key < p.first; }
+                );
+        EXPECT_EQ(counts[m], it - a.begin());
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test radix_sort() and radix_sort_by_key()
+//
+
+template <typename T>
+static void test_radix_sort(thread_pool& pool, std::vector<T> a)
+{
+    std::vector<T> ref(a);
+    std::sort(ref.begin(), ref.end());
+
+    paralgo::radix_sort(pool, a.begin(), a.end());
+    EXPECT_TRUE(a == ref);
+}
+
+TEST(ParallelAlgorithm, RadixSort)
+{
+    thread_pool pool(4);
+
+    for (size_t n : { size_t(0), size_t(1), size_t(1000), size_t(1000003) })
+    {
+        std::vector<uint32_t> u32(n);
+        std::vector<uint64_t> u64(n);
+        std::vector<int> i32(n);
+        std::vector<float> f32(n);
+        std::vector<double> f64(n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            u32[i] = (uint32_t(rand()) << 16) ^ uint32_t(rand());
+            u64[i] = (uint64_t(u32[i]) << 32) ^ uint64_t(rand());
+            i32[i] = rand() - RAND_MAX / 2;
+            f32[i] = (rand() / static_cast<float>(RAND_MAX) - 0.5f) * 1000.0f;
+            f64[i] = (rand() / static_cast<double>(RAND_MAX) - 0.5) * 1e10;
+        }
+
+        test_radix_sort(pool, u32);
+        test_radix_sort(pool, u64);
+        test_radix_sort(pool, i32);
+        test_radix_sort(pool, f32);
+        test_radix_sort(pool, f64);
+
+        // Morton codes: only the lower 30 bits are set, the upper pass is skipped
+        for (auto& k : u32)
+        {
+            k &= 0x3FFFFFFF;
+        }
+
+        test_radix_sort(pool, u32);
+    }
+
+    // Signed zeros and infinities
+    test_radix_sort(pool, std::vector<float>{ 1.0f, -0.5f, 0.0f, -1e30f, 3.0f, -INFINITY, INFINITY, -2.0f });
+
+    // All keys equal, no pass at all
+    test_radix_sort(pool, std::vector<uint32_t>(100000, 42));
+}
+
+TEST(ParallelAlgorithm, RadixSortStable)
+{
+    thread_pool pool(4);
+
+    static const size_t N = 1000003;
+
+    // Few distinct keys, the original position is the payload
+    std::vector<uint32_t> keys(N);
+    std::vector<size_t> values(N);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        keys[i] = (rand() % 16) << 20;
+        values[i] = i;
+    }
+
+    std::vector<std::pair<uint32_t, size_t>> ref(N);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        ref[i] = { keys[i], values[i] };
+    }
+
+    std::stable_sort(
+            ref.begin(),
+            ref.end(),
+            [](std::pair<uint32_t, size_t> const& a, std::pair<uint32_t, size_t> const& b) { return a.first < b.first; }
+            );
+
+    // Items with a key function
+    std::vector<std::pair<uint32_t, size_t>> items(N);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        items[i] = { keys[i], values[i] };
+    }
+
+    paralgo::radix_sort(
+            pool,
+            items.begin(),
+            items.end(),
+            [](std::pair<uint32_t, size_t> const& p) { return p.first; }
+            );
+    EXPECT_TRUE(items == ref);
+
+    // Keys and values
+    paralgo::radix_sort_by_key(pool, keys.begin(), keys.end(), values.begin());
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        ASSERT_EQ(keys[i], ref[i].first);
+        ASSERT_EQ(values[i], ref[i].second);
+    }
+}
@@ -0,0 +1,77 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <atomic>
+#include <vector>
+
+#include <visionaray/detail/thread_pool.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that each work item is processed exactly once, over many consecutive runs
+//
+
+TEST(ThreadPool, RepeatedRuns)
+{
+    thread_pool pool(4);
+
+    std::vector<std::atomic<int>> counts(1000);
+
+    for (int run = 0; run < 1000; ++run)
+    {
+        long n = 1 + run % 1000;
+
+        for (long i = 0; i < n; ++i)
+        {
+            counts[i] = 0;
+        }
+
+        pool.run([&](unsigned i) { ++counts[i]; }, n);
+
+        for (long i = 0; i < n; ++i)
+        {
+            ASSERT_EQ(counts[i], 1);
+        }
+    }
+
+    // Empty queue returns immediately
+    pool.run([&](unsigned i) { ++counts[i]; }, 0);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that short-lived pools don't deadlock on construction or destruction
+//
+
+TEST(ThreadPool, CreateDestroy)
+{
+    for (int i = 0; i < 500; ++i)
+    {
+        thread_pool pool(4);
+
+        std::atomic<int> sum(0);
+        pool.run([&](unsigned j) { sum += static_cast<int>(j); }, 16);
+        EXPECT_EQ(sum, 120);
+    }
+
+    // Pool that is never used
+    for (int i = 0; i < 500; ++i)
+    {
+        thread_pool pool(4);
+    }
+
+    // Reset between runs
+    thread_pool pool(2);
+    for (unsigned n = 1; n <= 8; ++n)
+    {
+        pool.reset(n);
+
+        std::atomic<int> count(0);
+        pool.run([&](unsigned) { ++count; }, 100);
+        EXPECT_EQ(count, 100);
+    }
+}
@@ -0,0 +1,139 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <visionaray/cpu_features.h>
+#include <visionaray/isa_dispatch.h>
+
+#include <gtest/gtest.h>
+
+#include "isa_dispatch/shared_helper.h"
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static int impl_sse2(int i)   { return i + VSNRAY_SIMD_ISA_SSE2; }
+static int impl_sse4_1(int i) { return i + VSNRAY_SIMD_ISA_SSE4_1; }
+static int impl_avx2(int i)   { return i + VSNRAY_SIMD_ISA_AVX2; }
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that the host supports at least the ISA the tests were compiled for
+//
+
+TEST(ISADispatch, HostISA)
+{
+    int isa = host_simd_isa();
+
+    EXPECT_GE(isa, VSNRAY_SIMD_ISA_);
+    EXPECT_TRUE(host_supports_simd_isa(0));
+    EXPECT_TRUE(host_supports_simd_isa(VSNRAY_SIMD_ISA_));
+    EXPECT_TRUE(host_supports_simd_isa(isa));
+    EXPECT_STRNE(simd_isa_name(isa), "unknown");
+
+#if VSNRAY_BASE_ARCH == VSNRAY_BASE_ARCH_X86
+    // No ARM ISA on x86 hosts, and vice versa
+    EXPECT_FALSE(host_supports_simd_isa(VSNRAY_SIMD_ISA_NEON));
+#endif
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test selection of per-ISA implementations
+//
+
+TEST(ISADispatch, Select)
+{
+    isa_dispatcher<int(int)> dispatcher;
+
+    // Nothing registered
+    EXPECT_FALSE(dispatcher.select());
+    EXPECT_FALSE(dispatcher.valid());
+    EXPECT_EQ(dispatcher.selected_isa(), -1);
+
+    // Registration order doesn't matter
+    dispatcher.add(VSNRAY_SIMD_ISA_SSE4_1, impl_sse4_1);
+    dispatcher.add(VSNRAY_SIMD_ISA_SSE2, impl_sse2);
+    dispatcher.add(VSNRAY_SIMD_ISA_AVX2, impl_avx2);
+
+#if VSNRAY_BASE_ARCH == VSNRAY_BASE_ARCH_X86
+    // Widest implementation the host supports
+    ASSERT_TRUE(dispatcher.select());
+    int expected = host_supports_simd_isa(VSNRAY_SIMD_ISA_AVX2)   ? VSNRAY_SIMD_ISA_AVX2
+                 : host_supports_simd_isa(VSNRAY_SIMD_ISA_SSE4_1) ? VSNRAY_SIMD_ISA_SSE4_1
+                                                                  : VSNRAY_SIMD_ISA_SSE2;
+    EXPECT_EQ(dispatcher.selected_isa(), expected);
+    EXPECT_EQ(dispatcher(1), 1 + expected);
+
+    // Upper bound, e.g. to compare implementations
+    ASSERT_TRUE(dispatcher.select(VSNRAY_SIMD_ISA_SSE4_2));
+    EXPECT_EQ(dispatcher.selected_isa(), host_supports_simd_isa(VSNRAY_SIMD_ISA_SSE4_1)
+            ? VSNRAY_SIMD_ISA_SSE4_1 : VSNRAY_SIMD_ISA_SSE2);
+
+    ASSERT_TRUE(dispatcher.select(VSNRAY_SIMD_ISA_SSE2));
+    EXPECT_EQ(dispatcher.selected_isa(), VSNRAY_SIMD_ISA_SSE2);
+    EXPECT_EQ(dispatcher(1), 1 + VSNRAY_SIMD_ISA_SSE2);
+
+    EXPECT_FALSE(dispatcher.select(VSNRAY_SIMD_ISA_SSE));
+    EXPECT_FALSE(dispatcher.valid());
+#endif
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that inline functions compiled for several ISAs are not merged by the linker
+//
+
+TEST(ISADispatch, SharedInlineFunction)
+{
+    struct
+    {
+        int isa;
+        shared_helper_func (*helper)();
+    } impls[] = {
+#ifdef VSNRAY_DISPATCH_SSE2
+        { VSNRAY_SIMD_ISA_SSE2,     shared_helper_sse2      },
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_1
+        { VSNRAY_SIMD_ISA_SSE4_1,   shared_helper_sse4_1    },
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_2
+        { VSNRAY_SIMD_ISA_SSE4_2,   shared_helper_sse4_2    },
+#endif
+#ifdef VSNRAY_DISPATCH_AVX
+        { VSNRAY_SIMD_ISA_AVX,      shared_helper_avx       },
+#endif
+#ifdef VSNRAY_DISPATCH_AVX2
+        { VSNRAY_SIMD_ISA_AVX2,     shared_helper_avx2      },
+#endif
+#ifdef VSNRAY_DISPATCH_AVX512F
+        { VSNRAY_SIMD_ISA_AVX512F,  shared_helper_avx512f   },
+#endif
+        { -1, nullptr }
+        };
+
+    // Called through a pointer, so that the out-of-line definition is used
+    shared_helper_func baseline = &compiled_simd_isa;
+    EXPECT_EQ(baseline(), VSNRAY_SIMD_ISA_);
+
+    for (auto const& impl : impls)
+    {
+        if (impl.helper == nullptr)
+        {
+            continue;
+        }
+
+        shared_helper_func func = impl.helper();
+
+        // Each translation unit keeps its own definition
+        EXPECT_NE(func, baseline);
+
+        if (host_supports_simd_isa(impl.isa))
+        {
+            EXPECT_EQ(func(), impl.isa);
+        }
+    }
+}
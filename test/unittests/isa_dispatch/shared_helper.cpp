@@ -0,0 +1,16 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+// Compiled once per ISA, see visionaray/isa_dispatch.h
+
+#include <visionaray/isa_dispatch.h>
+
+#include "shared_helper.h"
+
+using namespace visionaray;
+
+shared_helper_func VSNRAY_ISA_FUNCTION(shared_helper)()
+{
+    // Taking the address makes the compiler emit an out-of-line definition
+    return &compiled_simd_isa;
+}
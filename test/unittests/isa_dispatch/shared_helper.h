@@ -0,0 +1,35 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#pragma once
+
+#ifndef VSNRAY_UNITTESTS_ISA_DISPATCH_SHARED_HELPER_H
+#define VSNRAY_UNITTESTS_ISA_DISPATCH_SHARED_HELPER_H 1
+
+//-------------------------------------------------------------------------------------------------
+// Address of visionaray::compiled_simd_isa() in the per-ISA translation units
+// (shared_helper.cpp)
+//
+
+using shared_helper_func = int (*)();
+
+#ifdef VSNRAY_DISPATCH_SSE2
+shared_helper_func shared_helper_sse2();
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_1
+shared_helper_func shared_helper_sse4_1();
+#endif
+#ifdef VSNRAY_DISPATCH_SSE4_2
+shared_helper_func shared_helper_sse4_2();
+#endif
+#ifdef VSNRAY_DISPATCH_AVX
+shared_helper_func shared_helper_avx();
+#endif
+#ifdef VSNRAY_DISPATCH_AVX2
+shared_helper_func shared_helper_avx2();
+#endif
+#ifdef VSNRAY_DISPATCH_AVX512F
+shared_helper_func shared_helper_avx512f();
+#endif
+
+#endif // VSNRAY_UNITTESTS_ISA_DISPATCH_SHARED_HELPER_H
@@ -0,0 +1,285 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <random>
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+#include <visionaray/get_normal.h>
+#include <visionaray/intersector.h>
+#include <visionaray/traverse.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+using curve_t = basic_curve<float>;
+using oriented_curve_t = basic_oriented_curve<float>;
+
+// Random curly hairs growing from the xy plane, along z
+static aligned_vector<curve_t> make_hairs(int n)
+{
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    aligned_vector<curve_t> result;
+
+    for (int i = 0; i < n; ++i)
+    {
+        vec3 root(dist(rng), dist(rng), 0.0f);
+        vec3 bend(dist(rng) * 0.2f, dist(rng) * 0.2f, 0.0f);
+
+        curve_t c(
+                root,
+                root + vec3(0.0f, 0.0f, 0.3f) + bend,
+                root + vec3(0.0f, 0.0f, 0.6f) - bend,
+                root + vec3(0.0f, 0.0f, 1.0f) + bend,
+                0.01f
+                );
+        c.prim_id = i;
+        c.geom_id = 0;
+        result.push_back(c);
+    }
+
+    return result;
+}
+
+static basic_ray<float> make_ray(vec3 const& ori, vec3 const& dir)
+{
+    basic_ray<float> ray(ori, dir);
+    ray.tmin = 0.0f;
+    ray.tmax = numeric_limits<float>::max();
+    return ray;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test bounds, B-spline conversion and subdivision
+//
+
+TEST(Curve, Geometry)
+{
+    curve_t curve(vec3(0.0f), vec3(1.0f, 2.0f, 0.0f), vec3(2.0f, -2.0f, 1.0f), vec3(3.0f, 0.0f, 0.0f), 0.1f);
+
+    // Bounds are tight and contain the curve
+    auto bounds = get_bounds(curve);
+
+    aabb sampled;
+    sampled.invalidate();
+
+    for (int i = 0; i <= 1000; ++i)
+    {
+        vec3 p = curve.f(i / 1000.0f);
+        sampled.insert(p);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            EXPECT_GE(p[j], bounds.min[j] + 0.1f - 1e-5f);
+            EXPECT_LE(p[j], bounds.max[j] - 0.1f + 1e-5f);
+        }
+    }
+
+    for (int j = 0; j < 3; ++j)
+    {
+        EXPECT_NEAR(sampled.min[j], bounds.min[j] + 0.1f, 1e-4f);
+        EXPECT_NEAR(sampled.max[j], bounds.max[j] - 0.1f, 1e-4f);
+    }
+
+    // Subdivision
+    curve_t left;
+    curve_t right;
+    subdivide(curve, 0.25f, left, right);
+
+    for (int i = 0; i <= 10; ++i)
+    {
+        float t = i / 10.0f;
+        vec3 l = left.f(t);
+        vec3 r = right.f(t);
+        vec3 l_expected = curve.f(t * 0.25f);
+        vec3 r_expected = curve.f(0.25f + t * 0.75f);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(l[j], l_expected[j], 1e-5f);
+            EXPECT_NEAR(r[j], r_expected[j], 1e-5f);
+        }
+    }
+
+    // Uniform cubic B-spline
+    vec3 p0(0.0f);
+    vec3 p1(1.0f, 1.0f, 0.0f);
+    vec3 p2(2.0f, -1.0f, 0.5f);
+    vec3 p3(3.0f, 0.0f, 0.0f);
+
+    auto bspline = make_bspline_curve(p0, p1, p2, p3, 0.1f);
+
+    for (int i = 0; i <= 10; ++i)
+    {
+        float t = i / 10.0f;
+        float s = 1.0f - t;
+
+        vec3 expected = (s * s * s * p0
+                      + (3.0f * t * t * t - 6.0f * t * t + 4.0f) * p1
+                      + (-3.0f * t * t * t + 3.0f * t * t + 3.0f * t + 1.0f) * p2
+                      + t * t * t * p3) / 6.0f;
+
+        vec3 p = bspline.f(t);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            EXPECT_NEAR(p[j], expected[j], 1e-5f);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test ray / curve intersection
+//
+
+TEST(Curve, Intersect)
+{
+    // Straight curve along x
+    curve_t curve(vec3(0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(2.0f, 0.0f, 0.0f), vec3(3.0f, 0.0f, 0.0f), 0.1f);
+    curve.prim_id = 5;
+    curve.geom_id = 2;
+
+    // Round
+    auto hr = intersect(make_ray(vec3(1.5f, 0.0f, 2.0f), vec3(0.0f, 0.0f, -1.0f)), curve);
+    EXPECT_TRUE(hr.hit);
+    EXPECT_EQ(hr.prim_id, 5U);
+    EXPECT_EQ(hr.geom_id, 2U);
+    EXPECT_NEAR(hr.t, 1.9f, 1e-5f);
+    EXPECT_NEAR(hr.u, 0.5f, 1e-5f);
+    EXPECT_NEAR(hr.v, 0.0f, 1e-5f);
+
+    hr.isect_pos = vec3(1.5f, 0.0f, 2.0f) + vec3(0.0f, 0.0f, -1.0f) * hr.t;
+    vec3 n = get_normal(hr, curve);
+    EXPECT_NEAR(n.z, 1.0f, 1e-5f);
+
+    // Off center
+    hr = intersect(make_ray(vec3(1.5f, 0.05f, 2.0f), vec3(0.0f, 0.0f, -1.0f)), curve);
+    EXPECT_TRUE(hr.hit);
+    EXPECT_NEAR(hr.t, 2.0f - std::sqrt(0.1f * 0.1f - 0.05f * 0.05f), 1e-5f);
+    EXPECT_NEAR(std::abs(hr.v), 0.5f, 1e-5f);
+
+    // Ribbon, hit at the center line's depth
+    hr = intersect_ribbon(make_ray(vec3(1.5f, 0.05f, 2.0f), vec3(0.0f, 0.0f, -1.0f)), curve);
+    EXPECT_TRUE(hr.hit);
+    EXPECT_NEAR(hr.t, 2.0f, 1e-5f);
+
+    // Non-normalized direction
+    hr = intersect(make_ray(vec3(1.5f, 0.0f, 2.0f), vec3(0.0f, 0.0f, -2.0f)), curve);
+    EXPECT_TRUE(hr.hit);
+    EXPECT_NEAR(hr.t, 0.95f, 1e-5f);
+
+    // Misses: beside the curve, beyond the end, behind the ray, and with tmax
+    EXPECT_FALSE(intersect(make_ray(vec3(1.5f, 0.2f, 2.0f), vec3(0.0f, 0.0f, -1.0f)), curve).hit);
+    EXPECT_FALSE(intersect(make_ray(vec3(3.2f, 0.0f, 2.0f), vec3(0.0f, 0.0f, -1.0f)), curve).hit);
+    EXPECT_FALSE(intersect(make_ray(vec3(1.5f, 0.0f, 2.0f), vec3(0.0f, 0.0f, 1.0f)), curve).hit);
+
+    auto ray = make_ray(vec3(1.5f, 0.0f, 2.0f), vec3(0.0f, 0.0f, -1.0f));
+    ray.tmax = 1.0f;
+    EXPECT_FALSE(intersect(ray, curve).hit);
+
+    // The oriented bounding box doesn't change the result
+    oriented_curve_t oriented(curve);
+    hr = intersect(make_ray(vec3(1.5f, 0.05f, 2.0f), vec3(0.0f, 0.0f, -1.0f)), oriented);
+    EXPECT_TRUE(hr.hit);
+    EXPECT_NEAR(hr.t, 2.0f - std::sqrt(0.1f * 0.1f - 0.05f * 0.05f), 1e-5f);
+    EXPECT_FALSE(intersect(make_ray(vec3(1.5f, 0.2f, 2.0f), vec3(0.0f, 0.0f, -1.0f)), oriented).hit);
+
+    // SIMD rays, lanes over rays instead of segments
+    vector<3, simd::float4> ori(
+            simd::float4(1.5f, 1.5f, 1.5f, 3.2f),
+            simd::float4(0.0f, 0.05f, 0.2f, 0.0f),
+            simd::float4(2.0f)
+            );
+    basic_ray<simd::float4> ray4(ori, vector<3, simd::float4>(0.0f, 0.0f, -1.0f));
+    ray4.tmin = 0.0f;
+    ray4.tmax = numeric_limits<float>::max();
+
+    auto hr4 = intersect(ray4, curve);
+    EXPECT_TRUE(all(hr4.hit == simd::mask4(true, true, false, false)));
+
+    auto hrs = simd::unpack(hr4);
+    EXPECT_NEAR(hrs[0].t, 1.9f, 1e-5f);
+    EXPECT_NEAR(hrs[1].t, 2.0f - std::sqrt(0.1f * 0.1f - 0.05f * 0.05f), 1e-5f);
+    EXPECT_NEAR(hrs[0].u, 0.5f, 1e-5f);
+
+    hr4 = intersect_ribbon(ray4, oriented);
+    EXPECT_TRUE(all(hr4.hit == simd::mask4(true, true, false, false)));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that BVHs over curves find the same hits as linear traversal
+//
+
+TEST(Curve, BVH)
+{
+    auto curves = make_hairs(500);
+
+    aligned_vector<oriented_curve_t> oriented;
+    for (auto const& c : curves)
+    {
+        oriented.emplace_back(c);
+    }
+
+    binned_sah_builder builder;
+    builder.enable_spatial_splits(true);
+
+    auto bvh = builder.build(index_bvh<curve_t>{}, curves.data(), curves.size());
+    auto oriented_bvh = builder.build(index_bvh<oriented_curve_t>{}, oriented.data(), oriented.size());
+
+    auto r1 = bvh.ref();
+    auto r2 = oriented_bvh.ref();
+
+    std::default_random_engine rng(1);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    int num_hits = 0;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        // Oblique rays from the side
+        auto ray = make_ray(
+                vec3(dist(rng), -3.0f, 0.5f + dist(rng) * 0.5f),
+                normalize(vec3(dist(rng) * 0.1f, 1.0f, dist(rng) * 0.1f))
+                );
+
+        auto ref = closest_hit(ray, curves.data(), curves.data() + curves.size());
+        auto hr1 = closest_hit(ray, &r1, &r1 + 1);
+        auto hr2 = closest_hit(ray, &r2, &r2 + 1);
+
+        ribbon_curve_intersector ribbon_isect;
+        auto ref_ribbon = closest_hit(ray, curves.data(), curves.data() + curves.size(), ribbon_isect);
+        auto hr_ribbon = closest_hit(ray, &r2, &r2 + 1, ribbon_isect);
+
+        ASSERT_EQ(hr1.hit, ref.hit);
+        ASSERT_EQ(hr2.hit, ref.hit);
+        ASSERT_EQ(hr_ribbon.hit, ref_ribbon.hit);
+
+        if (ref.hit)
+        {
+            EXPECT_FLOAT_EQ(hr1.t, ref.t);
+            EXPECT_FLOAT_EQ(hr2.t, ref.t);
+            EXPECT_EQ(hr1.prim_id, ref.prim_id);
+            ++num_hits;
+        }
+
+        if (ref_ribbon.hit)
+        {
+            EXPECT_FLOAT_EQ(hr_ribbon.t, ref_ribbon.t);
+            EXPECT_GE(hr_ribbon.t, ref.t);
+        }
+    }
+
+    EXPECT_GT(num_hits, 100);
+}
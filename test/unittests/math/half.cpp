@@ -0,0 +1,87 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <visionaray/math/half.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// half is POD!
+//
+
+static_assert(std::is_pod<half>::value, "Not POD!");
+static_assert(sizeof(half) == 2, "Wrong size!");
+
+
+//-------------------------------------------------------------------------------------------------
+// Test float <-> half conversion
+//
+
+TEST(Half, Conversion)
+{
+    // Exactly representable values
+    float exact[] = { 0.0f, 1.0f, -1.0f, 0.5f, 2.0f, 1024.0f, 65504.0f, 0.099975586f, -3.140625f };
+
+    for (float f : exact)
+    {
+        EXPECT_FLOAT_EQ(float(half(f)), f);
+    }
+
+    // Bit patterns
+    EXPECT_EQ(half(1.0f).value, 0x3C00);
+    EXPECT_EQ(half(-2.0f).value, 0xC000);
+    EXPECT_EQ(half(65504.0f).value, 0x7BFF);
+    EXPECT_EQ(half(-0.0f).value, 0x8000);
+
+    // Smallest denormal and smallest normal
+    EXPECT_EQ(half(std::ldexp(1.0f, -24)).value, 0x0001);
+    EXPECT_EQ(half(std::ldexp(1.0f, -14)).value, 0x0400);
+    EXPECT_FLOAT_EQ(float(half(std::ldexp(3.0f, -24))), std::ldexp(3.0f, -24));
+
+    // Overflow and underflow
+    EXPECT_EQ(half(1e6f).value, 0x7C00);
+    EXPECT_EQ(half(-1e6f).value, 0xFC00);
+    EXPECT_EQ(half(1e-10f).value, 0x0000);
+
+    // Inf and NaN
+    EXPECT_TRUE(std::isinf(float(half(std::numeric_limits<float>::infinity()))));
+    EXPECT_TRUE(std::isnan(float(half(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(Half, Rounding)
+{
+    // Relative error of normal numbers is at most 2^-11
+    for (float f = 1e-4f; f < 6e4f; f *= 1.01f)
+    {
+        EXPECT_LE(std::abs(float(half(f)) - f), f * std::ldexp(1.0f, -11));
+    }
+
+    // Ties round to even: 1 + 2^-11 lies between 1 and 1 + 2^-10
+    EXPECT_EQ(half(1.0f + std::ldexp(1.0f, -11)).value, 0x3C00);
+    EXPECT_EQ(half(1.0f + 3.0f * std::ldexp(1.0f, -11)).value, 0x3C02);
+
+    // Rounding up into the next binade
+    EXPECT_EQ(half(2.0f - std::ldexp(1.0f, -12)).value, 0x4000);
+
+    // All half values round trip
+    for (uint32_t i = 0; i < 0x10000; ++i)
+    {
+        half h;
+        h.value = static_cast<uint16_t>(i);
+
+        float f = h;
+
+        if (!std::isnan(f))
+        {
+            EXPECT_EQ(half(f).value, h.value);
+        }
+    }
+}
@@ -0,0 +1,269 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <random>
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+#include <visionaray/get_normal.h>
+#include <visionaray/get_shading_normal.h>
+#include <visionaray/get_tex_coord.h>
+#include <visionaray/intersector.h>
+#include <visionaray/traverse.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+using triangle_t = basic_triangle<3, float>;
+using indexed_triangle_t = basic_indexed_triangle<float>;
+
+// Height field over [0..1]^2 with n x n quads, two triangles per quad
+struct grid_mesh
+{
+    aligned_vector<vec3> vertices;
+    aligned_vector<vec2> tex_coords;
+    aligned_vector<indexed_triangle_t> triangles;
+};
+
+static grid_mesh make_grid_mesh(int n)
+{
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(-0.05f, 0.05f);
+
+    grid_mesh mesh;
+
+    for (int y = 0; y <= n; ++y)
+    {
+        for (int x = 0; x <= n; ++x)
+        {
+            vec2 tc(x / float(n), y / float(n));
+            mesh.vertices.emplace_back(tc.x, tc.y, dist(rng));
+            mesh.tex_coords.push_back(tc);
+        }
+    }
+
+    for (int y = 0; y < n; ++y)
+    {
+        for (int x = 0; x < n; ++x)
+        {
+            unsigned i0 = y * (n + 1) + x;
+            unsigned i1 = i0 + 1;
+            unsigned i2 = i0 + n + 1;
+            unsigned i3 = i2 + 1;
+
+            mesh.triangles.emplace_back(i0, i1, i3);
+            mesh.triangles.emplace_back(i0, i3, i2);
+        }
+    }
+
+    for (size_t i = 0; i < mesh.triangles.size(); ++i)
+    {
+        mesh.triangles[i].prim_id = static_cast<unsigned>(i);
+        mesh.triangles[i].geom_id = 0;
+    }
+
+    return mesh;
+}
+
+static aligned_vector<triangle_t> deindex(grid_mesh const& mesh)
+{
+    aligned_vector<triangle_t> result;
+
+    for (auto const& t : mesh.triangles)
+    {
+        result.push_back(make_triangle(t, mesh.vertices.data()));
+    }
+
+    return result;
+}
+
+static basic_ray<float> make_ray(vec2 const& pos)
+{
+    basic_ray<float> ray(vec3(pos, 1.0f), vec3(0.0f, 0.0f, -1.0f));
+    ray.tmin = 0.0f;
+    ray.tmax = numeric_limits<float>::max();
+    return ray;
+}
+
+template <typename BVH, typename RefBVH>
+static void test_closest_hits(BVH const& tree, RefBVH const& ref_tree, vec3 const* vertices)
+{
+    indexed_triangle_intersector<float> isect(vertices);
+
+    std::default_random_engine rng(1);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    auto bvh = tree.ref();
+    auto ref_bvh = ref_tree.ref();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto ray = make_ray(vec2(dist(rng), dist(rng)));
+
+        auto hr = closest_hit(ray, &bvh, &bvh + 1, isect);
+        auto ref = closest_hit(ray, &ref_bvh, &ref_bvh + 1);
+
+        ASSERT_EQ(hr.hit, ref.hit);
+
+        if (hr.hit)
+        {
+            EXPECT_EQ(hr.prim_id, ref.prim_id);
+            EXPECT_FLOAT_EQ(hr.t, ref.t);
+            EXPECT_FLOAT_EQ(hr.u, ref.u);
+            EXPECT_FLOAT_EQ(hr.v, ref.v);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test geometric functions and intersection against non-indexed triangles
+//
+
+TEST(IndexedTriangle, Geometry)
+{
+    vec3 vertices[] = { vec3(0, 0, 0), vec3(2, 0, 0), vec3(2, 2, 0), vec3(1, 1, 1) };
+
+    indexed_triangle_t tri(0, 1, 2);
+    tri.prim_id = 7;
+    tri.geom_id = 3;
+
+    EXPECT_FLOAT_EQ(area(tri, vertices), 2.0f);
+
+    auto bounds = get_bounds(tri, vertices);
+    EXPECT_FLOAT_EQ(bounds.min.x, 0.0f);
+    EXPECT_FLOAT_EQ(bounds.max.x, 2.0f);
+    EXPECT_FLOAT_EQ(bounds.max.y, 2.0f);
+    EXPECT_FLOAT_EQ(bounds.max.z, 0.0f);
+
+    // Three indices and the ids, no vertex positions or vertex array pointer
+    EXPECT_EQ(sizeof(indexed_triangle_t), 5 * sizeof(uint32_t));
+
+    basic_ray<float> ray(vec3(1.5f, 0.5f, 1.0f), vec3(0.0f, 0.0f, -1.0f));
+
+    auto hr = intersect(ray, tri, vertices);
+    auto ref = intersect(ray, make_triangle(tri, vertices));
+
+    EXPECT_TRUE(hr.hit);
+    EXPECT_EQ(hr.prim_id, 7U);
+    EXPECT_EQ(hr.geom_id, 3U);
+    EXPECT_FLOAT_EQ(hr.t, ref.t);
+    EXPECT_FLOAT_EQ(hr.u, ref.u);
+    EXPECT_FLOAT_EQ(hr.v, ref.v);
+
+    // SIMD rays
+    vector<3, simd::float4> ori(
+            simd::float4(1.5f, 0.5f, 3.0f, 1.9f),
+            simd::float4(0.5f, 1.0f, 0.5f, 0.5f),
+            simd::float4(1.0f)
+            );
+    basic_ray<simd::float4> ray4(ori, vector<3, simd::float4>(0.0f, 0.0f, -1.0f));
+
+    auto hr4 = intersect(ray4, tri, vertices);
+    simd::mask4 expected(true, false, false, true);
+    EXPECT_TRUE(all(hr4.hit == expected));
+
+    // Splitting
+    aabb L;
+    aabb R;
+    split_primitive(L, R, 1.0f, 0, bind_vertices(tri, vertices));
+    EXPECT_FLOAT_EQ(L.max.x, 1.0f);
+    EXPECT_FLOAT_EQ(R.min.x, 1.0f);
+    EXPECT_FLOAT_EQ(R.max.x, 2.0f);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that BVHs over indexed triangles find the same hits as over regular triangles
+//
+
+TEST(IndexedTriangle, BVH)
+{
+    auto mesh = make_grid_mesh(32);
+    auto triangles = deindex(mesh);
+
+    binned_sah_builder builder;
+
+    auto ref_bvh = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    auto vertices = mesh.vertices.data();
+
+    // Binned SAH
+    auto sah_bvh = builder.build(index_bvh<indexed_triangle_t>{}, mesh.triangles.data(), mesh.triangles.size(), vertices);
+    EXPECT_EQ(sah_bvh.primitives().size(), mesh.triangles.size());
+    test_closest_hits(sah_bvh, ref_bvh, vertices);
+
+    // Binned SAH with spatial splits
+    builder.enable_spatial_splits(true);
+    auto split_bvh = builder.build(index_bvh<indexed_triangle_t>{}, mesh.triangles.data(), mesh.triangles.size(), vertices);
+    test_closest_hits(split_bvh, ref_bvh, vertices);
+
+    // LBVH
+    lbvh_builder lbuilder;
+    auto lbvh = lbuilder.build(index_bvh<indexed_triangle_t>{}, mesh.triangles.data(), mesh.triangles.size(), vertices);
+    test_closest_hits(lbvh, ref_bvh, vertices);
+
+    // Refit after moving the vertices, the indices stay the same
+    for (auto& v : mesh.vertices)
+    {
+        v.z += 0.5f * v.x;
+    }
+
+    triangles = deindex(mesh);
+    ref_bvh = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+
+    bvh_refitter refitter;
+    refitter.refit(lbvh, mesh.triangles.data(), mesh.triangles.size(), vertices);
+    test_closest_hits(lbvh, ref_bvh, vertices);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that per-vertex attributes are looked up with the vertex indices
+//
+
+TEST(IndexedTriangle, Attributes)
+{
+    auto mesh = make_grid_mesh(4);
+
+    aligned_vector<vec3> normals(mesh.vertices.size(), vec3(0.0f, 0.0f, 1.0f));
+
+    aligned_vector<vec3> face_normals;
+
+    for (auto const& tri : mesh.triangles)
+    {
+        auto t = make_triangle(tri, mesh.vertices.data());
+        face_normals.push_back(normalize(cross(t.e1, t.e2)));
+    }
+
+    for (auto const& tri : mesh.triangles)
+    {
+        vec2 center = (mesh.tex_coords[tri.i1] + mesh.tex_coords[tri.i2] + mesh.tex_coords[tri.i3]) / 3.0f;
+
+        auto ray = make_ray(center);
+        auto hr = intersect(ray, tri, mesh.vertices.data());
+        ASSERT_TRUE(hr.hit);
+
+        // Texture coordinates are the vertices' x/y positions
+        auto tc = get_tex_coord(mesh.tex_coords.data(), hr, tri);
+        EXPECT_NEAR(tc.x, center.x, 1e-5f);
+        EXPECT_NEAR(tc.y, center.y, 1e-5f);
+
+        auto sn = get_shading_normal(normals.data(), hr, tri, normals_per_vertex_binding{});
+        EXPECT_FLOAT_EQ(sn.z, 1.0f);
+
+        // Face normals are looked up with the primitive id
+        auto gn = get_normal(face_normals.data(), hr, tri);
+        auto ref = get_normal(hr, make_triangle(tri, mesh.vertices.data()));
+        EXPECT_FLOAT_EQ(gn.x, ref.x);
+        EXPECT_FLOAT_EQ(gn.y, ref.y);
+        EXPECT_FLOAT_EQ(gn.z, ref.z);
+    }
+}
@@ -0,0 +1,284 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <random>
+
+#include <visionaray/math/math.h>
+#include <visionaray/aligned_vector.h>
+#include <visionaray/bvh.h>
+#include <visionaray/get_normal.h>
+#include <visionaray/get_shading_normal.h>
+#include <visionaray/get_tex_coord.h>
+#include <visionaray/intersector.h>
+#include <visionaray/traverse.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+using triangle_t = basic_triangle<3, float>;
+using precomputed_triangle_t = basic_precomputed_triangle<float>;
+
+// Height field over [0..1]^2 with n x n quads, two triangles per quad
+static aligned_vector<triangle_t> make_grid_mesh(int n, float jitter)
+{
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(-jitter, jitter);
+
+    aligned_vector<vec3> vertices;
+
+    for (int y = 0; y <= n; ++y)
+    {
+        for (int x = 0; x <= n; ++x)
+        {
+            vertices.emplace_back(x / float(n), y / float(n), dist(rng));
+        }
+    }
+
+    aligned_vector<triangle_t> result;
+
+    auto add = [&](unsigned i1, unsigned i2, unsigned i3)
+    {
+        triangle_t t(vertices[i1], vertices[i2] - vertices[i1], vertices[i3] - vertices[i1]);
+        t.prim_id = static_cast<unsigned>(result.size());
+        t.geom_id = 0;
+        result.push_back(t);
+    };
+
+    for (int y = 0; y < n; ++y)
+    {
+        for (int x = 0; x < n; ++x)
+        {
+            unsigned i0 = y * (n + 1) + x;
+            unsigned i1 = i0 + 1;
+            unsigned i2 = i0 + n + 1;
+            unsigned i3 = i2 + 1;
+
+            add(i0, i1, i3);
+            add(i0, i3, i2);
+        }
+    }
+
+    return result;
+}
+
+static aligned_vector<precomputed_triangle_t> precompute(aligned_vector<triangle_t> const& triangles)
+{
+    aligned_vector<precomputed_triangle_t> result;
+
+    for (auto const& t : triangles)
+    {
+        result.emplace_back(t);
+    }
+
+    return result;
+}
+
+static basic_ray<float> make_ray(vec2 const& pos)
+{
+    basic_ray<float> ray(vec3(pos, 1.0f), vec3(0.0f, 0.0f, -1.0f));
+    ray.tmin = 0.0f;
+    ray.tmax = numeric_limits<float>::max();
+    return ray;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test geometric functions and intersection against the Moeller-Trumbore test
+//
+
+TEST(PrecomputedTriangle, Geometry)
+{
+    vec3 v1(0.0f, 0.0f, 0.0f);
+    vec3 v2(2.0f, 0.0f, 0.5f);
+    vec3 v3(2.0f, 2.0f, 0.0f);
+
+    triangle_t ref_tri(v1, v2 - v1, v3 - v1);
+    ref_tri.prim_id = 7;
+    ref_tri.geom_id = 3;
+
+    precomputed_triangle_t tri(ref_tri);
+
+    // 48 bytes transform, padded to a cache line with the ids
+    EXPECT_EQ(sizeof(precomputed_triangle_t), 64U);
+
+    // Vertices are recovered from the transform
+    auto verts = compute_vertices(tri);
+    for (int i = 0; i < 3; ++i)
+    {
+        vec3 expected = i == 0 ? v1 : i == 1 ? v2 : v3;
+        EXPECT_NEAR(verts[i].x, expected.x, 1e-6f);
+        EXPECT_NEAR(verts[i].y, expected.y, 1e-6f);
+        EXPECT_NEAR(verts[i].z, expected.z, 1e-6f);
+    }
+
+    EXPECT_FLOAT_EQ(area(tri), area(ref_tri));
+
+    auto bounds = get_bounds(tri);
+    EXPECT_NEAR(bounds.max.x, 2.0f, 1e-6f);
+    EXPECT_NEAR(bounds.max.z, 0.5f, 1e-6f);
+
+    basic_ray<float> ray(vec3(1.5f, 0.5f, 1.0f), vec3(0.0f, 0.0f, -1.0f));
+
+    auto hr = intersect(ray, tri);
+    auto ref = intersect(ray, ref_tri);
+
+    EXPECT_TRUE(hr.hit);
+    EXPECT_EQ(hr.prim_id, 7U);
+    EXPECT_EQ(hr.geom_id, 3U);
+    EXPECT_NEAR(hr.t, ref.t, 1e-5f);
+    EXPECT_NEAR(hr.u, ref.u, 1e-5f);
+    EXPECT_NEAR(hr.v, ref.v, 1e-5f);
+
+    auto gn = get_normal(hr, tri);
+    auto ref_gn = get_normal(ref, ref_tri);
+    EXPECT_NEAR(gn.x, ref_gn.x, 1e-6f);
+    EXPECT_NEAR(gn.y, ref_gn.y, 1e-6f);
+    EXPECT_NEAR(gn.z, ref_gn.z, 1e-6f);
+
+    // SIMD rays
+    vector<3, simd::float4> ori(
+            simd::float4(1.5f, 0.5f, 3.0f, 1.9f),
+            simd::float4(0.5f, 1.0f, 0.5f, 0.5f),
+            simd::float4(1.0f)
+            );
+    basic_ray<simd::float4> ray4(ori, vector<3, simd::float4>(0.0f, 0.0f, -1.0f));
+
+    auto hr4 = intersect(ray4, tri);
+    simd::mask4 expected(true, false, false, true);
+    EXPECT_TRUE(all(hr4.hit == expected));
+
+    // Degenerate triangles are never hit
+    precomputed_triangle_t degenerate(triangle_t(v1, v2 - v1, (v2 - v1) * 2.0f));
+    EXPECT_FALSE(intersect(basic_ray<float>(vec3(1.0f, 0.0f, 1.0f), vec3(0.0f, 0.0f, -1.0f)), degenerate).hit);
+    EXPECT_FLOAT_EQ(get_bounds(degenerate).min.x, 0.0f);
+    EXPECT_FLOAT_EQ(get_bounds(degenerate).max.x, 0.0f);
+
+    // Splitting
+    aabb L;
+    aabb R;
+    split_primitive(L, R, 1.0f, 0, tri);
+    EXPECT_FLOAT_EQ(L.max.x, 1.0f);
+    EXPECT_FLOAT_EQ(R.min.x, 1.0f);
+    EXPECT_NEAR(R.max.x, 2.0f, 1e-6f);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that BVHs over precomputed triangles find the same hits as over regular triangles
+//
+
+TEST(PrecomputedTriangle, BVH)
+{
+    auto triangles = make_grid_mesh(32, 0.05f);
+    auto precomputed = precompute(triangles);
+
+    binned_sah_builder builder;
+    builder.enable_spatial_splits(true);
+
+    auto ref_bvh = builder.build(index_bvh<triangle_t>{}, triangles.data(), triangles.size());
+    auto bvh = builder.build(index_bvh<precomputed_triangle_t>{}, precomputed.data(), precomputed.size());
+
+    lbvh_builder lbuilder;
+    auto lbvh = lbuilder.build(index_bvh<precomputed_triangle_t>{}, precomputed.data(), precomputed.size());
+
+    auto ref = ref_bvh.ref();
+    auto r1 = bvh.ref();
+    auto r2 = lbvh.ref();
+
+    std::default_random_engine rng(1);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto ray = make_ray(vec2(dist(rng), dist(rng)));
+
+        auto hr_ref = closest_hit(ray, &ref, &ref + 1);
+        auto hr1 = closest_hit(ray, &r1, &r1 + 1);
+        auto hr2 = closest_hit(ray, &r2, &r2 + 1);
+
+        ASSERT_TRUE(hr_ref.hit);
+        ASSERT_TRUE(hr1.hit);
+        ASSERT_TRUE(hr2.hit);
+
+        EXPECT_NEAR(hr1.t, hr_ref.t, 1e-5f);
+        EXPECT_NEAR(hr2.t, hr_ref.t, 1e-5f);
+
+        if (hr1.prim_id == hr_ref.prim_id)
+        {
+            EXPECT_NEAR(hr1.u, hr_ref.u, 1e-4f);
+            EXPECT_NEAR(hr1.v, hr_ref.v, 1e-4f);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test the watertight ray / triangle test
+//
+
+TEST(PrecomputedTriangle, Watertight)
+{
+    int n = 16;
+    auto triangles = make_grid_mesh(n, 0.02f);
+
+    // Linear traversal, BVH traversal with axis aligned rays has its own
+    // edge cases
+    auto begin = triangles.data();
+    auto end = triangles.data() + triangles.size();
+
+    watertight_intersector isect;
+
+    std::default_random_engine rng(2);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    // Same hits as Moeller-Trumbore away from edges
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto ray = make_ray(vec2(dist(rng), dist(rng)));
+
+        auto hr = closest_hit(ray, begin, end, isect);
+        auto hr_ref = closest_hit(ray, begin, end);
+
+        ASSERT_TRUE(hr.hit);
+        EXPECT_NEAR(hr.t, hr_ref.t, 1e-5f);
+    }
+
+    // Rays through shared vertices and along shared edges, from oblique
+    // directions, never slip through
+    for (int y = 1; y < n; ++y)
+    {
+        for (int x = 1; x < n; ++x)
+        {
+            vec2 p(x / float(n), y / float(n));
+
+            for (int j = 0; j < 4; ++j)
+            {
+                // Target the vertex, the diagonal edge's midpoint and the
+                // horizontal and vertical edges' midpoints
+                vec2 offset = j == 0 ? vec2(0.0f) : j == 1 ? vec2(0.5f) : j == 2 ? vec2(0.5f, 0.0f) : vec2(0.0f, 0.5f);
+                vec2 target_xy = p + offset / float(n);
+
+                // Ray towards the grid point, the height is found with a vertical ray
+                auto hr_v = closest_hit(make_ray(target_xy), begin, end, isect);
+                ASSERT_TRUE(hr_v.hit) << x << ' ' << y << ' ' << j;
+
+                vec3 target(target_xy, 1.0f - hr_v.t);
+                // Origin slightly above, so the first hit is at the target
+                vec3 ori = target + normalize(vec3(0.1f * (j + 1), -0.1f * j, 1.0f)) * 0.05f;
+
+                basic_ray<float> ray(ori, normalize(target - ori));
+                ray.tmin = 0.0f;
+                ray.tmax = numeric_limits<float>::max();
+
+                auto hr = closest_hit(ray, begin, end, isect);
+                EXPECT_TRUE(hr.hit) << x << ' ' << y << ' ' << j;
+            }
+        }
+    }
+}
@@ -0,0 +1,263 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <visionaray/math/math.h>
+#include <visionaray/macrocell_grid.h>
+#include <visionaray/participating_media.h>
+#include <visionaray/random_generator.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+// Extinction increases linearly from 0 to 4 along x over the unit cube
+// centered at the origin, a ray along x has optical depth 2
+struct linear_medium
+{
+    float operator()(vec3 const& pos) const
+    {
+        return 4.0f * (pos.x + 0.5f);
+    }
+};
+
+// Dense box in an otherwise empty medium, a ray along x
+// through the box has optical depth 50 * 0.1 = 5
+struct sparse_medium
+{
+    float operator()(vec3 const& pos) const
+    {
+        bool inside = pos.x >= 0.1f && pos.x <= 0.2f
+                   && pos.y >= 0.1f && pos.y <= 0.2f
+                   && pos.z >= 0.1f && pos.z <= 0.2f;
+        return inside ? 50.0f : 0.0f;
+    }
+
+    // Exact range of extinction values inside box
+    vec2 range(aabb const& box) const
+    {
+        aabb dense(vec3(0.1f), vec3(0.2f));
+        aabb isect = intersect(box, dense);
+
+        if (isect.invalid())
+        {
+            return vec2(0.0f);
+        }
+
+        bool contained = box.min.x >= 0.1f && box.max.x <= 0.2f
+                      && box.min.y >= 0.1f && box.max.y <= 0.2f
+                      && box.min.z >= 0.1f && box.max.z <= 0.2f;
+        return vec2(contained ? 50.0f : 0.0f, 50.0f);
+    }
+};
+
+static basic_ray<float> make_x_ray(float y, float z)
+{
+    basic_ray<float> ray(vec3(-1.0f, y, z), vec3(1.0f, 0.0f, 0.0f));
+    ray.tmin = 0.0f;
+    ray.tmax = numeric_limits<float>::max();
+    return ray;
+}
+
+static macrocell_grid make_majorant_grid(linear_medium const& medium, vec3i const& dims)
+{
+    // Lipschitz constant of the linear medium is its slope
+    macrocell_grid grid(dims, aabb(vec3(-0.5f), vec3(0.5f)));
+    grid.build_from_function(medium, vec3i(9), 4.0f);
+    grid.compute_majorants([](vec2 const& range) { return range.y; });
+    return grid;
+}
+
+static macrocell_grid make_majorant_grid(sparse_medium const& medium, vec3i const& dims)
+{
+    macrocell_grid grid(dims, aabb(vec3(-0.5f), vec3(0.5f)));
+    grid.build_from_range_function([&](aabb const& box) { return medium.range(box); });
+    grid.compute_majorants([](vec2 const& range) { return range.y; });
+    return grid;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that the estimators converge to the analytic transmittance
+//
+
+TEST(ParticipatingMedia, Transmittance)
+{
+    linear_medium medium;
+    auto grid = make_majorant_grid(medium, vec3i(8));
+
+    auto ray = make_x_ray(0.0f, 0.0f);
+    float expected = exp(-2.0f);
+
+    random_generator<float> gen(0);
+
+    static const int N = 100000;
+
+    int escaped = 0;
+    double ratio = 0.0;
+    double residual = 0.0;
+
+    for (int i = 0; i < N; ++i)
+    {
+        float t = 0.0f;
+        if (!delta_tracking(ray, medium, grid, gen, t))
+        {
+            ++escaped;
+        }
+        else
+        {
+            EXPECT_GE(t, 0.5f);
+            EXPECT_LE(t, 1.5f);
+        }
+
+        ratio += ratio_tracking(ray, medium, grid, gen);
+        residual += residual_ratio_tracking(ray, medium, grid, gen);
+    }
+
+    EXPECT_NEAR(escaped / double(N), expected, 0.01);
+    EXPECT_NEAR(ratio / N, expected, 0.01);
+    EXPECT_NEAR(residual / N, expected, 0.01);
+
+    // Rays that miss the medium are not attenuated
+    auto miss = make_x_ray(2.0f, 0.0f);
+    float t = 0.0f;
+    EXPECT_FALSE(delta_tracking(miss, medium, grid, gen, t));
+    EXPECT_FLOAT_EQ(ratio_tracking(miss, medium, grid, gen), 1.0f);
+    EXPECT_FLOAT_EQ(residual_ratio_tracking(miss, medium, grid, gen), 1.0f);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that local majorants reduce the number of density lookups
+//
+
+TEST(ParticipatingMedia, LocalMajorants)
+{
+    sparse_medium medium;
+    auto grid = make_majorant_grid(medium, vec3i(20));
+    auto global = make_majorant_grid(medium, vec3i(1));
+
+    EXPECT_FLOAT_EQ(grid.max_majorant(), 50.0f);
+    EXPECT_FLOAT_EQ(global.majorant(vec3i(0)), 50.0f);
+
+    // Cells that only contain empty space have majorant 0
+    EXPECT_FLOAT_EQ(grid.majorant(vec3i(0)), 0.0f);
+
+    random_generator<float> gen(0);
+
+    static const int N = 20000;
+
+    // Through empty space: no lookups with local majorants
+    auto empty_ray = make_x_ray(-0.3f, -0.3f);
+
+    tracking_stats empty_stats;
+    for (int i = 0; i < N; ++i)
+    {
+        EXPECT_FLOAT_EQ(ratio_tracking(empty_ray, medium, grid, gen, empty_stats), 1.0f);
+    }
+    EXPECT_EQ(empty_stats.density_lookups, 0U);
+
+    // Through the dense box: same estimate, fewer lookups
+    auto ray = make_x_ray(0.15f, 0.15f);
+    float expected = exp(-5.0f);
+
+    tracking_stats local_stats;
+    tracking_stats global_stats;
+    tracking_stats residual_stats;
+
+    double local = 0.0;
+    double glob = 0.0;
+    double residual = 0.0;
+
+    for (int i = 0; i < N; ++i)
+    {
+        local += ratio_tracking(ray, medium, grid, gen, local_stats);
+        glob += ratio_tracking(ray, medium, global, gen, global_stats);
+        residual += residual_ratio_tracking(ray, medium, grid, gen, residual_stats);
+    }
+
+    EXPECT_NEAR(local / N, expected, 0.005);
+    EXPECT_NEAR(glob / N, expected, 0.005);
+    EXPECT_NEAR(residual / N, expected, 0.005);
+
+    EXPECT_LT(local_stats.density_lookups * 4, global_stats.density_lookups);
+
+    // Cells inside the box are homogeneous, so residual
+    // ratio tracking only needs lookups at the box boundary
+    EXPECT_LT(residual_stats.density_lookups, local_stats.density_lookups);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that majorants bound features that lie between the samples
+//
+
+TEST(ParticipatingMedia, ConservativeMajorants)
+{
+    // Narrow Gaussian bump centered between two samples
+    vec3 center(0.0125f + 0.003f, 0.0f, 0.0f);
+    float height = 50.0f;
+    float width = 0.002f;
+
+    auto bump = [&](vec3 const& pos)
+    {
+        vec3 d = pos - center;
+        return height * exp(-dot(d, d) / (2.0f * width * width));
+    };
+
+    // Max. gradient magnitude of the Gaussian
+    float lipschitz = height / (width * sqrt(exp(1.0f)));
+
+    aabb bounds(vec3(-0.5f), vec3(0.5f));
+
+    macrocell_grid sampled(vec3i(20), bounds);
+    sampled.build_from_function(bump, vec3i(9));
+
+    macrocell_grid padded(vec3i(20), bounds);
+    padded.build_from_function(bump, vec3i(9), lipschitz);
+
+    vec3i cell = padded.cell_index(center);
+
+    // Point samples miss the peak
+    EXPECT_LT(sampled.value_range(cell).y, height);
+    EXPECT_GE(padded.value_range(cell).y, height);
+
+    // Samples of neighboring cells are covered
+    EXPECT_GE(sampled.value_range(vec3i(10, 9, 9)).y, sampled.value_range(cell).y);
+
+    // Thin slab that no sample hits, with a conservative range per cell
+    auto slab = [](vec3 const& pos)
+    {
+        return pos.x >= 0.013f && pos.x <= 0.018f ? 50.0f : 0.0f;
+    };
+
+    macrocell_grid grid(vec3i(20), bounds);
+    grid.build_from_range_function([](aabb const& box)
+    {
+        bool overlaps = box.max.x >= 0.013f && box.min.x <= 0.018f;
+        return vec2(0.0f, overlaps ? 50.0f : 0.0f);
+    });
+    grid.compute_majorants([](vec2 const& range) { return range.y; });
+
+    EXPECT_FLOAT_EQ(grid.majorant(vec3i(10, 0, 0)), 50.0f);
+    EXPECT_FLOAT_EQ(grid.majorant(vec3i(9, 0, 0)), 0.0f);
+
+    random_generator<float> gen(0);
+
+    static const int N = 20000;
+
+    auto ray = make_x_ray(0.0f, 0.0f);
+    float expected = exp(-50.0f * 0.005f);
+
+    double tr = 0.0;
+    for (int i = 0; i < N; ++i)
+    {
+        tr += ratio_tracking(ray, slab, grid, gen);
+    }
+
+    EXPECT_NEAR(tr / N, expected, 0.01);
+}
@@ -0,0 +1,241 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/profiling.h>
+#include <visionaray/result_record.h>
+#include <visionaray/scheduler.h>
+#include <visionaray/simple_buffer_rt.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static size_t count_events(std::vector<profiling::event> const& events, char const* name)
+{
+    size_t result = 0;
+
+    for (auto const& e : events)
+    {
+        result += std::strcmp(e.name, name) == 0 ? 1 : 0;
+    }
+
+    return result;
+}
+
+// Enable with a clean timeline, disable again when the test ends
+struct profiling_scope
+{
+    explicit profiling_scope(size_t capacity = 65536)
+    {
+        profiling::set_capacity(capacity);
+        profiling::enable();
+    }
+
+    ~profiling_scope()
+    {
+        profiling::enable(false);
+        profiling::set_capacity(65536);
+    }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Test recording on multiple threads
+//
+
+TEST(Profiling, Record)
+{
+    // Disabled by default
+    profiling::clear();
+    profiling::record("ignored", 0, 1);
+    EXPECT_TRUE(profiling::events().empty());
+
+    profiling_scope scope;
+
+    {
+        profiling::scoped_event e("main", 42);
+    }
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([i]()
+        {
+            for (int j = 0; j < 100; ++j)
+            {
+                profiling::scoped_event e("worker", i * 100 + j);
+            }
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    auto events = profiling::events();
+
+    ASSERT_EQ(events.size(), size_t(401));
+    EXPECT_EQ(count_events(events, "main"), size_t(1));
+    EXPECT_EQ(count_events(events, "worker"), size_t(400));
+
+    std::set<unsigned> worker_threads;
+    std::set<int64_t> ids;
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        EXPECT_LE(events[i].begin, events[i].end);
+
+        // Sorted by begin time
+        if (i > 0)
+        {
+            EXPECT_LE(events[i - 1].begin, events[i].begin);
+        }
+
+        if (std::strcmp(events[i].name, "main") == 0)
+        {
+            EXPECT_EQ(events[i].id, 42);
+        }
+        else
+        {
+            worker_threads.insert(events[i].thread);
+            ids.insert(events[i].id);
+        }
+    }
+
+    EXPECT_EQ(worker_threads.size(), size_t(4));
+    EXPECT_EQ(ids.size(), size_t(400));
+
+    // Events of exited threads remain until clear()
+    profiling::clear();
+    EXPECT_TRUE(profiling::events().empty());
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Full ring buffers keep the newest events
+//
+
+TEST(Profiling, RingBuffer)
+{
+    profiling_scope scope(4);
+
+    EXPECT_EQ(profiling::capacity(), size_t(4));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        profiling::record("event", i, i + 1, i);
+    }
+
+    auto events = profiling::events();
+
+    ASSERT_EQ(events.size(), size_t(4));
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        EXPECT_EQ(events[i].id, static_cast<int64_t>(i + 6));
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Chrome trace event export
+//
+
+TEST(Profiling, ChromeTrace)
+{
+    profiling_scope scope;
+
+    profiling::record("frame", 1000, 2500, 7);
+    profiling::record("quote\"d", 3000, 3000);
+
+    std::ostringstream out;
+    profiling::write_chrome_trace(out);
+
+    std::string json = out.str();
+
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), size_t(0));
+    EXPECT_NE(json.find("\"ph\":\"M\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"frame\""), std::string::npos);
+    EXPECT_NE(json.find("\"ts\":1.000,\"dur\":1.500,\"args\":{\"id\":7}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"quote\\\"d\""), std::string::npos);
+    EXPECT_NE(json.find("\"ts\":3.000,\"dur\":0.000}"), std::string::npos);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+
+#if VSNRAY_HAVE_PROFILING
+
+//-------------------------------------------------------------------------------------------------
+// Scheduler frames are instrumented
+//
+
+template <typename S>
+struct kernel
+{
+    result_record<S> operator()(basic_ray<S> const& /* */) const
+    {
+        result_record<S> result;
+        result.hit = true;
+        result.color = vector<4, S>(1.0f);
+        return result;
+    }
+};
+
+TEST(Profiling, TiledSched)
+{
+    profiling_scope scope;
+
+    simple_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED> rt;
+    rt.resize(64, 32);
+
+    tiled_sched<basic_ray<float>> sched(2);
+
+    auto sparams = make_sched_params(mat4::identity(), mat4::identity(), rt);
+    sparams.tile_width = 16;
+    sparams.tile_height = 16;
+
+    sched.frame(kernel<float>{}, sparams);
+    sched.frame(kernel<float>{}, sparams);
+
+    auto events = profiling::events();
+
+    EXPECT_EQ(count_events(events, "frame"), size_t(2));
+    EXPECT_EQ(count_events(events, "begin_frame"), size_t(2));
+    EXPECT_EQ(count_events(events, "end_frame"), size_t(2));
+    EXPECT_EQ(count_events(events, "parallel_for tile"), size_t(2 * 4 * 2));
+
+    // Tiles are nested in their frame
+    uint64_t frame_begin = 0;
+    uint64_t frame_end = 0;
+
+    for (auto const& e : events)
+    {
+        if (std::strcmp(e.name, "frame") == 0)
+        {
+            frame_begin = e.begin;
+            frame_end = e.end;
+        }
+        else if (std::strcmp(e.name, "parallel_for tile") == 0)
+        {
+            EXPECT_GE(e.begin, frame_begin);
+            EXPECT_LE(e.end, frame_end);
+        }
+    }
+}
+
+#endif // VSNRAY_HAVE_PROFILING
@@ -0,0 +1,433 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/preview_controller.h>
+#include <visionaray/result_record.h>
+#include <visionaray/simple_buffer_rt.h>
+#include <visionaray/scheduler.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static bool is_permutation(std::vector<int> const& indices, int n)
+{
+    std::vector<int> sorted(indices);
+    std::sort(sorted.begin(), sorted.end());
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (sorted.size() != static_cast<size_t>(n) || sorted[i] != i)
+        {
+            return false;
+        }
+    }
+
+    return sorted.size() == static_cast<size_t>(n);
+}
+
+using render_target_t = simple_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED>;
+
+// Kernel that writes 1 to all pixels
+template <typename S>
+struct kernel
+{
+    result_record<S> operator()(basic_ray<S> const& /* */) const
+    {
+        result_record<S> result;
+        result.hit = true;
+        result.color = vector<4, S>(1.0f);
+        result.depth = S(1.0f);
+        return result;
+    }
+};
+
+// Clear to 0, render 1 inside scissor, return true if exactly the expected
+// region [x0..x1) x [y0..y1) was written
+template <typename Sched>
+static bool test_scissor(
+        Sched&      sched,
+        recti       scissor,
+        int         x0,
+        int         y0,
+        int         x1,
+        int         y1,
+        tile_order  order = RowMajorOrder
+        )
+{
+    using R = typename Sched::ray_type;
+
+    render_target_t rt;
+    rt.resize(37, 29);
+
+    std::fill(rt.color(), rt.color() + rt.width() * rt.height(), vec4(0.0f));
+
+    auto sparams = make_sched_params(mat4::identity(), mat4::identity(), rt);
+    sparams.scissor = scissor;
+    sparams.order = order;
+
+    sched.frame(kernel<typename R::scalar_type>{}, sparams);
+
+    for (int y = 0; y < rt.height(); ++y)
+    {
+        for (int x = 0; x < rt.width(); ++x)
+        {
+            bool inside = x >= x0 && x < x1 && y >= y0 && y < y1;
+            float expected = inside ? 1.0f : 0.0f;
+
+            if (rt.color()[y * rt.width() + x].x != expected)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename R>
+struct tiled_sched_test : tiled_sched<R>
+{
+    using ray_type = R;
+    using tiled_sched<R>::tiled_sched;
+};
+
+template <typename R>
+struct simple_sched_test : simple_sched<R>
+{
+    using ray_type = R;
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that all tile orders visit each tile exactly once
+//
+
+TEST(Scheduler, TileOrderPermutation)
+{
+    tile_order orders[] = { RowMajorOrder, MortonOrder, HilbertOrder, SpiralOrder };
+
+    int sizes[][2] = { { 1, 1 }, { 5, 3 }, { 3, 5 }, { 16, 16 }, { 7, 13 }, { 40, 1 } };
+
+    for (auto order : orders)
+    {
+        for (auto const& size : sizes)
+        {
+            std::vector<int> indices;
+            detail::make_tile_order(order, size[0], size[1], indices);
+            EXPECT_TRUE(is_permutation(indices, size[0] * size[1]));
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test locality of the tile orders
+//
+
+TEST(Scheduler, TileOrderLocality)
+{
+    std::vector<int> indices;
+
+    // Morton: first four tiles form a 2x2 block
+    detail::make_tile_order(MortonOrder, 4, 4, indices);
+    EXPECT_EQ(indices[0], 0);
+    EXPECT_EQ(indices[1], 1);
+    EXPECT_EQ(indices[2], 4);
+    EXPECT_EQ(indices[3], 5);
+
+    // Hilbert: consecutive tiles are neighbors
+    detail::make_tile_order(HilbertOrder, 16, 16, indices);
+
+    for (size_t i = 1; i < indices.size(); ++i)
+    {
+        int dx = std::abs(indices[i] % 16 - indices[i - 1] % 16);
+        int dy = std::abs(indices[i] / 16 - indices[i - 1] / 16);
+        EXPECT_EQ(dx + dy, 1);
+    }
+
+    // Spiral: center first, rings of increasing size
+    detail::make_tile_order(SpiralOrder, 5, 5, indices);
+    EXPECT_EQ(indices[0], 12);
+
+    for (size_t i = 1; i < 9; ++i)
+    {
+        int dx = std::abs(indices[i] % 5 - 2);
+        int dy = std::abs(indices[i] / 5 - 2);
+        EXPECT_EQ(std::max(dx, dy), 1);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test automatic tile size
+//
+
+TEST(Scheduler, AutoTileSize)
+{
+    // Large image, few threads: big tiles
+    EXPECT_EQ(detail::auto_tile_size(1920, 1080, 4), 64);
+
+    // Many threads: smaller tiles, but not below 8x8
+    EXPECT_LT(detail::auto_tile_size(512, 512, 64), 64);
+    EXPECT_EQ(detail::auto_tile_size(16, 16, 64), 8);
+
+    for (unsigned threads = 1; threads <= 256; threads *= 2)
+    {
+        int size = detail::auto_tile_size(1024, 768, threads);
+        EXPECT_GE(size, 8);
+        EXPECT_LE(size, 64);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that only pixels inside the scissor rectangle are rendered
+//
+
+TEST(Scheduler, Scissor)
+{
+    simple_sched_test<basic_ray<float>> simple;
+    tiled_sched_test<basic_ray<float>> tiled(2);
+    tiled_sched_test<basic_ray<simd::float4>> tiled4(2);
+
+    tile_order orders[] = { RowMajorOrder, MortonOrder, HilbertOrder, SpiralOrder };
+
+    // No scissor: whole image
+    EXPECT_TRUE(test_scissor(simple, recti(0, 0, 0, 0), 0, 0, 37, 29));
+    EXPECT_TRUE(test_scissor(tiled, recti(0, 0, 0, 0), 0, 0, 37, 29));
+    EXPECT_TRUE(test_scissor(tiled4, recti(0, 0, 0, 0), 0, 0, 37, 29));
+
+    // Exact for scalar rays
+    EXPECT_TRUE(test_scissor(simple, recti(3, 5, 10, 7), 3, 5, 13, 12));
+
+    for (auto order : orders)
+    {
+        EXPECT_TRUE(test_scissor(tiled, recti(3, 5, 10, 7), 3, 5, 13, 12, order));
+    }
+
+    // Expanded to packet boundaries (2x2 pixels for float4)
+    for (auto order : orders)
+    {
+        EXPECT_TRUE(test_scissor(tiled4, recti(3, 5, 10, 7), 2, 4, 14, 12, order));
+    }
+
+    // Clipped to the render target
+    EXPECT_TRUE(test_scissor(tiled, recti(-5, 20, 100, 100), 0, 20, 37, 29));
+    EXPECT_TRUE(test_scissor(simple, recti(-5, 20, 100, 100), 0, 20, 37, 29));
+
+    // Outside the render target: nothing
+    EXPECT_TRUE(test_scissor(tiled, recti(50, 50, 10, 10), 0, 0, 0, 0));
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that fixed tile sizes are honored and the image is covered
+//
+
+TEST(Scheduler, TileSize)
+{
+    tiled_sched_test<basic_ray<simd::float4>> sched(3);
+
+    render_target_t rt;
+    rt.resize(37, 29);
+
+    std::fill(rt.color(), rt.color() + rt.width() * rt.height(), vec4(0.0f));
+
+    auto sparams = make_sched_params(mat4::identity(), mat4::identity(), rt);
+    sparams.tile_width = 5; // rounded up to 6
+    sparams.tile_height = 3;
+    sparams.order = HilbertOrder;
+
+    sched.frame(kernel<simd::float4>{}, sparams);
+
+    for (int i = 0; i < rt.width() * rt.height(); ++i)
+    {
+        EXPECT_FLOAT_EQ(rt.color()[i].x, 1.0f);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test progressive preview
+//
+
+TEST(Scheduler, Preview)
+{
+    // Kernel that stores the x coordinate of the primary ray's direction
+    struct kernel
+    {
+        result_record<simd::float4> operator()(basic_ray<simd::float4> const& ray) const
+        {
+            result_record<simd::float4> result;
+            result.hit = true;
+            result.color = vector<4, simd::float4>(ray.dir.x, ray.dir.y, 0.0f, 1.0f);
+            result.depth = simd::float4(1.0f);
+            return result;
+        }
+    };
+
+    tiled_sched_test<basic_ray<simd::float4>> sched(2);
+
+    render_target_t rt;
+    rt.resize(37, 29);
+
+    auto sparams = make_sched_params(mat4::identity(), mat4::identity(), rt);
+
+    sched.frame(kernel{}, sparams);
+    std::vector<vec4> full(rt.color(), rt.color() + rt.width() * rt.height());
+
+    sched.set_preview_factor(4);
+    EXPECT_EQ(sched.preview_factor(), 4);
+
+    std::fill(rt.color(), rt.color() + rt.width() * rt.height(), vec4(0.0f));
+    sched.frame(kernel{}, sparams);
+
+    for (int y = 0; y < rt.height(); ++y)
+    {
+        for (int x = 0; x < rt.width(); ++x)
+        {
+            // All pixels written, constant in 4x4 blocks
+            vec4 c = rt.color()[y * rt.width() + x];
+            vec4 block = rt.color()[(y / 4 * 4) * rt.width() + x / 4 * 4];
+            EXPECT_FLOAT_EQ(c.w, 1.0f);
+            EXPECT_FLOAT_EQ(c.x, block.x);
+            EXPECT_FLOAT_EQ(c.y, block.y);
+
+            // Approximates the full resolution image
+            vec4 f = full[y * rt.width() + x];
+            EXPECT_NEAR(c.x, f.x, 0.25f);
+            EXPECT_NEAR(c.y, f.y, 0.25f);
+        }
+    }
+
+    // Preview with scissor: only the region is updated
+    std::fill(rt.color(), rt.color() + rt.width() * rt.height(), vec4(0.0f));
+    sparams.scissor = recti(5, 6, 10, 10);
+    sched.frame(kernel{}, sparams);
+
+    for (int y = 0; y < rt.height(); ++y)
+    {
+        for (int x = 0; x < rt.width(); ++x)
+        {
+            bool inside = x >= 5 && x < 15 && y >= 6 && y < 16;
+            EXPECT_FLOAT_EQ(rt.color()[y * rt.width() + x].w, inside ? 1.0f : 0.0f);
+        }
+    }
+
+    // Back to full resolution
+    sched.set_preview_factor(1);
+    sparams.scissor = recti(0, 0, 0, 0);
+    sched.frame(kernel{}, sparams);
+
+    for (int i = 0; i < rt.width() * rt.height(); ++i)
+    {
+        EXPECT_FLOAT_EQ(rt.color()[i].x, full[i].x);
+        EXPECT_FLOAT_EQ(rt.color()[i].y, full[i].y);
+    }
+}
+
+TEST(Scheduler, PreviewController)
+{
+    preview_controller preview(0.01 /* 10 ms */, 8, 0.02 /* 20 ms hold time */);
+
+    // No estimate yet: full resolution
+    EXPECT_EQ(preview.begin_frame(true), 1);
+    preview.end_frame(0.1);
+
+    // 100 ms at full resolution, needs 1/16 of the pixels
+    EXPECT_EQ(preview.begin_frame(true), 4);
+    preview.end_frame(0.1 / 16);
+    EXPECT_NEAR(preview.full_frame_time(), 0.1, 1e-6);
+
+    // Camera stopped: preview is kept for the hold time
+    EXPECT_EQ(preview.begin_frame(false), 4);
+    preview.end_frame(0.1 / 16);
+    EXPECT_EQ(preview.begin_frame(false), 4);
+    preview.end_frame(0.1 / 16);
+
+    // Moving again restarts the hold time
+    EXPECT_EQ(preview.begin_frame(true), 4);
+    preview.end_frame(0.1 / 16);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(preview.begin_frame(false), 4);
+        preview.end_frame(0.1 / 16);
+    }
+
+    // Hold time is over: refine
+    EXPECT_EQ(preview.begin_frame(false), 1);
+    preview.end_frame(0.1);
+    EXPECT_EQ(preview.begin_frame(false), 1);
+
+    // Never exceeds max factor
+    preview.end_frame(10.0);
+    EXPECT_EQ(preview.begin_frame(true), 8);
+
+    // Fast enough at full resolution
+    preview_controller fast(0.01, 8);
+    fast.end_frame(0.005);
+    EXPECT_EQ(fast.begin_frame(true), 1);
+}
+
+TEST(Scheduler, FeatureBuffers)
+{
+    // Kernel that records a hit left of x = 0, with features
+    struct kernel
+    {
+        result_record<simd::float4> operator()(basic_ray<simd::float4> const& ray) const
+        {
+            result_record<simd::float4> result;
+            result.hit = ray.ori.x < simd::float4(0.0f);
+            result.color = vector<4, simd::float4>(1.0f);
+            result.depth = simd::float4(2.0f);
+            result.albedo = vector<3, simd::float4>(0.25f, 0.5f, 0.75f);
+            result.normal = vector<3, simd::float4>(0.0f, 0.0f, 1.0f);
+            return result;
+        }
+    };
+
+    simple_buffer_rt<PF_RGBA32F, PF_UNSPECIFIED, PF_RGBA32F, PF_RGBA32F> rt;
+    rt.resize(16, 8);
+    rt.clear_accum_buffer();
+    rt.clear_feature_buffers();
+
+    // Orthographic projection, ray origins span [-1..1] in x
+    pixel_sampler::jittered_blend_type blend_params;
+    blend_params.spp = 1;
+    blend_params.sfactor = 1.0f;
+    blend_params.dfactor = 0.0f;
+
+    auto sparams = make_sched_params(blend_params, mat4::identity(), mat4::identity(), rt);
+
+    tiled_sched_test<basic_ray<simd::float4>> sched(2);
+    sched.frame(kernel{}, sparams);
+
+    for (int y = 0; y < rt.height(); ++y)
+    {
+        for (int x = 0; x < rt.width(); ++x)
+        {
+            int i = y * rt.width() + x;
+            bool hit = x < rt.width() / 2;
+
+            vec4 albedo = rt.albedo()[i];
+            vec4 normal_depth = rt.normal_depth()[i];
+
+            EXPECT_FLOAT_EQ(albedo.x, hit ? 0.25f : 1.0f);
+            EXPECT_FLOAT_EQ(albedo.z, hit ? 0.75f : 1.0f);
+            EXPECT_FLOAT_EQ(normal_depth.z, hit ? 1.0f : 0.0f);
+            EXPECT_FLOAT_EQ(normal_depth.w, hit ? 2.0f : 0.0f);
+        }
+    }
+}
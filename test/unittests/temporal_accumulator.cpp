@@ -0,0 +1,196 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cmath>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/pinhole_camera.h>
+#include <visionaray/temporal_accumulator.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static pinhole_camera make_camera(vec3 eye, int width, int height)
+{
+    pinhole_camera cam;
+    cam.perspective(45.0f * constants::degrees_to_radians<float>(), width / static_cast<float>(height), 0.1f, 100.0f);
+    cam.set_viewport(0, 0, width, height);
+    cam.look_at(eye, eye - vec3(0.0f, 0.0f, 1.0f), vec3(0.0f, 1.0f, 0.0f));
+    cam.begin_frame();
+    return cam;
+}
+
+// Features of the plane z = plane_z (or z = near_z where x < 0) facing +z,
+// color is the hit point's x coordinate
+static void render_planes(
+        pinhole_camera const&   cam,
+        int                     width,
+        int                     height,
+        float                   plane_z,
+        float                   near_z,
+        std::vector<vec4>&      color,
+        std::vector<vec4>&      normal_depth
+        )
+{
+    color.resize(width * height);
+    normal_depth.resize(width * height);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            auto r = cam.primary_ray(basic_ray<float>{}, float(x), float(y), float(width), float(height));
+
+            float t = (plane_z - r.ori.z) / r.dir.z;
+            vec3 p = r.ori + r.dir * t;
+
+            if (p.x < 0.0f)
+            {
+                t = (near_z - r.ori.z) / r.dir.z;
+                p = r.ori + r.dir * t;
+            }
+
+            color[y * width + x] = vec4(p.x, 0.0f, 0.0f, 1.0f);
+            normal_depth[y * width + x] = vec4(0.0f, 0.0f, 1.0f, t);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test temporal_accumulator
+//
+
+TEST(TemporalAccumulator, StaticCamera)
+{
+    int width = 16;
+    int height = 8;
+
+    auto cam = make_camera(vec3(0.0f, 0.0f, 10.0f), width, height);
+
+    std::vector<vec4> accum(width * height);
+    std::vector<vec4> normal_depth(width * height, vec4(0.0f, 0.0f, 1.0f, 10.0f));
+    std::vector<vec4> color(width * height);
+
+    temporal_accumulator acc(2);
+
+    float samples[] = { 1.0f, 0.0f, 2.0f, 1.0f };
+
+    for (float s : samples)
+    {
+        std::fill(accum.begin(), accum.end(), vec4(s));
+        acc.accumulate(pixel_format_constant<PF_RGBA32F>{}, color.data(), accum.data(), normal_depth.data(), width, height, cam);
+    }
+
+    for (int i = 0; i < width * height; ++i)
+    {
+        EXPECT_FLOAT_EQ(accum[i].x, 1.0f);
+        EXPECT_FLOAT_EQ(color[i].x, 1.0f);
+        EXPECT_FLOAT_EQ(acc.history_length()[i], 4.0f);
+        EXPECT_FLOAT_EQ(acc.motion_vectors()[i].x, 0.0f);
+    }
+
+    // Limited history
+    acc.reset();
+    acc.set_max_history(2);
+
+    for (float s : samples)
+    {
+        std::fill(accum.begin(), accum.end(), vec4(s));
+        acc.accumulate(pixel_format_constant<PF_RGBA32F>{}, color.data(), accum.data(), normal_depth.data(), width, height, cam);
+    }
+
+    // 0.5 * 1 + 0.5 * (0.5 * 2 + 0.5 * (0.5 * 0 + 0.5 * 1))
+    EXPECT_FLOAT_EQ(accum[0].x, 1.125f);
+    EXPECT_FLOAT_EQ(acc.history_length()[0], 2.0f);
+}
+
+TEST(TemporalAccumulator, Reprojection)
+{
+    int width = 64;
+    int height = 48;
+
+    std::vector<vec4> accum;
+    std::vector<vec4> normal_depth;
+    std::vector<vec4> color(width * height);
+
+    temporal_accumulator acc(2);
+
+    // Frame 0: colors are the x coordinates of the hit points
+    auto cam0 = make_camera(vec3(2.0f, 0.0f, 10.0f), width, height);
+    render_planes(cam0, width, height, 0.0f, 0.0f, accum, normal_depth);
+    acc.accumulate(pixel_format_constant<PF_RGBA32F>{}, color.data(), accum.data(), normal_depth.data(), width, height, cam0);
+
+    // Frame 1: camera moved to the right, sample colors 0
+    auto cam1 = make_camera(vec3(2.5f, 0.0f, 10.0f), width, height);
+    std::vector<vec4> expected;
+    render_planes(cam1, width, height, 0.0f, 0.0f, expected, normal_depth);
+    std::fill(accum.begin(), accum.end(), vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    acc.accumulate(pixel_format_constant<PF_RGBA32F>{}, color.data(), accum.data(), normal_depth.data(), width, height, cam1);
+
+    float dx = acc.motion_vectors()[0].x;
+    EXPECT_GT(dx, 0.0f);
+
+    int reused = 0;
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            int i = y * width + x;
+
+            EXPECT_NEAR(acc.motion_vectors()[i].x, dx, 1e-3f);
+            EXPECT_NEAR(acc.motion_vectors()[i].y, 0.0f, 1e-3f);
+
+            if (x + dx < width - 1)
+            {
+                // History is the old color at the same point on the plane
+                EXPECT_FLOAT_EQ(acc.history_length()[i], 2.0f);
+                EXPECT_NEAR(accum[i].x * 2.0f, expected[i].x, 1e-3f);
+                ++reused;
+            }
+            else if (x + dx >= width)
+            {
+                // Outside the previous frame
+                EXPECT_FLOAT_EQ(acc.history_length()[i], 1.0f);
+                EXPECT_FLOAT_EQ(accum[i].x, 0.0f);
+            }
+        }
+    }
+
+    EXPECT_GT(reused, width * height / 2);
+}
+
+TEST(TemporalAccumulator, Disocclusion)
+{
+    int width = 64;
+    int height = 48;
+
+    std::vector<vec4> accum;
+    std::vector<vec4> normal_depth;
+    std::vector<vec4> color(width * height);
+
+    temporal_accumulator acc(2);
+
+    auto cam0 = make_camera(vec3(0.0f, 0.0f, 10.0f), width, height);
+    render_planes(cam0, width, height, 0.0f, 0.0f, accum, normal_depth);
+    acc.accumulate(pixel_format_constant<PF_RGBA32F>{}, color.data(), accum.data(), normal_depth.data(), width, height, cam0);
+
+    // Camera moved slightly, an occluder appeared where x < 0
+    auto cam1 = make_camera(vec3(0.0f, 0.01f, 10.0f), width, height);
+    render_planes(cam1, width, height, 0.0f, 5.0f, accum, normal_depth);
+    acc.accumulate(pixel_format_constant<PF_RGBA32F>{}, color.data(), accum.data(), normal_depth.data(), width, height, cam1);
+
+    for (int y = 1; y < height - 1; ++y)
+    {
+        EXPECT_FLOAT_EQ(acc.history_length()[y * width + 2], 1.0f);
+        EXPECT_FLOAT_EQ(acc.history_length()[y * width + width - 3], 2.0f);
+    }
+}
@@ -0,0 +1,206 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <random>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/detail/storage_types/bricked_accessor.h>
+#include <visionaray/texture/detail/storage_types/bricked_storage.h>
+#include <visionaray/texture/texture.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+template <typename T, unsigned BrickSize, unsigned Halo>
+struct bricked_texture : texture_base<3, bricked_storage<T, BrickSize, Halo>>
+{
+    using value_type = T;
+    using base_type = texture_base<3, bricked_storage<T, BrickSize, Halo>>;
+    enum { dimensions = 3 };
+    using base_type::base_type;
+};
+
+template <typename T, unsigned BrickSize, unsigned Halo>
+struct bricked_texture_ref : texture_base<3, bricked_accessor<T, BrickSize, Halo, brick_order::Morton>>
+{
+    using value_type = T;
+    using base_type = texture_base<3, bricked_accessor<T, BrickSize, Halo, brick_order::Morton>>;
+    enum { dimensions = 3 };
+    using base_type::base_type;
+};
+
+template <typename Tex>
+static void setup(Tex& tex, tex_filter_mode filter_mode, tex_address_mode address_mode)
+{
+    tex.set_filter_mode(filter_mode);
+    tex.set_address_mode(address_mode);
+}
+
+// Compare filtered lookups of a bricked texture against row-major storage
+template <unsigned BrickSize, unsigned Halo>
+static void test_bricked(unsigned w, unsigned h, unsigned d)
+{
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<float> data(w * h * d);
+    for (auto& v : data)
+    {
+        v = dist(rng);
+    }
+
+    texture<float, 3> reference(w, h, d);
+    reference.reset(data.data());
+
+    bricked_texture<float, BrickSize, Halo> bricked(w, h, d);
+    bricked.reset(data.data());
+
+    // View to the bricked data
+    bricked_texture_ref<float, BrickSize, Halo> ref(bricked.data(), bricked.size());
+
+    tex_filter_mode filter_modes[] = { Nearest, Linear, BSpline, CardinalSpline };
+    tex_address_mode address_modes[] = { Clamp, Wrap, Mirror };
+
+    for (auto fm : filter_modes)
+    {
+        for (auto am : address_modes)
+        {
+            setup(reference, fm, am);
+            setup(bricked, fm, am);
+            setup(ref, fm, am);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                // Also sample outside [0..1) to exercise the address modes
+                vec3 coord(
+                        dist(rng) * 1.2f - 0.1f,
+                        dist(rng) * 1.2f - 0.1f,
+                        dist(rng) * 1.2f - 0.1f
+                        );
+
+                float expected = tex3D(reference, coord);
+                EXPECT_FLOAT_EQ(tex3D(bricked, coord), expected);
+                EXPECT_FLOAT_EQ(tex3D(ref, coord), expected);
+
+                // SIMD fetch
+                vector<3, simd::float4> coord4(coord);
+                coord4.y += simd::float4(0.0f, 0.01f, 0.02f, 0.5f);
+
+                simd::aligned_array_t<simd::float4> expected4;
+                simd::aligned_array_t<simd::float4> value4;
+                store(expected4, tex3D(reference, coord4));
+                store(value4, tex3D(bricked, coord4));
+
+                for (int j = 0; j < 4; ++j)
+                {
+                    EXPECT_FLOAT_EQ(value4[j], expected4[j]);
+                }
+            }
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test bricked storage with various brick and halo sizes
+//
+
+TEST(BrickedStorage, Lookup)
+{
+    test_bricked<4, 0>(13, 7, 21);
+    test_bricked<4, 1>(13, 7, 21);
+    test_bricked<4, 2>(13, 7, 21);
+    test_bricked<8, 1>(40, 33, 17);
+    test_bricked<1, 0>(5, 6, 7);
+    test_bricked<2, 2>(64, 64, 64);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test memory layout
+//
+
+TEST(BrickedStorage, Layout)
+{
+    // Each texel is stored exactly once (no halo)
+    bricked_layout<4, 0> layout(32, 32, 32);
+    EXPECT_EQ(layout.storage_size(), size_t(32 * 32 * 32));
+
+    std::vector<int> count(layout.storage_size(), 0);
+
+    for (int z = 0; z < 32; ++z)
+    {
+        for (int y = 0; y < 32; ++y)
+        {
+            for (int x = 0; x < 32; ++x)
+            {
+                ++count[layout.index(x, y, z)];
+            }
+        }
+    }
+
+    for (auto c : count)
+    {
+        EXPECT_EQ(c, 1);
+    }
+
+    // Neighboring bricks are stored consecutively (Morton order)
+    EXPECT_EQ(layout.index(0, 0, 0), 0);
+    EXPECT_EQ(layout.index(4, 0, 0), 64);
+    EXPECT_EQ(layout.index(0, 4, 0), 128);
+    EXPECT_EQ(layout.index(4, 4, 0), 192);
+    EXPECT_EQ(layout.index(0, 0, 4), 256);
+
+    // Row-major bricks, the default for bricked_accessor
+    bricked_accessor<float> row_major(12, 8, 8);
+    EXPECT_EQ(row_major.storage_size(), size_t(12 * 8 * 8));
+    EXPECT_EQ(row_major.index(0, 0, 0), 0);
+    EXPECT_EQ(row_major.index(4, 0, 0), 64);
+    EXPECT_EQ(row_major.index(8, 0, 0), 128);
+    EXPECT_EQ(row_major.index(0, 4, 0), 192);
+    EXPECT_EQ(row_major.index(0, 0, 4), 384);
+    EXPECT_EQ(row_major.index(5, 6, 7), (1 * 6 + 1 * 3 + 1) * 64 + 3 * 16 + 2 * 4 + 1);
+
+    // Haloed bricks
+    bricked_layout<4, 1> haloed(8, 8, 8);
+    EXPECT_EQ(haloed.storage_size(), size_t(8 * 6 * 6 * 6));
+    EXPECT_EQ(haloed.index(1, 0, 0) - haloed.index(0, 0, 0), 1);
+    EXPECT_EQ(haloed.index(0, 1, 0) - haloed.index(0, 0, 0), 6);
+    EXPECT_EQ(haloed.index(0, 0, 1) - haloed.index(0, 0, 0), 36);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that scalar addressing of layouts with more than 2^31 texels doesn't overflow
+//
+
+TEST(BrickedStorage, LargeLayout)
+{
+    // 256^3 bricks with 6^3 texels each, about 3.6e9 texels
+    bricked_layout<4, 1> layout(1024, 1024, 1024);
+
+    size_t num_texels = size_t(256) * 256 * 256 * 216;
+    EXPECT_EQ(layout.storage_size(), num_texels);
+    EXPECT_FALSE(layout.simd_addressable());
+
+    // The last brick is stored last, its last texel (without halo) is followed
+    // by one row, one slice and one texel of halo
+    auto last = layout.index(1023, 1023, 1023);
+    EXPECT_EQ(static_cast<size_t>(last), num_texels - 1 - 6 - 36 - 1);
+
+    auto last_unsigned = layout.index(1023U, 1023U, 1023U);
+    EXPECT_EQ(last_unsigned, num_texels - 1 - 6 - 36 - 1);
+
+    // Offsets within a brick are still relative to the texel
+    EXPECT_EQ(layout.index(1023, 1023, 1022) - last, -36);
+
+    bricked_layout<4, 1> small(64, 64, 64);
+    EXPECT_TRUE(small.simd_addressable());
+}
@@ -0,0 +1,295 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/detail/prefilter.h>
+#include <visionaray/texture/texture.h>
+#include <visionaray/aligned_vector.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+static aligned_vector<float> make_random(size_t n)
+{
+    std::default_random_engine rng(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    aligned_vector<float> result(n);
+
+    for (auto& f : result)
+    {
+        f = dist(rng);
+    }
+
+    return result;
+}
+
+// Serial reference, one line after another
+static void prefilter_reference(float* data, std::array<unsigned, 3> size)
+{
+    size_t stride = 1;
+
+    for (int d = 0; d < 3; ++d)
+    {
+        size_t total = size[0] * size[1] * size[2];
+        size_t num_lines = total / size[d];
+
+        for (size_t i = 0; i < num_lines; ++i)
+        {
+            size_t offset = (i % stride) + (i / stride) * stride * size[d];
+            detail::convert_to_bspline_coeffs(data + offset, size[d], stride);
+        }
+
+        stride *= size[d];
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that parallel, SIMD prefiltering matches the serial version
+//
+
+TEST(Prefilter, Parallel)
+{
+    // Sizes that are not multiples of the SIMD width
+    std::array<unsigned, 3> size = {{ 37, 21, 13 }};
+    auto data = make_random(size[0] * size[1] * size[2]);
+
+    auto expected = data;
+    prefilter_reference(expected.data(), size);
+
+    thread_pool pool(4);
+    convert_for_bspline_interpol(data.data(), size, pool);
+
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        ASSERT_NEAR(data[i], expected[i], 1e-5f * std::abs(expected[i]) + 1e-6f);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that B-spline interpolation reproduces the texel values
+//
+
+TEST(Prefilter, Interpolation1D)
+{
+    unsigned n = 50;
+    auto data = make_random(n);
+
+    texture<float, 1> tex(n);
+    tex.reset(data.data());
+    tex.set_address_mode(Clamp);
+    tex.set_filter_mode(BSplineInterpol);
+
+    convert_for_bspline_interpol(tex);
+
+    for (unsigned i = 0; i < n; ++i)
+    {
+        float coord = (i + 0.5f) / n;
+        EXPECT_NEAR(tex1D(tex, coord), data[i], 1e-4f);
+    }
+}
+
+TEST(Prefilter, Interpolation2D)
+{
+    unsigned w = 30;
+    unsigned h = 17;
+    auto data = make_random(w * h);
+
+    // Vector texture, components with different data
+    aligned_vector<vec2> data2(w * h);
+
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data2[i] = vec2(data[i], data[data.size() - 1 - i]);
+    }
+
+    texture<vec2, 2> tex(w, h);
+    tex.reset(data2.data());
+    tex.set_address_mode(Clamp);
+    tex.set_filter_mode(BSplineInterpol);
+
+    convert_for_bspline_interpol(tex);
+
+    for (unsigned y = 0; y < h; ++y)
+    {
+        for (unsigned x = 0; x < w; ++x)
+        {
+            vec2 coord((x + 0.5f) / w, (y + 0.5f) / h);
+            vec2 value = tex2D(tex, coord);
+            EXPECT_NEAR(value.x, data2[y * w + x].x, 1e-4f);
+            EXPECT_NEAR(value.y, data2[y * w + x].y, 1e-4f);
+        }
+    }
+}
+
+TEST(Prefilter, Interpolation3D)
+{
+    unsigned w = 19;
+    unsigned h = 12;
+    unsigned d = 9;
+    auto data = make_random(w * h * d);
+
+    texture<float, 3> tex(w, h, d);
+    tex.reset(data.data());
+    tex.set_address_mode(Clamp);
+    tex.set_filter_mode(BSplineInterpol);
+
+    convert_for_bspline_interpol(tex);
+
+    for (unsigned z = 0; z < d; ++z)
+    {
+        for (unsigned y = 0; y < h; ++y)
+        {
+            for (unsigned x = 0; x < w; ++x)
+            {
+                vec3 coord((x + 0.5f) / w, (y + 0.5f) / h, (z + 0.5f) / d);
+                EXPECT_NEAR(tex3D(tex, coord), data[(z * h + y) * w + x], 1e-4f);
+            }
+        }
+    }
+
+    // SIMD coordinates
+    simd::float4 xs((0.5f) / w, (3.5f) / w, (7.5f) / w, (18.5f) / w);
+    vector<3, simd::float4> coord(xs, simd::float4(2.5f / h), simd::float4(4.5f / d));
+    simd::aligned_array_t<simd::float4> values;
+    store(values, tex3D(tex, coord));
+
+    int xi[] = { 0, 3, 7, 18 };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_NEAR(values[i], data[(4 * h + 2) * w + xi[i]], 1e-4f);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test integer and unorm textures
+//
+
+TEST(Prefilter, Integer)
+{
+    // Smooth data, coefficients stay inside the value range
+    unsigned w = 64;
+    unsigned h = 32;
+
+    aligned_vector<vector<4, unorm<8>>> rgba(w * h);
+    aligned_vector<short> shorts(w * h);
+    aligned_vector<unorm<16>> unorm16(w * h);
+
+    for (unsigned y = 0; y < h; ++y)
+    {
+        for (unsigned x = 0; x < w; ++x)
+        {
+            float f = 0.5f + 0.3f * std::sin(x * 0.2f) * std::cos(y * 0.3f);
+            rgba[y * w + x] = vector<4, unorm<8>>(vec4(f, 1.0f - f, 0.5f, 1.0f));
+            shorts[y * w + x] = static_cast<short>(f * 10000.0f);
+            unorm16[y * w + x] = unorm<16>(f);
+        }
+    }
+
+    texture<vector<4, unorm<8>>, 2> tex(w, h);
+    tex.reset(rgba.data());
+    tex.set_address_mode(Clamp);
+    tex.set_filter_mode(BSplineInterpol);
+
+    convert_for_bspline_interpol(tex);
+
+    for (unsigned y = 0; y < h; ++y)
+    {
+        for (unsigned x = 0; x < w; ++x)
+        {
+            vec2 coord((x + 0.5f) / w, (y + 0.5f) / h);
+            vec4 value = tex2D(tex, coord);
+            vec4 expected(rgba[y * w + x]);
+
+            for (int c = 0; c < 4; ++c)
+            {
+                // Filtering 8-bit texels truncates intermediate results
+                EXPECT_NEAR(value[c], expected[c], 3.0f / 255.0f);
+            }
+        }
+    }
+
+    auto coeffs = shorts;
+    convert_for_bspline_interpol(coeffs.data(), std::array<unsigned, 2>{{ w, h }});
+
+    texture<short, 2> stex(w, h);
+    stex.reset(coeffs.data());
+    stex.set_address_mode(Clamp);
+    stex.set_filter_mode(BSplineInterpol);
+
+    texture<unorm<16>, 2> utex(w, h);
+    utex.reset(unorm16.data());
+    utex.set_address_mode(Clamp);
+    utex.set_filter_mode(BSplineInterpol);
+
+    convert_for_bspline_interpol(utex);
+
+    for (unsigned y = 0; y < h; ++y)
+    {
+        for (unsigned x = 0; x < w; ++x)
+        {
+            vec2 coord((x + 0.5f) / w, (y + 0.5f) / h);
+            EXPECT_NEAR(float(tex2D(stex, coord)), float(shorts[y * w + x]), 2.0f);
+            EXPECT_NEAR(tex2D(utex, coord), float(unorm16[y * w + x]), 1e-4f);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that integer data filtered without a float copy (1D) or with a float copy of
+// the intermediate dimensions only (3D) matches rounded float coefficients
+//
+
+TEST(Prefilter, IntegerMatchesFloat)
+{
+    std::array<unsigned, 3> size = {{ 37, 21, 13 }};
+    auto values = make_random(size[0] * size[1] * size[2]);
+
+    aligned_vector<short> shorts(values.size());
+    aligned_vector<float> floats(values.size());
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        shorts[i] = static_cast<short>(values[i] * 1000.0f);
+        floats[i] = static_cast<float>(shorts[i]);
+    }
+
+    thread_pool pool(4);
+
+    // 1D, in place
+    auto shorts1D = shorts;
+    auto floats1D = floats;
+
+    convert_for_bspline_interpol(shorts1D.data(), std::array<unsigned, 1>{{ size[0] }}, pool);
+    convert_for_bspline_interpol(floats1D.data(), std::array<unsigned, 1>{{ size[0] }}, pool);
+
+    for (unsigned i = 0; i < size[0]; ++i)
+    {
+        EXPECT_EQ(shorts1D[i], static_cast<short>(std::round(floats1D[i])));
+    }
+
+    // 3D
+    convert_for_bspline_interpol(shorts.data(), size, pool);
+    convert_for_bspline_interpol(floats.data(), size, pool);
+
+    for (size_t i = 0; i < shorts.size(); ++i)
+    {
+        ASSERT_EQ(shorts[i], static_cast<short>(std::round(floats[i])));
+    }
+}
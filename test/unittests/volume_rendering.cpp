@@ -0,0 +1,308 @@
+// This file is distributed under the MIT license.
+// See the LICENSE file for details.
+
+#include <cstdlib>
+#include <vector>
+
+#include <visionaray/math/math.h>
+#include <visionaray/texture/texture.h>
+#include <visionaray/macrocell_grid.h>
+#include <visionaray/volume_rendering.h>
+
+#include <gtest/gtest.h>
+
+using namespace visionaray;
+
+
+//-------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+// 32^3 volume that is zero everywhere but in a 4^3 block of ones
+static texture<float, 3> make_sparse_volume()
+{
+    texture<float, 3> volume(32, 32, 32);
+
+    std::vector<float> data(32 * 32 * 32, 0.0f);
+
+    for (int z = 20; z < 24; ++z)
+    {
+        for (int y = 20; y < 24; ++y)
+        {
+            for (int x = 20; x < 24; ++x)
+            {
+                data[z * 32 * 32 + y * 32 + x] = 1.0f;
+            }
+        }
+    }
+
+    volume.reset(data.data());
+    volume.set_address_mode(Clamp);
+    volume.set_filter_mode(Linear);
+
+    return volume;
+}
+
+// Transparent for values < 0.5, constant color and opacity otherwise
+static texture<vec4, 1> make_transfunc()
+{
+    texture<vec4, 1> transfunc(8);
+
+    std::vector<vec4> data(8, vec4(0.0f));
+
+    for (int i = 4; i < 8; ++i)
+    {
+        data[i] = vec4(1.0f, 0.5f, 0.25f, 0.2f);
+    }
+
+    transfunc.reset(data.data());
+    transfunc.set_address_mode(Clamp);
+    transfunc.set_filter_mode(Linear);
+
+    return transfunc;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test macrocell_grid value ranges and majorants
+//
+
+TEST(VolumeRendering, MacrocellGrid)
+{
+    auto volume = make_sparse_volume();
+    auto transfunc = make_transfunc();
+
+    macrocell_grid grid(vec3i(8), aabb(vec3(0.0f), vec3(1.0f)));
+    grid.build(volume);
+    grid.compute_opacity_majorants(transfunc);
+
+    // Cells covering voxels [20..24) are cells 5 (and their neighbors,
+    // due to the one voxel apron for interpolation)
+    EXPECT_FLOAT_EQ(grid.value_range(vec3i(5)).y, 1.0f);
+    EXPECT_FLOAT_EQ(grid.value_range(vec3i(4)).y, 1.0f);
+    EXPECT_FLOAT_EQ(grid.value_range(vec3i(6)).y, 1.0f);
+    EXPECT_FLOAT_EQ(grid.value_range(vec3i(0)).y, 0.0f);
+    EXPECT_FLOAT_EQ(grid.value_range(vec3i(7)).y, 0.0f);
+
+    EXPECT_FLOAT_EQ(grid.majorant(vec3i(5)), 0.2f);
+    EXPECT_FLOAT_EQ(grid.majorant(vec3i(0)), 0.0f);
+    EXPECT_FLOAT_EQ(grid.max_majorant(), 0.2f);
+
+    // Parallel build yields the same grid
+    thread_pool pool(4);
+    macrocell_grid grid2(vec3i(8), aabb(vec3(0.0f), vec3(1.0f)));
+    grid2.build(volume, pool);
+
+    for (int z = 0; z < 8; ++z)
+    {
+        for (int y = 0; y < 8; ++y)
+        {
+            for (int x = 0; x < 8; ++x)
+            {
+                EXPECT_TRUE(grid.value_range(vec3i(x, y, z)) == grid2.value_range(vec3i(x, y, z)));
+            }
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test 3D-DDA traversal
+//
+
+TEST(VolumeRendering, TraverseGrid)
+{
+    macrocell_grid grid(vec3i(4, 5, 6), aabb(vec3(-1.0f), vec3(1.0f)));
+
+    vec3 dirs[] = {
+        vec3( 1.0f,  0.0f,  0.0f),
+        vec3(-1.0f,  0.0f,  0.0f),
+        vec3( 0.3f, -0.5f,  0.8f),
+        vec3(-0.2f,  0.7f, -0.1f)
+        };
+
+    for (auto d : dirs)
+    {
+        basic_ray<float> ray(vec3(0.1f, 0.05f, -0.02f) - normalize(d) * 3.0f, normalize(d));
+        ray.tmin = 0.0f;
+        ray.tmax = numeric_limits<float>::max();
+
+        auto hr = intersect(ray, grid.bounds());
+        ASSERT_TRUE(hr.hit);
+
+        float last_t = hr.tnear;
+        vec3i last_index(-1);
+
+        traverse_grid(ray, grid, [&](vec3i const& index, float t0, float t1)
+        {
+            // Intervals are contiguous and non-empty
+            EXPECT_FLOAT_EQ(t0, last_t);
+            EXPECT_LE(t0, t1);
+
+            // Neighboring cells differ in exactly one coordinate by one
+            if (last_index.x >= 0)
+            {
+                vec3i diff = index - last_index;
+                EXPECT_EQ(std::abs(diff.x) + std::abs(diff.y) + std::abs(diff.z), 1);
+            }
+
+            // The interval midpoint lies inside the cell
+            vec3 mid = ray.ori + ray.dir * (0.5f * (t0 + t1));
+            EXPECT_TRUE(grid.cell_index(mid) == index);
+
+            last_t = t1;
+            last_index = index;
+            return true;
+        });
+
+        EXPECT_NEAR(last_t, hr.tfar, 1e-5f);
+    }
+
+    // Early exit
+    basic_ray<float> ray(vec3(-2.0f, 0.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f));
+    int count = 0;
+    traverse_grid(ray, grid, [&](vec3i const&, float, float) { return ++count < 2; });
+    EXPECT_EQ(count, 2);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test emission/absorption ray marching with empty space skipping
+//
+
+TEST(VolumeRendering, IntegrateEmissionAbsorption)
+{
+    auto volume = make_sparse_volume();
+    auto transfunc = make_transfunc();
+
+    macrocell_grid grid(vec3i(8), aabb(vec3(0.0f), vec3(1.0f)));
+    grid.build(volume);
+    grid.compute_opacity_majorants(transfunc);
+
+    // Same, but no cell is empty (=> no skipping)
+    macrocell_grid dense_grid(vec3i(1), aabb(vec3(0.0f), vec3(1.0f)));
+    dense_grid.build(volume);
+    dense_grid.compute_majorants([](vec2 const&) { return 0.2f; });
+
+    ray_marching_params params;
+    params.min_step = params.max_step = params.reference_step = 1.0f / 256.0f;
+
+    // Ray through the dense block
+    basic_ray<float> ray(vec3(0.69f, 0.69f, -1.0f), vec3(0.0f, 0.0f, 1.0f));
+
+    ray_marching_stats stats;
+    vec4 skipped = integrate_emission_absorption(ray, volume, transfunc, grid, params, stats);
+
+    ray_marching_stats dense_stats;
+    vec4 dense = integrate_emission_absorption(ray, volume, transfunc, dense_grid, params, dense_stats);
+
+    EXPECT_GT(skipped.w, 0.0f);
+    EXPECT_NEAR(skipped.x, dense.x, 0.02f);
+    EXPECT_NEAR(skipped.w, dense.w, 0.02f);
+    EXPECT_GT(stats.cells_skipped, 0U);
+    EXPECT_LT(stats.samples, dense_stats.samples);
+
+    // Ray through empty space only
+    basic_ray<float> empty_ray(vec3(0.1f, 0.1f, -1.0f), vec3(0.0f, 0.0f, 1.0f));
+
+    ray_marching_stats empty_stats;
+    vec4 empty = integrate_emission_absorption(empty_ray, volume, transfunc, grid, params, empty_stats);
+
+    EXPECT_FLOAT_EQ(empty.w, 0.0f);
+    EXPECT_EQ(empty_stats.samples, 0U);
+    EXPECT_EQ(empty_stats.cells_skipped, empty_stats.cells_visited);
+
+    // Early ray termination: opaque transfer function
+    dense_grid.compute_majorants([](vec2 const&) { return 1.0f; });
+    texture<vec4, 1> opaque(2);
+    vec4 opaque_data[] = { vec4(1.0f), vec4(1.0f) };
+    opaque.reset(opaque_data);
+    opaque.set_address_mode(Clamp);
+    opaque.set_filter_mode(Linear);
+
+    ray_marching_stats opaque_stats;
+    vec4 color = integrate_emission_absorption(ray, volume, opaque, dense_grid, params, opaque_stats);
+
+    EXPECT_GE(color.w, params.termination_opacity);
+    EXPECT_EQ(opaque_stats.samples, 1U);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that the integral does not depend on how the ray is split into cells
+//
+
+TEST(VolumeRendering, StepsPerCell)
+{
+    // Homogeneous volume
+    texture<float, 3> volume(4, 4, 4);
+    std::vector<float> data(4 * 4 * 4, 1.0f);
+    volume.reset(data.data());
+    volume.set_address_mode(Clamp);
+    volume.set_filter_mode(Linear);
+
+    auto transfunc = make_transfunc();
+
+    // Transfer function opacities refer to the whole volume
+    ray_marching_params params;
+    params.reference_step = 1.0f;
+    params.max_step_opacity = 1.0f; // always use max_step
+
+    // Oblique ray, direction not normalized
+    vec3 dir(0.3f, 0.2f, 1.0f);
+    basic_ray<float> ray(vec3(0.1f, 0.2f, -1.0f), dir * 2.0f);
+
+    float dist = 1.0f * length(dir) / dir.z;
+    float expected = 1.0f - pow(1.0f - 0.2f, dist / params.reference_step);
+
+    for (int n : { 1, 7, 64, 100 })
+    {
+        // Cells are much shorter than max_step for large n
+        macrocell_grid grid(vec3i(n), aabb(vec3(0.0f), vec3(1.0f)));
+        grid.build(volume);
+        grid.compute_opacity_majorants(transfunc);
+
+        vec4 color = integrate_emission_absorption(ray, volume, transfunc, grid, params);
+
+        EXPECT_NEAR(color.w, expected, 1e-4f) << n << " cells";
+    }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+// Test that the adaptive step size bounds the opacity per sample
+//
+
+TEST(VolumeRendering, AdaptiveStepSize)
+{
+    ray_marching_params params;
+
+    EXPECT_FLOAT_EQ(detail::adaptive_step_size(0.0f, params), params.max_step);
+    EXPECT_FLOAT_EQ(detail::adaptive_step_size(1.0f, params), params.min_step);
+
+    float prev_dt = params.max_step;
+
+    // Majorants below, at and above max_step_opacity
+    for (int i = 1; i <= 200; ++i)
+    {
+        float m = i * 0.001f;
+        float dt = detail::adaptive_step_size(m, params);
+
+        EXPECT_LE(dt, prev_dt) << "m = " << m;
+        EXPECT_GE(dt, params.min_step);
+        EXPECT_LE(dt, params.max_step);
+
+        if (dt > params.min_step)
+        {
+            float opacity = 1.0f - pow(1.0f - m, dt / params.reference_step);
+            EXPECT_LE(opacity, params.max_step_opacity + 1e-5f) << "m = " << m;
+        }
+
+        prev_dt = dt;
+    }
+
+    // No jump at the threshold
+    float below = detail::adaptive_step_size(params.max_step_opacity * 0.999f, params);
+    float above = detail::adaptive_step_size(params.max_step_opacity * 1.001f, params);
+    EXPECT_NEAR(below, above, params.reference_step * 0.01f);
+}